@@ -3,6 +3,21 @@ AC_DEFUN([AX_LIBVSHADOW_CHECK_LOCAL],
   [dnl Check for internationalization functions in libvshadow/libvshadow_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
 
+  dnl Check for the monotonic clock used by libvshadow/libvshadow_statistics.c
+  AC_CHECK_FUNCS([clock_gettime])
+
+  AS_IF(
+    [test "x$ac_cv_func_clock_gettime" != xyes],
+    [AC_SEARCH_LIBS(
+      [clock_gettime],
+      [rt],
+      [AC_DEFINE(
+        [HAVE_CLOCK_GETTIME],
+        [1],
+        [Define to 1 if you have the `clock_gettime' function.])
+    ])
+  ])
+
   dnl Check if library should be build with verbose output
   AX_COMMON_CHECK_ENABLE_VERBOSE_OUTPUT
 
@@ -28,10 +43,19 @@ AC_DEFUN([AX_LIBVSHADOW_CHECK_LOCAL],
 
 dnl Function to detect if vshadowtools dependencies are available
 AC_DEFUN([AX_VSHADOWTOOLS_CHECK_LOCAL],
-  [AC_CHECK_HEADERS([signal.h sys/signal.h unistd.h])
+  [AC_CHECK_HEADERS([errno.h fcntl.h signal.h sys/signal.h sys/socket.h sys/stat.h sys/un.h unistd.h])
 
   AC_CHECK_FUNCS([close getopt setvbuf])
 
+  dnl Check if copying data can be offloaded to the file system by vshadowexport
+  AC_CHECK_FUNCS([copy_file_range])
+
+  dnl Check if vshadowexport can read volume data with direct I/O or cache hints
+  AC_CHECK_FUNCS([posix_fadvise pread])
+
+  dnl Check if vshadowexport can flush image files to storage before writing a checkpoint
+  AC_CHECK_FUNCS([fdatasync fsync])
+
   AS_IF(
    [test "x$ac_cv_func_close" != xyes],
    [AC_MSG_FAILURE(
@@ -0,0 +1,1137 @@
+/*
+ * NTFS allocation bitmap functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_allocation_bitmap.h"
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcnotify.h"
+
+#include "vshadow_volume.h"
+
+/* The NTFS $DATA attribute type
+ */
+#define LIBVSHADOW_NTFS_ATTRIBUTE_TYPE_DATA		0x00000080UL
+
+/* The NTFS end of attributes marker
+ */
+#define LIBVSHADOW_NTFS_ATTRIBUTE_TYPE_END_OF_ATTRIBUTES	0xffffffffUL
+
+/* The NTFS compressed and encrypted attribute data flags
+ */
+#define LIBVSHADOW_NTFS_ATTRIBUTE_DATA_FLAGS_UNSUPPORTED	0x40ff
+
+/* The NTFS fix-up values are stored per 512 bytes
+ */
+#define LIBVSHADOW_NTFS_FIXUP_VALUES_STRIDE		512
+
+/* The largest supported NTFS cluster block size
+ */
+#define LIBVSHADOW_NTFS_MAXIMUM_CLUSTER_BLOCK_SIZE	( 2 * 1024 * 1024 )
+
+/* The largest supported NTFS MFT entry size
+ */
+#define LIBVSHADOW_NTFS_MAXIMUM_MFT_ENTRY_SIZE		( 64 * 1024 )
+
+const char *vshadow_ntfs_mft_entry_signature = "FILE";
+
+/* Creates an allocation bitmap
+ * Make sure the value allocation_bitmap is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_allocation_bitmap_initialize(
+     libvshadow_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_allocation_bitmap_initialize";
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_bitmap != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation bitmap value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*allocation_bitmap = memory_allocate_structure(
+	                      libvshadow_allocation_bitmap_t );
+
+	if( *allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create allocation bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *allocation_bitmap,
+	     0,
+	     sizeof( libvshadow_allocation_bitmap_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear allocation bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *allocation_bitmap != NULL )
+	{
+		memory_free(
+		 *allocation_bitmap );
+
+		*allocation_bitmap = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an allocation bitmap
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_allocation_bitmap_free(
+     libvshadow_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_allocation_bitmap_free";
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_bitmap != NULL )
+	{
+		if( ( *allocation_bitmap )->data != NULL )
+		{
+			memory_free(
+			 ( *allocation_bitmap )->data );
+		}
+		if( ( *allocation_bitmap )->data_runs != NULL )
+		{
+			memory_free(
+			 ( *allocation_bitmap )->data_runs );
+		}
+		memory_free(
+		 *allocation_bitmap );
+
+		*allocation_bitmap = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads the NTFS volume header
+ * Returns 1 if successful, 0 if the data does not contain a NTFS volume header or -1 on error
+ */
+int libvshadow_allocation_bitmap_read_volume_header_data(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function             = "libvshadow_allocation_bitmap_read_volume_header_data";
+	uint64_t mft_cluster_block_number = 0;
+	uint64_t total_number_of_sectors  = 0;
+	uint32_t cluster_block_size       = 0;
+	uint32_t mft_entry_size           = 0;
+	uint16_t bytes_per_sector         = 0;
+	uint8_t sectors_per_cluster_block = 0;
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( vshadow_ntfs_volume_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     ( (vshadow_ntfs_volume_header_t *) data )->signature,
+	     vshadow_ntfs_volume_file_system_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (vshadow_ntfs_volume_header_t *) data )->bytes_per_sector,
+	 bytes_per_sector );
+
+	sectors_per_cluster_block = ( (vshadow_ntfs_volume_header_t *) data )->sectors_per_cluster_block;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vshadow_ntfs_volume_header_t *) data )->total_number_of_sectors_64bit,
+	 total_number_of_sectors );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vshadow_ntfs_volume_header_t *) data )->mft_cluster_block_number,
+	 mft_cluster_block_number );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vshadow_ntfs_volume_header_t *) data )->mft_entry_size,
+	 mft_entry_size );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: bytes per sector\t\t\t: %" PRIu16 "\n",
+		 function,
+		 bytes_per_sector );
+
+		libcnotify_printf(
+		 "%s: sectors per cluster block\t\t: %" PRIu8 "\n",
+		 function,
+		 sectors_per_cluster_block );
+
+		libcnotify_printf(
+		 "%s: total number of sectors\t\t: %" PRIu64 "\n",
+		 function,
+		 total_number_of_sectors );
+
+		libcnotify_printf(
+		 "%s: MFT cluster block number\t\t: %" PRIu64 "\n",
+		 function,
+		 mft_cluster_block_number );
+
+		libcnotify_printf(
+		 "%s: MFT entry size\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 mft_entry_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( ( bytes_per_sector != 256 )
+	 && ( bytes_per_sector != 512 )
+	 && ( bytes_per_sector != 1024 )
+	 && ( bytes_per_sector != 2048 )
+	 && ( bytes_per_sector != 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bytes per sector: %" PRIu16 ".",
+		 function,
+		 bytes_per_sector );
+
+		return( -1 );
+	}
+	/* Sectors per cluster block values larger than 128 contain
+	 * the exponent of a power of 2 number of sectors
+	 */
+	if( sectors_per_cluster_block > 128 )
+	{
+		if( sectors_per_cluster_block < 244 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported sectors per cluster block: %" PRIu8 ".",
+			 function,
+			 sectors_per_cluster_block );
+
+			return( -1 );
+		}
+		cluster_block_size = (uint32_t) bytes_per_sector << ( 256 - (uint32_t) sectors_per_cluster_block );
+	}
+	else
+	{
+		cluster_block_size = (uint32_t) bytes_per_sector * sectors_per_cluster_block;
+	}
+	if( ( cluster_block_size == 0 )
+	 || ( cluster_block_size > LIBVSHADOW_NTFS_MAXIMUM_CLUSTER_BLOCK_SIZE )
+	 || ( ( cluster_block_size & ( cluster_block_size - 1 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported cluster block size: %" PRIu32 ".",
+		 function,
+		 cluster_block_size );
+
+		return( -1 );
+	}
+	allocation_bitmap->cluster_block_size       = cluster_block_size;
+	allocation_bitmap->number_of_cluster_blocks = total_number_of_sectors / ( cluster_block_size / bytes_per_sector );
+
+	if( ( allocation_bitmap->number_of_cluster_blocks == 0 )
+	 || ( allocation_bitmap->number_of_cluster_blocks > ( (uint64_t) INT64_MAX / cluster_block_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cluster blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_cluster_block_number >= allocation_bitmap->number_of_cluster_blocks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT cluster block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	allocation_bitmap->mft_offset = (off64_t) ( mft_cluster_block_number * cluster_block_size );
+
+	/* The MFT entry size contains a number of cluster blocks
+	 * or if the (8-bit) value is negative the exponent of a power of 2 byte size
+	 */
+	mft_entry_size &= 0x000000ffUL;
+
+	if( mft_entry_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported MFT entry size: 0.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry_size < 128 )
+	{
+		if( mft_entry_size > ( LIBVSHADOW_NTFS_MAXIMUM_MFT_ENTRY_SIZE / cluster_block_size ) )
+		{
+			mft_entry_size = 0;
+		}
+		else
+		{
+			mft_entry_size *= cluster_block_size;
+		}
+	}
+	else
+	{
+		mft_entry_size = 256 - mft_entry_size;
+
+		if( ( mft_entry_size < 9 )
+		 || ( mft_entry_size > 16 ) )
+		{
+			mft_entry_size = 0;
+		}
+		else
+		{
+			mft_entry_size = (uint32_t) 1 << mft_entry_size;
+		}
+	}
+	if( ( mft_entry_size < LIBVSHADOW_NTFS_FIXUP_VALUES_STRIDE )
+	 || ( mft_entry_size > LIBVSHADOW_NTFS_MAXIMUM_MFT_ENTRY_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported MFT entry size.",
+		 function );
+
+		return( -1 );
+	}
+	allocation_bitmap->mft_entry_size = mft_entry_size;
+
+	return( 1 );
+}
+
+/* Reads the $Bitmap MFT entry
+ * Applies the fix-up values to the data, determines the data runs of the unnamed $DATA attribute
+ * and allocates the bitmap data. Data of a resident $DATA attribute is copied into the bitmap data
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_allocation_bitmap_read_mft_entry_data(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libvshadow_allocation_bitmap_data_run_t *data_run  = NULL;
+	libvshadow_allocation_bitmap_data_run_t *data_runs = NULL;
+	static char *function                              = "libvshadow_allocation_bitmap_read_mft_entry_data";
+	size64_t data_runs_size                            = 0;
+	size64_t run_length                                = 0;
+	size_t attribute_offset                            = 0;
+	size_t data_runs_end_offset                        = 0;
+	size_t data_runs_offset                            = 0;
+	size_t fixup_value_offset                          = 0;
+	size_t fixup_values_offset                         = 0;
+	int64_t cluster_block_number                       = 0;
+	int64_t run_offset                                 = 0;
+	uint64_t attribute_data_size                       = 0;
+	uint64_t first_vcn                                 = 0;
+	uint32_t attribute_size                            = 0;
+	uint32_t attribute_type                            = 0;
+	uint16_t attributes_offset                         = 0;
+	uint16_t data_flags                                = 0;
+	uint16_t entry_flags                               = 0;
+	uint16_t fixup_value_index                         = 0;
+	uint16_t number_of_fixup_values                    = 0;
+	uint16_t resident_data_offset                      = 0;
+	uint8_t run_length_size                            = 0;
+	uint8_t run_offset_size                            = 0;
+	uint8_t byte_index                                 = 0;
+	int maximum_number_of_data_runs                    = 0;
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( allocation_bitmap->data != NULL )
+	 || ( allocation_bitmap->data_runs != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation bitmap - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_bitmap->cluster_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid allocation bitmap - missing cluster block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( vshadow_ntfs_mft_entry_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     ( (vshadow_ntfs_mft_entry_header_t *) data )->signature,
+	     vshadow_ntfs_mft_entry_signature,
+	     4 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+		 "%s: unsupported MFT entry signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (vshadow_ntfs_mft_entry_header_t *) data )->fixup_values_offset,
+	 fixup_values_offset );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (vshadow_ntfs_mft_entry_header_t *) data )->number_of_fixup_values,
+	 number_of_fixup_values );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (vshadow_ntfs_mft_entry_header_t *) data )->attributes_offset,
+	 attributes_offset );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (vshadow_ntfs_mft_entry_header_t *) data )->flags,
+	 entry_flags );
+
+	if( ( entry_flags & 0x0001 ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported MFT entry - entry not in use.",
+		 function );
+
+		return( -1 );
+	}
+	/* The first fix-up value contains the update sequence number, that is stored
+	 * in the last 2 bytes of every 512 bytes of the entry, the other fix-up values
+	 * contain the original values of these bytes
+	 */
+	if( number_of_fixup_values > 0 )
+	{
+		if( ( fixup_values_offset < sizeof( vshadow_ntfs_mft_entry_header_t ) )
+		 || ( fixup_values_offset > ( data_size - ( 2 * (size_t) number_of_fixup_values ) ) )
+		 || ( ( (size_t) number_of_fixup_values - 1 ) > ( data_size / LIBVSHADOW_NTFS_FIXUP_VALUES_STRIDE ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid fix-up values offset or number of fix-up values value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		for( fixup_value_index = 1;
+		     fixup_value_index < number_of_fixup_values;
+		     fixup_value_index++ )
+		{
+			fixup_value_offset = ( (size_t) fixup_value_index * LIBVSHADOW_NTFS_FIXUP_VALUES_STRIDE ) - 2;
+
+			if( ( data[ fixup_value_offset ] != data[ fixup_values_offset ] )
+			 || ( data[ fixup_value_offset + 1 ] != data[ fixup_values_offset + 1 ] ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: mismatch in fix-up value: %" PRIu16 ".",
+				 function,
+				 fixup_value_index );
+
+				return( -1 );
+			}
+			data[ fixup_value_offset ]     = data[ fixup_values_offset + ( 2 * (size_t) fixup_value_index ) ];
+			data[ fixup_value_offset + 1 ] = data[ fixup_values_offset + ( 2 * (size_t) fixup_value_index ) + 1 ];
+		}
+	}
+	/* Find the unnamed $DATA attribute
+	 */
+	attribute_offset = (size_t) attributes_offset;
+
+	while( attribute_offset <= ( data_size - 4 ) )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (vshadow_ntfs_mft_attribute_header_t *) &( data[ attribute_offset ] ) )->type,
+		 attribute_type );
+
+		if( attribute_type == LIBVSHADOW_NTFS_ATTRIBUTE_TYPE_END_OF_ATTRIBUTES )
+		{
+			break;
+		}
+		if( attribute_offset > ( data_size - sizeof( vshadow_ntfs_mft_attribute_header_t ) ) )
+		{
+			attribute_type = 0;
+
+			break;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (vshadow_ntfs_mft_attribute_header_t *) &( data[ attribute_offset ] ) )->size,
+		 attribute_size );
+
+		if( ( attribute_size < sizeof( vshadow_ntfs_mft_attribute_header_t ) )
+		 || ( (size_t) attribute_size > ( data_size - attribute_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid attribute size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( attribute_type == LIBVSHADOW_NTFS_ATTRIBUTE_TYPE_DATA )
+		 && ( ( (vshadow_ntfs_mft_attribute_header_t *) &( data[ attribute_offset ] ) )->name_size == 0 ) )
+		{
+			break;
+		}
+		attribute_offset += (size_t) attribute_size;
+	}
+	if( ( attribute_offset > ( data_size - 4 ) )
+	 || ( attribute_type != LIBVSHADOW_NTFS_ATTRIBUTE_TYPE_DATA ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing $DATA attribute.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (vshadow_ntfs_mft_attribute_header_t *) &( data[ attribute_offset ] ) )->data_flags,
+	 data_flags );
+
+	if( ( data_flags & LIBVSHADOW_NTFS_ATTRIBUTE_DATA_FLAGS_UNSUPPORTED ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported $DATA attribute data flags: 0x%04" PRIx16 ".",
+		 function,
+		 data_flags );
+
+		return( -1 );
+	}
+	allocation_bitmap->data_size = (size_t) ( ( allocation_bitmap->number_of_cluster_blocks + 7 ) / 8 );
+
+	if( ( allocation_bitmap->data_size == 0 )
+	 || ( ( ( allocation_bitmap->number_of_cluster_blocks + 7 ) / 8 ) > (uint64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid allocation bitmap - data size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	allocation_bitmap->data = (uint8_t *) memory_allocate(
+	                                       sizeof( uint8_t ) * allocation_bitmap->data_size );
+
+	if( allocation_bitmap->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     allocation_bitmap->data,
+	     0,
+	     sizeof( uint8_t ) * allocation_bitmap->data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( (vshadow_ntfs_mft_attribute_header_t *) &( data[ attribute_offset ] ) )->non_resident_flag == 0 )
+	{
+		if( attribute_size < ( sizeof( vshadow_ntfs_mft_attribute_header_t ) + sizeof( vshadow_ntfs_mft_attribute_resident_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid resident $DATA attribute size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		attribute_offset += sizeof( vshadow_ntfs_mft_attribute_header_t );
+		attribute_size   -= sizeof( vshadow_ntfs_mft_attribute_header_t );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (vshadow_ntfs_mft_attribute_resident_t *) &( data[ attribute_offset ] ) )->data_size,
+		 attribute_data_size );
+
+		byte_stream_copy_to_uint16_little_endian(
+		 ( (vshadow_ntfs_mft_attribute_resident_t *) &( data[ attribute_offset ] ) )->data_offset,
+		 resident_data_offset );
+
+		/* The resident data offset is relative to the start of the attribute
+		 */
+		if( ( resident_data_offset < sizeof( vshadow_ntfs_mft_attribute_header_t ) )
+		 || ( attribute_data_size < (uint64_t) allocation_bitmap->data_size )
+		 || ( attribute_data_size > (uint64_t) ( attribute_size + sizeof( vshadow_ntfs_mft_attribute_header_t ) - resident_data_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid resident $DATA attribute data size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     allocation_bitmap->data,
+		     &( data[ attribute_offset - sizeof( vshadow_ntfs_mft_attribute_header_t ) + resident_data_offset ] ),
+		     allocation_bitmap->data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy resident data.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	if( attribute_size < ( sizeof( vshadow_ntfs_mft_attribute_header_t ) + sizeof( vshadow_ntfs_mft_attribute_non_resident_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid non-resident $DATA attribute size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	data_runs_end_offset = attribute_offset + attribute_size;
+
+	attribute_offset += sizeof( vshadow_ntfs_mft_attribute_header_t );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vshadow_ntfs_mft_attribute_non_resident_t *) &( data[ attribute_offset ] ) )->data_first_vcn,
+	 first_vcn );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (vshadow_ntfs_mft_attribute_non_resident_t *) &( data[ attribute_offset ] ) )->data_runs_offset,
+	 data_runs_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vshadow_ntfs_mft_attribute_non_resident_t *) &( data[ attribute_offset ] ) )->data_size,
+	 attribute_data_size );
+
+	/* A $Bitmap file that is too fragmented to describe in a single MFT entry
+	 * is stored in multiple attribute extents, which is not supported
+	 */
+	if( first_vcn != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported $DATA attribute first VCN: %" PRIu64 ".",
+		 function,
+		 first_vcn );
+
+		goto on_error;
+	}
+	if( attribute_data_size < (uint64_t) allocation_bitmap->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid $DATA attribute data size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* The data runs offset is relative to the start of the attribute
+	 */
+	data_runs_offset += attribute_offset - sizeof( vshadow_ntfs_mft_attribute_header_t );
+
+	if( ( data_runs_offset < ( attribute_offset + sizeof( vshadow_ntfs_mft_attribute_non_resident_t ) ) )
+	 || ( data_runs_offset >= data_runs_end_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data runs offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* Every data run starts with a byte that contains the size of the run length
+	 * in the lower nibble and the size of the run offset in the upper nibble,
+	 * the run offset is a signed value relative to the previous run offset
+	 */
+	while( ( data_runs_offset < data_runs_end_offset )
+	    && ( data_runs_size < (size64_t) allocation_bitmap->data_size ) )
+	{
+		run_length_size = data[ data_runs_offset ] & 0x0f;
+		run_offset_size = data[ data_runs_offset ] >> 4;
+
+		if( run_length_size == 0 )
+		{
+			break;
+		}
+		if( ( run_length_size > 8 )
+		 || ( run_offset_size > 8 )
+		 || ( ( (size_t) run_length_size + run_offset_size ) >= ( data_runs_end_offset - data_runs_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid data run value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		data_runs_offset += 1;
+
+		run_length = 0;
+
+		for( byte_index = run_length_size;
+		     byte_index > 0;
+		     byte_index-- )
+		{
+			run_length <<= 8;
+			run_length  |= data[ data_runs_offset + byte_index - 1 ];
+		}
+		data_runs_offset += run_length_size;
+
+		run_offset = 0;
+
+		if( run_offset_size > 0 )
+		{
+			/* Sign extend the run offset
+			 */
+			if( ( data[ data_runs_offset + run_offset_size - 1 ] & 0x80 ) != 0 )
+			{
+				run_offset = -1;
+			}
+			for( byte_index = run_offset_size;
+			     byte_index > 0;
+			     byte_index-- )
+			{
+				run_offset = (int64_t) ( ( (uint64_t) run_offset << 8 ) | data[ data_runs_offset + byte_index - 1 ] );
+			}
+			data_runs_offset += run_offset_size;
+
+			cluster_block_number += run_offset;
+		}
+		if( ( run_length == 0 )
+		 || ( run_length > allocation_bitmap->number_of_cluster_blocks )
+		 || ( ( run_offset_size > 0 )
+		  && ( ( cluster_block_number < 0 )
+		   || ( (uint64_t) cluster_block_number > ( allocation_bitmap->number_of_cluster_blocks - run_length ) ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid data run: %d value out of bounds.",
+			 function,
+			 allocation_bitmap->number_of_data_runs );
+
+			goto on_error;
+		}
+		if( allocation_bitmap->number_of_data_runs >= maximum_number_of_data_runs )
+		{
+			maximum_number_of_data_runs += 16;
+
+			data_runs = (libvshadow_allocation_bitmap_data_run_t *) memory_reallocate(
+			                                                         allocation_bitmap->data_runs,
+			                                                         sizeof( libvshadow_allocation_bitmap_data_run_t ) * maximum_number_of_data_runs );
+
+			if( data_runs == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize data runs.",
+				 function );
+
+				goto on_error;
+			}
+			allocation_bitmap->data_runs = data_runs;
+		}
+		data_run = &( allocation_bitmap->data_runs[ allocation_bitmap->number_of_data_runs ] );
+
+		data_run->offset    = (off64_t) cluster_block_number * allocation_bitmap->cluster_block_size;
+		data_run->size      = (size64_t) run_length * allocation_bitmap->cluster_block_size;
+		data_run->is_sparse = (uint8_t) ( run_offset_size == 0 );
+
+		data_runs_size += data_run->size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: data run: %d offset: 0x%08" PRIx64 ", size: %" PRIu64 "%s\n",
+			 function,
+			 allocation_bitmap->number_of_data_runs,
+			 data_run->offset,
+			 data_run->size,
+			 ( data_run->is_sparse != 0 ) ? " (sparse)" : "" );
+		}
+#endif
+		allocation_bitmap->number_of_data_runs += 1;
+	}
+	if( data_runs_size < (size64_t) allocation_bitmap->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data runs - size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( allocation_bitmap->data_runs != NULL )
+	{
+		memory_free(
+		 allocation_bitmap->data_runs );
+
+		allocation_bitmap->data_runs = NULL;
+	}
+	allocation_bitmap->number_of_data_runs = 0;
+
+	if( allocation_bitmap->data != NULL )
+	{
+		memory_free(
+		 allocation_bitmap->data );
+
+		allocation_bitmap->data = NULL;
+	}
+	allocation_bitmap->data_size = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the extent at a specific offset that has the same allocation state
+ * The offset and size are relative to the start of the volume, data beyond
+ * the last cluster block of the file system is considered allocated
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_allocation_bitmap_get_extent(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     off64_t offset,
+     size64_t maximum_size,
+     size64_t *extent_size,
+     uint8_t *is_allocated,
+     libcerror_error_t **error )
+{
+	static char *function             = "libvshadow_allocation_bitmap_get_extent";
+	uint64_t cluster_block_number     = 0;
+	uint64_t end_cluster_block_number = 0;
+	uint64_t end_offset               = 0;
+	uint8_t allocation_byte           = 0;
+	uint8_t allocation_state          = 0;
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( allocation_bitmap->data == NULL )
+	 || ( allocation_bitmap->cluster_block_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid allocation bitmap - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_size == 0 )
+	 || ( maximum_size > (size64_t) ( INT64_MAX - offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_allocated == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is allocated.",
+		 function );
+
+		return( -1 );
+	}
+	cluster_block_number = (uint64_t) offset / allocation_bitmap->cluster_block_size;
+
+	if( cluster_block_number >= allocation_bitmap->number_of_cluster_blocks )
+	{
+		*extent_size  = maximum_size;
+		*is_allocated = 1;
+
+		return( 1 );
+	}
+	end_cluster_block_number = ( (uint64_t) offset + maximum_size + allocation_bitmap->cluster_block_size - 1 ) / allocation_bitmap->cluster_block_size;
+
+	if( end_cluster_block_number > allocation_bitmap->number_of_cluster_blocks )
+	{
+		end_cluster_block_number = allocation_bitmap->number_of_cluster_blocks;
+	}
+	allocation_state = ( allocation_bitmap->data[ cluster_block_number / 8 ] >> ( cluster_block_number % 8 ) ) & 0x01;
+
+	if( allocation_state != 0 )
+	{
+		allocation_byte = 0xff;
+	}
+	cluster_block_number++;
+
+	/* Whole bytes with the same allocation state are skipped at once
+	 */
+	while( cluster_block_number < end_cluster_block_number )
+	{
+		if( ( ( cluster_block_number % 8 ) == 0 )
+		 && ( ( end_cluster_block_number - cluster_block_number ) >= 8 )
+		 && ( allocation_bitmap->data[ cluster_block_number / 8 ] == allocation_byte ) )
+		{
+			cluster_block_number += 8;
+
+			continue;
+		}
+		if( ( ( allocation_bitmap->data[ cluster_block_number / 8 ] >> ( cluster_block_number % 8 ) ) & 0x01 ) != allocation_state )
+		{
+			break;
+		}
+		cluster_block_number++;
+	}
+	if( ( cluster_block_number >= allocation_bitmap->number_of_cluster_blocks )
+	 && ( allocation_state != 0 ) )
+	{
+		end_offset = (uint64_t) offset + maximum_size;
+	}
+	else
+	{
+		end_offset = cluster_block_number * allocation_bitmap->cluster_block_size;
+	}
+	*extent_size = (size64_t) ( end_offset - (uint64_t) offset );
+
+	if( *extent_size > maximum_size )
+	{
+		*extent_size = maximum_size;
+	}
+	*is_allocated = allocation_state;
+
+	return( 1 );
+}
+
@@ -0,0 +1,127 @@
+/*
+ * NTFS allocation bitmap functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_ALLOCATION_BITMAP_H )
+#define _LIBVSHADOW_ALLOCATION_BITMAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_allocation_bitmap_data_run libvshadow_allocation_bitmap_data_run_t;
+
+/* A data run of the $Bitmap file
+ */
+struct libvshadow_allocation_bitmap_data_run
+{
+	/* The offset of the data run in the volume
+	 */
+	off64_t offset;
+
+	/* The size of the data run
+	 */
+	size64_t size;
+
+	/* Value to indicate the data run is sparse
+	 */
+	uint8_t is_sparse;
+};
+
+typedef struct libvshadow_allocation_bitmap libvshadow_allocation_bitmap_t;
+
+/* The cluster block allocation of the NTFS file system in a store
+ * as stored in the $Bitmap file, bit N of the data is set
+ * if cluster block N is allocated
+ */
+struct libvshadow_allocation_bitmap
+{
+	/* The cluster block size
+	 */
+	size32_t cluster_block_size;
+
+	/* The number of cluster blocks
+	 */
+	uint64_t number_of_cluster_blocks;
+
+	/* The MFT offset
+	 */
+	off64_t mft_offset;
+
+	/* The MFT entry size
+	 */
+	size32_t mft_entry_size;
+
+	/* The data runs of the $Bitmap file
+	 */
+	libvshadow_allocation_bitmap_data_run_t *data_runs;
+
+	/* The number of data runs
+	 */
+	int number_of_data_runs;
+
+	/* The (bitmap) data
+	 */
+	uint8_t *data;
+
+	/* The (bitmap) data size
+	 */
+	size_t data_size;
+};
+
+int libvshadow_allocation_bitmap_initialize(
+     libvshadow_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error );
+
+int libvshadow_allocation_bitmap_free(
+     libvshadow_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error );
+
+int libvshadow_allocation_bitmap_read_volume_header_data(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvshadow_allocation_bitmap_read_mft_entry_data(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvshadow_allocation_bitmap_get_extent(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     off64_t offset,
+     size64_t maximum_size,
+     size64_t *extent_size,
+     uint8_t *is_allocated,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_ALLOCATION_BITMAP_H ) */
+
@@ -30,6 +30,7 @@
 #include "libvshadow_types.h"
 
 /* Creates a block
+ * The block contains a copy of the block descriptor
  * Make sure the value block is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
@@ -102,8 +103,23 @@ int libvshadow_block_initialize(
 
 		goto on_error;
 	}
-	internal_block->block_descriptor = block_descriptor;
+	/* The block descriptor is copied since the block descriptors of a store
+	 * can be evicted while the block is still in use
+	 */
+	if( libvshadow_block_descriptor_clone(
+	     &( internal_block->block_descriptor ),
+	     block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block descriptor.",
+		 function );
 
+		goto on_error;
+	}
 	*block = (libvshadow_block_t *) internal_block;
 
 	return( 1 );
@@ -144,6 +160,19 @@ int libvshadow_block_free(
 		internal_block = (libvshadow_internal_block_t *) *block;
 		*block         = NULL;
 
+		if( libvshadow_block_descriptor_free(
+		     &( internal_block->block_descriptor ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block descriptor.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 internal_block );
 	}
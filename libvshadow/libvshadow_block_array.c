@@ -0,0 +1,588 @@
+/*
+ * Block array functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libvshadow_block_array.h"
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_table.h"
+#include "libvshadow_libcerror.h"
+
+/* The block array contains the block descriptors sorted by original offset
+ * It is built once after the block lists have been read and is searched
+ * with a binary search
+ */
+
+/* Creates a block array
+ * Make sure the value block_array is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_array_initialize(
+     libvshadow_block_array_t **block_array,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_array_initialize";
+
+	if( block_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block array.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_array != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block array value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*block_array = memory_allocate_structure(
+	                libvshadow_block_array_t );
+
+	if( *block_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block array.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_array,
+	     0,
+	     sizeof( libvshadow_block_array_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *block_array != NULL )
+	{
+		memory_free(
+		 *block_array );
+
+		*block_array = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a block array and the block descriptors it contains
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_array_free(
+     libvshadow_block_array_t **block_array,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_array_free";
+	int block_index       = 0;
+	int result            = 1;
+
+	if( block_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block array.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_array != NULL )
+	{
+		if( ( *block_array )->block_descriptors != NULL )
+		{
+			for( block_index = 0;
+			     block_index < ( *block_array )->number_of_block_descriptors;
+			     block_index++ )
+			{
+				if( libvshadow_block_descriptor_free(
+				     &( ( *block_array )->block_descriptors[ block_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free block descriptor: %d.",
+					 function,
+					 block_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *block_array )->block_descriptors );
+		}
+		memory_free(
+		 *block_array );
+
+		*block_array = NULL;
+	}
+	return( result );
+}
+
+/* Compares 2 block descriptors by the original offset
+ * Returns a negative value, 0 or a positive value for use with qsort
+ */
+static int libvshadow_block_array_compare_block_descriptors(
+            const void *first_value,
+            const void *second_value )
+{
+	const libvshadow_block_descriptor_t *first_block_descriptor  = *( (libvshadow_block_descriptor_t * const *) first_value );
+	const libvshadow_block_descriptor_t *second_block_descriptor = *( (libvshadow_block_descriptor_t * const *) second_value );
+
+	if( first_block_descriptor->original_offset < second_block_descriptor->original_offset )
+	{
+		return( -1 );
+	}
+	else if( first_block_descriptor->original_offset > second_block_descriptor->original_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Builds the block array from the block descriptors in a block table
+ * The block descriptors are moved out of the block table, which is left empty,
+ * and are sorted by original offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_array_build_from_table(
+     libvshadow_block_array_t *block_array,
+     libvshadow_block_table_t *block_table,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t **block_descriptors = NULL;
+	static char *function                             = "libvshadow_block_array_build_from_table";
+	size_t block_descriptors_size                     = 0;
+	int number_of_block_descriptors                   = 0;
+
+	if( block_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block array.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_array->block_descriptors != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block array - block descriptors value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_block_table_get_number_of_block_descriptors(
+	     block_table,
+	     &number_of_block_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of block descriptors from block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_block_descriptors == 0 )
+	{
+		return( 1 );
+	}
+	if( (size_t) number_of_block_descriptors > ( (size_t) SSIZE_MAX / sizeof( libvshadow_block_descriptor_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of block descriptors value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	block_descriptors_size = sizeof( libvshadow_block_descriptor_t * ) * number_of_block_descriptors;
+
+	block_descriptors = (libvshadow_block_descriptor_t **) memory_allocate(
+	                                                        block_descriptors_size );
+
+	if( block_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_block_table_move_block_descriptors(
+	     block_table,
+	     block_descriptors,
+	     number_of_block_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to move block descriptors out of block table.",
+		 function );
+
+		memory_free(
+		 block_descriptors );
+
+		return( -1 );
+	}
+	/* Duplicate and overlay block descriptors have already been merged
+	 * by the block table, hence a single sort suffices
+	 */
+	qsort(
+	 block_descriptors,
+	 (size_t) number_of_block_descriptors,
+	 sizeof( libvshadow_block_descriptor_t * ),
+	 &libvshadow_block_array_compare_block_descriptors );
+
+	block_array->block_descriptors           = block_descriptors;
+	block_array->number_of_block_descriptors = number_of_block_descriptors;
+
+	return( 1 );
+}
+
+/* Retrieves the number of block descriptors
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_array_get_number_of_block_descriptors(
+     libvshadow_block_array_t *block_array,
+     int *number_of_block_descriptors,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_array_get_number_of_block_descriptors";
+
+	if( block_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block array.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_block_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_block_descriptors = block_array->number_of_block_descriptors;
+
+	return( 1 );
+}
+
+/* Retrieves a specific block descriptor
+ * The block descriptors are ordered by original offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_array_get_block_descriptor_by_index(
+     libvshadow_block_array_t *block_array,
+     int block_descriptor_index,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_array_get_block_descriptor_by_index";
+
+	if( block_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block array.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_descriptor_index < 0 )
+	 || ( block_descriptor_index >= block_array->number_of_block_descriptors ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block descriptor index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*block_descriptor = block_array->block_descriptors[ block_descriptor_index ];
+
+	return( 1 );
+}
+
+/* Retrieves the block descriptor of the block that contains a specific (original) offset
+ * Returns 1 if successful, 0 if no such block descriptor or -1 on error
+ */
+int libvshadow_block_array_get_block_descriptor_at_offset(
+     libvshadow_block_array_t *block_array,
+     off64_t offset,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t *safe_block_descriptor = NULL;
+	static char *function                                = "libvshadow_block_array_get_block_descriptor_at_offset";
+	int lower_index                                      = 0;
+	int middle_index                                     = 0;
+	int upper_index                                      = 0;
+
+	if( block_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block array.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the first block descriptor with an original offset beyond the offset
+	 */
+	upper_index = block_array->number_of_block_descriptors;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( block_array->block_descriptors[ middle_index ]->original_offset <= offset )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	if( lower_index == 0 )
+	{
+		return( 0 );
+	}
+	safe_block_descriptor = block_array->block_descriptors[ lower_index - 1 ];
+
+	if( offset >= ( safe_block_descriptor->original_offset + 0x4000 ) )
+	{
+		return( 0 );
+	}
+	*block_descriptor = safe_block_descriptor;
+
+	return( 1 );
+}
+
+/* Retrieves the indexes of the block descriptors of the blocks that overlap with a specific (original) range
+ * The block descriptors in the range are the number of block descriptors from the first block descriptor index
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_array_get_block_descriptor_indexes_in_range(
+     libvshadow_block_array_t *block_array,
+     off64_t offset,
+     size64_t size,
+     int *first_block_descriptor_index,
+     int *number_of_block_descriptors,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_array_get_block_descriptor_indexes_in_range";
+	off64_t end_offset    = 0;
+	int end_index         = 0;
+	int lower_index       = 0;
+	int middle_index      = 0;
+	int upper_index       = 0;
+
+	if( block_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block array.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_block_descriptor_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first block descriptor index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_block_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the first block descriptor of a block that ends beyond the offset
+	 */
+	upper_index = block_array->number_of_block_descriptors;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( ( block_array->block_descriptors[ middle_index ]->original_offset + 0x4000 ) <= offset )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	*first_block_descriptor_index = lower_index;
+
+	if( size == 0 )
+	{
+		*number_of_block_descriptors = 0;
+
+		return( 1 );
+	}
+	/* Determine the first block descriptor of a block that starts at or beyond the end of the range
+	 */
+	end_index = block_array->number_of_block_descriptors;
+
+	if( size <= (size64_t) ( INT64_MAX - offset ) )
+	{
+		end_offset  = offset + (off64_t) size;
+		upper_index = end_index;
+
+		while( lower_index < upper_index )
+		{
+			middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+			if( block_array->block_descriptors[ middle_index ]->original_offset < end_offset )
+			{
+				lower_index = middle_index + 1;
+			}
+			else
+			{
+				upper_index = middle_index;
+			}
+		}
+		end_index = lower_index;
+	}
+	*number_of_block_descriptors = end_index - *first_block_descriptor_index;
+
+	return( 1 );
+}
@@ -0,0 +1,92 @@
+/*
+ * Block array functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_BLOCK_ARRAY_H )
+#define _LIBVSHADOW_BLOCK_ARRAY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_table.h"
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_block_array libvshadow_block_array_t;
+
+struct libvshadow_block_array
+{
+	/* The block descriptors sorted by original offset
+	 */
+	libvshadow_block_descriptor_t **block_descriptors;
+
+	/* The number of block descriptors
+	 */
+	int number_of_block_descriptors;
+};
+
+int libvshadow_block_array_initialize(
+     libvshadow_block_array_t **block_array,
+     libcerror_error_t **error );
+
+int libvshadow_block_array_free(
+     libvshadow_block_array_t **block_array,
+     libcerror_error_t **error );
+
+int libvshadow_block_array_build_from_table(
+     libvshadow_block_array_t *block_array,
+     libvshadow_block_table_t *block_table,
+     libcerror_error_t **error );
+
+int libvshadow_block_array_get_number_of_block_descriptors(
+     libvshadow_block_array_t *block_array,
+     int *number_of_block_descriptors,
+     libcerror_error_t **error );
+
+int libvshadow_block_array_get_block_descriptor_by_index(
+     libvshadow_block_array_t *block_array,
+     int block_descriptor_index,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_array_get_block_descriptor_at_offset(
+     libvshadow_block_array_t *block_array,
+     off64_t offset,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_array_get_block_descriptor_indexes_in_range(
+     libvshadow_block_array_t *block_array,
+     off64_t offset,
+     size64_t size,
+     int *first_block_descriptor_index,
+     int *number_of_block_descriptors,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_BLOCK_ARRAY_H ) */
+
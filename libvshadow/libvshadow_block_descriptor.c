@@ -33,6 +33,20 @@
 
 #include "vshadow_store.h"
 
+/* The number of bytes covered by a single bit of the overlay bitmap
+ */
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_OVERLAY_SECTOR_SIZE	512
+
+#if !defined( __GNUC__ ) && !defined( __clang__ )
+
+/* Table to determine the index of the lowest bit set using a De Bruijn sequence
+ */
+static const uint8_t libvshadow_block_descriptor_de_bruijn_bit_index[ 32 ] = {
+	0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+	31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9 };
+
+#endif /* !defined( __GNUC__ ) && !defined( __clang__ ) */
+
 const uint8_t vshadow_empty_store_block_list_entry[ 32 ] = {
 	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
@@ -674,3 +688,99 @@ int libvshadow_block_descriptor_read_data(
 	return( 1 );
 }
 
+/* Determines the number of trailing (least significant) zero bits of a non-zero value
+ * Returns the number of trailing zero bits
+ */
+static uint8_t libvshadow_block_descriptor_get_number_of_trailing_zero_bits(
+                uint32_t value )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+	return( (uint8_t) __builtin_ctz( (unsigned int) value ) );
+#else
+	return( libvshadow_block_descriptor_de_bruijn_bit_index[ (uint32_t) ( ( value & ( ~value + 1 ) ) * 0x077cb531UL ) >> 27 ] );
+#endif
+}
+
+/* Determines the overlay run at a relative offset within the block
+ * The run size is the number of bytes, starting at the relative offset, that are
+ * either all stored in the overlay or all not stored in the overlay, which does
+ * not exceed the end of the block
+ * Returns 1 if the data at the relative offset is stored in the overlay, 0 if not or -1 on error
+ */
+int libvshadow_block_descriptor_get_overlay_run(
+     libvshadow_block_descriptor_t *block_descriptor,
+     uint32_t relative_offset,
+     size_t *run_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libvshadow_block_descriptor_get_overlay_run";
+	uint32_t bitmap           = 0;
+	uint8_t number_of_bits    = 0;
+	uint8_t number_of_sectors = 0;
+	uint8_t sector_index      = 0;
+	int result                = 0;
+
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( relative_offset >= ( 32 * LIBVSHADOW_BLOCK_DESCRIPTOR_OVERLAY_SECTOR_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid relative offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run size.",
+		 function );
+
+		return( -1 );
+	}
+	sector_index = (uint8_t) ( relative_offset / LIBVSHADOW_BLOCK_DESCRIPTOR_OVERLAY_SECTOR_SIZE );
+	bitmap       = block_descriptor->bitmap >> sector_index;
+
+	if( ( bitmap & 0x00000001UL ) != 0 )
+	{
+		result = 1;
+	}
+	else
+	{
+		bitmap = ~bitmap;
+	}
+	/* The run ends at the first bit that differs from the bit at the relative offset
+	 * or at the end of the block
+	 */
+	number_of_sectors = 32 - sector_index;
+
+	if( ~bitmap != 0 )
+	{
+		number_of_bits = libvshadow_block_descriptor_get_number_of_trailing_zero_bits(
+		                  ~bitmap );
+
+		if( number_of_bits < number_of_sectors )
+		{
+			number_of_sectors = number_of_bits;
+		}
+	}
+	*run_size = ( (size_t) number_of_sectors * LIBVSHADOW_BLOCK_DESCRIPTOR_OVERLAY_SECTOR_SIZE )
+	          - ( relative_offset % LIBVSHADOW_BLOCK_DESCRIPTOR_OVERLAY_SECTOR_SIZE );
+
+	return( result );
+}
@@ -117,6 +117,12 @@ int libvshadow_block_descriptor_read_data(
      int store_index,
      libcerror_error_t **error );
 
+int libvshadow_block_descriptor_get_overlay_run(
+     libvshadow_block_descriptor_t *block_descriptor,
+     uint32_t relative_offset,
+     size_t *run_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
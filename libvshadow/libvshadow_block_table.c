@@ -0,0 +1,831 @@
+/*
+ * Block table functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_table.h"
+#include "libvshadow_libcerror.h"
+
+/* The block table is an open addressing hash table with linear probing
+ * The entries are hashed by block number so that the block that contains
+ * an offset can be found without an ordered search
+ */
+
+/* The number of bits of the number of entries on first insert
+ */
+#define LIBVSHADOW_BLOCK_TABLE_INITIAL_NUMBER_OF_BITS	8
+
+/* The maximum number of bits of the number of entries
+ */
+#define LIBVSHADOW_BLOCK_TABLE_MAXIMUM_NUMBER_OF_BITS	28
+
+#define libvshadow_block_table_get_entry_index( block_table, offset ) \
+	(int) ( ( ( (uint64_t) ( offset ) >> 14 ) * 0x9e3779b97f4a7c15ULL ) >> ( 64 - ( block_table )->number_of_bits ) )
+
+/* Creates a block table
+ * Make sure the value block_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_table_initialize(
+     libvshadow_block_table_t **block_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_table_initialize";
+
+	if( block_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*block_table = memory_allocate_structure(
+	                libvshadow_block_table_t );
+
+	if( *block_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_table,
+	     0,
+	     sizeof( libvshadow_block_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block table.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *block_table != NULL )
+	{
+		memory_free(
+		 *block_table );
+
+		*block_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a block table
+ * The block descriptor free function is called for every block descriptor in the table
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_table_free(
+     libvshadow_block_table_t **block_table,
+     int (*block_descriptor_free_function)(
+            libvshadow_block_descriptor_t **block_descriptor,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_table_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( block_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_table != NULL )
+	{
+		if( ( *block_table )->entries != NULL )
+		{
+			if( block_descriptor_free_function != NULL )
+			{
+				for( entry_index = 0;
+				     entry_index < ( *block_table )->number_of_entries;
+				     entry_index++ )
+				{
+					if( ( *block_table )->entries[ entry_index ].block_descriptor == NULL )
+					{
+						continue;
+					}
+					if( block_descriptor_free_function(
+					     &( ( *block_table )->entries[ entry_index ].block_descriptor ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free block descriptor: %d.",
+						 function,
+						 entry_index );
+
+						result = -1;
+					}
+				}
+			}
+			memory_free(
+			 ( *block_table )->entries );
+		}
+		memory_free(
+		 *block_table );
+
+		*block_table = NULL;
+	}
+	return( result );
+}
+
+/* Resizes the block table
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_table_resize(
+     libvshadow_block_table_t *block_table,
+     uint8_t number_of_bits,
+     libcerror_error_t **error )
+{
+	libvshadow_block_table_entry_t *entries = NULL;
+	static char *function                   = "libvshadow_block_table_resize";
+	size_t entries_size                     = 0;
+	int entry_index                         = 0;
+	int number_of_entries                   = 0;
+	int old_entry_index                     = 0;
+	int old_number_of_entries               = 0;
+
+	if( block_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_bits == 0 )
+	 || ( number_of_bits > LIBVSHADOW_BLOCK_TABLE_MAXIMUM_NUMBER_OF_BITS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of bits value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_entries = 1 << number_of_bits;
+
+	if( number_of_entries < ( 2 * block_table->number_of_block_descriptors ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of bits value too small.",
+		 function );
+
+		return( -1 );
+	}
+	entries_size = sizeof( libvshadow_block_table_entry_t ) * number_of_entries;
+
+	if( entries_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid entries size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	entries = (libvshadow_block_table_entry_t *) memory_allocate(
+	                                              entries_size );
+
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		memory_free(
+		 entries );
+
+		return( -1 );
+	}
+	old_number_of_entries = block_table->number_of_entries;
+
+	block_table->number_of_bits    = number_of_bits;
+	block_table->number_of_entries = number_of_entries;
+
+	if( block_table->entries != NULL )
+	{
+		for( old_entry_index = 0;
+		     old_entry_index < old_number_of_entries;
+		     old_entry_index++ )
+		{
+			if( block_table->entries[ old_entry_index ].block_descriptor == NULL )
+			{
+				continue;
+			}
+			entry_index = libvshadow_block_table_get_entry_index(
+			               block_table,
+			               block_table->entries[ old_entry_index ].offset );
+
+			while( entries[ entry_index ].block_descriptor != NULL )
+			{
+				entry_index = ( entry_index + 1 ) & ( number_of_entries - 1 );
+			}
+			entries[ entry_index ] = block_table->entries[ old_entry_index ];
+		}
+		memory_free(
+		 block_table->entries );
+	}
+	block_table->entries = entries;
+
+	return( 1 );
+}
+
+/* Retrieves the number of block descriptors
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_table_get_number_of_block_descriptors(
+     libvshadow_block_table_t *block_table,
+     int *number_of_block_descriptors,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_table_get_number_of_block_descriptors";
+
+	if( block_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_block_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_block_descriptors = block_table->number_of_block_descriptors;
+
+	return( 1 );
+}
+
+/* Retrieves the block descriptor stored with a specific offset
+ * Returns 1 if successful, 0 if no such block descriptor or -1 on error
+ */
+int libvshadow_block_table_get_block_descriptor_by_offset(
+     libvshadow_block_table_t *block_table,
+     off64_t offset,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_table_get_block_descriptor_by_offset";
+	int entry_index       = 0;
+
+	if( block_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*block_descriptor = NULL;
+
+	if( block_table->number_of_block_descriptors == 0 )
+	{
+		return( 0 );
+	}
+	entry_index = libvshadow_block_table_get_entry_index(
+	               block_table,
+	               offset );
+
+	while( block_table->entries[ entry_index ].block_descriptor != NULL )
+	{
+		if( block_table->entries[ entry_index ].offset == offset )
+		{
+			*block_descriptor = block_table->entries[ entry_index ].block_descriptor;
+
+			return( 1 );
+		}
+		entry_index = ( entry_index + 1 ) & ( block_table->number_of_entries - 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the block descriptor of the block that contains a specific offset
+ * Every block descriptor in the table is considered to cover 16 KiB starting at its offset
+ * Returns 1 if successful, 0 if no such block descriptor or -1 on error
+ */
+int libvshadow_block_table_get_block_descriptor_at_offset(
+     libvshadow_block_table_t *block_table,
+     off64_t offset,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_table_get_block_descriptor_at_offset";
+	off64_t block_offset  = 0;
+	off64_t entry_offset  = 0;
+	int entry_index       = 0;
+	int result            = 0;
+	int search_index      = 0;
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	block_offset = offset - ( offset % 0x4000 );
+
+	result = libvshadow_block_table_get_block_descriptor_by_offset(
+	          block_table,
+	          block_offset,
+	          block_descriptor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block descriptor for offset: 0x%08" PRIx64 ".",
+		 function,
+		 block_offset );
+
+		return( -1 );
+	}
+	else if( ( result != 0 )
+	      || ( block_table->has_unaligned_offsets == 0 ) )
+	{
+		return( result );
+	}
+	/* A block that does not start at a block boundary is hashed by the block number
+	 * of its offset, which is either the block number of the offset or the one before it
+	 */
+	for( search_index = 0;
+	     search_index < 2;
+	     search_index++ )
+	{
+		if( block_offset < ( search_index * 0x4000 ) )
+		{
+			break;
+		}
+		entry_index = libvshadow_block_table_get_entry_index(
+		               block_table,
+		               block_offset - ( search_index * 0x4000 ) );
+
+		while( block_table->entries[ entry_index ].block_descriptor != NULL )
+		{
+			entry_offset = block_table->entries[ entry_index ].offset;
+
+			if( ( offset >= entry_offset )
+			 && ( offset < ( entry_offset + 0x4000 ) ) )
+			{
+				*block_descriptor = block_table->entries[ entry_index ].block_descriptor;
+
+				return( 1 );
+			}
+			entry_index = ( entry_index + 1 ) & ( block_table->number_of_entries - 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Inserts a block descriptor with a specific offset
+ * If a block descriptor with the same offset is already stored it is returned
+ * in existing block descriptor and the table is not changed
+ * Returns 1 if successful, 0 if a block descriptor with the offset already exists or -1 on error
+ */
+int libvshadow_block_table_insert_block_descriptor(
+     libvshadow_block_table_t *block_table,
+     off64_t offset,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libvshadow_block_descriptor_t **existing_block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function  = "libvshadow_block_table_insert_block_descriptor";
+	uint8_t number_of_bits = 0;
+	int entry_index        = 0;
+
+	if( block_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( existing_block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid existing block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*existing_block_descriptor = NULL;
+
+	/* Keep at least half of the entries empty to keep the probe sequences short
+	 */
+	if( ( 2 * ( block_table->number_of_block_descriptors + 1 ) ) > block_table->number_of_entries )
+	{
+		if( block_table->number_of_bits == 0 )
+		{
+			number_of_bits = LIBVSHADOW_BLOCK_TABLE_INITIAL_NUMBER_OF_BITS;
+		}
+		else
+		{
+			number_of_bits = block_table->number_of_bits + 1;
+		}
+		if( libvshadow_block_table_resize(
+		     block_table,
+		     number_of_bits,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize block table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	entry_index = libvshadow_block_table_get_entry_index(
+	               block_table,
+	               offset );
+
+	while( block_table->entries[ entry_index ].block_descriptor != NULL )
+	{
+		if( block_table->entries[ entry_index ].offset == offset )
+		{
+			*existing_block_descriptor = block_table->entries[ entry_index ].block_descriptor;
+
+			return( 0 );
+		}
+		entry_index = ( entry_index + 1 ) & ( block_table->number_of_entries - 1 );
+	}
+	block_table->entries[ entry_index ].offset           = offset;
+	block_table->entries[ entry_index ].block_descriptor = block_descriptor;
+
+	block_table->number_of_block_descriptors += 1;
+
+	if( ( offset % 0x4000 ) != 0 )
+	{
+		block_table->has_unaligned_offsets = 1;
+	}
+	return( 1 );
+}
+
+/* Replaces the block descriptor stored with a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_table_replace_block_descriptor(
+     libvshadow_block_table_t *block_table,
+     off64_t offset,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_table_replace_block_descriptor";
+	int entry_index       = 0;
+
+	if( block_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_table->number_of_block_descriptors > 0 )
+	{
+		entry_index = libvshadow_block_table_get_entry_index(
+		               block_table,
+		               offset );
+
+		while( block_table->entries[ entry_index ].block_descriptor != NULL )
+		{
+			if( block_table->entries[ entry_index ].offset == offset )
+			{
+				block_table->entries[ entry_index ].block_descriptor = block_descriptor;
+
+				return( 1 );
+			}
+			entry_index = ( entry_index + 1 ) & ( block_table->number_of_entries - 1 );
+		}
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+	 "%s: missing block descriptor for offset: 0x%08" PRIx64 ".",
+	 function,
+	 offset );
+
+	return( -1 );
+}
+
+/* Removes the block descriptor stored with a specific offset
+ * The block descriptor itself is not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_table_remove_block_descriptor(
+     libvshadow_block_table_t *block_table,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function    = "libvshadow_block_table_remove_block_descriptor";
+	int empty_entry_index    = 0;
+	int entry_index          = 0;
+	int home_entry_index     = 0;
+	int is_in_probe_sequence = 0;
+
+	if( block_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_table->number_of_block_descriptors > 0 )
+	{
+		entry_index = libvshadow_block_table_get_entry_index(
+		               block_table,
+		               offset );
+
+		while( block_table->entries[ entry_index ].block_descriptor != NULL )
+		{
+			if( block_table->entries[ entry_index ].offset == offset )
+			{
+				break;
+			}
+			entry_index = ( entry_index + 1 ) & ( block_table->number_of_entries - 1 );
+		}
+	}
+	if( ( block_table->number_of_block_descriptors == 0 )
+	 || ( block_table->entries[ entry_index ].block_descriptor == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing block descriptor for offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	/* Move entries that follow in the same probe sequence back into the emptied entry
+	 * so that no markers of removed entries are needed
+	 */
+	empty_entry_index = entry_index;
+
+	for( ;; )
+	{
+		entry_index = ( entry_index + 1 ) & ( block_table->number_of_entries - 1 );
+
+		if( block_table->entries[ entry_index ].block_descriptor == NULL )
+		{
+			break;
+		}
+		home_entry_index = libvshadow_block_table_get_entry_index(
+		                    block_table,
+		                    block_table->entries[ entry_index ].offset );
+
+		/* The entry stays if its home entry lies cyclically in ( empty_entry_index, entry_index ]
+		 */
+		if( empty_entry_index <= entry_index )
+		{
+			is_in_probe_sequence = ( ( empty_entry_index < home_entry_index ) && ( home_entry_index <= entry_index ) );
+		}
+		else
+		{
+			is_in_probe_sequence = ( ( empty_entry_index < home_entry_index ) || ( home_entry_index <= entry_index ) );
+		}
+		if( is_in_probe_sequence == 0 )
+		{
+			block_table->entries[ empty_entry_index ] = block_table->entries[ entry_index ];
+
+			empty_entry_index = entry_index;
+		}
+	}
+	block_table->entries[ empty_entry_index ].offset           = 0;
+	block_table->entries[ empty_entry_index ].block_descriptor = NULL;
+
+	block_table->number_of_block_descriptors -= 1;
+
+	return( 1 );
+}
+
+/* Moves the block descriptors out of the block table
+ * The block descriptors are stored in table order and the table is emptied
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_table_move_block_descriptors(
+     libvshadow_block_table_t *block_table,
+     libvshadow_block_descriptor_t **block_descriptors,
+     int number_of_block_descriptors,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_table_move_block_descriptors";
+	int block_index       = 0;
+	int entry_index       = 0;
+
+	if( block_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_block_descriptors < block_table->number_of_block_descriptors )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of block descriptors value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < block_table->number_of_entries;
+	     entry_index++ )
+	{
+		if( block_table->entries[ entry_index ].block_descriptor == NULL )
+		{
+			continue;
+		}
+		block_descriptors[ block_index++ ] = block_table->entries[ entry_index ].block_descriptor;
+
+		block_table->entries[ entry_index ].offset           = 0;
+		block_table->entries[ entry_index ].block_descriptor = NULL;
+	}
+	block_table->number_of_block_descriptors = 0;
+	block_table->has_unaligned_offsets       = 0;
+
+	return( 1 );
+}
@@ -0,0 +1,135 @@
+/*
+ * Block table functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_BLOCK_TABLE_H )
+#define _LIBVSHADOW_BLOCK_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_block_table_entry libvshadow_block_table_entry_t;
+
+struct libvshadow_block_table_entry
+{
+	/* The (block) offset
+	 */
+	off64_t offset;
+
+	/* The block descriptor
+	 */
+	libvshadow_block_descriptor_t *block_descriptor;
+};
+
+typedef struct libvshadow_block_table libvshadow_block_table_t;
+
+struct libvshadow_block_table
+{
+	/* The entries
+	 */
+	libvshadow_block_table_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of bits of the number of entries
+	 */
+	uint8_t number_of_bits;
+
+	/* The number of block descriptors
+	 */
+	int number_of_block_descriptors;
+
+	/* Value to indicate the table contains offsets that are not block aligned
+	 */
+	uint8_t has_unaligned_offsets;
+};
+
+int libvshadow_block_table_initialize(
+     libvshadow_block_table_t **block_table,
+     libcerror_error_t **error );
+
+int libvshadow_block_table_free(
+     libvshadow_block_table_t **block_table,
+     int (*block_descriptor_free_function)(
+            libvshadow_block_descriptor_t **block_descriptor,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libvshadow_block_table_resize(
+     libvshadow_block_table_t *block_table,
+     uint8_t number_of_bits,
+     libcerror_error_t **error );
+
+int libvshadow_block_table_get_number_of_block_descriptors(
+     libvshadow_block_table_t *block_table,
+     int *number_of_block_descriptors,
+     libcerror_error_t **error );
+
+int libvshadow_block_table_get_block_descriptor_by_offset(
+     libvshadow_block_table_t *block_table,
+     off64_t offset,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_table_get_block_descriptor_at_offset(
+     libvshadow_block_table_t *block_table,
+     off64_t offset,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_table_insert_block_descriptor(
+     libvshadow_block_table_t *block_table,
+     off64_t offset,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libvshadow_block_descriptor_t **existing_block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_table_replace_block_descriptor(
+     libvshadow_block_table_t *block_table,
+     off64_t offset,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_table_remove_block_descriptor(
+     libvshadow_block_table_t *block_table,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libvshadow_block_table_move_block_descriptors(
+     libvshadow_block_table_t *block_table,
+     libvshadow_block_descriptor_t **block_descriptors,
+     int number_of_block_descriptors,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_BLOCK_TABLE_H ) */
+
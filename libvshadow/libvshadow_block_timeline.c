@@ -0,0 +1,831 @@
+/*
+ * Block timeline functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_LIMITS_H ) || defined( WINAPI )
+#include <limits.h>
+#endif
+
+#include "libvshadow_block_timeline.h"
+#include "libvshadow_libcerror.h"
+
+/* The block timeline contains for every block of the volume that was changed
+ * the set of stores that contain a different version of the block than
+ * the next store or, for the most recent store, the current volume.
+ * The version of a block in a store is that of the first store in
+ * the set from that store onwards, or the current volume if there is none
+ */
+
+/* Creates a block timeline
+ * Make sure the value block_timeline is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_timeline_initialize(
+     libvshadow_block_timeline_t **block_timeline,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_timeline_initialize";
+
+	if( block_timeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block timeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_timeline != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block timeline value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*block_timeline = memory_allocate_structure(
+	                   libvshadow_block_timeline_t );
+
+	if( *block_timeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block timeline.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_timeline,
+	     0,
+	     sizeof( libvshadow_block_timeline_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block timeline.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *block_timeline != NULL )
+	{
+		memory_free(
+		 *block_timeline );
+
+		*block_timeline = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a block timeline
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_timeline_free(
+     libvshadow_block_timeline_t **block_timeline,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_timeline_free";
+
+	if( block_timeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block timeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_timeline != NULL )
+	{
+		if( ( *block_timeline )->block_offsets != NULL )
+		{
+			memory_free(
+			 ( *block_timeline )->block_offsets );
+		}
+		if( ( *block_timeline )->store_bitmaps != NULL )
+		{
+			memory_free(
+			 ( *block_timeline )->store_bitmaps );
+		}
+		memory_free(
+		 *block_timeline );
+
+		*block_timeline = NULL;
+	}
+	return( 1 );
+}
+
+/* Restores the heap order, of the stores ordered by the offset of their current block,
+ * from a specific heap index downwards
+ */
+static void libvshadow_block_timeline_heap_sift_down(
+             int *heap,
+             int heap_size,
+             const off64_t *current_offsets,
+             int heap_index )
+{
+	int child_index = 0;
+	int store_index = heap[ heap_index ];
+
+	while( heap_index < ( heap_size / 2 ) )
+	{
+		child_index = ( 2 * heap_index ) + 1;
+
+		if( ( ( child_index + 1 ) < heap_size )
+		 && ( current_offsets[ heap[ child_index + 1 ] ] < current_offsets[ heap[ child_index ] ] ) )
+		{
+			child_index++;
+		}
+		if( current_offsets[ store_index ] <= current_offsets[ heap[ child_index ] ] )
+		{
+			break;
+		}
+		heap[ heap_index ] = heap[ child_index ];
+		heap_index         = child_index;
+	}
+	heap[ heap_index ] = store_index;
+}
+
+/* Builds the block timeline from the (original) block offsets of the stores
+ * The block offsets of every store must be sorted, as those of the forward block
+ * descriptors array. The block offsets of all stores are merged in a single pass
+ * using a heap of the stores, hence for n block offsets in k stores the build
+ * takes O(n log k) time
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_timeline_build(
+     libvshadow_block_timeline_t *block_timeline,
+     off64_t **store_block_offsets,
+     int *store_number_of_block_offsets,
+     int number_of_stores,
+     libcerror_error_t **error )
+{
+	off64_t *current_offsets     = NULL;
+	off64_t *reallocation        = NULL;
+	uint64_t *store_bitmap       = NULL;
+	static char *function        = "libvshadow_block_timeline_build";
+	size_t bitmaps_size          = 0;
+	off64_t block_offset         = 0;
+	int *heap                    = NULL;
+	int *store_block_indexes     = NULL;
+	int heap_index               = 0;
+	int heap_size                = 0;
+	int maximum_number_of_blocks = 0;
+	int number_of_bitmap_entries = 0;
+	int store_index              = 0;
+
+	if( block_timeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block timeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_timeline->block_offsets != NULL )
+	 || ( block_timeline->store_bitmaps != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block timeline - blocks value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_stores < 0 )
+	 || ( (size_t) number_of_stores > ( (size_t) SSIZE_MAX / sizeof( off64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of stores value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	block_timeline->number_of_stores         = number_of_stores;
+	block_timeline->number_of_bitmap_entries = ( number_of_stores + 63 ) / 64;
+	block_timeline->number_of_blocks         = 0;
+
+	if( number_of_stores == 0 )
+	{
+		return( 1 );
+	}
+	if( store_block_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store block offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_number_of_block_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store number of block offsets.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_bitmap_entries = block_timeline->number_of_bitmap_entries;
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( store_number_of_block_offsets[ store_index ] == 0 )
+		{
+			continue;
+		}
+		if( ( store_number_of_block_offsets[ store_index ] < 0 )
+		 || ( store_number_of_block_offsets[ store_index ] > ( INT_MAX - maximum_number_of_blocks ) )
+		 || ( store_block_offsets[ store_index ] == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid store: %d block offsets value out of bounds.",
+			 function,
+			 store_index );
+
+			return( -1 );
+		}
+		maximum_number_of_blocks += store_number_of_block_offsets[ store_index ];
+	}
+	if( maximum_number_of_blocks == 0 )
+	{
+		return( 1 );
+	}
+	if( ( (size_t) maximum_number_of_blocks > ( (size_t) SSIZE_MAX / sizeof( off64_t ) ) )
+	 || ( (size_t) maximum_number_of_blocks > ( (size_t) SSIZE_MAX / ( sizeof( uint64_t ) * number_of_bitmap_entries ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum number of blocks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	bitmaps_size = sizeof( uint64_t ) * number_of_bitmap_entries * maximum_number_of_blocks;
+
+	block_timeline->block_offsets = (off64_t *) memory_allocate(
+	                                             sizeof( off64_t ) * maximum_number_of_blocks );
+
+	if( block_timeline->block_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block offsets.",
+		 function );
+
+		goto on_error;
+	}
+	block_timeline->store_bitmaps = (uint64_t *) memory_allocate(
+	                                              bitmaps_size );
+
+	if( block_timeline->store_bitmaps == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create store bitmaps.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     block_timeline->store_bitmaps,
+	     0,
+	     bitmaps_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear store bitmaps.",
+		 function );
+
+		goto on_error;
+	}
+	current_offsets = (off64_t *) memory_allocate(
+	                               sizeof( off64_t ) * number_of_stores );
+
+	if( current_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create current offsets.",
+		 function );
+
+		goto on_error;
+	}
+	heap = (int *) memory_allocate(
+	                sizeof( int ) * number_of_stores );
+
+	if( heap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create heap.",
+		 function );
+
+		goto on_error;
+	}
+	store_block_indexes = (int *) memory_allocate(
+	                               sizeof( int ) * number_of_stores );
+
+	if( store_block_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create store block indexes.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		store_block_indexes[ store_index ] = 0;
+
+		if( store_number_of_block_offsets[ store_index ] == 0 )
+		{
+			continue;
+		}
+		block_offset = store_block_offsets[ store_index ][ 0 ];
+
+		if( block_offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+			 "%s: invalid store: %d block offset: 0 value less than zero.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		current_offsets[ store_index ] = block_offset - ( block_offset % 0x4000 );
+
+		heap[ heap_size++ ] = store_index;
+	}
+	for( heap_index = ( heap_size / 2 ) - 1;
+	     heap_index >= 0;
+	     heap_index-- )
+	{
+		libvshadow_block_timeline_heap_sift_down(
+		 heap,
+		 heap_size,
+		 current_offsets,
+		 heap_index );
+	}
+	/* Every block offset is taken from the store with the smallest current offset,
+	 * consecutive equal offsets of different stores are merged into a single block
+	 */
+	while( heap_size > 0 )
+	{
+		store_index  = heap[ 0 ];
+		block_offset = current_offsets[ store_index ];
+
+		if( ( block_timeline->number_of_blocks == 0 )
+		 || ( block_timeline->block_offsets[ block_timeline->number_of_blocks - 1 ] != block_offset ) )
+		{
+			block_timeline->block_offsets[ block_timeline->number_of_blocks ] = block_offset;
+
+			block_timeline->number_of_blocks += 1;
+		}
+		store_bitmap = &( block_timeline->store_bitmaps[ ( block_timeline->number_of_blocks - 1 ) * number_of_bitmap_entries ] );
+
+		store_bitmap[ store_index / 64 ] |= (uint64_t) 1 << ( store_index % 64 );
+
+		store_block_indexes[ store_index ] += 1;
+
+		if( store_block_indexes[ store_index ] < store_number_of_block_offsets[ store_index ] )
+		{
+			block_offset = store_block_offsets[ store_index ][ store_block_indexes[ store_index ] ];
+			block_offset = block_offset - ( block_offset % 0x4000 );
+
+			if( block_offset < current_offsets[ store_index ] )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid store: %d block offset: %d value out of bounds - block offsets not sorted.",
+				 function,
+				 store_index,
+				 store_block_indexes[ store_index ] );
+
+				goto on_error;
+			}
+			current_offsets[ store_index ] = block_offset;
+		}
+		else
+		{
+			heap_size -= 1;
+
+			heap[ 0 ] = heap[ heap_size ];
+		}
+		if( heap_size > 0 )
+		{
+			libvshadow_block_timeline_heap_sift_down(
+			 heap,
+			 heap_size,
+			 current_offsets,
+			 0 );
+		}
+	}
+	memory_free(
+	 store_block_indexes );
+
+	store_block_indexes = NULL;
+
+	memory_free(
+	 heap );
+
+	heap = NULL;
+
+	memory_free(
+	 current_offsets );
+
+	current_offsets = NULL;
+
+	/* Blocks that were changed in multiple stores are stored once,
+	 * hence release the unused part of the arrays
+	 */
+	if( block_timeline->number_of_blocks < maximum_number_of_blocks )
+	{
+		reallocation = (off64_t *) memory_reallocate(
+		                            block_timeline->block_offsets,
+		                            sizeof( off64_t ) * block_timeline->number_of_blocks );
+
+		if( reallocation != NULL )
+		{
+			block_timeline->block_offsets = reallocation;
+		}
+		store_bitmap = (uint64_t *) memory_reallocate(
+		                             block_timeline->store_bitmaps,
+		                             sizeof( uint64_t ) * number_of_bitmap_entries * block_timeline->number_of_blocks );
+
+		if( store_bitmap != NULL )
+		{
+			block_timeline->store_bitmaps = store_bitmap;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( store_block_indexes != NULL )
+	{
+		memory_free(
+		 store_block_indexes );
+	}
+	if( heap != NULL )
+	{
+		memory_free(
+		 heap );
+	}
+	if( current_offsets != NULL )
+	{
+		memory_free(
+		 current_offsets );
+	}
+	if( block_timeline->store_bitmaps != NULL )
+	{
+		memory_free(
+		 block_timeline->store_bitmaps );
+
+		block_timeline->store_bitmaps = NULL;
+	}
+	if( block_timeline->block_offsets != NULL )
+	{
+		memory_free(
+		 block_timeline->block_offsets );
+
+		block_timeline->block_offsets = NULL;
+	}
+	block_timeline->number_of_blocks = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the number of blocks that were changed in one or more stores
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_timeline_get_number_of_blocks(
+     libvshadow_block_timeline_t *block_timeline,
+     int *number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_timeline_get_number_of_blocks";
+
+	if( block_timeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block timeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_blocks = block_timeline->number_of_blocks;
+
+	return( 1 );
+}
+
+/* Retrieves the (original) offset of a specific block
+ * The blocks are ordered by offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_timeline_get_block_offset_by_index(
+     libvshadow_block_timeline_t *block_timeline,
+     int block_index,
+     off64_t *block_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_timeline_get_block_offset_by_index";
+
+	if( block_timeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block timeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_index < 0 )
+	 || ( block_index >= block_timeline->number_of_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block offset.",
+		 function );
+
+		return( -1 );
+	}
+	*block_offset = block_timeline->block_offsets[ block_index ];
+
+	return( 1 );
+}
+
+/* Retrieves the index of the block that contains a specific (original) offset
+ * Returns 1 if successful, 0 if the block was not changed in any store or -1 on error
+ */
+int libvshadow_block_timeline_get_block_index_at_offset(
+     libvshadow_block_timeline_t *block_timeline,
+     off64_t offset,
+     int *block_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_timeline_get_block_index_at_offset";
+	off64_t block_offset  = 0;
+	int lower_index       = 0;
+	int middle_index      = 0;
+	int upper_index       = 0;
+
+	if( block_timeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block timeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	block_offset = offset - ( offset % 0x4000 );
+	upper_index  = block_timeline->number_of_blocks;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( block_timeline->block_offsets[ middle_index ] < block_offset )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	if( ( lower_index >= block_timeline->number_of_blocks )
+	 || ( block_timeline->block_offsets[ lower_index ] != block_offset ) )
+	{
+		return( 0 );
+	}
+	*block_index = lower_index;
+
+	return( 1 );
+}
+
+/* Retrieves the indexes of the stores in which a specific block was changed
+ * These are the stores that contain a different version of the block than
+ * the next store or, for the most recent store, the current volume.
+ * The store indexes are stored in ascending order, store indexes can be NULL
+ * to only retrieve the number of changed stores
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_timeline_get_store_indexes(
+     libvshadow_block_timeline_t *block_timeline,
+     int block_index,
+     int *store_indexes,
+     int number_of_store_indexes,
+     int *number_of_changed_stores,
+     libcerror_error_t **error )
+{
+	uint64_t *store_bitmap     = NULL;
+	static char *function      = "libvshadow_block_timeline_get_store_indexes";
+	int safe_number_of_changes = 0;
+	int store_index            = 0;
+
+	if( block_timeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block timeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_index < 0 )
+	 || ( block_index >= block_timeline->number_of_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_store_indexes < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of store indexes value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_changed_stores == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of changed stores.",
+		 function );
+
+		return( -1 );
+	}
+	store_bitmap = &( block_timeline->store_bitmaps[ block_index * block_timeline->number_of_bitmap_entries ] );
+
+	for( store_index = 0;
+	     store_index < block_timeline->number_of_stores;
+	     store_index++ )
+	{
+		if( ( store_bitmap[ store_index / 64 ] & ( (uint64_t) 1 << ( store_index % 64 ) ) ) == 0 )
+		{
+			continue;
+		}
+		if( store_indexes != NULL )
+		{
+			if( safe_number_of_changes >= number_of_store_indexes )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: invalid number of store indexes value too small.",
+				 function );
+
+				return( -1 );
+			}
+			store_indexes[ safe_number_of_changes ] = store_index;
+		}
+		safe_number_of_changes++;
+	}
+	*number_of_changed_stores = safe_number_of_changes;
+
+	return( 1 );
+}
+
@@ -0,0 +1,106 @@
+/*
+ * Block timeline functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_BLOCK_TIMELINE_H )
+#define _LIBVSHADOW_BLOCK_TIMELINE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_block_timeline libvshadow_block_timeline_t;
+
+struct libvshadow_block_timeline
+{
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The number of 64-bit store bitmap entries per block
+	 */
+	int number_of_bitmap_entries;
+
+	/* The (original) offsets of the blocks that were changed in one or more stores
+	 * sorted by offset
+	 */
+	off64_t *block_offsets;
+
+	/* The store bitmaps, bit N of the bitmap of a block is set if store N
+	 * contains a different version of the block than the next store
+	 */
+	uint64_t *store_bitmaps;
+
+	/* The number of blocks
+	 */
+	int number_of_blocks;
+};
+
+int libvshadow_block_timeline_initialize(
+     libvshadow_block_timeline_t **block_timeline,
+     libcerror_error_t **error );
+
+int libvshadow_block_timeline_free(
+     libvshadow_block_timeline_t **block_timeline,
+     libcerror_error_t **error );
+
+int libvshadow_block_timeline_build(
+     libvshadow_block_timeline_t *block_timeline,
+     off64_t **store_block_offsets,
+     int *store_number_of_block_offsets,
+     int number_of_stores,
+     libcerror_error_t **error );
+
+int libvshadow_block_timeline_get_number_of_blocks(
+     libvshadow_block_timeline_t *block_timeline,
+     int *number_of_blocks,
+     libcerror_error_t **error );
+
+int libvshadow_block_timeline_get_block_offset_by_index(
+     libvshadow_block_timeline_t *block_timeline,
+     int block_index,
+     off64_t *block_offset,
+     libcerror_error_t **error );
+
+int libvshadow_block_timeline_get_block_index_at_offset(
+     libvshadow_block_timeline_t *block_timeline,
+     off64_t offset,
+     int *block_index,
+     libcerror_error_t **error );
+
+int libvshadow_block_timeline_get_store_indexes(
+     libvshadow_block_timeline_t *block_timeline,
+     int block_index,
+     int *store_indexes,
+     int number_of_store_indexes,
+     int *number_of_changed_stores,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_BLOCK_TIMELINE_H ) */
+
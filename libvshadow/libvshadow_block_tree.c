@@ -23,24 +23,23 @@
 #include <types.h>
 
 #include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_table.h"
 #include "libvshadow_definitions.h"
-#include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcnotify.h"
 #include "libvshadow_unused.h"
 
-/* Inserts a block descriptor in the block tree
+/* Inserts a block descriptor in the forward and reverse block tables
+ * The block descriptors must be inserted in the order they are stored in the block list
  * Returns 1 if successful or -1 on error
  */
 int libvshadow_block_tree_insert(
-     libcdata_btree_t *forward_block_tree,
-     libcdata_btree_t *reverse_block_tree,
+     libvshadow_block_table_t *forward_block_table,
+     libvshadow_block_table_t *reverse_block_table,
      libvshadow_block_descriptor_t *block_descriptor,
      int store_index LIBVSHADOW_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
-	libcdata_tree_node_t *existing_tree_node                 = NULL;
-	libcdata_tree_node_t *reverse_tree_node                  = NULL;
 	libvshadow_block_descriptor_t *existing_block_descriptor = NULL;
 	libvshadow_block_descriptor_t *new_block_descriptor      = NULL;
 	libvshadow_block_descriptor_t *overlay_block_descriptor  = NULL;
@@ -50,24 +49,24 @@ int libvshadow_block_tree_insert(
 
 	LIBVSHADOW_UNREFERENCED_PARAMETER( store_index )
 
-	if( forward_block_tree == NULL )
+	if( forward_block_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid forward block tree.",
+		 "%s: invalid forward block table.",
 		 function );
 
 		return( -1 );
 	}
-	if( reverse_block_tree == NULL )
+	if( reverse_block_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid reverse block tree.",
+		 "%s: invalid reverse block table.",
 		 function );
 
 		return( -1 );
@@ -114,14 +113,12 @@ int libvshadow_block_tree_insert(
 	}
 	if( ( new_block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) == 0 )
 	{
-		/* The reverse block tree is used to detect forwarder block descriptors that point to each other
+		/* The reverse block table is used to detect forwarder block descriptors that point to each other
 		 */
-		result = libcdata_btree_get_value_by_value(
-			  reverse_block_tree,
-			  (intptr_t *) new_block_descriptor,
-			  (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_reverse,
-			  &reverse_tree_node,
-			  (intptr_t **) &reverse_block_descriptor,
+		result = libvshadow_block_table_get_block_descriptor_by_offset(
+			  reverse_block_table,
+			  new_block_descriptor->original_offset,
+			  &reverse_block_descriptor,
 			  error );
 
 		if( result == -1 )
@@ -130,7 +127,7 @@ int libvshadow_block_tree_insert(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve reverse block descriptor from reverse block tree.",
+			 "%s: unable to retrieve reverse block descriptor from reverse block table.",
 			 function );
 
 			goto on_error;
@@ -165,23 +162,23 @@ int libvshadow_block_tree_insert(
 #endif
 			new_block_descriptor->original_offset = reverse_block_descriptor->original_offset;
 
-			if( libcdata_btree_remove_value(
-			     reverse_block_tree,
-			     reverse_tree_node,
-			     &( reverse_block_descriptor->reverse_index ),
-			     (intptr_t *) reverse_block_descriptor,
+			if( libvshadow_block_table_remove_block_descriptor(
+			     reverse_block_table,
+			     reverse_block_descriptor->relative_offset,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-				 "%s: unable to remove reverse block descriptor: 0x%08" PRIx64 " from reverse block tree node.",
+				 "%s: unable to remove reverse block descriptor: 0x%08" PRIx64 " from reverse block table.",
 				 function,
 				 reverse_block_descriptor->original_offset );
 
 				goto on_error;
 			}
+			reverse_block_descriptor->reverse_index = -1;
+
 			if( reverse_block_descriptor->index == -1 )
 			{
 				if( libvshadow_block_descriptor_free(
@@ -231,13 +228,11 @@ int libvshadow_block_tree_insert(
 			return( 1 );
 		}
 	}
-	result = libcdata_btree_insert_value(
-		  forward_block_tree,
-	          &( new_block_descriptor->index ),
-		  (intptr_t *) new_block_descriptor,
-		  (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_by_original_offset,
-		  &existing_tree_node,
-		  (intptr_t **) &existing_block_descriptor,
+	result = libvshadow_block_table_insert_block_descriptor(
+		  forward_block_table,
+		  new_block_descriptor->original_offset,
+		  new_block_descriptor,
+		  &existing_block_descriptor,
 		  error );
 
 	if( result == -1 )
@@ -246,7 +241,7 @@ int libvshadow_block_tree_insert(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert block descriptor in forward block tree.",
+		 "%s: unable to insert block descriptor in forward block table.",
 		 function );
 
 		goto on_error;
@@ -364,22 +359,19 @@ int libvshadow_block_tree_insert(
 			 store_index );
 		}
 #endif
-		if( libcdata_btree_replace_value(
-		     forward_block_tree,
-		     existing_tree_node,
-		     &( existing_block_descriptor->index ),
-		     (intptr_t *) existing_block_descriptor,
-		     &( new_block_descriptor->index ),
-		     (intptr_t *) new_block_descriptor,
+		if( libvshadow_block_table_replace_block_descriptor(
+		     forward_block_table,
+		     new_block_descriptor->original_offset,
+		     new_block_descriptor,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to replace existing block descriptor: %d.",
+			 "%s: unable to replace existing block descriptor: 0x%08" PRIx64 ".",
 			 function,
-			 existing_block_descriptor->index );
+			 existing_block_descriptor->original_offset );
 
 			goto on_error;
 		}
@@ -422,6 +414,7 @@ int libvshadow_block_tree_insert(
 			 */
 			new_block_descriptor->overlay      = existing_block_descriptor->overlay;
 			existing_block_descriptor->overlay = NULL;
+			existing_block_descriptor->index   = -1;
 
 			if( existing_block_descriptor->reverse_index == -1 )
 			{
@@ -450,15 +443,15 @@ int libvshadow_block_tree_insert(
 		 store_index );
 	}
 #endif
+	new_block_descriptor->index = 0;
+
 	if( ( new_block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
 	{
-		result = libcdata_btree_insert_value(
-			  reverse_block_tree,
-			  &( new_block_descriptor->reverse_index ),
-			  (intptr_t *) new_block_descriptor,
-			  (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_by_relative_offset,
-			  &reverse_tree_node,
-			  (intptr_t **) &reverse_block_descriptor,
+		result = libvshadow_block_table_insert_block_descriptor(
+			  reverse_block_table,
+			  new_block_descriptor->relative_offset,
+			  new_block_descriptor,
+			  &reverse_block_descriptor,
 			  error );
 
 		if( result == -1 )
@@ -467,14 +460,16 @@ int libvshadow_block_tree_insert(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to insert block descriptor in reverse block tree.",
+			 "%s: unable to insert block descriptor in reverse block table.",
 			 function );
 
 			new_block_descriptor = NULL;
 
 			goto on_error;
 		}
-		else if( result == 0 )
+		new_block_descriptor->reverse_index = 0;
+
+		if( result == 0 )
 		{
 			if( reverse_block_descriptor == NULL )
 			{
@@ -499,27 +494,26 @@ int libvshadow_block_tree_insert(
 				 reverse_block_descriptor->original_offset );
 			}
 #endif
-			if( libcdata_btree_replace_value(
-			     reverse_block_tree,
-			     reverse_tree_node,
-			     &( reverse_block_descriptor->reverse_index ),
-			     (intptr_t *) reverse_block_descriptor,
-			     &( new_block_descriptor->reverse_index ),
-			     (intptr_t *) new_block_descriptor,
+			if( libvshadow_block_table_replace_block_descriptor(
+			     reverse_block_table,
+			     new_block_descriptor->relative_offset,
+			     new_block_descriptor,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-				 "%s: unable to replace reverse block descriptor: %d.",
+				 "%s: unable to replace reverse block descriptor: 0x%08" PRIx64 ".",
 				 function,
-				 reverse_block_descriptor->reverse_index );
+				 reverse_block_descriptor->original_offset );
 
 				new_block_descriptor = NULL;
 
 				goto on_error;
 			}
+			reverse_block_descriptor->reverse_index = -1;
+
 			if( reverse_block_descriptor->index == -1 )
 			{
 				if( libvshadow_block_descriptor_free(
@@ -26,7 +26,7 @@
 #include <types.h>
 
 #include "libvshadow_block_descriptor.h"
-#include "libvshadow_libcdata.h"
+#include "libvshadow_block_table.h"
 #include "libvshadow_libcerror.h"
 
 #if defined( __cplusplus )
@@ -34,8 +34,8 @@ extern "C" {
 #endif
 
 int libvshadow_block_tree_insert(
-     libcdata_btree_t *forward_block_tree,
-     libcdata_btree_t *reverse_block_tree,
+     libvshadow_block_table_t *forward_block_table,
+     libvshadow_block_table_t *reverse_block_table,
      libvshadow_block_descriptor_t *block_descriptor,
      int store_index,
      libcerror_error_t **error );
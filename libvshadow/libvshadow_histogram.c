@@ -0,0 +1,464 @@
+/*
+ * Histogram functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_definitions.h"
+#include "libvshadow_histogram.h"
+#include "libvshadow_libcerror.h"
+
+/* Creates a histogram
+ * Make sure the value histogram is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_histogram_initialize(
+     libvshadow_histogram_t **histogram,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_histogram_initialize";
+
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( *histogram != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid histogram value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*histogram = memory_allocate_structure(
+	              libvshadow_histogram_t );
+
+	if( *histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create histogram.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *histogram,
+	     0,
+	     sizeof( libvshadow_histogram_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear histogram.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *histogram != NULL )
+	{
+		memory_free(
+		 *histogram );
+
+		*histogram = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a histogram
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_histogram_free(
+     libvshadow_histogram_t **histogram,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_histogram_free";
+
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( *histogram != NULL )
+	{
+		memory_free(
+		 *histogram );
+
+		*histogram = NULL;
+	}
+	return( 1 );
+}
+
+/* Determines the index of the bucket that contains a value
+ * Values smaller than the number of sub buckets have a bucket of their own,
+ * larger values are stored in one of the sub buckets of their power of 2
+ * Returns the bucket index
+ */
+int libvshadow_histogram_get_bucket_index(
+     uint64_t value )
+{
+	int exponent         = LIBVSHADOW_HISTOGRAM_SUB_BUCKET_BITS;
+	int sub_bucket_index = 0;
+
+	if( value < (uint64_t) LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS )
+	{
+		return( (int) value );
+	}
+	while( ( value >> exponent ) > 1 )
+	{
+		exponent++;
+	}
+	if( exponent > LIBVSHADOW_HISTOGRAM_MAXIMUM_EXPONENT )
+	{
+		return( LIBVSHADOW_HISTOGRAM_NUMBER_OF_BUCKETS - 1 );
+	}
+	sub_bucket_index = (int) ( ( value >> ( exponent - LIBVSHADOW_HISTOGRAM_SUB_BUCKET_BITS ) ) & ( LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS - 1 ) );
+
+	return( ( ( exponent - LIBVSHADOW_HISTOGRAM_SUB_BUCKET_BITS + 1 ) * LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS ) + sub_bucket_index );
+}
+
+/* Determines the largest value that is stored in a bucket
+ * Returns the upper bound of the bucket
+ */
+uint64_t libvshadow_histogram_get_bucket_upper_bound(
+          int bucket_index )
+{
+	uint64_t lower_bound = 0;
+	int exponent         = 0;
+	int sub_bucket_index = 0;
+
+	if( bucket_index < LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS )
+	{
+		return( (uint64_t) bucket_index );
+	}
+	exponent         = ( bucket_index / LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS ) + LIBVSHADOW_HISTOGRAM_SUB_BUCKET_BITS - 1;
+	sub_bucket_index = bucket_index % LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS;
+
+	lower_bound = (uint64_t) ( LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS + sub_bucket_index ) << ( exponent - LIBVSHADOW_HISTOGRAM_SUB_BUCKET_BITS );
+
+	return( lower_bound + ( (uint64_t) 1 << ( exponent - LIBVSHADOW_HISTOGRAM_SUB_BUCKET_BITS ) ) - 1 );
+}
+
+/* Adds a value to the histogram
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_histogram_add_value(
+     libvshadow_histogram_t *histogram,
+     uint64_t value,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_histogram_add_value";
+	int bucket_index      = 0;
+
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_index = libvshadow_histogram_get_bucket_index(
+	                value );
+
+	histogram->bucket_counts[ bucket_index ] += 1;
+
+	histogram->number_of_values += 1;
+	histogram->total_value      += value;
+
+	if( histogram->maximum_value < value )
+	{
+		histogram->maximum_value = value;
+	}
+	return( 1 );
+}
+
+/* Adds the values of another histogram to the histogram
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_histogram_add(
+     libvshadow_histogram_t *histogram,
+     const libvshadow_histogram_t *source_histogram,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_histogram_add";
+	int bucket_index      = 0;
+
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source histogram.",
+		 function );
+
+		return( -1 );
+	}
+	for( bucket_index = 0;
+	     bucket_index < LIBVSHADOW_HISTOGRAM_NUMBER_OF_BUCKETS;
+	     bucket_index++ )
+	{
+		histogram->bucket_counts[ bucket_index ] += source_histogram->bucket_counts[ bucket_index ];
+	}
+	histogram->number_of_values += source_histogram->number_of_values;
+	histogram->total_value      += source_histogram->total_value;
+
+	if( histogram->maximum_value < source_histogram->maximum_value )
+	{
+		histogram->maximum_value = source_histogram->maximum_value;
+	}
+	return( 1 );
+}
+
+/* Retrieves the value of a specific quantile
+ * The quantile is specified in per mille, e.g. 999 for the 99.9th percentile
+ * The value is the upper bound of the bucket that contains the quantile
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_histogram_get_quantile(
+     const libvshadow_histogram_t *histogram,
+     uint16_t quantile,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	static char *function     = "libvshadow_histogram_get_quantile";
+	uint64_t cumulative_count = 0;
+	uint64_t rank             = 0;
+	int bucket_index          = 0;
+
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( quantile > 1000 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid quantile value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	*value = 0;
+
+	if( histogram->number_of_values == 0 )
+	{
+		return( 1 );
+	}
+	rank = ( ( histogram->number_of_values * quantile ) + 999 ) / 1000;
+
+	if( rank == 0 )
+	{
+		rank = 1;
+	}
+	for( bucket_index = 0;
+	     bucket_index < LIBVSHADOW_HISTOGRAM_NUMBER_OF_BUCKETS;
+	     bucket_index++ )
+	{
+		cumulative_count += histogram->bucket_counts[ bucket_index ];
+
+		if( cumulative_count >= rank )
+		{
+			*value = libvshadow_histogram_get_bucket_upper_bound(
+			          bucket_index );
+
+			break;
+		}
+	}
+	if( *value > histogram->maximum_value )
+	{
+		*value = histogram->maximum_value;
+	}
+	return( 1 );
+}
+
+/* Retrieves the timing values
+ * The values are stored in the order of the LIBVSHADOW_TIMING_VALUE definitions
+ * Values beyond LIBVSHADOW_NUMBER_OF_TIMING_VALUES are set to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_histogram_get_timing_values(
+     const libvshadow_histogram_t *histogram,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error )
+{
+	uint64_t timing_values[ LIBVSHADOW_NUMBER_OF_TIMING_VALUES ];
+
+	static char *function = "libvshadow_histogram_get_timing_values";
+	int value_index       = 0;
+
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_values < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of values value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	timing_values[ LIBVSHADOW_TIMING_VALUE_NUMBER_OF_SAMPLES ] = histogram->number_of_values;
+	timing_values[ LIBVSHADOW_TIMING_VALUE_TOTAL_TIME ]        = histogram->total_value;
+	timing_values[ LIBVSHADOW_TIMING_VALUE_MAXIMUM_TIME ]      = histogram->maximum_value;
+
+	if( libvshadow_histogram_get_quantile(
+	     histogram,
+	     500,
+	     &( timing_values[ LIBVSHADOW_TIMING_VALUE_P50_TIME ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve 50th percentile.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_histogram_get_quantile(
+	     histogram,
+	     990,
+	     &( timing_values[ LIBVSHADOW_TIMING_VALUE_P99_TIME ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve 99th percentile.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_histogram_get_quantile(
+	     histogram,
+	     999,
+	     &( timing_values[ LIBVSHADOW_TIMING_VALUE_P999_TIME ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve 99.9th percentile.",
+		 function );
+
+		return( -1 );
+	}
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index++ )
+	{
+		if( value_index < LIBVSHADOW_NUMBER_OF_TIMING_VALUES )
+		{
+			values[ value_index ] = timing_values[ value_index ];
+		}
+		else
+		{
+			values[ value_index ] = 0;
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,100 @@
+/*
+ * Histogram functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_HISTOGRAM_H )
+#define _LIBVSHADOW_HISTOGRAM_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_definitions.h"
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_histogram libvshadow_histogram_t;
+
+/* A log-linear histogram, every power of 2 is split
+ * into LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS linear buckets
+ */
+struct libvshadow_histogram
+{
+	/* The bucket counts
+	 */
+	uint64_t bucket_counts[ LIBVSHADOW_HISTOGRAM_NUMBER_OF_BUCKETS ];
+
+	/* The number of values
+	 */
+	uint64_t number_of_values;
+
+	/* The sum of the values
+	 */
+	uint64_t total_value;
+
+	/* The largest value
+	 */
+	uint64_t maximum_value;
+};
+
+int libvshadow_histogram_initialize(
+     libvshadow_histogram_t **histogram,
+     libcerror_error_t **error );
+
+int libvshadow_histogram_free(
+     libvshadow_histogram_t **histogram,
+     libcerror_error_t **error );
+
+int libvshadow_histogram_get_bucket_index(
+     uint64_t value );
+
+uint64_t libvshadow_histogram_get_bucket_upper_bound(
+          int bucket_index );
+
+int libvshadow_histogram_add_value(
+     libvshadow_histogram_t *histogram,
+     uint64_t value,
+     libcerror_error_t **error );
+
+int libvshadow_histogram_add(
+     libvshadow_histogram_t *histogram,
+     const libvshadow_histogram_t *source_histogram,
+     libcerror_error_t **error );
+
+int libvshadow_histogram_get_quantile(
+     const libvshadow_histogram_t *histogram,
+     uint16_t quantile,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+int libvshadow_histogram_get_timing_values(
+     const libvshadow_histogram_t *histogram,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_HISTOGRAM_H ) */
+
@@ -26,6 +26,7 @@
 
 #include "libvshadow_debug.h"
 #include "libvshadow_definitions.h"
+#include "libvshadow_histogram.h"
 #include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
@@ -33,6 +34,9 @@
 #include "libvshadow_libcnotify.h"
 #include "libvshadow_libfdatetime.h"
 #include "libvshadow_libfguid.h"
+#include "libvshadow_statistics.h"
+#include "libvshadow_store_block.h"
+#include "libvshadow_store_block_reader.h"
 #include "libvshadow_store_descriptor.h"
 
 #include "vshadow_catalog.h"
@@ -126,6 +130,7 @@ int libvshadow_io_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "libvshadow_io_handle_free";
+	int result            = 1;
 
 	if( io_handle == NULL )
 	{
@@ -140,12 +145,25 @@ int libvshadow_io_handle_free(
 	}
 	if( *io_handle != NULL )
 	{
+		if( libvshadow_histogram_free(
+		     &( ( *io_handle )->catalog_read_histogram ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free catalog read histogram.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *io_handle );
 
 		*io_handle = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clears the IO handle
@@ -168,6 +186,19 @@ int libvshadow_io_handle_clear(
 
 		return( -1 );
 	}
+	if( libvshadow_histogram_free(
+	     &( io_handle->catalog_read_histogram ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free catalog read histogram.",
+		 function );
+
+		return( -1 );
+	}
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -272,6 +303,9 @@ int libvshadow_io_handle_read_ntfs_volume_header(
 
 		return( -1 );
 	}
+	io_handle->statistics.number_of_read_calls += 1;
+	io_handle->statistics.read_size            += (uint64_t) read_count;
+
 	if( memory_compare(
 	     volume_header.signature,
 	     vshadow_ntfs_volume_file_system_signature,
@@ -361,6 +395,9 @@ int libvshadow_io_handle_read_ntfs_volume_header(
 
 		return( -1 );
 	}
+	io_handle->statistics.number_of_read_calls += 1;
+	io_handle->statistics.read_size            += (uint64_t) read_count;
+
 	if( memory_compare(
 	     volume_header.signature,
 	     vshadow_ntfs_volume_file_system_signature,
@@ -477,6 +514,9 @@ int libvshadow_io_handle_read_volume_header(
 
 		return( -1 );
 	}
+	io_handle->statistics.number_of_read_calls += 1;
+	io_handle->statistics.read_size            += (uint64_t) read_count;
+
 	if( libvshadow_io_handle_read_volume_header_data(
 	     io_handle,
 	     (uint8_t *) &volume_header,
@@ -768,6 +808,8 @@ int libvshadow_io_handle_read_catalog(
      libcdata_array_t *store_descriptors_array,
      libcerror_error_t **error )
 {
+	libvshadow_store_block_t *store_block                = NULL;
+	libvshadow_store_block_reader_t *store_block_reader  = NULL;
 	libvshadow_store_descriptor_t *last_store_descriptor = NULL;
 	libvshadow_store_descriptor_t *store_descriptor      = NULL;
 	uint8_t *catalog_block_data                          = NULL;
@@ -775,8 +817,8 @@ int libvshadow_io_handle_read_catalog(
 	off64_t next_offset                                  = 0;
 	size_t catalog_block_offset                          = 0;
 	size_t catalog_block_size                            = 0;
-	ssize_t read_count                                   = 0;
 	uint64_t catalog_entry_type                          = 0;
+	uint64_t timestamp                                   = 0;
 	int result                                           = 0;
 	int store_descriptor_index                           = 0;
 
@@ -802,24 +844,27 @@ int libvshadow_io_handle_read_catalog(
 
 		return( -1 );
 	}
-	catalog_block_data = (uint8_t *) memory_allocate(
-	                                  sizeof( uint8_t ) * io_handle->block_size );
-
-	if( catalog_block_data == NULL )
+	if( io_handle->phase_timing_enabled != 0 )
+	{
+		timestamp = libvshadow_statistics_get_timestamp();
+	}
+	/* The catalog blocks are read in runs of consecutive blocks
+	 */
+	if( libvshadow_store_block_reader_initialize(
+	     &store_block_reader,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to catalog block data.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create store block reader.",
 		 function );
 
 		goto on_error;
 	}
 	do
 	{
-		catalog_block_size = io_handle->block_size;
-
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
@@ -830,39 +875,27 @@ int libvshadow_io_handle_read_catalog(
 			 file_offset );
 		}
 #endif
-		if( libbfio_handle_seek_offset(
+		if( libvshadow_store_block_reader_read(
+		     store_block_reader,
 		     file_io_handle,
 		     file_offset,
-		     SEEK_SET,
-		     error ) == -1 )
+		     &( io_handle->statistics ),
+		     &store_block,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek catalog block offset: %" PRIi64 ".",
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read catalog block at offset: %" PRIi64 ".",
 			 function,
 			 file_offset );
 
 			goto on_error;
 		}
-		read_count = libbfio_handle_read_buffer(
-			      file_io_handle,
-			      catalog_block_data,
-			      catalog_block_size,
-			      error );
-
-		if( read_count != (ssize_t) catalog_block_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read catalog block data.",
-			 function );
+		catalog_block_data = store_block->data;
+		catalog_block_size = store_block->data_size;
 
-			goto on_error;
-		}
 		if( libvshadow_io_handle_read_catalog_header_data(
 		     io_handle,
 		     catalog_block_data,
@@ -899,6 +932,7 @@ int libvshadow_io_handle_read_catalog(
 
 					goto on_error;
 				}
+				store_descriptor->phase_timing_enabled = io_handle->phase_timing_enabled;
 			}
 			result = libvshadow_store_descriptor_read_catalog_entry(
 			          store_descriptor,
@@ -1028,9 +1062,53 @@ int libvshadow_io_handle_read_catalog(
 			goto on_error;
 		}
 	}
-	memory_free(
-	 catalog_block_data );
+	if( libvshadow_store_block_reader_free(
+	     &store_block_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free store block reader.",
+		 function );
+
+		goto on_error;
+	}
+
+	if( io_handle->phase_timing_enabled != 0 )
+	{
+		if( io_handle->catalog_read_histogram == NULL )
+		{
+			if( libvshadow_histogram_initialize(
+			     &( io_handle->catalog_read_histogram ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create catalog read histogram.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libvshadow_histogram_add_value(
+		     io_handle->catalog_read_histogram,
+		     libvshadow_statistics_get_timestamp() - timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add value to catalog read histogram.",
+			 function );
 
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -1040,10 +1118,11 @@ on_error:
 		 &store_descriptor,
 		 NULL );
 	}
-	if( catalog_block_data != NULL )
+	if( store_block_reader != NULL )
 	{
-		memory_free(
-		 catalog_block_data );
+		libvshadow_store_block_reader_free(
+		 &store_block_reader,
+		 NULL );
 	}
 	return( -1 );
 }
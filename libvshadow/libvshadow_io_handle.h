@@ -25,9 +25,11 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvshadow_histogram.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
+#include "libvshadow_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -35,6 +37,8 @@ extern "C" {
 
 extern const uint8_t vshadow_vss_identifier[ 16 ];
 
+extern const char *vshadow_ntfs_volume_file_system_signature;
+
 typedef struct libvshadow_io_handle libvshadow_io_handle_t;
 
 struct libvshadow_io_handle
@@ -43,6 +47,18 @@ struct libvshadow_io_handle
 	 */
 	size_t block_size;
 
+	/* The statistics of the volume header and catalog reads
+	 */
+	libvshadow_statistics_t statistics;
+
+	/* The catalog read timing histogram
+	 */
+	libvshadow_histogram_t *catalog_read_histogram;
+
+	/* Value to indicate the phase timing is enabled
+	 */
+	uint8_t phase_timing_enabled;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -0,0 +1,659 @@
+/*
+ * Physical block map functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libvshadow_libcerror.h"
+#include "libvshadow_physical_block_map.h"
+
+/* The physical block map contains an entry for every block of store data,
+ * which is appended per store and sorted once by (block) offset afterwards.
+ * Lookups are done with a binary search
+ */
+
+/* Creates a physical block map
+ * Make sure the value physical_block_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_physical_block_map_initialize(
+     libvshadow_physical_block_map_t **physical_block_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_physical_block_map_initialize";
+
+	if( physical_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *physical_block_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid physical block map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*physical_block_map = memory_allocate_structure(
+	                       libvshadow_physical_block_map_t );
+
+	if( *physical_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create physical block map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *physical_block_map,
+	     0,
+	     sizeof( libvshadow_physical_block_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear physical block map.",
+		 function );
+
+		goto on_error;
+	}
+	( *physical_block_map )->is_sorted = 1;
+
+	return( 1 );
+
+on_error:
+	if( *physical_block_map != NULL )
+	{
+		memory_free(
+		 *physical_block_map );
+
+		*physical_block_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a physical block map
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_physical_block_map_free(
+     libvshadow_physical_block_map_t **physical_block_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_physical_block_map_free";
+
+	if( physical_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *physical_block_map != NULL )
+	{
+		if( ( *physical_block_map )->entries != NULL )
+		{
+			memory_free(
+			 ( *physical_block_map )->entries );
+		}
+		memory_free(
+		 *physical_block_map );
+
+		*physical_block_map = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends a block
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_physical_block_map_append_block(
+     libvshadow_physical_block_map_t *physical_block_map,
+     off64_t offset,
+     off64_t original_offset,
+     int store_index,
+     libcerror_error_t **error )
+{
+	libvshadow_physical_block_map_entry_t *entries = NULL;
+	libvshadow_physical_block_map_entry_t *entry   = NULL;
+	static char *function                          = "libvshadow_physical_block_map_append_block";
+	int number_of_allocated_entries                = 0;
+
+	if( physical_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid store index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( physical_block_map->number_of_entries >= physical_block_map->number_of_allocated_entries )
+	{
+		/* Grow the entries geometrically to keep appending amortized constant time
+		 */
+		if( physical_block_map->number_of_allocated_entries == 0 )
+		{
+			number_of_allocated_entries = 1024;
+		}
+		else if( physical_block_map->number_of_allocated_entries <= ( INT32_MAX / 2 ) )
+		{
+			number_of_allocated_entries = physical_block_map->number_of_allocated_entries * 2;
+		}
+		else
+		{
+			number_of_allocated_entries = INT32_MAX;
+		}
+		if( ( number_of_allocated_entries <= physical_block_map->number_of_entries )
+		 || ( (size_t) number_of_allocated_entries > ( (size_t) SSIZE_MAX / sizeof( libvshadow_physical_block_map_entry_t ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated entries value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		entries = (libvshadow_physical_block_map_entry_t *) memory_reallocate(
+		                                                     physical_block_map->entries,
+		                                                     sizeof( libvshadow_physical_block_map_entry_t ) * number_of_allocated_entries );
+
+		if( entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entries.",
+			 function );
+
+			return( -1 );
+		}
+		physical_block_map->entries                     = entries;
+		physical_block_map->number_of_allocated_entries = number_of_allocated_entries;
+	}
+	entry = &( physical_block_map->entries[ physical_block_map->number_of_entries ] );
+
+	entry->offset          = offset;
+	entry->original_offset = original_offset;
+	entry->store_index     = store_index;
+
+	physical_block_map->number_of_entries += 1;
+	physical_block_map->is_sorted          = 0;
+
+	return( 1 );
+}
+
+/* Compares two physical block map entries by (block) offset and store index
+ * Returns a negative value, 0 or a positive value for use with qsort
+ */
+static int libvshadow_physical_block_map_compare_entries(
+            const void *first_value,
+            const void *second_value )
+{
+	const libvshadow_physical_block_map_entry_t *first_entry  = (const libvshadow_physical_block_map_entry_t *) first_value;
+	const libvshadow_physical_block_map_entry_t *second_entry = (const libvshadow_physical_block_map_entry_t *) second_value;
+
+	if( first_entry->offset < second_entry->offset )
+	{
+		return( -1 );
+	}
+	else if( first_entry->offset > second_entry->offset )
+	{
+		return( 1 );
+	}
+	if( first_entry->store_index < second_entry->store_index )
+	{
+		return( -1 );
+	}
+	else if( first_entry->store_index > second_entry->store_index )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sorts the blocks by (block) offset
+ * Any unused allocated entries are released
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_physical_block_map_sort(
+     libvshadow_physical_block_map_t *physical_block_map,
+     libcerror_error_t **error )
+{
+	libvshadow_physical_block_map_entry_t *entries = NULL;
+	static char *function                          = "libvshadow_physical_block_map_sort";
+
+	if( physical_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( physical_block_map->number_of_entries > 1 )
+	{
+		qsort(
+		 physical_block_map->entries,
+		 (size_t) physical_block_map->number_of_entries,
+		 sizeof( libvshadow_physical_block_map_entry_t ),
+		 &libvshadow_physical_block_map_compare_entries );
+	}
+	if( ( physical_block_map->number_of_entries > 0 )
+	 && ( physical_block_map->number_of_entries < physical_block_map->number_of_allocated_entries ) )
+	{
+		entries = (libvshadow_physical_block_map_entry_t *) memory_reallocate(
+		                                                     physical_block_map->entries,
+		                                                     sizeof( libvshadow_physical_block_map_entry_t ) * physical_block_map->number_of_entries );
+
+		if( entries != NULL )
+		{
+			physical_block_map->entries                     = entries;
+			physical_block_map->number_of_allocated_entries = physical_block_map->number_of_entries;
+		}
+	}
+	physical_block_map->is_sorted = 1;
+
+	return( 1 );
+}
+
+/* Retrieves the index of the first block with a (block) offset equal to or greater than a specific offset
+ */
+static int libvshadow_physical_block_map_get_lower_bound(
+            libvshadow_physical_block_map_t *physical_block_map,
+            off64_t offset )
+{
+	int lower_index  = 0;
+	int middle_index = 0;
+	int upper_index  = physical_block_map->number_of_entries;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( physical_block_map->entries[ middle_index ].offset < offset )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	return( lower_index );
+}
+
+/* Retrieves the number of blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_physical_block_map_get_number_of_blocks(
+     libvshadow_physical_block_map_t *physical_block_map,
+     int *number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_physical_block_map_get_number_of_blocks";
+
+	if( physical_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_blocks = physical_block_map->number_of_entries;
+
+	return( 1 );
+}
+
+/* Retrieves a specific block
+ * The blocks are ordered by (block) offset once sorted
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_physical_block_map_get_block_by_index(
+     libvshadow_physical_block_map_t *physical_block_map,
+     int block_index,
+     off64_t *offset,
+     int *store_index,
+     off64_t *original_offset,
+     libcerror_error_t **error )
+{
+	libvshadow_physical_block_map_entry_t *entry = NULL;
+	static char *function                        = "libvshadow_physical_block_map_get_block_by_index";
+
+	if( physical_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_index < 0 )
+	 || ( block_index >= physical_block_map->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store index.",
+		 function );
+
+		return( -1 );
+	}
+	if( original_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid original offset.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( physical_block_map->entries[ block_index ] );
+
+	*offset          = entry->offset;
+	*store_index     = entry->store_index;
+	*original_offset = entry->original_offset;
+
+	return( 1 );
+}
+
+/* Retrieves the index of the block that contains a specific (block) offset
+ * If multiple stores refer to the same block the first one is retrieved
+ * Returns 1 if successful, 0 if no block contains the offset or -1 on error
+ */
+int libvshadow_physical_block_map_get_block_index_at_offset(
+     libvshadow_physical_block_map_t *physical_block_map,
+     off64_t offset,
+     int *block_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_physical_block_map_get_block_index_at_offset";
+	int safe_block_index  = 0;
+
+	if( physical_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( physical_block_map->is_sorted == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid physical block map - blocks not sorted.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( offset == INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	/* The last block that starts at or before the offset
+	 */
+	safe_block_index = libvshadow_physical_block_map_get_lower_bound(
+	                    physical_block_map,
+	                    offset + 1 ) - 1;
+
+	if( safe_block_index < 0 )
+	{
+		return( 0 );
+	}
+	if( ( offset - physical_block_map->entries[ safe_block_index ].offset ) >= 0x4000 )
+	{
+		return( 0 );
+	}
+	*block_index = libvshadow_physical_block_map_get_lower_bound(
+	                physical_block_map,
+	                physical_block_map->entries[ safe_block_index ].offset );
+
+	return( 1 );
+}
+
+/* Retrieves the indexes of the blocks that overlap with a specific range
+ * The blocks in the range are the number of blocks from the first block index
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_physical_block_map_get_block_indexes_in_range(
+     libvshadow_physical_block_map_t *physical_block_map,
+     off64_t offset,
+     size64_t size,
+     int *first_block_index,
+     int *number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_physical_block_map_get_block_indexes_in_range";
+	int safe_block_index  = 0;
+	int end_block_index   = 0;
+
+	if( physical_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( physical_block_map->is_sorted == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid physical block map - blocks not sorted.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	safe_block_index = libvshadow_physical_block_map_get_lower_bound(
+	                    physical_block_map,
+	                    offset );
+
+	if( size == 0 )
+	{
+		*first_block_index = safe_block_index;
+		*number_of_blocks  = 0;
+
+		return( 1 );
+	}
+	/* Include the blocks that start before but extend into the range
+	 */
+	if( ( safe_block_index > 0 )
+	 && ( ( offset - physical_block_map->entries[ safe_block_index - 1 ].offset ) < 0x4000 ) )
+	{
+		safe_block_index = libvshadow_physical_block_map_get_lower_bound(
+		                    physical_block_map,
+		                    physical_block_map->entries[ safe_block_index - 1 ].offset );
+	}
+	if( size > (size64_t) ( INT64_MAX - offset ) )
+	{
+		end_block_index = physical_block_map->number_of_entries;
+	}
+	else
+	{
+		end_block_index = libvshadow_physical_block_map_get_lower_bound(
+		                   physical_block_map,
+		                   offset + (off64_t) size );
+	}
+	*first_block_index = safe_block_index;
+	*number_of_blocks  = end_block_index - safe_block_index;
+
+	return( 1 );
+}
+
@@ -0,0 +1,128 @@
+/*
+ * Physical block map functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_PHYSICAL_BLOCK_MAP_H )
+#define _LIBVSHADOW_PHYSICAL_BLOCK_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_physical_block_map_entry libvshadow_physical_block_map_entry_t;
+
+/* A block of store data in the volume
+ */
+struct libvshadow_physical_block_map_entry
+{
+	/* The (block) offset
+	 */
+	off64_t offset;
+
+	/* The original (volume) offset
+	 */
+	off64_t original_offset;
+
+	/* The index of the store the block belongs to
+	 */
+	int store_index;
+};
+
+typedef struct libvshadow_physical_block_map libvshadow_physical_block_map_t;
+
+/* The physical block map maps the offsets of the blocks of store data
+ * in the volume to the store and original (volume) offset they belong to
+ */
+struct libvshadow_physical_block_map
+{
+	/* The entries sorted by (block) offset
+	 */
+	libvshadow_physical_block_map_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of allocated entries
+	 */
+	int number_of_allocated_entries;
+
+	/* Value to indicate the entries are sorted
+	 */
+	uint8_t is_sorted;
+};
+
+int libvshadow_physical_block_map_initialize(
+     libvshadow_physical_block_map_t **physical_block_map,
+     libcerror_error_t **error );
+
+int libvshadow_physical_block_map_free(
+     libvshadow_physical_block_map_t **physical_block_map,
+     libcerror_error_t **error );
+
+int libvshadow_physical_block_map_append_block(
+     libvshadow_physical_block_map_t *physical_block_map,
+     off64_t offset,
+     off64_t original_offset,
+     int store_index,
+     libcerror_error_t **error );
+
+int libvshadow_physical_block_map_sort(
+     libvshadow_physical_block_map_t *physical_block_map,
+     libcerror_error_t **error );
+
+int libvshadow_physical_block_map_get_number_of_blocks(
+     libvshadow_physical_block_map_t *physical_block_map,
+     int *number_of_blocks,
+     libcerror_error_t **error );
+
+int libvshadow_physical_block_map_get_block_by_index(
+     libvshadow_physical_block_map_t *physical_block_map,
+     int block_index,
+     off64_t *offset,
+     int *store_index,
+     off64_t *original_offset,
+     libcerror_error_t **error );
+
+int libvshadow_physical_block_map_get_block_index_at_offset(
+     libvshadow_physical_block_map_t *physical_block_map,
+     off64_t offset,
+     int *block_index,
+     libcerror_error_t **error );
+
+int libvshadow_physical_block_map_get_block_indexes_in_range(
+     libvshadow_physical_block_map_t *physical_block_map,
+     off64_t offset,
+     size64_t size,
+     int *first_block_index,
+     int *number_of_blocks,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_PHYSICAL_BLOCK_MAP_H ) */
+
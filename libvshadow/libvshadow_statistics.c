@@ -0,0 +1,206 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_CLOCK_GETTIME ) && !defined( WINAPI )
+#include <time.h>
+#endif
+
+#include "libvshadow_definitions.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_statistics.h"
+
+/* Adds statistics to other statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_statistics_add(
+     libvshadow_statistics_t *statistics,
+     const libvshadow_statistics_t *source_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_statistics_add";
+	int phase             = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source statistics.",
+		 function );
+
+		return( -1 );
+	}
+	statistics->number_of_block_tree_lookups += source_statistics->number_of_block_tree_lookups;
+	statistics->number_of_chain_reads        += source_statistics->number_of_chain_reads;
+
+	if( statistics->maximum_chain_depth < source_statistics->maximum_chain_depth )
+	{
+		statistics->maximum_chain_depth = source_statistics->maximum_chain_depth;
+	}
+	statistics->store_data_size      += source_statistics->store_data_size;
+	statistics->volume_data_size     += source_statistics->volume_data_size;
+	statistics->zero_fill_size       += source_statistics->zero_fill_size;
+	statistics->overlay_data_size    += source_statistics->overlay_data_size;
+	statistics->number_of_read_calls += source_statistics->number_of_read_calls;
+	statistics->read_size            += source_statistics->read_size;
+	statistics->lock_wait_time       += source_statistics->lock_wait_time;
+
+	statistics->number_of_index_loads     += source_statistics->number_of_index_loads;
+	statistics->number_of_index_evictions += source_statistics->number_of_index_evictions;
+
+	for( phase = 0;
+	     phase < LIBVSHADOW_NUMBER_OF_TIMING_PHASES;
+	     phase++ )
+	{
+		statistics->phase_times[ phase ] += source_statistics->phase_times[ phase ];
+	}
+	return( 1 );
+}
+
+/* Retrieves the statistics values
+ * The values are stored in the order of the LIBVSHADOW_STATISTICS_VALUE definitions
+ * Values beyond LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES are set to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_statistics_get_values(
+     const libvshadow_statistics_t *statistics,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error )
+{
+	uint64_t statistics_values[ LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES ];
+
+	static char *function = "libvshadow_statistics_get_values";
+	int value_index       = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_values < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of values value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_BLOCK_TREE_LOOKUPS ] = statistics->number_of_block_tree_lookups;
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_CHAIN_READS ]        = statistics->number_of_chain_reads;
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_MAXIMUM_CHAIN_DEPTH ]          = statistics->maximum_chain_depth;
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_STORE_DATA_SIZE ]              = statistics->store_data_size;
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_VOLUME_DATA_SIZE ]             = statistics->volume_data_size;
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_ZERO_FILL_SIZE ]               = statistics->zero_fill_size;
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_OVERLAY_DATA_SIZE ]            = statistics->overlay_data_size;
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_READ_CALLS ]         = statistics->number_of_read_calls;
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_READ_SIZE ]                    = statistics->read_size;
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_LOCK_WAIT_TIME ]               = statistics->lock_wait_time;
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_LOADS ]        = statistics->number_of_index_loads;
+	statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_EVICTIONS ]    = statistics->number_of_index_evictions;
+
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index++ )
+	{
+		if( value_index < LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES )
+		{
+			values[ value_index ] = statistics_values[ value_index ];
+		}
+		else
+		{
+			values[ value_index ] = 0;
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves a monotonic timestamp in nano seconds
+ * Returns the timestamp or 0 if not available
+ */
+uint64_t libvshadow_statistics_get_timestamp(
+          void )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		return( 0 );
+	}
+	return( (uint64_t) ( ( (double) counter.QuadPart * 1000000000.0 ) / (double) frequency.QuadPart ) );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec );
+
+#else
+	return( 0 );
+#endif
+}
+
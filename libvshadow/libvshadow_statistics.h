@@ -0,0 +1,115 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_STATISTICS_H )
+#define _LIBVSHADOW_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_definitions.h"
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_statistics libvshadow_statistics_t;
+
+struct libvshadow_statistics
+{
+	/* The number of block descriptors tree lookups
+	 */
+	uint64_t number_of_block_tree_lookups;
+
+	/* The number of reads that were passed on to the next store
+	 */
+	uint64_t number_of_chain_reads;
+
+	/* The maximum depth of the next store chain
+	 */
+	uint64_t maximum_chain_depth;
+
+	/* The number of bytes served from store data
+	 */
+	uint64_t store_data_size;
+
+	/* The number of bytes served from the (live) volume
+	 */
+	uint64_t volume_data_size;
+
+	/* The number of bytes served as zero-fill
+	 */
+	uint64_t zero_fill_size;
+
+	/* The number of bytes served from overlays
+	 */
+	uint64_t overlay_data_size;
+
+	/* The number of read calls
+	 */
+	uint64_t number_of_read_calls;
+
+	/* The number of bytes read
+	 */
+	uint64_t read_size;
+
+	/* The time spent waiting for locks in nano seconds
+	 */
+	uint64_t lock_wait_time;
+
+	/* The number of times the block descriptors of a store were read
+	 */
+	uint64_t number_of_index_loads;
+
+	/* The number of times the block descriptors of a store were evicted
+	 */
+	uint64_t number_of_index_evictions;
+
+	/* The time spent per timing phase in nano seconds
+	 */
+	uint64_t phase_times[ LIBVSHADOW_NUMBER_OF_TIMING_PHASES ];
+
+	/* Value to indicate the phase times should be measured
+	 */
+	uint8_t phase_timing_enabled;
+};
+
+int libvshadow_statistics_add(
+     libvshadow_statistics_t *statistics,
+     const libvshadow_statistics_t *source_statistics,
+     libcerror_error_t **error );
+
+int libvshadow_statistics_get_values(
+     const libvshadow_statistics_t *statistics,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+uint64_t libvshadow_statistics_get_timestamp(
+          void );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_STATISTICS_H ) */
+
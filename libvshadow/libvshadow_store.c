@@ -27,10 +27,12 @@
 #include "libvshadow_block_descriptor.h"
 #include "libvshadow_block_tree.h"
 #include "libvshadow_definitions.h"
+#include "libvshadow_histogram.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_statistics.h"
 #include "libvshadow_store.h"
 #include "libvshadow_store_descriptor.h"
 #include "libvshadow_volume.h"
@@ -84,7 +86,8 @@ int libvshadow_store_initialize(
 
 		return( -1 );
 	}
-	/* Make sure there is a store descriptor for the store
+	/* This function is called with the volume read/write lock held for reading
+	 * hence the store descriptors array and size of the volume are stable
 	 */
 	if( libcdata_array_get_entry_by_index(
 	     internal_volume->store_descriptors_array,
@@ -152,6 +155,8 @@ int libvshadow_store_initialize(
 	internal_store->io_handle              = io_handle;
 	internal_store->internal_volume        = internal_volume;
 	internal_store->store_descriptor_index = store_descriptor_index;
+	internal_store->store_descriptor       = store_descriptor;
+	internal_store->volume_size            = internal_volume->size;
 
 	*store = (libvshadow_store_t *) internal_store;
 
@@ -252,22 +257,8 @@ int libvshadow_store_has_in_volume_data(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_store->internal_volume->store_descriptors_array,
-	     internal_store->store_descriptor_index,
-	     (intptr_t **) &store_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+	store_descriptor = internal_store->store_descriptor;
 
-		return( -1 );
-	}
 	result = libvshadow_store_descriptor_has_in_volume_data(
 	          store_descriptor,
 	          error );
@@ -339,30 +330,16 @@ ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
 	{
 		return( 0 );
 	}
-	if( (size64_t) internal_store->current_offset >= internal_store->internal_volume->size )
+	if( (size64_t) internal_store->current_offset >= internal_store->volume_size )
 	{
 		return( 0 );
 	}
-	if( (size64_t) ( internal_store->current_offset + buffer_size ) > internal_store->internal_volume->size )
+	if( (size64_t) ( internal_store->current_offset + buffer_size ) > internal_store->volume_size )
 	{
-		buffer_size = (size_t) ( internal_store->internal_volume->size - internal_store->current_offset );
+		buffer_size = (size_t) ( internal_store->volume_size - internal_store->current_offset );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_store->internal_volume->store_descriptors_array,
-	     internal_store->store_descriptor_index,
-	     (intptr_t **) &store_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+	store_descriptor = internal_store->store_descriptor;
 
-		return( -1 );
-	}
 	read_count = libvshadow_store_descriptor_read_buffer(
 		      store_descriptor,
 		      file_io_handle,
@@ -386,6 +363,19 @@ ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
 	}
 	internal_store->current_offset += read_count;
 
+	if( libvshadow_internal_volume_enforce_index_memory_limit(
+	     internal_store->internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to enforce index memory limit.",
+		 function );
+
+		return( -1 );
+	}
 	return( read_count );
 }
 
@@ -698,7 +688,7 @@ off64_t libvshadow_internal_store_seek_offset(
 	}
 	else if( whence == SEEK_END )
 	{
-		offset += (off64_t) internal_store->internal_volume->size;
+		offset += (off64_t) internal_store->volume_size;
 	}
 	if( offset < 0 )
 	{
@@ -938,22 +928,8 @@ int libvshadow_store_get_volume_size(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_store->internal_volume->store_descriptors_array,
-	     internal_store->store_descriptor_index,
-	     (intptr_t **) &store_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+	store_descriptor = internal_store->store_descriptor;
 
-		return( -1 );
-	}
 	if( libvshadow_store_descriptor_get_volume_size(
 	     store_descriptor,
 	     volume_size,
@@ -1009,22 +985,8 @@ int libvshadow_store_get_identifier(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_store->internal_volume->store_descriptors_array,
-	     internal_store->store_descriptor_index,
-	     (intptr_t **) &store_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+	store_descriptor = internal_store->store_descriptor;
 
-		return( -1 );
-	}
 	if( libvshadow_store_descriptor_get_identifier(
 	     store_descriptor,
 	     guid,
@@ -1080,22 +1042,8 @@ int libvshadow_store_get_creation_time(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_store->internal_volume->store_descriptors_array,
-	     internal_store->store_descriptor_index,
-	     (intptr_t **) &store_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+	store_descriptor = internal_store->store_descriptor;
 
-		return( -1 );
-	}
 	if( libvshadow_store_descriptor_get_creation_time(
 	     store_descriptor,
 	     filetime,
@@ -1152,24 +1100,11 @@ int libvshadow_store_get_copy_identifier(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_store->internal_volume->store_descriptors_array,
-	     internal_store->store_descriptor_index,
-	     (intptr_t **) &store_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+	store_descriptor = internal_store->store_descriptor;
 
-		return( -1 );
-	}
 	result = libvshadow_store_descriptor_get_copy_identifier(
 	          store_descriptor,
+	          internal_store->file_io_handle,
 	          guid,
 	          size,
 	          error );
@@ -1227,24 +1162,11 @@ int libvshadow_store_get_copy_set_identifier(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_store->internal_volume->store_descriptors_array,
-	     internal_store->store_descriptor_index,
-	     (intptr_t **) &store_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+	store_descriptor = internal_store->store_descriptor;
 
-		return( -1 );
-	}
 	result = libvshadow_store_descriptor_get_copy_set_identifier(
 	          store_descriptor,
+	          internal_store->file_io_handle,
 	          guid,
 	          size,
 	          error );
@@ -1301,24 +1223,11 @@ int libvshadow_store_get_attribute_flags(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_store->internal_volume->store_descriptors_array,
-	     internal_store->store_descriptor_index,
-	     (intptr_t **) &store_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+	store_descriptor = internal_store->store_descriptor;
 
-		return( -1 );
-	}
 	result = libvshadow_store_descriptor_get_attribute_flags(
 	          store_descriptor,
+	          internal_store->file_io_handle,
 	          attribute_flags,
 	          error );
 
@@ -1373,35 +1282,34 @@ int libvshadow_store_get_number_of_blocks(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_store->internal_volume->store_descriptors_array,
-	     internal_store->store_descriptor_index,
-	     (intptr_t **) &store_descriptor,
+	store_descriptor = internal_store->store_descriptor;
+
+	if( libvshadow_store_descriptor_get_number_of_blocks(
+	     store_descriptor,
+	     internal_store->file_io_handle,
+	     number_of_blocks,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
+		 "%s: unable to retrieve number of blocks store descriptor: %d.",
 		 function,
 		 internal_store->store_descriptor_index );
 
 		return( -1 );
 	}
-	if( libvshadow_store_descriptor_get_number_of_blocks(
-	     store_descriptor,
-	     internal_store->file_io_handle,
-	     number_of_blocks,
+	if( libvshadow_internal_volume_enforce_index_memory_limit(
+	     internal_store->internal_volume,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of blocks store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to enforce index memory limit.",
+		 function );
 
 		return( -1 );
 	}
@@ -1468,22 +1376,8 @@ int libvshadow_store_get_block_by_index(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_store->internal_volume->store_descriptors_array,
-	     internal_store->store_descriptor_index,
-	     (intptr_t **) &store_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+	store_descriptor = internal_store->store_descriptor;
 
-		return( -1 );
-	}
 	if( libvshadow_store_descriptor_get_block_descriptor_by_index(
 	     store_descriptor,
 	     internal_store->file_io_handle,
@@ -1515,8 +1409,717 @@ int libvshadow_store_get_block_by_index(
 		 function,
 		 block_index );
 
-		return( -1 );
+		goto on_error;
+	}
+	if( libvshadow_block_descriptor_free(
+	     &block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free block descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_internal_volume_enforce_index_memory_limit(
+	     internal_store->internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to enforce index memory limit.",
+		 function );
+
+		goto on_error;
 	}
 	return( 1 );
+
+on_error:
+	if( *block != NULL )
+	{
+		libvshadow_block_free(
+		 block,
+		 NULL );
+	}
+	if( block_descriptor != NULL )
+	{
+		libvshadow_block_descriptor_free(
+		 &block_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the values of the blocks that overlap with a specific range
+ * The blocks are ordered by original offset, only the blocks in the range
+ * are looked up. The value arrays are filled up to the number of values,
+ * any of them can be NULL if the corresponding values are not needed
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_blocks_in_range(
+     libvshadow_store_t *store,
+     off64_t offset,
+     size64_t size,
+     off64_t *original_offsets,
+     off64_t *relative_offsets,
+     off64_t *offsets,
+     uint32_t *flags,
+     uint32_t *bitmaps,
+     int number_of_values,
+     int *number_of_blocks,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_blocks_in_range";
+	int result                                      = 1;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	store_descriptor = internal_store->store_descriptor;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_store_descriptor_get_block_values_in_range(
+	     store_descriptor,
+	     internal_store->file_io_handle,
+	     offset,
+	     size,
+	     original_offsets,
+	     relative_offsets,
+	     offsets,
+	     flags,
+	     bitmaps,
+	     number_of_values,
+	     number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block values in range from store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		result = -1;
+	}
+	else if( libvshadow_internal_volume_enforce_index_memory_limit(
+	          internal_store->internal_volume,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to enforce index memory limit.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the statistics
+ * The values are stored in the order of the LIBVSHADOW_STATISTICS_VALUE definitions
+ * The statistics include the reads of other stores and of the store metadata
+ * that were needed to read the store
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_statistics(
+     libvshadow_store_t *store,
+     uint64_t *statistics_values,
+     int number_of_statistics_values,
+     libcerror_error_t **error )
+{
+	libvshadow_statistics_t statistics;
+
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_statistics";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	store_descriptor = internal_store->store_descriptor;
+
+	if( libvshadow_store_descriptor_get_statistics(
+	     store_descriptor,
+	     &statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics of store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( libvshadow_statistics_get_values(
+	     &statistics,
+	     statistics_values,
+	     number_of_statistics_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics values.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the phase timing
+ * The values are stored in the order of the LIBVSHADOW_TIMING_VALUE definitions,
+ * where the number of timing values should not exceed the size of timing values
+ * The times are in nano seconds
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_phase_timing(
+     libvshadow_store_t *store,
+     int phase,
+     uint64_t *timing_values,
+     int number_of_timing_values,
+     libcerror_error_t **error )
+{
+	libvshadow_histogram_t *histogram               = NULL;
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_phase_timing";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	store_descriptor = internal_store->store_descriptor;
+
+	if( libvshadow_histogram_initialize(
+	     &histogram,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create histogram.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_store_descriptor_get_phase_timing(
+	     store_descriptor,
+	     phase,
+	     histogram,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve phase timing of store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		goto on_error;
+	}
+	if( libvshadow_histogram_get_timing_values(
+	     histogram,
+	     timing_values,
+	     number_of_timing_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timing values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_histogram_free(
+	     &histogram,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free histogram.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( histogram != NULL )
+	{
+		libvshadow_histogram_free(
+		 &histogram,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the physical extent that contains the (store) data at a specific offset
+ * The extent is the range of data starting at the offset that is stored consecutively
+ * in the volume, where the extent size does not exceed the maximum size
+ * The physical offset is relative to the start of the volume and is 0 if the extent is sparse
+ * The extent flags contain LIBVSHADOW_EXTENT_FLAG_IS_SPARSE if the data consists of 0-byte values
+ * and LIBVSHADOW_EXTENT_FLAG_IS_STORE_DATA if the data is stored in the store,
+ * otherwise the data is stored in the current volume
+ * If the NTFS allocation bitmap has been read the extent does not span clusters with
+ * a different allocation state and the extent flags contain LIBVSHADOW_EXTENT_FLAG_IS_UNALLOCATED
+ * if the clusters are not allocated by the file system in the store
+ * Returns 1 if successful, 0 if the offset is beyond the end of the store data or -1 on error
+ */
+int libvshadow_store_get_physical_extent(
+     libvshadow_store_t *store,
+     off64_t offset,
+     size64_t maximum_size,
+     off64_t *physical_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_physical_extent";
+	size64_t allocation_extent_size                 = 0;
+	uint8_t is_allocated                            = 0;
+	int result                                      = 1;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_store->volume_size )
+	{
+		return( 0 );
+	}
+	if( maximum_size > ( internal_store->volume_size - (size64_t) offset ) )
+	{
+		maximum_size = internal_store->volume_size - (size64_t) offset;
+	}
+	store_descriptor = internal_store->store_descriptor;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_store_descriptor_get_physical_extent(
+	     store_descriptor,
+	     internal_store->file_io_handle,
+	     offset,
+	     maximum_size,
+	     store_descriptor,
+	     physical_offset,
+	     extent_size,
+	     extent_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve physical extent of store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		result = -1;
+	}
+	else if( *extent_size > 0 )
+	{
+		result = libvshadow_store_descriptor_get_allocation_extent(
+		          store_descriptor,
+		          offset,
+		          *extent_size,
+		          &allocation_extent_size,
+		          &is_allocated,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation extent of store descriptor: %d.",
+			 function,
+			 internal_store->store_descriptor_index );
+		}
+		else
+		{
+			if( result != 0 )
+			{
+				if( allocation_extent_size < *extent_size )
+				{
+					*extent_size = allocation_extent_size;
+				}
+				if( is_allocated == 0 )
+				{
+					*extent_flags |= LIBVSHADOW_EXTENT_FLAG_IS_UNALLOCATED;
+				}
+			}
+			result = 1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( libvshadow_internal_volume_enforce_index_memory_limit(
+	      internal_store->internal_volume,
+	      error ) != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to enforce index memory limit.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the NTFS allocation bitmap of the store
+ * The $Bitmap file is read through the store, hence the allocation reflects
+ * the file system at the time the snapshot was created. The allocation bitmap
+ * is kept with the store until the volume is closed and requires 1 bit per cluster
+ * Once read, the physical extents do not span clusters with a different allocation state
+ * Returns 1 if successful, 0 if the store does not contain a NTFS file system or -1 on error
+ */
+int libvshadow_store_read_allocation_bitmap(
+     libvshadow_store_t *store,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_read_allocation_bitmap";
+	int result                                      = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	store_descriptor = internal_store->store_descriptor;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvshadow_store_descriptor_read_allocation_bitmap(
+	          store_descriptor,
+	          internal_store->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read allocation bitmap of store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+	}
+	else if( libvshadow_internal_volume_enforce_index_memory_limit(
+	          internal_store->internal_volume,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to enforce index memory limit.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the extent at a specific offset that has the same NTFS allocation state
+ * The extent size does not exceed the maximum size, data beyond the last cluster
+ * of the file system is considered allocated
+ * Returns 1 if successful, 0 if the allocation bitmap has not been read or -1 on error
+ */
+int libvshadow_store_get_allocation_extent(
+     libvshadow_store_t *store,
+     off64_t offset,
+     size64_t maximum_size,
+     size64_t *extent_size,
+     uint8_t *is_allocated,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_allocation_extent";
+	int result                                      = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	store_descriptor = internal_store->store_descriptor;
+
+	result = libvshadow_store_descriptor_get_allocation_extent(
+	          store_descriptor,
+	          offset,
+	          maximum_size,
+	          extent_size,
+	          is_allocated,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation extent of store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( result );
 }
 
@@ -29,6 +29,7 @@
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_store_descriptor.h"
 #include "libvshadow_types.h"
 #include "libvshadow_volume.h"
 
@@ -56,6 +57,16 @@ struct libvshadow_internal_store
 	 */
 	int store_descriptor_index;
 
+	/* The store descriptor
+	 * The store descriptor is retrieved when the store is created since
+	 * a refresh of the volume can reallocate the store descriptors array
+	 */
+	libvshadow_store_descriptor_t *store_descriptor;
+
+	/* The volume size
+	 */
+	size64_t volume_size;
+
 	/* The current offset
 	 */
 	off64_t current_offset;
@@ -192,6 +203,59 @@ int libvshadow_store_get_block_by_index(
      libvshadow_block_t **block,
      libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_blocks_in_range(
+     libvshadow_store_t *store,
+     off64_t offset,
+     size64_t size,
+     off64_t *original_offsets,
+     off64_t *relative_offsets,
+     off64_t *offsets,
+     uint32_t *flags,
+     uint32_t *bitmaps,
+     int number_of_values,
+     int *number_of_blocks,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_statistics(
+     libvshadow_store_t *store,
+     uint64_t *statistics_values,
+     int number_of_statistics_values,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_phase_timing(
+     libvshadow_store_t *store,
+     int phase,
+     uint64_t *timing_values,
+     int number_of_timing_values,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_physical_extent(
+     libvshadow_store_t *store,
+     off64_t offset,
+     size64_t maximum_size,
+     off64_t *physical_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_read_allocation_bitmap(
+     libvshadow_store_t *store,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_allocation_extent(
+     libvshadow_store_t *store,
+     off64_t offset,
+     size64_t maximum_size,
+     size64_t *extent_size,
+     uint8_t *is_allocated,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,386 @@
+/*
+ * Store block reader functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcnotify.h"
+#include "libvshadow_statistics.h"
+#include "libvshadow_store_block.h"
+#include "libvshadow_store_block_reader.h"
+
+/* Creates a store block reader
+ * Make sure the value store_block_reader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_block_reader_initialize(
+     libvshadow_store_block_reader_t **store_block_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_block_reader_initialize";
+
+	if( store_block_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store block reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *store_block_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid store block reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*store_block_reader = memory_allocate_structure(
+	                       libvshadow_store_block_reader_t );
+
+	if( *store_block_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create store block reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *store_block_reader,
+	     0,
+	     sizeof( libvshadow_store_block_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear store block reader.",
+		 function );
+
+		goto on_error;
+	}
+	( *store_block_reader )->number_of_read_ahead_blocks = 1;
+
+	return( 1 );
+
+on_error:
+	if( *store_block_reader != NULL )
+	{
+		memory_free(
+		 *store_block_reader );
+
+		*store_block_reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a store block reader
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_block_reader_free(
+     libvshadow_store_block_reader_t **store_block_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_block_reader_free";
+
+	if( store_block_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store block reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *store_block_reader != NULL )
+	{
+		/* The store block data references the read buffer and is not freed separately
+		 */
+		if( ( *store_block_reader )->buffer != NULL )
+		{
+			memory_free(
+			 ( *store_block_reader )->buffer );
+		}
+		memory_free(
+		 *store_block_reader );
+
+		*store_block_reader = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the read ahead size
+ * The size is rounded up to a multiple of the store block size and limited to the maximum number of blocks
+ * The read ahead size applies to the next read that is not served from the read buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_block_reader_set_read_ahead_size(
+     libvshadow_store_block_reader_t *store_block_reader,
+     size64_t read_ahead_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_block_reader_set_read_ahead_size";
+
+	if( store_block_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store block reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead_size > ( (size64_t) LIBVSHADOW_STORE_BLOCK_READER_MAXIMUM_NUMBER_OF_BLOCKS * LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE ) )
+	{
+		store_block_reader->number_of_read_ahead_blocks = LIBVSHADOW_STORE_BLOCK_READER_MAXIMUM_NUMBER_OF_BLOCKS;
+	}
+	else if( read_ahead_size <= LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE )
+	{
+		store_block_reader->number_of_read_ahead_blocks = 1;
+	}
+	else
+	{
+		store_block_reader->number_of_read_ahead_blocks = (int) ( ( read_ahead_size + LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE - 1 ) / LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE );
+	}
+	return( 1 );
+}
+
+/* Reads the store block at a specific offset
+ * Store blocks that follow each other in a chain are often stored consecutively,
+ * hence the number of blocks read at once is doubled, up to the maximum, while
+ * the next block in the chain directly follows the block read, and reset to 1
+ * when it does not
+ * The store block is owned by the store block reader and remains valid until the next read
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_block_reader_read(
+     libvshadow_store_block_reader_t *store_block_reader,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libvshadow_statistics_t *statistics,
+     libvshadow_store_block_t **store_block,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_block_reader_read";
+	size64_t file_size    = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( store_block_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store block reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store block.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_block_reader->buffer_data_size < LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE )
+	 || ( file_offset < store_block_reader->buffer_offset )
+	 || ( (size64_t) ( file_offset - store_block_reader->buffer_offset ) > (size64_t) ( store_block_reader->buffer_data_size - LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE ) ) )
+	{
+		if( libbfio_handle_get_size(
+		     file_io_handle,
+		     &file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to retrieve file size.",
+			 function );
+
+			return( -1 );
+		}
+		read_size = (size_t) store_block_reader->number_of_read_ahead_blocks * LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE;
+
+		/* Do not read ahead beyond the end of the file
+		 */
+		if( (size64_t) file_offset >= file_size )
+		{
+			read_size = LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE;
+		}
+		else if( (size64_t) read_size > ( file_size - file_offset ) )
+		{
+			read_size = (size_t) ( file_size - file_offset );
+
+			if( read_size < LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE )
+			{
+				read_size = LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE;
+			}
+		}
+		if( read_size > store_block_reader->buffer_size )
+		{
+			if( store_block_reader->buffer != NULL )
+			{
+				memory_free(
+				 store_block_reader->buffer );
+
+				store_block_reader->buffer      = NULL;
+				store_block_reader->buffer_size = 0;
+			}
+			store_block_reader->buffer = (uint8_t *) memory_allocate(
+			                                          sizeof( uint8_t ) * read_size );
+
+			if( store_block_reader->buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create read buffer.",
+				 function );
+
+				return( -1 );
+			}
+			store_block_reader->buffer_size = read_size;
+		}
+		store_block_reader->buffer_data_size = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading %" PRIzd " bytes of store blocks at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 read_size,
+			 file_offset,
+			 file_offset );
+		}
+#endif
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     file_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek store block offset: %" PRIi64 ".",
+			 function,
+			 file_offset );
+
+			return( -1 );
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              store_block_reader->buffer,
+		              read_size,
+		              error );
+
+		if( read_count < (ssize_t) LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read store block data.",
+			 function );
+
+			return( -1 );
+		}
+		if( statistics != NULL )
+		{
+			statistics->number_of_read_calls += 1;
+			statistics->read_size            += (uint64_t) read_count;
+		}
+		store_block_reader->buffer_offset    = file_offset;
+		store_block_reader->buffer_data_size = (size_t) read_count;
+	}
+	store_block_reader->store_block.data      = &( store_block_reader->buffer[ file_offset - store_block_reader->buffer_offset ] );
+	store_block_reader->store_block.data_size = LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE;
+
+	if( libvshadow_store_block_read_header_data(
+	     &( store_block_reader->store_block ),
+	     store_block_reader->store_block.data,
+	     store_block_reader->store_block.data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read store block header.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_block_reader->store_block.next_offset == ( file_offset + LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE ) )
+	{
+		store_block_reader->number_of_read_ahead_blocks *= 2;
+
+		if( store_block_reader->number_of_read_ahead_blocks > LIBVSHADOW_STORE_BLOCK_READER_MAXIMUM_NUMBER_OF_BLOCKS )
+		{
+			store_block_reader->number_of_read_ahead_blocks = LIBVSHADOW_STORE_BLOCK_READER_MAXIMUM_NUMBER_OF_BLOCKS;
+		}
+	}
+	else if( store_block_reader->store_block.next_offset != 0 )
+	{
+		store_block_reader->number_of_read_ahead_blocks = 1;
+	}
+	*store_block = &( store_block_reader->store_block );
+
+	return( 1 );
+}
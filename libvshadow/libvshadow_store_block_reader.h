@@ -0,0 +1,100 @@
+/*
+ * Store block reader functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_STORE_BLOCK_READER_H )
+#define _LIBVSHADOW_STORE_BLOCK_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_statistics.h"
+#include "libvshadow_store_block.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of a store block
+ */
+#define LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE			0x4000
+
+/* The maximum number of store blocks read at once
+ */
+#define LIBVSHADOW_STORE_BLOCK_READER_MAXIMUM_NUMBER_OF_BLOCKS		64
+
+typedef struct libvshadow_store_block_reader libvshadow_store_block_reader_t;
+
+struct libvshadow_store_block_reader
+{
+	/* The read buffer
+	 */
+	uint8_t *buffer;
+
+	/* The read buffer size
+	 */
+	size_t buffer_size;
+
+	/* The offset of the data in the read buffer
+	 */
+	off64_t buffer_offset;
+
+	/* The size of the data in the read buffer
+	 */
+	size_t buffer_data_size;
+
+	/* The number of blocks to read at once
+	 */
+	int number_of_read_ahead_blocks;
+
+	/* The store block of the last read
+	 * its data references the read buffer
+	 */
+	libvshadow_store_block_t store_block;
+};
+
+int libvshadow_store_block_reader_initialize(
+     libvshadow_store_block_reader_t **store_block_reader,
+     libcerror_error_t **error );
+
+int libvshadow_store_block_reader_free(
+     libvshadow_store_block_reader_t **store_block_reader,
+     libcerror_error_t **error );
+
+int libvshadow_store_block_reader_set_read_ahead_size(
+     libvshadow_store_block_reader_t *store_block_reader,
+     size64_t read_ahead_size,
+     libcerror_error_t **error );
+
+int libvshadow_store_block_reader_read(
+     libvshadow_store_block_reader_t *store_block_reader,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libvshadow_statistics_t *statistics,
+     libvshadow_store_block_t **store_block,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_STORE_BLOCK_READER_H ) */
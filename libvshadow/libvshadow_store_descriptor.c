@@ -23,11 +23,13 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libvshadow_allocation_bitmap.h"
 #include "libvshadow_block_descriptor.h"
 #include "libvshadow_block_range_descriptor.h"
 #include "libvshadow_block_tree.h"
 #include "libvshadow_debug.h"
 #include "libvshadow_definitions.h"
+#include "libvshadow_histogram.h"
 #include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
@@ -37,10 +39,14 @@
 #include "libvshadow_libfdatetime.h"
 #include "libvshadow_libfguid.h"
 #include "libvshadow_libuna.h"
+#include "libvshadow_physical_block_map.h"
+#include "libvshadow_statistics.h"
 #include "libvshadow_store_block.h"
+#include "libvshadow_store_block_reader.h"
 #include "libvshadow_store_descriptor.h"
 
 #include "vshadow_store.h"
+#include "vshadow_volume.h"
 
 /* Creates a store descriptor
  * ake sure the value store_descriptor is referencing, is set to NULL
@@ -120,30 +126,41 @@ int libvshadow_store_descriptor_initialize(
 
 		goto on_error;
 	}
-	if( libcdata_btree_initialize(
-	     &( ( *store_descriptor )->forward_block_descriptors_tree ),
-	     LIBVSHADOW_BLOCK_DESCRIPTORS_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
+	if( libvshadow_block_table_initialize(
+	     &( ( *store_descriptor )->forward_block_descriptors_table ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create forward block descriptors tree.",
+		 "%s: unable to create forward block descriptors table.",
 		 function );
 
 		goto on_error;
 	}
-	if( libcdata_btree_initialize(
-	     &( ( *store_descriptor )->reverse_block_descriptors_tree ),
-	     LIBVSHADOW_BLOCK_DESCRIPTORS_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
+	if( libvshadow_block_array_initialize(
+	     &( ( *store_descriptor )->forward_block_descriptors_array ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create reverse block descriptors tree.",
+		 "%s: unable to create forward block descriptors array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_block_table_initialize(
+	     &( ( *store_descriptor )->reverse_block_descriptors_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reverse block descriptors table.",
 		 function );
 
 		goto on_error;
@@ -188,12 +205,40 @@ int libvshadow_store_descriptor_initialize(
 
 		goto on_error;
 	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *store_descriptor )->statistics_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize statistics mutex.",
+		 function );
+
+		goto on_error;
+	}
 #endif
 	return( 1 );
 
 on_error:
 	if( *store_descriptor != NULL )
 	{
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( ( *store_descriptor )->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( ( *store_descriptor )->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( ( *store_descriptor )->previous_block_offset_list != NULL )
+		{
+			libcdata_range_list_free(
+			 &( ( *store_descriptor )->previous_block_offset_list ),
+			 NULL,
+			 NULL );
+		}
 		if( ( *store_descriptor )->block_offset_list != NULL )
 		{
 			libcdata_range_list_free(
@@ -201,17 +246,23 @@ on_error:
 			 NULL,
 			 NULL );
 		}
-		if( ( *store_descriptor )->reverse_block_descriptors_tree != NULL )
+		if( ( *store_descriptor )->reverse_block_descriptors_table != NULL )
 		{
-			libcdata_btree_free(
-			 &( ( *store_descriptor )->reverse_block_descriptors_tree ),
+			libvshadow_block_table_free(
+			 &( ( *store_descriptor )->reverse_block_descriptors_table ),
 			 NULL,
 			 NULL );
 		}
-		if( ( *store_descriptor )->forward_block_descriptors_tree != NULL )
+		if( ( *store_descriptor )->forward_block_descriptors_array != NULL )
+		{
+			libvshadow_block_array_free(
+			 &( ( *store_descriptor )->forward_block_descriptors_array ),
+			 NULL );
+		}
+		if( ( *store_descriptor )->forward_block_descriptors_table != NULL )
 		{
-			libcdata_btree_free(
-			 &( ( *store_descriptor )->forward_block_descriptors_tree ),
+			libvshadow_block_table_free(
+			 &( ( *store_descriptor )->forward_block_descriptors_table ),
 			 NULL,
 			 NULL );
 		}
@@ -238,6 +289,7 @@ int libvshadow_store_descriptor_free(
      libcerror_error_t **error )
 {
 	static char *function = "libvshadow_store_descriptor_free";
+	int phase             = 0;
 	int result            = 1;
 
 	if( store_descriptor == NULL )
@@ -267,7 +319,52 @@ int libvshadow_store_descriptor_free(
 
 			result = -1;
 		}
+		if( libcthreads_mutex_free(
+		     &( ( *store_descriptor )->statistics_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free statistics mutex.",
+			 function );
+
+			result = -1;
+		}
 #endif
+		for( phase = 0;
+		     phase < LIBVSHADOW_NUMBER_OF_TIMING_PHASES;
+		     phase++ )
+		{
+			if( libvshadow_histogram_free(
+			     &( ( *store_descriptor )->phase_timing_histograms[ phase ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free phase: %d timing histogram.",
+				 function,
+				 phase );
+
+				result = -1;
+			}
+		}
+		if( libvshadow_allocation_bitmap_free(
+		     &( ( *store_descriptor )->allocation_bitmap ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free allocation bitmap.",
+			 function );
+
+			result = -1;
+		}
 		if( ( *store_descriptor )->operating_machine_string != NULL )
 		{
 			memory_free(
@@ -278,30 +375,46 @@ int libvshadow_store_descriptor_free(
 			memory_free(
 			 ( *store_descriptor )->service_machine_string );
 		}
-		if( libcdata_btree_free(
-		     &( ( *store_descriptor )->reverse_block_descriptors_tree ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free_reverse,
+		if( libvshadow_block_table_free(
+		     &( ( *store_descriptor )->reverse_block_descriptors_table ),
+		     &libvshadow_block_descriptor_free_reverse,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free reverse block descriptors tree.",
+			 "%s: unable to free reverse block descriptors table.",
 			 function );
 
 			result = -1;
 		}
-		if( libcdata_btree_free(
-		     &( ( *store_descriptor )->forward_block_descriptors_tree ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+		if( libvshadow_block_array_free(
+		     &( ( *store_descriptor )->forward_block_descriptors_array ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free forward block descriptors tree.",
+			 "%s: unable to free forward block descriptors array.",
+			 function );
+
+			result = -1;
+		}
+		/* The forward block descriptors table only contains block descriptors
+		 * if reading the block lists failed
+		 */
+		if( libvshadow_block_table_free(
+		     &( ( *store_descriptor )->forward_block_descriptors_table ),
+		     &libvshadow_block_descriptor_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free forward block descriptors table.",
 			 function );
 
 			result = -1;
@@ -356,14 +469,16 @@ int libvshadow_store_descriptor_free(
 	return( result );
 }
 
-/* Determines if the store has in-volume data
- * Returns 1 if the store has in-volume data, 0 if not or -1 on error
+/* Clears the block descriptors
+ * The block descriptors are read again when next needed
+ * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_has_in_volume_data(
+int libvshadow_store_descriptor_clear_block_descriptors(
      libvshadow_store_descriptor_t *store_descriptor,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_store_descriptor_has_in_volume_data";
+	static char *function = "libvshadow_store_descriptor_clear_block_descriptors";
+	int result            = 1;
 
 	if( store_descriptor == NULL )
 	{
@@ -376,91 +491,489 @@ int libvshadow_store_descriptor_has_in_volume_data(
 
 		return( -1 );
 	}
-	return( (int) store_descriptor->has_in_volume_store_data );
-}
-
-/* Compares 2 store descriptors by their creation time
- * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
- */
-int libvshadow_store_descriptor_compare_by_creation_time(
-     libvshadow_store_descriptor_t *first_store_descriptor,
-     libvshadow_store_descriptor_t *second_store_descriptor,
-     libcerror_error_t **error )
-{
-	static char *function = "libvshadow_store_descriptor_compare_by_creation_time";
-
-	if( first_store_descriptor == NULL )
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid first store descriptor.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( second_store_descriptor == NULL )
+#endif
+	if( store_descriptor->block_descriptors_read != 0 )
+	{
+		if( libvshadow_block_table_free(
+		     &( store_descriptor->reverse_block_descriptors_table ),
+		     &libvshadow_block_descriptor_free_reverse,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reverse block descriptors table.",
+			 function );
+
+			result = -1;
+		}
+		else if( libvshadow_block_table_initialize(
+		          &( store_descriptor->reverse_block_descriptors_table ),
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create reverse block descriptors table.",
+			 function );
+
+			result = -1;
+		}
+		if( result == 1 )
+		{
+			if( libvshadow_block_array_free(
+			     &( store_descriptor->forward_block_descriptors_array ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free forward block descriptors array.",
+				 function );
+
+				result = -1;
+			}
+			else if( libvshadow_block_array_initialize(
+			          &( store_descriptor->forward_block_descriptors_array ),
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create forward block descriptors array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			if( libvshadow_block_table_free(
+			     &( store_descriptor->forward_block_descriptors_table ),
+			     &libvshadow_block_descriptor_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free forward block descriptors table.",
+				 function );
+
+				result = -1;
+			}
+			else if( libvshadow_block_table_initialize(
+			          &( store_descriptor->forward_block_descriptors_table ),
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create forward block descriptors table.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			if( libcdata_list_empty(
+			     store_descriptor->block_descriptors_list,
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to empty block descriptors list.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			if( libcdata_range_list_empty(
+			     store_descriptor->block_offset_list,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to empty block offsets list.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			if( libcdata_range_list_empty(
+			     store_descriptor->previous_block_offset_list,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to empty previous block offsets list.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			store_descriptor->block_descriptors_read        = 0;
+			store_descriptor->block_descriptors_memory_size = 0;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid second store descriptor.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( first_store_descriptor->creation_time < second_store_descriptor->creation_time )
-	{
-		return( LIBCDATA_COMPARE_LESS );
-	}
-	else if( first_store_descriptor->creation_time > second_store_descriptor->creation_time )
-	{
-		return( LIBCDATA_COMPARE_GREATER );
-	}
-	return( LIBCDATA_COMPARE_EQUAL );
+#endif
+	return( result );
 }
 
-/* Compares 2 store descriptors by their identifier
- * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
+/* Evicts the block descriptors to free the memory used
+ * The block descriptors are read again when next needed
+ * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_compare_by_identifier(
-     libvshadow_store_descriptor_t *first_store_descriptor,
-     libvshadow_store_descriptor_t *second_store_descriptor,
+int libvshadow_store_descriptor_evict_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_store_descriptor_compare_by_identifier";
-	int result            = 0;
+	libvshadow_statistics_t statistics;
 
-	if( first_store_descriptor == NULL )
+	static char *function = "libvshadow_store_descriptor_evict_block_descriptors";
+
+	if( libvshadow_store_descriptor_clear_block_descriptors(
+	     store_descriptor,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid first store descriptor.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear block descriptors.",
 		 function );
 
 		return( -1 );
 	}
-	if( second_store_descriptor == NULL )
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvshadow_statistics_t ) ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid second store descriptor.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
 		 function );
 
 		return( -1 );
 	}
-	result = memory_compare(
-	          first_store_descriptor->identifier,
-	          second_store_descriptor->identifier,
-	          16 );
+	statistics.number_of_index_evictions = 1;
 
-	if( result < 0 )
+	if( libvshadow_store_descriptor_add_statistics(
+	     store_descriptor,
+	     &statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the memory usage of the block descriptors
+ * The memory size is an estimate and the used time the timestamp of the last use
+ * Returns 1 if successful, 0 if the block descriptors have not been read or -1 on error
+ */
+int libvshadow_store_descriptor_get_block_descriptors_usage(
+     libvshadow_store_descriptor_t *store_descriptor,
+     size64_t *memory_size,
+     uint64_t *used_time,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_block_descriptors_usage";
+	int result            = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory size.",
+		 function );
+
+		return( -1 );
+	}
+	if( used_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid used time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->block_descriptors_read != 0 )
+	{
+		*memory_size = store_descriptor->block_descriptors_memory_size;
+		*used_time   = store_descriptor->block_descriptors_used_time;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the next store descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_set_next_store_descriptor(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *next_store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_set_next_store_descriptor";
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	store_descriptor->next_store_descriptor = next_store_descriptor;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Determines if the store has in-volume data
+ * Returns 1 if the store has in-volume data, 0 if not or -1 on error
+ */
+int libvshadow_store_descriptor_has_in_volume_data(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_has_in_volume_data";
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	return( (int) store_descriptor->has_in_volume_store_data );
+}
+
+/* Compares 2 store descriptors by their creation time
+ * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
+ */
+int libvshadow_store_descriptor_compare_by_creation_time(
+     libvshadow_store_descriptor_t *first_store_descriptor,
+     libvshadow_store_descriptor_t *second_store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_compare_by_creation_time";
+
+	if( first_store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( second_store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid second store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_store_descriptor->creation_time < second_store_descriptor->creation_time )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	else if( first_store_descriptor->creation_time > second_store_descriptor->creation_time )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	return( LIBCDATA_COMPARE_EQUAL );
+}
+
+/* Compares 2 store descriptors by their identifier
+ * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
+ */
+int libvshadow_store_descriptor_compare_by_identifier(
+     libvshadow_store_descriptor_t *first_store_descriptor,
+     libvshadow_store_descriptor_t *second_store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_compare_by_identifier";
+	int result            = 0;
+
+	if( first_store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( second_store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid second store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	result = memory_compare(
+	          first_store_descriptor->identifier,
+	          second_store_descriptor->identifier,
+	          16 );
+
+	if( result < 0 )
 	{
 		return( LIBCDATA_COMPARE_LESS );
 	}
@@ -832,21 +1345,27 @@ on_error:
 	return( -1 );
 }
 
-/* Reads the store header
+/* Reads the store header if not already read
+ * The store block reader is optional and allows store headers to share a read buffer
  * Returns 1 if successful or -1 on error
  */
 int libvshadow_store_descriptor_read_store_header(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_block_reader_t *store_block_reader,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	libvshadow_store_block_t *store_block = NULL;
-	uint8_t *store_header_data            = NULL;
-	static char *function                 = "libvshadow_store_descriptor_read_store_header";
-	size_t store_header_data_offset       = 0;
+	libvshadow_statistics_t statistics;
+
+	libvshadow_store_block_reader_t *local_store_block_reader = NULL;
+	libvshadow_store_block_t *store_block                     = NULL;
+	uint8_t *store_header_data                                = NULL;
+	static char *function                                     = "libvshadow_store_descriptor_read_store_header";
+	size_t store_header_data_offset                           = 0;
+	uint64_t timestamp                                        = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
-	uint32_t value_32bit                  = 0;
+	uint32_t value_32bit                                      = 0;
 #endif
 
 	if( store_descriptor == NULL )
@@ -875,360 +1394,411 @@ int libvshadow_store_descriptor_read_store_header(
 		return( -1 );
 	}
 #endif
-	if( libvshadow_store_block_initialize(
-	     &store_block,
-	     0x4000,
-	     error ) != 1 )
+	if( store_descriptor->store_header_read == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create store block.",
-		 function );
+		/* Without a shared store block reader the store header is read on its own
+		 */
+		if( store_block_reader == NULL )
+		{
+			if( libvshadow_store_block_reader_initialize(
+			     &local_store_block_reader,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create store block reader.",
+				 function );
 
-		goto on_error;
-	}
-	if( libvshadow_store_block_read(
-	     store_block,
-	     file_io_handle,
-	     store_descriptor->store_header_offset,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read store block at offset: %" PRIi64 ".",
-		 function,
-		 store_descriptor->store_header_offset );
-
-		goto on_error;
-	}
-	if( store_block->record_type != LIBVSHADOW_RECORD_TYPE_STORE_HEADER )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported record type: %" PRIu32 ".",
-		 function,
-		 store_block->record_type );
-
-		return( -1 );
-	}
-	store_header_data = &( store_block->data[ sizeof( vshadow_store_header_t ) ] );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: store header information:\n",
-		 function );
-		libcnotify_print_data(
-		 store_header_data,
-		 sizeof( vshadow_store_information_t ),
-		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
-	}
-#endif
-	if( memory_copy(
-	     store_descriptor->copy_identifier,
-	     ( (vshadow_store_information_t *) store_header_data )->copy_identifier,
-	     16 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy shadow copy identifier.",
-		 function );
-
-		goto on_error;
-	}
-	if( memory_copy(
-	     store_descriptor->copy_set_identifier,
-	     ( (vshadow_store_information_t *) store_header_data )->copy_set_identifier,
-	     16 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy shadow copy set identifier.",
-		 function );
+				goto on_error;
+			}
+			store_block_reader = local_store_block_reader;
+		}
+		if( memory_set(
+		     &statistics,
+		     0,
+		     sizeof( libvshadow_statistics_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear statistics.",
+			 function );
 
-		goto on_error;
-	}
-	byte_stream_copy_to_uint32_little_endian(
-	 ( (vshadow_store_information_t *) store_header_data )->attribute_flags,
-	 store_descriptor->attribute_flags );
+			goto on_error;
+		}
+		if( store_descriptor->phase_timing_enabled != 0 )
+		{
+			timestamp = libvshadow_statistics_get_timestamp();
+		}
+		if( libvshadow_store_block_reader_read(
+		     store_block_reader,
+		     file_io_handle,
+		     store_descriptor->store_header_offset,
+		     &statistics,
+		     &store_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read store block at offset: %" PRIi64 ".",
+			 function,
+			 store_descriptor->store_header_offset );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		if( libvshadow_debug_print_guid_value(
-		     function,
-		     "unknown5\t\t\t",
-		     ( (vshadow_store_information_t *) store_header_data )->unknown5,
-		     16,
-		     LIBFGUID_ENDIAN_LITTLE,
-		     LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
+			goto on_error;
+		}
+		if( store_descriptor->phase_timing_enabled != 0 )
+		{
+			statistics.phase_times[ LIBVSHADOW_TIMING_PHASE_STORE_HEADER_READ ] = libvshadow_statistics_get_timestamp() - timestamp;
+			statistics.phase_timing_enabled                                     = 1;
+		}
+		if( libvshadow_store_descriptor_add_statistics(
+		     store_descriptor,
+		     &statistics,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print GUID value.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add statistics.",
 			 function );
 
 			goto on_error;
 		}
-		if( libvshadow_debug_print_guid_value(
-		     function,
-		     "copy identifier\t\t",
-		     ( (vshadow_store_information_t *) store_header_data )->copy_identifier,
-		     16,
-		     LIBFGUID_ENDIAN_LITTLE,
-		     LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
-		     error ) != 1 )
+		if( store_block->record_type != LIBVSHADOW_RECORD_TYPE_STORE_HEADER )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print GUID value.",
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported record type: %" PRIu32 ".",
+			 function,
+			 store_block->record_type );
+
+			goto on_error;
+		}
+		store_header_data = &( store_block->data[ sizeof( vshadow_store_header_t ) ] );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: store header information:\n",
+			 function );
+			libcnotify_print_data(
+			 store_header_data,
+			 sizeof( vshadow_store_information_t ),
+			 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
+		}
+#endif
+		if( memory_copy(
+		     store_descriptor->copy_identifier,
+		     ( (vshadow_store_information_t *) store_header_data )->copy_identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy shadow copy identifier.",
 			 function );
 
 			goto on_error;
 		}
-		if( libvshadow_debug_print_guid_value(
-		     function,
-		     "copy set identifier\t",
+		if( memory_copy(
+		     store_descriptor->copy_set_identifier,
 		     ( (vshadow_store_information_t *) store_header_data )->copy_set_identifier,
-		     16,
-		     LIBFGUID_ENDIAN_LITTLE,
-		     LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
-		     error ) != 1 )
+		     16 ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print GUID value.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy shadow copy set identifier.",
 			 function );
 
 			goto on_error;
 		}
 		byte_stream_copy_to_uint32_little_endian(
-		 ( (vshadow_store_information_t *) store_header_data )->type,
-		 value_32bit );
-		libcnotify_printf(
-		 "%s: type\t\t\t: 0x%08" PRIx32 "\n",
-		 function,
-		 value_32bit );
-
-		byte_stream_copy_to_uint32_little_endian(
-		 ( (vshadow_store_information_t *) store_header_data )->provider,
-		 value_32bit );
-		libcnotify_printf(
-		 "%s: provider\t\t\t: %" PRIu32 "\n",
-		 function,
-		 value_32bit );
-
-		libcnotify_printf(
-		 "%s: attribute flags\t\t: 0x%08" PRIx32 "\n",
-		 function,
-		 store_descriptor->attribute_flags );
-		libvshadow_debug_print_attribute_flags(
+		 ( (vshadow_store_information_t *) store_header_data )->attribute_flags,
 		 store_descriptor->attribute_flags );
-		libcnotify_printf(
-		 "\n" );
 
-		byte_stream_copy_to_uint32_little_endian(
-		 ( (vshadow_store_information_t *) store_header_data )->unknown10,
-		 value_32bit );
-		libcnotify_printf(
-		 "%s: unknown10\t\t: 0x%08" PRIx32 "\n",
-		 function,
-		 value_32bit );
-	}
-#endif
-	store_header_data_offset = sizeof( vshadow_store_information_t );
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( libvshadow_debug_print_guid_value(
+			     function,
+			     "unknown5\t\t\t",
+			     ( (vshadow_store_information_t *) store_header_data )->unknown5,
+			     16,
+			     LIBFGUID_ENDIAN_LITTLE,
+			     LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print GUID value.",
+				 function );
 
-	byte_stream_copy_to_uint16_little_endian(
-	 &( store_header_data[ store_header_data_offset ] ),
-	 store_descriptor->operating_machine_string_size );
+				goto on_error;
+			}
+			if( libvshadow_debug_print_guid_value(
+			     function,
+			     "copy identifier\t\t",
+			     ( (vshadow_store_information_t *) store_header_data )->copy_identifier,
+			     16,
+			     LIBFGUID_ENDIAN_LITTLE,
+			     LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print GUID value.",
+				 function );
 
-	store_header_data_offset += 2;
+				goto on_error;
+			}
+			if( libvshadow_debug_print_guid_value(
+			     function,
+			     "copy set identifier\t",
+			     ( (vshadow_store_information_t *) store_header_data )->copy_set_identifier,
+			     16,
+			     LIBFGUID_ENDIAN_LITTLE,
+			     LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print GUID value.",
+				 function );
 
-	if( ( store_header_data_offset + store_descriptor->operating_machine_string_size ) > store_block->data_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: operating machine string size value out of bounds.",
-		 function );
+				goto on_error;
+			}
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (vshadow_store_information_t *) store_header_data )->type,
+			 value_32bit );
+			libcnotify_printf(
+			 "%s: type\t\t\t: 0x%08" PRIx32 "\n",
+			 function,
+			 value_32bit );
 
-		goto on_error;
-	}
-	store_descriptor->operating_machine_string = (uint8_t *) memory_allocate(
-	                                                          sizeof( uint8_t ) * store_descriptor->operating_machine_string_size );
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (vshadow_store_information_t *) store_header_data )->provider,
+			 value_32bit );
+			libcnotify_printf(
+			 "%s: provider\t\t\t: %" PRIu32 "\n",
+			 function,
+			 value_32bit );
 
-	if( store_descriptor->operating_machine_string == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create operating machine string.",
-		 function );
+			libcnotify_printf(
+			 "%s: attribute flags\t\t: 0x%08" PRIx32 "\n",
+			 function,
+			 store_descriptor->attribute_flags );
+			libvshadow_debug_print_attribute_flags(
+			 store_descriptor->attribute_flags );
+			libcnotify_printf(
+			 "\n" );
 
-		goto on_error;
-	}
-	if( memory_copy(
-	     store_descriptor->operating_machine_string,
-	     &( store_header_data[ store_header_data_offset ] ),
-	     (size_t) store_descriptor->operating_machine_string_size ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy operating machine string.",
-		 function );
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (vshadow_store_information_t *) store_header_data )->unknown10,
+			 value_32bit );
+			libcnotify_printf(
+			 "%s: unknown10\t\t: 0x%08" PRIx32 "\n",
+			 function,
+			 value_32bit );
+		}
+#endif
+		store_header_data_offset = sizeof( vshadow_store_information_t );
 
-		goto on_error;
-	}
-	store_header_data_offset += store_descriptor->operating_machine_string_size;
+		byte_stream_copy_to_uint16_little_endian(
+		 &( store_header_data[ store_header_data_offset ] ),
+		 store_descriptor->operating_machine_string_size );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		if( libvshadow_debug_print_utf16_string_value(
-		     function,
-		     "operating machine string\t",
-		     store_descriptor->operating_machine_string,
-		     (size_t) store_descriptor->operating_machine_string_size,
-		     LIBUNA_ENDIAN_LITTLE,
-		     error ) != 1 )
+		store_header_data_offset += 2;
+
+		if( ( store_header_data_offset + store_descriptor->operating_machine_string_size ) > store_block->data_size )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print UTF-16 string value.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: operating machine string size value out of bounds.",
 			 function );
 
 			goto on_error;
 		}
-	}
-#endif
-	byte_stream_copy_to_uint16_little_endian(
-	 &( store_header_data[ store_header_data_offset ] ),
-	 store_descriptor->service_machine_string_size );
+		store_descriptor->operating_machine_string = (uint8_t *) memory_allocate(
+		                                                          sizeof( uint8_t ) * store_descriptor->operating_machine_string_size );
 
-	store_header_data_offset += 2;
+		if( store_descriptor->operating_machine_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create operating machine string.",
+			 function );
 
-	if( ( store_header_data_offset + store_descriptor->service_machine_string_size ) > store_block->data_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: operating machine string size value out of bounds.",
-		 function );
+			goto on_error;
+		}
+		if( memory_copy(
+		     store_descriptor->operating_machine_string,
+		     &( store_header_data[ store_header_data_offset ] ),
+		     (size_t) store_descriptor->operating_machine_string_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy operating machine string.",
+			 function );
 
-		goto on_error;
-	}
-	store_descriptor->service_machine_string = (uint8_t *) memory_allocate(
-	                                                        sizeof( uint8_t ) * store_descriptor->service_machine_string_size );
+			goto on_error;
+		}
+		store_header_data_offset += store_descriptor->operating_machine_string_size;
 
-	if( store_descriptor->service_machine_string == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create service machine string.",
-		 function );
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( libvshadow_debug_print_utf16_string_value(
+			     function,
+			     "operating machine string\t",
+			     store_descriptor->operating_machine_string,
+			     (size_t) store_descriptor->operating_machine_string_size,
+			     LIBUNA_ENDIAN_LITTLE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print UTF-16 string value.",
+				 function );
 
-		goto on_error;
-	}
-	if( memory_copy(
-	     store_descriptor->service_machine_string,
-	     &( store_header_data[ store_header_data_offset ] ),
-	     (size_t) store_descriptor->service_machine_string_size ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy service machine string.",
-		 function );
+				goto on_error;
+			}
+		}
+#endif
+		byte_stream_copy_to_uint16_little_endian(
+		 &( store_header_data[ store_header_data_offset ] ),
+		 store_descriptor->service_machine_string_size );
 
-		goto on_error;
-	}
-	store_header_data_offset += store_descriptor->service_machine_string_size;
+		store_header_data_offset += 2;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		if( libvshadow_debug_print_utf16_string_value(
-		     function,
-		     "service machine string\t",
-		     store_descriptor->service_machine_string,
-		     (size_t) store_descriptor->service_machine_string_size,
-		     LIBUNA_ENDIAN_LITTLE,
-		     error ) != 1 )
+		if( ( store_header_data_offset + store_descriptor->service_machine_string_size ) > store_block->data_size )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print UTF-16 string value.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: operating machine string size value out of bounds.",
 			 function );
 
 			goto on_error;
 		}
-	}
+		store_descriptor->service_machine_string = (uint8_t *) memory_allocate(
+		                                                        sizeof( uint8_t ) * store_descriptor->service_machine_string_size );
+
+		if( store_descriptor->service_machine_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create service machine string.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     store_descriptor->service_machine_string,
+		     &( store_header_data[ store_header_data_offset ] ),
+		     (size_t) store_descriptor->service_machine_string_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy service machine string.",
+			 function );
+
+			goto on_error;
+		}
+		store_header_data_offset += store_descriptor->service_machine_string_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( libvshadow_debug_print_utf16_string_value(
+			     function,
+			     "service machine string\t",
+			     store_descriptor->service_machine_string,
+			     (size_t) store_descriptor->service_machine_string_size,
+			     LIBUNA_ENDIAN_LITTLE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print UTF-16 string value.",
+				 function );
+
+				goto on_error;
+			}
+		}
 #endif
 #if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		if( store_header_data_offset < store_block->data_size )
+		if( libcnotify_verbose != 0 )
 		{
-			libcnotify_printf(
-			 "%s: trailing data:\n",
-			 function );
-			libcnotify_print_data(
-			 &( store_header_data[ store_header_data_offset ] ),
-			 store_block->data_size - store_header_data_offset,
-			 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
+			if( store_header_data_offset < store_block->data_size )
+			{
+				libcnotify_printf(
+				 "%s: trailing data:\n",
+				 function );
+				libcnotify_print_data(
+				 &( store_header_data[ store_header_data_offset ] ),
+				 store_block->data_size - store_header_data_offset,
+				 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
+			}
 		}
-	}
 #endif
-	if( libvshadow_store_block_free(
-	     &store_block,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free store block.",
-		 function );
+		if( local_store_block_reader != NULL )
+		{
+			if( libvshadow_store_block_reader_free(
+			     &local_store_block_reader,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free store block reader.",
+				 function );
 
-		goto on_error;
-	}
+				goto on_error;
+			}
+		}
 #if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "\n" );
-	}
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "\n" );
+		}
 #endif
+		store_descriptor->store_header_read = 1;
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     store_descriptor->read_write_lock,
@@ -1247,10 +1817,24 @@ int libvshadow_store_descriptor_read_store_header(
 	return( 1 );
 
 on_error:
-	if( store_block != NULL )
+	if( store_descriptor->service_machine_string != NULL )
+	{
+		memory_free(
+		 store_descriptor->service_machine_string );
+
+		store_descriptor->service_machine_string = NULL;
+	}
+	if( store_descriptor->operating_machine_string != NULL )
+	{
+		memory_free(
+		 store_descriptor->operating_machine_string );
+
+		store_descriptor->operating_machine_string = NULL;
+	}
+	if( local_store_block_reader != NULL )
 	{
-		libvshadow_store_block_free(
-		 &store_block,
+		libvshadow_store_block_reader_free(
+		 &local_store_block_reader,
 		 NULL );
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
@@ -1267,17 +1851,20 @@ on_error:
  */
 int libvshadow_store_descriptor_read_store_bitmap(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_block_reader_t *store_block_reader,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      libcdata_range_list_t *offset_list,
      off64_t *bitmap_offset,
      off64_t *next_offset,
+     libvshadow_statistics_t *statistics,
      libcerror_error_t **error )
 {
 	libvshadow_store_block_t *store_block = NULL;
 	uint8_t *block_data                   = NULL;
 	static char *function                 = "libvshadow_store_descriptor_read_store_bitmap";
 	off64_t start_offset                  = 0;
+	uint64_t timestamp                    = 0;
 	uint32_t value_32bit                  = 0;
 	uint16_t block_size                   = 0;
 	uint8_t bit_index                     = 0;
@@ -1315,25 +1902,18 @@ int libvshadow_store_descriptor_read_store_bitmap(
 
 		return( -1 );
 	}
-	if( libvshadow_store_block_initialize(
-	     &store_block,
-	     0x4000,
-	     error ) != 1 )
+	if( ( statistics != NULL )
+	 && ( statistics->phase_timing_enabled != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create store block.",
-		 function );
-
-		goto on_error;
+		timestamp = libvshadow_statistics_get_timestamp();
 	}
-	if( libvshadow_store_block_read(
-	     store_block,
+	if( libvshadow_store_block_reader_read(
+	     store_block_reader,
 	     file_io_handle,
 	     file_offset,
-	     error ) == -1 )
+	     statistics,
+	     &store_block,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1471,19 +2051,6 @@ int libvshadow_store_descriptor_read_store_bitmap(
 			goto on_error;
 		}
 	}
-	if( libvshadow_store_block_free(
-	     &store_block,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free store block.",
-		 function );
-
-		goto on_error;
-	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -1491,15 +2058,14 @@ int libvshadow_store_descriptor_read_store_bitmap(
 		 "\n" );
 	}
 #endif
+	if( ( statistics != NULL )
+	 && ( statistics->phase_timing_enabled != 0 ) )
+	{
+		statistics->phase_times[ LIBVSHADOW_TIMING_PHASE_BITMAP_PARSE ] += libvshadow_statistics_get_timestamp() - timestamp;
+	}
 	return( 1 );
 
 on_error:
-	if( store_block != NULL )
-	{
-		libvshadow_store_block_free(
-		 &store_block,
-		 NULL );
-	}
 	return( -1 );
 }
 
@@ -1509,15 +2075,20 @@ on_error:
  */
 int libvshadow_store_descriptor_read_store_block_list(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_block_reader_t *store_block_reader,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      off64_t *next_offset,
+     libvshadow_statistics_t *statistics,
      libcerror_error_t **error )
 {
 	libvshadow_store_block_t *store_block           = NULL;
 	libvshadow_block_descriptor_t *block_descriptor = NULL;
 	uint8_t *block_data                             = NULL;
 	static char *function                           = "libvshadow_store_descriptor_read_store_block_list";
+	uint64_t timestamp                              = 0;
+	uint64_t tree_insert_time                       = 0;
+	uint64_t tree_insert_timestamp                  = 0;
 	uint16_t block_size                             = 0;
 	int result                                      = 0;
 
@@ -1543,25 +2114,18 @@ int libvshadow_store_descriptor_read_store_block_list(
 
 		return( -1 );
 	}
-	if( libvshadow_store_block_initialize(
-	     &store_block,
-	     0x4000,
-	     error ) != 1 )
+	if( ( statistics != NULL )
+	 && ( statistics->phase_timing_enabled != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create store block.",
-		 function );
-
-		goto on_error;
+		timestamp = libvshadow_statistics_get_timestamp();
 	}
-	if( libvshadow_store_block_read(
-	     store_block,
+	if( libvshadow_store_block_reader_read(
+	     store_block_reader,
 	     file_io_handle,
 	     file_offset,
-	     error ) == -1 )
+	     statistics,
+	     &store_block,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1625,9 +2189,14 @@ int libvshadow_store_descriptor_read_store_block_list(
 		}
 		else if( result != 0 )
 		{
+			if( ( statistics != NULL )
+			 && ( statistics->phase_timing_enabled != 0 ) )
+			{
+				tree_insert_timestamp = libvshadow_statistics_get_timestamp();
+			}
 			if( libvshadow_block_tree_insert(
-			     store_descriptor->forward_block_descriptors_tree,
-			     store_descriptor->reverse_block_descriptors_tree,
+			     store_descriptor->forward_block_descriptors_table,
+			     store_descriptor->reverse_block_descriptors_table,
 			     block_descriptor,
 			     store_descriptor->index,
 			     error ) != 1 )
@@ -1636,11 +2205,16 @@ int libvshadow_store_descriptor_read_store_block_list(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to insert block descriptor in tree.",
+				 "%s: unable to insert block descriptor in block tables.",
 				 function );
 
 				goto on_error;
 			}
+			if( ( statistics != NULL )
+			 && ( statistics->phase_timing_enabled != 0 ) )
+			{
+				tree_insert_time += libvshadow_statistics_get_timestamp() - tree_insert_timestamp;
+			}
 			if( libcdata_list_append_value(
 			     store_descriptor->block_descriptors_list,
 			     (intptr_t *) block_descriptor,
@@ -1679,18 +2253,13 @@ int libvshadow_store_descriptor_read_store_block_list(
 		block_data += sizeof( vshadow_store_block_list_entry_t );
 		block_size -= sizeof( vshadow_store_block_list_entry_t );
 	}
-	if( libvshadow_store_block_free(
-	     &store_block,
-	     error ) != 1 )
+	if( ( statistics != NULL )
+	 && ( statistics->phase_timing_enabled != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free store block.",
-		 function );
-
-		goto on_error;
+		/* The tree insert time is not included in the block list parse time
+		 */
+		statistics->phase_times[ LIBVSHADOW_TIMING_PHASE_BLOCK_LIST_PARSE ] += libvshadow_statistics_get_timestamp() - timestamp - tree_insert_time;
+		statistics->phase_times[ LIBVSHADOW_TIMING_PHASE_TREE_INSERT ]      += tree_insert_time;
 	}
 	return( 1 );
 
@@ -1701,12 +2270,6 @@ on_error:
 		 &block_descriptor,
 		 NULL );
 	}
-	if( store_block != NULL )
-	{
-		libvshadow_store_block_free(
-		 &store_block,
-		 NULL );
-	}
 	return( -1 );
 }
 
@@ -1716,17 +2279,20 @@ on_error:
  */
 int libvshadow_store_descriptor_read_store_block_range_list(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_block_reader_t *store_block_reader,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      off64_t *next_offset,
+     libvshadow_statistics_t *statistics,
      libcerror_error_t **error )
 {
-	libvshadow_store_block_t *store_block                       = NULL;
-	libvshadow_block_range_descriptor_t *block_range_descriptor = NULL;
-	uint8_t *block_data                                         = NULL;
-	static char *function                                       = "libvshadow_store_descriptor_read_store_block_range_list";
-	uint16_t block_size                                         = 0;
-	int result                                                  = 0;
+	libvshadow_block_range_descriptor_t block_range_descriptor;
+
+	libvshadow_store_block_t *store_block = NULL;
+	uint8_t *block_data                   = NULL;
+	static char *function                 = "libvshadow_store_descriptor_read_store_block_range_list";
+	uint64_t timestamp                    = 0;
+	uint16_t block_size                   = 0;
 
 	if( store_descriptor == NULL )
 	{
@@ -1750,25 +2316,18 @@ int libvshadow_store_descriptor_read_store_block_range_list(
 
 		return( -1 );
 	}
-	if( libvshadow_store_block_initialize(
-	     &store_block,
-	     0x4000,
-	     error ) != 1 )
+	if( ( statistics != NULL )
+	 && ( statistics->phase_timing_enabled != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create store block.",
-		 function );
-
-		goto on_error;
+		timestamp = libvshadow_statistics_get_timestamp();
 	}
-	if( libvshadow_store_block_read(
-	     store_block,
+	if( libvshadow_store_block_reader_read(
+	     store_block_reader,
 	     file_io_handle,
 	     file_offset,
-	     error ) == -1 )
+	     statistics,
+	     &store_block,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1797,29 +2356,17 @@ int libvshadow_store_descriptor_read_store_block_range_list(
 	block_data = &( store_block->data[ sizeof( vshadow_store_block_header_t ) ] );
 	block_size = (uint16_t) ( store_block->data_size - sizeof( vshadow_store_block_header_t ) );
 
-	while( block_size >= sizeof( vshadow_store_block_list_entry_t ) )
+	/* The block range descriptors are decoded into a single descriptor on
+	 * the stack since they are not used to determine the source of the data
+	 */
+	while( block_size >= sizeof( vshadow_store_block_range_list_entry_t ) )
 	{
-		if( libvshadow_block_range_descriptor_initialize(
+		if( libvshadow_block_range_descriptor_read_data(
 		     &block_range_descriptor,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create block range descriptor.",
-			 function );
-
-			goto on_error;
-		}
-		result = libvshadow_block_range_descriptor_read_data(
-			  block_range_descriptor,
-			  block_data,
-			  block_size,
-			  store_descriptor->index,
-			  error );
-
-		if( result == -1 )
+		     block_data,
+		     block_size,
+		     store_descriptor->index,
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -1830,60 +2377,17 @@ int libvshadow_store_descriptor_read_store_block_range_list(
 
 			goto on_error;
 		}
-		else if( result != 0 )
-		{
-/* TODO do something useful with the range descriptors */
-		}
-		if( block_range_descriptor != NULL )
-		{
-			if( libvshadow_block_range_descriptor_free(
-			     &block_range_descriptor,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free block range descriptor.",
-				 function );
-
-				block_range_descriptor = NULL;
-
-				goto on_error;
-			}
-			block_range_descriptor = NULL;
-		}
 		block_data += sizeof( vshadow_store_block_range_list_entry_t );
 		block_size -= sizeof( vshadow_store_block_range_list_entry_t );
 	}
-	if( libvshadow_store_block_free(
-	     &store_block,
-	     error ) != 1 )
+	if( ( statistics != NULL )
+	 && ( statistics->phase_timing_enabled != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free store block.",
-		 function );
-
-		goto on_error;
+		statistics->phase_times[ LIBVSHADOW_TIMING_PHASE_BLOCK_LIST_PARSE ] += libvshadow_statistics_get_timestamp() - timestamp;
 	}
 	return( 1 );
 
 on_error:
-	if( block_range_descriptor != NULL )
-	{
-		libvshadow_block_range_descriptor_free(
-		 &block_range_descriptor,
-		 NULL );
-	}
-	if( store_block != NULL )
-	{
-		libvshadow_store_block_free(
-		 &store_block,
-		 NULL );
-	}
 	return( -1 );
 }
 
@@ -1893,11 +2397,18 @@ on_error:
 int libvshadow_store_descriptor_read_block_descriptors(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
+     libvshadow_statistics_t *statistics,
      libcerror_error_t **error )
 {
-	static char *function      = "libvshadow_store_descriptor_read_block_descriptors";
-	off64_t bitmap_offset      = 0;
-	off64_t store_block_offset = 0;
+	libvshadow_store_block_reader_t *store_block_reader = NULL;
+	static char *function                               = "libvshadow_store_descriptor_read_block_descriptors";
+	off64_t bitmap_offset                               = 0;
+	off64_t store_block_offset                          = 0;
+	uint64_t build_timestamp                            = 0;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	uint64_t timestamp                                  = 0;
+#endif
 
 	if( store_descriptor == NULL )
 	{
@@ -1911,6 +2422,10 @@ int libvshadow_store_descriptor_read_block_descriptors(
 		return( -1 );
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( statistics != NULL )
+	{
+		timestamp = libvshadow_statistics_get_timestamp();
+	}
 	if( libcthreads_read_write_lock_grab_for_write(
 	     store_descriptor->read_write_lock,
 	     error ) != 1 )
@@ -1924,21 +2439,43 @@ int libvshadow_store_descriptor_read_block_descriptors(
 
 		return( -1 );
 	}
+	if( statistics != NULL )
+	{
+		statistics->lock_wait_time += libvshadow_statistics_get_timestamp() - timestamp;
+	}
 #endif
 	if( store_descriptor->block_descriptors_read == 0 )
 	{
-		bitmap_offset      = 0;
-		store_block_offset = store_descriptor->store_bitmap_offset;
+		/* The store block reader is shared by the metadata chains
+		 * so that its read buffer is allocated only once
+		 */
+		if( libvshadow_store_block_reader_initialize(
+		     &store_block_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create store block reader.",
+			 function );
+
+			goto on_error;
+		}
+		bitmap_offset      = 0;
+		store_block_offset = store_descriptor->store_bitmap_offset;
 
 		while( store_block_offset != 0 )
 		{
 			if( libvshadow_store_descriptor_read_store_bitmap(
 			     store_descriptor,
+			     store_block_reader,
 			     file_io_handle,
 			     store_block_offset,
 			     store_descriptor->block_offset_list,
 			     &bitmap_offset,
 			     &store_block_offset,
+			     statistics,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -1958,11 +2495,13 @@ int libvshadow_store_descriptor_read_block_descriptors(
 		{
 			if( libvshadow_store_descriptor_read_store_bitmap(
 			     store_descriptor,
+			     store_block_reader,
 			     file_io_handle,
 			     store_block_offset,
 			     store_descriptor->previous_block_offset_list,
 			     &bitmap_offset,
 			     &store_block_offset,
+			     statistics,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -1981,9 +2520,11 @@ int libvshadow_store_descriptor_read_block_descriptors(
 		{
 			if( libvshadow_store_descriptor_read_store_block_list(
 			     store_descriptor,
+			     store_block_reader,
 			     file_io_handle,
 			     store_block_offset,
 			     &store_block_offset,
+			     statistics,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -1996,29 +2537,112 @@ int libvshadow_store_descriptor_read_block_descriptors(
 				goto on_error;
 			}
 		}
-		store_block_offset = store_descriptor->store_block_range_list_offset;
+		/* The block descriptors are merged in block list order by the forward
+		 * block descriptors table and are sorted only once afterwards
+		 */
+		if( ( statistics != NULL )
+		 && ( statistics->phase_timing_enabled != 0 ) )
+		{
+			build_timestamp = libvshadow_statistics_get_timestamp();
+		}
+		if( libvshadow_block_array_build_from_table(
+		     store_descriptor->forward_block_descriptors_array,
+		     store_descriptor->forward_block_descriptors_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to build forward block descriptors array.",
+			 function );
 
-		while( store_block_offset != 0 )
+			goto on_error;
+		}
+		if( libvshadow_block_table_free(
+		     &( store_descriptor->forward_block_descriptors_table ),
+		     NULL,
+		     error ) != 1 )
 		{
-			if( libvshadow_store_descriptor_read_store_block_range_list(
-			     store_descriptor,
-			     file_io_handle,
-			     store_block_offset,
-			     &store_block_offset,
-			     error ) != 1 )
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free forward block descriptors table.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( statistics != NULL )
+		 && ( statistics->phase_timing_enabled != 0 ) )
+		{
+			statistics->phase_times[ LIBVSHADOW_TIMING_PHASE_TREE_INSERT ] += libvshadow_statistics_get_timestamp() - build_timestamp;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		/* The store block range list does not contribute to the block
+		 * descriptors and is only read to print its entries
+		 */
+		if( libcnotify_verbose != 0 )
+		{
+			store_block_offset = store_descriptor->store_block_range_list_offset;
+
+			while( store_block_offset != 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read store block range list.",
-				 function );
+				if( libvshadow_store_descriptor_read_store_block_range_list(
+				     store_descriptor,
+				     store_block_reader,
+				     file_io_handle,
+				     store_block_offset,
+				     &store_block_offset,
+				     statistics,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read store block range list.",
+					 function );
 
-				goto on_error;
+					goto on_error;
+				}
 			}
 		}
+#endif
+		if( libvshadow_store_block_reader_free(
+		     &store_block_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store block reader.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvshadow_store_descriptor_calculate_block_descriptors_memory_size(
+		     store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate block descriptors memory size.",
+			 function );
+
+			goto on_error;
+		}
+		if( statistics != NULL )
+		{
+			statistics->number_of_index_loads += 1;
+		}
 		store_descriptor->block_descriptors_read = 1;
 	}
+	store_descriptor->block_descriptors_used_time = libvshadow_statistics_get_timestamp();
+
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     store_descriptor->read_write_lock,
@@ -2037,6 +2661,12 @@ int libvshadow_store_descriptor_read_block_descriptors(
 	return( 1 );
 
 on_error:
+	if( store_block_reader != NULL )
+	{
+		libvshadow_store_block_reader_free(
+		 &store_block_reader,
+		 NULL );
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	libcthreads_read_write_lock_release_for_write(
 	 store_descriptor->read_write_lock,
@@ -2045,38 +2675,233 @@ on_error:
 	return( -1 );
 }
 
-/* Reads data at the specified offset into a buffer
- * Returns the number of bytes read or -1 on error
+/* Calculates the estimated size of the memory used by the block descriptors
+ * This function expects the read/write lock to be grabbed for writing
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvshadow_store_descriptor_read_buffer(
-         libvshadow_store_descriptor_t *store_descriptor,
-         libbfio_handle_t *file_io_handle,
-         uint8_t *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libvshadow_store_descriptor_t *active_store_descriptor,
-         libcerror_error_t **error )
+int libvshadow_store_descriptor_calculate_block_descriptors_memory_size(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function           = "libvshadow_store_descriptor_calculate_block_descriptors_memory_size";
+	size64_t memory_size            = 0;
+	int number_of_block_descriptors = 0;
+	int number_of_ranges            = 0;
+	int number_of_previous_ranges   = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->forward_block_descriptors_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store descriptor - missing forward block descriptors array.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->reverse_block_descriptors_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store descriptor - missing reverse block descriptors table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_list_get_number_of_elements(
+	     store_descriptor->block_descriptors_list,
+	     &number_of_block_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_range_list_get_number_of_elements(
+	     store_descriptor->block_offset_list,
+	     &number_of_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of block offset list elements.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_range_list_get_number_of_elements(
+	     store_descriptor->previous_block_offset_list,
+	     &number_of_previous_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of previous block offset list elements.",
+		 function );
+
+		return( -1 );
+	}
+	/* Every block descriptor is referenced by a list element and by either
+	 * the forward block descriptors array or the reverse block descriptors table
+	 * A list element and a range consist of about 4 values each
+	 */
+	memory_size  = (size64_t) number_of_block_descriptors * ( sizeof( libvshadow_block_descriptor_t ) + ( 4 * sizeof( intptr_t ) ) );
+	memory_size += (size64_t) store_descriptor->forward_block_descriptors_array->number_of_block_descriptors * sizeof( libvshadow_block_descriptor_t * );
+	memory_size += (size64_t) store_descriptor->reverse_block_descriptors_table->number_of_entries * sizeof( libvshadow_block_table_entry_t );
+	memory_size += (size64_t) ( number_of_ranges + number_of_previous_ranges ) * ( 8 * sizeof( intptr_t ) );
+
+	store_descriptor->block_descriptors_memory_size = memory_size;
+
+	return( 1 );
+}
+
+/* Reads the block descriptors if needed and grabs the read/write lock for reading
+ * The block descriptors can be evicted between reading them and grabbing the lock
+ * in which case they are read again
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_grab_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libvshadow_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_grab_block_descriptors";
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	uint64_t timestamp    = 0;
+#endif
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		/* This function will acquire the write lock
+		 */
+		if( libvshadow_store_descriptor_read_block_descriptors(
+		     store_descriptor,
+		     file_io_handle,
+		     statistics,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block descriptors.",
+			 function );
+
+			return( -1 );
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( statistics != NULL )
+		{
+			timestamp = libvshadow_statistics_get_timestamp();
+		}
+		if( libcthreads_read_write_lock_grab_for_read(
+		     store_descriptor->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+		if( statistics != NULL )
+		{
+			statistics->lock_wait_time += libvshadow_statistics_get_timestamp() - timestamp;
+		}
+		if( store_descriptor->block_descriptors_read != 0 )
+		{
+			break;
+		}
+		if( libcthreads_read_write_lock_release_for_read(
+		     store_descriptor->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	while( store_descriptor->block_descriptors_read == 0 );
+
+	return( 1 );
+}
+
+/* Determines the source of the data at the specified offset
+ * The source size is the number of bytes, starting at the offset, that are stored
+ * consecutively in the same source, which does not exceed the end of the block
+ * This function expects the block descriptors to be read and the read/write lock
+ * to be grabbed for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_block_source(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_statistics_t *statistics,
+     int *source_type,
+     off64_t *source_offset,
+     size_t *source_size,
+     libcerror_error_t **error )
 {
-	libcdata_tree_node_t *tree_node                         = NULL;
 	libvshadow_block_descriptor_t *block_descriptor         = NULL;
 	libvshadow_block_descriptor_t *overlay_block_descriptor = NULL;
 	libvshadow_block_descriptor_t *reverse_block_descriptor = NULL;
-	static char *function                                   = "libvshadow_store_descriptor_read_buffer";
+	static char *function                                   = "libvshadow_store_descriptor_get_block_source";
 	intptr_t *value                                         = NULL;
 	off64_t block_descriptor_offset                         = 0;
 	off64_t block_offset                                    = 0;
 	off64_t block_range_offset                              = 0;
-	off64_t overlay_block_offset                            = 0;
 	off64_t previous_block_range_offset                     = 0;
 	size64_t block_range_size                               = 0;
 	size64_t previous_block_range_size                      = 0;
-	size_t buffer_offset                                    = 0;
 	size_t block_size                                       = 0;
-	size_t read_size                                        = 0;
-	ssize_t read_count                                      = 0;
-	uint32_t overlay_bitmap                                 = 0;
+	uint64_t timestamp                                      = 0;
 	uint32_t relative_block_offset                          = 0;
-	uint8_t bit_count                                       = 0;
 	int in_block_descriptor_list                            = 0;
 	int in_current_bitmap                                   = 0;
 	int in_previous_bitmap                                  = 0;
@@ -2094,262 +2919,269 @@ ssize_t libvshadow_store_descriptor_read_buffer(
 
 		return( -1 );
 	}
-	if( store_descriptor->has_in_volume_store_data == 0 )
+	if( active_store_descriptor == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store descriptor - missing in-volume store data.",
+		 "%s: invalid active store descriptor.",
 		 function );
 
 		return( -1 );
 	}
-	if( active_store_descriptor == NULL )
+	if( statistics == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid active store descriptor.",
+		 "%s: invalid statistics.",
 		 function );
 
 		return( -1 );
 	}
-	/* This function will acquire the write lock
-	 */
-	if( libvshadow_store_descriptor_read_block_descriptors(
-	     store_descriptor,
-	     file_io_handle,
-	     error ) != 1 )
+	if( source_type == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read block descriptors.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source type.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     store_descriptor->read_write_lock,
-	     error ) != 1 )
+	if( source_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source offset.",
 		 function );
 
 		return( -1 );
 	}
-#endif
+	if( source_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source size.",
+		 function );
+
+		return( -1 );
+	}
+	block_offset          = offset;
+	relative_block_offset = (uint32_t) ( offset % 0x4000 );
+	block_size            = 0x4000 - relative_block_offset;
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
 		libcnotify_printf(
-		 "%s: store: %02d requested offset: 0x%08" PRIx64 "\n",
+		 "%s: store: %02d block offset: 0x%08" PRIx64 "\n",
 		 function,
 		 store_descriptor->index,
-		 offset );
+		 block_offset );
 	}
 #endif
-	while( buffer_size > 0 )
+	if( statistics->phase_timing_enabled != 0 )
 	{
-		block_offset          = offset;
-		relative_block_offset = (uint32_t) (offset % 0x4000);
-		block_size            = 0x4000 - relative_block_offset;
+		timestamp = libvshadow_statistics_get_timestamp();
+	}
+	statistics->number_of_block_tree_lookups += 1;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: store: %02d block offset: 0x%08" PRIx64 "\n",
-			 function,
-			 store_descriptor->index,
-			 block_offset );
-		}
-#endif
-		in_block_descriptor_list         = 0;
-		in_reverse_block_descriptor_list = 0;
-		in_current_bitmap                = 0;
-		in_previous_bitmap               = 0;
+	result = libvshadow_block_array_get_block_descriptor_at_offset(
+	          store_descriptor->forward_block_descriptors_array,
+	          block_offset,
+	          &block_descriptor,
+	          error );
 
-		result = libcdata_btree_get_value_by_value(
-		          store_descriptor->forward_block_descriptors_tree,
-		          (intptr_t *) &block_offset,
-		          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_original_offset_value,
-		          &tree_node,
-		          (intptr_t **) &block_descriptor,
-		          error );
+	if( statistics->phase_timing_enabled != 0 )
+	{
+		statistics->phase_times[ LIBVSHADOW_TIMING_PHASE_INDEX_LOOKUP ] += libvshadow_statistics_get_timestamp() - timestamp;
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block range for offset: 0x%08" PRIx64 ".",
+		 function,
+		 block_offset );
 
-		if( result == -1 )
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( block_descriptor == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve block range for offset: 0x%08" PRIx64 ".",
-			 function,
-			 block_offset );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing block descriptor.",
+			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		else if( result != 0 )
+		in_block_descriptor_list = 1;
+
+		if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
+		{
+			block_descriptor_offset = block_descriptor->relative_offset;
+		}
+		else
+		{
+			block_descriptor_offset = block_descriptor->offset;
+		}
+		if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
+		{
+			overlay_block_descriptor = block_descriptor;
+		}
+		else
+		{
+			overlay_block_descriptor = block_descriptor->overlay;
+		}
+		if( overlay_block_descriptor != NULL )
+		{
+			if( store_descriptor->index != active_store_descriptor->index )
+			{
+				if( block_descriptor == overlay_block_descriptor )
+				{
+					block_descriptor         = NULL;
+					in_block_descriptor_list = 0;
+				}
+			}
+			else
+			{
+				result = libvshadow_block_descriptor_get_overlay_run(
+				          overlay_block_descriptor,
+				          (uint32_t) ( block_offset - overlay_block_descriptor->original_offset ),
+				          &block_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve overlay run for offset: 0x%08" PRIx64 ".",
+					 function,
+					 block_offset );
+
+					return( -1 );
+				}
+				else if( result != 0 )
+				{
+					block_descriptor_offset = overlay_block_descriptor->offset;
+					block_descriptor        = overlay_block_descriptor;
+				}
+				else if( block_descriptor == overlay_block_descriptor )
+				{
+					block_descriptor         = NULL;
+					in_block_descriptor_list = 0;
+				}
+			}
+		}
+	}
+	if( in_block_descriptor_list == 0 )
+	{
+		/* Only the most recent store seems to bother checking the current bitmap
+		 */
+		if( ( store_descriptor->next_store_descriptor == NULL )
+		 && ( store_descriptor->index == active_store_descriptor->index ) )
 		{
-			if( block_descriptor == NULL )
+			if( store_descriptor->reverse_block_descriptors_table == NULL )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing block descriptor.",
+				 "%s: invalid store descriptor - missing reverse block descriptors table.",
 				 function );
 
-				goto on_error;
-			}
-			in_block_descriptor_list = 1;
-
-			if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
-			{
-				block_descriptor_offset = block_descriptor->relative_offset;
-			}
-			else
-			{
-				block_descriptor_offset = block_descriptor->offset;
+				return( -1 );
 			}
-			if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
+			if( statistics->phase_timing_enabled != 0 )
 			{
-				overlay_block_descriptor = block_descriptor;
+				timestamp = libvshadow_statistics_get_timestamp();
 			}
-			else
+			statistics->number_of_block_tree_lookups += 1;
+
+			result = libvshadow_block_table_get_block_descriptor_at_offset(
+				  store_descriptor->reverse_block_descriptors_table,
+				  block_offset,
+				  &reverse_block_descriptor,
+				  error );
+
+			if( statistics->phase_timing_enabled != 0 )
 			{
-				overlay_block_descriptor = block_descriptor->overlay;
+				statistics->phase_times[ LIBVSHADOW_TIMING_PHASE_INDEX_LOOKUP ] += libvshadow_statistics_get_timestamp() - timestamp;
 			}
-			if( overlay_block_descriptor != NULL )
+			if( result == -1 )
 			{
-				if( store_descriptor->index != active_store_descriptor->index )
-				{
-					if( block_descriptor == overlay_block_descriptor )
-					{
-						block_descriptor         = NULL;
-						in_block_descriptor_list = 0;
-					}
-				}
-				else
-				{
-					overlay_block_offset = overlay_block_descriptor->original_offset;
-					overlay_bitmap       = overlay_block_descriptor->bitmap;
-
-					bit_count = 32;
-
-					while( overlay_block_offset < block_offset )
-					{
-						overlay_bitmap >>= 1;
-
-						overlay_block_offset += 512;
-
-						bit_count--;
-
-						if( bit_count == 0 )
-						{
-							break;
-						}
-					}
-					if( ( overlay_bitmap & 0x00000001UL ) != 0 )
-					{
-						block_descriptor_offset = overlay_block_descriptor->offset;
-						block_descriptor        = overlay_block_descriptor;
-
-						block_size = 0;
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve reverse block descriptor for offset: 0x%08" PRIx64 ".",
+				 function,
+				 block_offset );
 
-						while( ( overlay_bitmap & 0x00000001UL ) != 0 )
-						{
-							overlay_bitmap >>= 1;
+				return( -1 );
+			}
+			in_reverse_block_descriptor_list = result;
 
-							block_size += 512;
+			result = libcdata_range_list_get_range_at_offset(
+				  store_descriptor->block_offset_list,
+				  (uint64_t) block_offset,
+				  (uint64_t *) &block_range_offset,
+				  (uint64_t *) &block_range_size,
+				  &value,
+				  error );
 
-							bit_count--;
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve offset: 0x%08" PRIx64 " from block offset list.",
+				 function,
+				 offset );
 
-							if( bit_count == 0 )
-							{
-								break;
-							}
-						}
-					}
-					else
-					{
-						if( block_descriptor == overlay_block_descriptor )
-						{
-							block_descriptor         = NULL;
-							in_block_descriptor_list = 0;
-						}
-						block_size = 0;
-
-						while( ( overlay_bitmap & 0x00000001UL ) == 0 )
-						{
-							overlay_bitmap >>= 1;
-
-							block_size += 512;
-
-							bit_count--;
-
-							if( bit_count == 0 )
-							{
-								break;
-							}
-						}
-					}
-				}
+				return( -1 );
 			}
-		}
-		if( in_block_descriptor_list == 0 )
-		{
-			/* Only the most recent store seems to bother checking the current bitmap
-			 */
-			if( ( store_descriptor->next_store_descriptor == NULL )
-			 && ( store_descriptor->index == active_store_descriptor->index ) )
+#if defined( HAVE_DEBUG_OUTPUT )
+			else if( result != 0 )
 			{
-				if( store_descriptor->reverse_block_descriptors_tree == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: invalid store descriptor - missing reverse block descriptors tree.",
-					 function );
-
-					goto on_error;
-				}
-				result = libcdata_btree_get_value_by_value(
-					  store_descriptor->reverse_block_descriptors_tree,
-					  (intptr_t *) &block_offset,
-					  (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_relative_offset_value,
-					  &tree_node,
-					  (intptr_t **) &reverse_block_descriptor,
-					  error );
-
-				if( result == -1 )
+				if( libcnotify_verbose != 0 )
 				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve reverse block descriptor from root node.",
-					 function );
-
-					goto on_error;
+					libcnotify_printf(
+					 "%s: store: %02d block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
+					 function,
+					 store_descriptor->index,
+					 block_range_offset,
+					 block_range_offset + block_range_size,
+					 block_range_size );
 				}
-				in_reverse_block_descriptor_list = result;
+			}
+#endif
+			in_current_bitmap = result;
 
+			if( store_descriptor->store_previous_bitmap_offset != 0 )
+			{
 				result = libcdata_range_list_get_range_at_offset(
-					  store_descriptor->block_offset_list,
+					  store_descriptor->previous_block_offset_list,
 					  (uint64_t) block_offset,
-					  (uint64_t *) &block_range_offset,
-					  (uint64_t *) &block_range_size,
+					  (uint64_t *) &previous_block_range_offset,
+					  (uint64_t *) &previous_block_range_size,
 					  &value,
 					  error );
 
@@ -2359,11 +3191,11 @@ ssize_t libvshadow_store_descriptor_read_buffer(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve offset: 0x%08" PRIx64 " from block offset list.",
+					 "%s: unable to retrieve offset: 0x%08" PRIx64 " from previous block offset list.",
 					 function,
 					 offset );
 
-					goto on_error;
+					return( -1 );
 				}
 #if defined( HAVE_DEBUG_OUTPUT )
 				else if( result != 0 )
@@ -2371,334 +3203,2044 @@ ssize_t libvshadow_store_descriptor_read_buffer(
 					if( libcnotify_verbose != 0 )
 					{
 						libcnotify_printf(
-						 "%s: store: %02d block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
+						 "%s: store: %02d previous block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
 						 function,
 						 store_descriptor->index,
-						 block_range_offset,
-						 block_range_offset + block_range_size,
-						 block_range_size );
+						 previous_block_range_offset,
+						 previous_block_range_offset + previous_block_range_size,
+						 previous_block_range_size );
 					}
 				}
 #endif
-				in_current_bitmap = result;
-
-				if( store_descriptor->store_previous_bitmap_offset != 0 )
-				{
-					result = libcdata_range_list_get_range_at_offset(
-						  store_descriptor->previous_block_offset_list,
-						  (uint64_t) block_offset,
-						  (uint64_t *) &previous_block_range_offset,
-						  (uint64_t *) &previous_block_range_size,
-						  &value,
-						  error );
-
-					if( result == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-						 "%s: unable to retrieve offset: 0x%08" PRIx64 " from previous block offset list.",
-						 function,
-						 offset );
-
-						goto on_error;
-					}
-#if defined( HAVE_DEBUG_OUTPUT )
-					else if( result != 0 )
-					{
-						if( libcnotify_verbose != 0 )
-						{
-							libcnotify_printf(
-							 "%s: store: %02d previous block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-							 function,
-							 store_descriptor->index,
-							 previous_block_range_offset,
-							 previous_block_range_offset + previous_block_range_size,
-							 previous_block_range_size );
-						}
-					}
-#endif
-					in_previous_bitmap = result;
-				}
-				else
-				{
-					in_previous_bitmap = 1;
-				}
+				in_previous_bitmap = result;
+			}
+			else
+			{
+				in_previous_bitmap = 1;
 			}
 		}
-		block_descriptor_offset += relative_block_offset;
+	}
+	block_descriptor_offset += relative_block_offset;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: store: %02d range: 0x%08" PRIx64 " - 0x%08" PRIx64 " size: %" PRIzd "",
+		 function,
+		 store_descriptor->index,
+		 block_offset,
+		 block_offset + block_size,
+		 block_size );
 
-		if( buffer_size > block_size )
+		if( block_descriptor != NULL )
 		{
-			read_size = block_size;
+			libcnotify_printf(
+			 ", flags: 0x%08" PRIx32 "",
+			 block_descriptor->flags );
 		}
-		else
+		libcnotify_printf(
+		 "\n" );
+
+		if( in_block_descriptor_list != 0 )
 		{
-			read_size = buffer_size;
+			libcnotify_printf(
+			 "\tIn block list\n" );
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( block_descriptor != NULL )
 		{
-			libcnotify_printf(
-			 "%s: store: %02d range: 0x%08" PRIx64 " - 0x%08" PRIx64 " size: %" PRIzd "",
-			 function,
-			 store_descriptor->index,
-			 block_offset,
-			 block_offset + block_size,
-			 block_size );
-
-			if( block_descriptor != NULL )
+			if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
 			{
 				libcnotify_printf(
-				 ", flags: 0x%08" PRIx32 "",
-				 block_descriptor->flags );
+				 "\tIs overlay\n" );
 			}
+		}
+		if( in_reverse_block_descriptor_list != 0 )
+		{
 			libcnotify_printf(
-			 "\n" );
-
-			if( in_block_descriptor_list != 0 )
-			{
-				libcnotify_printf(
-				 "\tIn block list\n" );
-			}
-			if( block_descriptor != NULL )
-			{
-				if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
-				{
-					libcnotify_printf(
-					 "\tIs overlay\n" );
-				}
-			}
-			if( in_reverse_block_descriptor_list != 0 )
-			{
-				libcnotify_printf(
-				 "\tIn reverse block list\n" );
-			}
-			if( in_current_bitmap != 0 )
-			{
-				libcnotify_printf(
-				 "\tIn current bitmap\n" );
-			}
-			if( ( store_descriptor->store_previous_bitmap_offset != 0 )
-			 && ( in_previous_bitmap != 0 ) )
-			{
-				libcnotify_printf(
-				 "\tIn previous bitmap\n" );
-			}
+			 "\tIn reverse block list\n" );
+		}
+		if( in_current_bitmap != 0 )
+		{
 			libcnotify_printf(
-			 "\n" );
+			 "\tIn current bitmap\n" );
+		}
+		if( ( store_descriptor->store_previous_bitmap_offset != 0 )
+		 && ( in_previous_bitmap != 0 ) )
+		{
+			libcnotify_printf(
+			 "\tIn previous bitmap\n" );
 		}
+		libcnotify_printf(
+		 "\n" );
+	}
 #endif
-		if( in_block_descriptor_list != 0 )
+	if( in_block_descriptor_list != 0 )
+	{
+		if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
 		{
-			if( ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
-			 && ( store_descriptor->next_store_descriptor != NULL ) )
+			if( store_descriptor->next_store_descriptor != NULL )
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from next store at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_descriptor_offset );
-				}
-#endif
-				read_count = libvshadow_store_descriptor_read_buffer(
-					      store_descriptor->next_store_descriptor,
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      block_descriptor_offset,
-					      active_store_descriptor,
-					      error );
-
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from next store descriptor.",
-					 function );
-
-					goto on_error;
-				}
+				*source_type = LIBVSHADOW_BLOCK_SOURCE_TYPE_NEXT_STORE;
 			}
 			else
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from current volume at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_descriptor_offset );
-				}
-#endif
-				if( libbfio_handle_seek_offset(
-				     file_io_handle,
-				     block_descriptor_offset,
-				     SEEK_SET,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_SEEK_FAILED,
-					 "%s: unable to seek block offset: %" PRIi64 ".",
-					 function,
-					 block_descriptor_offset );
-
-					goto on_error;
-				}
-				read_count = libbfio_handle_read_buffer(
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      error );
-
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from file IO handle.",
-					 function );
-
-					goto on_error;
-				}
+				*source_type = LIBVSHADOW_BLOCK_SOURCE_TYPE_FORWARDED_DATA;
 			}
 		}
+		else if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
+		{
+			*source_type = LIBVSHADOW_BLOCK_SOURCE_TYPE_OVERLAY_DATA;
+		}
 		else
 		{
-			/* Check if the next store defines the block
-			 */
-			if( store_descriptor->next_store_descriptor != NULL )
-			{
+			*source_type = LIBVSHADOW_BLOCK_SOURCE_TYPE_STORE_DATA;
+		}
+		*source_offset = block_descriptor_offset;
+	}
+	/* Check if the next store defines the block
+	 */
+	else if( store_descriptor->next_store_descriptor != NULL )
+	{
+		*source_type   = LIBVSHADOW_BLOCK_SOURCE_TYPE_NEXT_STORE;
+		*source_offset = block_offset;
+	}
+	else if( ( in_reverse_block_descriptor_list == 0 )
+	      && ( in_current_bitmap != 0 )
+	      && ( in_previous_bitmap != 0 ) )
+	{
+		*source_type   = LIBVSHADOW_BLOCK_SOURCE_TYPE_ZERO_FILL;
+		*source_offset = 0;
+	}
+	else
+	{
+		*source_type   = LIBVSHADOW_BLOCK_SOURCE_TYPE_VOLUME_DATA;
+		*source_offset = block_offset;
+	}
+	*source_size = block_size;
+
+	return( 1 );
+}
+
+/* Reads data at the specified offset into a buffer
+ * The chain depth is the number of stores the read was passed on from
+ * The statistics are updated for the store that was read from at chain depth 0
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_store_descriptor_read_buffer_in_chain(
+         libvshadow_store_descriptor_t *store_descriptor,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libvshadow_store_descriptor_t *active_store_descriptor,
+         libvshadow_statistics_t *statistics,
+         int chain_depth,
+         libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_read_buffer_in_chain";
+	off64_t source_offset = 0;
+	size_t buffer_offset  = 0;
+	size_t read_size      = 0;
+	size_t source_size    = 0;
+	ssize_t read_count    = 0;
+	uint64_t timestamp    = 0;
+	int source_type       = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor - missing in-volume store data.",
+		 function );
+
+		return( -1 );
+	}
+	if( active_store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid active store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( chain_depth < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chain depth value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* This function will acquire the read/write lock for reading
+	 */
+	if( libvshadow_store_descriptor_grab_block_descriptors(
+	     store_descriptor,
+	     file_io_handle,
+	     statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics->maximum_chain_depth < (uint64_t) chain_depth )
+	{
+		statistics->maximum_chain_depth = (uint64_t) chain_depth;
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from next store at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_offset );
-				}
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: store: %02d requested offset: 0x%08" PRIx64 "\n",
+		 function,
+		 store_descriptor->index,
+		 offset );
+	}
 #endif
-				read_count = libvshadow_store_descriptor_read_buffer(
-					      store_descriptor->next_store_descriptor,
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      block_offset,
-					      active_store_descriptor,
-					      error );
-
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from next store descriptor.",
-					 function );
+	while( buffer_size > 0 )
+	{
+		if( libvshadow_store_descriptor_get_block_source(
+		     store_descriptor,
+		     offset,
+		     active_store_descriptor,
+		     statistics,
+		     &source_type,
+		     &source_offset,
+		     &source_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve source of offset: 0x%08" PRIx64 ".",
+			 function,
+			 offset );
 
-					goto on_error;
-				}
+			goto on_error;
+		}
+		if( buffer_size > source_size )
+		{
+			read_size = source_size;
+		}
+		else
+		{
+			read_size = buffer_size;
+		}
+		if( source_type == LIBVSHADOW_BLOCK_SOURCE_TYPE_NEXT_STORE )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: store: %02d reading block from next store at offset: 0x%08" PRIx64 "\n",
+				 function,
+				 store_descriptor->index,
+				 source_offset );
 			}
-			else if( ( in_reverse_block_descriptor_list == 0 )
-			      && ( in_current_bitmap != 0 )
-			      && ( in_previous_bitmap != 0 ) )
+#endif
+			statistics->number_of_chain_reads += 1;
+
+			read_count = libvshadow_store_descriptor_read_buffer_in_chain(
+				      store_descriptor->next_store_descriptor,
+				      file_io_handle,
+				      &( buffer[ buffer_offset ] ),
+				      read_size,
+				      source_offset,
+				      active_store_descriptor,
+				      statistics,
+				      chain_depth + 1,
+				      error );
+
+			if( read_count != (ssize_t) read_size )
 			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer from next store descriptor.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( source_type == LIBVSHADOW_BLOCK_SOURCE_TYPE_ZERO_FILL )
+		{
 #if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d filling block with zero bytes\n",
-					 function,
-					 store_descriptor->index,
-					 block_offset,
-					 read_size );
-				}
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: store: %02d filling block with zero bytes\n",
+				 function,
+				 store_descriptor->index );
+			}
 #endif
-				if( memory_set(
-				     &( buffer[ buffer_offset ] ),
-				     0,
-				     read_size ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to clear buffer.",
-					 function );
+			if( memory_set(
+			     &( buffer[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
 
-					goto on_error;
-				}
-				read_count = (ssize_t) read_size;
+				goto on_error;
 			}
-			else
-			{
+			read_count = (ssize_t) read_size;
+
+			statistics->zero_fill_size += (uint64_t) read_count;
+		}
+		else
+		{
 #if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from current volume at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_offset );
-				}
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: store: %02d reading block from current volume at offset: 0x%08" PRIx64 "\n",
+				 function,
+				 store_descriptor->index,
+				 source_offset );
+			}
 #endif
-				if( libbfio_handle_seek_offset(
-				     file_io_handle,
-				     block_offset,
-				     SEEK_SET,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_SEEK_FAILED,
-					 "%s: unable to seek block offset: %" PRIi64 ".",
-					 function,
-					 block_offset );
+			if( statistics->phase_timing_enabled != 0 )
+			{
+				timestamp = libvshadow_statistics_get_timestamp();
+			}
+			if( libbfio_handle_seek_offset(
+			     file_io_handle,
+			     source_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek block offset: %" PRIi64 ".",
+				 function,
+				 source_offset );
 
-					goto on_error;
-				}
-				read_count = libbfio_handle_read_buffer(
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      error );
+				goto on_error;
+			}
+			read_count = libbfio_handle_read_buffer(
+				      file_io_handle,
+				      &( buffer[ buffer_offset ] ),
+				      read_size,
+				      error );
 
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from file IO handle.",
-					 function );
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer from file IO handle.",
+				 function );
 
-					goto on_error;
-				}
+				goto on_error;
+			}
+			if( statistics->phase_timing_enabled != 0 )
+			{
+				statistics->phase_times[ LIBVSHADOW_TIMING_PHASE_PHYSICAL_IO ] += libvshadow_statistics_get_timestamp() - timestamp;
+			}
+			statistics->number_of_read_calls += 1;
+			statistics->read_size            += (uint64_t) read_count;
+
+			if( source_type == LIBVSHADOW_BLOCK_SOURCE_TYPE_OVERLAY_DATA )
+			{
+				statistics->overlay_data_size += (uint64_t) read_count;
+			}
+			else if( source_type == LIBVSHADOW_BLOCK_SOURCE_TYPE_STORE_DATA )
+			{
+				statistics->store_data_size += (uint64_t) read_count;
+			}
+			else
+			{
+				statistics->volume_data_size += (uint64_t) read_count;
 			}
 		}
 		offset        += read_count;
 		buffer_offset += read_count;
 		buffer_size   -= read_count;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( (ssize_t) buffer_offset );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 store_descriptor->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the source of the data at the specified offset
+ * A source in the next store is followed until the data is found
+ * The source size does not exceed the maximum size
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_block_source_in_chain(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size_t maximum_size,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_statistics_t *statistics,
+     int chain_depth,
+     int *source_type,
+     off64_t *source_offset,
+     size_t *source_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_block_source_in_chain";
+	int result            = 1;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor - missing in-volume store data.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chain_depth < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chain depth value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* This function will acquire the read/write lock for reading
+	 */
+	if( libvshadow_store_descriptor_grab_block_descriptors(
+	     store_descriptor,
+	     file_io_handle,
+	     statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics->maximum_chain_depth < (uint64_t) chain_depth )
+	{
+		statistics->maximum_chain_depth = (uint64_t) chain_depth;
+	}
+	if( libvshadow_store_descriptor_get_block_source(
+	     store_descriptor,
+	     offset,
+	     active_store_descriptor,
+	     statistics,
+	     source_type,
+	     source_offset,
+	     source_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve source of offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		result = -1;
+	}
+	else
+	{
+		if( *source_size > maximum_size )
+		{
+			*source_size = maximum_size;
+		}
+		if( *source_type == LIBVSHADOW_BLOCK_SOURCE_TYPE_NEXT_STORE )
+		{
+			statistics->number_of_chain_reads += 1;
+
+			if( libvshadow_store_descriptor_get_block_source_in_chain(
+			     store_descriptor->next_store_descriptor,
+			     file_io_handle,
+			     *source_offset,
+			     *source_size,
+			     active_store_descriptor,
+			     statistics,
+			     chain_depth + 1,
+			     source_type,
+			     source_offset,
+			     source_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve source from next store descriptor.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the physical extent that contains the data at the specified offset
+ * The extent consists of consecutive data stored consecutively in the same kind
+ * of source and does not exceed the maximum size
+ * The physical offset is the offset of the data relative to the start of the volume
+ * and is 0 for sparse extents
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_physical_extent(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t maximum_size,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     off64_t *physical_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	libvshadow_statistics_t statistics;
+
+	static char *function        = "libvshadow_store_descriptor_get_physical_extent";
+	off64_t source_offset        = 0;
+	size64_t safe_extent_size    = 0;
+	size_t source_size           = 0;
+	size_t maximum_source_size   = 0;
+	uint32_t safe_extent_flags   = 0;
+	uint32_t source_extent_flags = 0;
+	int source_type              = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( physical_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvshadow_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->phase_timing_enabled != 0 )
+	{
+		statistics.phase_timing_enabled = 1;
+	}
+	/* Consecutive sources are merged into a single extent
+	 */
+	while( safe_extent_size < maximum_size )
+	{
+		if( ( maximum_size - safe_extent_size ) > (size64_t) 0x4000 )
+		{
+			maximum_source_size = 0x4000;
+		}
+		else
+		{
+			maximum_source_size = (size_t) ( maximum_size - safe_extent_size );
+		}
+		if( libvshadow_store_descriptor_get_block_source_in_chain(
+		     store_descriptor,
+		     file_io_handle,
+		     offset + (off64_t) safe_extent_size,
+		     maximum_source_size,
+		     active_store_descriptor,
+		     &statistics,
+		     0,
+		     &source_type,
+		     &source_offset,
+		     &source_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve source of offset: 0x%08" PRIx64 ".",
+			 function,
+			 offset + (off64_t) safe_extent_size );
+
+			return( -1 );
+		}
+		switch( source_type )
+		{
+			case LIBVSHADOW_BLOCK_SOURCE_TYPE_OVERLAY_DATA:
+			case LIBVSHADOW_BLOCK_SOURCE_TYPE_STORE_DATA:
+				source_extent_flags = LIBVSHADOW_EXTENT_FLAG_IS_STORE_DATA;
+				break;
+
+			case LIBVSHADOW_BLOCK_SOURCE_TYPE_ZERO_FILL:
+				source_extent_flags = LIBVSHADOW_EXTENT_FLAG_IS_SPARSE;
+				break;
+
+			default:
+				source_extent_flags = 0;
+				break;
+		}
+		if( safe_extent_size == 0 )
+		{
+			*physical_offset  = source_offset;
+			safe_extent_flags = source_extent_flags;
+		}
+		else if( source_extent_flags != safe_extent_flags )
+		{
+			break;
+		}
+		else if( ( ( source_extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) == 0 )
+		      && ( source_offset != ( *physical_offset + (off64_t) safe_extent_size ) ) )
+		{
+			break;
+		}
+		safe_extent_size += source_size;
+	}
+	*extent_size  = safe_extent_size;
+	*extent_flags = safe_extent_flags;
+
+	if( libvshadow_store_descriptor_add_statistics(
+	     store_descriptor,
+	     &statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads data at the specified offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_store_descriptor_read_buffer(
+         libvshadow_store_descriptor_t *store_descriptor,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libvshadow_store_descriptor_t *active_store_descriptor,
+         libcerror_error_t **error )
+{
+	libvshadow_statistics_t statistics;
+
+	static char *function = "libvshadow_store_descriptor_read_buffer";
+	ssize_t read_count    = 0;
+
+	/* The statistics are gathered per read in the calling thread
+	 * and added to the store descriptor statistics afterwards
+	 */
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvshadow_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		return( -1 );
+	}
+	statistics.phase_timing_enabled = store_descriptor->phase_timing_enabled;
+
+	read_count = libvshadow_store_descriptor_read_buffer_in_chain(
+	              store_descriptor,
+	              file_io_handle,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              active_store_descriptor,
+	              &statistics,
+	              0,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_add_statistics(
+	     store_descriptor,
+	     &statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads the NTFS allocation bitmap
+ * The $Bitmap file is located and read through the store itself, so that the
+ * allocation reflects the file system at the time the snapshot was created
+ * This function will acquire the read/write lock when needed
+ * Returns 1 if successful, 0 if the store does not contain a NTFS file system or -1 on error
+ */
+int libvshadow_store_descriptor_read_allocation_bitmap(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t volume_header_data[ sizeof( vshadow_ntfs_volume_header_t ) ];
+
+	libvshadow_allocation_bitmap_data_run_t *data_run = NULL;
+	libvshadow_allocation_bitmap_t *allocation_bitmap = NULL;
+	uint8_t *mft_entry_data                           = NULL;
+	static char *function                             = "libvshadow_store_descriptor_read_allocation_bitmap";
+	size_t data_offset                                = 0;
+	size_t read_size                                  = 0;
+	ssize_t read_count                                = 0;
+	off64_t mft_entry_offset                          = 0;
+	int data_run_index                                = 0;
+	int result                                        = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->allocation_bitmap != NULL )
+	{
+		result = 1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 0 )
+	{
+		return( 1 );
+	}
+	if( libvshadow_allocation_bitmap_initialize(
+	     &allocation_bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create allocation bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	/* The store data is read without the read/write lock since reading
+	 * acquires the lock itself
+	 */
+	read_count = libvshadow_store_descriptor_read_buffer(
+	              store_descriptor,
+	              file_io_handle,
+	              volume_header_data,
+	              sizeof( vshadow_ntfs_volume_header_t ),
+	              0,
+	              store_descriptor,
+	              error );
+
+	if( read_count != (ssize_t) sizeof( vshadow_ntfs_volume_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read NTFS volume header data.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvshadow_allocation_bitmap_read_volume_header_data(
+	          allocation_bitmap,
+	          volume_header_data,
+	          sizeof( vshadow_ntfs_volume_header_t ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read NTFS volume header.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libvshadow_allocation_bitmap_free(
+		     &allocation_bitmap,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free allocation bitmap.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	if( ( allocation_bitmap->cluster_block_size > store_descriptor->volume_size )
+	 || ( allocation_bitmap->number_of_cluster_blocks > ( store_descriptor->volume_size / allocation_bitmap->cluster_block_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cluster blocks value exceeds volume size.",
+		 function );
+
+		goto on_error;
+	}
+	mft_entry_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * allocation_bitmap->mft_entry_size );
+
+	if( mft_entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create MFT entry data.",
+		 function );
+
+		goto on_error;
+	}
+	/* The $Bitmap file is stored in MFT entry 6, which is part of the first data run of the $MFT
+	 */
+	mft_entry_offset = allocation_bitmap->mft_offset + ( 6 * (off64_t) allocation_bitmap->mft_entry_size );
+
+	if( (size64_t) ( mft_entry_offset + allocation_bitmap->mft_entry_size ) > store_descriptor->volume_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid $Bitmap MFT entry offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libvshadow_store_descriptor_read_buffer(
+	              store_descriptor,
+	              file_io_handle,
+	              mft_entry_data,
+	              (size_t) allocation_bitmap->mft_entry_size,
+	              mft_entry_offset,
+	              store_descriptor,
+	              error );
+
+	if( read_count != (ssize_t) allocation_bitmap->mft_entry_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read $Bitmap MFT entry data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 mft_entry_offset,
+		 mft_entry_offset );
+
+		goto on_error;
+	}
+	if( libvshadow_allocation_bitmap_read_mft_entry_data(
+	     allocation_bitmap,
+	     mft_entry_data,
+	     (size_t) allocation_bitmap->mft_entry_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read $Bitmap MFT entry.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 mft_entry_data );
+
+	mft_entry_data = NULL;
+
+	/* The data of sparse data runs was cleared when the bitmap data was allocated
+	 */
+	for( data_run_index = 0;
+	     data_run_index < allocation_bitmap->number_of_data_runs;
+	     data_run_index++ )
+	{
+		if( data_offset >= allocation_bitmap->data_size )
+		{
+			break;
+		}
+		data_run = &( allocation_bitmap->data_runs[ data_run_index ] );
+
+		read_size = allocation_bitmap->data_size - data_offset;
+
+		if( (size64_t) read_size > data_run->size )
+		{
+			read_size = (size_t) data_run->size;
+		}
+		if( data_run->is_sparse == 0 )
+		{
+			read_count = libvshadow_store_descriptor_read_buffer(
+			              store_descriptor,
+			              file_io_handle,
+			              &( allocation_bitmap->data[ data_offset ] ),
+			              read_size,
+			              data_run->offset,
+			              store_descriptor,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read $Bitmap data run: %d.",
+				 function,
+				 data_run_index );
+
+				goto on_error;
+			}
+		}
+		data_offset += read_size;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* Another thread could have read the allocation bitmap in the meantime
+	 */
+	if( store_descriptor->allocation_bitmap == NULL )
+	{
+		store_descriptor->allocation_bitmap = allocation_bitmap;
+
+		allocation_bitmap = NULL;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( allocation_bitmap != NULL )
+	{
+		if( libvshadow_allocation_bitmap_free(
+		     &allocation_bitmap,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free allocation bitmap.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( mft_entry_data != NULL )
+	{
+		memory_free(
+		 mft_entry_data );
+	}
+	if( allocation_bitmap != NULL )
+	{
+		libvshadow_allocation_bitmap_free(
+		 &allocation_bitmap,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the extent at a specific offset that has the same NTFS allocation state
+ * Returns 1 if successful, 0 if the allocation bitmap has not been read or -1 on error
+ */
+int libvshadow_store_descriptor_get_allocation_extent(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     size64_t maximum_size,
+     size64_t *extent_size,
+     uint8_t *is_allocated,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_allocation_extent";
+	int result            = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->allocation_bitmap != NULL )
+	{
+		result = libvshadow_allocation_bitmap_get_extent(
+		          store_descriptor->allocation_bitmap,
+		          offset,
+		          maximum_size,
+		          extent_size,
+		          is_allocated,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation extent at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Adds statistics to the store descriptor statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_add_statistics(
+     libvshadow_store_descriptor_t *store_descriptor,
+     const libvshadow_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_add_statistics";
+	int phase             = 0;
+	int result            = 1;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     store_descriptor->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_statistics_add(
+	     &( store_descriptor->statistics ),
+	     statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add statistics.",
+		 function );
+
+		result = -1;
+	}
+	/* Every call adds a single sample per phase it spent time in
+	 */
+	else if( statistics->phase_timing_enabled != 0 )
+	{
+		for( phase = 0;
+		     phase < LIBVSHADOW_NUMBER_OF_TIMING_PHASES;
+		     phase++ )
+		{
+			if( statistics->phase_times[ phase ] == 0 )
+			{
+				continue;
+			}
+			if( store_descriptor->phase_timing_histograms[ phase ] == NULL )
+			{
+				if( libvshadow_histogram_initialize(
+				     &( store_descriptor->phase_timing_histograms[ phase ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create phase: %d timing histogram.",
+					 function,
+					 phase );
+
+					result = -1;
+
+					break;
+				}
+			}
+			if( libvshadow_histogram_add_value(
+			     store_descriptor->phase_timing_histograms[ phase ],
+			     statistics->phase_times[ phase ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to add value to phase: %d timing histogram.",
+				 function,
+				 phase );
+
+				result = -1;
+
+				break;
+			}
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     store_descriptor->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_statistics(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_statistics";
+	int result            = 1;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     store_descriptor->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( memory_copy(
+	     statistics,
+	     &( store_descriptor->statistics ),
+	     sizeof( libvshadow_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy statistics.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     store_descriptor->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Adds the phase timing to a histogram
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_phase_timing(
+     libvshadow_store_descriptor_t *store_descriptor,
+     int phase,
+     libvshadow_histogram_t *histogram,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_phase_timing";
+	int result            = 1;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( phase < 0 )
+	 || ( phase >= LIBVSHADOW_NUMBER_OF_TIMING_PHASES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid phase value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     store_descriptor->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->phase_timing_histograms[ phase ] != NULL )
+	{
+		if( libvshadow_histogram_add(
+		     histogram,
+		     store_descriptor->phase_timing_histograms[ phase ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add phase: %d timing histogram.",
+			 function,
+			 phase );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     store_descriptor->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the volume size
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_volume_size(
+     libvshadow_store_descriptor_t *store_descriptor,
+     size64_t *volume_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_volume_size";
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*volume_size = store_descriptor->volume_size;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_identifier(
+     libvshadow_store_descriptor_t *store_descriptor,
+     uint8_t *guid,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_identifier";
+	int result            = 1;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid GUID.",
+		 function );
+
+		return( -1 );
+	}
+	if( size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid GUID value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( memory_copy(
+	     guid,
+	     store_descriptor->identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy identifier.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the creation date and time
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_creation_time(
+     libvshadow_store_descriptor_t *store_descriptor,
+     uint64_t *filetime,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_creation_time";
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( filetime == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filetime.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*filetime = store_descriptor->creation_time;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the copy identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvshadow_store_descriptor_get_copy_identifier(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     uint8_t *guid,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_copy_identifier";
+	int result            = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid GUID.",
+		 function );
+
+		return( -1 );
+	}
+	if( size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid GUID value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data != 0 )
+	{
+		/* This function will acquire the write lock
+		 */
+		if( libvshadow_store_descriptor_read_store_header(
+		     store_descriptor,
+		     NULL,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read store header.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->has_in_volume_store_data != 0 )
+	{
+		result = 1;
+
+		if( memory_copy(
+		     guid,
+		     store_descriptor->copy_identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy shadow copy identifier.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the copy set identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvshadow_store_descriptor_get_copy_set_identifier(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     uint8_t *guid,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_copy_set_identifier";
+	int result            = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid GUID.",
+		 function );
+
+		return( -1 );
+	}
+	if( size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid GUID value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data != 0 )
+	{
+		/* This function will acquire the write lock
+		 */
+		if( libvshadow_store_descriptor_read_store_header(
+		     store_descriptor,
+		     NULL,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read store header.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->has_in_volume_store_data != 0 )
+	{
+		result = 1;
+
+		if( memory_copy(
+		     guid,
+		     store_descriptor->copy_set_identifier,
+		     16 ) == NULL )
 		{
-			libcnotify_printf(
-			 "\n" );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy shadow copy set identifier.",
+			 function );
+
+			result = -1;
 		}
-#endif
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -2715,26 +5257,20 @@ ssize_t libvshadow_store_descriptor_read_buffer(
 		return( -1 );
 	}
 #endif
-	return( (ssize_t) buffer_offset );
-
-on_error:
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
-	 store_descriptor->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+	return( result );
 }
 
-/* Retrieves the volume size
- * Returns 1 if successful or -1 on error
+/* Retrieves the attribute flags
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libvshadow_store_descriptor_get_volume_size(
+int libvshadow_store_descriptor_get_attribute_flags(
      libvshadow_store_descriptor_t *store_descriptor,
-     size64_t *volume_size,
+     libbfio_handle_t *file_io_handle,
+     uint32_t *attribute_flags,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_store_descriptor_get_volume_size";
+	static char *function = "libvshadow_store_descriptor_get_attribute_flags";
+	int result            = 0;
 
 	if( store_descriptor == NULL )
 	{
@@ -2747,17 +5283,37 @@ int libvshadow_store_descriptor_get_volume_size(
 
 		return( -1 );
 	}
-	if( volume_size == NULL )
+	if( attribute_flags == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume size.",
+		 "%s: invalid attribute flags.",
 		 function );
 
 		return( -1 );
 	}
+	if( store_descriptor->has_in_volume_store_data != 0 )
+	{
+		/* This function will acquire the write lock
+		 */
+		if( libvshadow_store_descriptor_read_store_header(
+		     store_descriptor,
+		     NULL,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read store header.",
+			 function );
+
+			return( -1 );
+		}
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     store_descriptor->read_write_lock,
@@ -2773,8 +5329,12 @@ int libvshadow_store_descriptor_get_volume_size(
 		return( -1 );
 	}
 #endif
-	*volume_size = store_descriptor->volume_size;
+	if( store_descriptor->has_in_volume_store_data != 0 )
+	{
+		result = 1;
 
+		*attribute_flags = store_descriptor->attribute_flags;
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     store_descriptor->read_write_lock,
@@ -2790,19 +5350,21 @@ int libvshadow_store_descriptor_get_volume_size(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Retrieves the identifier
+/* Retrieves the number of blocks
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_get_identifier(
+int libvshadow_store_descriptor_get_number_of_blocks(
      libvshadow_store_descriptor_t *store_descriptor,
-     uint8_t *guid,
-     size_t size,
+     libbfio_handle_t *file_io_handle,
+     int *number_of_blocks,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_store_descriptor_get_identifier";
+	libvshadow_statistics_t statistics;
+
+	static char *function = "libvshadow_store_descriptor_get_number_of_blocks";
 	int result            = 1;
 
 	if( store_descriptor == NULL )
@@ -2816,53 +5378,74 @@ int libvshadow_store_descriptor_get_identifier(
 
 		return( -1 );
 	}
-	if( guid == NULL )
+	if( store_descriptor->has_in_volume_store_data == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid GUID.",
+		 "%s: invalid store descriptor - missing in-volume store data.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 16 )
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvshadow_statistics_t ) ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: invalid GUID value too small.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     store_descriptor->read_write_lock,
+	statistics.phase_timing_enabled = store_descriptor->phase_timing_enabled;
+
+	/* This function will acquire the read/write lock for reading
+	 */
+	if( libvshadow_store_descriptor_grab_block_descriptors(
+	     store_descriptor,
+	     file_io_handle,
+	     &statistics,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block descriptors.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( memory_copy(
-	     guid,
-	     store_descriptor->identifier,
-	     16 ) == NULL )
+	if( libvshadow_store_descriptor_add_statistics(
+	     store_descriptor,
+	     &statistics,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy identifier.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add statistics.",
+		 function );
+
+		result = -1;
+	}
+	else if( libcdata_list_get_number_of_elements(
+	     store_descriptor->block_descriptors_list,
+	     number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of block descriptors.",
 		 function );
 
 		result = -1;
@@ -2885,15 +5468,24 @@ int libvshadow_store_descriptor_get_identifier(
 	return( result );
 }
 
-/* Retrieves the creation date and time
+/* Retrieves a copy of a specific block descriptor
+ * The block descriptor is copied while the read/write lock is held
+ * since the block descriptors can be evicted after it is released
+ * Make sure the value block_descriptor is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_get_creation_time(
+int libvshadow_store_descriptor_get_block_descriptor_by_index(
      libvshadow_store_descriptor_t *store_descriptor,
-     uint64_t *filetime,
+     libbfio_handle_t *file_io_handle,
+     int block_index,
+     libvshadow_block_descriptor_t **block_descriptor,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_store_descriptor_get_creation_time";
+	libvshadow_statistics_t statistics;
+
+	libvshadow_block_descriptor_t *list_block_descriptor = NULL;
+	static char *function                                = "libvshadow_store_descriptor_get_block_descriptor_by_index";
+	int result                                           = 1;
 
 	if( store_descriptor == NULL )
 	{
@@ -2906,34 +5498,95 @@ int libvshadow_store_descriptor_get_creation_time(
 
 		return( -1 );
 	}
-	if( filetime == NULL )
+	if( store_descriptor->has_in_volume_store_data == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filetime.",
+		 "%s: invalid store descriptor - missing in-volume store data.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     store_descriptor->read_write_lock,
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvshadow_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		return( -1 );
+	}
+	statistics.phase_timing_enabled = store_descriptor->phase_timing_enabled;
+
+	/* This function will acquire the read/write lock for reading
+	 */
+	if( libvshadow_store_descriptor_grab_block_descriptors(
+	     store_descriptor,
+	     file_io_handle,
+	     &statistics,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block descriptors.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*filetime = store_descriptor->creation_time;
+	if( libvshadow_store_descriptor_add_statistics(
+	     store_descriptor,
+	     &statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add statistics.",
+		 function );
+
+		result = -1;
+	}
+	else if( libcdata_list_get_value_by_index(
+	          store_descriptor->block_descriptors_list,
+	          block_index,
+	          (intptr_t **) &list_block_descriptor,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block descriptor: %d.",
+		 function,
+		 block_index );
+
+		result = -1;
+	}
+	else if( libvshadow_block_descriptor_clone(
+	          block_descriptor,
+	          list_block_descriptor,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create copy of block descriptor: %d.",
+		 function,
+		 block_index );
 
+		result = -1;
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     store_descriptor->read_write_lock,
@@ -2946,23 +5599,35 @@ int libvshadow_store_descriptor_get_creation_time(
 		 "%s: unable to release read/write lock for reading.",
 		 function );
 
+		libvshadow_block_descriptor_free(
+		 block_descriptor,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Retrieves the copy identifier
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves the (original) offsets of the blocks
+ * The block offsets are sorted by offset and are copied while the read/write lock
+ * is held since the block descriptors can be evicted after it is released
+ * Make sure the value block_offsets is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_get_copy_identifier(
+int libvshadow_store_descriptor_get_block_offsets(
      libvshadow_store_descriptor_t *store_descriptor,
-     uint8_t *guid,
-     size_t size,
+     libbfio_handle_t *file_io_handle,
+     off64_t **block_offsets,
+     int *number_of_block_offsets,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_store_descriptor_get_copy_identifier";
-	int result            = 0;
+	libvshadow_statistics_t statistics;
+
+	libvshadow_block_array_t *block_array = NULL;
+	static char *function                 = "libvshadow_store_descriptor_get_block_offsets";
+	int block_index                       = 0;
+	int result                            = 1;
 
 	if( store_descriptor == NULL )
 	{
@@ -2975,158 +5640,139 @@ int libvshadow_store_descriptor_get_copy_identifier(
 
 		return( -1 );
 	}
-	if( guid == NULL )
+	if( store_descriptor->has_in_volume_store_data == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid GUID.",
-		 function );
-
-		return( -1 );
-	}
-	if( size < 16 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: invalid GUID value too small.",
+		 "%s: invalid store descriptor - missing in-volume store data.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     store_descriptor->read_write_lock,
-	     error ) != 1 )
+	if( block_offsets == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
-
-		return( -1 );
-	}
-#endif
-	if( store_descriptor->has_in_volume_store_data != 0 )
-	{
-		result = 1;
-
-		if( memory_copy(
-		     guid,
-		     store_descriptor->copy_identifier,
-		     16 ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy shadow copy identifier.",
-			 function );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block offsets.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     store_descriptor->read_write_lock,
-	     error ) != 1 )
+	if( *block_offsets != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block offsets value already set.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves the copy set identifier
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libvshadow_store_descriptor_get_copy_set_identifier(
-     libvshadow_store_descriptor_t *store_descriptor,
-     uint8_t *guid,
-     size_t size,
-     libcerror_error_t **error )
-{
-	static char *function = "libvshadow_store_descriptor_get_copy_set_identifier";
-	int result            = 0;
-
-	if( store_descriptor == NULL )
+	if( number_of_block_offsets == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store descriptor.",
+		 "%s: invalid number of block offsets.",
 		 function );
 
 		return( -1 );
 	}
-	if( guid == NULL )
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvshadow_statistics_t ) ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid GUID.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 16 )
+	statistics.phase_timing_enabled = store_descriptor->phase_timing_enabled;
+
+	/* This function will acquire the read/write lock for reading
+	 */
+	if( libvshadow_store_descriptor_grab_block_descriptors(
+	     store_descriptor,
+	     file_io_handle,
+	     &statistics,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: invalid GUID value too small.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block descriptors.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     store_descriptor->read_write_lock,
+	block_array = store_descriptor->forward_block_descriptors_array;
+
+	*number_of_block_offsets = 0;
+
+	if( libvshadow_store_descriptor_add_statistics(
+	     store_descriptor,
+	     &statistics,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add statistics.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	if( store_descriptor->has_in_volume_store_data != 0 )
+	else if( ( block_array->number_of_block_descriptors < 0 )
+	      || ( (size_t) block_array->number_of_block_descriptors > ( (size_t) SSIZE_MAX / sizeof( off64_t ) ) ) )
 	{
-		result = 1;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block array - number of block descriptors value out of bounds.",
+		 function );
 
-		if( memory_copy(
-		     guid,
-		     store_descriptor->copy_set_identifier,
-		     16 ) == NULL )
+		result = -1;
+	}
+	else if( block_array->number_of_block_descriptors > 0 )
+	{
+		*block_offsets = (off64_t *) memory_allocate(
+		                              sizeof( off64_t ) * block_array->number_of_block_descriptors );
+
+		if( *block_offsets == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy shadow copy set identifier.",
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create block offsets.",
 			 function );
 
 			result = -1;
 		}
+		else
+		{
+			for( block_index = 0;
+			     block_index < block_array->number_of_block_descriptors;
+			     block_index++ )
+			{
+				( *block_offsets )[ block_index ] = block_array->block_descriptors[ block_index ]->original_offset;
+			}
+			*number_of_block_offsets = block_array->number_of_block_descriptors;
+		}
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -3140,22 +5786,51 @@ int libvshadow_store_descriptor_get_copy_set_identifier(
 		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
 #endif
+	if( result != 1 )
+	{
+		if( *block_offsets != NULL )
+		{
+			memory_free(
+			 *block_offsets );
+
+			*block_offsets = NULL;
+		}
+		*number_of_block_offsets = 0;
+	}
 	return( result );
 }
 
-/* Retrieves the attribute flags
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves the values of the blocks that overlap with a specific (original) range
+ * The values are copied while the read/write lock is held since the block descriptors
+ * can be evicted after it is released. The value arrays are filled up to the number
+ * of values, any of them can be NULL if the corresponding values are not needed
+ * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_get_attribute_flags(
+int libvshadow_store_descriptor_get_block_values_in_range(
      libvshadow_store_descriptor_t *store_descriptor,
-     uint32_t *attribute_flags,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t size,
+     off64_t *original_offsets,
+     off64_t *relative_offsets,
+     off64_t *offsets,
+     uint32_t *flags,
+     uint32_t *bitmaps,
+     int number_of_values,
+     int *number_of_blocks,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_store_descriptor_get_attribute_flags";
-	int result            = 0;
+	libvshadow_statistics_t statistics;
+
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	static char *function                           = "libvshadow_store_descriptor_get_block_values_in_range";
+	int first_block_index                           = 0;
+	int safe_number_of_blocks                       = 0;
+	int value_index                                 = 0;
+	int result                                      = 1;
 
 	if( store_descriptor == NULL )
 	{
@@ -3168,95 +5843,72 @@ int libvshadow_store_descriptor_get_attribute_flags(
 
 		return( -1 );
 	}
-	if( attribute_flags == NULL )
+	if( store_descriptor->has_in_volume_store_data == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid attribute flags.",
+		 "%s: invalid store descriptor - missing in-volume store data.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     store_descriptor->read_write_lock,
-	     error ) != 1 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( store_descriptor->has_in_volume_store_data != 0 )
-	{
-		result = 1;
-
-		*attribute_flags = store_descriptor->attribute_flags;
-	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     store_descriptor->read_write_lock,
-	     error ) != 1 )
+	if( number_of_values < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of values value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves the number of blocks
- * Returns 1 if successful or -1 on error
- */
-int libvshadow_store_descriptor_get_number_of_blocks(
-     libvshadow_store_descriptor_t *store_descriptor,
-     libbfio_handle_t *file_io_handle,
-     int *number_of_blocks,
-     libcerror_error_t **error )
-{
-	static char *function = "libvshadow_store_descriptor_get_number_of_blocks";
-	int result            = 1;
-
-	if( store_descriptor == NULL )
+	if( number_of_blocks == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store descriptor.",
+		 "%s: invalid number of blocks.",
 		 function );
 
 		return( -1 );
 	}
-	if( store_descriptor->has_in_volume_store_data == 0 )
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvshadow_statistics_t ) ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store descriptor - missing in-volume store data.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
 		 function );
 
 		return( -1 );
 	}
-	/* This function will acquire the write lock
+	statistics.phase_timing_enabled = store_descriptor->phase_timing_enabled;
+
+	/* This function will acquire the read/write lock for reading
 	 */
-	if( libvshadow_store_descriptor_read_block_descriptors(
+	if( libvshadow_store_descriptor_grab_block_descriptors(
 	     store_descriptor,
 	     file_io_handle,
+	     &statistics,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -3268,35 +5920,68 @@ int libvshadow_store_descriptor_get_number_of_blocks(
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     store_descriptor->read_write_lock,
+	if( libvshadow_store_descriptor_add_statistics(
+	     store_descriptor,
+	     &statistics,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add statistics.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	if( libcdata_list_get_number_of_elements(
-	     store_descriptor->block_descriptors_list,
-	     number_of_blocks,
-	     error ) != 1 )
+	else if( libvshadow_block_array_get_block_descriptor_indexes_in_range(
+	          store_descriptor->forward_block_descriptors_array,
+	          offset,
+	          size,
+	          &first_block_index,
+	          &safe_number_of_blocks,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of block descriptors.",
+		 "%s: unable to retrieve block descriptor indexes in range.",
 		 function );
 
 		result = -1;
 	}
+	else
+	{
+		for( value_index = 0;
+		     ( value_index < safe_number_of_blocks ) && ( value_index < number_of_values );
+		     value_index++ )
+		{
+			block_descriptor = store_descriptor->forward_block_descriptors_array->block_descriptors[ first_block_index + value_index ];
+
+			if( original_offsets != NULL )
+			{
+				original_offsets[ value_index ] = block_descriptor->original_offset;
+			}
+			if( relative_offsets != NULL )
+			{
+				relative_offsets[ value_index ] = block_descriptor->relative_offset;
+			}
+			if( offsets != NULL )
+			{
+				offsets[ value_index ] = block_descriptor->offset;
+			}
+			if( flags != NULL )
+			{
+				flags[ value_index ] = block_descriptor->flags;
+			}
+			if( bitmaps != NULL )
+			{
+				bitmaps[ value_index ] = block_descriptor->bitmap;
+			}
+		}
+		*number_of_blocks = safe_number_of_blocks;
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     store_descriptor->read_write_lock,
@@ -3315,18 +6000,24 @@ int libvshadow_store_descriptor_get_number_of_blocks(
 	return( result );
 }
 
-/* Retrieves a specific block descriptor
+/* Appends the blocks of store data to a physical block map
+ * Forwarder block descriptors are not appended since their data is not
+ * stored in this store
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_get_block_descriptor_by_index(
+int libvshadow_store_descriptor_append_physical_blocks(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
-     int block_index,
-     libvshadow_block_descriptor_t **block_descriptor,
+     libvshadow_physical_block_map_t *physical_block_map,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_store_descriptor_get_block_descriptor_by_index";
-	int result            = 1;
+	libvshadow_statistics_t statistics;
+
+	libvshadow_block_array_t *block_array           = NULL;
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	static char *function                           = "libvshadow_store_descriptor_append_physical_blocks";
+	int block_index                                 = 0;
+	int result                                      = 1;
 
 	if( store_descriptor == NULL )
 	{
@@ -3350,11 +6041,39 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
 
 		return( -1 );
 	}
-	/* This function will acquire the write lock
+	if( physical_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvshadow_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		return( -1 );
+	}
+	statistics.phase_timing_enabled = store_descriptor->phase_timing_enabled;
+
+	/* This function will acquire the read/write lock for reading
 	 */
-	if( libvshadow_store_descriptor_read_block_descriptors(
+	if( libvshadow_store_descriptor_grab_block_descriptors(
 	     store_descriptor,
 	     file_io_handle,
+	     &statistics,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -3366,36 +6085,72 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     store_descriptor->read_write_lock,
+	block_array = store_descriptor->forward_block_descriptors_array;
+
+	if( libvshadow_store_descriptor_add_statistics(
+	     store_descriptor,
+	     &statistics,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add statistics.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	if( libcdata_list_get_value_by_index(
-	     store_descriptor->block_descriptors_list,
-	     block_index,
-	     (intptr_t **) block_descriptor,
-	     error ) != 1 )
+	for( block_index = 0;
+	     ( result == 1 ) && ( block_index < block_array->number_of_block_descriptors );
+	     block_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve block descriptor: %d.",
-		 function,
-		 block_index );
+		block_descriptor = block_array->block_descriptors[ block_index ];
 
-		result = -1;
+		if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) == 0 )
+		{
+			if( libvshadow_physical_block_map_append_block(
+			     physical_block_map,
+			     block_descriptor->offset,
+			     block_descriptor->original_offset,
+			     store_descriptor->index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append block: %d to physical block map.",
+				 function,
+				 block_index );
+
+				result = -1;
+			}
+		}
+		/* An overlay of a regular or forwarder block descriptor has its own block of store data
+		 */
+		if( ( result == 1 )
+		 && ( block_descriptor->overlay != NULL )
+		 && ( block_descriptor->overlay != block_descriptor ) )
+		{
+			if( libvshadow_physical_block_map_append_block(
+			     physical_block_map,
+			     block_descriptor->overlay->offset,
+			     block_descriptor->overlay->original_offset,
+			     store_descriptor->index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append overlay of block: %d to physical block map.",
+				 function,
+				 block_index );
+
+				result = -1;
+			}
+		}
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -3414,4 +6169,3 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
 #endif
 	return( result );
 }
-
@@ -25,11 +25,18 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvshadow_allocation_bitmap.h"
+#include "libvshadow_block_array.h"
 #include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_table.h"
+#include "libvshadow_histogram.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_physical_block_map.h"
+#include "libvshadow_statistics.h"
+#include "libvshadow_store_block_reader.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -106,13 +113,19 @@ struct libvshadow_store_descriptor
 	 */
 	libcdata_list_t *block_descriptors_list;
 
-	/* The forward block descriptors B-tree
+	/* The forward block descriptors table
+	 * used to merge the block descriptors while the block lists are read
 	 */
-	libcdata_btree_t *forward_block_descriptors_tree;
+	libvshadow_block_table_t *forward_block_descriptors_table;
 
-	/* The reverse block descriptors B-tree
+	/* The forward block descriptors array
+	 * sorted by original offset after the block lists have been read
 	 */
-	libcdata_btree_t *reverse_block_descriptors_tree;
+	libvshadow_block_array_t *forward_block_descriptors_array;
+
+	/* The reverse block descriptors table
+	 */
+	libvshadow_block_table_t *reverse_block_descriptors_table;
 
 	/* The block offset list
 	 */
@@ -122,6 +135,10 @@ struct libvshadow_store_descriptor
 	 */
 	libcdata_range_list_t *previous_block_offset_list;
 
+	/* The NTFS allocation bitmap of the store
+	 */
+	libvshadow_allocation_bitmap_t *allocation_bitmap;
+
 	/* The previous store descriptor in the read chain
 	 */
 	libvshadow_store_descriptor_t *previous_store_descriptor;
@@ -138,14 +155,42 @@ struct libvshadow_store_descriptor
 	 */
 	uint8_t has_in_volume_store_data;
 
+	/* Value to indicate the store header has been read
+	 */
+	uint8_t store_header_read;
+
 	/* Value to indicate the block descriptors have been read
 	 */
 	uint8_t block_descriptors_read;
 
+	/* The estimated size of the memory used by the block descriptors
+	 */
+	size64_t block_descriptors_memory_size;
+
+	/* The timestamp of the last use of the block descriptors
+	 */
+	uint64_t block_descriptors_used_time;
+
+	/* The statistics
+	 */
+	libvshadow_statistics_t statistics;
+
+	/* The phase timing histograms
+	 */
+	libvshadow_histogram_t *phase_timing_histograms[ LIBVSHADOW_NUMBER_OF_TIMING_PHASES ];
+
+	/* Value to indicate the phase timing is enabled
+	 */
+	uint8_t phase_timing_enabled;
+
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The statistics mutex
+	 */
+	libcthreads_mutex_t *statistics_mutex;
 #endif
 };
 
@@ -157,6 +202,25 @@ int libvshadow_store_descriptor_free(
      libvshadow_store_descriptor_t **store_descriptor,
      libcerror_error_t **error );
 
+int libvshadow_store_descriptor_clear_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_evict_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_block_descriptors_usage(
+     libvshadow_store_descriptor_t *store_descriptor,
+     size64_t *memory_size,
+     uint64_t *used_time,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_set_next_store_descriptor(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *next_store_descriptor,
+     libcerror_error_t **error );
+
 int libvshadow_store_descriptor_has_in_volume_data(
      libvshadow_store_descriptor_t *store_descriptor,
      libcerror_error_t **error );
@@ -180,35 +244,98 @@ int libvshadow_store_descriptor_read_catalog_entry(
 
 int libvshadow_store_descriptor_read_store_header(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_block_reader_t *store_block_reader,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
 int libvshadow_store_descriptor_read_store_bitmap(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_block_reader_t *store_block_reader,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      libcdata_range_list_t *offset_list,
      off64_t *bitmap_offset,
      off64_t *next_offset,
+     libvshadow_statistics_t *statistics,
      libcerror_error_t **error );
 
 int libvshadow_store_descriptor_read_store_block_list(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_block_reader_t *store_block_reader,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      off64_t *next_offset,
+     libvshadow_statistics_t *statistics,
      libcerror_error_t **error );
 
 int libvshadow_store_descriptor_read_store_block_range_list(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_block_reader_t *store_block_reader,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      off64_t *next_offset,
+     libvshadow_statistics_t *statistics,
      libcerror_error_t **error );
 
 int libvshadow_store_descriptor_read_block_descriptors(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
+     libvshadow_statistics_t *statistics,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_calculate_block_descriptors_memory_size(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_grab_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libvshadow_statistics_t *statistics,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_block_source(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_statistics_t *statistics,
+     int *source_type,
+     off64_t *source_offset,
+     size_t *source_size,
+     libcerror_error_t **error );
+
+ssize_t libvshadow_store_descriptor_read_buffer_in_chain(
+         libvshadow_store_descriptor_t *store_descriptor,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libvshadow_store_descriptor_t *active_store_descriptor,
+         libvshadow_statistics_t *statistics,
+         int chain_depth,
+         libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_block_source_in_chain(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size_t maximum_size,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_statistics_t *statistics,
+     int chain_depth,
+     int *source_type,
+     off64_t *source_offset,
+     size_t *source_size,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_physical_extent(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t maximum_size,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     off64_t *physical_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
      libcerror_error_t **error );
 
 ssize_t libvshadow_store_descriptor_read_buffer(
@@ -220,6 +347,35 @@ ssize_t libvshadow_store_descriptor_read_buffer(
          libvshadow_store_descriptor_t *active_store_descriptor,
          libcerror_error_t **error );
 
+int libvshadow_store_descriptor_read_allocation_bitmap(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_allocation_extent(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     size64_t maximum_size,
+     size64_t *extent_size,
+     uint8_t *is_allocated,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_add_statistics(
+     libvshadow_store_descriptor_t *store_descriptor,
+     const libvshadow_statistics_t *statistics,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_statistics(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_statistics_t *statistics,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_phase_timing(
+     libvshadow_store_descriptor_t *store_descriptor,
+     int phase,
+     libvshadow_histogram_t *histogram,
+     libcerror_error_t **error );
+
 int libvshadow_store_descriptor_get_volume_size(
      libvshadow_store_descriptor_t *store_descriptor,
      size64_t *volume_size,
@@ -238,18 +394,21 @@ int libvshadow_store_descriptor_get_creation_time(
 
 int libvshadow_store_descriptor_get_copy_identifier(
      libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
      uint8_t *guid,
      size_t size,
      libcerror_error_t **error );
 
 int libvshadow_store_descriptor_get_copy_set_identifier(
      libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
      uint8_t *guid,
      size_t size,
      libcerror_error_t **error );
 
 int libvshadow_store_descriptor_get_attribute_flags(
      libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
      uint32_t *attribute_flags,
      libcerror_error_t **error );
 
@@ -266,6 +425,33 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
      libvshadow_block_descriptor_t **block_descriptor,
      libcerror_error_t **error );
 
+int libvshadow_store_descriptor_get_block_offsets(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t **block_offsets,
+     int *number_of_block_offsets,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_block_values_in_range(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t size,
+     off64_t *original_offsets,
+     off64_t *relative_offsets,
+     off64_t *offsets,
+     uint32_t *flags,
+     uint32_t *bitmaps,
+     int number_of_values,
+     int *number_of_blocks,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_append_physical_blocks(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libvshadow_physical_block_map_t *physical_block_map,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1610 @@
+/*
+ * Thread pool functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_definitions.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcnotify.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_thread_pool.h"
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+
+/* The tasks of a job are divided in one range of task indexes per worker.
+ * A worker runs the tasks of its most recently added range in order and,
+ * when it has no ranges left, steals the upper half of the oldest range
+ * of another worker. A thread that waits for a job to finish runs single
+ * tasks of the other workers in the meantime, hence a task can run a job
+ * on the same thread pool without the risk of a deadlock.
+ */
+
+/* The thread pool cannot be freed by a task since the task is run on behalf
+ * of a user of the thread pool. The task frames of the calling thread are kept
+ * in thread-local storage so that this can be detected.
+ */
+#if defined( _MSC_VER )
+#define LIBVSHADOW_THREAD_POOL_THREAD_LOCAL	__declspec( thread )
+
+#elif defined( __STDC_VERSION__ ) && ( __STDC_VERSION__ >= 201112L )
+#define LIBVSHADOW_THREAD_POOL_THREAD_LOCAL	_Thread_local
+
+#elif defined( __GNUC__ ) || defined( __clang__ )
+#define LIBVSHADOW_THREAD_POOL_THREAD_LOCAL	__thread
+
+#endif
+
+#if defined( LIBVSHADOW_THREAD_POOL_THREAD_LOCAL )
+
+/* The frame of the task the calling thread is running
+ */
+static LIBVSHADOW_THREAD_POOL_THREAD_LOCAL libvshadow_thread_pool_task_frame_t *libvshadow_thread_pool_current_task_frame = NULL;
+
+#endif
+
+/* Adds a range of tasks to a worker
+ * Returns 1 if successful or -1 on error
+ */
+static int libvshadow_thread_pool_worker_push_range(
+            libvshadow_thread_pool_worker_t *worker,
+            libvshadow_thread_pool_job_t *job,
+            int first_task_index,
+            int end_task_index,
+            libcerror_error_t **error )
+{
+	libvshadow_thread_pool_range_t *ranges = NULL;
+	static char *function                  = "libvshadow_thread_pool_worker_push_range";
+	int number_of_allocated_ranges         = 0;
+	int range_index                        = 0;
+	int result                             = 1;
+
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     worker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker->number_of_ranges >= worker->number_of_allocated_ranges )
+	{
+		number_of_allocated_ranges = worker->number_of_allocated_ranges * 2;
+
+		if( number_of_allocated_ranges == 0 )
+		{
+			number_of_allocated_ranges = 16;
+		}
+		ranges = (libvshadow_thread_pool_range_t *) memory_allocate(
+		                                             sizeof( libvshadow_thread_pool_range_t ) * number_of_allocated_ranges );
+
+		if( ranges == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create ranges.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			/* Copy the ranges in order so that the oldest range becomes the first
+			 */
+			for( range_index = 0;
+			     range_index < worker->number_of_ranges;
+			     range_index++ )
+			{
+				ranges[ range_index ] = worker->ranges[ ( worker->first_range_index + range_index ) % worker->number_of_allocated_ranges ];
+			}
+			if( worker->ranges != NULL )
+			{
+				memory_free(
+				 worker->ranges );
+			}
+			worker->ranges                     = ranges;
+			worker->first_range_index          = 0;
+			worker->number_of_allocated_ranges = number_of_allocated_ranges;
+		}
+	}
+	if( result == 1 )
+	{
+		range_index = ( worker->first_range_index + worker->number_of_ranges ) % worker->number_of_allocated_ranges;
+
+		worker->ranges[ range_index ].job              = job;
+		worker->ranges[ range_index ].first_task_index = first_task_index;
+		worker->ranges[ range_index ].end_task_index   = end_task_index;
+
+		worker->number_of_ranges += 1;
+	}
+	if( libcthreads_mutex_release(
+	     worker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Takes a task from the most recent range of a worker
+ * Returns 1 if successful, 0 if the worker has no ranges or -1 on error
+ */
+static int libvshadow_thread_pool_worker_take_task(
+            libvshadow_thread_pool_worker_t *worker,
+            libvshadow_thread_pool_job_t **job,
+            int *task_index,
+            libcerror_error_t **error )
+{
+	libvshadow_thread_pool_range_t *range = NULL;
+	static char *function                 = "libvshadow_thread_pool_worker_take_task";
+	int result                            = 0;
+
+	if( libcthreads_mutex_grab(
+	     worker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker->number_of_ranges > 0 )
+	{
+		range = &( worker->ranges[ ( worker->first_range_index + worker->number_of_ranges - 1 ) % worker->number_of_allocated_ranges ] );
+
+		*job        = range->job;
+		*task_index = range->first_task_index;
+
+		range->first_task_index += 1;
+
+		if( range->first_task_index >= range->end_task_index )
+		{
+			worker->number_of_ranges -= 1;
+		}
+		result = 1;
+	}
+	if( libcthreads_mutex_release(
+	     worker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Steals tasks from the oldest range of a worker
+ * If a stolen range is provided the upper half of the range is stolen,
+ * otherwise only the last task of the range
+ * Returns 1 if successful, 0 if the worker has no ranges or -1 on error
+ */
+static int libvshadow_thread_pool_worker_steal_tasks(
+            libvshadow_thread_pool_worker_t *worker,
+            libvshadow_thread_pool_range_t *stolen_range,
+            libvshadow_thread_pool_job_t **job,
+            int *task_index,
+            libcerror_error_t **error )
+{
+	libvshadow_thread_pool_range_t *range = NULL;
+	static char *function                 = "libvshadow_thread_pool_worker_steal_tasks";
+	int middle_task_index                 = 0;
+	int result                            = 0;
+
+	if( libcthreads_mutex_grab(
+	     worker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker->number_of_ranges > 0 )
+	{
+		range = &( worker->ranges[ worker->first_range_index ] );
+
+		*job = range->job;
+
+		if( stolen_range == NULL )
+		{
+			range->end_task_index -= 1;
+
+			*task_index = range->end_task_index;
+		}
+		else
+		{
+			middle_task_index = range->first_task_index
+			                  + ( ( range->end_task_index - range->first_task_index ) / 2 );
+
+			stolen_range->job              = range->job;
+			stolen_range->first_task_index = middle_task_index + 1;
+			stolen_range->end_task_index   = range->end_task_index;
+
+			*task_index = middle_task_index;
+
+			range->end_task_index = middle_task_index;
+		}
+		if( range->first_task_index >= range->end_task_index )
+		{
+			worker->first_range_index = ( worker->first_range_index + 1 ) % worker->number_of_allocated_ranges;
+			worker->number_of_ranges -= 1;
+		}
+		result = 1;
+	}
+	if( libcthreads_mutex_release(
+	     worker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Takes a task that is queued in the thread pool
+ * A worker first takes a task from its own ranges before stealing from other workers,
+ * a thread that is not a worker, with worker index -1, only steals single tasks
+ * Returns 1 if successful, 0 if no task is available or -1 on error
+ */
+static int libvshadow_thread_pool_get_task(
+            libvshadow_thread_pool_t *thread_pool,
+            int worker_index,
+            libvshadow_thread_pool_job_t **job,
+            int *task_index,
+            libcerror_error_t **error )
+{
+	libvshadow_thread_pool_range_t stolen_range;
+
+	static char *function = "libvshadow_thread_pool_get_task";
+	int result            = 0;
+	int victim_index      = 0;
+	int worker_offset     = 0;
+
+	stolen_range.job              = NULL;
+	stolen_range.first_task_index = 0;
+	stolen_range.end_task_index   = 0;
+
+	if( worker_index >= 0 )
+	{
+		result = libvshadow_thread_pool_worker_take_task(
+		          &( thread_pool->workers[ worker_index ] ),
+		          job,
+		          task_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to take task from worker: %d.",
+			 function,
+			 worker_index );
+
+			return( -1 );
+		}
+	}
+	for( worker_offset = 1;
+	     ( result == 0 ) && ( worker_offset <= thread_pool->number_of_threads );
+	     worker_offset++ )
+	{
+		victim_index = ( worker_index + worker_offset ) % thread_pool->number_of_threads;
+
+		if( victim_index == worker_index )
+		{
+			continue;
+		}
+		if( worker_index >= 0 )
+		{
+			result = libvshadow_thread_pool_worker_steal_tasks(
+			          &( thread_pool->workers[ victim_index ] ),
+			          &stolen_range,
+			          job,
+			          task_index,
+			          error );
+		}
+		else
+		{
+			result = libvshadow_thread_pool_worker_steal_tasks(
+			          &( thread_pool->workers[ victim_index ] ),
+			          NULL,
+			          job,
+			          task_index,
+			          error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to steal tasks from worker: %d.",
+			 function,
+			 victim_index );
+
+			return( -1 );
+		}
+	}
+	if( result == 0 )
+	{
+		return( 0 );
+	}
+	/* The remainder of a stolen range is added to the ranges of the worker
+	 * and remains queued
+	 */
+	if( stolen_range.first_task_index < stolen_range.end_task_index )
+	{
+		if( libvshadow_thread_pool_worker_push_range(
+		     &( thread_pool->workers[ worker_index ] ),
+		     stolen_range.job,
+		     stolen_range.first_task_index,
+		     stolen_range.end_task_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add stolen range to worker: %d.",
+			 function,
+			 worker_index );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	thread_pool->number_of_queued_tasks -= 1;
+
+	if( libcthreads_mutex_release(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Runs a task and marks it as finished
+ * Returns 1 if successful or -1 on error
+ */
+static int libvshadow_thread_pool_run_task(
+            libvshadow_thread_pool_t *thread_pool,
+            libvshadow_thread_pool_job_t *job,
+            int task_index,
+            libcerror_error_t **error )
+{
+	static char *function = "libvshadow_thread_pool_run_task";
+	int callback_result   = 0;
+
+#if defined( LIBVSHADOW_THREAD_POOL_THREAD_LOCAL )
+	libvshadow_thread_pool_task_frame_t task_frame;
+
+	task_frame.thread_pool    = thread_pool;
+	task_frame.previous_frame = libvshadow_thread_pool_current_task_frame;
+
+	libvshadow_thread_pool_current_task_frame = &task_frame;
+#endif
+	callback_result = job->callback_function(
+	                   task_index,
+	                   job->callback_function_arguments );
+
+#if defined( LIBVSHADOW_THREAD_POOL_THREAD_LOCAL )
+	libvshadow_thread_pool_current_task_frame = task_frame.previous_frame;
+#endif
+
+	if( libcthreads_mutex_grab(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_result != 1 )
+	{
+		job->result = -1;
+	}
+	job->number_of_unfinished_tasks -= 1;
+
+	/* The job can be freed by the thread that runs it after the mutex is released
+	 */
+	if( job->number_of_unfinished_tasks == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     thread_pool->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 thread_pool->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* The worker thread callback function
+ * Returns 1 if successful or -1 on error
+ */
+static int libvshadow_thread_pool_worker_callback(
+            libvshadow_thread_pool_worker_t *worker )
+{
+	libcerror_error_t *error           = NULL;
+	libvshadow_thread_pool_job_t *job  = NULL;
+	libvshadow_thread_pool_t *thread_pool = NULL;
+	static char *function              = "libvshadow_thread_pool_worker_callback";
+	int result                         = 0;
+	int task_index                     = 0;
+	uint8_t stop                       = 0;
+
+	if( worker == NULL )
+	{
+		return( -1 );
+	}
+	thread_pool = worker->thread_pool;
+
+	while( stop == 0 )
+	{
+		result = libvshadow_thread_pool_get_task(
+		          thread_pool,
+		          worker->worker_index,
+		          &job,
+		          &task_index,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve task.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libvshadow_thread_pool_run_task(
+			     thread_pool,
+			     job,
+			     task_index,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to run task: %d.",
+				 function,
+				 task_index );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( libcthreads_mutex_grab(
+		     thread_pool->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		while( ( thread_pool->number_of_queued_tasks == 0 )
+		    && ( thread_pool->abort == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     thread_pool->condition,
+			     thread_pool->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 thread_pool->mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		if( ( thread_pool->number_of_queued_tasks == 0 )
+		 && ( thread_pool->abort != 0 ) )
+		{
+			stop = 1;
+		}
+		if( libcthreads_mutex_release(
+		     thread_pool->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	/* The tasks that remain in the ranges of the worker are stolen
+	 * by the other workers and the threads that wait for their jobs
+	 */
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Creates a thread pool
+ * Make sure the value thread_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_thread_pool_initialize(
+     libvshadow_thread_pool_t **thread_pool,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_thread_pool_initialize";
+	int worker_index      = 0;
+
+	if( thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBVSHADOW_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*thread_pool = memory_allocate_structure(
+	                libvshadow_thread_pool_t );
+
+	if( *thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *thread_pool,
+	     0,
+	     sizeof( libvshadow_thread_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear thread pool.",
+		 function );
+
+		memory_free(
+		 *thread_pool );
+
+		*thread_pool = NULL;
+
+		return( -1 );
+	}
+	( *thread_pool )->workers = (libvshadow_thread_pool_worker_t *) memory_allocate(
+	                                                                 sizeof( libvshadow_thread_pool_worker_t ) * number_of_threads );
+
+	if( ( *thread_pool )->workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *thread_pool )->workers,
+	     0,
+	     sizeof( libvshadow_thread_pool_worker_t ) * number_of_threads ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		memory_free(
+		 ( *thread_pool )->workers );
+
+		( *thread_pool )->workers = NULL;
+
+		goto on_error;
+	}
+	( *thread_pool )->number_of_threads = number_of_threads;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *thread_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *thread_pool )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	for( worker_index = 0;
+	     worker_index < number_of_threads;
+	     worker_index++ )
+	{
+		( *thread_pool )->workers[ worker_index ].thread_pool  = *thread_pool;
+		( *thread_pool )->workers[ worker_index ].worker_index = worker_index;
+
+		if( libcthreads_mutex_initialize(
+		     &( ( *thread_pool )->workers[ worker_index ].mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mutex of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+	/* The threads are started after all the workers have been set up
+	 * since a worker steals from the other workers
+	 */
+	for( worker_index = 0;
+	     worker_index < number_of_threads;
+	     worker_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( ( *thread_pool )->workers[ worker_index ].thread ),
+		     NULL,
+		     (int (*)(void *)) &libvshadow_thread_pool_worker_callback,
+		     (void *) &( ( *thread_pool )->workers[ worker_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *thread_pool != NULL )
+	{
+		libvshadow_thread_pool_free(
+		 thread_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a thread pool
+ * Waits until every user that grabbed the thread pool has released it,
+ * the threads are stopped after the queued tasks have been run
+ * A task of the thread pool cannot free it since it would wait for itself
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_thread_pool_free(
+     libvshadow_thread_pool_t **thread_pool,
+     libcerror_error_t **error )
+{
+	libvshadow_thread_pool_worker_t *worker = NULL;
+	static char *function                   = "libvshadow_thread_pool_free";
+	int result                              = 1;
+	int worker_index                        = 0;
+
+	if( thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *thread_pool == NULL )
+	{
+		return( 1 );
+	}
+	result = libvshadow_thread_pool_is_running_task(
+	          *thread_pool,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if calling thread is running a task.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to free thread pool from one of its tasks.",
+		 function );
+
+		return( -1 );
+	}
+	result = 1;
+
+	if( ( *thread_pool )->mutex != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     ( *thread_pool )->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			while( ( result == 1 )
+			    && ( ( *thread_pool )->number_of_users > 0 ) )
+			{
+				if( libcthreads_condition_wait(
+				     ( *thread_pool )->condition,
+				     ( *thread_pool )->mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to wait for condition.",
+					 function );
+
+					result = -1;
+				}
+			}
+			( *thread_pool )->abort = 1;
+
+			if( libcthreads_condition_broadcast(
+			     ( *thread_pool )->condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast condition.",
+				 function );
+
+				result = -1;
+			}
+			if( libcthreads_mutex_release(
+			     ( *thread_pool )->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+	if( ( *thread_pool )->workers != NULL )
+	{
+		for( worker_index = 0;
+		     worker_index < ( *thread_pool )->number_of_threads;
+		     worker_index++ )
+		{
+			worker = &( ( *thread_pool )->workers[ worker_index ] );
+
+			if( worker->thread != NULL )
+			{
+				if( libcthreads_thread_join(
+				     &( worker->thread ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to join thread of worker: %d.",
+					 function,
+					 worker_index );
+
+					result = -1;
+				}
+			}
+		}
+		for( worker_index = 0;
+		     worker_index < ( *thread_pool )->number_of_threads;
+		     worker_index++ )
+		{
+			worker = &( ( *thread_pool )->workers[ worker_index ] );
+
+			if( worker->mutex != NULL )
+			{
+				if( libcthreads_mutex_free(
+				     &( worker->mutex ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free mutex of worker: %d.",
+					 function,
+					 worker_index );
+
+					result = -1;
+				}
+			}
+			if( worker->ranges != NULL )
+			{
+				memory_free(
+				 worker->ranges );
+			}
+		}
+		memory_free(
+		 ( *thread_pool )->workers );
+	}
+	if( ( *thread_pool )->condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( ( *thread_pool )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( *thread_pool )->mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( ( *thread_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	memory_free(
+	 *thread_pool );
+
+	*thread_pool = NULL;
+
+	return( result );
+}
+
+/* Retrieves the number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_thread_pool_get_number_of_threads(
+     libvshadow_thread_pool_t *thread_pool,
+     int *number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_thread_pool_get_number_of_threads";
+
+	if( thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_threads = thread_pool->number_of_threads;
+
+	return( 1 );
+}
+
+/* Grabs the thread pool to run jobs on it
+ * The thread pool is not freed before it is released by every user that grabbed it
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_thread_pool_grab(
+     libvshadow_thread_pool_t *thread_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_thread_pool_grab";
+
+	if( thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	thread_pool->number_of_users += 1;
+
+	if( libcthreads_mutex_release(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases the thread pool after it was grabbed
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_thread_pool_release(
+     libvshadow_thread_pool_t *thread_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_thread_pool_release";
+	int result            = 1;
+
+	if( thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_pool->number_of_users <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid thread pool - number of users value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		thread_pool->number_of_users -= 1;
+
+		/* The thread pool can be freed by the thread that waits for it
+		 * after the mutex is released
+		 */
+		if( thread_pool->number_of_users == 0 )
+		{
+			if( libcthreads_condition_broadcast(
+			     thread_pool->condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+	if( libcthreads_mutex_release(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Determines if the calling thread is running a task of the thread pool
+ * Without thread-local storage support the calling thread is never
+ * considered to be running a task
+ * Returns 1 if the calling thread is running a task, 0 if not or -1 on error
+ */
+int libvshadow_thread_pool_is_running_task(
+     libvshadow_thread_pool_t *thread_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_thread_pool_is_running_task";
+
+#if defined( LIBVSHADOW_THREAD_POOL_THREAD_LOCAL )
+	libvshadow_thread_pool_task_frame_t *task_frame = NULL;
+#endif
+
+	if( thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVSHADOW_THREAD_POOL_THREAD_LOCAL )
+	for( task_frame = libvshadow_thread_pool_current_task_frame;
+	     task_frame != NULL;
+	     task_frame = task_frame->previous_frame )
+	{
+		if( task_frame->thread_pool == thread_pool )
+		{
+			return( 1 );
+		}
+	}
+#endif
+	return( 0 );
+}
+
+/* Runs the callback function for the task indexes 0 to number of tasks - 1
+ * The tasks are run by the threads of the thread pool and by the calling thread,
+ * which returns after all tasks have finished
+ * Tasks can run in any order and concurrently
+ * A task can call this function to run tasks on the same thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_thread_pool_run(
+     libvshadow_thread_pool_t *thread_pool,
+     int (*callback_function)(
+            int task_index,
+            void *arguments ),
+     void *callback_function_arguments,
+     int number_of_tasks,
+     libcerror_error_t **error )
+{
+	libvshadow_thread_pool_job_t job;
+
+	libvshadow_thread_pool_job_t *task_job = NULL;
+	static char *function                  = "libvshadow_thread_pool_run";
+	int end_task_index                     = 0;
+	int first_task_index                   = 0;
+	int first_worker_index                 = 0;
+	int number_of_ranges                   = 0;
+	int number_of_unqueued_tasks           = 0;
+	int range_index                        = 0;
+	int result                             = 0;
+	int task_index                         = 0;
+	uint8_t finished                       = 0;
+	uint8_t run_other_tasks                = 1;
+
+	if( thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_tasks < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of tasks value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_tasks == 0 )
+	{
+		return( 1 );
+	}
+	job.callback_function           = callback_function;
+	job.callback_function_arguments = callback_function_arguments;
+	job.number_of_unfinished_tasks  = number_of_tasks;
+	job.result                      = 1;
+
+	number_of_ranges = thread_pool->number_of_threads;
+
+	if( number_of_ranges > number_of_tasks )
+	{
+		number_of_ranges = number_of_tasks;
+	}
+	if( libcthreads_mutex_grab(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* The tasks are counted as queued before they are added so that
+	 * the number of queued tasks never becomes negative
+	 */
+	thread_pool->number_of_queued_tasks += number_of_tasks;
+
+	first_worker_index = thread_pool->next_worker_index;
+
+	thread_pool->next_worker_index = ( first_worker_index + number_of_ranges ) % thread_pool->number_of_threads;
+
+	if( libcthreads_mutex_release(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* Every worker is given a contiguous range of tasks
+	 */
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		first_task_index = (int) ( ( (int64_t) number_of_tasks * range_index ) / number_of_ranges );
+		end_task_index   = (int) ( ( (int64_t) number_of_tasks * ( range_index + 1 ) ) / number_of_ranges );
+
+		if( libvshadow_thread_pool_worker_push_range(
+		     &( thread_pool->workers[ ( first_worker_index + range_index ) % thread_pool->number_of_threads ] ),
+		     &job,
+		     first_task_index,
+		     end_task_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add range: %d to worker.",
+			 function,
+			 range_index );
+
+			number_of_unqueued_tasks = number_of_tasks - first_task_index;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_unqueued_tasks > 0 )
+	{
+		thread_pool->number_of_queued_tasks -= number_of_unqueued_tasks;
+		job.number_of_unfinished_tasks      -= number_of_unqueued_tasks;
+		job.result                           = -1;
+	}
+	if( libcthreads_condition_broadcast(
+	     thread_pool->condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		run_other_tasks = 0;
+	}
+	if( libcthreads_mutex_release(
+	     thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* The job is referenced by the ranges of the workers hence this function
+	 * cannot return before all of its tasks have finished
+	 */
+	while( finished == 0 )
+	{
+		if( run_other_tasks != 0 )
+		{
+			result = libvshadow_thread_pool_get_task(
+			          thread_pool,
+			          -1,
+			          &task_job,
+			          &task_index,
+			          error );
+
+			if( result == 1 )
+			{
+				if( libvshadow_thread_pool_run_task(
+				     thread_pool,
+				     task_job,
+				     task_index,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to run task: %d.",
+					 function,
+					 task_index );
+
+					run_other_tasks = 0;
+				}
+				continue;
+			}
+			else if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve task.",
+				 function );
+
+				run_other_tasks = 0;
+			}
+		}
+		if( libcthreads_mutex_grab(
+		     thread_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		while( ( job.number_of_unfinished_tasks != 0 )
+		    && ( ( run_other_tasks == 0 )
+		     ||  ( thread_pool->number_of_queued_tasks == 0 ) ) )
+		{
+			if( libcthreads_condition_wait(
+			     thread_pool->condition,
+			     thread_pool->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 thread_pool->mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( job.number_of_unfinished_tasks == 0 )
+		{
+			finished = 1;
+		}
+		if( libcthreads_mutex_release(
+		     thread_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( run_other_tasks == 0 )
+	{
+		return( -1 );
+	}
+	if( job.result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run one or more tasks.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,222 @@
+/*
+ * Thread pool functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_THREAD_POOL_H )
+#define _LIBVSHADOW_THREAD_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+
+typedef struct libvshadow_thread_pool_job libvshadow_thread_pool_job_t;
+
+/* A set of tasks that is run by the thread pool
+ */
+struct libvshadow_thread_pool_job
+{
+	/* The callback function, called once for every task index
+	 */
+	int (*callback_function)(
+	       int task_index,
+	       void *arguments );
+
+	/* The callback function arguments
+	 */
+	void *callback_function_arguments;
+
+	/* The number of tasks that have not finished
+	 */
+	int number_of_unfinished_tasks;
+
+	/* The result, -1 if any of the tasks failed
+	 */
+	int result;
+};
+
+typedef struct libvshadow_thread_pool_range libvshadow_thread_pool_range_t;
+
+/* A range of task indexes of a job
+ */
+struct libvshadow_thread_pool_range
+{
+	/* The job
+	 */
+	libvshadow_thread_pool_job_t *job;
+
+	/* The first task index
+	 */
+	int first_task_index;
+
+	/* The end task index, the task index after the last task
+	 */
+	int end_task_index;
+};
+
+typedef struct libvshadow_thread_pool libvshadow_thread_pool_t;
+
+typedef struct libvshadow_thread_pool_worker libvshadow_thread_pool_worker_t;
+
+/* A worker thread and the ranges of tasks it was given
+ * The worker runs the tasks of its most recent range first,
+ * other threads steal from its oldest range
+ */
+struct libvshadow_thread_pool_worker
+{
+	/* The thread pool
+	 */
+	libvshadow_thread_pool_t *thread_pool;
+
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The index of the worker
+	 */
+	int worker_index;
+
+	/* The mutex that protects the ranges
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The ranges, a circular buffer
+	 */
+	libvshadow_thread_pool_range_t *ranges;
+
+	/* The index of the oldest range
+	 */
+	int first_range_index;
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+
+	/* The number of allocated ranges
+	 */
+	int number_of_allocated_ranges;
+};
+
+/* A work-stealing thread pool
+ */
+struct libvshadow_thread_pool
+{
+	/* The workers
+	 */
+	libvshadow_thread_pool_worker_t *workers;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The index of the worker that is given the first range of the next job
+	 */
+	int next_worker_index;
+
+	/* The number of tasks that were queued but not yet taken by a thread
+	 */
+	int number_of_queued_tasks;
+
+	/* The number of callers that grabbed the thread pool to run jobs on it
+	 */
+	int number_of_users;
+
+	/* Value to indicate the threads should stop
+	 */
+	uint8_t abort;
+
+	/* The mutex that protects the number of queued tasks, the jobs,
+	 * the number of users and the abort value
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when tasks are queued, jobs finish
+	 * or the last user releases the thread pool
+	 */
+	libcthreads_condition_t *condition;
+};
+
+typedef struct libvshadow_thread_pool_task_frame libvshadow_thread_pool_task_frame_t;
+
+/* The task that a thread is running, kept on the stack of the thread
+ * A task that runs a job on a thread pool can run tasks of that job
+ * on the same thread, hence the frames form a chain
+ */
+struct libvshadow_thread_pool_task_frame
+{
+	/* The thread pool the task belongs to
+	 */
+	libvshadow_thread_pool_t *thread_pool;
+
+	/* The frame of the task the thread was running before
+	 */
+	libvshadow_thread_pool_task_frame_t *previous_frame;
+};
+
+int libvshadow_thread_pool_initialize(
+     libvshadow_thread_pool_t **thread_pool,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libvshadow_thread_pool_free(
+     libvshadow_thread_pool_t **thread_pool,
+     libcerror_error_t **error );
+
+int libvshadow_thread_pool_get_number_of_threads(
+     libvshadow_thread_pool_t *thread_pool,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+int libvshadow_thread_pool_grab(
+     libvshadow_thread_pool_t *thread_pool,
+     libcerror_error_t **error );
+
+int libvshadow_thread_pool_release(
+     libvshadow_thread_pool_t *thread_pool,
+     libcerror_error_t **error );
+
+int libvshadow_thread_pool_is_running_task(
+     libvshadow_thread_pool_t *thread_pool,
+     libcerror_error_t **error );
+
+int libvshadow_thread_pool_run(
+     libvshadow_thread_pool_t *thread_pool,
+     int (*callback_function)(
+            int task_index,
+            void *arguments ),
+     void *callback_function_arguments,
+     int number_of_tasks,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_THREAD_POOL_H ) */
+
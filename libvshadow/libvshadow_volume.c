@@ -25,16 +25,26 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libvshadow_block_timeline.h"
 #include "libvshadow_debug.h"
 #include "libvshadow_definitions.h"
+#include "libvshadow_histogram.h"
 #include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcnotify.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_physical_block_map.h"
+#include "libvshadow_statistics.h"
 #include "libvshadow_store.h"
+#include "libvshadow_store_block_reader.h"
 #include "libvshadow_store_descriptor.h"
+#include "libvshadow_thread_pool.h"
 #include "libvshadow_volume.h"
 
 /* Creates a volume
@@ -164,6 +174,8 @@ on_error:
 }
 
 /* Frees a volume
+ * Waits until the tasks that are being run on the thread pool of the volume have finished,
+ * hence the volume cannot be freed from one of these tasks
  * Returns 1 if successful or -1 on error
  */
 int libvshadow_volume_free(
@@ -189,6 +201,60 @@ int libvshadow_volume_free(
 	{
 		internal_volume = (libvshadow_internal_volume_t *) *volume;
 
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		/* The volume is left unchanged when freed from one of its tasks
+		 * since the task would wait for itself
+		 */
+		if( internal_volume->thread_pool != NULL )
+		{
+			result = libvshadow_thread_pool_is_running_task(
+			          internal_volume->thread_pool,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if calling thread is running a task.",
+				 function );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to free volume from a task of its thread pool.",
+				 function );
+
+				return( -1 );
+			}
+			result = 1;
+		}
+		/* The thread pool is freed first since tasks that are still
+		 * being run can use the volume
+		 */
+		if( internal_volume->thread_pool != NULL )
+		{
+			if( libvshadow_thread_pool_free(
+			     &( internal_volume->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( internal_volume->file_io_handle != NULL )
 		{
 			if( libvshadow_volume_close(
@@ -920,6 +986,38 @@ int libvshadow_volume_close(
 
 		result = -1;
 	}
+	if( internal_volume->block_timeline != NULL )
+	{
+		if( libvshadow_block_timeline_free(
+		     &( internal_volume->block_timeline ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block timeline.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->physical_block_map != NULL )
+	{
+		if( libvshadow_physical_block_map_free(
+		     &( internal_volume->physical_block_map ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free physical block map.",
+			 function );
+
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -990,6 +1088,8 @@ int libvshadow_volume_open_read(
 		return( -1 );
 	}
 #endif
+	internal_volume->io_handle->phase_timing_enabled = internal_volume->phase_timing_enabled;
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -1109,32 +1209,8 @@ int libvshadow_volume_open_read(
 			}
 			store_descriptor->index = store_descriptor_index;
 
-			if( store_descriptor->has_in_volume_store_data != 0 )
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "Reading VSS store: %02d:\n",
-					 store_descriptor->index );
-				}
-#endif
-				if( libvshadow_store_descriptor_read_store_header(
-				     store_descriptor,
-				     file_io_handle,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read store: %d header.",
-					 function,
-					 store_descriptor->index );
-
-					goto on_error;
-				}
-			}
+			/* The store header is read on demand
+			 */
 			store_descriptor->previous_store_descriptor = last_store_descriptor;
 
 			if( last_store_descriptor != NULL )
@@ -1179,16 +1255,38 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the size
- * Returns 1 if successful or -1 on error
+/* Refreshes the volume
+ * Re-reads the catalog and adds the stores that were created since the volume was opened
+ * or last refreshed, where the indexes of the existing stores are not changed
+ * Since the most recent store can change while the volume is in use its block descriptors
+ * are read again when next needed
+ * Returns 1 if successful, 0 if stores were removed or -1 on error
+ * When stores were removed the volume is left unchanged and needs to be reopened
  */
-int libvshadow_volume_get_size(
+int libvshadow_volume_refresh(
      libvshadow_volume_t *volume,
-     size64_t *size,
      libcerror_error_t **error )
 {
-	libvshadow_internal_volume_t *internal_volume = NULL;
-	static char *function                         = "libvshadow_volume_get_size";
+	libcdata_array_t *catalog_store_descriptors_array        = NULL;
+	libvshadow_block_timeline_t *block_timeline              = NULL;
+	libvshadow_internal_volume_t *internal_volume            = NULL;
+	libvshadow_physical_block_map_t *physical_block_map      = NULL;
+	libvshadow_store_descriptor_t *catalog_descriptor        = NULL;
+	libvshadow_store_descriptor_t *first_store_descriptor    = NULL;
+	libvshadow_store_descriptor_t *last_store_descriptor     = NULL;
+	libvshadow_store_descriptor_t *new_store_descriptor      = NULL;
+	libvshadow_store_descriptor_t *previous_store_descriptor = NULL;
+	libvshadow_store_descriptor_t *store_descriptor          = NULL;
+	static char *function                                    = "libvshadow_volume_refresh";
+	size64_t volume_size                                     = 0;
+	off64_t catalog_offset                                   = 0;
+	uint8_t last_store_descriptor_is_linked                  = 0;
+	int entry_index                                          = 0;
+	int number_of_appended_store_descriptors                 = 0;
+	int number_of_catalog_store_descriptors                  = 0;
+	int number_of_store_descriptors                          = 0;
+	int result                                               = 1;
+	int store_descriptor_index                               = 0;
 
 	if( volume == NULL )
 	{
@@ -1203,36 +1301,30 @@ int libvshadow_volume_get_size(
 	}
 	internal_volume = (libvshadow_internal_volume_t *) volume;
 
-	if( size == NULL )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*size = internal_volume->size;
-
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1240,58 +1332,67 @@ int libvshadow_volume_get_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
-}
-
-/* Retrieves the number of stores
- * Returns 1 if successful or -1 on error
- */
-int libvshadow_volume_get_number_of_stores(
-     libvshadow_volume_t *volume,
-     int *number_of_stores,
-     libcerror_error_t **error )
-{
-	libvshadow_internal_volume_t *internal_volume = NULL;
-	static char *function                         = "libvshadow_volume_get_number_of_stores";
-	int result                                    = 1;
-
-	if( volume == NULL )
+	if( libvshadow_io_handle_read_volume_header(
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     (off64_t) 0x1e00,
+	     &catalog_offset,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_volume = (libvshadow_internal_volume_t *) volume;
-
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
+	if( libcdata_array_initialize(
+	     &catalog_store_descriptors_array,
+	     0,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create catalog store descriptors array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	if( catalog_offset > 0 )
+	{
+		volume_size = internal_volume->size;
+
+		if( libvshadow_io_handle_read_catalog(
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     catalog_offset,
+		     &volume_size,
+		     catalog_store_descriptors_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read catalog.",
+			 function );
+
+			goto on_error;
+		}
 	}
-#endif
 	if( libcdata_array_get_number_of_entries(
 	     internal_volume->store_descriptors_array,
-	     number_of_stores,
+	     &number_of_store_descriptors,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1301,109 +1402,302 @@ int libvshadow_volume_get_number_of_stores(
 		 "%s: unable to retrieve number of store descriptors.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
+	if( libcdata_array_get_number_of_entries(
+	     catalog_store_descriptors_array,
+	     &number_of_catalog_store_descriptors,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of catalog store descriptors.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves a specific store
- * Returns 1 if successful or -1 on error
- */
-int libvshadow_volume_get_store(
-     libvshadow_volume_t *volume,
-     int store_index,
-     libvshadow_store_t **store,
-     libcerror_error_t **error )
-{
-	libvshadow_internal_volume_t *internal_volume = NULL;
-	static char *function                         = "libvshadow_volume_get_store";
-	int result                                    = 1;
-
-	if( volume == NULL )
+	if( number_of_catalog_store_descriptors < number_of_store_descriptors )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
-		 function );
-
-		return( -1 );
+		result = 0;
 	}
-	internal_volume = (libvshadow_internal_volume_t *) volume;
-
-	if( store == NULL )
+	/* Both arrays are sorted by creation time, hence the existing stores
+	 * are unchanged if they are the first stores in the catalog
+	 */
+	for( store_descriptor_index = 0;
+	     ( result == 1 ) && ( store_descriptor_index < number_of_store_descriptors );
+	     store_descriptor_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store.",
-		 function );
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
 
-		return( -1 );
-	}
-	if( *store != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid store value already set.",
-		 function );
+			goto on_error;
+		}
+		if( libcdata_array_get_entry_by_index(
+		     catalog_store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &catalog_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve catalog store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
 
-		return( -1 );
+			goto on_error;
+		}
+		if( ( store_descriptor == NULL )
+		 || ( catalog_descriptor == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     store_descriptor->identifier,
+		     catalog_descriptor->identifier,
+		     16 ) != 0 )
+		{
+			result = 0;
+		}
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( result == 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
+		/* The new store descriptors are appended and linked before the volume
+		 * is changed otherwise, so that they can be removed again on error
+		 */
+		if( number_of_store_descriptors > 0 )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_volume->store_descriptors_array,
+			     number_of_store_descriptors - 1,
+			     (intptr_t **) &last_store_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve store descriptor: %d.",
+				 function,
+				 number_of_store_descriptors - 1 );
 
-		return( -1 );
+				goto on_error;
+			}
+		}
+		previous_store_descriptor = last_store_descriptor;
+
+		for( store_descriptor_index = number_of_store_descriptors;
+		     store_descriptor_index < number_of_catalog_store_descriptors;
+		     store_descriptor_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     catalog_store_descriptors_array,
+			     store_descriptor_index,
+			     (intptr_t **) &store_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve catalog store descriptor: %d.",
+				 function,
+				 store_descriptor_index );
+
+				goto on_error;
+			}
+			if( libcdata_array_set_entry_by_index(
+			     catalog_store_descriptors_array,
+			     store_descriptor_index,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set catalog store descriptor: %d.",
+				 function,
+				 store_descriptor_index );
+
+				goto on_error;
+			}
+			new_store_descriptor = store_descriptor;
+
+			if( libcdata_array_append_entry(
+			     internal_volume->store_descriptors_array,
+			     &entry_index,
+			     (intptr_t *) store_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append store descriptor: %d.",
+				 function,
+				 store_descriptor_index );
+
+				goto on_error;
+			}
+			/* The store descriptor is now managed by the store descriptors array
+			 */
+			new_store_descriptor = NULL;
+
+			number_of_appended_store_descriptors++;
+
+			store_descriptor->index                     = entry_index;
+			store_descriptor->previous_store_descriptor = previous_store_descriptor;
+
+			if( previous_store_descriptor == last_store_descriptor )
+			{
+				first_store_descriptor = store_descriptor;
+			}
+			else if( libvshadow_store_descriptor_set_next_store_descriptor(
+			          previous_store_descriptor,
+			          store_descriptor,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set next store descriptor of store descriptor: %d.",
+				 function,
+				 previous_store_descriptor->index );
+
+				goto on_error;
+			}
+			previous_store_descriptor = store_descriptor;
+		}
+		if( last_store_descriptor != NULL )
+		{
+			if( first_store_descriptor != NULL )
+			{
+				if( libvshadow_store_descriptor_set_next_store_descriptor(
+				     last_store_descriptor,
+				     first_store_descriptor,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set next store descriptor of store descriptor: %d.",
+					 function,
+					 last_store_descriptor->index );
+
+					goto on_error;
+				}
+				last_store_descriptor_is_linked = 1;
+			}
+			/* The most recent store can have changed since its block descriptors were read
+			 */
+			if( libvshadow_store_descriptor_clear_block_descriptors(
+			     last_store_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to clear block descriptors of store descriptor: %d.",
+				 function,
+				 last_store_descriptor->index );
+
+				goto on_error;
+			}
+		}
+		/* The volume is changed from here on and is no longer restored on error
+		 */
+		number_of_appended_store_descriptors = 0;
+		last_store_descriptor_is_linked      = 0;
+
+		/* The block timeline and physical block map are rebuilt on demand,
+		 * to include the changes of the most recent and the new stores
+		 */
+		internal_volume->generation += 1;
+
+		block_timeline                      = internal_volume->block_timeline;
+		internal_volume->block_timeline     = NULL;
+		physical_block_map                  = internal_volume->physical_block_map;
+		internal_volume->physical_block_map = NULL;
+
+		if( internal_volume->size == 0 )
+		{
+			internal_volume->size = volume_size;
+		}
 	}
-#endif
-	if( libvshadow_store_initialize(
-	     store,
-	     internal_volume->file_io_handle,
-	     internal_volume->io_handle,
-	     internal_volume,
-	     store_index,
+	if( block_timeline != NULL )
+	{
+		if( libvshadow_block_timeline_free(
+		     &block_timeline,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block timeline.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( physical_block_map != NULL )
+	{
+		if( libvshadow_physical_block_map_free(
+		     &physical_block_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free physical block map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_free(
+	     &catalog_store_descriptors_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_store_descriptor_free,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create store: %d.",
-		 function,
-		 store_index );
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free catalog store descriptors array.",
+		 function );
 
-		result = -1;
+		goto on_error;
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1411,28 +1705,75 @@ int libvshadow_volume_get_store(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( result );
+
+on_error:
+	/* Remove the store descriptors that were appended to leave the volume unchanged
+	 */
+	if( last_store_descriptor_is_linked != 0 )
+	{
+		libvshadow_store_descriptor_set_next_store_descriptor(
+		 last_store_descriptor,
+		 NULL,
+		 NULL );
+	}
+	if( number_of_appended_store_descriptors > 0 )
+	{
+		libcdata_array_resize(
+		 internal_volume->store_descriptors_array,
+		 number_of_store_descriptors,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_store_descriptor_free,
+		 NULL );
+	}
+	if( new_store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &new_store_descriptor,
+		 NULL );
+	}
+	if( physical_block_map != NULL )
+	{
+		libvshadow_physical_block_map_free(
+		 &physical_block_map,
+		 NULL );
+	}
+	if( block_timeline != NULL )
+	{
+		libvshadow_block_timeline_free(
+		 &block_timeline,
+		 NULL );
+	}
+	if( catalog_store_descriptors_array != NULL )
+	{
+		libcdata_array_free(
+		 &catalog_store_descriptors_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_store_descriptor_free,
+		 NULL );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves a specific store identifier
+/* Retrieves the size
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_volume_get_store_identifier(
+int libvshadow_volume_get_size(
      libvshadow_volume_t *volume,
-     int store_index,
-     uint8_t *guid,
-     size_t size,
+     size64_t *size,
      libcerror_error_t **error )
 {
-	libvshadow_internal_volume_t *internal_volume   = NULL;
-	libvshadow_store_descriptor_t *store_descriptor = NULL;
-	static char *function                           = "libvshadow_volume_get_store_identifier";
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_size";
 
 	if( volume == NULL )
 	{
@@ -1447,6 +1788,17 @@ int libvshadow_volume_get_store_identifier(
 	}
 	internal_volume = (libvshadow_internal_volume_t *) volume;
 
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
@@ -1462,40 +1814,53 @@ int libvshadow_volume_get_store_identifier(
 		return( -1 );
 	}
 #endif
-	if( libcdata_array_get_entry_by_index(
-	     internal_volume->store_descriptors_array,
-	     store_index,
-	     (intptr_t **) &store_descriptor,
+	*size = internal_volume->size;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
-		 function,
-		 store_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libvshadow_store_descriptor_get_identifier(
-	     store_descriptor,
-	     guid,
-	     size,
-	     error ) != 1 )
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of stores
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_number_of_stores(
+     libvshadow_volume_t *volume,
+     int *number_of_stores,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_number_of_stores";
+	int result                                    = 1;
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve identifier from store descriptor: %d.",
-		 function,
-		 store_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1503,15 +1868,235 @@ int libvshadow_volume_get_store_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
 
-on_error:
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific store
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_store(
+     libvshadow_volume_t *volume,
+     int store_index,
+     libvshadow_store_t **store,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_store";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	if( *store != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid store value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_store_initialize(
+	     store,
+	     internal_volume->file_io_handle,
+	     internal_volume->io_handle,
+	     internal_volume,
+	     store_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create store: %d.",
+		 function,
+		 store_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific store identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_store_identifier(
+     libvshadow_volume_t *volume,
+     int store_index,
+     uint8_t *guid,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_volume_get_store_identifier";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_entry_by_index(
+	     internal_volume->store_descriptors_array,
+	     store_index,
+	     (intptr_t **) &store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptor: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+	if( libvshadow_store_descriptor_get_identifier(
+	     store_descriptor,
+	     guid,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier from store descriptor: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	libcthreads_read_write_lock_release_for_read(
 	 internal_volume->read_write_lock,
@@ -1520,3 +2105,3356 @@ on_error:
 	return( -1 );
 }
 
+/* Compares 2 store descriptors by the store header offset
+ * Returns a negative value, 0 or a positive value for use with qsort
+ */
+static int libvshadow_volume_compare_store_header_offsets(
+            const void *first_value,
+            const void *second_value )
+{
+	const libvshadow_store_descriptor_t *first_store_descriptor  = *( (libvshadow_store_descriptor_t * const *) first_value );
+	const libvshadow_store_descriptor_t *second_store_descriptor = *( (libvshadow_store_descriptor_t * const *) second_value );
+
+	if( first_store_descriptor->store_header_offset < second_store_descriptor->store_header_offset )
+	{
+		return( -1 );
+	}
+	else if( first_store_descriptor->store_header_offset > second_store_descriptor->store_header_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads the store headers of all the stores
+ * By default a store header is read the first time one of its values is retrieved
+ * This function reads all the store headers at once in order of their offset,
+ * where store headers that are near each other are read with a single read
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_read_store_headers(
+     libvshadow_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume       = NULL;
+	libvshadow_store_block_reader_t *store_block_reader = NULL;
+	libvshadow_store_descriptor_t **store_descriptors   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor     = NULL;
+	static char *function                               = "libvshadow_volume_read_store_headers";
+	size64_t read_ahead_size                            = 0;
+	int number_of_store_descriptors                     = 0;
+	int number_of_store_headers                         = 0;
+	int read_ahead_index                                = 0;
+	int store_descriptor_index                          = 0;
+	int store_header_index                              = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_store_descriptors > 0 )
+	{
+		if( (size_t) number_of_store_descriptors > (size_t) ( SSIZE_MAX / sizeof( libvshadow_store_descriptor_t * ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of store descriptors value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		store_descriptors = (libvshadow_store_descriptor_t **) memory_allocate(
+		                                                        sizeof( libvshadow_store_descriptor_t * ) * number_of_store_descriptors );
+
+		if( store_descriptors == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create store descriptors.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( store_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( store_descriptor->has_in_volume_store_data != 0 )
+		{
+			store_descriptors[ number_of_store_headers++ ] = store_descriptor;
+		}
+	}
+	if( number_of_store_headers > 0 )
+	{
+		qsort(
+		 store_descriptors,
+		 (size_t) number_of_store_headers,
+		 sizeof( libvshadow_store_descriptor_t * ),
+		 &libvshadow_volume_compare_store_header_offsets );
+
+		if( libvshadow_store_block_reader_initialize(
+		     &store_block_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create store block reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( store_header_index = 0;
+	     store_header_index < number_of_store_headers;
+	     store_header_index++ )
+	{
+		store_descriptor = store_descriptors[ store_header_index ];
+
+		/* Read ahead up to the last of the following store headers that fits in a single read
+		 */
+		read_ahead_size = LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE;
+
+		for( read_ahead_index = store_header_index + 1;
+		     read_ahead_index < number_of_store_headers;
+		     read_ahead_index++ )
+		{
+			if( (size64_t) ( store_descriptors[ read_ahead_index ]->store_header_offset - store_descriptor->store_header_offset ) >= ( (size64_t) LIBVSHADOW_STORE_BLOCK_READER_MAXIMUM_NUMBER_OF_BLOCKS * LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE ) )
+			{
+				break;
+			}
+			read_ahead_size = (size64_t) ( store_descriptors[ read_ahead_index ]->store_header_offset - store_descriptor->store_header_offset ) + LIBVSHADOW_STORE_BLOCK_READER_BLOCK_SIZE;
+		}
+		if( libvshadow_store_block_reader_set_read_ahead_size(
+		     store_block_reader,
+		     read_ahead_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set read ahead size.",
+			 function );
+
+			goto on_error;
+		}
+		/* This function will acquire the write lock of the store descriptor
+		 */
+		if( libvshadow_store_descriptor_read_store_header(
+		     store_descriptor,
+		     store_block_reader,
+		     internal_volume->file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read store: %d header.",
+			 function,
+			 store_descriptor->index );
+
+			goto on_error;
+		}
+	}
+	if( store_block_reader != NULL )
+	{
+		if( libvshadow_store_block_reader_free(
+		     &store_block_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store block reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( store_descriptors != NULL )
+	{
+		memory_free(
+		 store_descriptors );
+
+		store_descriptors = NULL;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( store_block_reader != NULL )
+	{
+		libvshadow_store_block_reader_free(
+		 &store_block_reader,
+		 NULL );
+	}
+	if( store_descriptors != NULL )
+	{
+		memory_free(
+		 store_descriptors );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the statistics
+ * The values are stored in the order of the LIBVSHADOW_STATISTICS_VALUE definitions
+ * The statistics are those of all the stores and the volume header and catalog reads
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_statistics(
+     libvshadow_volume_t *volume,
+     uint64_t *statistics_values,
+     int number_of_statistics_values,
+     libcerror_error_t **error )
+{
+	libvshadow_statistics_t statistics;
+	libvshadow_statistics_t store_statistics;
+
+	libvshadow_internal_volume_t *internal_volume   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_volume_get_statistics";
+	int number_of_store_descriptors                 = 0;
+	int store_descriptor_index                      = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( memory_copy(
+	     &statistics,
+	     &( internal_volume->io_handle->statistics ),
+	     sizeof( libvshadow_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy IO handle statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( libvshadow_store_descriptor_get_statistics(
+		     store_descriptor,
+		     &store_statistics,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics of store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( libvshadow_statistics_add(
+		     &statistics,
+		     &store_statistics,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add statistics of store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_statistics_get_values(
+	     &statistics,
+	     statistics_values,
+	     number_of_statistics_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics values.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Enables or disables the phase timing
+ * The phase timing measures the time spent reading the catalog, the store headers,
+ * parsing the store bitmaps and block lists, inserting and looking up block descriptors
+ * and reading from the file IO handle, and stores it in histograms per store.
+ * Set phase timing to a non-zero value to enable it before opening the volume
+ * to include the catalog read time
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_phase_timing(
+     libvshadow_volume_t *volume,
+     uint8_t phase_timing,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_volume_set_phase_timing";
+	int number_of_store_descriptors                 = 0;
+	int store_descriptor_index                      = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( phase_timing != 0 )
+	{
+		phase_timing = 1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->phase_timing_enabled            = phase_timing;
+	internal_volume->io_handle->phase_timing_enabled = phase_timing;
+
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		store_descriptor->phase_timing_enabled = phase_timing;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the phase timing of all stores
+ * The values are stored in the order of the LIBVSHADOW_TIMING_VALUE definitions,
+ * where the number of timing values should not exceed the size of timing values
+ * The times are in nano seconds
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_phase_timing(
+     libvshadow_volume_t *volume,
+     int phase,
+     uint64_t *timing_values,
+     int number_of_timing_values,
+     libcerror_error_t **error )
+{
+	libvshadow_histogram_t *histogram               = NULL;
+	libvshadow_internal_volume_t *internal_volume   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_volume_get_phase_timing";
+	int number_of_store_descriptors                 = 0;
+	int store_descriptor_index                      = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( phase < 0 )
+	 || ( phase >= LIBVSHADOW_NUMBER_OF_TIMING_PHASES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid phase value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_histogram_initialize(
+	     &histogram,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create histogram.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		libvshadow_histogram_free(
+		 &histogram,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( ( phase == LIBVSHADOW_TIMING_PHASE_CATALOG_READ )
+	 && ( internal_volume->io_handle->catalog_read_histogram != NULL ) )
+	{
+		if( libvshadow_histogram_add(
+		     histogram,
+		     internal_volume->io_handle->catalog_read_histogram,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add catalog read histogram.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( libvshadow_store_descriptor_get_phase_timing(
+		     store_descriptor,
+		     phase,
+		     histogram,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve phase timing of store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		libvshadow_histogram_free(
+		 &histogram,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_histogram_get_timing_values(
+	     histogram,
+	     timing_values,
+	     number_of_timing_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timing values.",
+		 function );
+
+		libvshadow_histogram_free(
+		 &histogram,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libvshadow_histogram_free(
+	     &histogram,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free histogram.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	libvshadow_histogram_free(
+	 &histogram,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Sets the index memory limit
+ * The index memory limit is the maximum estimated size of the memory used by
+ * the block descriptors of the stores. When exceeded the block descriptors of
+ * the least recently used stores are evicted and read again when next needed.
+ * The block descriptors of the most recently used store are never evicted
+ * Set the index memory limit to 0 to disable the limit
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_index_memory_limit(
+     libvshadow_volume_t *volume,
+     size64_t index_memory_limit,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_set_index_memory_limit";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->index_memory_limit = index_memory_limit;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_internal_volume_enforce_index_memory_limit(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to enforce index memory limit.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the index memory limit
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_index_memory_limit(
+     libvshadow_volume_t *volume,
+     size64_t *index_memory_limit,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_index_memory_limit";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( index_memory_limit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index memory limit.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*index_memory_limit = internal_volume->index_memory_limit;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of threads
+ * The volume runs long-running operations, such as reading the block descriptors
+ * of all the stores, on a thread pool with the maximum number of threads
+ * The thread pool can also be used by the application using libvshadow_volume_run_tasks
+ * Set the maximum number of threads to 0 to run all operations on the calling thread
+ * Waits until the tasks that are being run on the previous thread pool have finished,
+ * hence this function cannot be called from one of these tasks
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_maximum_number_of_threads(
+     libvshadow_volume_t *volume,
+     int maximum_number_of_threads,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_set_maximum_number_of_threads";
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libvshadow_thread_pool_t *previous_thread_pool = NULL;
+	libvshadow_thread_pool_t *thread_pool          = NULL;
+	int result                                     = 0;
+#endif
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( ( maximum_number_of_threads < 0 )
+	 || ( maximum_number_of_threads > LIBVSHADOW_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	/* The threads are started without the read/write lock being held
+	 */
+	if( maximum_number_of_threads > 0 )
+	{
+		if( libvshadow_thread_pool_initialize(
+		     &thread_pool,
+		     maximum_number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+	/* The previous thread pool is not replaced when called from one of its tasks
+	 * since the task would wait for itself
+	 */
+	if( internal_volume->thread_pool != NULL )
+	{
+		result = libvshadow_thread_pool_is_running_task(
+		          internal_volume->thread_pool,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if calling thread is running a task.",
+			 function );
+		}
+		else if( result != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of threads from a task of the thread pool.",
+			 function );
+		}
+		if( result != 0 )
+		{
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+#endif
+	internal_volume->maximum_number_of_threads = maximum_number_of_threads;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	previous_thread_pool         = internal_volume->thread_pool;
+	internal_volume->thread_pool = thread_pool;
+	thread_pool                  = NULL;
+
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+	/* The threads of the previous thread pool are joined without the read/write lock being held
+	 */
+	if( previous_thread_pool != NULL )
+	{
+		if( libvshadow_thread_pool_free(
+		     &previous_thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( 1 );
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+on_error:
+	if( thread_pool != NULL )
+	{
+		libvshadow_thread_pool_free(
+		 &thread_pool,
+		 NULL );
+	}
+	return( -1 );
+#endif
+}
+
+/* Retrieves the maximum number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_maximum_number_of_threads(
+     libvshadow_volume_t *volume,
+     int *maximum_number_of_threads,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_maximum_number_of_threads";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( maximum_number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*maximum_number_of_threads = internal_volume->maximum_number_of_threads;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Runs the callback function for the task indexes 0 to number of tasks - 1
+ * on the thread pool of the volume and returns after all tasks have finished
+ * Tasks can run in any order and concurrently, including on the calling thread
+ * If the volume has no thread pool the tasks are run in order on the calling thread
+ * The callback function should return 1 if successful or -1 on error
+ * A task can call this function to run more tasks without the risk of a deadlock
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_run_tasks(
+     libvshadow_volume_t *volume,
+     int (*callback_function)(
+            int task_index,
+            void *arguments ),
+     void *callback_function_arguments,
+     int number_of_tasks,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_run_tasks";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( libvshadow_internal_volume_run_tasks(
+	     internal_volume,
+	     callback_function,
+	     callback_function_arguments,
+	     number_of_tasks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run tasks.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of changed blocks
+ * A changed block is a block of the volume of which one or more stores
+ * contain a different version than the current volume
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_number_of_changed_blocks(
+     libvshadow_volume_t *volume,
+     int *number_of_changed_blocks,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_number_of_changed_blocks";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( number_of_changed_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of changed blocks.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block timeline is used while the read/write lock is held
+	 * so that it cannot be freed by a refresh
+	 */
+	if( libvshadow_internal_volume_grab_block_timeline(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block timeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_block_timeline_get_number_of_blocks(
+	     internal_volume->block_timeline,
+	     number_of_changed_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of blocks from block timeline.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific changed block
+ * The changed blocks are ordered by offset. The indexes of the stores that contain
+ * a different version of the block than the next store, or for the most recent store
+ * the current volume, are stored in ascending order. Store indexes can be NULL
+ * to only retrieve the number of changed stores
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_changed_block_by_index(
+     libvshadow_volume_t *volume,
+     int changed_block_index,
+     off64_t *offset,
+     int *store_indexes,
+     int number_of_store_indexes,
+     int *number_of_changed_stores,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_changed_block_by_index";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	/* The block timeline is used while the read/write lock is held
+	 * so that it cannot be freed by a refresh
+	 */
+	if( libvshadow_internal_volume_grab_block_timeline(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block timeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_block_timeline_get_block_offset_by_index(
+	     internal_volume->block_timeline,
+	     changed_block_index,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset of block: %d from block timeline.",
+		 function,
+		 changed_block_index );
+
+		result = -1;
+	}
+	else if( libvshadow_block_timeline_get_store_indexes(
+	          internal_volume->block_timeline,
+	          changed_block_index,
+	          store_indexes,
+	          number_of_store_indexes,
+	          number_of_changed_stores,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store indexes of block: %d from block timeline.",
+		 function,
+		 changed_block_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the indexes of the stores in which the block at a specific offset was changed
+ * These are the stores that contain a different version of the block than the next store
+ * or, for the most recent store, the current volume. The store indexes are stored
+ * in ascending order. Store indexes can be NULL to only retrieve the number of changed stores
+ * Returns 1 if successful, 0 if the block was not changed in any store or -1 on error
+ */
+int libvshadow_volume_get_changed_stores_at_offset(
+     libvshadow_volume_t *volume,
+     off64_t offset,
+     int *store_indexes,
+     int number_of_store_indexes,
+     int *number_of_changed_stores,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_changed_stores_at_offset";
+	int block_index                               = 0;
+	int result                                    = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( number_of_changed_stores == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of changed stores.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block timeline is used while the read/write lock is held
+	 * so that it cannot be freed by a refresh
+	 */
+	if( libvshadow_internal_volume_grab_block_timeline(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block timeline.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_block_timeline_get_block_index_at_offset(
+	          internal_volume->block_timeline,
+	          offset,
+	          &block_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block at offset: %" PRIi64 " (0x%08" PRIx64 ") from block timeline.",
+		 function,
+		 offset,
+		 offset );
+	}
+	else if( result == 0 )
+	{
+		*number_of_changed_stores = 0;
+	}
+	else if( libvshadow_block_timeline_get_store_indexes(
+	          internal_volume->block_timeline,
+	          block_index,
+	          store_indexes,
+	          number_of_store_indexes,
+	          number_of_changed_stores,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store indexes of block: %d from block timeline.",
+		 function,
+		 block_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of physical blocks
+ * A physical block is a 16 KiB block of store data in the volume
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_number_of_physical_blocks(
+     libvshadow_volume_t *volume,
+     int *number_of_physical_blocks,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_number_of_physical_blocks";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	/* The physical block map is used while the read/write lock is held
+	 * so that it cannot be freed by a refresh
+	 */
+	if( libvshadow_internal_volume_grab_physical_block_map(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_physical_block_map_get_number_of_blocks(
+	     internal_volume->physical_block_map,
+	     number_of_physical_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of blocks from physical block map.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific physical block
+ * The physical blocks are ordered by offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_physical_block_by_index(
+     libvshadow_volume_t *volume,
+     int physical_block_index,
+     off64_t *offset,
+     int *store_index,
+     off64_t *original_offset,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_physical_block_by_index";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	/* The physical block map is used while the read/write lock is held
+	 * so that it cannot be freed by a refresh
+	 */
+	if( libvshadow_internal_volume_grab_physical_block_map(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_physical_block_map_get_block_by_index(
+	     internal_volume->physical_block_map,
+	     physical_block_index,
+	     offset,
+	     store_index,
+	     original_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block: %d from physical block map.",
+		 function,
+		 physical_block_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the store and original offset of the data at a specific offset in the volume
+ * The original offset is the offset in the store that corresponds with the offset
+ * If multiple stores refer to the same physical block the one with the lowest index is retrieved
+ * Returns 1 if successful, 0 if the offset is not in a physical block or -1 on error
+ */
+int libvshadow_volume_get_physical_block_at_offset(
+     libvshadow_volume_t *volume,
+     off64_t offset,
+     int *store_index,
+     off64_t *original_offset,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_physical_block_at_offset";
+	off64_t block_offset                          = 0;
+	off64_t block_original_offset                 = 0;
+	int block_index                               = 0;
+	int result                                    = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( store_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store index.",
+		 function );
+
+		return( -1 );
+	}
+	if( original_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid original offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* The physical block map is used while the read/write lock is held
+	 * so that it cannot be freed by a refresh
+	 */
+	if( libvshadow_internal_volume_grab_physical_block_map(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_physical_block_map_get_block_index_at_offset(
+	          internal_volume->physical_block_map,
+	          offset,
+	          &block_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block at offset: %" PRIi64 " (0x%08" PRIx64 ") from physical block map.",
+		 function,
+		 offset,
+		 offset );
+	}
+	else if( result != 0 )
+	{
+		if( libvshadow_physical_block_map_get_block_by_index(
+		     internal_volume->physical_block_map,
+		     block_index,
+		     &block_offset,
+		     store_index,
+		     &block_original_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block: %d from physical block map.",
+			 function,
+			 block_index );
+
+			result = -1;
+		}
+		else
+		{
+			*original_offset = block_original_offset + ( offset - block_offset );
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the physical blocks that overlap with a specific range of the volume
+ * The physical blocks in the range are the number of physical blocks
+ * from the first physical block index, which can be retrieved by index
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_physical_blocks_in_range(
+     libvshadow_volume_t *volume,
+     off64_t offset,
+     size64_t size,
+     int *first_physical_block_index,
+     int *number_of_physical_blocks,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_physical_blocks_in_range";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	/* The physical block map is used while the read/write lock is held
+	 * so that it cannot be freed by a refresh
+	 */
+	if( libvshadow_internal_volume_grab_physical_block_map(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve physical block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_physical_block_map_get_block_indexes_in_range(
+	     internal_volume->physical_block_map,
+	     offset,
+	     size,
+	     first_physical_block_index,
+	     number_of_physical_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve blocks in range from physical block map.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Evicts the block descriptors of the least recently used stores until
+ * the estimated memory used by the block descriptors of all stores does
+ * not exceed the index memory limit
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_volume_enforce_index_memory_limit(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	libvshadow_store_descriptor_t *evict_store_descriptor = NULL;
+	libvshadow_store_descriptor_t *store_descriptor       = NULL;
+	static char *function                                 = "libvshadow_internal_volume_enforce_index_memory_limit";
+	size64_t memory_size                                  = 0;
+	size64_t total_memory_size                            = 0;
+	uint64_t evict_used_time                              = 0;
+	uint64_t used_time                                    = 0;
+	int number_of_read_store_descriptors                  = 0;
+	int number_of_store_descriptors                       = 0;
+	int result                                            = 0;
+	int store_descriptor_index                            = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->index_memory_limit == 0 )
+	{
+		goto on_exit;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		evict_store_descriptor           = NULL;
+		evict_used_time                  = 0;
+		number_of_read_store_descriptors = 0;
+		total_memory_size                = 0;
+
+		for( store_descriptor_index = 0;
+		     store_descriptor_index < number_of_store_descriptors;
+		     store_descriptor_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_volume->store_descriptors_array,
+			     store_descriptor_index,
+			     (intptr_t **) &store_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve store descriptor: %d.",
+				 function,
+				 store_descriptor_index );
+
+				goto on_error;
+			}
+			result = libvshadow_store_descriptor_get_block_descriptors_usage(
+			          store_descriptor,
+			          &memory_size,
+			          &used_time,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve block descriptors usage of store descriptor: %d.",
+				 function,
+				 store_descriptor_index );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				if( ( evict_store_descriptor == NULL )
+				 || ( used_time < evict_used_time ) )
+				{
+					evict_store_descriptor = store_descriptor;
+					evict_used_time        = used_time;
+				}
+				total_memory_size += memory_size;
+
+				number_of_read_store_descriptors++;
+			}
+		}
+		/* Keep the block descriptors of at least the most recently used store
+		 */
+		if( ( total_memory_size <= internal_volume->index_memory_limit )
+		 || ( number_of_read_store_descriptors < 2 ) )
+		{
+			break;
+		}
+		if( libvshadow_store_descriptor_evict_block_descriptors(
+		     evict_store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to evict block descriptors.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( number_of_read_store_descriptors > 1 );
+
+on_exit:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Runs the callback function for the task indexes 0 to number of tasks - 1
+ * on the thread pool of the volume or on the calling thread if the volume has none
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_volume_run_tasks(
+     libvshadow_internal_volume_t *internal_volume,
+     int (*callback_function)(
+            int task_index,
+            void *arguments ),
+     void *callback_function_arguments,
+     int number_of_tasks,
+     libcerror_error_t **error )
+{
+	static char *function                 = "libvshadow_internal_volume_run_tasks";
+	int result                            = 1;
+	int task_index                        = 0;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libvshadow_thread_pool_t *thread_pool = NULL;
+#endif
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_tasks < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of tasks value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	thread_pool = internal_volume->thread_pool;
+
+	/* The thread pool is grabbed while the read/write lock is held so that
+	 * it cannot be freed by libvshadow_volume_set_maximum_number_of_threads
+	 * or libvshadow_volume_free before it is released
+	 */
+	if( thread_pool != NULL )
+	{
+		if( libvshadow_thread_pool_grab(
+		     thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab thread pool.",
+			 function );
+
+			libcthreads_read_write_lock_release_for_read(
+			 internal_volume->read_write_lock,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+	/* The read/write lock is not held while the tasks run since the tasks
+	 * can call functions of the volume
+	 */
+	if( thread_pool != NULL )
+	{
+		if( libvshadow_thread_pool_run(
+		     thread_pool,
+		     callback_function,
+		     callback_function_arguments,
+		     number_of_tasks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run tasks on thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvshadow_thread_pool_release(
+		     thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release thread pool.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
+	/* All tasks are run even if one of them fails, like on the thread pool
+	 */
+	for( task_index = 0;
+	     task_index < number_of_tasks;
+	     task_index++ )
+	{
+		if( callback_function(
+		     task_index,
+		     callback_function_arguments ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run one or more tasks.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+on_error:
+	if( thread_pool != NULL )
+	{
+		libvshadow_thread_pool_release(
+		 thread_pool,
+		 NULL );
+	}
+	return( -1 );
+#endif
+}
+
+/* Retrieves a copy of the store descriptors array
+ * The store descriptors are not freed by a refresh, which only appends to the array,
+ * hence the copy can be used without holding the read/write lock.
+ * If multi-threading is enabled the read/write lock must be grabbed by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_volume_get_store_descriptors(
+     libvshadow_internal_volume_t *internal_volume,
+     libvshadow_store_descriptor_t ***store_descriptors,
+     int *number_of_store_descriptors,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvshadow_internal_volume_get_store_descriptors";
+	int store_descriptor_index = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( *store_descriptors != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid store descriptors value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_store_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of store descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( *number_of_store_descriptors < 0 )
+	 || ( (size_t) *number_of_store_descriptors > ( (size_t) SSIZE_MAX / sizeof( libvshadow_store_descriptor_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of store descriptors value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( *number_of_store_descriptors == 0 )
+	{
+		return( 1 );
+	}
+	*store_descriptors = (libvshadow_store_descriptor_t **) memory_allocate(
+	                                                         sizeof( libvshadow_store_descriptor_t * ) * *number_of_store_descriptors );
+
+	if( *store_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < *number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &( ( *store_descriptors )[ store_descriptor_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *store_descriptors != NULL )
+	{
+		memory_free(
+		 *store_descriptors );
+
+		*store_descriptors = NULL;
+	}
+	*number_of_store_descriptors = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the block offsets of a specific store
+ * This is the callback function of the tasks run by libvshadow_internal_volume_build_block_timeline
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_volume_get_store_block_offsets_task(
+     int store_descriptor_index,
+     libvshadow_internal_volume_block_offsets_task_arguments_t *task_arguments )
+{
+	libbfio_handle_t *file_io_handle                = NULL;
+	libcerror_error_t *error                        = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_internal_volume_get_store_block_offsets_task";
+
+	if( task_arguments == NULL )
+	{
+		return( -1 );
+	}
+	store_descriptor = task_arguments->store_descriptors[ store_descriptor_index ];
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing store descriptor: %d.",
+		 function,
+		 store_descriptor_index );
+
+		goto on_error;
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		return( 1 );
+	}
+	/* Tasks that run concurrently cannot share the current offset of the file IO handle
+	 */
+	if( task_arguments->use_file_io_handle_clone == 0 )
+	{
+		file_io_handle = task_arguments->internal_volume->file_io_handle;
+	}
+	else
+	{
+		if( libbfio_handle_clone(
+		     &file_io_handle,
+		     task_arguments->internal_volume->file_io_handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvshadow_store_descriptor_get_block_offsets(
+	     store_descriptor,
+	     file_io_handle,
+	     &( task_arguments->store_block_offsets[ store_descriptor_index ] ),
+	     &( task_arguments->store_number_of_block_offsets[ store_descriptor_index ] ),
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block offsets of store descriptor: %d.",
+		 function,
+		 store_descriptor_index );
+
+		goto on_error;
+	}
+	if( task_arguments->use_file_io_handle_clone != 0 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     &error ) != 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_free(
+		     &file_io_handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvshadow_internal_volume_enforce_index_memory_limit(
+	     task_arguments->internal_volume,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to enforce index memory limit.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	if( ( task_arguments->use_file_io_handle_clone != 0 )
+	 && ( file_io_handle != NULL ) )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Builds the block timeline of the stores if not already built
+ * The block offsets of the stores are read by tasks on the thread pool of the volume,
+ * one task per store, and the index memory limit is enforced after every store.
+ * Note that with a thread pool the block descriptors of up to one store per thread
+ * can be read at the same time
+ * The block timeline is discarded instead of stored when the volume was refreshed
+ * while it was being built, use libvshadow_internal_volume_grab_block_timeline
+ * to retrieve a block timeline that cannot be freed while it is used
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_volume_build_block_timeline(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_block_offsets_task_arguments_t task_arguments;
+
+	libvshadow_block_timeline_t *block_timeline       = NULL;
+	libvshadow_store_descriptor_t **store_descriptors = NULL;
+	off64_t **store_block_offsets                     = NULL;
+	static char *function                             = "libvshadow_internal_volume_build_block_timeline";
+	int *store_number_of_block_offsets                = NULL;
+	uint32_t generation                               = 0;
+	int number_of_store_descriptors                   = 0;
+	int result                                        = 0;
+	int store_descriptor_index                        = 0;
+	uint8_t use_file_io_handle_clone                  = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( internal_volume->thread_pool != NULL )
+	{
+		use_file_io_handle_clone = 1;
+	}
+#endif
+	generation = internal_volume->generation;
+
+	if( internal_volume->block_timeline != NULL )
+	{
+		result = 1;
+	}
+	else if( libvshadow_internal_volume_get_store_descriptors(
+	          internal_volume,
+	          &store_descriptors,
+	          &number_of_store_descriptors,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptors.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result != 0 )
+	{
+		return( result );
+	}
+	if( (size_t) number_of_store_descriptors > ( (size_t) SSIZE_MAX / sizeof( off64_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of store descriptors value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_store_descriptors > 0 )
+	{
+		store_block_offsets = (off64_t **) memory_allocate(
+		                                    sizeof( off64_t * ) * number_of_store_descriptors );
+
+		if( store_block_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create store block offsets.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     store_block_offsets,
+		     0,
+		     sizeof( off64_t * ) * number_of_store_descriptors ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear store block offsets.",
+			 function );
+
+			memory_free(
+			 store_block_offsets );
+
+			store_block_offsets = NULL;
+
+			goto on_error;
+		}
+		store_number_of_block_offsets = (int *) memory_allocate(
+		                                         sizeof( int ) * number_of_store_descriptors );
+
+		if( store_number_of_block_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create store number of block offsets.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     store_number_of_block_offsets,
+		     0,
+		     sizeof( int ) * number_of_store_descriptors ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear store number of block offsets.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	task_arguments.internal_volume               = internal_volume;
+	task_arguments.store_descriptors             = store_descriptors;
+	task_arguments.store_block_offsets           = store_block_offsets;
+	task_arguments.store_number_of_block_offsets = store_number_of_block_offsets;
+	task_arguments.use_file_io_handle_clone      = use_file_io_handle_clone;
+
+	if( libvshadow_internal_volume_run_tasks(
+	     internal_volume,
+	     (int (*)(int, void *)) &libvshadow_internal_volume_get_store_block_offsets_task,
+	     (void *) &task_arguments,
+	     number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block offsets of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_block_timeline_initialize(
+	     &block_timeline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block timeline.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_block_timeline_build(
+	     block_timeline,
+	     store_block_offsets,
+	     store_number_of_block_offsets,
+	     number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build block timeline.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( store_block_offsets[ store_descriptor_index ] != NULL )
+		{
+			memory_free(
+			 store_block_offsets[ store_descriptor_index ] );
+		}
+	}
+	if( store_number_of_block_offsets != NULL )
+	{
+		memory_free(
+		 store_number_of_block_offsets );
+
+		store_number_of_block_offsets = NULL;
+	}
+	if( store_block_offsets != NULL )
+	{
+		memory_free(
+		 store_block_offsets );
+
+		store_block_offsets = NULL;
+	}
+	if( store_descriptors != NULL )
+	{
+		memory_free(
+		 store_descriptors );
+
+		store_descriptors = NULL;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* Another thread could have built the block timeline in the meantime
+	 * or the volume could have been refreshed, in which case the block timeline
+	 * lacks the changes of the most recent and the new stores
+	 */
+	if( ( internal_volume->block_timeline == NULL )
+	 && ( internal_volume->generation == generation ) )
+	{
+		internal_volume->block_timeline = block_timeline;
+		block_timeline                  = NULL;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( block_timeline != NULL )
+	{
+		if( libvshadow_block_timeline_free(
+		     &block_timeline,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block timeline.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( block_timeline != NULL )
+	{
+		libvshadow_block_timeline_free(
+		 &block_timeline,
+		 NULL );
+	}
+	if( store_block_offsets != NULL )
+	{
+		for( store_descriptor_index = 0;
+		     store_descriptor_index < number_of_store_descriptors;
+		     store_descriptor_index++ )
+		{
+			if( store_block_offsets[ store_descriptor_index ] != NULL )
+			{
+				memory_free(
+				 store_block_offsets[ store_descriptor_index ] );
+			}
+		}
+		memory_free(
+		 store_block_offsets );
+	}
+	if( store_number_of_block_offsets != NULL )
+	{
+		memory_free(
+		 store_number_of_block_offsets );
+	}
+	if( store_descriptors != NULL )
+	{
+		memory_free(
+		 store_descriptors );
+	}
+	return( -1 );
+}
+
+/* Builds the block timeline if needed and grabs the read/write lock for reading
+ * Holding the read/write lock prevents a refresh from freeing the block timeline
+ * while it is used, the caller must release the read/write lock for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_volume_grab_block_timeline(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_internal_volume_grab_block_timeline";
+	int result            = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block timeline is built again when the volume was refreshed
+	 * before the read/write lock was grabbed
+	 */
+	while( result == 0 )
+	{
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( internal_volume->block_timeline != NULL )
+		{
+			result = 1;
+		}
+		else
+		{
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+			if( libcthreads_read_write_lock_release_for_read(
+			     internal_volume->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release read/write lock for reading.",
+				 function );
+
+				return( -1 );
+			}
+#endif
+			if( libvshadow_internal_volume_build_block_timeline(
+			     internal_volume,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to build block timeline.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( result );
+}
+
+/* Builds the physical block map of the stores if not already built
+ * The blocks of every store are read one store at a time,
+ * hence the index memory limit is enforced in between stores
+ * The physical block map is discarded instead of stored when the volume was refreshed
+ * while it was being built, use libvshadow_internal_volume_grab_physical_block_map
+ * to retrieve a physical block map that cannot be freed while it is used
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_volume_build_physical_block_map(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	libvshadow_physical_block_map_t *physical_block_map = NULL;
+	libvshadow_store_descriptor_t **store_descriptors   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor     = NULL;
+	static char *function                               = "libvshadow_internal_volume_build_physical_block_map";
+	uint32_t generation                                 = 0;
+	int number_of_store_descriptors                     = 0;
+	int result                                          = 0;
+	int store_descriptor_index                          = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	generation = internal_volume->generation;
+
+	if( internal_volume->physical_block_map != NULL )
+	{
+		result = 1;
+	}
+	else if( libvshadow_internal_volume_get_store_descriptors(
+	          internal_volume,
+	          &store_descriptors,
+	          &number_of_store_descriptors,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptors.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result != 0 )
+	{
+		return( result );
+	}
+	if( libvshadow_physical_block_map_initialize(
+	     &physical_block_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create physical block map.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		store_descriptor = store_descriptors[ store_descriptor_index ];
+
+		if( store_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( store_descriptor->has_in_volume_store_data == 0 )
+		{
+			continue;
+		}
+		if( libvshadow_store_descriptor_append_physical_blocks(
+		     store_descriptor,
+		     internal_volume->file_io_handle,
+		     physical_block_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append physical blocks of store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( libvshadow_internal_volume_enforce_index_memory_limit(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to enforce index memory limit.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvshadow_physical_block_map_sort(
+	     physical_block_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to sort physical block map.",
+		 function );
+
+		goto on_error;
+	}
+	if( store_descriptors != NULL )
+	{
+		memory_free(
+		 store_descriptors );
+
+		store_descriptors = NULL;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* Another thread could have built the physical block map in the meantime
+	 * or the volume could have been refreshed, in which case the physical block map
+	 * lacks the blocks of the most recent and the new stores
+	 */
+	if( ( internal_volume->physical_block_map == NULL )
+	 && ( internal_volume->generation == generation ) )
+	{
+		internal_volume->physical_block_map = physical_block_map;
+		physical_block_map                  = NULL;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( physical_block_map != NULL )
+	{
+		if( libvshadow_physical_block_map_free(
+		     &physical_block_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free physical block map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( physical_block_map != NULL )
+	{
+		libvshadow_physical_block_map_free(
+		 &physical_block_map,
+		 NULL );
+	}
+	if( store_descriptors != NULL )
+	{
+		memory_free(
+		 store_descriptors );
+	}
+	return( -1 );
+}
+
+/* Builds the physical block map if needed and grabs the read/write lock for reading
+ * Holding the read/write lock prevents a refresh from freeing the physical block map
+ * while it is used, the caller must release the read/write lock for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_volume_grab_physical_block_map(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_internal_volume_grab_physical_block_map";
+	int result            = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	/* The physical block map is built again when the volume was refreshed
+	 * before the read/write lock was grabbed
+	 */
+	while( result == 0 )
+	{
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( internal_volume->physical_block_map != NULL )
+		{
+			result = 1;
+		}
+		else
+		{
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+			if( libcthreads_read_write_lock_release_for_read(
+			     internal_volume->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release read/write lock for reading.",
+				 function );
+
+				return( -1 );
+			}
+#endif
+			if( libvshadow_internal_volume_build_physical_block_map(
+			     internal_volume,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to build physical block map.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( result );
+}
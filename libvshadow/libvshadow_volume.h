@@ -25,12 +25,16 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvshadow_block_timeline.h"
 #include "libvshadow_extern.h"
 #include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_physical_block_map.h"
+#include "libvshadow_store_descriptor.h"
+#include "libvshadow_thread_pool.h"
 #include "libvshadow_types.h"
 
 #if defined( __cplusplus )
@@ -65,13 +69,73 @@ struct libvshadow_internal_volume
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* Value to indicate the phase timing is enabled
+	 */
+	uint8_t phase_timing_enabled;
+
+	/* The maximum estimated size of the memory used by the block descriptors of the stores
+	 * 0 represents no limit
+	 */
+	size64_t index_memory_limit;
+
+	/* The block timeline, built on demand
+	 */
+	libvshadow_block_timeline_t *block_timeline;
+
+	/* The physical block map, built on demand
+	 */
+	libvshadow_physical_block_map_t *physical_block_map;
+
+	/* The generation, incremented every time the volume is refreshed
+	 * a block timeline or physical block map that was built from the stores
+	 * of a previous generation is discarded
+	 */
+	uint32_t generation;
+
+	/* The maximum number of threads of the thread pool
+	 * 0 represents no thread pool
+	 */
+	int maximum_number_of_threads;
+
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libvshadow_thread_pool_t *thread_pool;
+
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
 #endif
 };
 
+typedef struct libvshadow_internal_volume_block_offsets_task_arguments libvshadow_internal_volume_block_offsets_task_arguments_t;
+
+/* The arguments of the tasks that retrieve the block offsets of the stores
+ */
+struct libvshadow_internal_volume_block_offsets_task_arguments
+{
+	/* The internal volume
+	 */
+	libvshadow_internal_volume_t *internal_volume;
+
+	/* The store descriptors, copied from the store descriptors array since
+	 * a refresh can append to the array while the tasks run
+	 */
+	libvshadow_store_descriptor_t **store_descriptors;
+
+	/* The block offsets per store
+	 */
+	off64_t **store_block_offsets;
+
+	/* The number of block offsets per store
+	 */
+	int *store_number_of_block_offsets;
+
+	/* Value to indicate every task should use its own clone of the file IO handle
+	 */
+	uint8_t use_file_io_handle_clone;
+};
+
 LIBVSHADOW_EXTERN \
 int libvshadow_volume_initialize(
      libvshadow_volume_t **volume,
@@ -122,6 +186,11 @@ int libvshadow_volume_open_read(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_refresh(
+     libvshadow_volume_t *volume,
+     libcerror_error_t **error );
+
 LIBVSHADOW_EXTERN \
 int libvshadow_volume_get_size(
      libvshadow_volume_t *volume,
@@ -149,6 +218,162 @@ int libvshadow_volume_get_store_identifier(
      size_t size,
      libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_read_store_headers(
+     libvshadow_volume_t *volume,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_statistics(
+     libvshadow_volume_t *volume,
+     uint64_t *statistics_values,
+     int number_of_statistics_values,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_set_phase_timing(
+     libvshadow_volume_t *volume,
+     uint8_t phase_timing,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_phase_timing(
+     libvshadow_volume_t *volume,
+     int phase,
+     uint64_t *timing_values,
+     int number_of_timing_values,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_set_index_memory_limit(
+     libvshadow_volume_t *volume,
+     size64_t index_memory_limit,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_index_memory_limit(
+     libvshadow_volume_t *volume,
+     size64_t *index_memory_limit,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_set_maximum_number_of_threads(
+     libvshadow_volume_t *volume,
+     int maximum_number_of_threads,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_maximum_number_of_threads(
+     libvshadow_volume_t *volume,
+     int *maximum_number_of_threads,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_run_tasks(
+     libvshadow_volume_t *volume,
+     int (*callback_function)(
+            int task_index,
+            void *arguments ),
+     void *callback_function_arguments,
+     int number_of_tasks,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_number_of_changed_blocks(
+     libvshadow_volume_t *volume,
+     int *number_of_changed_blocks,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_changed_block_by_index(
+     libvshadow_volume_t *volume,
+     int changed_block_index,
+     off64_t *offset,
+     int *store_indexes,
+     int number_of_store_indexes,
+     int *number_of_changed_stores,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_changed_stores_at_offset(
+     libvshadow_volume_t *volume,
+     off64_t offset,
+     int *store_indexes,
+     int number_of_store_indexes,
+     int *number_of_changed_stores,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_number_of_physical_blocks(
+     libvshadow_volume_t *volume,
+     int *number_of_physical_blocks,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_physical_block_by_index(
+     libvshadow_volume_t *volume,
+     int physical_block_index,
+     off64_t *offset,
+     int *store_index,
+     off64_t *original_offset,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_physical_block_at_offset(
+     libvshadow_volume_t *volume,
+     off64_t offset,
+     int *store_index,
+     off64_t *original_offset,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_physical_blocks_in_range(
+     libvshadow_volume_t *volume,
+     off64_t offset,
+     size64_t size,
+     int *first_physical_block_index,
+     int *number_of_physical_blocks,
+     libcerror_error_t **error );
+
+int libvshadow_internal_volume_enforce_index_memory_limit(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libvshadow_internal_volume_run_tasks(
+     libvshadow_internal_volume_t *internal_volume,
+     int (*callback_function)(
+            int task_index,
+            void *arguments ),
+     void *callback_function_arguments,
+     int number_of_tasks,
+     libcerror_error_t **error );
+
+int libvshadow_internal_volume_get_store_descriptors(
+     libvshadow_internal_volume_t *internal_volume,
+     libvshadow_store_descriptor_t ***store_descriptors,
+     int *number_of_store_descriptors,
+     libcerror_error_t **error );
+
+int libvshadow_internal_volume_get_store_block_offsets_task(
+     int store_descriptor_index,
+     libvshadow_internal_volume_block_offsets_task_arguments_t *task_arguments );
+
+int libvshadow_internal_volume_build_block_timeline(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libvshadow_internal_volume_grab_block_timeline(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libvshadow_internal_volume_build_physical_block_map(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libvshadow_internal_volume_grab_physical_block_map(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
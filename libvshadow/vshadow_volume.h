@@ -216,6 +216,183 @@ struct vshadow_ntfs_volume_header
 	uint8_t sector_signature[ 2 ];
 };
 
+typedef struct vshadow_ntfs_mft_entry_header vshadow_ntfs_mft_entry_header_t;
+
+struct vshadow_ntfs_mft_entry_header
+{
+	/* The signature
+	 * Consists of 4 bytes
+	 * Contains: FILE
+	 */
+	uint8_t signature[ 4 ];
+
+	/* The fix-up values offset
+	 * Consists of 2 bytes
+	 */
+	uint8_t fixup_values_offset[ 2 ];
+
+	/* The number of fix-up values
+	 * Consists of 2 bytes
+	 */
+	uint8_t number_of_fixup_values[ 2 ];
+
+	/* The journal sequence number
+	 * Consists of 8 bytes
+	 */
+	uint8_t journal_sequence_number[ 8 ];
+
+	/* The sequence
+	 * Consists of 2 bytes
+	 */
+	uint8_t sequence[ 2 ];
+
+	/* The reference count
+	 * Consists of 2 bytes
+	 */
+	uint8_t reference_count[ 2 ];
+
+	/* The attributes offset
+	 * Consists of 2 bytes
+	 */
+	uint8_t attributes_offset[ 2 ];
+
+	/* The flags
+	 * Consists of 2 bytes
+	 */
+	uint8_t flags[ 2 ];
+
+	/* The used entry size
+	 * Consists of 4 bytes
+	 */
+	uint8_t used_entry_size[ 4 ];
+
+	/* The total entry size
+	 * Consists of 4 bytes
+	 */
+	uint8_t total_entry_size[ 4 ];
+
+	/* The base record file reference
+	 * Consists of 8 bytes
+	 */
+	uint8_t base_record_file_reference[ 8 ];
+
+	/* The first available attribute identifier
+	 * Consists of 2 bytes
+	 */
+	uint8_t first_available_attribute_identifier[ 2 ];
+};
+
+typedef struct vshadow_ntfs_mft_attribute_header vshadow_ntfs_mft_attribute_header_t;
+
+struct vshadow_ntfs_mft_attribute_header
+{
+	/* The type
+	 * Consists of 4 bytes
+	 */
+	uint8_t type[ 4 ];
+
+	/* The size
+	 * Consists of 4 bytes
+	 */
+	uint8_t size[ 4 ];
+
+	/* The non-resident flag
+	 * Consists of 1 byte
+	 */
+	uint8_t non_resident_flag;
+
+	/* The name size
+	 * Consists of 1 byte
+	 * Contains the number of characters
+	 */
+	uint8_t name_size;
+
+	/* The name offset
+	 * Consists of 2 bytes
+	 */
+	uint8_t name_offset[ 2 ];
+
+	/* The data flags
+	 * Consists of 2 bytes
+	 */
+	uint8_t data_flags[ 2 ];
+
+	/* The identifier
+	 * Consists of 2 bytes
+	 */
+	uint8_t identifier[ 2 ];
+};
+
+typedef struct vshadow_ntfs_mft_attribute_resident vshadow_ntfs_mft_attribute_resident_t;
+
+struct vshadow_ntfs_mft_attribute_resident
+{
+	/* The data size
+	 * Consists of 4 bytes
+	 */
+	uint8_t data_size[ 4 ];
+
+	/* The data offset
+	 * Consists of 2 bytes
+	 */
+	uint8_t data_offset[ 2 ];
+
+	/* The indexed flag
+	 * Consists of 1 byte
+	 */
+	uint8_t indexed_flag;
+
+	/* Padding
+	 * Consists of 1 byte
+	 */
+	uint8_t padding;
+};
+
+typedef struct vshadow_ntfs_mft_attribute_non_resident vshadow_ntfs_mft_attribute_non_resident_t;
+
+struct vshadow_ntfs_mft_attribute_non_resident
+{
+	/* The data first VCN
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_first_vcn[ 8 ];
+
+	/* The data last VCN
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_last_vcn[ 8 ];
+
+	/* The data runs offset
+	 * Consists of 2 bytes
+	 */
+	uint8_t data_runs_offset[ 2 ];
+
+	/* The compression unit size
+	 * Consists of 2 bytes
+	 */
+	uint8_t compression_unit_size[ 2 ];
+
+	/* Padding
+	 * Consists of 4 bytes
+	 */
+	uint8_t padding[ 4 ];
+
+	/* The allocated data size
+	 * Consists of 8 bytes
+	 */
+	uint8_t allocated_data_size[ 8 ];
+
+	/* The data size
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_size[ 8 ];
+
+	/* The valid data size
+	 * Consists of 8 bytes
+	 */
+	uint8_t valid_data_size[ 8 ];
+};
+
 #if defined( __cplusplus )
 }
 #endif
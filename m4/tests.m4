@@ -1,12 +1,12 @@
 dnl Functions for testing
 dnl
-dnl Version: 20161212
+dnl Version: 20171018
 
 dnl Function to detect if tests dependencies are available
 AC_DEFUN([AX_TESTS_CHECK_LOCAL],
-  [AC_CHECK_HEADERS([dlfcn.h])
+  [AC_CHECK_HEADERS([dlfcn.h sys/resource.h sys/time.h])
 
-  AC_CHECK_FUNCS([fmemopen getopt])
+  AC_CHECK_FUNCS([fmemopen getopt getrusage gettimeofday])
 
   AC_CHECK_LIB(
     dl,
@@ -23,6 +23,14 @@
 #include <memory.h>
 #include <types.h>
 
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "pyvshadow_error.h"
 #include "pyvshadow_file_object_io_handle.h"
 #include "pyvshadow_integer.h"
@@ -102,7 +110,8 @@ int pyvshadow_file_object_io_handle_initialize(
 
 		goto on_error;
 	}
-	( *file_object_io_handle )->file_object = file_object;
+	( *file_object_io_handle )->file_object     = file_object;
+	( *file_object_io_handle )->file_descriptor = -1;
 
 	Py_IncRef(
 	 ( *file_object_io_handle )->file_object );
@@ -130,6 +139,7 @@ int pyvshadow_file_object_initialize(
 {
 	pyvshadow_file_object_io_handle_t *file_object_io_handle = NULL;
 	static char *function                                    = "pyvshadow_file_object_initialize";
+	int result                                               = 0;
 
 	if( handle == NULL )
 	{
@@ -167,6 +177,34 @@ int pyvshadow_file_object_initialize(
 
 		goto on_error;
 	}
+	/* Read directly from the file descriptor if the file object has one,
+	 * otherwise prefer the readinto method over the read method
+	 */
+	if( pyvshadow_file_object_get_file_descriptor(
+	     file_object,
+	     &( file_object_io_handle->file_descriptor ),
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file descriptor of file object.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_object_io_handle->file_descriptor == -1 )
+	{
+		result = PyObject_HasAttrString(
+		          file_object,
+		          "readinto" );
+
+		if( result != 0 )
+		{
+			file_object_io_handle->has_readinto = 1;
+		}
+	}
 	if( libbfio_handle_initialize(
 	     handle,
 	     (intptr_t *) file_object_io_handle,
@@ -204,6 +242,195 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the file descriptor of the file object
+ * Only file objects that are backed by an operating system file and support
+ * positional reads are supported, such as io.FileIO or a buffered object that wraps io.FileIO
+ * Make sure to hold the GIL state before calling this function
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int pyvshadow_file_object_get_file_descriptor(
+     PyObject *file_object,
+     int *file_descriptor,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_PREAD )
+	PyObject *file_io_type    = NULL;
+	PyObject *io_module       = NULL;
+	PyObject *method_name     = NULL;
+	PyObject *method_result   = NULL;
+	PyObject *raw_file_object = NULL;
+	long safe_file_descriptor = -1;
+	int result                = 0;
+#endif
+	static char *function     = "pyvshadow_file_object_get_file_descriptor";
+
+	if( file_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*file_descriptor = -1;
+
+#if defined( HAVE_PREAD )
+#if PY_MAJOR_VERSION < 3
+	if( PyFile_Check(
+	     file_object ) != 0 )
+	{
+		safe_file_descriptor = (long) fileno(
+		                               PyFile_AsFile(
+		                                file_object ) );
+
+		result = 1;
+	}
+	else
+#endif
+	{
+		/* Any failure here means the file object is read using its methods
+		 */
+		io_module = PyImport_ImportModule(
+		             "io" );
+
+		if( io_module != NULL )
+		{
+			file_io_type = PyObject_GetAttrString(
+			                io_module,
+			                "FileIO" );
+		}
+		if( file_io_type != NULL )
+		{
+			result = PyObject_IsInstance(
+			          file_object,
+			          file_io_type );
+
+			if( result == 1 )
+			{
+				raw_file_object = file_object;
+
+				Py_IncRef(
+				 raw_file_object );
+			}
+			else if( result == 0 )
+			{
+				/* Buffered objects, like io.BufferedReader, expose the underlying raw object
+				 */
+				result = PyObject_HasAttrString(
+				          file_object,
+				          "raw" );
+
+				if( result == 1 )
+				{
+					raw_file_object = PyObject_GetAttrString(
+					                   file_object,
+					                   "raw" );
+				}
+				if( raw_file_object != NULL )
+				{
+					result = PyObject_IsInstance(
+					          raw_file_object,
+					          file_io_type );
+				}
+				else
+				{
+					result = 0;
+				}
+			}
+		}
+		if( result == 1 )
+		{
+#if PY_MAJOR_VERSION >= 3
+			method_name = PyUnicode_FromString(
+			               "fileno" );
+#else
+			method_name = PyString_FromString(
+			               "fileno" );
+#endif
+			method_result = PyObject_CallMethodObjArgs(
+			                 raw_file_object,
+			                 method_name,
+			                 NULL );
+
+			if( method_result == NULL )
+			{
+				result = 0;
+			}
+			else
+			{
+				safe_file_descriptor = PyLong_AsLong(
+				                        method_result );
+
+				if( PyErr_Occurred() )
+				{
+					result = 0;
+				}
+			}
+		}
+		if( method_result != NULL )
+		{
+			Py_DecRef(
+			 method_result );
+		}
+		if( method_name != NULL )
+		{
+			Py_DecRef(
+			 method_name );
+		}
+		if( raw_file_object != NULL )
+		{
+			Py_DecRef(
+			 raw_file_object );
+		}
+		if( file_io_type != NULL )
+		{
+			Py_DecRef(
+			 file_io_type );
+		}
+		if( io_module != NULL )
+		{
+			Py_DecRef(
+			 io_module );
+		}
+		PyErr_Clear();
+	}
+	if( ( result != 1 )
+	 || ( safe_file_descriptor < 0 )
+	 || ( safe_file_descriptor > (long) INT_MAX ) )
+	{
+		return( 0 );
+	}
+	/* Pipes and sockets do not support positional reads
+	 */
+	if( lseek(
+	     (int) safe_file_descriptor,
+	     0,
+	     SEEK_CUR ) == -1 )
+	{
+		return( 0 );
+	}
+	*file_descriptor = (int) safe_file_descriptor;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_PREAD ) */
+}
+
 /* Frees a file object IO handle
  * Returns 1 if succesful or -1 on error
  */
@@ -229,6 +456,11 @@ int pyvshadow_file_object_io_handle_free(
 	{
 		gil_state = PyGILState_Ensure();
 
+		if( ( *file_object_io_handle )->read_buffer_object != NULL )
+		{
+			Py_DecRef(
+			 ( *file_object_io_handle )->read_buffer_object );
+		}
 		Py_DecRef(
 		 ( *file_object_io_handle )->file_object );
 
@@ -306,6 +538,13 @@ int pyvshadow_file_object_io_handle_clone(
 
 		return( -1 );
 	}
+	/* The clone reads from the same file descriptor but maintains its own offset
+	 */
+	( *destination_file_object_io_handle )->file_descriptor = source_file_object_io_handle->file_descriptor;
+	( *destination_file_object_io_handle )->size            = source_file_object_io_handle->size;
+	( *destination_file_object_io_handle )->size_is_set     = source_file_object_io_handle->size_is_set;
+	( *destination_file_object_io_handle )->has_readinto    = source_file_object_io_handle->has_readinto;
+
 	return( 1 );
 }
 
@@ -613,6 +852,326 @@ on_error:
 	return( -1 );
 }
 
+/* Reads a buffer from the file object using the readinto method
+ * The buffer object is reused between reads to prevent a new object being created for every read
+ * Make sure to hold the GIL state before calling this function
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t pyvshadow_file_object_readinto_buffer(
+         PyObject *file_object,
+         PyObject **buffer_object,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	PyObject *method_name      = NULL;
+	PyObject *method_result    = NULL;
+	char *safe_buffer          = NULL;
+	static char *function      = "pyvshadow_file_object_readinto_buffer";
+	Py_ssize_t safe_read_count = 0;
+	ssize_t read_count         = 0;
+
+	if( file_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer object.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size > (size_t) SSIZE_MAX )
+	 || ( size > (size_t) PY_SSIZE_T_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	PyErr_Clear();
+
+	if( *buffer_object == NULL )
+	{
+		*buffer_object = PyByteArray_FromStringAndSize(
+		                  NULL,
+		                  (Py_ssize_t) size );
+
+		if( *buffer_object == NULL )
+		{
+			pyvshadow_error_fetch(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer object.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( PyByteArray_Size(
+	          *buffer_object ) != (Py_ssize_t) size )
+	{
+		/* The readinto method reads as many bytes as the size of the buffer object
+		 */
+		if( PyByteArray_Resize(
+		     *buffer_object,
+		     (Py_ssize_t) size ) != 0 )
+		{
+			pyvshadow_error_fetch(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize buffer object.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if PY_MAJOR_VERSION >= 3
+	method_name = PyUnicode_FromString(
+	               "readinto" );
+#else
+	method_name = PyString_FromString(
+	               "readinto" );
+#endif
+	method_result = PyObject_CallMethodObjArgs(
+	                 file_object,
+	                 method_name,
+	                 *buffer_object,
+	                 NULL );
+
+	if( PyErr_Occurred() )
+	{
+		pyvshadow_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file object.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( method_result == NULL )
+	 || ( method_result == Py_None ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing method result.",
+		 function );
+
+		goto on_error;
+	}
+	safe_read_count = PyNumber_AsSsize_t(
+	                   method_result,
+	                   PyExc_OverflowError );
+
+	if( PyErr_Occurred() )
+	{
+		pyvshadow_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to convert method result into read count.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( safe_read_count < 0 )
+	 || ( (size_t) safe_read_count > size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read count value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = (ssize_t) safe_read_count;
+
+	safe_buffer = PyByteArray_AsString(
+	               *buffer_object );
+
+	if( memory_copy(
+	     buffer,
+	     safe_buffer,
+	     read_count ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to data to buffer.",
+		 function );
+
+		goto on_error;
+	}
+	Py_DecRef(
+	 method_result );
+
+	Py_DecRef(
+	 method_name );
+
+	return( read_count );
+
+on_error:
+	if( method_result != NULL )
+	{
+		Py_DecRef(
+		 method_result );
+	}
+	if( method_name != NULL )
+	{
+		Py_DecRef(
+		 method_name );
+	}
+	return( -1 );
+}
+
+/* Reads a buffer from the file descriptor of the file object IO handle
+ * The data is read at the current offset of the file object IO handle,
+ * which makes it safe to read from the same file descriptor in multiple threads
+ * The GIL state does not need to be held when calling this function
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t pyvshadow_file_object_io_handle_read_file_descriptor(
+         pyvshadow_file_object_io_handle_t *file_object_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "pyvshadow_file_object_io_handle_read_file_descriptor";
+
+#if defined( HAVE_PREAD )
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+#endif
+
+	if( file_object_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_object_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file object IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_PREAD )
+	while( buffer_offset < size )
+	{
+		read_count = pread(
+		              file_object_io_handle->file_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              size - buffer_offset,
+		              (off_t) ( file_object_io_handle->current_offset + buffer_offset ) );
+
+		if( read_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read from file descriptor.",
+			 function );
+
+			return( -1 );
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	file_object_io_handle->current_offset += (off64_t) buffer_offset;
+
+	return( (ssize_t) buffer_offset );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: positional reads not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_PREAD ) */
+}
+
 /* Reads a buffer from the file object IO handle
  * Returns the number of bytes read if successful, or -1 on error
  */
@@ -637,14 +1196,48 @@ ssize_t pyvshadow_file_object_io_handle_read(
 
 		return( -1 );
 	}
-	gil_state = PyGILState_Ensure();
+	/* Reading from the file descriptor does not require the GIL
+	 */
+	if( file_object_io_handle->file_descriptor != -1 )
+	{
+		read_count = pyvshadow_file_object_io_handle_read_file_descriptor(
+		              file_object_io_handle,
+		              buffer,
+		              size,
+		              error );
 
-	read_count = pyvshadow_file_object_read_buffer(
-	              file_object_io_handle->file_object,
-	              buffer,
-	              size,
-	              error );
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file descriptor.",
+			 function );
 
+			return( -1 );
+		}
+		return( read_count );
+	}
+	gil_state = PyGILState_Ensure();
+
+	if( file_object_io_handle->has_readinto != 0 )
+	{
+		read_count = pyvshadow_file_object_readinto_buffer(
+		              file_object_io_handle->file_object,
+		              &( file_object_io_handle->read_buffer_object ),
+		              buffer,
+		              size,
+		              error );
+	}
+	else
+	{
+		read_count = pyvshadow_file_object_read_buffer(
+		              file_object_io_handle->file_object,
+		              buffer,
+		              size,
+		              error );
+	}
 	if( read_count == -1 )
 	{
 		libcerror_error_set(
@@ -1139,6 +1732,7 @@ off64_t pyvshadow_file_object_io_handle_seek_offset(
          libcerror_error_t **error )
 {
 	static char *function      = "pyvshadow_file_object_io_handle_seek_offset";
+	size64_t size              = 0;
 	PyGILState_STATE gil_state = 0;
 
 	if( file_object_io_handle == NULL )
@@ -1152,6 +1746,56 @@ off64_t pyvshadow_file_object_io_handle_seek_offset(
 
 		return( -1 );
 	}
+	if( file_object_io_handle->file_descriptor != -1 )
+	{
+		if( whence == SEEK_CUR )
+		{
+			offset += file_object_io_handle->current_offset;
+		}
+		else if( whence == SEEK_END )
+		{
+			if( pyvshadow_file_object_io_handle_get_size(
+			     file_object_io_handle,
+			     &size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size.",
+				 function );
+
+				return( -1 );
+			}
+			offset += (off64_t) size;
+		}
+		else if( whence != SEEK_SET )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported whence.",
+			 function );
+
+			return( -1 );
+		}
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: invalid offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		file_object_io_handle->current_offset = offset;
+
+		return( offset );
+	}
 	gil_state = PyGILState_Ensure();
 
 	if( pyvshadow_file_object_seek_offset(
@@ -1401,6 +2045,23 @@ int pyvshadow_file_object_io_handle_get_size(
 
 		return( -1 );
 	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_object_io_handle->size_is_set != 0 )
+	{
+		*size = file_object_io_handle->size;
+
+		return( 1 );
+	}
 	gil_state = PyGILState_Ensure();
 
 #if PY_MAJOR_VERSION >= 3
@@ -1508,6 +2169,14 @@ int pyvshadow_file_object_io_handle_get_size(
 	PyGILState_Release(
 	 gil_state );
 
+	/* The size is cached when reading from the file descriptor
+	 * so that seeking relative to the end does not require the GIL
+	 */
+	if( file_object_io_handle->file_descriptor != -1 )
+	{
+		file_object_io_handle->size        = *size;
+		file_object_io_handle->size_is_set = 1;
+	}
 	return( 1 );
 
 on_error:
@@ -1519,6 +2188,6 @@ on_error:
 	PyGILState_Release(
 	 gil_state );
 
-	return( 1 );
+	return( -1 );
 }
 
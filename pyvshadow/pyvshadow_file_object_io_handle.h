@@ -44,6 +44,31 @@ struct pyvshadow_file_object_io_handle
 	/* The access flags
 	 */
 	int access_flags;
+
+	/* The file descriptor of the file object
+	 * -1 if the file object has no file descriptor that supports positional reads
+	 */
+	int file_descriptor;
+
+	/* The current offset, used when reading from the file descriptor
+	 */
+	off64_t current_offset;
+
+	/* The size, used when reading from the file descriptor
+	 */
+	size64_t size;
+
+	/* Value to indicate the size was determined
+	 */
+	uint8_t size_is_set;
+
+	/* Value to indicate the file object has a readinto method
+	 */
+	uint8_t has_readinto;
+
+	/* The (reusable) buffer object used by the readinto method
+	 */
+	PyObject *read_buffer_object;
 };
 
 int pyvshadow_file_object_io_handle_initialize(
@@ -56,6 +81,11 @@ int pyvshadow_file_object_initialize(
      PyObject *file_object,
      libcerror_error_t **error );
 
+int pyvshadow_file_object_get_file_descriptor(
+     PyObject *file_object,
+     int *file_descriptor,
+     libcerror_error_t **error );
+
 int pyvshadow_file_object_io_handle_free(
      pyvshadow_file_object_io_handle_t **file_object_io_handle,
      libcerror_error_t **error );
@@ -80,6 +110,19 @@ ssize_t pyvshadow_file_object_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+ssize_t pyvshadow_file_object_readinto_buffer(
+         PyObject *file_object,
+         PyObject **buffer_object,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t pyvshadow_file_object_io_handle_read_file_descriptor(
+         pyvshadow_file_object_io_handle_t *file_object_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
 ssize_t pyvshadow_file_object_io_handle_read(
          pyvshadow_file_object_io_handle_t *file_object_io_handle,
          uint8_t *buffer,
@@ -28,6 +28,39 @@ import sys
 import pyvshadow
 
 
+class FileObjectWithoutDescriptor(object):
+  """File-like object that does not expose a file descriptor."""
+
+  def __init__(self, file_object):
+    """Initializes the file-like object.
+
+    Args:
+      file_object (file): file-like object to wrap.
+    """
+    super(FileObjectWithoutDescriptor, self).__init__()
+    self._file_object = file_object
+
+  def close(self):
+    """Closes the file-like object."""
+    self._file_object.close()
+
+  def get_size(self):
+    """Retrieves the size of the file-like object."""
+    return os.fstat(self._file_object.fileno()).st_size
+
+  def read(self, size=-1):
+    """Reads data from the file-like object."""
+    return self._file_object.read(size)
+
+  def seek(self, offset, whence=os.SEEK_SET):
+    """Seeks an offset within the file-like object."""
+    self._file_object.seek(offset, whence)
+
+  def tell(self):
+    """Retrieves the current offset of the file-like object."""
+    return self._file_object.tell()
+
+
 def get_whence_string(whence):
   """Retrieves a human readable string representation of the whence."""
   if whence == os.SEEK_CUR:
@@ -258,6 +291,23 @@ def pyvshadow_test_read_file_object(filename):
   return result
 
 
+def pyvshadow_test_read_file_object_without_descriptor(filename):
+  file_object = FileObjectWithoutDescriptor(open(filename, "rb"))
+  vshadow_volume = pyvshadow.volume()
+
+  vshadow_volume.open_file_object(file_object, "r")
+
+  result = True
+  for vshadow_store in vshadow_volume.stores:
+    result = pyvshadow_test_read(vshadow_store)
+    if not result:
+      break
+
+  vshadow_volume.close()
+
+  return result
+
+
 def main():
   args_parser = argparse.ArgumentParser(description=(
       "Tests read."))
@@ -281,6 +331,9 @@ def main():
   if not pyvshadow_test_read_file_object(options.source):
     return False
 
+  if not pyvshadow_test_read_file_object_without_descriptor(options.source):
+    return False
+
   return True
 
 
@@ -0,0 +1,81 @@
+#!/bin/bash
+# Benchmarks reading generated volume images.
+#
+# The shape of the generated volume images can be changed by setting
+# BENCHMARK_GENERATE_OPTION_SETS to one or more vshadow_test_generate
+# option sets, separated by a semicolon, for example:
+# BENCHMARK_GENERATE_OPTION_SETS="-n 4 -s 256M;-n 16 -s 1G -f 50"
+#
+# Additional benchmark options can be passed with BENCHMARK_OPTIONS,
+# for example: BENCHMARK_OPTIONS="-b 4096 -t 8"
+#
+# Version: 20171018
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+TEST_PREFIX=`dirname ${PWD}`;
+TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\).*$/\1/'`;
+
+if test -z "${BENCHMARK_GENERATE_OPTION_SETS}";
+then
+	BENCHMARK_GENERATE_OPTION_SETS="-n 4 -s 256M;-n 4 -s 256M -f 50 -F 25 -o 25;-n 32 -s 256M -c 5";
+fi
+
+IFS=";" read -r -a GENERATE_OPTION_SETS <<< "${BENCHMARK_GENERATE_OPTION_SETS}";
+
+TEST_TOOL_DIRECTORY=".";
+TEST_GENERATE="${TEST_TOOL_DIRECTORY}/${TEST_PREFIX}_test_generate";
+TEST_BENCHMARK="${TEST_TOOL_DIRECTORY}/${TEST_PREFIX}_test_benchmark";
+
+if ! test -x "${TEST_GENERATE}";
+then
+	TEST_GENERATE="${TEST_GENERATE}.exe";
+fi
+
+if ! test -x "${TEST_BENCHMARK}";
+then
+	TEST_BENCHMARK="${TEST_BENCHMARK}.exe";
+fi
+
+if ! test -x "${TEST_GENERATE}" || ! test -x "${TEST_BENCHMARK}";
+then
+	echo "Missing executables, run: make check first.";
+
+	exit ${EXIT_IGNORE};
+fi
+
+TMPDIR="tmp$$";
+
+rm -rf ${TMPDIR};
+mkdir ${TMPDIR};
+
+RESULT=${EXIT_SUCCESS};
+
+for GENERATE_OPTIONS in "${GENERATE_OPTION_SETS[@]}";
+do
+	${TEST_GENERATE} ${GENERATE_OPTIONS} "${TMPDIR}/volume.raw" > /dev/null;
+	RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo "Unable to generate volume image with options: ${GENERATE_OPTIONS}";
+
+		break;
+	fi
+	echo "generate_options: ${GENERATE_OPTIONS}";
+
+	${TEST_BENCHMARK} ${BENCHMARK_OPTIONS} "${TMPDIR}/volume.raw";
+	RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		break;
+	fi
+done
+
+rm -rf ${TMPDIR};
+
+exit ${RESULT};
+
@@ -0,0 +1,142 @@
+#!/bin/bash
+# Tests the library and tools with generated volume images.
+#
+# Version: 20171018
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+TEST_PREFIX=`dirname ${PWD}`;
+TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\).*$/\1/'`;
+
+# Every option set is used to generate a volume image.
+GENERATE_OPTION_SETS=("-n 1 -s 1M" "-n 4 -s 8M -f 50 -F 25 -o 25" "-n 40 -s 16M -c 1");
+
+TEST_TOOL_DIRECTORY=".";
+TEST_GENERATE="${TEST_TOOL_DIRECTORY}/${TEST_PREFIX}_test_generate";
+TEST_STORE="${TEST_TOOL_DIRECTORY}/${TEST_PREFIX}_test_store";
+TEST_VOLUME="${TEST_TOOL_DIRECTORY}/${TEST_PREFIX}_test_volume";
+TEST_INFO="../${TEST_PREFIX}tools/${TEST_PREFIX}info";
+TEST_HASH="../${TEST_PREFIX}tools/${TEST_PREFIX}hash";
+TEST_EXPORT="../${TEST_PREFIX}tools/${TEST_PREFIX}export";
+
+if ! test -z ${SKIP_LIBRARY_TESTS};
+then
+	exit ${EXIT_IGNORE};
+fi
+
+if ! test -x "${TEST_GENERATE}";
+then
+	TEST_GENERATE="${TEST_GENERATE}.exe";
+fi
+
+if ! test -x "${TEST_STORE}";
+then
+	TEST_STORE="${TEST_STORE}.exe";
+fi
+
+if ! test -x "${TEST_VOLUME}";
+then
+	TEST_VOLUME="${TEST_VOLUME}.exe";
+fi
+
+if ! test -x "${TEST_INFO}";
+then
+	TEST_INFO="${TEST_INFO}.exe";
+fi
+
+if ! test -x "${TEST_HASH}";
+then
+	TEST_HASH="${TEST_HASH}.exe";
+fi
+
+if ! test -x "${TEST_EXPORT}";
+then
+	TEST_EXPORT="${TEST_EXPORT}.exe";
+fi
+
+TEST_RUNNER="tests/test_runner.sh";
+
+if ! test -f "${TEST_RUNNER}";
+then
+	TEST_RUNNER="./test_runner.sh";
+fi
+
+if ! test -f "${TEST_RUNNER}";
+then
+	echo "Missing test runner: ${TEST_RUNNER}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+source ${TEST_RUNNER};
+
+TMPDIR="tmp$$";
+
+rm -rf ${TMPDIR};
+mkdir ${TMPDIR};
+
+RESULT=${EXIT_SUCCESS};
+
+for GENERATE_OPTIONS in "${GENERATE_OPTION_SETS[@]}";
+do
+	${TEST_GENERATE} ${GENERATE_OPTIONS} "${TMPDIR}/volume.raw" > /dev/null;
+	RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo "Unable to generate volume image with options: ${GENERATE_OPTIONS}";
+
+		break;
+	fi
+	run_test_with_arguments "Testing: volume (generated with: ${GENERATE_OPTIONS})" "${TEST_VOLUME}" "${TMPDIR}/volume.raw";
+	RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		break;
+	fi
+	run_test_with_arguments "Testing: store (generated with: ${GENERATE_OPTIONS})" "${TEST_STORE}" "${TMPDIR}/volume.raw";
+	RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		break;
+	fi
+	if test -z ${SKIP_TOOLS_TESTS} && test -x "${TEST_INFO}";
+	then
+		run_test_with_arguments "Testing: ${TEST_PREFIX}info (generated with: ${GENERATE_OPTIONS})" "${TEST_INFO}" "${TMPDIR}/volume.raw";
+		RESULT=$?;
+
+		if test ${RESULT} -ne ${EXIT_SUCCESS};
+		then
+			break;
+		fi
+	fi
+	if test -z ${SKIP_TOOLS_TESTS} && test -x "${TEST_HASH}";
+	then
+		run_test_with_arguments "Testing: ${TEST_PREFIX}hash (generated with: ${GENERATE_OPTIONS})" "${TEST_HASH}" -d all -j 2 "${TMPDIR}/volume.raw";
+		RESULT=$?;
+
+		if test ${RESULT} -ne ${EXIT_SUCCESS};
+		then
+			break;
+		fi
+	fi
+	if test -z ${SKIP_TOOLS_TESTS} && test -x "${TEST_EXPORT}";
+	then
+		run_test_with_arguments "Testing: ${TEST_PREFIX}export (generated with: ${GENERATE_OPTIONS})" "${TEST_EXPORT}" -j 2 -w 2 "${TMPDIR}/volume.raw" "${TMPDIR}/export";
+		RESULT=$?;
+
+		if test ${RESULT} -ne ${EXIT_SUCCESS};
+		then
+			break;
+		fi
+	fi
+done
+
+rm -rf ${TMPDIR};
+
+exit ${RESULT};
+
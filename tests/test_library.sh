@@ -11,7 +11,7 @@ TEST_PREFIX=`dirname ${PWD}`;
 TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\).*$/\1/'`;
 
 TEST_PROFILE="lib${TEST_PREFIX}";
-LIBRARY_TESTS="block block_descriptor block_range_descriptor error io_handle notify store store_block store_descriptor";
+LIBRARY_TESTS="allocation_bitmap block block_array block_descriptor block_range_descriptor block_table block_timeline error histogram io_handle notify physical_block_map statistics store store_block store_block_reader store_descriptor thread_pool";
 LIBRARY_TESTS_WITH_INPUT="support volume";
 OPTION_SETS="";
 
@@ -0,0 +1,984 @@
+/*
+ * Library allocation_bitmap type test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_allocation_bitmap.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libvshadow_allocation_bitmap_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_initialize(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libvshadow_allocation_bitmap_t *allocation_bitmap = NULL;
+	int result                                        = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_allocation_bitmap_free(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_allocation_bitmap_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	allocation_bitmap = (libvshadow_allocation_bitmap_t *) 0x12345678UL;
+
+	result = libvshadow_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          &error );
+
+	allocation_bitmap = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_bitmap != NULL )
+	{
+		libvshadow_allocation_bitmap_free(
+		 &allocation_bitmap,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_allocation_bitmap_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_allocation_bitmap_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_allocation_bitmap_read_volume_header_data function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_read_volume_header_data(
+     void )
+{
+	uint8_t volume_header_data[ 512 ];
+
+	libcerror_error_t *error                          = NULL;
+	libvshadow_allocation_bitmap_t *allocation_bitmap = NULL;
+	int result                                        = 0;
+
+	/* Initialize test
+	 * A NTFS volume header of 8192 sectors of 512 bytes with 4096 bytes
+	 * per cluster block, the MFT at cluster block 4 and 1024 bytes per MFT entry
+	 */
+	memory_set(
+	 volume_header_data,
+	 0,
+	 512 );
+
+	memory_copy(
+	 &( volume_header_data[ 3 ] ),
+	 "NTFS    ",
+	 8 );
+
+	volume_header_data[ 11 ] = 0x00;
+	volume_header_data[ 12 ] = 0x02;
+	volume_header_data[ 13 ] = 8;
+	volume_header_data[ 40 ] = 0x00;
+	volume_header_data[ 41 ] = 0x20;
+	volume_header_data[ 48 ] = 4;
+	volume_header_data[ 64 ] = 0xf6;
+
+	result = libvshadow_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_allocation_bitmap_read_volume_header_data(
+	          allocation_bitmap,
+	          volume_header_data,
+	          512,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "allocation_bitmap->cluster_block_size",
+	 allocation_bitmap->cluster_block_size,
+	 (uint32_t) 4096 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "allocation_bitmap->number_of_cluster_blocks",
+	 allocation_bitmap->number_of_cluster_blocks,
+	 (uint64_t) 1024 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "allocation_bitmap->mft_offset",
+	 (int64_t) allocation_bitmap->mft_offset,
+	 (int64_t) 16384 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "allocation_bitmap->mft_entry_size",
+	 allocation_bitmap->mft_entry_size,
+	 (uint32_t) 1024 );
+
+	/* Test a volume header without a NTFS signature
+	 */
+	volume_header_data[ 3 ] = 'X';
+
+	result = libvshadow_allocation_bitmap_read_volume_header_data(
+	          allocation_bitmap,
+	          volume_header_data,
+	          512,
+	          &error );
+
+	volume_header_data[ 3 ] = 'N';
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_allocation_bitmap_read_volume_header_data(
+	          NULL,
+	          volume_header_data,
+	          512,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_read_volume_header_data(
+	          allocation_bitmap,
+	          NULL,
+	          512,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_read_volume_header_data(
+	          allocation_bitmap,
+	          volume_header_data,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test an unsupported number of sectors per cluster block
+	 */
+	volume_header_data[ 13 ] = 3;
+
+	result = libvshadow_allocation_bitmap_read_volume_header_data(
+	          allocation_bitmap,
+	          volume_header_data,
+	          512,
+	          &error );
+
+	volume_header_data[ 13 ] = 8;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a MFT cluster block number beyond the end of the file system
+	 */
+	volume_header_data[ 49 ] = 0x04;
+
+	result = libvshadow_allocation_bitmap_read_volume_header_data(
+	          allocation_bitmap,
+	          volume_header_data,
+	          512,
+	          &error );
+
+	volume_header_data[ 49 ] = 0x00;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_allocation_bitmap_free(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_bitmap != NULL )
+	{
+		libvshadow_allocation_bitmap_free(
+		 &allocation_bitmap,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_allocation_bitmap_read_mft_entry_data function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_read_mft_entry_data(
+     void )
+{
+	uint8_t mft_entry_data[ 1024 ];
+
+	libcerror_error_t *error                          = NULL;
+	libvshadow_allocation_bitmap_t *allocation_bitmap = NULL;
+	int result                                        = 0;
+
+	/* Initialize test
+	 * A $Bitmap MFT entry of 1024 bytes with a non-resident $DATA attribute
+	 * of 128 bytes that is stored in cluster block 5
+	 */
+	memory_set(
+	 mft_entry_data,
+	 0,
+	 1024 );
+
+	memory_copy(
+	 mft_entry_data,
+	 "FILE",
+	 4 );
+
+	/* The fix-up values
+	 */
+	mft_entry_data[ 4 ]    = 48;
+	mft_entry_data[ 6 ]    = 3;
+	mft_entry_data[ 48 ]   = 0x01;
+	mft_entry_data[ 510 ]  = 0x01;
+	mft_entry_data[ 1022 ] = 0x01;
+
+	/* The attributes offset and in-use flag
+	 */
+	mft_entry_data[ 20 ] = 56;
+	mft_entry_data[ 22 ] = 0x01;
+
+	/* The $DATA attribute header
+	 */
+	mft_entry_data[ 56 ] = 0x80;
+	mft_entry_data[ 60 ] = 72;
+	mft_entry_data[ 64 ] = 1;
+
+	/* The non-resident $DATA attribute values
+	 */
+	mft_entry_data[ 88 ]  = 64;
+	mft_entry_data[ 97 ]  = 0x10;
+	mft_entry_data[ 104 ] = 128;
+	mft_entry_data[ 112 ] = 128;
+
+	/* The data runs
+	 */
+	mft_entry_data[ 120 ] = 0x21;
+	mft_entry_data[ 121 ] = 0x01;
+	mft_entry_data[ 122 ] = 0x05;
+
+	/* The end of attributes marker
+	 */
+	memory_set(
+	 &( mft_entry_data[ 128 ] ),
+	 0xff,
+	 4 );
+
+	result = libvshadow_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	allocation_bitmap->cluster_block_size       = 4096;
+	allocation_bitmap->number_of_cluster_blocks = 1024;
+
+	/* Test error cases
+	 */
+	result = libvshadow_allocation_bitmap_read_mft_entry_data(
+	          NULL,
+	          mft_entry_data,
+	          1024,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_read_mft_entry_data(
+	          allocation_bitmap,
+	          NULL,
+	          1024,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a MFT entry with a mismatching fix-up value
+	 */
+	mft_entry_data[ 1022 ] = 0x02;
+
+	result = libvshadow_allocation_bitmap_read_mft_entry_data(
+	          allocation_bitmap,
+	          mft_entry_data,
+	          1024,
+	          &error );
+
+	/* The fix-up value of the first 512 bytes was already applied
+	 */
+	mft_entry_data[ 510 ]  = 0x01;
+	mft_entry_data[ 1022 ] = 0x01;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_allocation_bitmap_read_mft_entry_data(
+	          allocation_bitmap,
+	          mft_entry_data,
+	          1024,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_bitmap->data",
+	 allocation_bitmap->data );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "allocation_bitmap->data_size",
+	 allocation_bitmap->data_size,
+	 (size_t) 128 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "allocation_bitmap->number_of_data_runs",
+	 allocation_bitmap->number_of_data_runs,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "allocation_bitmap->data_runs[ 0 ].offset",
+	 (int64_t) allocation_bitmap->data_runs[ 0 ].offset,
+	 (int64_t) 20480 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "allocation_bitmap->data_runs[ 0 ].size",
+	 (uint64_t) allocation_bitmap->data_runs[ 0 ].size,
+	 (uint64_t) 4096 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "allocation_bitmap->data_runs[ 0 ].is_sparse",
+	 allocation_bitmap->data_runs[ 0 ].is_sparse,
+	 0 );
+
+	/* Test reading the MFT entry data again
+	 */
+	result = libvshadow_allocation_bitmap_read_mft_entry_data(
+	          allocation_bitmap,
+	          mft_entry_data,
+	          1024,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_allocation_bitmap_free(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_bitmap != NULL )
+	{
+		libvshadow_allocation_bitmap_free(
+		 &allocation_bitmap,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_allocation_bitmap_get_extent function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_get_extent(
+     void )
+{
+	uint8_t bitmap_data[ 4 ] = {
+		0xff, 0x0f, 0x00, 0x00 };
+
+	libvshadow_allocation_bitmap_t allocation_bitmap;
+
+	libcerror_error_t *error = NULL;
+	size64_t extent_size     = 0;
+	uint8_t is_allocated     = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 * A file system of 32 cluster blocks of which the first 12 are allocated
+	 */
+	memory_set(
+	 &allocation_bitmap,
+	 0,
+	 sizeof( libvshadow_allocation_bitmap_t ) );
+
+	allocation_bitmap.cluster_block_size       = 4096;
+	allocation_bitmap.number_of_cluster_blocks = 32;
+	allocation_bitmap.data                     = bitmap_data;
+	allocation_bitmap.data_size                = 4;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_allocation_bitmap_get_extent(
+	          &allocation_bitmap,
+	          0,
+	          1048576,
+	          &extent_size,
+	          &is_allocated,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 (uint64_t) extent_size,
+	 (uint64_t) 49152 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 1 );
+
+	/* Test an extent that is limited by the maximum size
+	 */
+	result = libvshadow_allocation_bitmap_get_extent(
+	          &allocation_bitmap,
+	          512,
+	          1024,
+	          &extent_size,
+	          &is_allocated,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 (uint64_t) extent_size,
+	 (uint64_t) 1024 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 1 );
+
+	/* Test an unallocated extent that ends at the last cluster block
+	 */
+	result = libvshadow_allocation_bitmap_get_extent(
+	          &allocation_bitmap,
+	          49152,
+	          1048576,
+	          &extent_size,
+	          &is_allocated,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 (uint64_t) extent_size,
+	 (uint64_t) 81920 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 0 );
+
+	/* Test an extent beyond the last cluster block
+	 */
+	result = libvshadow_allocation_bitmap_get_extent(
+	          &allocation_bitmap,
+	          131072,
+	          65536,
+	          &extent_size,
+	          &is_allocated,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 (uint64_t) extent_size,
+	 (uint64_t) 65536 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_allocation_bitmap_get_extent(
+	          NULL,
+	          0,
+	          1048576,
+	          &extent_size,
+	          &is_allocated,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_get_extent(
+	          &allocation_bitmap,
+	          -1,
+	          1048576,
+	          &extent_size,
+	          &is_allocated,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_get_extent(
+	          &allocation_bitmap,
+	          0,
+	          0,
+	          &extent_size,
+	          &is_allocated,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_get_extent(
+	          &allocation_bitmap,
+	          0,
+	          1048576,
+	          NULL,
+	          &is_allocated,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_get_extent(
+	          &allocation_bitmap,
+	          0,
+	          1048576,
+	          &extent_size,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_allocation_bitmap_initialize",
+	 vshadow_test_allocation_bitmap_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_allocation_bitmap_free",
+	 vshadow_test_allocation_bitmap_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_allocation_bitmap_read_volume_header_data",
+	 vshadow_test_allocation_bitmap_read_volume_header_data );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_allocation_bitmap_read_mft_entry_data",
+	 vshadow_test_allocation_bitmap_read_mft_entry_data );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_allocation_bitmap_get_extent",
+	 vshadow_test_allocation_bitmap_get_extent );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1050 @@
+/*
+ * Benchmarks reading Volume Shadow Snapshot (VSS) stores
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* The benchmark measures per store:
+ * - the time to load the store metadata, which is done on the first read
+ * - sequential read throughput
+ * - random read throughput
+ * - multi-threaded sequential read throughput, where every thread
+ *   reads a separate part of the store using the same store
+ *
+ * The results are printed as "key: value" lines, where per store results
+ * are prefixed with "store: <number>", so that they can be compared across
+ * runs and releases.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#if defined( HAVE_SYS_RESOURCE_H )
+#include <sys/resource.h>
+#endif
+
+#include <time.h>
+
+#include "vshadow_test_getopt.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libcthreads.h"
+#include "vshadow_test_libvshadow.h"
+
+/* The maximum number of threads
+ */
+#define VSHADOW_TEST_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS	64
+
+typedef struct vshadow_test_benchmark_thread_values vshadow_test_benchmark_thread_values_t;
+
+struct vshadow_test_benchmark_thread_values
+{
+	/* The store
+	 */
+	libvshadow_store_t *store;
+
+	/* The start offset
+	 */
+	off64_t start_offset;
+
+	/* The end offset
+	 */
+	off64_t end_offset;
+
+	/* The read size
+	 */
+	size_t read_size;
+
+	/* The number of bytes read
+	 */
+	size64_t read_count;
+
+	/* The result
+	 */
+	int result;
+};
+
+/* Prints usage information
+ */
+void vshadow_test_benchmark_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadow_test_benchmark to benchmark reading the stores of a Volume\n"
+	                 "Shadow Snapshot (VSS) volume.\n\n" );
+
+	fprintf( stream, "Usage: vshadow_test_benchmark [ -b size ] [ -n number ] [ -s number ]\n"
+	                 "                              [ -t number ] [ -h ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device\n\n" );
+	fprintf( stream, "\t-b:     read size in bytes (default is 65536)\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-n:     number of random reads per store (default is 4096)\n" );
+	fprintf( stream, "\t-s:     only benchmark a specific store number\n" );
+	fprintf( stream, "\t-t:     number of threads of the multi-threaded read benchmark\n"
+	                 "\t        (default is 4, 0 disables the benchmark)\n" );
+}
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_benchmark_string_copy_to_64bit(
+     const system_character_t *string,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_benchmark_string_copy_to_64bit";
+	size_t string_index   = 0;
+	uint64_t value        = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( string[ string_index ] >= (system_character_t) '0' )
+	    && ( string[ string_index ] <= (system_character_t) '9' ) )
+	{
+		if( value > ( ( (uint64_t) UINT64_MAX - 9 ) / 10 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		value *= 10;
+		value += (uint64_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		string_index++;
+	}
+	if( ( string_index == 0 )
+	 || ( string[ string_index ] != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported value.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = value;
+
+	return( 1 );
+}
+
+/* Retrieves a monotonic timestamp in nano seconds
+ */
+uint64_t vshadow_test_benchmark_get_timestamp(
+          void )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		return( 0 );
+	}
+	return( (uint64_t) ( ( (double) counter.QuadPart * 1000000000.0 ) / (double) frequency.QuadPart ) );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec );
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	struct timeval time_value;
+
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + ( (uint64_t) time_value.tv_usec * 1000 ) );
+
+#else
+	return( (uint64_t) time( NULL ) * 1000000000UL );
+#endif
+}
+
+/* Retrieves the peak resident set size (RSS) of the process in bytes
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int vshadow_test_benchmark_get_peak_resident_set_size(
+     size64_t *peak_resident_set_size )
+{
+#if defined( HAVE_GETRUSAGE )
+	struct rusage resource_usage;
+#endif
+
+	if( peak_resident_set_size == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_GETRUSAGE )
+	if( getrusage(
+	     RUSAGE_SELF,
+	     &resource_usage ) != 0 )
+	{
+		return( -1 );
+	}
+#if defined( __APPLE__ )
+	/* On Mac OS X ru_maxrss is in bytes
+	 */
+	*peak_resident_set_size = (size64_t) resource_usage.ru_maxrss;
+#else
+	/* On Linux and the BSDs ru_maxrss is in kilobytes
+	 */
+	*peak_resident_set_size = (size64_t) resource_usage.ru_maxrss * 1024;
+#endif
+	return( 1 );
+#else
+	*peak_resident_set_size = 0;
+
+	return( 0 );
+#endif
+}
+
+/* Prints a throughput result
+ */
+void vshadow_test_benchmark_result_fprint(
+      FILE *stream,
+      int store_index,
+      const char *name,
+      size64_t read_count,
+      uint64_t number_of_reads,
+      uint64_t elapsed_time )
+{
+	double mebibytes_per_second = 0.0;
+	double seconds              = 0.0;
+
+	seconds = (double) elapsed_time / 1000000000.0;
+
+	if( elapsed_time > 0 )
+	{
+		mebibytes_per_second = ( (double) read_count / ( 1024.0 * 1024.0 ) ) / seconds;
+	}
+	fprintf(
+	 stream,
+	 "store: %d %s_bytes: %" PRIu64 " %s_reads: %" PRIu64 " %s_time: %.6f %s_throughput: %.3f\n",
+	 store_index + 1,
+	 name,
+	 read_count,
+	 name,
+	 number_of_reads,
+	 name,
+	 seconds,
+	 name,
+	 mebibytes_per_second );
+}
+
+/* Reads a part of a store sequentially
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_benchmark_read_sequential(
+     libvshadow_store_t *store,
+     uint8_t *buffer,
+     size_t read_size,
+     off64_t start_offset,
+     off64_t end_offset,
+     size64_t *read_count,
+     uint64_t *number_of_reads,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_benchmark_read_sequential";
+	ssize_t read_result   = 0;
+	off64_t offset        = 0;
+	size_t buffer_size    = 0;
+
+	for( offset = start_offset;
+	     offset < end_offset;
+	     offset += read_result )
+	{
+		buffer_size = read_size;
+
+		if( (size64_t) buffer_size > (size64_t) ( end_offset - offset ) )
+		{
+			buffer_size = (size_t) ( end_offset - offset );
+		}
+		read_result = libvshadow_store_read_buffer_at_offset(
+		               store,
+		               buffer,
+		               buffer_size,
+		               offset,
+		               error );
+
+		if( read_result <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		*read_count      += (size64_t) read_result;
+		*number_of_reads += 1;
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Reads a part of a store sequentially in a separate thread
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_benchmark_read_thread_callback(
+     vshadow_test_benchmark_thread_values_t *thread_values )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *buffer          = NULL;
+	uint64_t number_of_reads = 0;
+
+	if( thread_values == NULL )
+	{
+		return( -1 );
+	}
+	thread_values->result = -1;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * thread_values->read_size );
+
+	if( buffer == NULL )
+	{
+		return( -1 );
+	}
+	thread_values->result = vshadow_test_benchmark_read_sequential(
+	                         thread_values->store,
+	                         buffer,
+	                         thread_values->read_size,
+	                         thread_values->start_offset,
+	                         thread_values->end_offset,
+	                         &( thread_values->read_count ),
+	                         &number_of_reads,
+	                         &error );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	memory_free(
+	 buffer );
+
+	return( thread_values->result );
+}
+
+/* Reads a store sequentially using multiple threads
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_benchmark_read_multi_threaded(
+     libvshadow_store_t *store,
+     size64_t store_size,
+     size_t read_size,
+     int number_of_threads,
+     size64_t *read_count,
+     libcerror_error_t **error )
+{
+	libcthreads_thread_t *threads[ VSHADOW_TEST_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS ];
+	vshadow_test_benchmark_thread_values_t thread_values[ VSHADOW_TEST_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS ];
+
+	static char *function = "vshadow_test_benchmark_read_multi_threaded";
+	size64_t part_size    = 0;
+	int result            = 1;
+	int thread_index      = 0;
+
+	if( memory_set(
+	     threads,
+	     0,
+	     sizeof( libcthreads_thread_t * ) * VSHADOW_TEST_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear threads.",
+		 function );
+
+		return( -1 );
+	}
+	/* Every thread reads a part of the store that is aligned with the read size
+	 */
+	part_size  = store_size / number_of_threads;
+	part_size -= part_size % read_size;
+
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		thread_values[ thread_index ].store        = store;
+		thread_values[ thread_index ].start_offset = (off64_t) ( part_size * thread_index );
+		thread_values[ thread_index ].end_offset   = (off64_t) ( part_size * ( thread_index + 1 ) );
+		thread_values[ thread_index ].read_size    = read_size;
+		thread_values[ thread_index ].read_count   = 0;
+		thread_values[ thread_index ].result       = 0;
+
+		if( thread_index == ( number_of_threads - 1 ) )
+		{
+			thread_values[ thread_index ].end_offset = (off64_t) store_size;
+		}
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( threads[ thread_index ] ),
+		     NULL,
+		     (int (*)(void *)) &vshadow_test_benchmark_read_thread_callback,
+		     (void *) &( thread_values[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+
+			break;
+		}
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_join(
+		     &( threads[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+		else if( thread_values[ thread_index ].result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: thread: %d unable to read store.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+		*read_count += thread_values[ thread_index ].read_count;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Benchmarks a store
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_benchmark_store(
+     libvshadow_volume_t *volume,
+     int store_index,
+     size_t read_size,
+     uint64_t number_of_random_reads,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	uint8_t *buffer           = NULL;
+	static char *function     = "vshadow_test_benchmark_store";
+	size64_t read_count       = 0;
+	size64_t store_size       = 0;
+	ssize_t read_result       = 0;
+	off64_t offset            = 0;
+	uint64_t number_of_blocks = 0;
+	uint64_t number_of_reads  = 0;
+	uint64_t random_state     = 0;
+	uint64_t read_index       = 0;
+	uint64_t start_time       = 0;
+	uint64_t end_time         = 0;
+
+	if( libvshadow_volume_get_store(
+	     volume,
+	     store_index,
+	     &store,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+	if( libvshadow_store_get_size(
+	     store,
+	     &store_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store size.",
+		 function );
+
+		goto on_error;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * read_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "store: %d size: %" PRIu64 "\n",
+	 store_index + 1,
+	 store_size );
+
+	/* The store metadata, such as the block list, is read on the first read
+	 */
+	start_time = vshadow_test_benchmark_get_timestamp();
+
+	read_result = libvshadow_store_read_buffer_at_offset(
+	               store,
+	               buffer,
+	               512,
+	               0,
+	               error );
+
+	end_time = vshadow_test_benchmark_get_timestamp();
+
+	if( read_result != 512 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read first sector of store.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "store: %d metadata_load_time: %.6f\n",
+	 store_index + 1,
+	 (double) ( end_time - start_time ) / 1000000000.0 );
+
+	/* Sequential read
+	 */
+	start_time = vshadow_test_benchmark_get_timestamp();
+
+	if( vshadow_test_benchmark_read_sequential(
+	     store,
+	     buffer,
+	     read_size,
+	     0,
+	     (off64_t) store_size,
+	     &read_count,
+	     &number_of_reads,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	end_time = vshadow_test_benchmark_get_timestamp();
+
+	vshadow_test_benchmark_result_fprint(
+	 stdout,
+	 store_index,
+	 "sequential_read",
+	 read_count,
+	 number_of_reads,
+	 end_time - start_time );
+
+	/* Random read
+	 */
+	number_of_blocks = store_size / read_size;
+
+	if( ( number_of_blocks > 0 )
+	 && ( number_of_random_reads > 0 ) )
+	{
+		read_count      = 0;
+		number_of_reads = 0;
+		random_state    = 0x9e3779b97f4a7c15ULL ^ (uint64_t) store_index;
+
+		start_time = vshadow_test_benchmark_get_timestamp();
+
+		for( read_index = 0;
+		     read_index < number_of_random_reads;
+		     read_index++ )
+		{
+			/* xorshift64
+			 */
+			random_state ^= random_state << 13;
+			random_state ^= random_state >> 7;
+			random_state ^= random_state << 17;
+
+			offset = (off64_t) ( ( random_state % number_of_blocks ) * read_size );
+
+			read_result = libvshadow_store_read_buffer_at_offset(
+			               store,
+			               buffer,
+			               read_size,
+			               offset,
+			               error );
+
+			if( read_result != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+			read_count      += (size64_t) read_result;
+			number_of_reads += 1;
+		}
+		end_time = vshadow_test_benchmark_get_timestamp();
+
+		vshadow_test_benchmark_result_fprint(
+		 stdout,
+		 store_index,
+		 "random_read",
+		 read_count,
+		 number_of_reads,
+		 end_time - start_time );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Multi-threaded read
+	 */
+	if( number_of_threads > 0 )
+	{
+		read_count = 0;
+
+		start_time = vshadow_test_benchmark_get_timestamp();
+
+		if( vshadow_test_benchmark_read_multi_threaded(
+		     store,
+		     store_size,
+		     read_size,
+		     number_of_threads,
+		     &read_count,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		end_time = vshadow_test_benchmark_get_timestamp();
+
+		fprintf(
+		 stdout,
+		 "store: %d threads: %d\n",
+		 store_index + 1,
+		 number_of_threads );
+
+		vshadow_test_benchmark_result_fprint(
+		 stdout,
+		 store_index,
+		 "multi_threaded_read",
+		 read_count,
+		 ( read_count + read_size - 1 ) / read_size,
+		 end_time - start_time );
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	memory_free(
+	 buffer );
+
+	if( libvshadow_store_free(
+	     &store,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free store: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	libcerror_error_t *error          = NULL;
+	libvshadow_volume_t *volume       = NULL;
+	system_character_t *source        = NULL;
+	size64_t peak_resident_set_size   = 0;
+	size_t read_size                  = 65536;
+	system_integer_t option           = 0;
+	uint64_t end_time                 = 0;
+	uint64_t number_of_random_reads   = 4096;
+	uint64_t start_time               = 0;
+	uint64_t value_64bit              = 0;
+	int number_of_stores              = 0;
+	int number_of_threads             = 4;
+	int store_index                   = 0;
+	int store_number                  = 0;
+
+	while( ( option = vshadow_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:hn:s:t:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				vshadow_test_benchmark_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				vshadow_test_benchmark_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'b':
+			case (system_integer_t) 'n':
+			case (system_integer_t) 's':
+			case (system_integer_t) 't':
+				if( vshadow_test_benchmark_string_copy_to_64bit(
+				     optarg,
+				     &value_64bit,
+				     &error ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported value of argument: %" PRIs_SYSTEM ".\n",
+					 argv[ optind - 1 ] );
+
+					goto on_error;
+				}
+				if( option == (system_integer_t) 'b' )
+				{
+					if( ( value_64bit < 512 )
+					 || ( value_64bit > ( 64 * 1024 * 1024 ) ) )
+					{
+						fprintf(
+						 stderr,
+						 "Unsupported read size, value should be 512 - 67108864.\n" );
+
+						return( EXIT_FAILURE );
+					}
+					read_size = (size_t) value_64bit;
+				}
+				else if( option == (system_integer_t) 'n' )
+				{
+					number_of_random_reads = value_64bit;
+				}
+				else if( option == (system_integer_t) 's' )
+				{
+					if( ( value_64bit == 0 )
+					 || ( value_64bit > (uint64_t) INT_MAX ) )
+					{
+						fprintf(
+						 stderr,
+						 "Unsupported store number.\n" );
+
+						return( EXIT_FAILURE );
+					}
+					store_number = (int) value_64bit;
+				}
+				else
+				{
+					if( value_64bit > VSHADOW_TEST_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS )
+					{
+						fprintf(
+						 stderr,
+						 "Unsupported number of threads, value should be 0 - %d.\n",
+						 VSHADOW_TEST_BENCHMARK_MAXIMUM_NUMBER_OF_THREADS );
+
+						return( EXIT_FAILURE );
+					}
+					number_of_threads = (int) value_64bit;
+				}
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		vshadow_test_benchmark_usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	if( libvshadow_volume_initialize(
+	     &volume,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize volume.\n" );
+
+		goto on_error;
+	}
+	start_time = vshadow_test_benchmark_get_timestamp();
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvshadow_volume_open_wide(
+	     volume,
+	     source,
+	     LIBVSHADOW_OPEN_READ,
+	     &error ) != 1 )
+#else
+	if( libvshadow_volume_open(
+	     volume,
+	     source,
+	     LIBVSHADOW_OPEN_READ,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	end_time = vshadow_test_benchmark_get_timestamp();
+
+	if( libvshadow_volume_get_number_of_stores(
+	     volume,
+	     &number_of_stores,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve number of stores.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "open_time: %.6f\n",
+	 (double) ( end_time - start_time ) / 1000000000.0 );
+
+	fprintf(
+	 stdout,
+	 "number_of_stores: %d\n",
+	 number_of_stores );
+
+	fprintf(
+	 stdout,
+	 "read_size: %" PRIzd "\n",
+	 read_size );
+
+	if( store_number > number_of_stores )
+	{
+		fprintf(
+		 stderr,
+		 "No such store: %d.\n",
+		 store_number );
+
+		goto on_error;
+	}
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( ( store_number != 0 )
+		 && ( store_index != ( store_number - 1 ) ) )
+		{
+			continue;
+		}
+		if( vshadow_test_benchmark_store(
+		     volume,
+		     store_index,
+		     read_size,
+		     number_of_random_reads,
+		     number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to benchmark store: %d.\n",
+			 store_index + 1 );
+
+			goto on_error;
+		}
+	}
+	if( libvshadow_volume_close(
+	     volume,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close volume.\n" );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_free(
+	     &volume,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free volume.\n" );
+
+		goto on_error;
+	}
+	if( vshadow_test_benchmark_get_peak_resident_set_size(
+	     &peak_resident_set_size ) == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "peak_resident_set_size: %" PRIu64 "\n",
+		 peak_resident_set_size );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
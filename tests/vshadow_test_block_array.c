@@ -0,0 +1,833 @@
+/*
+ * Library block_array type test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_block_array.h"
+#include "../libvshadow/libvshadow_block_descriptor.h"
+#include "../libvshadow/libvshadow_block_table.h"
+
+#define VSHADOW_TEST_BLOCK_ARRAY_NUMBER_OF_BLOCK_DESCRIPTORS	256
+
+#if defined( __GNUC__ )
+
+/* Tests the libvshadow_block_array_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_array_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libvshadow_block_array_t *block_array = NULL;
+	int result                            = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_array_initialize(
+	          &block_array,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_array",
+	 block_array );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_array_free(
+	          &block_array,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_array",
+	 block_array );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_array_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	block_array = (libvshadow_block_array_t *) 0x12345678UL;
+
+	result = libvshadow_block_array_initialize(
+	          &block_array,
+	          &error );
+
+	block_array = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_array != NULL )
+	{
+		libvshadow_block_array_free(
+		 &block_array,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_array_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_array_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_array_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_array_build_from_table, libvshadow_block_array_get_block_descriptor_by_index
+ * and libvshadow_block_array_get_block_descriptor_at_offset functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_array_build_from_table(
+     void )
+{
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_array_t *block_array                    = NULL;
+	libvshadow_block_descriptor_t *block_descriptor          = NULL;
+	libvshadow_block_descriptor_t *existing_block_descriptor = NULL;
+	libvshadow_block_table_t *block_table                    = NULL;
+	off64_t offset                                           = 0;
+	int block_descriptor_index                               = 0;
+	int first_block_descriptor_index                         = 0;
+	int number_of_block_descriptors                          = 0;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_block_table_initialize(
+	          &block_table,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_table",
+	 block_table );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Insert the block descriptors out of order, block 0 is left unused
+	 */
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < VSHADOW_TEST_BLOCK_ARRAY_NUMBER_OF_BLOCK_DESCRIPTORS;
+	     block_descriptor_index++ )
+	{
+		result = libvshadow_block_descriptor_initialize(
+		          &block_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		offset = (off64_t) ( ( ( block_descriptor_index * 97 ) % VSHADOW_TEST_BLOCK_ARRAY_NUMBER_OF_BLOCK_DESCRIPTORS ) + 1 ) * 0x4000;
+
+		block_descriptor->original_offset = offset;
+
+		result = libvshadow_block_table_insert_block_descriptor(
+		          block_table,
+		          offset,
+		          block_descriptor,
+		          &existing_block_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		block_descriptor = NULL;
+	}
+	result = libvshadow_block_array_initialize(
+	          &block_array,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_array_build_from_table(
+	          block_array,
+	          block_table,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_table_get_number_of_block_descriptors(
+	          block_table,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_array_get_number_of_block_descriptors(
+	          block_array,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 VSHADOW_TEST_BLOCK_ARRAY_NUMBER_OF_BLOCK_DESCRIPTORS );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < VSHADOW_TEST_BLOCK_ARRAY_NUMBER_OF_BLOCK_DESCRIPTORS;
+	     block_descriptor_index++ )
+	{
+		result = libvshadow_block_array_get_block_descriptor_by_index(
+		          block_array,
+		          block_descriptor_index,
+		          &block_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "block_descriptor",
+		 block_descriptor );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT64(
+		 "block_descriptor->original_offset",
+		 (int64_t) block_descriptor->original_offset,
+		 (int64_t) ( block_descriptor_index + 1 ) * 0x4000 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	block_descriptor = NULL;
+
+	result = libvshadow_block_array_get_block_descriptor_at_offset(
+	          block_array,
+	          0x8123,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "block_descriptor->original_offset",
+	 (int64_t) block_descriptor->original_offset,
+	 (int64_t) 0x8000 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	block_descriptor = NULL;
+
+	result = libvshadow_block_array_get_block_descriptor_at_offset(
+	          block_array,
+	          0x1000,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_array_get_block_descriptor_at_offset(
+	          block_array,
+	          (off64_t) ( VSHADOW_TEST_BLOCK_ARRAY_NUMBER_OF_BLOCK_DESCRIPTORS + 1 ) * 0x4000,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_array_get_block_descriptor_indexes_in_range(
+	          block_array,
+	          0x8123,
+	          0x4000,
+	          &first_block_descriptor_index,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_block_descriptor_index",
+	 first_block_descriptor_index,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_array_get_block_descriptor_indexes_in_range(
+	          block_array,
+	          0x1000,
+	          0x3000,
+	          &first_block_descriptor_index,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_block_descriptor_index",
+	 first_block_descriptor_index,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_array_get_block_descriptor_indexes_in_range(
+	          block_array,
+	          0x8000,
+	          0,
+	          &first_block_descriptor_index,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_block_descriptor_index",
+	 first_block_descriptor_index,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_array_get_block_descriptor_indexes_in_range(
+	          block_array,
+	          0,
+	          (size64_t) -1,
+	          &first_block_descriptor_index,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_block_descriptor_index",
+	 first_block_descriptor_index,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 VSHADOW_TEST_BLOCK_ARRAY_NUMBER_OF_BLOCK_DESCRIPTORS );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_array_build_from_table(
+	          NULL,
+	          block_table,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_array_build_from_table(
+	          block_array,
+	          block_table,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_array_get_block_descriptor_by_index(
+	          block_array,
+	          -1,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_array_get_block_descriptor_by_index(
+	          block_array,
+	          VSHADOW_TEST_BLOCK_ARRAY_NUMBER_OF_BLOCK_DESCRIPTORS,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_array_get_block_descriptor_at_offset(
+	          NULL,
+	          0x8000,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_array_get_block_descriptor_at_offset(
+	          block_array,
+	          -1,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_array_get_block_descriptor_at_offset(
+	          block_array,
+	          0x8000,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_array_get_block_descriptor_indexes_in_range(
+	          NULL,
+	          0x8000,
+	          0x4000,
+	          &first_block_descriptor_index,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_array_get_block_descriptor_indexes_in_range(
+	          block_array,
+	          -1,
+	          0x4000,
+	          &first_block_descriptor_index,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_array_get_block_descriptor_indexes_in_range(
+	          block_array,
+	          0x8000,
+	          0x4000,
+	          NULL,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_array_get_block_descriptor_indexes_in_range(
+	          block_array,
+	          0x8000,
+	          0x4000,
+	          &first_block_descriptor_index,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_array_free(
+	          &block_array,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_array",
+	 block_array );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_table_free(
+	          &block_table,
+	          &libvshadow_block_descriptor_free,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_table",
+	 block_table );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_array != NULL )
+	{
+		libvshadow_block_array_free(
+		 &block_array,
+		 NULL );
+	}
+	if( block_table != NULL )
+	{
+		libvshadow_block_table_free(
+		 &block_table,
+		 &libvshadow_block_descriptor_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_array_initialize",
+	 vshadow_test_block_array_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_array_free",
+	 vshadow_test_block_array_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_array_build_from_table",
+	 vshadow_test_block_array_build_from_table );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
@@ -1474,6 +1474,258 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvshadow_block_descriptor_get_overlay_run function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_descriptor_get_overlay_run(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	size_t run_size                                 = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_block_descriptor_initialize(
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "block_descriptor",
+         block_descriptor );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Sectors 0 - 3 and 8 - 15 are stored in the overlay
+	 */
+	block_descriptor->bitmap = 0x0000ff0fUL;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_descriptor_get_overlay_run(
+	          block_descriptor,
+	          0,
+	          &run_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 2048 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libvshadow_block_descriptor_get_overlay_run(
+	          block_descriptor,
+	          100,
+	          &run_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 1948 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libvshadow_block_descriptor_get_overlay_run(
+	          block_descriptor,
+	          2048,
+	          &run_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 2048 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libvshadow_block_descriptor_get_overlay_run(
+	          block_descriptor,
+	          4106,
+	          &run_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 4086 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libvshadow_block_descriptor_get_overlay_run(
+	          block_descriptor,
+	          8192,
+	          &run_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 8192 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test a run that ends at the end of the block
+	 */
+	block_descriptor->bitmap = 0xffffffffUL;
+
+	result = libvshadow_block_descriptor_get_overlay_run(
+	          block_descriptor,
+	          512,
+	          &run_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 15872 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_descriptor_get_overlay_run(
+	          NULL,
+	          0,
+	          &run_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_get_overlay_run(
+	          block_descriptor,
+	          0x4000,
+	          &run_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_get_overlay_run(
+	          block_descriptor,
+	          0,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_descriptor_free(
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "block_descriptor",
+         block_descriptor );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_descriptor != NULL )
+	{
+		libvshadow_block_descriptor_free(
+		 &block_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) */
 
 /* The main program
@@ -1533,6 +1785,10 @@ int main(
 	 "libvshadow_block_descriptor_read_data",
 	 vshadow_test_block_descriptor_read_data );
 
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_descriptor_get_overlay_run",
+	 vshadow_test_block_descriptor_get_overlay_run );
+
 #endif /* defined( __GNUC__ ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,1052 @@
+/*
+ * Library block_table type test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_block_descriptor.h"
+#include "../libvshadow/libvshadow_block_table.h"
+
+#define VSHADOW_TEST_BLOCK_TABLE_NUMBER_OF_BLOCK_DESCRIPTORS	2048
+
+#if defined( __GNUC__ )
+
+/* Tests the libvshadow_block_table_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_table_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libvshadow_block_table_t *block_table = NULL;
+	int result                            = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_table_initialize(
+	          &block_table,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_table",
+	 block_table );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_table_free(
+	          &block_table,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_table",
+	 block_table );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_table_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	block_table = (libvshadow_block_table_t *) 0x12345678UL;
+
+	result = libvshadow_block_table_initialize(
+	          &block_table,
+	          &error );
+
+	block_table = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_table != NULL )
+	{
+		libvshadow_block_table_free(
+		 &block_table,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_table_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_table_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_table_free(
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_table_insert_block_descriptor, libvshadow_block_table_get_block_descriptor_by_offset
+ * and libvshadow_block_table_remove_block_descriptor functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_table_insert_block_descriptor(
+     void )
+{
+	libvshadow_block_descriptor_t block_descriptors[ VSHADOW_TEST_BLOCK_TABLE_NUMBER_OF_BLOCK_DESCRIPTORS ];
+
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_descriptor_t *existing_block_descriptor = NULL;
+	libvshadow_block_table_t *block_table                    = NULL;
+	off64_t offset                                           = 0;
+	int block_descriptor_index                               = 0;
+	int number_of_block_descriptors                          = 0;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_block_table_initialize(
+	          &block_table,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_table",
+	 block_table );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_table_get_block_descriptor_by_offset(
+	          block_table,
+	          0,
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Insert enough block descriptors for the table to be resized several times
+	 * with offsets that are not consecutive to spread the probe sequences
+	 */
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < VSHADOW_TEST_BLOCK_TABLE_NUMBER_OF_BLOCK_DESCRIPTORS;
+	     block_descriptor_index++ )
+	{
+		offset = (off64_t) ( ( block_descriptor_index * 7919 ) % 65536 ) * 0x4000;
+
+		block_descriptors[ block_descriptor_index ].relative_offset = offset;
+
+		result = libvshadow_block_table_insert_block_descriptor(
+		          block_table,
+		          offset,
+		          &( block_descriptors[ block_descriptor_index ] ),
+		          &existing_block_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libvshadow_block_table_get_number_of_block_descriptors(
+	          block_table,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 VSHADOW_TEST_BLOCK_TABLE_NUMBER_OF_BLOCK_DESCRIPTORS );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Inserting an existing offset returns the existing block descriptor
+	 */
+	result = libvshadow_block_table_insert_block_descriptor(
+	          block_table,
+	          block_descriptors[ 5 ].relative_offset,
+	          &( block_descriptors[ 6 ] ),
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INTPTR(
+	 "existing_block_descriptor",
+	 (intptr_t *) existing_block_descriptor,
+	 (intptr_t *) &( block_descriptors[ 5 ] ) );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Remove every other block descriptor
+	 */
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < VSHADOW_TEST_BLOCK_TABLE_NUMBER_OF_BLOCK_DESCRIPTORS;
+	     block_descriptor_index += 2 )
+	{
+		result = libvshadow_block_table_remove_block_descriptor(
+		          block_table,
+		          block_descriptors[ block_descriptor_index ].relative_offset,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The remaining block descriptors must still be found after the removals
+	 */
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < VSHADOW_TEST_BLOCK_TABLE_NUMBER_OF_BLOCK_DESCRIPTORS;
+	     block_descriptor_index++ )
+	{
+		result = libvshadow_block_table_get_block_descriptor_by_offset(
+		          block_table,
+		          block_descriptors[ block_descriptor_index ].relative_offset,
+		          &existing_block_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 block_descriptor_index % 2 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result != 0 )
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INTPTR(
+			 "existing_block_descriptor",
+			 (intptr_t *) existing_block_descriptor,
+			 (intptr_t *) &( block_descriptors[ block_descriptor_index ] ) );
+		}
+	}
+	result = libvshadow_block_table_get_number_of_block_descriptors(
+	          block_table,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 VSHADOW_TEST_BLOCK_TABLE_NUMBER_OF_BLOCK_DESCRIPTORS / 2 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_table_insert_block_descriptor(
+	          NULL,
+	          0,
+	          &( block_descriptors[ 0 ] ),
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_table_insert_block_descriptor(
+	          block_table,
+	          -1,
+	          &( block_descriptors[ 0 ] ),
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_table_insert_block_descriptor(
+	          block_table,
+	          0,
+	          NULL,
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_table_insert_block_descriptor(
+	          block_table,
+	          0,
+	          &( block_descriptors[ 0 ] ),
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test removing an offset that is not in the table
+	 */
+	result = libvshadow_block_table_remove_block_descriptor(
+	          block_table,
+	          block_descriptors[ 0 ].relative_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_table_free(
+	          &block_table,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_table",
+	 block_table );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_table != NULL )
+	{
+		libvshadow_block_table_free(
+		 &block_table,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_table_get_block_descriptor_at_offset and
+ * libvshadow_block_table_replace_block_descriptor functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_table_get_block_descriptor_at_offset(
+     void )
+{
+	libvshadow_block_descriptor_t block_descriptors[ 3 ];
+
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_descriptor_t *existing_block_descriptor = NULL;
+	libvshadow_block_table_t *block_table                    = NULL;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_block_table_initialize(
+	          &block_table,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_table",
+	 block_table );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_table_insert_block_descriptor(
+	          block_table,
+	          0x00010000,
+	          &( block_descriptors[ 0 ] ),
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_table_get_block_descriptor_at_offset(
+	          block_table,
+	          0x00012345,
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INTPTR(
+	 "existing_block_descriptor",
+	 (intptr_t *) existing_block_descriptor,
+	 (intptr_t *) &( block_descriptors[ 0 ] ) );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_table_get_block_descriptor_at_offset(
+	          block_table,
+	          0x00014000,
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a block that does not start at a block boundary
+	 */
+	result = libvshadow_block_table_insert_block_descriptor(
+	          block_table,
+	          0x00022000,
+	          &( block_descriptors[ 1 ] ),
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_table_get_block_descriptor_at_offset(
+	          block_table,
+	          0x00025fff,
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INTPTR(
+	 "existing_block_descriptor",
+	 (intptr_t *) existing_block_descriptor,
+	 (intptr_t *) &( block_descriptors[ 1 ] ) );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_table_get_block_descriptor_at_offset(
+	          block_table,
+	          0x00026000,
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test replacing a block descriptor
+	 */
+	result = libvshadow_block_table_replace_block_descriptor(
+	          block_table,
+	          0x00010000,
+	          &( block_descriptors[ 2 ] ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_table_get_block_descriptor_at_offset(
+	          block_table,
+	          0x00010000,
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INTPTR(
+	 "existing_block_descriptor",
+	 (intptr_t *) existing_block_descriptor,
+	 (intptr_t *) &( block_descriptors[ 2 ] ) );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_table_get_block_descriptor_at_offset(
+	          NULL,
+	          0x00010000,
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_table_get_block_descriptor_at_offset(
+	          block_table,
+	          -1,
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_table_get_block_descriptor_at_offset(
+	          block_table,
+	          0x00010000,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_table_replace_block_descriptor(
+	          block_table,
+	          0x00030000,
+	          &( block_descriptors[ 2 ] ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_table_free(
+	          &block_table,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_table",
+	 block_table );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_table != NULL )
+	{
+		libvshadow_block_table_free(
+		 &block_table,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_table_move_block_descriptors function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_table_move_block_descriptors(
+     void )
+{
+	libvshadow_block_descriptor_t block_descriptors[ 3 ];
+	libvshadow_block_descriptor_t *moved_block_descriptors[ 3 ];
+
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_descriptor_t *existing_block_descriptor = NULL;
+	libvshadow_block_table_t *block_table                    = NULL;
+	int block_descriptor_index                               = 0;
+	int number_of_block_descriptors                          = 0;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_block_table_initialize(
+	          &block_table,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_table",
+	 block_table );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < 3;
+	     block_descriptor_index++ )
+	{
+		result = libvshadow_block_table_insert_block_descriptor(
+		          block_table,
+		          (off64_t) block_descriptor_index * 0x4000,
+		          &( block_descriptors[ block_descriptor_index ] ),
+		          &existing_block_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libvshadow_block_table_move_block_descriptors(
+	          NULL,
+	          moved_block_descriptors,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_table_move_block_descriptors(
+	          block_table,
+	          NULL,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_table_move_block_descriptors(
+	          block_table,
+	          moved_block_descriptors,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_table_move_block_descriptors(
+	          block_table,
+	          moved_block_descriptors,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < 3;
+	     block_descriptor_index++ )
+	{
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "moved_block_descriptors[ block_descriptor_index ]",
+		 moved_block_descriptors[ block_descriptor_index ] );
+	}
+	result = libvshadow_block_table_get_number_of_block_descriptors(
+	          block_table,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_table_get_block_descriptor_by_offset(
+	          block_table,
+	          0x4000,
+	          &existing_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_table_free(
+	          &block_table,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_table",
+	 block_table );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_table != NULL )
+	{
+		libvshadow_block_table_free(
+		 &block_table,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_table_initialize",
+	 vshadow_test_block_table_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_table_free",
+	 vshadow_test_block_table_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_table_insert_block_descriptor",
+	 vshadow_test_block_table_insert_block_descriptor );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_table_get_block_descriptor_at_offset",
+	 vshadow_test_block_table_get_block_descriptor_at_offset );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_table_move_block_descriptors",
+	 vshadow_test_block_table_move_block_descriptors );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
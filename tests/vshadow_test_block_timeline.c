@@ -0,0 +1,855 @@
+/*
+ * Library block_timeline type test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_block_timeline.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libvshadow_block_timeline_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_timeline_initialize(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libvshadow_block_timeline_t *block_timeline = NULL;
+	int result                                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_timeline_initialize(
+	          &block_timeline,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_timeline",
+	 block_timeline );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_timeline_free(
+	          &block_timeline,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_timeline",
+	 block_timeline );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_timeline_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	block_timeline = (libvshadow_block_timeline_t *) 0x12345678UL;
+
+	result = libvshadow_block_timeline_initialize(
+	          &block_timeline,
+	          &error );
+
+	block_timeline = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_timeline != NULL )
+	{
+		libvshadow_block_timeline_free(
+		 &block_timeline,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_timeline_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_timeline_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_timeline_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_timeline_build function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_timeline_build(
+     void )
+{
+	off64_t store1_block_offsets[ 3 ]    = { 0x00000000, 0x00004000, 0x00010000 };
+	off64_t store2_block_offsets[ 2 ]    = { 0x00004000, 0x00008000 };
+	off64_t store3_block_offsets[ 2 ]    = { 0x00004100, 0x00020000 };
+	off64_t unsorted_block_offsets[ 2 ]  = { 0x00008000, 0x00004000 };
+	off64_t negative_block_offsets[ 1 ]  = { -1 };
+	off64_t *store_block_offsets[ 66 ];
+	int store_number_of_block_offsets[ 66 ];
+
+	libcerror_error_t *error                    = NULL;
+	libvshadow_block_timeline_t *block_timeline = NULL;
+	int number_of_blocks                        = 0;
+	int result                                  = 0;
+	int store_index                             = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_block_timeline_initialize(
+	          &block_timeline,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_timeline",
+	 block_timeline );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	store_block_offsets[ 0 ]           = store1_block_offsets;
+	store_number_of_block_offsets[ 0 ] = 3;
+	store_block_offsets[ 1 ]           = store2_block_offsets;
+	store_number_of_block_offsets[ 1 ] = 2;
+	store_block_offsets[ 2 ]           = store3_block_offsets;
+	store_number_of_block_offsets[ 2 ] = 2;
+
+	result = libvshadow_block_timeline_build(
+	          block_timeline,
+	          store_block_offsets,
+	          store_number_of_block_offsets,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_timeline_get_number_of_blocks(
+	          block_timeline,
+	          &number_of_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 5 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_timeline_build(
+	          NULL,
+	          store_block_offsets,
+	          store_number_of_block_offsets,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test build with blocks value already set
+	 */
+	result = libvshadow_block_timeline_build(
+	          block_timeline,
+	          store_block_offsets,
+	          store_number_of_block_offsets,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_timeline_free(
+	          &block_timeline,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_timeline",
+	 block_timeline );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test build with block offsets that are not sorted
+	 */
+	result = libvshadow_block_timeline_initialize(
+	          &block_timeline,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	store_block_offsets[ 1 ] = unsorted_block_offsets;
+
+	result = libvshadow_block_timeline_build(
+	          block_timeline,
+	          store_block_offsets,
+	          store_number_of_block_offsets,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test build with a negative block offset
+	 */
+	store_block_offsets[ 1 ]           = negative_block_offsets;
+	store_number_of_block_offsets[ 1 ] = 1;
+
+	result = libvshadow_block_timeline_build(
+	          block_timeline,
+	          store_block_offsets,
+	          store_number_of_block_offsets,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test build with more than 64 stores
+	 */
+	for( store_index = 0;
+	     store_index < 66;
+	     store_index++ )
+	{
+		store_block_offsets[ store_index ]           = NULL;
+		store_number_of_block_offsets[ store_index ] = 0;
+	}
+	store_block_offsets[ 0 ]            = store2_block_offsets;
+	store_number_of_block_offsets[ 0 ]  = 2;
+	store_block_offsets[ 65 ]           = store3_block_offsets;
+	store_number_of_block_offsets[ 65 ] = 2;
+
+	result = libvshadow_block_timeline_build(
+	          block_timeline,
+	          store_block_offsets,
+	          store_number_of_block_offsets,
+	          66,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_timeline_get_number_of_blocks(
+	          block_timeline,
+	          &number_of_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 3 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_timeline_free(
+	          &block_timeline,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_timeline",
+	 block_timeline );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_timeline != NULL )
+	{
+		libvshadow_block_timeline_free(
+		 &block_timeline,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_timeline_get_block_offset_by_index, libvshadow_block_timeline_get_block_index_at_offset
+ * and libvshadow_block_timeline_get_store_indexes functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_timeline_get_store_indexes(
+     void )
+{
+	off64_t store1_block_offsets[ 3 ] = { 0x00000000, 0x00004000, 0x00010000 };
+	off64_t store2_block_offsets[ 2 ] = { 0x00004000, 0x00008000 };
+	off64_t store3_block_offsets[ 2 ] = { 0x00004100, 0x00020000 };
+	off64_t *store_block_offsets[ 3 ];
+	int store_number_of_block_offsets[ 3 ];
+	int store_indexes[ 3 ];
+
+	libcerror_error_t *error                    = NULL;
+	libvshadow_block_timeline_t *block_timeline = NULL;
+	off64_t block_offset                        = 0;
+	int block_index                             = 0;
+	int number_of_changed_stores                = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	store_block_offsets[ 0 ]           = store1_block_offsets;
+	store_number_of_block_offsets[ 0 ] = 3;
+	store_block_offsets[ 1 ]           = store2_block_offsets;
+	store_number_of_block_offsets[ 1 ] = 2;
+	store_block_offsets[ 2 ]           = store3_block_offsets;
+	store_number_of_block_offsets[ 2 ] = 2;
+
+	result = libvshadow_block_timeline_initialize(
+	          &block_timeline,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_timeline_build(
+	          block_timeline,
+	          store_block_offsets,
+	          store_number_of_block_offsets,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_timeline_get_block_offset_by_index(
+	          block_timeline,
+	          2,
+	          &block_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "block_offset",
+	 (int64_t) block_offset,
+	 (int64_t) 0x00008000 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_timeline_get_block_index_at_offset(
+	          block_timeline,
+	          0x00005000,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index",
+	 block_index,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_timeline_get_store_indexes(
+	          block_timeline,
+	          block_index,
+	          store_indexes,
+	          3,
+	          &number_of_changed_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_changed_stores",
+	 number_of_changed_stores,
+	 3 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_indexes[ 2 ]",
+	 store_indexes[ 2 ],
+	 2 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_timeline_get_block_index_at_offset(
+	          block_timeline,
+	          0x00020000,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index",
+	 block_index,
+	 4 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_timeline_get_store_indexes(
+	          block_timeline,
+	          block_index,
+	          store_indexes,
+	          3,
+	          &number_of_changed_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_changed_stores",
+	 number_of_changed_stores,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_indexes[ 0 ]",
+	 store_indexes[ 0 ],
+	 2 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test retrieving the number of changed stores only
+	 */
+	result = libvshadow_block_timeline_get_store_indexes(
+	          block_timeline,
+	          1,
+	          NULL,
+	          0,
+	          &number_of_changed_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_changed_stores",
+	 number_of_changed_stores,
+	 3 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a block that was not changed
+	 */
+	result = libvshadow_block_timeline_get_block_index_at_offset(
+	          block_timeline,
+	          0x0000c000,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_timeline_get_block_index_at_offset(
+	          block_timeline,
+	          0x00040000,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_timeline_get_block_offset_by_index(
+	          block_timeline,
+	          5,
+	          &block_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_timeline_get_block_index_at_offset(
+	          block_timeline,
+	          -1,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_timeline_get_store_indexes(
+	          block_timeline,
+	          1,
+	          store_indexes,
+	          2,
+	          &number_of_changed_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_timeline_get_store_indexes(
+	          block_timeline,
+	          1,
+	          store_indexes,
+	          3,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_timeline_free(
+	          &block_timeline,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_timeline",
+	 block_timeline );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_timeline != NULL )
+	{
+		libvshadow_block_timeline_free(
+		 &block_timeline,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_timeline_initialize",
+	 vshadow_test_block_timeline_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_timeline_free",
+	 vshadow_test_block_timeline_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_timeline_build",
+	 vshadow_test_block_timeline_build );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_timeline_get_store_indexes",
+	 vshadow_test_block_timeline_get_store_indexes );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -35,6 +35,7 @@
 #include "vshadow_test_unused.h"
 
 #include "../libvshadow/libvshadow_block_descriptor.h"
+#include "../libvshadow/libvshadow_block_table.h"
 #include "../libvshadow/libvshadow_block_tree.h"
 #include "../libvshadow/libvshadow_definitions.h"
 
@@ -46,17 +47,16 @@
 int vshadow_test_block_tree_insert(
      void )
 {
-	libcdata_btree_t *forward_block_tree            = NULL;
-	libcdata_btree_t *reverse_block_tree            = NULL;
 	libcerror_error_t *error                        = NULL;
 	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	libvshadow_block_table_t *forward_block_table   = NULL;
+	libvshadow_block_table_t *reverse_block_table   = NULL;
 	int result                                      = 0;
 
 	/* Initialize test
 	 */
-	result = libcdata_btree_initialize(
-	          &forward_block_tree,
-	          LIBVSHADOW_BLOCK_DESCRIPTORS_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
+	result = libvshadow_block_table_initialize(
+	          &forward_block_table,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -65,16 +65,15 @@ int vshadow_test_block_tree_insert(
 	 1 );
 
         VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "forward_block_tree",
-         forward_block_tree );
+         "forward_block_table",
+         forward_block_table );
 
         VSHADOW_TEST_ASSERT_IS_NULL(
          "error",
          error );
 
-	result = libcdata_btree_initialize(
-	          &reverse_block_tree,
-	          LIBVSHADOW_BLOCK_DESCRIPTORS_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
+	result = libvshadow_block_table_initialize(
+	          &reverse_block_table,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -83,8 +82,8 @@ int vshadow_test_block_tree_insert(
 	 1 );
 
         VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "reverse_block_tree",
-         reverse_block_tree );
+         "reverse_block_table",
+         reverse_block_table );
 
         VSHADOW_TEST_ASSERT_IS_NULL(
          "error",
@@ -118,8 +117,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x00000000;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -142,8 +141,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x00000000;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -166,8 +165,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0xff000000;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -190,8 +189,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x00ff0000;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -214,8 +213,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x00000000;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -238,8 +237,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x000000ff;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -262,8 +261,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x0000ff00;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -286,8 +285,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x00000000;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -310,8 +309,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x00000000;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -334,8 +333,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x00000000;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -358,8 +357,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x00000000;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -382,8 +381,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x00000000;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -406,8 +405,8 @@ int vshadow_test_block_tree_insert(
 	block_descriptor->bitmap          = 0x00000000;
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -425,7 +424,7 @@ int vshadow_test_block_tree_insert(
 	 */
 	result = libvshadow_block_tree_insert(
 	          NULL,
-	          reverse_block_tree,
+	          reverse_block_table,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -443,7 +442,7 @@ int vshadow_test_block_tree_insert(
 	 &error );
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
+	          forward_block_table,
 	          NULL,
 	          block_descriptor,
 	          0,
@@ -462,8 +461,8 @@ int vshadow_test_block_tree_insert(
 	 &error );
 
 	result = libvshadow_block_tree_insert(
-	          forward_block_tree,
-	          reverse_block_tree,
+	          forward_block_table,
+	          reverse_block_table,
 	          NULL,
 	          0,
 	          &error );
@@ -482,9 +481,9 @@ int vshadow_test_block_tree_insert(
 
 	/* Clean up
 	 */
-	result = libcdata_btree_free(
-	          &reverse_block_tree,
-	          (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free_reverse,
+	result = libvshadow_block_table_free(
+	          &reverse_block_table,
+	          &libvshadow_block_descriptor_free_reverse,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -493,16 +492,16 @@ int vshadow_test_block_tree_insert(
 	 1 );
 
         VSHADOW_TEST_ASSERT_IS_NULL(
-         "reverse_block_tree",
-         reverse_block_tree );
+         "reverse_block_table",
+         reverse_block_table );
 
         VSHADOW_TEST_ASSERT_IS_NULL(
          "error",
          error );
 
-	result = libcdata_btree_free(
-	          &forward_block_tree,
-	          (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+	result = libvshadow_block_table_free(
+	          &forward_block_table,
+	          &libvshadow_block_descriptor_free,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -511,8 +510,8 @@ int vshadow_test_block_tree_insert(
 	 1 );
 
         VSHADOW_TEST_ASSERT_IS_NULL(
-         "forward_block_tree",
-         forward_block_tree );
+         "forward_block_table",
+         forward_block_table );
 
         VSHADOW_TEST_ASSERT_IS_NULL(
          "error",
@@ -532,18 +531,18 @@ on_error:
 		 &block_descriptor,
 		 NULL );
 	}
-	if( reverse_block_tree != NULL )
+	if( reverse_block_table != NULL )
 	{
-		libcdata_btree_free(
-		 &reverse_block_tree,
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free_reverse,
+		libvshadow_block_table_free(
+		 &reverse_block_table,
+		 &libvshadow_block_descriptor_free_reverse,
 		 NULL );
 	}
-	if( forward_block_tree != NULL )
+	if( forward_block_table != NULL )
 	{
-		libcdata_btree_free(
-		 &forward_block_tree,
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+		libvshadow_block_table_free(
+		 &forward_block_table,
+		 &libvshadow_block_descriptor_free,
 		 NULL );
 	}
 	return( 0 );
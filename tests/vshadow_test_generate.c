@@ -0,0 +1,2833 @@
+/*
+ * Generates synthetic Volume Shadow Snapshot (VSS) volume images
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* The generator simulates a volume that is written to between consecutive
+ * snapshots and records the copy-on-write activity in the same on-disk
+ * structures Windows uses: the volume header, the catalog, and per store a
+ * header, block list, block range list, current and previous bitmap and
+ * the store data blocks. Changes are either full block writes, partial
+ * (overlay) writes or block moves (forwarders).
+ *
+ * The volume is split into the data area, which starts after the block
+ * containing the volume header, and the diff area, which contains the catalog
+ * and the store data and metadata. The last block of the volume is reserved.
+ *
+ * Every 512-byte sector written by the simulation gets an unique content
+ * identifier and its data is derived from that identifier, so that sector
+ * data is never all 0-byte values. When expected content is requested the
+ * state of the volume at the time of every snapshot is written to a file
+ * named <prefix>.vss<number> where sectors that have no defined content,
+ * such as unallocated blocks and the diff area, are 0-byte values and
+ * should be ignored when verifying.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_getopt.h"
+#include "vshadow_test_libcerror.h"
+
+#include "../libvshadow/libvshadow_definitions.h"
+#include "../libvshadow/vshadow_catalog.h"
+#include "../libvshadow/vshadow_store.h"
+#include "../libvshadow/vshadow_volume.h"
+
+#define VSHADOW_TEST_GENERATE_BLOCK_SIZE		0x4000
+#define VSHADOW_TEST_GENERATE_SECTOR_SIZE		512
+#define VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK		32
+
+/* The number of usable bytes in a store block after the store block header
+ */
+#define VSHADOW_TEST_GENERATE_BLOCK_DATA_SIZE		( VSHADOW_TEST_GENERATE_BLOCK_SIZE - sizeof( vshadow_store_block_header_t ) )
+
+#define VSHADOW_TEST_GENERATE_BLOCK_LIST_ENTRIES_PER_BLOCK	( VSHADOW_TEST_GENERATE_BLOCK_DATA_SIZE / sizeof( vshadow_store_block_list_entry_t ) )
+#define VSHADOW_TEST_GENERATE_RANGE_LIST_ENTRIES_PER_BLOCK	( VSHADOW_TEST_GENERATE_BLOCK_DATA_SIZE / sizeof( vshadow_store_block_range_list_entry_t ) )
+#define VSHADOW_TEST_GENERATE_BITMAP_BITS_PER_BLOCK		( VSHADOW_TEST_GENERATE_BLOCK_DATA_SIZE * 8 )
+
+/* The catalog reader only considers the first 63 entries of a catalog block
+ * hence store entry pairs are limited to 31 per catalog block
+ */
+#define VSHADOW_TEST_GENERATE_STORES_PER_CATALOG_BLOCK	31
+
+/* The maximum number of stores
+ */
+#define VSHADOW_TEST_GENERATE_MAXIMUM_NUMBER_OF_STORES	512
+
+/* The block state flags
+ */
+enum VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAGS
+{
+	VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_ALLOCATED	= 0x01,
+	VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_CHANGED		= 0x02
+};
+
+const uint8_t vshadow_test_generate_vss_identifier[ 16 ] = {
+	0x6b, 0x87, 0x08, 0x38, 0x76, 0xc1, 0x48, 0x4e, 0xb7, 0xae, 0x04, 0x04, 0x6e, 0x6c, 0xc7, 0x52 };
+
+/* The FILETIME of January 1, 2017 00:00:00 UTC
+ */
+#define VSHADOW_TEST_GENERATE_BASE_CREATION_TIME	0x01d263b6dd04c000ULL
+
+typedef struct vshadow_test_generate_store vshadow_test_generate_store_t;
+
+struct vshadow_test_generate_store
+{
+	/* The store identifier
+	 */
+	uint8_t identifier[ 16 ];
+
+	/* The creation time
+	 */
+	uint64_t creation_time;
+
+	/* The store header offset
+	 */
+	off64_t header_offset;
+
+	/* The block list offset
+	 */
+	off64_t block_list_offset;
+
+	/* The block range list offset
+	 */
+	off64_t block_range_list_offset;
+
+	/* The bitmap offset
+	 */
+	off64_t bitmap_offset;
+
+	/* The previous bitmap offset
+	 */
+	off64_t previous_bitmap_offset;
+
+	/* The next relative (store) offset
+	 */
+	uint64_t relative_offset;
+
+	/* The block list entries data
+	 */
+	uint8_t *block_list_data;
+
+	/* The number of block list entries
+	 */
+	size_t number_of_block_list_entries;
+
+	/* The maximum number of block list entries
+	 */
+	size_t maximum_number_of_block_list_entries;
+
+	/* The block range list entries data
+	 */
+	uint8_t *block_range_list_data;
+
+	/* The number of block range list entries
+	 */
+	size_t number_of_block_range_list_entries;
+
+	/* The maximum number of block range list entries
+	 */
+	size_t maximum_number_of_block_range_list_entries;
+
+	/* The end offset of the last block range
+	 */
+	off64_t last_range_end_offset;
+
+	/* The relative end offset of the last block range
+	 */
+	uint64_t last_range_relative_end_offset;
+
+	/* Statistics
+	 */
+	uint64_t number_of_full_blocks;
+	uint64_t number_of_overlays;
+	uint64_t number_of_forwarders;
+	uint64_t number_of_chained_forwarders;
+	uint64_t number_of_unused_entries;
+	uint64_t number_of_data_blocks;
+};
+
+typedef struct vshadow_test_generator vshadow_test_generator_t;
+
+struct vshadow_test_generator
+{
+	/* The image stream
+	 */
+	FILE *image_stream;
+
+	/* The expected content filename prefix
+	 */
+	const system_character_t *expected_prefix;
+
+	/* The volume size
+	 */
+	size64_t volume_size;
+
+	/* The number of blocks
+	 */
+	uint64_t number_of_blocks;
+
+	/* The index of the first block after the data area
+	 */
+	uint64_t data_area_end;
+
+	/* The sector content identifiers of the data area
+	 */
+	uint32_t *sector_contents;
+
+	/* The next sector content identifier
+	 */
+	uint32_t next_content_identifier;
+
+	/* The block state flags of the data area
+	 */
+	uint8_t *block_states;
+
+	/* The index of the last store with a non-overlay entry per block
+	 */
+	int *last_entry_store;
+
+	/* The diff area block slots
+	 */
+	uint64_t *diff_area_slots;
+
+	/* The number of diff area block slots
+	 */
+	uint64_t number_of_diff_area_slots;
+
+	/* The next diff area block slot
+	 */
+	uint64_t next_diff_area_slot;
+
+	/* The current and previous allocation bitmaps
+	 */
+	uint8_t *current_bitmap;
+	uint8_t *previous_bitmap;
+
+	/* The bitmap size
+	 */
+	size_t bitmap_size;
+
+	/* The catalog block offsets
+	 */
+	off64_t *catalog_block_offsets;
+
+	/* The number of catalog blocks
+	 */
+	int number_of_catalog_blocks;
+
+	/* The stores
+	 */
+	vshadow_test_generate_store_t *stores;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The percentage of the volume in use before the first snapshot
+	 */
+	int allocation_percentage;
+
+	/* The percentage of the data area written between snapshots
+	 */
+	int churn_percentage;
+
+	/* The fragmentation percentage
+	 */
+	int fragmentation_percentage;
+
+	/* The percentage of changes that are block moves (forwarders)
+	 */
+	int forwarder_percentage;
+
+	/* The percentage of changes that are partial block writes (overlays)
+	 */
+	int overlay_percentage;
+
+	/* The seed
+	 */
+	uint64_t seed;
+
+	/* The pseudo random number generator state
+	 */
+	uint64_t random_state;
+
+	/* The block buffer
+	 */
+	uint8_t block_buffer[ VSHADOW_TEST_GENERATE_BLOCK_SIZE ];
+};
+
+/* Prints usage information
+ */
+void vshadow_test_generate_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadow_test_generate to generate a synthetic Volume Shadow\n"
+	                 "Snapshot (VSS) volume image.\n\n" );
+
+	fprintf( stream, "Usage: vshadow_test_generate [ -a percentage ] [ -c percentage ]\n"
+	                 "                             [ -e prefix ] [ -f percentage ]\n"
+	                 "                             [ -F percentage ] [ -n number ]\n"
+	                 "                             [ -o percentage ] [ -s size ]\n"
+	                 "                             [ -S seed ] [ -h ] target\n\n" );
+
+	fprintf( stream, "\ttarget: the volume image file\n\n" );
+	fprintf( stream, "\t-a:     percentage of the volume in use before the first snapshot\n"
+	                 "\t        (default is 75)\n" );
+	fprintf( stream, "\t-c:     churn, percentage of the volume written between consecutive\n"
+	                 "\t        snapshots (default is 10)\n" );
+	fprintf( stream, "\t-e:     write the expected content of every store to <prefix>.vss<number>\n" );
+	fprintf( stream, "\t-f:     fragmentation percentage of the changes and the diff area\n"
+	                 "\t        (default is 0)\n" );
+	fprintf( stream, "\t-F:     percentage of changes that are block moves (default is 5)\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-n:     number of stores (default is 4)\n" );
+	fprintf( stream, "\t-o:     percentage of changes that are partial block writes\n"
+	                 "\t        (default is 10)\n" );
+	fprintf( stream, "\t-s:     volume size in bytes, supports K, M, G and T suffixes\n"
+	                 "\t        (default is 64M)\n" );
+	fprintf( stream, "\t-S:     seed of the pseudo random number generator (default is 1)\n" );
+}
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Supports the K, M, G and T size suffixes if allow_suffix is set
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_string_copy_to_64bit(
+     const system_character_t *string,
+     uint64_t *value_64bit,
+     int allow_suffix,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_generate_string_copy_to_64bit";
+	size_t string_index   = 0;
+	uint64_t value        = 0;
+	uint8_t shift         = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( string[ string_index ] >= (system_character_t) '0' )
+	    && ( string[ string_index ] <= (system_character_t) '9' ) )
+	{
+		if( value > ( ( (uint64_t) UINT64_MAX - 9 ) / 10 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		value *= 10;
+		value += (uint64_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		string_index++;
+	}
+	if( string_index == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing digits.",
+		 function );
+
+		return( -1 );
+	}
+	if( allow_suffix != 0 )
+	{
+		switch( string[ string_index ] )
+		{
+			case (system_character_t) 'k':
+			case (system_character_t) 'K':
+				shift = 10;
+				break;
+
+			case (system_character_t) 'm':
+			case (system_character_t) 'M':
+				shift = 20;
+				break;
+
+			case (system_character_t) 'g':
+			case (system_character_t) 'G':
+				shift = 30;
+				break;
+
+			case (system_character_t) 't':
+			case (system_character_t) 'T':
+				shift = 40;
+				break;
+
+			default:
+				break;
+		}
+		if( shift != 0 )
+		{
+			if( value > ( (uint64_t) UINT64_MAX >> shift ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			value <<= shift;
+
+			string_index++;
+		}
+	}
+	if( string[ string_index ] != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported trailing characters.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = value;
+
+	return( 1 );
+}
+
+/* Copies a string of a percentage to an integer value
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_string_copy_to_percentage(
+     const system_character_t *string,
+     int *percentage,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_generate_string_copy_to_percentage";
+	uint64_t value_64bit  = 0;
+
+	if( percentage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid percentage.",
+		 function );
+
+		return( -1 );
+	}
+	if( vshadow_test_generate_string_copy_to_64bit(
+	     string,
+	     &value_64bit,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > 100 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: percentage value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*percentage = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Retrieves the next pseudo random value
+ * Uses the xorshift64* algorithm
+ */
+uint64_t vshadow_test_generate_random(
+          vshadow_test_generator_t *generator )
+{
+	uint64_t value = generator->random_state;
+
+	value ^= value >> 12;
+	value ^= value << 25;
+	value ^= value >> 27;
+
+	generator->random_state = value;
+
+	return( value * 0x2545f4914f6cdd1dULL );
+}
+
+/* Mixes a 64-bit value
+ * Uses the splitmix64 finalizer
+ */
+uint64_t vshadow_test_generate_mix(
+          uint64_t value )
+{
+	value += 0x9e3779b97f4a7c15ULL;
+	value  = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+	value  = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebULL;
+
+	return( value ^ ( value >> 31 ) );
+}
+
+/* Fills a sector with the data of a content identifier
+ * A content identifier of 0 represents a sector without defined content
+ */
+void vshadow_test_generate_fill_sector(
+      vshadow_test_generator_t *generator,
+      uint8_t *sector_data,
+      uint32_t content_identifier )
+{
+	uint64_t value_64bit = 0;
+	size_t data_offset   = 0;
+
+	if( content_identifier == 0 )
+	{
+		memory_set(
+		 sector_data,
+		 0,
+		 VSHADOW_TEST_GENERATE_SECTOR_SIZE );
+
+		return;
+	}
+	/* The first 8 bytes contain a "VSSG" signature and the content identifier
+	 * so that the sector data is never all 0-byte values
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 sector_data,
+	 0x4753535600000000ULL | (uint64_t) content_identifier );
+
+	value_64bit = vshadow_test_generate_mix(
+	               generator->seed ^ ( (uint64_t) content_identifier << 20 ) );
+
+	for( data_offset = 8;
+	     data_offset < VSHADOW_TEST_GENERATE_SECTOR_SIZE;
+	     data_offset += 8 )
+	{
+		value_64bit = vshadow_test_generate_mix(
+		               value_64bit );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( sector_data[ data_offset ] ),
+		 value_64bit );
+	}
+}
+
+/* Fills the block buffer with the current content of a data area block
+ * Returns 1 if the block has defined content or 0 if not
+ */
+int vshadow_test_generate_fill_block(
+     vshadow_test_generator_t *generator,
+     uint64_t block_index )
+{
+	uint32_t *sector_contents = NULL;
+	int result                = 0;
+	int sector_index          = 0;
+
+	sector_contents = &( generator->sector_contents[ block_index * VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK ] );
+
+	for( sector_index = 0;
+	     sector_index < VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK;
+	     sector_index++ )
+	{
+		vshadow_test_generate_fill_sector(
+		 generator,
+		 &( generator->block_buffer[ sector_index * VSHADOW_TEST_GENERATE_SECTOR_SIZE ] ),
+		 sector_contents[ sector_index ] );
+
+		if( sector_contents[ sector_index ] != 0 )
+		{
+			result = 1;
+		}
+	}
+	return( result );
+}
+
+/* Assigns new content to sectors of a data area block
+ * Only the sectors with a bit set in sector_bitmap are assigned
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_write_sectors(
+     vshadow_test_generator_t *generator,
+     uint64_t block_index,
+     uint32_t sector_bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_generate_write_sectors";
+	int sector_index      = 0;
+
+	for( sector_index = 0;
+	     sector_index < VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK;
+	     sector_index++ )
+	{
+		if( ( sector_bitmap & ( (uint32_t) 1 << sector_index ) ) == 0 )
+		{
+			continue;
+		}
+		if( generator->next_content_identifier == UINT32_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: too many sector writes - reduce volume size, number of stores or churn.",
+			 function );
+
+			return( -1 );
+		}
+		generator->sector_contents[ ( block_index * VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK ) + sector_index ] = generator->next_content_identifier++;
+	}
+	return( 1 );
+}
+
+/* Writes data to the image at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_write_at_offset(
+     FILE *stream,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_generate_write_at_offset";
+
+	if( file_stream_seek_offset(
+	     stream,
+	     offset,
+	     SEEK_SET ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( file_stream_write(
+	     stream,
+	     data,
+	     data_size ) != data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Allocates a block in the diff area
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_allocate_diff_area_block(
+     vshadow_test_generator_t *generator,
+     vshadow_test_generate_store_t *store,
+     off64_t *block_offset,
+     uint64_t *relative_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_generate_allocate_diff_area_block";
+	uint64_t slot_index   = 0;
+	uint64_t slot_value   = 0;
+
+	if( generator->next_diff_area_slot >= generator->number_of_diff_area_slots )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: diff area is full.",
+		 function );
+
+		return( -1 );
+	}
+	/* A fragmented diff area is simulated by handing out the remaining slots in random order
+	 */
+	if( (int) ( vshadow_test_generate_random( generator ) % 100 ) < generator->fragmentation_percentage )
+	{
+		slot_index = generator->next_diff_area_slot
+		           + ( vshadow_test_generate_random( generator ) % ( generator->number_of_diff_area_slots - generator->next_diff_area_slot ) );
+
+		slot_value = generator->diff_area_slots[ slot_index ];
+
+		generator->diff_area_slots[ slot_index ] = generator->diff_area_slots[ generator->next_diff_area_slot ];
+		generator->diff_area_slots[ generator->next_diff_area_slot ] = slot_value;
+	}
+	*block_offset = (off64_t) ( generator->diff_area_slots[ generator->next_diff_area_slot++ ] * VSHADOW_TEST_GENERATE_BLOCK_SIZE );
+
+	if( store != NULL )
+	{
+		*relative_offset        = store->relative_offset;
+		store->relative_offset += VSHADOW_TEST_GENERATE_BLOCK_SIZE;
+	}
+	else
+	{
+		*relative_offset = 0;
+	}
+	return( 1 );
+}
+
+/* Appends a block list entry to a store
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_append_block_list_entry(
+     vshadow_test_generate_store_t *store,
+     uint64_t original_offset,
+     uint64_t relative_offset,
+     uint64_t offset,
+     uint32_t flags,
+     uint32_t allocation_bitmap,
+     libcerror_error_t **error )
+{
+	vshadow_store_block_list_entry_t *entry = NULL;
+	uint8_t *reallocation                   = NULL;
+	static char *function                   = "vshadow_test_generate_append_block_list_entry";
+	size_t maximum_number_of_entries        = 0;
+
+	if( store->number_of_block_list_entries >= store->maximum_number_of_block_list_entries )
+	{
+		maximum_number_of_entries = store->maximum_number_of_block_list_entries * 2;
+
+		if( maximum_number_of_entries == 0 )
+		{
+			maximum_number_of_entries = VSHADOW_TEST_GENERATE_BLOCK_LIST_ENTRIES_PER_BLOCK;
+		}
+		reallocation = (uint8_t *) memory_reallocate(
+		                            store->block_list_data,
+		                            sizeof( vshadow_store_block_list_entry_t ) * maximum_number_of_entries );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize block list data.",
+			 function );
+
+			return( -1 );
+		}
+		store->block_list_data                      = reallocation;
+		store->maximum_number_of_block_list_entries = maximum_number_of_entries;
+	}
+	entry = &( ( (vshadow_store_block_list_entry_t *) store->block_list_data )[ store->number_of_block_list_entries ] );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 entry->original_offset,
+	 original_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 entry->relative_offset,
+	 relative_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 entry->offset,
+	 offset );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 entry->flags,
+	 flags );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 entry->allocation_bitmap,
+	 allocation_bitmap );
+
+	store->number_of_block_list_entries += 1;
+
+	return( 1 );
+}
+
+/* Appends a store data block to the block range list of a store
+ * Adjacent store data blocks are merged into a single block range
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_append_block_range(
+     vshadow_test_generate_store_t *store,
+     off64_t offset,
+     uint64_t relative_offset,
+     libcerror_error_t **error )
+{
+	vshadow_store_block_range_list_entry_t *entry = NULL;
+	uint8_t *reallocation                         = NULL;
+	static char *function                         = "vshadow_test_generate_append_block_range";
+	size_t maximum_number_of_entries              = 0;
+	uint64_t range_size                           = 0;
+
+	if( ( store->number_of_block_range_list_entries > 0 )
+	 && ( store->last_range_end_offset == offset )
+	 && ( store->last_range_relative_end_offset == relative_offset ) )
+	{
+		entry = &( ( (vshadow_store_block_range_list_entry_t *) store->block_range_list_data )[ store->number_of_block_range_list_entries - 1 ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 entry->size,
+		 range_size );
+
+		range_size += VSHADOW_TEST_GENERATE_BLOCK_SIZE;
+
+		byte_stream_copy_from_uint64_little_endian(
+		 entry->size,
+		 range_size );
+	}
+	else
+	{
+		if( store->number_of_block_range_list_entries >= store->maximum_number_of_block_range_list_entries )
+		{
+			maximum_number_of_entries = store->maximum_number_of_block_range_list_entries * 2;
+
+			if( maximum_number_of_entries == 0 )
+			{
+				maximum_number_of_entries = VSHADOW_TEST_GENERATE_RANGE_LIST_ENTRIES_PER_BLOCK;
+			}
+			reallocation = (uint8_t *) memory_reallocate(
+			                            store->block_range_list_data,
+			                            sizeof( vshadow_store_block_range_list_entry_t ) * maximum_number_of_entries );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize block range list data.",
+				 function );
+
+				return( -1 );
+			}
+			store->block_range_list_data                      = reallocation;
+			store->maximum_number_of_block_range_list_entries = maximum_number_of_entries;
+		}
+		entry = &( ( (vshadow_store_block_range_list_entry_t *) store->block_range_list_data )[ store->number_of_block_range_list_entries ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 entry->offset,
+		 (uint64_t) offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 entry->relative_offset,
+		 relative_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 entry->size,
+		 (uint64_t) VSHADOW_TEST_GENERATE_BLOCK_SIZE );
+
+		store->number_of_block_range_list_entries += 1;
+	}
+	store->last_range_end_offset          = offset + VSHADOW_TEST_GENERATE_BLOCK_SIZE;
+	store->last_range_relative_end_offset = relative_offset + VSHADOW_TEST_GENERATE_BLOCK_SIZE;
+
+	return( 1 );
+}
+
+/* Copies the current content of a data area block into a new store data block
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_copy_on_write(
+     vshadow_test_generator_t *generator,
+     vshadow_test_generate_store_t *store,
+     uint64_t block_index,
+     off64_t *store_block_offset,
+     uint64_t *store_relative_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_generate_copy_on_write";
+
+	if( vshadow_test_generate_allocate_diff_area_block(
+	     generator,
+	     store,
+	     store_block_offset,
+	     store_relative_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to allocate store data block.",
+		 function );
+
+		return( -1 );
+	}
+	vshadow_test_generate_fill_block(
+	 generator,
+	 block_index );
+
+	if( vshadow_test_generate_write_at_offset(
+	     generator->image_stream,
+	     *store_block_offset,
+	     generator->block_buffer,
+	     VSHADOW_TEST_GENERATE_BLOCK_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write store data block.",
+		 function );
+
+		return( -1 );
+	}
+	if( vshadow_test_generate_append_block_range(
+	     store,
+	     *store_block_offset,
+	     *store_relative_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append block range.",
+		 function );
+
+		return( -1 );
+	}
+	store->number_of_data_blocks += 1;
+
+	return( 1 );
+}
+
+/* Finds a data area block that has never been allocated and was not changed since the last snapshot
+ * Returns 1 if found, 0 if not or -1 on error
+ */
+int vshadow_test_generate_find_unallocated_block(
+     vshadow_test_generator_t *generator,
+     uint64_t *block_index )
+{
+	uint64_t candidate_index = 0;
+	int attempt              = 0;
+
+	for( attempt = 0;
+	     attempt < 16;
+	     attempt++ )
+	{
+		candidate_index = 1 + ( vshadow_test_generate_random( generator ) % ( generator->data_area_end - 1 ) );
+
+		if( generator->block_states[ candidate_index ] == 0 )
+		{
+			*block_index = candidate_index;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Changes a data area block between snapshots and records the copy-on-write activity in the store
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_change_block(
+     vshadow_test_generator_t *generator,
+     int store_index,
+     uint64_t block_index,
+     uint64_t *number_of_changed_blocks,
+     libcerror_error_t **error )
+{
+	vshadow_test_generate_store_t *store = NULL;
+	static char *function                = "vshadow_test_generate_change_block";
+	off64_t store_block_offset           = 0;
+	uint64_t change_type                 = 0;
+	uint64_t store_relative_offset       = 0;
+	uint64_t target_block_index          = 0;
+	uint32_t sector_bitmap               = 0;
+	uint8_t sector_count                 = 0;
+	uint8_t sector_index                 = 0;
+	int result                           = 0;
+
+	store = &( generator->stores[ store_index ] );
+
+	if( ( generator->block_states[ block_index ] & VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_ALLOCATED ) == 0 )
+	{
+		/* Blocks that were not in use at the time of a snapshot are not preserved
+		 */
+		if( vshadow_test_generate_write_sectors(
+		     generator,
+		     block_index,
+		     0xffffffffUL,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		generator->block_states[ block_index ] = VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_ALLOCATED
+		                                       | VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_CHANGED;
+
+		*number_of_changed_blocks += 1;
+
+		return( 1 );
+	}
+	change_type = vshadow_test_generate_random( generator ) % 100;
+
+	if( change_type < (uint64_t) generator->forwarder_percentage )
+	{
+		/* Move the block to a block that was not in use and overwrite the original block
+		 */
+		result = vshadow_test_generate_find_unallocated_block(
+		          generator,
+		          &target_block_index );
+
+		if( result != 0 )
+		{
+			if( vshadow_test_generate_append_block_list_entry(
+			     store,
+			     block_index * VSHADOW_TEST_GENERATE_BLOCK_SIZE,
+			     target_block_index * VSHADOW_TEST_GENERATE_BLOCK_SIZE,
+			     0,
+			     LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER,
+			     0,
+			     error ) != 1 )
+			{
+				goto on_error;
+			}
+			if( memory_copy(
+			     &( generator->sector_contents[ target_block_index * VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK ] ),
+			     &( generator->sector_contents[ block_index * VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK ] ),
+			     sizeof( uint32_t ) * VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy sector contents.",
+				 function );
+
+				goto on_error;
+			}
+			generator->block_states[ target_block_index ] = VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_ALLOCATED
+			                                              | VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_CHANGED;
+
+			store->number_of_forwarders += 1;
+
+			/* Occasionally the moved block is overwritten again before the next snapshot,
+			 * which results in a store data block of the target that maps back to the original block
+			 */
+			if( ( vshadow_test_generate_random( generator ) % 4 ) == 0 )
+			{
+				if( vshadow_test_generate_copy_on_write(
+				     generator,
+				     store,
+				     target_block_index,
+				     &store_block_offset,
+				     &store_relative_offset,
+				     error ) != 1 )
+				{
+					goto on_error;
+				}
+				if( vshadow_test_generate_append_block_list_entry(
+				     store,
+				     target_block_index * VSHADOW_TEST_GENERATE_BLOCK_SIZE,
+				     store_relative_offset,
+				     (uint64_t) store_block_offset,
+				     0,
+				     0,
+				     error ) != 1 )
+				{
+					goto on_error;
+				}
+				if( vshadow_test_generate_write_sectors(
+				     generator,
+				     target_block_index,
+				     0xffffffffUL,
+				     error ) != 1 )
+				{
+					goto on_error;
+				}
+				store->number_of_chained_forwarders += 1;
+			}
+			if( vshadow_test_generate_write_sectors(
+			     generator,
+			     block_index,
+			     0xffffffffUL,
+			     error ) != 1 )
+			{
+				goto on_error;
+			}
+			generator->block_states[ block_index ] |= VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_CHANGED;
+			generator->last_entry_store[ block_index ] = store_index;
+
+			*number_of_changed_blocks += 2;
+
+			return( 1 );
+		}
+	}
+	else if( change_type < (uint64_t) ( generator->forwarder_percentage + generator->overlay_percentage ) )
+	{
+		/* Overlays are only honoured when reading the store itself, hence only
+		 * create them when no older store can fall through to this store
+		 */
+		if( ( store_index == 0 )
+		 || ( generator->last_entry_store[ block_index ] == ( store_index - 1 ) ) )
+		{
+			if( ( vshadow_test_generate_random( generator ) % 2 ) == 0 )
+			{
+				sector_bitmap = (uint32_t) vshadow_test_generate_random( generator );
+			}
+			else
+			{
+				sector_index = (uint8_t) ( vshadow_test_generate_random( generator ) % VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK );
+				sector_count = (uint8_t) ( 1 + ( vshadow_test_generate_random( generator ) % ( VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK - 1 ) ) );
+
+				sector_bitmap = (uint32_t) ( ( ( (uint64_t) 1 << sector_count ) - 1 ) << sector_index );
+			}
+			if( sector_bitmap == 0 )
+			{
+				sector_bitmap = 0x00000001UL;
+			}
+			else if( sector_bitmap == 0xffffffffUL )
+			{
+				sector_bitmap = 0xfffffffeUL;
+			}
+			if( vshadow_test_generate_copy_on_write(
+			     generator,
+			     store,
+			     block_index,
+			     &store_block_offset,
+			     &store_relative_offset,
+			     error ) != 1 )
+			{
+				goto on_error;
+			}
+			if( vshadow_test_generate_append_block_list_entry(
+			     store,
+			     block_index * VSHADOW_TEST_GENERATE_BLOCK_SIZE,
+			     1,
+			     (uint64_t) store_block_offset,
+			     LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY,
+			     sector_bitmap,
+			     error ) != 1 )
+			{
+				goto on_error;
+			}
+			if( vshadow_test_generate_write_sectors(
+			     generator,
+			     block_index,
+			     sector_bitmap,
+			     error ) != 1 )
+			{
+				goto on_error;
+			}
+			generator->block_states[ block_index ] |= VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_CHANGED;
+
+			store->number_of_overlays += 1;
+
+			*number_of_changed_blocks += 1;
+
+			return( 1 );
+		}
+	}
+	/* Overwrite the entire block
+	 */
+	if( vshadow_test_generate_copy_on_write(
+	     generator,
+	     store,
+	     block_index,
+	     &store_block_offset,
+	     &store_relative_offset,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( vshadow_test_generate_append_block_list_entry(
+	     store,
+	     block_index * VSHADOW_TEST_GENERATE_BLOCK_SIZE,
+	     store_relative_offset,
+	     (uint64_t) store_block_offset,
+	     0,
+	     0,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( vshadow_test_generate_write_sectors(
+	     generator,
+	     block_index,
+	     0xffffffffUL,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	generator->block_states[ block_index ] |= VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_CHANGED;
+	generator->last_entry_store[ block_index ] = store_index;
+
+	store->number_of_full_blocks += 1;
+
+	*number_of_changed_blocks += 1;
+
+	/* Occasionally add an entry that is marked as not used
+	 */
+	if( ( vshadow_test_generate_random( generator ) % 64 ) == 0 )
+	{
+		if( vshadow_test_generate_append_block_list_entry(
+		     store,
+		     ( 1 + ( vshadow_test_generate_random( generator ) % ( generator->data_area_end - 1 ) ) ) * VSHADOW_TEST_GENERATE_BLOCK_SIZE,
+		     store_relative_offset,
+		     (uint64_t) store_block_offset,
+		     LIBVSHADOW_BLOCK_FLAG_NOT_USED,
+		     0,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		store->number_of_unused_entries += 1;
+	}
+	return( 1 );
+
+on_error:
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+	 "%s: unable to change block: %" PRIu64 ".",
+	 function,
+	 block_index );
+
+	return( -1 );
+}
+
+/* Builds the allocation bitmap of the current state of the volume
+ * A bit is set for every block that does not need to be preserved
+ */
+void vshadow_test_generate_build_bitmap(
+      vshadow_test_generator_t *generator,
+      uint8_t *bitmap )
+{
+	uint64_t block_index = 0;
+
+	memory_set(
+	 bitmap,
+	 0,
+	 generator->bitmap_size );
+
+	for( block_index = 1;
+	     block_index < generator->number_of_blocks;
+	     block_index++ )
+	{
+		if( ( block_index >= generator->data_area_end )
+		 || ( ( generator->block_states[ block_index ] & VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_ALLOCATED ) == 0 ) )
+		{
+			bitmap[ block_index / 8 ] |= (uint8_t) ( 1 << ( block_index % 8 ) );
+		}
+	}
+}
+
+/* Writes a chain of store metadata blocks
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_write_store_chain(
+     vshadow_test_generator_t *generator,
+     vshadow_test_generate_store_t *store,
+     uint32_t record_type,
+     const uint8_t *data,
+     size_t data_size,
+     size_t block_data_size,
+     off64_t *first_block_offset,
+     libcerror_error_t **error )
+{
+	vshadow_store_block_header_t *block_header = NULL;
+	off64_t *block_offsets                     = NULL;
+	static char *function                      = "vshadow_test_generate_write_store_chain";
+	size_t data_offset                         = 0;
+	size_t number_of_blocks                    = 0;
+	size_t block_index                         = 0;
+	size_t read_size                           = 0;
+	uint64_t *relative_offsets                 = NULL;
+
+	number_of_blocks = ( data_size + block_data_size - 1 ) / block_data_size;
+
+	if( number_of_blocks == 0 )
+	{
+		number_of_blocks = 1;
+	}
+	block_offsets = (off64_t *) memory_allocate(
+	                             sizeof( off64_t ) * number_of_blocks );
+
+	relative_offsets = (uint64_t *) memory_allocate(
+	                                 sizeof( uint64_t ) * number_of_blocks );
+
+	if( ( block_offsets == NULL )
+	 || ( relative_offsets == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block offsets.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( vshadow_test_generate_allocate_diff_area_block(
+		     generator,
+		     store,
+		     &( block_offsets[ block_index ] ),
+		     &( relative_offsets[ block_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to allocate store metadata block.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	block_header = (vshadow_store_block_header_t *) generator->block_buffer;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		memory_set(
+		 generator->block_buffer,
+		 0,
+		 VSHADOW_TEST_GENERATE_BLOCK_SIZE );
+
+		memory_copy(
+		 block_header->identifier,
+		 vshadow_test_generate_vss_identifier,
+		 16 );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 block_header->version,
+		 1 );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 block_header->record_type,
+		 record_type );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 block_header->relative_offset,
+		 relative_offsets[ block_index ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 block_header->offset,
+		 (uint64_t) block_offsets[ block_index ] );
+
+		if( ( block_index + 1 ) < number_of_blocks )
+		{
+			byte_stream_copy_from_uint64_little_endian(
+			 block_header->next_offset,
+			 (uint64_t) block_offsets[ block_index + 1 ] );
+		}
+		read_size = data_size - data_offset;
+
+		if( read_size > block_data_size )
+		{
+			read_size = block_data_size;
+		}
+		if( read_size > 0 )
+		{
+			memory_copy(
+			 &( generator->block_buffer[ sizeof( vshadow_store_block_header_t ) ] ),
+			 &( data[ data_offset ] ),
+			 read_size );
+
+			data_offset += read_size;
+		}
+		if( vshadow_test_generate_write_at_offset(
+		     generator->image_stream,
+		     block_offsets[ block_index ],
+		     generator->block_buffer,
+		     VSHADOW_TEST_GENERATE_BLOCK_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write store metadata block.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*first_block_offset = block_offsets[ 0 ];
+
+	memory_free(
+	 relative_offsets );
+	memory_free(
+	 block_offsets );
+
+	return( 1 );
+
+on_error:
+	if( relative_offsets != NULL )
+	{
+		memory_free(
+		 relative_offsets );
+	}
+	if( block_offsets != NULL )
+	{
+		memory_free(
+		 block_offsets );
+	}
+	return( -1 );
+}
+
+/* Writes the bitmap of a store as a chain of store bitmap blocks
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_write_store_bitmap(
+     vshadow_test_generator_t *generator,
+     vshadow_test_generate_store_t *store,
+     const uint8_t *bitmap,
+     off64_t *bitmap_offset,
+     libcerror_error_t **error )
+{
+	static char *function  = "vshadow_test_generate_write_store_bitmap";
+	size_t block_data_size = 0;
+
+	/* The bitmap is stored as 32-bit little-endian values, which maps
+	 * to the same byte order as the bitmap buffer
+	 */
+	block_data_size = VSHADOW_TEST_GENERATE_BITMAP_BITS_PER_BLOCK / 8;
+
+	if( vshadow_test_generate_write_store_chain(
+	     generator,
+	     store,
+	     LIBVSHADOW_RECORD_TYPE_STORE_BITMAP,
+	     bitmap,
+	     generator->bitmap_size,
+	     block_data_size,
+	     bitmap_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write store bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the header of a store
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_write_store_header(
+     vshadow_test_generator_t *generator,
+     vshadow_test_generate_store_t *store,
+     int store_index,
+     libcerror_error_t **error )
+{
+	uint8_t store_information_data[ 256 ];
+
+	vshadow_store_information_t *store_information = NULL;
+	const char *machine_string                     = "vshadow-test-generate";
+	static char *function                          = "vshadow_test_generate_write_store_header";
+	size_t machine_string_index                    = 0;
+	size_t machine_string_length                   = 0;
+	size_t store_information_size                  = 0;
+	int string_index                               = 0;
+
+	memory_set(
+	 store_information_data,
+	 0,
+	 256 );
+
+	store_information = (vshadow_store_information_t *) store_information_data;
+
+	byte_stream_copy_from_uint64_little_endian(
+	 store_information->copy_identifier,
+	 vshadow_test_generate_mix( generator->seed ^ 0x636f7079ULL ^ (uint64_t) store_index ) );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( store_information->copy_identifier[ 8 ] ),
+	 vshadow_test_generate_mix( generator->seed ^ 0x636f7080ULL ^ (uint64_t) store_index ) );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 store_information->copy_set_identifier,
+	 vshadow_test_generate_mix( generator->seed ^ 0x73657400ULL ^ (uint64_t) store_index ) );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( store_information->copy_set_identifier[ 8 ] ),
+	 vshadow_test_generate_mix( generator->seed ^ 0x73657401ULL ^ (uint64_t) store_index ) );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 store_information->type,
+	 0x0000000dUL );
+
+	/* VSS_VOLSNAP_ATTR_DIFFERENTIAL | VSS_VOLSNAP_ATTR_AUTORECOVER
+	 * | VSS_VOLSNAP_ATTR_CLIENT_ACCESSIBLE | VSS_VOLSNAP_ATTR_PERSISTENT
+	 * | VSS_VOLSNAP_ATTR_NO_AUTO_RELEASE
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 store_information->attribute_flags,
+	 0x0042000dUL );
+
+	store_information_size = sizeof( vshadow_store_information_t );
+
+	machine_string_length = narrow_string_length(
+	                         machine_string );
+
+	/* The operating and service machine strings are UTF-16 little-endian without end-of-string character
+	 */
+	for( string_index = 0;
+	     string_index < 2;
+	     string_index++ )
+	{
+		byte_stream_copy_from_uint16_little_endian(
+		 &( store_information_data[ store_information_size ] ),
+		 (uint16_t) ( machine_string_length * 2 ) );
+
+		store_information_size += 2;
+
+		for( machine_string_index = 0;
+		     machine_string_index < machine_string_length;
+		     machine_string_index++ )
+		{
+			store_information_data[ store_information_size ] = (uint8_t) machine_string[ machine_string_index ];
+
+			store_information_size += 2;
+		}
+	}
+	if( vshadow_test_generate_write_store_chain(
+	     generator,
+	     store,
+	     LIBVSHADOW_RECORD_TYPE_STORE_HEADER,
+	     store_information_data,
+	     store_information_size,
+	     VSHADOW_TEST_GENERATE_BLOCK_DATA_SIZE,
+	     &( store->header_offset ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write store header.",
+		 function );
+
+		return( -1 );
+	}
+	/* The size of the store information is stored in the first store block header
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (vshadow_store_block_header_t *) generator->block_buffer )->unknown1,
+	 (uint64_t) store_information_size );
+
+	if( vshadow_test_generate_write_at_offset(
+	     generator->image_stream,
+	     store->header_offset,
+	     generator->block_buffer,
+	     sizeof( vshadow_store_block_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write store header.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the metadata of a store
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_write_store_metadata(
+     vshadow_test_generator_t *generator,
+     int store_index,
+     libcerror_error_t **error )
+{
+	vshadow_test_generate_store_t *store = NULL;
+	static char *function                = "vshadow_test_generate_write_store_metadata";
+
+	store = &( generator->stores[ store_index ] );
+
+	if( vshadow_test_generate_write_store_header(
+	     generator,
+	     store,
+	     store_index,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( vshadow_test_generate_write_store_chain(
+	     generator,
+	     store,
+	     LIBVSHADOW_RECORD_TYPE_STORE_INDEX,
+	     store->block_list_data,
+	     store->number_of_block_list_entries * sizeof( vshadow_store_block_list_entry_t ),
+	     VSHADOW_TEST_GENERATE_BLOCK_LIST_ENTRIES_PER_BLOCK * sizeof( vshadow_store_block_list_entry_t ),
+	     &( store->block_list_offset ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( vshadow_test_generate_write_store_chain(
+	     generator,
+	     store,
+	     LIBVSHADOW_RECORD_TYPE_STORE_BLOCK_RANGE,
+	     store->block_range_list_data,
+	     store->number_of_block_range_list_entries * sizeof( vshadow_store_block_range_list_entry_t ),
+	     VSHADOW_TEST_GENERATE_RANGE_LIST_ENTRIES_PER_BLOCK * sizeof( vshadow_store_block_range_list_entry_t ),
+	     &( store->block_range_list_offset ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( vshadow_test_generate_write_store_bitmap(
+	     generator,
+	     store,
+	     generator->current_bitmap,
+	     &( store->bitmap_offset ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( store_index > 0 )
+	{
+		if( vshadow_test_generate_write_store_bitmap(
+		     generator,
+		     store,
+		     generator->previous_bitmap,
+		     &( store->previous_bitmap_offset ),
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_WRITE_FAILED,
+	 "%s: unable to write metadata of store: %d.",
+	 function,
+	 store_index );
+
+	return( -1 );
+}
+
+/* Writes the expected content of the volume at the time of a snapshot
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_write_expected_content(
+     vshadow_test_generator_t *generator,
+     int store_index,
+     const uint8_t *volume_header_data,
+     libcerror_error_t **error )
+{
+	system_character_t filename[ 1024 ];
+
+	FILE *stream          = NULL;
+	static char *function = "vshadow_test_generate_write_expected_content";
+	uint64_t block_index  = 0;
+	int print_count       = 0;
+
+	print_count = system_string_sprintf(
+	               filename,
+	               1024,
+	               _SYSTEM_STRING( "%" ) _SYSTEM_STRING( PRIs_SYSTEM ) _SYSTEM_STRING( ".vss%d" ),
+	               generator->expected_prefix,
+	               store_index + 1 );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= 1024 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set expected content filename.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	stream = file_stream_open_wide(
+	          filename,
+	          L"wb" );
+#else
+	stream = file_stream_open(
+	          filename,
+	          "wb" );
+#endif
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open expected content file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	/* The first block only has defined content where the volume header is stored
+	 */
+	if( vshadow_test_generate_write_at_offset(
+	     stream,
+	     (off64_t) 0x1e00,
+	     volume_header_data,
+	     sizeof( vshadow_volume_header_t ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( block_index = 1;
+	     block_index < generator->data_area_end;
+	     block_index++ )
+	{
+		if( ( generator->block_states[ block_index ] & VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_ALLOCATED ) == 0 )
+		{
+			continue;
+		}
+		if( vshadow_test_generate_fill_block(
+		     generator,
+		     block_index ) == 0 )
+		{
+			continue;
+		}
+		if( vshadow_test_generate_write_at_offset(
+		     stream,
+		     (off64_t) ( block_index * VSHADOW_TEST_GENERATE_BLOCK_SIZE ),
+		     generator->block_buffer,
+		     VSHADOW_TEST_GENERATE_BLOCK_SIZE,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	/* Make sure the file has the size of the volume
+	 */
+	memory_set(
+	 generator->block_buffer,
+	 0,
+	 VSHADOW_TEST_GENERATE_SECTOR_SIZE );
+
+	if( vshadow_test_generate_write_at_offset(
+	     stream,
+	     (off64_t) ( generator->volume_size - VSHADOW_TEST_GENERATE_SECTOR_SIZE ),
+	     generator->block_buffer,
+	     VSHADOW_TEST_GENERATE_SECTOR_SIZE,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( file_stream_close(
+	     stream ) != 0 )
+	{
+		stream = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close expected content file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( stream != NULL )
+	{
+		file_stream_close(
+		 stream );
+	}
+	return( -1 );
+}
+
+/* Sets the volume header data
+ */
+void vshadow_test_generate_set_volume_header_data(
+      vshadow_test_generator_t *generator,
+      uint8_t *volume_header_data )
+{
+	vshadow_volume_header_t *volume_header = NULL;
+
+	memory_set(
+	 volume_header_data,
+	 0,
+	 sizeof( vshadow_volume_header_t ) );
+
+	volume_header = (vshadow_volume_header_t *) volume_header_data;
+
+	memory_copy(
+	 volume_header->identifier,
+	 vshadow_test_generate_vss_identifier,
+	 16 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 volume_header->version,
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 volume_header->record_type,
+	 LIBVSHADOW_RECORD_TYPE_VOLUME_HEADER );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 volume_header->offset,
+	 (uint64_t) 0x1e00 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 volume_header->unknown1,
+	 (uint64_t) 0x1e00 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 volume_header->catalog_offset,
+	 (uint64_t) generator->catalog_block_offsets[ 0 ] );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 volume_header->volume_identifier,
+	 vshadow_test_generate_mix( generator->seed ^ 0x766f6cULL ) );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( volume_header->volume_identifier[ 8 ] ),
+	 vshadow_test_generate_mix( generator->seed ^ 0x766f6dULL ) );
+
+	memory_copy(
+	 volume_header->store_volume_identifier,
+	 volume_header->volume_identifier,
+	 16 );
+}
+
+/* Writes the catalog
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_write_catalog(
+     vshadow_test_generator_t *generator,
+     libcerror_error_t **error )
+{
+	vshadow_catalog_header_t *catalog_header = NULL;
+	vshadow_test_generate_store_t *store     = NULL;
+	uint8_t *entry_data                      = NULL;
+	static char *function                    = "vshadow_test_generate_write_catalog";
+	int block_index                          = 0;
+	int store_index                          = 0;
+
+	catalog_header = (vshadow_catalog_header_t *) generator->block_buffer;
+
+	for( block_index = 0;
+	     block_index < generator->number_of_catalog_blocks;
+	     block_index++ )
+	{
+		memory_set(
+		 generator->block_buffer,
+		 0,
+		 VSHADOW_TEST_GENERATE_BLOCK_SIZE );
+
+		memory_copy(
+		 catalog_header->identifier,
+		 vshadow_test_generate_vss_identifier,
+		 16 );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 catalog_header->version,
+		 1 );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 catalog_header->record_type,
+		 LIBVSHADOW_RECORD_TYPE_CATALOG );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 catalog_header->relative_offset,
+		 (uint64_t) block_index * VSHADOW_TEST_GENERATE_BLOCK_SIZE );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 catalog_header->offset,
+		 (uint64_t) generator->catalog_block_offsets[ block_index ] );
+
+		if( ( block_index + 1 ) < generator->number_of_catalog_blocks )
+		{
+			byte_stream_copy_from_uint64_little_endian(
+			 catalog_header->next_offset,
+			 (uint64_t) generator->catalog_block_offsets[ block_index + 1 ] );
+		}
+		entry_data = &( generator->block_buffer[ sizeof( vshadow_catalog_header_t ) ] );
+
+		for( store_index = block_index * VSHADOW_TEST_GENERATE_STORES_PER_CATALOG_BLOCK;
+		     ( store_index < generator->number_of_stores )
+		  && ( store_index < ( ( block_index + 1 ) * VSHADOW_TEST_GENERATE_STORES_PER_CATALOG_BLOCK ) );
+		     store_index++ )
+		{
+			store = &( generator->stores[ store_index ] );
+
+			/* Catalog entry type 0x02
+			 */
+			byte_stream_copy_from_uint64_little_endian(
+			 entry_data,
+			 (uint64_t) 2 );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( entry_data[ 8 ] ),
+			 generator->volume_size );
+
+			memory_copy(
+			 &( entry_data[ 16 ] ),
+			 store->identifier,
+			 16 );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( entry_data[ 32 ] ),
+			 (uint64_t) store_index + 1 );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( entry_data[ 40 ] ),
+			 (uint64_t) 0x40 );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( entry_data[ 48 ] ),
+			 store->creation_time );
+
+			entry_data += 128;
+
+			/* Catalog entry type 0x03
+			 */
+			byte_stream_copy_from_uint64_little_endian(
+			 entry_data,
+			 (uint64_t) 3 );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( entry_data[ 8 ] ),
+			 (uint64_t) store->block_list_offset );
+
+			memory_copy(
+			 &( entry_data[ 16 ] ),
+			 store->identifier,
+			 16 );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( entry_data[ 32 ] ),
+			 (uint64_t) store->header_offset );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( entry_data[ 40 ] ),
+			 (uint64_t) store->block_range_list_offset );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( entry_data[ 48 ] ),
+			 (uint64_t) store->bitmap_offset );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( entry_data[ 64 ] ),
+			 store->relative_offset );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( entry_data[ 72 ] ),
+			 (uint64_t) store->previous_bitmap_offset );
+
+			entry_data += 128;
+		}
+		if( vshadow_test_generate_write_at_offset(
+		     generator->image_stream,
+		     generator->catalog_block_offsets[ block_index ],
+		     generator->block_buffer,
+		     VSHADOW_TEST_GENERATE_BLOCK_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write catalog block.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Determines the number of diff area blocks needed for a data area of a specific size
+ */
+uint64_t vshadow_test_generate_get_diff_area_size(
+          vshadow_test_generator_t *generator,
+          uint64_t number_of_data_blocks )
+{
+	uint64_t maximum_number_of_changes = 0;
+	uint64_t maximum_number_of_entries = 0;
+	uint64_t number_of_bitmap_blocks   = 0;
+	uint64_t store_size                = 0;
+
+	maximum_number_of_changes = ( ( number_of_data_blocks * generator->churn_percentage ) + 99 ) / 100;
+
+	/* Every change requires at most 1 entry, 1 store data block and 1 block range,
+	 * a chained forwarder consumes 2 changes, and 1 in 64 full writes adds an unused entry
+	 */
+	maximum_number_of_entries = maximum_number_of_changes + ( maximum_number_of_changes / 64 ) + 1;
+
+	number_of_bitmap_blocks = ( generator->number_of_blocks + VSHADOW_TEST_GENERATE_BITMAP_BITS_PER_BLOCK - 1 ) / VSHADOW_TEST_GENERATE_BITMAP_BITS_PER_BLOCK;
+
+	store_size = 1
+	           + ( 2 * number_of_bitmap_blocks )
+	           + ( ( maximum_number_of_entries + VSHADOW_TEST_GENERATE_BLOCK_LIST_ENTRIES_PER_BLOCK - 1 ) / VSHADOW_TEST_GENERATE_BLOCK_LIST_ENTRIES_PER_BLOCK )
+	           + ( ( maximum_number_of_changes + VSHADOW_TEST_GENERATE_RANGE_LIST_ENTRIES_PER_BLOCK ) / VSHADOW_TEST_GENERATE_RANGE_LIST_ENTRIES_PER_BLOCK )
+	           + maximum_number_of_changes;
+
+	return( ( store_size * generator->number_of_stores )
+	      + ( ( generator->number_of_stores + VSHADOW_TEST_GENERATE_STORES_PER_CATALOG_BLOCK - 1 ) / VSHADOW_TEST_GENERATE_STORES_PER_CATALOG_BLOCK ) );
+}
+
+/* Initializes the generator
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_initialize(
+     vshadow_test_generator_t *generator,
+     libcerror_error_t **error )
+{
+	static char *function             = "vshadow_test_generate_initialize";
+	uint64_t block_index              = 0;
+	uint64_t diff_area_size           = 0;
+	uint64_t maximum_number_of_blocks = 0;
+	uint64_t minimum_number_of_blocks = 0;
+	uint64_t number_of_blocks         = 0;
+	int store_index                   = 0;
+
+	generator->number_of_blocks = generator->volume_size / VSHADOW_TEST_GENERATE_BLOCK_SIZE;
+
+	/* Determine the largest data area for which the diff area fits in the remainder
+	 * of the volume. The first block contains the volume header and the last block
+	 * is reserved, like the NTFS backup volume header, and used to set the image size
+	 */
+	minimum_number_of_blocks = 0;
+	maximum_number_of_blocks = generator->number_of_blocks - 2;
+
+	while( minimum_number_of_blocks < maximum_number_of_blocks )
+	{
+		number_of_blocks = maximum_number_of_blocks - ( ( maximum_number_of_blocks - minimum_number_of_blocks ) / 2 );
+
+		diff_area_size = vshadow_test_generate_get_diff_area_size(
+		                  generator,
+		                  number_of_blocks );
+
+		if( ( number_of_blocks + diff_area_size + 2 ) <= generator->number_of_blocks )
+		{
+			minimum_number_of_blocks = number_of_blocks;
+		}
+		else
+		{
+			maximum_number_of_blocks = number_of_blocks - 1;
+		}
+	}
+	if( minimum_number_of_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: volume size too small for the requested number of stores and churn.",
+		 function );
+
+		return( -1 );
+	}
+	generator->data_area_end             = 1 + minimum_number_of_blocks;
+	generator->number_of_diff_area_slots = generator->number_of_blocks - 1 - generator->data_area_end;
+	generator->bitmap_size               = (size_t) ( ( generator->number_of_blocks + 7 ) / 8 );
+
+	if( (size_t) generator->data_area_end > ( (size_t) SSIZE_MAX / ( sizeof( uint32_t ) * VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: volume size exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	generator->sector_contents = (uint32_t *) memory_allocate(
+	                                           sizeof( uint32_t ) * VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK * (size_t) generator->data_area_end );
+
+	generator->block_states = (uint8_t *) memory_allocate(
+	                                       sizeof( uint8_t ) * (size_t) generator->data_area_end );
+
+	generator->last_entry_store = (int *) memory_allocate(
+	                                       sizeof( int ) * (size_t) generator->data_area_end );
+
+	generator->diff_area_slots = (uint64_t *) memory_allocate(
+	                                           sizeof( uint64_t ) * (size_t) generator->number_of_diff_area_slots );
+
+	generator->current_bitmap = (uint8_t *) memory_allocate(
+	                                         sizeof( uint8_t ) * generator->bitmap_size );
+
+	generator->previous_bitmap = (uint8_t *) memory_allocate(
+	                                          sizeof( uint8_t ) * generator->bitmap_size );
+
+	generator->stores = (vshadow_test_generate_store_t *) memory_allocate(
+	                                                       sizeof( vshadow_test_generate_store_t ) * generator->number_of_stores );
+
+	generator->number_of_catalog_blocks = ( generator->number_of_stores + VSHADOW_TEST_GENERATE_STORES_PER_CATALOG_BLOCK - 1 ) / VSHADOW_TEST_GENERATE_STORES_PER_CATALOG_BLOCK;
+
+	generator->catalog_block_offsets = (off64_t *) memory_allocate(
+	                                                sizeof( off64_t ) * generator->number_of_catalog_blocks );
+
+	if( ( generator->sector_contents == NULL )
+	 || ( generator->block_states == NULL )
+	 || ( generator->last_entry_store == NULL )
+	 || ( generator->diff_area_slots == NULL )
+	 || ( generator->current_bitmap == NULL )
+	 || ( generator->previous_bitmap == NULL )
+	 || ( generator->stores == NULL )
+	 || ( generator->catalog_block_offsets == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create generator state.",
+		 function );
+
+		return( -1 );
+	}
+	memory_set(
+	 generator->sector_contents,
+	 0,
+	 sizeof( uint32_t ) * VSHADOW_TEST_GENERATE_SECTORS_PER_BLOCK * (size_t) generator->data_area_end );
+
+	memory_set(
+	 generator->block_states,
+	 0,
+	 sizeof( uint8_t ) * (size_t) generator->data_area_end );
+
+	memory_set(
+	 generator->stores,
+	 0,
+	 sizeof( vshadow_test_generate_store_t ) * generator->number_of_stores );
+
+	for( block_index = 0;
+	     block_index < generator->data_area_end;
+	     block_index++ )
+	{
+		generator->last_entry_store[ block_index ] = -1;
+	}
+	for( block_index = 0;
+	     block_index < generator->number_of_diff_area_slots;
+	     block_index++ )
+	{
+		generator->diff_area_slots[ block_index ] = generator->data_area_end + block_index;
+	}
+	generator->random_state            = vshadow_test_generate_mix( generator->seed ) | 1;
+	generator->next_content_identifier = 1;
+
+	/* The catalog is at the start of the diff area, it is referenced by the volume header
+	 * which is part of the expected content
+	 */
+	for( store_index = 0;
+	     store_index < generator->number_of_catalog_blocks;
+	     store_index++ )
+	{
+		generator->catalog_block_offsets[ store_index ] = (off64_t) ( generator->diff_area_slots[ generator->next_diff_area_slot++ ] * VSHADOW_TEST_GENERATE_BLOCK_SIZE );
+	}
+
+	for( store_index = 0;
+	     store_index < generator->number_of_stores;
+	     store_index++ )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 generator->stores[ store_index ].identifier,
+		 vshadow_test_generate_mix( generator->seed ^ 0x73746f7265ULL ^ (uint64_t) store_index ) );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( generator->stores[ store_index ].identifier[ 8 ] ),
+		 vshadow_test_generate_mix( generator->seed ^ 0x73746f7266ULL ^ (uint64_t) store_index ) );
+
+		/* One snapshot per hour
+		 */
+		generator->stores[ store_index ].creation_time = VSHADOW_TEST_GENERATE_BASE_CREATION_TIME
+		                                               + ( (uint64_t) store_index * 36000000000ULL );
+	}
+	/* Fill the volume before the first snapshot
+	 */
+	for( block_index = 1;
+	     block_index < generator->data_area_end;
+	     block_index++ )
+	{
+		if( (int) ( vshadow_test_generate_random( generator ) % 100 ) < generator->allocation_percentage )
+		{
+			if( vshadow_test_generate_write_sectors(
+			     generator,
+			     block_index,
+			     0xffffffffUL,
+			     error ) != 1 )
+			{
+				return( -1 );
+			}
+			generator->block_states[ block_index ] = VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_ALLOCATED;
+		}
+	}
+	return( 1 );
+}
+
+/* Frees the generator state
+ */
+void vshadow_test_generate_free(
+      vshadow_test_generator_t *generator )
+{
+	int store_index = 0;
+
+	if( generator->catalog_block_offsets != NULL )
+	{
+		memory_free(
+		 generator->catalog_block_offsets );
+	}
+	if( generator->stores != NULL )
+	{
+		for( store_index = 0;
+		     store_index < generator->number_of_stores;
+		     store_index++ )
+		{
+			if( generator->stores[ store_index ].block_list_data != NULL )
+			{
+				memory_free(
+				 generator->stores[ store_index ].block_list_data );
+			}
+			if( generator->stores[ store_index ].block_range_list_data != NULL )
+			{
+				memory_free(
+				 generator->stores[ store_index ].block_range_list_data );
+			}
+		}
+		memory_free(
+		 generator->stores );
+	}
+	if( generator->previous_bitmap != NULL )
+	{
+		memory_free(
+		 generator->previous_bitmap );
+	}
+	if( generator->current_bitmap != NULL )
+	{
+		memory_free(
+		 generator->current_bitmap );
+	}
+	if( generator->diff_area_slots != NULL )
+	{
+		memory_free(
+		 generator->diff_area_slots );
+	}
+	if( generator->last_entry_store != NULL )
+	{
+		memory_free(
+		 generator->last_entry_store );
+	}
+	if( generator->block_states != NULL )
+	{
+		memory_free(
+		 generator->block_states );
+	}
+	if( generator->sector_contents != NULL )
+	{
+		memory_free(
+		 generator->sector_contents );
+	}
+}
+
+/* Simulates the changes between a snapshot and the next
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_changes(
+     vshadow_test_generator_t *generator,
+     int store_index,
+     libcerror_error_t **error )
+{
+	static char *function              = "vshadow_test_generate_changes";
+	uint64_t block_index               = 0;
+	uint64_t maximum_number_of_changes = 0;
+	uint64_t maximum_run_length        = 0;
+	uint64_t number_of_attempts        = 0;
+	uint64_t number_of_changed_blocks  = 0;
+	uint64_t run_index                 = 0;
+	uint64_t run_length                = 0;
+
+	maximum_number_of_changes = ( ( generator->data_area_end - 1 ) * generator->churn_percentage ) / 100;
+
+	/* The fragmentation determines the length of the runs of changed blocks
+	 */
+	maximum_run_length = 1 + ( ( (uint64_t) ( 100 - generator->fragmentation_percentage ) * 255 ) / 100 );
+
+	for( block_index = 1;
+	     block_index < generator->data_area_end;
+	     block_index++ )
+	{
+		generator->block_states[ block_index ] &= ~( VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_CHANGED );
+	}
+	/* Note that a change can consume 2 blocks hence the one block margin
+	 */
+	while( ( ( number_of_changed_blocks + 1 ) < maximum_number_of_changes )
+	    && ( number_of_attempts < ( maximum_number_of_changes * 4 ) ) )
+	{
+		block_index = 1 + ( vshadow_test_generate_random( generator ) % ( generator->data_area_end - 1 ) );
+		run_length  = 1 + ( vshadow_test_generate_random( generator ) % maximum_run_length );
+
+		for( run_index = 0;
+		     run_index < run_length;
+		     run_index++ )
+		{
+			if( ( block_index >= generator->data_area_end )
+			 || ( ( number_of_changed_blocks + 1 ) >= maximum_number_of_changes ) )
+			{
+				break;
+			}
+			number_of_attempts++;
+
+			if( ( generator->block_states[ block_index ] & VSHADOW_TEST_GENERATE_BLOCK_STATE_FLAG_CHANGED ) == 0 )
+			{
+				if( vshadow_test_generate_change_block(
+				     generator,
+				     store_index,
+				     block_index,
+				     &number_of_changed_blocks,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to generate changes of store: %d.",
+					 function,
+					 store_index );
+
+					return( -1 );
+				}
+			}
+			block_index++;
+		}
+	}
+	return( 1 );
+}
+
+/* Writes the current state of the data area to the image
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_write_data_area(
+     vshadow_test_generator_t *generator,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_generate_write_data_area";
+	uint64_t block_index  = 0;
+
+	for( block_index = 1;
+	     block_index < generator->data_area_end;
+	     block_index++ )
+	{
+		if( vshadow_test_generate_fill_block(
+		     generator,
+		     block_index ) == 0 )
+		{
+			continue;
+		}
+		if( vshadow_test_generate_write_at_offset(
+		     generator->image_stream,
+		     (off64_t) ( block_index * VSHADOW_TEST_GENERATE_BLOCK_SIZE ),
+		     generator->block_buffer,
+		     VSHADOW_TEST_GENERATE_BLOCK_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data block: %" PRIu64 ".",
+			 function,
+			 block_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Generates the volume image
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_volume(
+     vshadow_test_generator_t *generator,
+     libcerror_error_t **error )
+{
+	uint8_t volume_header_data[ sizeof( vshadow_volume_header_t ) ];
+
+	uint8_t *swap_bitmap  = NULL;
+	static char *function = "vshadow_test_generate_volume";
+	int store_index       = 0;
+
+	vshadow_test_generate_set_volume_header_data(
+	 generator,
+	 volume_header_data );
+
+	for( store_index = 0;
+	     store_index < generator->number_of_stores;
+	     store_index++ )
+	{
+		swap_bitmap                = generator->previous_bitmap;
+		generator->previous_bitmap = generator->current_bitmap;
+		generator->current_bitmap  = swap_bitmap;
+
+		vshadow_test_generate_build_bitmap(
+		 generator,
+		 generator->current_bitmap );
+
+		if( generator->expected_prefix != NULL )
+		{
+			if( vshadow_test_generate_write_expected_content(
+			     generator,
+			     store_index,
+			     volume_header_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write expected content of store: %d.",
+				 function,
+				 store_index );
+
+				return( -1 );
+			}
+		}
+		if( vshadow_test_generate_changes(
+		     generator,
+		     store_index,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		if( vshadow_test_generate_write_store_metadata(
+		     generator,
+		     store_index,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	if( vshadow_test_generate_write_catalog(
+	     generator,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( vshadow_test_generate_write_data_area(
+	     generator,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( vshadow_test_generate_write_at_offset(
+	     generator->image_stream,
+	     (off64_t) 0x1e00,
+	     volume_header_data,
+	     sizeof( vshadow_volume_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write volume header.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the image has the size of the volume
+	 */
+	memory_set(
+	 generator->block_buffer,
+	 0,
+	 VSHADOW_TEST_GENERATE_SECTOR_SIZE );
+
+	if( vshadow_test_generate_write_at_offset(
+	     generator->image_stream,
+	     (off64_t) ( generator->volume_size - VSHADOW_TEST_GENERATE_SECTOR_SIZE ),
+	     generator->block_buffer,
+	     VSHADOW_TEST_GENERATE_SECTOR_SIZE,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prints a summary of the generated volume
+ */
+void vshadow_test_generate_summary_fprint(
+      vshadow_test_generator_t *generator,
+      FILE *stream )
+{
+	vshadow_test_generate_store_t *store = NULL;
+	int store_index                      = 0;
+
+	fprintf(
+	 stream,
+	 "volume_size: %" PRIu64 "\n",
+	 generator->volume_size );
+
+	fprintf(
+	 stream,
+	 "data_area_size: %" PRIu64 "\n",
+	 ( generator->data_area_end - 1 ) * VSHADOW_TEST_GENERATE_BLOCK_SIZE );
+
+	fprintf(
+	 stream,
+	 "number_of_stores: %d\n",
+	 generator->number_of_stores );
+
+	for( store_index = 0;
+	     store_index < generator->number_of_stores;
+	     store_index++ )
+	{
+		store = &( generator->stores[ store_index ] );
+
+		fprintf(
+		 stream,
+		 "store: %d entries: %" PRIzu " full: %" PRIu64 " overlays: %" PRIu64 " forwarders: %" PRIu64 " chained_forwarders: %" PRIu64 " unused: %" PRIu64 " data_blocks: %" PRIu64 " ranges: %" PRIzu "\n",
+		 store_index + 1,
+		 store->number_of_block_list_entries,
+		 store->number_of_full_blocks,
+		 store->number_of_overlays,
+		 store->number_of_forwarders,
+		 store->number_of_chained_forwarders,
+		 store->number_of_unused_entries,
+		 store->number_of_data_blocks,
+		 store->number_of_block_range_list_entries );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	vshadow_test_generator_t generator;
+
+	libcerror_error_t *error   = NULL;
+	system_character_t *target = NULL;
+	system_integer_t option    = 0;
+	uint64_t value_64bit       = 0;
+	int result                 = 0;
+
+	memory_set(
+	 &generator,
+	 0,
+	 sizeof( vshadow_test_generator_t ) );
+
+	generator.volume_size              = 64 * 1024 * 1024;
+	generator.number_of_stores         = 4;
+	generator.allocation_percentage    = 75;
+	generator.churn_percentage         = 10;
+	generator.fragmentation_percentage = 0;
+	generator.forwarder_percentage     = 5;
+	generator.overlay_percentage       = 10;
+	generator.seed                     = 1;
+
+	while( ( option = vshadow_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "a:c:e:f:F:hn:o:s:S:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				vshadow_test_generate_usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'a':
+				result = vshadow_test_generate_string_copy_to_percentage(
+				          optarg,
+				          &( generator.allocation_percentage ),
+				          &error );
+				break;
+
+			case (system_integer_t) 'c':
+				result = vshadow_test_generate_string_copy_to_percentage(
+				          optarg,
+				          &( generator.churn_percentage ),
+				          &error );
+				break;
+
+			case (system_integer_t) 'e':
+				generator.expected_prefix = optarg;
+
+				result = 1;
+
+				break;
+
+			case (system_integer_t) 'f':
+				result = vshadow_test_generate_string_copy_to_percentage(
+				          optarg,
+				          &( generator.fragmentation_percentage ),
+				          &error );
+				break;
+
+			case (system_integer_t) 'F':
+				result = vshadow_test_generate_string_copy_to_percentage(
+				          optarg,
+				          &( generator.forwarder_percentage ),
+				          &error );
+				break;
+
+			case (system_integer_t) 'h':
+				vshadow_test_generate_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'n':
+				result = vshadow_test_generate_string_copy_to_64bit(
+				          optarg,
+				          &value_64bit,
+				          0,
+				          &error );
+
+				if( ( result == 1 )
+				 && ( ( value_64bit == 0 )
+				  ||  ( value_64bit > VSHADOW_TEST_GENERATE_MAXIMUM_NUMBER_OF_STORES ) ) )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of stores, value should be 1 - %d.\n",
+					 VSHADOW_TEST_GENERATE_MAXIMUM_NUMBER_OF_STORES );
+
+					return( EXIT_FAILURE );
+				}
+				generator.number_of_stores = (int) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'o':
+				result = vshadow_test_generate_string_copy_to_percentage(
+				          optarg,
+				          &( generator.overlay_percentage ),
+				          &error );
+				break;
+
+			case (system_integer_t) 's':
+				result = vshadow_test_generate_string_copy_to_64bit(
+				          optarg,
+				          &( generator.volume_size ),
+				          1,
+				          &error );
+				break;
+
+			case (system_integer_t) 'S':
+				result = vshadow_test_generate_string_copy_to_64bit(
+				          optarg,
+				          &( generator.seed ),
+				          0,
+				          &error );
+				break;
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported value of argument: %" PRIs_SYSTEM ".\n",
+			 argv[ optind - 1 ] );
+
+			goto on_error;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target file.\n" );
+
+		vshadow_test_generate_usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	target = argv[ optind ];
+
+	if( ( generator.forwarder_percentage + generator.overlay_percentage ) > 100 )
+	{
+		fprintf(
+		 stderr,
+		 "Sum of forwarder and overlay percentages exceeds 100.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	generator.volume_size -= generator.volume_size % VSHADOW_TEST_GENERATE_BLOCK_SIZE;
+
+	if( generator.volume_size < ( 16 * VSHADOW_TEST_GENERATE_BLOCK_SIZE ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported volume size, value should be at least 256K.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( vshadow_test_generate_initialize(
+	     &generator,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize generator.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	generator.image_stream = file_stream_open_wide(
+	                          target,
+	                          L"wb" );
+#else
+	generator.image_stream = file_stream_open(
+	                          target,
+	                          "wb" );
+#endif
+	if( generator.image_stream == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open target file: %" PRIs_SYSTEM ".\n",
+		 target );
+
+		goto on_error;
+	}
+	if( vshadow_test_generate_volume(
+	     &generator,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to generate volume.\n" );
+
+		goto on_error;
+	}
+	if( file_stream_close(
+	     generator.image_stream ) != 0 )
+	{
+		generator.image_stream = NULL;
+
+		fprintf(
+		 stderr,
+		 "Unable to close target file.\n" );
+
+		goto on_error;
+	}
+	generator.image_stream = NULL;
+
+	vshadow_test_generate_summary_fprint(
+	 &generator,
+	 stdout );
+
+	vshadow_test_generate_free(
+	 &generator );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( generator.image_stream != NULL )
+	{
+		file_stream_close(
+		 generator.image_stream );
+	}
+	vshadow_test_generate_free(
+	 &generator );
+
+	return( EXIT_FAILURE );
+}
+
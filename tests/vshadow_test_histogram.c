@@ -0,0 +1,851 @@
+/*
+ * Library histogram functions test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_histogram.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libvshadow_histogram_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_histogram_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libvshadow_histogram_t *histogram = NULL;
+	int result                        = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_histogram_initialize(
+	          &histogram,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "histogram",
+	 histogram );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_histogram_free(
+	          &histogram,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "histogram",
+	 histogram );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_histogram_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	histogram = (libvshadow_histogram_t *) 0x12345678UL;
+
+	result = libvshadow_histogram_initialize(
+	          &histogram,
+	          &error );
+
+	histogram = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( histogram != NULL )
+	{
+		libvshadow_histogram_free(
+		 &histogram,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_histogram_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_histogram_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_histogram_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_histogram_get_bucket_index and libvshadow_histogram_get_bucket_upper_bound functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_histogram_get_bucket_index(
+     void )
+{
+	uint64_t upper_bound = 0;
+	uint64_t value       = 0;
+	int bucket_index     = 0;
+
+	/* Test regular cases
+	 */
+	bucket_index = libvshadow_histogram_get_bucket_index(
+	                0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 0 );
+
+	bucket_index = libvshadow_histogram_get_bucket_index(
+	                LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS - 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS - 1 );
+
+	bucket_index = libvshadow_histogram_get_bucket_index(
+	                LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS );
+
+	bucket_index = libvshadow_histogram_get_bucket_index(
+	                (uint64_t) -1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 LIBVSHADOW_HISTOGRAM_NUMBER_OF_BUCKETS - 1 );
+
+	/* Every value must be stored in a bucket with an upper bound
+	 * within 1/LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS of the value
+	 */
+	for( value = 1;
+	     value < ( (uint64_t) 1 << 36 );
+	     value = ( value * 3 ) + 1 )
+	{
+		bucket_index = libvshadow_histogram_get_bucket_index(
+		                value );
+
+		VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+		 "bucket_index",
+		 bucket_index,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_LESS_THAN_INT(
+		 "bucket_index",
+		 bucket_index,
+		 LIBVSHADOW_HISTOGRAM_NUMBER_OF_BUCKETS );
+
+		upper_bound = libvshadow_histogram_get_bucket_upper_bound(
+		               bucket_index );
+
+		VSHADOW_TEST_ASSERT_LESS_THAN_UINT64(
+		 "value",
+		 value,
+		 upper_bound + 1 );
+
+		VSHADOW_TEST_ASSERT_LESS_THAN_UINT64(
+		 "upper_bound",
+		 upper_bound,
+		 value + ( value / LIBVSHADOW_HISTOGRAM_NUMBER_OF_SUB_BUCKETS ) + 1 );
+
+		bucket_index = libvshadow_histogram_get_bucket_index(
+		                upper_bound + 1 );
+
+		VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+		 "bucket_index",
+		 bucket_index,
+		 libvshadow_histogram_get_bucket_index(
+		  value ) );
+	}
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libvshadow_histogram_add_value function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_histogram_add_value(
+     void )
+{
+	libvshadow_histogram_t histogram;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &histogram,
+	 0,
+	 sizeof( libvshadow_histogram_t ) );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_histogram_add_value(
+	          &histogram,
+	          100,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_histogram_add_value(
+	          &histogram,
+	          5000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "histogram.number_of_values",
+	 histogram.number_of_values,
+	 (uint64_t) 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "histogram.total_value",
+	 histogram.total_value,
+	 (uint64_t) 5100 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "histogram.maximum_value",
+	 histogram.maximum_value,
+	 (uint64_t) 5000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "histogram.bucket_counts",
+	 histogram.bucket_counts[ libvshadow_histogram_get_bucket_index( 100 ) ],
+	 (uint64_t) 1 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_histogram_add_value(
+	          NULL,
+	          100,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_histogram_add function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_histogram_add(
+     void )
+{
+	libvshadow_histogram_t histogram;
+	libvshadow_histogram_t source_histogram;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &histogram,
+	 0,
+	 sizeof( libvshadow_histogram_t ) );
+
+	memory_set(
+	 &source_histogram,
+	 0,
+	 sizeof( libvshadow_histogram_t ) );
+
+	result = libvshadow_histogram_add_value(
+	          &histogram,
+	          10,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_histogram_add_value(
+	          &source_histogram,
+	          20000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_histogram_add(
+	          &histogram,
+	          &source_histogram,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "histogram.number_of_values",
+	 histogram.number_of_values,
+	 (uint64_t) 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "histogram.total_value",
+	 histogram.total_value,
+	 (uint64_t) 20010 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "histogram.maximum_value",
+	 histogram.maximum_value,
+	 (uint64_t) 20000 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_histogram_add(
+	          NULL,
+	          &source_histogram,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_histogram_add(
+	          &histogram,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_histogram_get_quantile function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_histogram_get_quantile(
+     void )
+{
+	libvshadow_histogram_t histogram;
+
+	libcerror_error_t *error = NULL;
+	uint64_t value           = 0;
+	int result               = 0;
+	int value_index          = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &histogram,
+	 0,
+	 sizeof( libvshadow_histogram_t ) );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_histogram_get_quantile(
+	          &histogram,
+	          500,
+	          &value,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 0 );
+
+	/* 990 values of 10 and 10 values of 1000000
+	 */
+	for( value_index = 0;
+	     value_index < 1000;
+	     value_index++ )
+	{
+		result = libvshadow_histogram_add_value(
+		          &histogram,
+		          ( value_index < 990 ) ? 10 : 1000000,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	result = libvshadow_histogram_get_quantile(
+	          &histogram,
+	          500,
+	          &value,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 10 );
+
+	result = libvshadow_histogram_get_quantile(
+	          &histogram,
+	          990,
+	          &value,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 10 );
+
+	result = libvshadow_histogram_get_quantile(
+	          &histogram,
+	          999,
+	          &value,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 1000000 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_histogram_get_quantile(
+	          NULL,
+	          500,
+	          &value,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_histogram_get_quantile(
+	          &histogram,
+	          1001,
+	          &value,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_histogram_get_quantile(
+	          &histogram,
+	          500,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_histogram_get_timing_values function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_histogram_get_timing_values(
+     void )
+{
+	uint64_t values[ LIBVSHADOW_NUMBER_OF_TIMING_VALUES + 2 ];
+	libvshadow_histogram_t histogram;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &histogram,
+	 0,
+	 sizeof( libvshadow_histogram_t ) );
+
+	result = libvshadow_histogram_add_value(
+	          &histogram,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	memory_set(
+	 values,
+	 0xff,
+	 sizeof( uint64_t ) * ( LIBVSHADOW_NUMBER_OF_TIMING_VALUES + 2 ) );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_histogram_get_timing_values(
+	          &histogram,
+	          values,
+	          LIBVSHADOW_NUMBER_OF_TIMING_VALUES + 2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVSHADOW_TIMING_VALUE_NUMBER_OF_SAMPLES ]",
+	 values[ LIBVSHADOW_TIMING_VALUE_NUMBER_OF_SAMPLES ],
+	 (uint64_t) 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVSHADOW_TIMING_VALUE_P999_TIME ]",
+	 values[ LIBVSHADOW_TIMING_VALUE_P999_TIME ],
+	 (uint64_t) 3 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVSHADOW_NUMBER_OF_TIMING_VALUES ]",
+	 values[ LIBVSHADOW_NUMBER_OF_TIMING_VALUES ],
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_histogram_get_timing_values(
+	          NULL,
+	          values,
+	          LIBVSHADOW_NUMBER_OF_TIMING_VALUES,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_histogram_get_timing_values(
+	          &histogram,
+	          NULL,
+	          LIBVSHADOW_NUMBER_OF_TIMING_VALUES,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_histogram_get_timing_values(
+	          &histogram,
+	          values,
+	          -1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_histogram_initialize",
+	 vshadow_test_histogram_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_histogram_free",
+	 vshadow_test_histogram_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_histogram_get_bucket_index",
+	 vshadow_test_histogram_get_bucket_index );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_histogram_add_value",
+	 vshadow_test_histogram_add_value );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_histogram_add",
+	 vshadow_test_histogram_add );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_histogram_get_quantile",
+	 vshadow_test_histogram_get_quantile );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_histogram_get_timing_values",
+	 vshadow_test_histogram_get_timing_values );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -183,6 +183,13 @@
 		goto on_error; \
 	}
 
+#define VSHADOW_TEST_ASSERT_EQUAL_INTPTR( name, value, expected_value ) \
+	if( value != expected_value ) \
+	{ \
+		fprintf( stdout, "%s:%d %s (%p) != %p\n", __FILE__, __LINE__, name, (void *) value, (void *) expected_value ); \
+		goto on_error; \
+	}
+
 #define VSHADOW_TEST_ASSERT_IS_NOT_NULL( name, value ) \
 	if( value == NULL ) \
 	{ \
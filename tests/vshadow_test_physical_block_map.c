@@ -0,0 +1,1322 @@
+/*
+ * Library physical_block_map type test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_physical_block_map.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libvshadow_physical_block_map_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_physical_block_map_initialize(
+     void )
+{
+	libcerror_error_t *error                            = NULL;
+	libvshadow_physical_block_map_t *physical_block_map = NULL;
+	int result                                          = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_physical_block_map_initialize(
+	          &physical_block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "physical_block_map",
+	 physical_block_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_free(
+	          &physical_block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "physical_block_map",
+	 physical_block_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_physical_block_map_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	physical_block_map = (libvshadow_physical_block_map_t *) 0x12345678UL;
+
+	result = libvshadow_physical_block_map_initialize(
+	          &physical_block_map,
+	          &error );
+
+	physical_block_map = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( physical_block_map != NULL )
+	{
+		libvshadow_physical_block_map_free(
+		 &physical_block_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_physical_block_map_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_physical_block_map_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_physical_block_map_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_physical_block_map_sort function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_physical_block_map_sort(
+     void )
+{
+	libcerror_error_t *error                            = NULL;
+	libvshadow_physical_block_map_t *physical_block_map = NULL;
+	off64_t offset                                      = 0;
+	off64_t original_offset                             = 0;
+	int block_index                                     = 0;
+	int number_of_blocks                                = 0;
+	int result                                          = 0;
+	int store_index                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_physical_block_map_initialize(
+	          &physical_block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "physical_block_map",
+	 physical_block_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00020000,
+	          0x00100000,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00008000,
+	          0x00004000,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00010000,
+	          0x00104000,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00008000,
+	          0x00004000,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_sort(
+	          physical_block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_get_number_of_blocks(
+	          physical_block_map,
+	          &number_of_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 4 );
+
+	result = libvshadow_physical_block_map_get_block_by_index(
+	          physical_block_map,
+	          0,
+	          &offset,
+	          &store_index,
+	          &original_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0x00008000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_index",
+	 store_index,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "original_offset",
+	 original_offset,
+	 (int64_t) 0x00004000 );
+
+	result = libvshadow_physical_block_map_get_block_by_index(
+	          physical_block_map,
+	          1,
+	          &offset,
+	          &store_index,
+	          &original_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0x00008000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_index",
+	 store_index,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "original_offset",
+	 original_offset,
+	 (int64_t) 0x00004000 );
+
+	result = libvshadow_physical_block_map_get_block_by_index(
+	          physical_block_map,
+	          2,
+	          &offset,
+	          &store_index,
+	          &original_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0x00010000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_index",
+	 store_index,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "original_offset",
+	 original_offset,
+	 (int64_t) 0x00104000 );
+
+	result = libvshadow_physical_block_map_get_block_by_index(
+	          physical_block_map,
+	          3,
+	          &offset,
+	          &store_index,
+	          &original_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0x00020000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_index",
+	 store_index,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "original_offset",
+	 original_offset,
+	 (int64_t) 0x00100000 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_physical_block_map_sort(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          -1,
+	          0,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_physical_block_map_get_block_by_index(
+	          physical_block_map,
+	          4,
+	          &offset,
+	          &store_index,
+	          &original_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_physical_block_map_get_block_by_index(
+	          physical_block_map,
+	          0,
+	          NULL,
+	          &store_index,
+	          &original_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test retrieving a block index when the map is not sorted
+	 */
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00004000,
+	          0x00000000,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_get_block_index_at_offset(
+	          physical_block_map,
+	          0x00004000,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_physical_block_map_free(
+	          &physical_block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "physical_block_map",
+	 physical_block_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( physical_block_map != NULL )
+	{
+		libvshadow_physical_block_map_free(
+		 &physical_block_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_physical_block_map_get_block_index_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_physical_block_map_get_block_index_at_offset(
+     void )
+{
+	libcerror_error_t *error                            = NULL;
+	libvshadow_physical_block_map_t *physical_block_map = NULL;
+	int block_index                                     = 0;
+	int result                                          = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_physical_block_map_initialize(
+	          &physical_block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "physical_block_map",
+	 physical_block_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00020000,
+	          0x00100000,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00008000,
+	          0x00004000,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00010000,
+	          0x00104000,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00008000,
+	          0x00004000,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_sort(
+	          physical_block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_physical_block_map_get_block_index_at_offset(
+	          physical_block_map,
+	          0x00008000,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index",
+	 block_index,
+	 0 );
+
+	result = libvshadow_physical_block_map_get_block_index_at_offset(
+	          physical_block_map,
+	          0x00013fff,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index",
+	 block_index,
+	 2 );
+
+	result = libvshadow_physical_block_map_get_block_index_at_offset(
+	          physical_block_map,
+	          0x00021000,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index",
+	 block_index,
+	 3 );
+
+	result = libvshadow_physical_block_map_get_block_index_at_offset(
+	          physical_block_map,
+	          0x00000000,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_get_block_index_at_offset(
+	          physical_block_map,
+	          0x0000c000,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_get_block_index_at_offset(
+	          physical_block_map,
+	          0x00024000,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_physical_block_map_get_block_index_at_offset(
+	          NULL,
+	          0x00008000,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_physical_block_map_get_block_index_at_offset(
+	          physical_block_map,
+	          -1,
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_physical_block_map_get_block_index_at_offset(
+	          physical_block_map,
+	          0x00008000,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_physical_block_map_free(
+	          &physical_block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "physical_block_map",
+	 physical_block_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( physical_block_map != NULL )
+	{
+		libvshadow_physical_block_map_free(
+		 &physical_block_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_physical_block_map_get_block_indexes_in_range function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_physical_block_map_get_block_indexes_in_range(
+     void )
+{
+	libcerror_error_t *error                            = NULL;
+	libvshadow_physical_block_map_t *physical_block_map = NULL;
+	int first_block_index                               = 0;
+	int number_of_blocks                                = 0;
+	int result                                          = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_physical_block_map_initialize(
+	          &physical_block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "physical_block_map",
+	 physical_block_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00020000,
+	          0x00100000,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00008000,
+	          0x00004000,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00010000,
+	          0x00104000,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_append_block(
+	          physical_block_map,
+	          0x00008000,
+	          0x00004000,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_physical_block_map_sort(
+	          physical_block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_physical_block_map_get_block_indexes_in_range(
+	          physical_block_map,
+	          0x00000000,
+	          0x00100000,
+	          &first_block_index,
+	          &number_of_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_block_index",
+	 first_block_index,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 4 );
+
+	result = libvshadow_physical_block_map_get_block_indexes_in_range(
+	          physical_block_map,
+	          0x0000a000,
+	          0x00008000,
+	          &first_block_index,
+	          &number_of_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_block_index",
+	 first_block_index,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 3 );
+
+	result = libvshadow_physical_block_map_get_block_indexes_in_range(
+	          physical_block_map,
+	          0x0000c000,
+	          0x00004000,
+	          &first_block_index,
+	          &number_of_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_block_index",
+	 first_block_index,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 0 );
+
+	result = libvshadow_physical_block_map_get_block_indexes_in_range(
+	          physical_block_map,
+	          0x00010000,
+	          0x00000000,
+	          &first_block_index,
+	          &number_of_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_block_index",
+	 first_block_index,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 0 );
+
+	result = libvshadow_physical_block_map_get_block_indexes_in_range(
+	          physical_block_map,
+	          0x00014000,
+	          0x00010000,
+	          &first_block_index,
+	          &number_of_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_block_index",
+	 first_block_index,
+	 3 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_physical_block_map_get_block_indexes_in_range(
+	          NULL,
+	          0,
+	          0x00004000,
+	          &first_block_index,
+	          &number_of_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_physical_block_map_get_block_indexes_in_range(
+	          physical_block_map,
+	          -1,
+	          0x00004000,
+	          &first_block_index,
+	          &number_of_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_physical_block_map_get_block_indexes_in_range(
+	          physical_block_map,
+	          0,
+	          0x00004000,
+	          NULL,
+	          &number_of_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_physical_block_map_get_block_indexes_in_range(
+	          physical_block_map,
+	          0,
+	          0x00004000,
+	          &first_block_index,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_physical_block_map_free(
+	          &physical_block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "physical_block_map",
+	 physical_block_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( physical_block_map != NULL )
+	{
+		libvshadow_physical_block_map_free(
+		 &physical_block_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_physical_block_map_initialize",
+	 vshadow_test_physical_block_map_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_physical_block_map_free",
+	 vshadow_test_physical_block_map_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_physical_block_map_sort",
+	 vshadow_test_physical_block_map_sort );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_physical_block_map_get_block_index_at_offset",
+	 vshadow_test_physical_block_map_get_block_index_at_offset );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_physical_block_map_get_block_indexes_in_range",
+	 vshadow_test_physical_block_map_get_block_indexes_in_range );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,353 @@
+/*
+ * Library statistics functions test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_statistics.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libvshadow_statistics_add function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_statistics_add(
+     void )
+{
+	libvshadow_statistics_t source_statistics;
+	libvshadow_statistics_t statistics;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &statistics,
+	 0,
+	 sizeof( libvshadow_statistics_t ) );
+
+	memory_set(
+	 &source_statistics,
+	 0,
+	 sizeof( libvshadow_statistics_t ) );
+
+	statistics.number_of_block_tree_lookups = 2;
+	statistics.maximum_chain_depth          = 3;
+	statistics.read_size                    = 16384;
+
+	source_statistics.number_of_block_tree_lookups = 5;
+	source_statistics.maximum_chain_depth          = 1;
+	source_statistics.read_size                    = 512;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_statistics_add(
+	          &statistics,
+	          &source_statistics,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics.number_of_block_tree_lookups",
+	 statistics.number_of_block_tree_lookups,
+	 (uint64_t) 7 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics.maximum_chain_depth",
+	 statistics.maximum_chain_depth,
+	 (uint64_t) 3 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics.read_size",
+	 statistics.read_size,
+	 (uint64_t) 16896 );
+
+	source_statistics.maximum_chain_depth = 4;
+
+	result = libvshadow_statistics_add(
+	          &statistics,
+	          &source_statistics,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics.maximum_chain_depth",
+	 statistics.maximum_chain_depth,
+	 (uint64_t) 4 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_statistics_add(
+	          NULL,
+	          &source_statistics,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_statistics_add(
+	          &statistics,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_statistics_get_values function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_statistics_get_values(
+     void )
+{
+	uint64_t values[ LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES + 2 ];
+	libvshadow_statistics_t statistics;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &statistics,
+	 0,
+	 sizeof( libvshadow_statistics_t ) );
+
+	statistics.number_of_chain_reads = 9;
+	statistics.lock_wait_time        = 1000;
+
+	statistics.number_of_index_evictions = 3;
+
+	memory_set(
+	 values,
+	 0xff,
+	 sizeof( uint64_t ) * ( LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES + 2 ) );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_statistics_get_values(
+	          &statistics,
+	          values,
+	          LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES + 2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_CHAIN_READS ]",
+	 values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_CHAIN_READS ],
+	 (uint64_t) 9 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVSHADOW_STATISTICS_VALUE_LOCK_WAIT_TIME ]",
+	 values[ LIBVSHADOW_STATISTICS_VALUE_LOCK_WAIT_TIME ],
+	 (uint64_t) 1000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_EVICTIONS ]",
+	 values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_EVICTIONS ],
+	 (uint64_t) 3 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES ]",
+	 values[ LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES ],
+	 (uint64_t) 0 );
+
+	result = libvshadow_statistics_get_values(
+	          &statistics,
+	          values,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_statistics_get_values(
+	          NULL,
+	          values,
+	          LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_statistics_get_values(
+	          &statistics,
+	          NULL,
+	          LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_statistics_get_values(
+	          &statistics,
+	          values,
+	          -1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_statistics_add",
+	 vshadow_test_statistics_add );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_statistics_get_values",
+	 vshadow_test_statistics_get_values );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
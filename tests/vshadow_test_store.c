@@ -21,12 +21,16 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include "vshadow_test_getopt.h"
+#include "vshadow_test_libbfio.h"
 #include "vshadow_test_libcerror.h"
 #include "vshadow_test_libvshadow.h"
 #include "vshadow_test_macros.h"
@@ -35,6 +39,254 @@
 
 #include "../libvshadow/libvshadow_store.h"
 
+/* The maximum size of the physical extents requested by the tests
+ */
+#define VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE	65536
+
+/* Creates and opens a source volume
+ * The file IO handle is opened separately to read the volume data directly
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_store_open_source(
+     libvshadow_volume_t **volume,
+     libbfio_handle_t **file_io_handle,
+     const system_character_t *source,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_store_open_source";
+	size_t source_length  = 0;
+	int result            = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	source_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          *file_io_handle,
+	          source,
+	          source_length,
+	          error );
+#else
+	result = libbfio_file_set_name(
+	          *file_io_handle,
+	          source,
+	          source_length,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file name.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     *file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize volume.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvshadow_volume_open_wide(
+	          *volume,
+	          source,
+	          LIBVSHADOW_OPEN_READ,
+	          error );
+#else
+	result = libvshadow_volume_open(
+	          *volume,
+	          source,
+	          LIBVSHADOW_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *volume != NULL )
+	{
+		libvshadow_volume_free(
+		 volume,
+		 NULL );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes and frees a source volume
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_store_close_source(
+     libvshadow_volume_t **volume,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_store_close_source";
+	int result            = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_close(
+	     *volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close volume.",
+		 function );
+
+		result = -1;
+	}
+	if( libvshadow_volume_free(
+	     volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free volume.",
+		 function );
+
+		result = -1;
+	}
+	if( libbfio_handle_close(
+	     *file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libbfio_handle_free(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
 #if defined( __GNUC__ ) && defined( TODO )
 
 /* Tests the libvshadow_store_initialize function
@@ -256,58 +508,1394 @@ on_error:
 	return( 0 );
 }
 
-/* The main program
+/* Tests the libvshadow_store_get_physical_extent function
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
-#endif
+int vshadow_test_store_get_physical_extent(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle )
 {
-	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
-	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+	libcerror_error_t *error          = NULL;
+	libvshadow_store_t *store         = NULL;
+	uint8_t *store_data               = NULL;
+	uint8_t *volume_data              = NULL;
+	size64_t extent_size              = 0;
+	size64_t volume_size              = 0;
+	size_t data_index                 = 0;
+	ssize_t read_count                = 0;
+	off64_t offset                    = 0;
+	off64_t physical_offset           = 0;
+	uint32_t extent_flags             = 0;
+	int number_of_blocks              = 0;
+	int number_of_sparse_extents      = 0;
+	int number_of_store_data_extents  = 0;
+	int number_of_stores              = 0;
+	int number_of_volume_extents      = 0;
+	int result                        = 0;
+	int store_index                   = 0;
+	int total_number_of_blocks        = 0;
 
-#if defined( __GNUC__ ) && defined( TODO )
+	/* Initialize test
+	 */
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
 
-	VSHADOW_TEST_RUN(
-	 "libvshadow_store_initialize",
-	 vshadow_test_store_initialize );
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-#endif /* defined( __GNUC__ ) */
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	VSHADOW_TEST_RUN(
-	 "libvshadow_store_free",
-	 vshadow_test_store_free );
+	result = libvshadow_volume_get_size(
+	          volume,
+	          &volume_size,
+	          &error );
 
-#if defined( __GNUC__ )
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* TODO add tests for libvshadow_store_has_in_volume_data */
-	/* TODO add tests for libvshadow_internal_store_read_buffer_from_file_io_handle */
-	/* TODO add tests for libvshadow_store_read_buffer */
-	/* TODO add tests for libvshadow_store_read_buffer_from_file_io_handle */
-	/* TODO add tests for libvshadow_store_read_buffer_at_offset */
-	/* TODO add tests for libvshadow_internal_store_seek_offset */
-	/* TODO add tests for libvshadow_store_seek_offset */
-	/* TODO add tests for libvshadow_store_get_offset */
-	/* TODO add tests for libvshadow_store_get_size */
-	/* TODO add tests for libvshadow_store_get_volume_size */
-	/* TODO add tests for libvshadow_store_get_identifier */
-	/* TODO add tests for libvshadow_store_get_creation_time */
-	/* TODO add tests for libvshadow_store_get_copy_identifier */
-	/* TODO add tests for libvshadow_store_get_copy_set_identifier */
-	/* TODO add tests for libvshadow_store_get_attribute_flags */
-	/* TODO add tests for libvshadow_store_get_number_of_blocks */
-	/* TODO add tests for libvshadow_store_get_block_by_index */
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-#endif /* defined( __GNUC__ ) */
+	store_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE );
 
-	return( EXIT_SUCCESS );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_data",
+	 store_data );
 
-on_error:
-	return( EXIT_FAILURE );
-}
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_data",
+	 volume_data );
+
+	/* Test regular cases
+	 * The extents of every store should cover the volume and the data of every
+	 * extent should match the store data read at the same offset
+	 */
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		result = libvshadow_volume_get_store(
+		          volume,
+		          store_index,
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "store",
+		 store );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_store_get_number_of_blocks(
+		          store,
+		          &number_of_blocks,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		total_number_of_blocks += number_of_blocks;
+
+		offset = 0;
+
+		while( (size64_t) offset < volume_size )
+		{
+			result = libvshadow_store_get_physical_extent(
+			          store,
+			          offset,
+			          VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE,
+			          &physical_offset,
+			          &extent_size,
+			          &extent_flags,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			VSHADOW_TEST_ASSERT_NOT_EQUAL_INT64(
+			 "extent_size",
+			 (int64_t) extent_size,
+			 (int64_t) 0 );
+
+			VSHADOW_TEST_ASSERT_LESS_THAN_UINT64(
+			 "extent_size",
+			 (uint64_t) extent_size,
+			 (uint64_t) VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE + 1 );
+
+			VSHADOW_TEST_ASSERT_LESS_THAN_UINT64(
+			 "extent_size",
+			 (uint64_t) extent_size,
+			 (uint64_t) ( volume_size - (size64_t) offset ) + 1 );
+
+			read_count = libvshadow_store_read_buffer_at_offset(
+			              store,
+			              store_data,
+			              (size_t) extent_size,
+			              offset,
+			              &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) extent_size );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			if( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+			{
+				VSHADOW_TEST_ASSERT_EQUAL_INT64(
+				 "physical_offset",
+				 (int64_t) physical_offset,
+				 (int64_t) 0 );
+
+				for( data_index = 0;
+				     data_index < (size_t) extent_size;
+				     data_index++ )
+				{
+					if( store_data[ data_index ] != 0 )
+					{
+						break;
+					}
+				}
+				VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+				 "data_index",
+				 data_index,
+				 (size_t) extent_size );
+
+				number_of_sparse_extents++;
+			}
+			else
+			{
+				VSHADOW_TEST_ASSERT_LESS_THAN_UINT64(
+				 "physical_offset",
+				 (uint64_t) physical_offset,
+				 (uint64_t) volume_size );
+
+				result = (int) libbfio_handle_seek_offset(
+				                file_io_handle,
+				                physical_offset,
+				                SEEK_SET,
+				                &error );
+
+				VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+				 "result",
+				 result,
+				 -1 );
+
+				VSHADOW_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				read_count = libbfio_handle_read_buffer(
+				              file_io_handle,
+				              volume_data,
+				              (size_t) extent_size,
+				              &error );
+
+				VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+				 "read_count",
+				 read_count,
+				 (ssize_t) extent_size );
+
+				VSHADOW_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = memory_compare(
+				          store_data,
+				          volume_data,
+				          (size_t) extent_size );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+
+				if( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_STORE_DATA ) != 0 )
+				{
+					number_of_store_data_extents++;
+				}
+				else
+				{
+					number_of_volume_extents++;
+				}
+			}
+			offset += (off64_t) extent_size;
+		}
+		/* Test an extent that is limited by the end of the store data
+		 */
+		result = libvshadow_store_get_physical_extent(
+		          store,
+		          (off64_t) volume_size - 1,
+		          VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE,
+		          &physical_offset,
+		          &extent_size,
+		          &extent_flags,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+		 "extent_size",
+		 (uint64_t) extent_size,
+		 (uint64_t) 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test extents beyond the end of the store data
+		 */
+		result = libvshadow_store_get_physical_extent(
+		          store,
+		          (off64_t) volume_size,
+		          VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE,
+		          &physical_offset,
+		          &extent_size,
+		          &extent_flags,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_store_get_physical_extent(
+		          store,
+		          (off64_t) volume_size + VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE,
+		          VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE,
+		          &physical_offset,
+		          &extent_size,
+		          &extent_flags,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
 
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_store_free(
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	if( number_of_stores > 0 )
+	{
+		/* The first block of the volume contains the volume header and is
+		 * not preserved by the stores, hence it is read from the current volume
+		 */
+		VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+		 "number_of_volume_extents",
+		 number_of_volume_extents,
+		 0 );
+
+		/* The blocks that are not in use in both the current and previous bitmap
+		 * and are not stored in the most recent store are sparse
+		 */
+		VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+		 "number_of_sparse_extents",
+		 number_of_sparse_extents,
+		 0 );
+	}
+	if( total_number_of_blocks > 0 )
+	{
+		VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+		 "number_of_store_data_extents",
+		 number_of_store_data_extents,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libvshadow_store_get_physical_extent(
+	          NULL,
+	          0,
+	          VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE,
+	          &physical_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( number_of_stores > 0 )
+	{
+		result = libvshadow_volume_get_store(
+		          volume,
+		          0,
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "store",
+		 store );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_store_get_physical_extent(
+		          store,
+		          -1,
+		          VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE,
+		          &physical_offset,
+		          &extent_size,
+		          &extent_flags,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvshadow_store_get_physical_extent(
+		          store,
+		          0,
+		          0,
+		          &physical_offset,
+		          &extent_size,
+		          &extent_flags,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvshadow_store_get_physical_extent(
+		          store,
+		          0,
+		          VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE,
+		          NULL,
+		          &extent_size,
+		          &extent_flags,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvshadow_store_get_physical_extent(
+		          store,
+		          0,
+		          VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE,
+		          &physical_offset,
+		          NULL,
+		          &extent_flags,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvshadow_store_get_physical_extent(
+		          store,
+		          0,
+		          VSHADOW_TEST_STORE_MAXIMUM_EXTENT_SIZE,
+		          &physical_offset,
+		          &extent_size,
+		          NULL,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvshadow_store_free(
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Clean up
+	 */
+	memory_free(
+	 volume_data );
+
+	volume_data = NULL;
+
+	memory_free(
+	 store_data );
+
+	store_data = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+	if( store_data != NULL )
+	{
+		memory_free(
+		 store_data );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_get_blocks_in_range function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_get_blocks_in_range(
+     libvshadow_volume_t *volume )
+{
+	off64_t limited_original_offsets[ 2 ];
+	uint32_t limited_flags[ 2 ];
+
+	libcerror_error_t *error        = NULL;
+	libvshadow_block_t *block       = NULL;
+	libvshadow_store_t *store       = NULL;
+	off64_t *offsets                = NULL;
+	off64_t *original_offsets       = NULL;
+	off64_t *relative_offsets       = NULL;
+	uint32_t *bitmaps               = NULL;
+	uint32_t *flags                 = NULL;
+	size64_t volume_size            = 0;
+	off64_t block_offset            = 0;
+	off64_t block_original_offset   = 0;
+	off64_t block_relative_offset   = 0;
+	uint32_t block_bitmap           = 0;
+	uint32_t block_flags            = 0;
+	int block_index                 = 0;
+	int number_of_blocks            = 0;
+	int number_of_blocks_in_range   = 0;
+	int number_of_stores            = 0;
+	int number_of_values            = 0;
+	int result                      = 0;
+	int store_index                 = 0;
+	int value_index                 = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_size(
+	          volume,
+	          &volume_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		result = libvshadow_volume_get_store(
+		          volume,
+		          store_index,
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "store",
+		 store );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_store_get_number_of_blocks(
+		          store,
+		          &number_of_blocks,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test the number of blocks in the range of the volume without values
+		 */
+		result = libvshadow_store_get_blocks_in_range(
+		          store,
+		          0,
+		          volume_size,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          0,
+		          &number_of_blocks_in_range,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Overlay blocks can be merged with the block they overlay
+		 */
+		VSHADOW_TEST_ASSERT_LESS_THAN_INT(
+		 "number_of_blocks_in_range",
+		 number_of_blocks_in_range,
+		 number_of_blocks + 1 );
+
+		if( number_of_blocks > 0 )
+		{
+			VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+			 "number_of_blocks_in_range",
+			 number_of_blocks_in_range,
+			 0 );
+		}
+		/* Test NULL value arrays with a number of values
+		 */
+		result = libvshadow_store_get_blocks_in_range(
+		          store,
+		          0,
+		          volume_size,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          number_of_blocks_in_range,
+		          &number_of_values,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "number_of_values",
+		 number_of_values,
+		 number_of_blocks_in_range );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test an empty range
+		 */
+		result = libvshadow_store_get_blocks_in_range(
+		          store,
+		          0,
+		          0,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          0,
+		          &number_of_values,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "number_of_values",
+		 number_of_values,
+		 0 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test a range beyond the end of the volume
+		 */
+		result = libvshadow_store_get_blocks_in_range(
+		          store,
+		          (off64_t) volume_size,
+		          volume_size,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          0,
+		          &number_of_values,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "number_of_values",
+		 number_of_values,
+		 0 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( number_of_blocks_in_range > 0 )
+		{
+			original_offsets = (off64_t *) memory_allocate(
+			                                sizeof( off64_t ) * number_of_blocks_in_range );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "original_offsets",
+			 original_offsets );
+
+			relative_offsets = (off64_t *) memory_allocate(
+			                                sizeof( off64_t ) * number_of_blocks_in_range );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "relative_offsets",
+			 relative_offsets );
+
+			offsets = (off64_t *) memory_allocate(
+			                       sizeof( off64_t ) * number_of_blocks_in_range );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "offsets",
+			 offsets );
+
+			flags = (uint32_t *) memory_allocate(
+			                      sizeof( uint32_t ) * number_of_blocks_in_range );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "flags",
+			 flags );
+
+			bitmaps = (uint32_t *) memory_allocate(
+			                        sizeof( uint32_t ) * number_of_blocks_in_range );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "bitmaps",
+			 bitmaps );
+
+			result = libvshadow_store_get_blocks_in_range(
+			          store,
+			          0,
+			          volume_size,
+			          original_offsets,
+			          relative_offsets,
+			          offsets,
+			          flags,
+			          bitmaps,
+			          number_of_blocks_in_range,
+			          &number_of_values,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "number_of_values",
+			 number_of_values,
+			 number_of_blocks_in_range );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			/* Every value should match a block retrieved by index
+			 * and the values should be ordered by original offset
+			 */
+			for( value_index = 0;
+			     value_index < number_of_blocks_in_range;
+			     value_index++ )
+			{
+				if( value_index > 0 )
+				{
+					VSHADOW_TEST_ASSERT_LESS_THAN_UINT64(
+					 "original_offset",
+					 (uint64_t) original_offsets[ value_index - 1 ],
+					 (uint64_t) original_offsets[ value_index ] + 1 );
+				}
+				for( block_index = 0;
+				     block_index < number_of_blocks;
+				     block_index++ )
+				{
+					result = libvshadow_store_get_block_by_index(
+					          store,
+					          block_index,
+					          &block,
+					          &error );
+
+					VSHADOW_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+					 "block",
+					 block );
+
+					VSHADOW_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+
+					result = libvshadow_block_get_values(
+					          block,
+					          &block_original_offset,
+					          &block_relative_offset,
+					          &block_offset,
+					          &block_flags,
+					          &block_bitmap,
+					          &error );
+
+					VSHADOW_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					VSHADOW_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+
+					result = libvshadow_block_free(
+					          &block,
+					          &error );
+
+					VSHADOW_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					VSHADOW_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+
+					if( ( block_original_offset == original_offsets[ value_index ] )
+					 && ( block_relative_offset == relative_offsets[ value_index ] )
+					 && ( block_offset == offsets[ value_index ] )
+					 && ( block_flags == flags[ value_index ] )
+					 && ( block_bitmap == bitmaps[ value_index ] ) )
+					{
+						break;
+					}
+				}
+				VSHADOW_TEST_ASSERT_LESS_THAN_INT(
+				 "block_index",
+				 block_index,
+				 number_of_blocks );
+			}
+			/* Test the range of a single block
+			 */
+			value_index = number_of_blocks_in_range / 2;
+
+			result = libvshadow_store_get_blocks_in_range(
+			          store,
+			          original_offsets[ value_index ],
+			          1,
+			          limited_original_offsets,
+			          NULL,
+			          NULL,
+			          limited_flags,
+			          NULL,
+			          1,
+			          &number_of_values,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+			 "number_of_values",
+			 number_of_values,
+			 0 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			VSHADOW_TEST_ASSERT_LESS_THAN_UINT64(
+			 "limited_original_offsets[ 0 ]",
+			 (uint64_t) limited_original_offsets[ 0 ],
+			 (uint64_t) original_offsets[ value_index ] + 1 );
+
+			/* Test a number of values that is smaller than the number of blocks
+			 * where the values beyond the number of values should not be set
+			 */
+			limited_original_offsets[ 0 ] = -1;
+			limited_original_offsets[ 1 ] = -1;
+			limited_flags[ 0 ]            = 0xffffffffUL;
+			limited_flags[ 1 ]            = 0xffffffffUL;
+
+			result = libvshadow_store_get_blocks_in_range(
+			          store,
+			          0,
+			          volume_size,
+			          limited_original_offsets,
+			          NULL,
+			          NULL,
+			          limited_flags,
+			          NULL,
+			          ( number_of_blocks_in_range > 1 ) ? 1 : 0,
+			          &number_of_values,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "number_of_values",
+			 number_of_values,
+			 number_of_blocks_in_range );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			if( number_of_blocks_in_range > 1 )
+			{
+				VSHADOW_TEST_ASSERT_EQUAL_INT64(
+				 "limited_original_offsets[ 0 ]",
+				 (int64_t) limited_original_offsets[ 0 ],
+				 (int64_t) original_offsets[ 0 ] );
+
+				VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+				 "limited_flags[ 0 ]",
+				 limited_flags[ 0 ],
+				 flags[ 0 ] );
+
+				value_index = 1;
+			}
+			else
+			{
+				value_index = 0;
+			}
+			VSHADOW_TEST_ASSERT_EQUAL_INT64(
+			 "limited_original_offsets[ value_index ]",
+			 (int64_t) limited_original_offsets[ value_index ],
+			 (int64_t) -1 );
+
+			VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+			 "limited_flags[ value_index ]",
+			 limited_flags[ value_index ],
+			 (uint32_t) 0xffffffffUL );
+
+			memory_free(
+			 bitmaps );
+
+			bitmaps = NULL;
+
+			memory_free(
+			 flags );
+
+			flags = NULL;
+
+			memory_free(
+			 offsets );
+
+			offsets = NULL;
+
+			memory_free(
+			 relative_offsets );
+
+			relative_offsets = NULL;
+
+			memory_free(
+			 original_offsets );
+
+			original_offsets = NULL;
+		}
+		result = libvshadow_store_free(
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libvshadow_store_get_blocks_in_range(
+	          NULL,
+	          0,
+	          volume_size,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &number_of_blocks_in_range,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( number_of_stores > 0 )
+	{
+		result = libvshadow_volume_get_store(
+		          volume,
+		          0,
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "store",
+		 store );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_store_get_blocks_in_range(
+		          store,
+		          -1,
+		          volume_size,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          0,
+		          &number_of_blocks_in_range,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvshadow_store_get_blocks_in_range(
+		          store,
+		          0,
+		          volume_size,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          -1,
+		          &number_of_blocks_in_range,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvshadow_store_get_blocks_in_range(
+		          store,
+		          0,
+		          volume_size,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          NULL,
+		          0,
+		          NULL,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvshadow_store_free(
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block != NULL )
+	{
+		libvshadow_block_free(
+		 &block,
+		 NULL );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( bitmaps != NULL )
+	{
+		memory_free(
+		 bitmaps );
+	}
+	if( flags != NULL )
+	{
+		memory_free(
+		 flags );
+	}
+	if( offsets != NULL )
+	{
+		memory_free(
+		 offsets );
+	}
+	if( relative_offsets != NULL )
+	{
+		memory_free(
+		 relative_offsets );
+	}
+	if( original_offsets != NULL )
+	{
+		memory_free(
+		 original_offsets );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvshadow_volume_t *volume      = NULL;
+	system_character_t *source       = NULL;
+	system_integer_t option          = 0;
+	int result                       = 0;
+
+	while( ( option = vshadow_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+#if defined( __GNUC__ ) && defined( TODO )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_initialize",
+	 vshadow_test_store_initialize );
+
+#endif /* defined( __GNUC__ ) */
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_free",
+	 vshadow_test_store_free );
+
+#if defined( __GNUC__ )
+
+	/* TODO add tests for libvshadow_store_has_in_volume_data */
+	/* TODO add tests for libvshadow_internal_store_read_buffer_from_file_io_handle */
+	/* TODO add tests for libvshadow_store_read_buffer */
+	/* TODO add tests for libvshadow_store_read_buffer_from_file_io_handle */
+	/* TODO add tests for libvshadow_store_read_buffer_at_offset */
+	/* TODO add tests for libvshadow_internal_store_seek_offset */
+	/* TODO add tests for libvshadow_store_seek_offset */
+	/* TODO add tests for libvshadow_store_get_offset */
+	/* TODO add tests for libvshadow_store_get_size */
+	/* TODO add tests for libvshadow_store_get_volume_size */
+	/* TODO add tests for libvshadow_store_get_identifier */
+	/* TODO add tests for libvshadow_store_get_creation_time */
+	/* TODO add tests for libvshadow_store_get_copy_identifier */
+	/* TODO add tests for libvshadow_store_get_copy_set_identifier */
+	/* TODO add tests for libvshadow_store_get_attribute_flags */
+	/* TODO add tests for libvshadow_store_get_number_of_blocks */
+	/* TODO add tests for libvshadow_store_get_block_by_index */
+
+#endif /* defined( __GNUC__ ) */
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+	if( source != NULL )
+	{
+		/* Initialize test
+		 */
+		result = vshadow_test_store_open_source(
+		          &volume,
+		          &file_io_handle,
+		          source,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "volume",
+		 volume );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_store_get_physical_extent",
+		 vshadow_test_store_get_physical_extent,
+		 volume,
+		 file_io_handle );
+
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_store_get_blocks_in_range",
+		 vshadow_test_store_get_blocks_in_range,
+		 volume );
+
+		/* Clean up
+		 */
+		result = vshadow_test_store_close_source(
+		          &volume,
+		          &file_io_handle,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "volume",
+		 volume );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		vshadow_test_store_close_source(
+		 &volume,
+		 &file_io_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
@@ -0,0 +1,798 @@
+/*
+ * Library store_block_reader type test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_statistics.h"
+#include "../libvshadow/libvshadow_store_block.h"
+#include "../libvshadow/libvshadow_store_block_reader.h"
+
+uint8_t vshadow_test_store_block_reader_identifier[ 16 ] = {
+	0x6b, 0x87, 0x08, 0x38, 0x76, 0xc1, 0x48, 0x4e, 0xb7, 0xae, 0x04, 0x04, 0x6e, 0x6c, 0xc7, 0x52 };
+
+/* The test data contains 3 store blocks that form a single chain
+ */
+uint8_t vshadow_test_store_block_reader_data[ 3 * 0x4000 ];
+
+#if defined( __GNUC__ )
+
+/* Initializes the test data
+ */
+void vshadow_test_store_block_reader_initialize_data(
+      void )
+{
+	uint8_t *block_data = NULL;
+	int block_index     = 0;
+
+	memory_set(
+	 vshadow_test_store_block_reader_data,
+	 0,
+	 3 * 0x4000 );
+
+	for( block_index = 0;
+	     block_index < 3;
+	     block_index++ )
+	{
+		block_data = &( vshadow_test_store_block_reader_data[ block_index * 0x4000 ] );
+
+		memory_copy(
+		 block_data,
+		 vshadow_test_store_block_reader_identifier,
+		 16 );
+
+		/* version
+		 */
+		byte_stream_copy_from_uint32_little_endian(
+		 &( block_data[ 16 ] ),
+		 1 );
+
+		/* record type
+		 */
+		byte_stream_copy_from_uint32_little_endian(
+		 &( block_data[ 20 ] ),
+		 4 );
+
+		/* offset
+		 */
+		byte_stream_copy_from_uint64_little_endian(
+		 &( block_data[ 32 ] ),
+		 (uint64_t) block_index * 0x4000 );
+
+		/* next offset
+		 */
+		if( block_index < 2 )
+		{
+			byte_stream_copy_from_uint64_little_endian(
+			 &( block_data[ 40 ] ),
+			 (uint64_t) ( block_index + 1 ) * 0x4000 );
+		}
+	}
+}
+
+/* Tests the libvshadow_store_block_reader_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_block_reader_initialize(
+     void )
+{
+	libcerror_error_t *error                            = NULL;
+	libvshadow_store_block_reader_t *store_block_reader = NULL;
+	int result                                          = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_block_reader_initialize(
+	          &store_block_reader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_block_reader",
+	 store_block_reader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_block_reader_free(
+	          &store_block_reader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store_block_reader",
+	 store_block_reader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_block_reader_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	store_block_reader = (libvshadow_store_block_reader_t *) 0x12345678UL;
+
+	result = libvshadow_store_block_reader_initialize(
+	          &store_block_reader,
+	          &error );
+
+	store_block_reader = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	/* Test libvshadow_store_block_reader_initialize with malloc failing
+	 */
+	vshadow_test_malloc_attempts_before_fail = 0;
+
+	result = libvshadow_store_block_reader_initialize(
+	          &store_block_reader,
+	          &error );
+
+	if( vshadow_test_malloc_attempts_before_fail != -1 )
+	{
+		vshadow_test_malloc_attempts_before_fail = -1;
+
+		if( store_block_reader != NULL )
+		{
+			libvshadow_store_block_reader_free(
+			 &store_block_reader,
+			 NULL );
+		}
+	}
+	else
+	{
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "store_block_reader",
+		 store_block_reader );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_block_reader != NULL )
+	{
+		libvshadow_store_block_reader_free(
+		 &store_block_reader,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_block_reader_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_block_reader_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_block_reader_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_block_reader_set_read_ahead_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_block_reader_set_read_ahead_size(
+     void )
+{
+	libcerror_error_t *error                            = NULL;
+	libvshadow_store_block_reader_t *store_block_reader = NULL;
+	int result                                          = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_store_block_reader_initialize(
+	          &store_block_reader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_block_reader",
+	 store_block_reader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_block_reader_set_read_ahead_size(
+	          store_block_reader,
+	          0x4001,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_block_reader->number_of_read_ahead_blocks",
+	 store_block_reader->number_of_read_ahead_blocks,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_block_reader_set_read_ahead_size(
+	          store_block_reader,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_block_reader->number_of_read_ahead_blocks",
+	 store_block_reader->number_of_read_ahead_blocks,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_block_reader_set_read_ahead_size(
+	          store_block_reader,
+	          0xffffffffffffffffULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_block_reader->number_of_read_ahead_blocks",
+	 store_block_reader->number_of_read_ahead_blocks,
+	 LIBVSHADOW_STORE_BLOCK_READER_MAXIMUM_NUMBER_OF_BLOCKS );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_block_reader_set_read_ahead_size(
+	          NULL,
+	          0x4000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_block_reader_free(
+	          &store_block_reader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store_block_reader",
+	 store_block_reader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_block_reader != NULL )
+	{
+		libvshadow_store_block_reader_free(
+		 &store_block_reader,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_block_reader_read function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_block_reader_read(
+     void )
+{
+	libvshadow_statistics_t statistics;
+
+	libbfio_handle_t *file_io_handle                    = NULL;
+	libcerror_error_t *error                            = NULL;
+	libvshadow_store_block_t *store_block               = NULL;
+	libvshadow_store_block_reader_t *store_block_reader = NULL;
+	int result                                          = 0;
+
+	/* Initialize test
+	 */
+	vshadow_test_store_block_reader_initialize_data();
+
+	memory_set(
+	 &statistics,
+	 0,
+	 sizeof( libvshadow_statistics_t ) );
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          vshadow_test_store_block_reader_data,
+	          3 * 0x4000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_block_reader_initialize(
+	          &store_block_reader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_block_reader",
+	 store_block_reader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_block_reader_read(
+	          store_block_reader,
+	          file_io_handle,
+	          0,
+	          &statistics,
+	          &store_block,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_block",
+	 store_block );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "store_block->next_offset",
+	 (int64_t) store_block->next_offset,
+	 (int64_t) 0x4000 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The second store block is read together with the third
+	 */
+	result = libvshadow_store_block_reader_read(
+	          store_block_reader,
+	          file_io_handle,
+	          0x4000,
+	          &statistics,
+	          &store_block,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "store_block->offset",
+	 (int64_t) store_block->offset,
+	 (int64_t) 0x4000 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_block_reader_read(
+	          store_block_reader,
+	          file_io_handle,
+	          0x8000,
+	          &statistics,
+	          &store_block,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "store_block->offset",
+	 (int64_t) store_block->offset,
+	 (int64_t) 0x8000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "store_block->next_offset",
+	 (int64_t) store_block->next_offset,
+	 (int64_t) 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics.number_of_read_calls",
+	 statistics.number_of_read_calls,
+	 (uint64_t) 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics.read_size",
+	 statistics.read_size,
+	 (uint64_t) ( 3 * 0x4000 ) );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_block_reader_read(
+	          NULL,
+	          file_io_handle,
+	          0,
+	          &statistics,
+	          &store_block,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_block_reader_read(
+	          store_block_reader,
+	          file_io_handle,
+	          -1,
+	          &statistics,
+	          &store_block,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_block_reader_read(
+	          store_block_reader,
+	          file_io_handle,
+	          0,
+	          &statistics,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_block_reader_read(
+	          store_block_reader,
+	          file_io_handle,
+	          3 * 0x4000,
+	          &statistics,
+	          &store_block,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_block_reader_free(
+	          &store_block_reader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store_block_reader",
+	 store_block_reader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_block_reader != NULL )
+	{
+		libvshadow_store_block_reader_free(
+		 &store_block_reader,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_block_reader_initialize",
+	 vshadow_test_store_block_reader_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_block_reader_free",
+	 vshadow_test_store_block_reader_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_block_reader_set_read_ahead_size",
+	 vshadow_test_store_block_reader_set_read_ahead_size );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_block_reader_read",
+	 vshadow_test_store_block_reader_read );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
@@ -20,23 +20,99 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include "vshadow_test_libbfio.h"
 #include "vshadow_test_libcerror.h"
 #include "vshadow_test_libvshadow.h"
 #include "vshadow_test_macros.h"
 #include "vshadow_test_memory.h"
 #include "vshadow_test_unused.h"
 
+#include "../libvshadow/libvshadow_definitions.h"
+#include "../libvshadow/libvshadow_statistics.h"
 #include "../libvshadow/libvshadow_store_descriptor.h"
+#include "../libvshadow/vshadow_store.h"
+
+uint8_t vshadow_test_store_descriptor_identifier[ 16 ] = {
+	0x6b, 0x87, 0x08, 0x38, 0x76, 0xc1, 0x48, 0x4e, 0xb7, 0xae, 0x04, 0x04, 0x6e, 0x6c, 0xc7, 0x52 };
+
+uint8_t vshadow_test_store_descriptor_copy_identifier[ 16 ] = {
+	0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 };
+
+/* The test data contains a single store header block
+ */
+uint8_t vshadow_test_store_descriptor_store_header_data[ 0x4000 ];
 
 #if defined( __GNUC__ )
 
+/* Initializes the store header test data with a specific record type
+ */
+void vshadow_test_store_descriptor_initialize_store_header_data(
+      uint32_t record_type )
+{
+	vshadow_store_information_t *store_information = NULL;
+	uint8_t *store_header_data                     = NULL;
+	size_t string_index                            = 0;
+
+	memory_set(
+	 vshadow_test_store_descriptor_store_header_data,
+	 0,
+	 0x4000 );
+
+	memory_copy(
+	 ( (vshadow_store_block_header_t *) vshadow_test_store_descriptor_store_header_data )->identifier,
+	 vshadow_test_store_descriptor_identifier,
+	 16 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vshadow_store_block_header_t *) vshadow_test_store_descriptor_store_header_data )->version,
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vshadow_store_block_header_t *) vshadow_test_store_descriptor_store_header_data )->record_type,
+	 record_type );
+
+	store_header_data = &( vshadow_test_store_descriptor_store_header_data[ sizeof( vshadow_store_header_t ) ] );
+	store_information = (vshadow_store_information_t *) store_header_data;
+
+	memory_copy(
+	 store_information->copy_identifier,
+	 vshadow_test_store_descriptor_copy_identifier,
+	 16 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 store_information->attribute_flags,
+	 0x0042000dUL );
+
+	store_header_data = &( store_header_data[ sizeof( vshadow_store_information_t ) ] );
+
+	/* The operating and service machine strings contain "test" in UTF-16 little-endian
+	 */
+	for( string_index = 0;
+	     string_index < 2;
+	     string_index++ )
+	{
+		byte_stream_copy_from_uint16_little_endian(
+		 store_header_data,
+		 8 );
+
+		store_header_data[ 2 ] = (uint8_t) 't';
+		store_header_data[ 4 ] = (uint8_t) 'e';
+		store_header_data[ 6 ] = (uint8_t) 's';
+		store_header_data[ 8 ] = (uint8_t) 't';
+
+		store_header_data = &( store_header_data[ 10 ] );
+	}
+}
+
 /* Tests the libvshadow_store_descriptor_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -254,6 +330,334 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvshadow_store_descriptor_read_store_header function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_descriptor_read_store_header(
+     void )
+{
+	libvshadow_statistics_t statistics;
+	uint8_t guid[ 16 ];
+
+	libbfio_handle_t *file_io_handle                = NULL;
+	libcerror_error_t *error                        = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	uint32_t attribute_flags                        = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	vshadow_test_store_descriptor_initialize_store_header_data(
+	 LIBVSHADOW_RECORD_TYPE_STORE_HEADER );
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          vshadow_test_store_descriptor_store_header_data,
+	          0x4000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_descriptor_initialize(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The catalog provides the store header offset, the store header
+	 * itself is not read until one of its values is needed
+	 */
+	store_descriptor->store_header_offset      = 0;
+	store_descriptor->has_in_volume_store_data = 1;
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "store_descriptor->store_header_read",
+	 store_descriptor->store_header_read,
+	 0 );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_descriptor_get_copy_identifier(
+	          store_descriptor,
+	          file_io_handle,
+	          guid,
+	          16,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          guid,
+	          vshadow_test_store_descriptor_copy_identifier,
+	          16 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "store_descriptor->store_header_read",
+	 store_descriptor->store_header_read,
+	 1 );
+
+	result = libvshadow_store_descriptor_get_attribute_flags(
+	          store_descriptor,
+	          file_io_handle,
+	          &attribute_flags,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "attribute_flags",
+	 attribute_flags,
+	 (uint32_t) 0x0042000dUL );
+
+	result = libvshadow_store_descriptor_read_store_header(
+	          store_descriptor,
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The store header was read exactly once
+	 */
+	result = libvshadow_store_descriptor_get_statistics(
+	          store_descriptor,
+	          &statistics,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics.number_of_read_calls",
+	 statistics.number_of_read_calls,
+	 (uint64_t) 1 );
+
+	result = libvshadow_store_descriptor_free(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_descriptor_read_store_header(
+	          NULL,
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a getter with a store header that has an unsupported record type
+	 */
+	vshadow_test_store_descriptor_initialize_store_header_data(
+	 LIBVSHADOW_RECORD_TYPE_STORE_INDEX );
+
+	result = libvshadow_store_descriptor_initialize(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	store_descriptor->store_header_offset      = 0;
+	store_descriptor->has_in_volume_store_data = 1;
+
+	result = libvshadow_store_descriptor_get_attribute_flags(
+	          store_descriptor,
+	          file_io_handle,
+	          &attribute_flags,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "store_descriptor->store_header_read",
+	 store_descriptor->store_header_read,
+	 0 );
+
+	result = libvshadow_store_descriptor_free(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &store_descriptor,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) */
 
 /* The main program
@@ -285,7 +689,11 @@ int main(
 	/* TODO add tests for libvshadow_store_descriptor_compare_by_creation_time */
 	/* TODO add tests for libvshadow_store_descriptor_compare_by_identifier */
 	/* TODO add tests for libvshadow_store_descriptor_read_catalog_entry */
-	/* TODO add tests for libvshadow_store_descriptor_read_store_header */
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_descriptor_read_store_header",
+	 vshadow_test_store_descriptor_read_store_header );
+
 	/* TODO add tests for libvshadow_store_descriptor_read_store_bitmap */
 	/* TODO add tests for libvshadow_store_descriptor_read_store_block_list */
 	/* TODO add tests for libvshadow_store_descriptor_read_store_block_range_list */
@@ -0,0 +1,1299 @@
+/*
+ * Library thread_pool type test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libcthreads.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_thread_pool.h"
+
+#if defined( __GNUC__ ) && defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+
+#define VSHADOW_TEST_THREAD_POOL_NUMBER_OF_TASKS	1000
+
+typedef struct vshadow_test_thread_pool_arguments vshadow_test_thread_pool_arguments_t;
+
+struct vshadow_test_thread_pool_arguments
+{
+	/* The thread pool
+	 */
+	libvshadow_thread_pool_t *thread_pool;
+
+	/* The number of times each task was run
+	 */
+	int task_counts[ VSHADOW_TEST_THREAD_POOL_NUMBER_OF_TASKS ];
+
+	/* The task index of the task that fails or -1 if none
+	 */
+	int failing_task_index;
+
+	/* The number of tasks per nested job or 0 if tasks do not run a nested job
+	 */
+	int number_of_nested_tasks;
+};
+
+typedef struct vshadow_test_thread_pool_user_arguments vshadow_test_thread_pool_user_arguments_t;
+
+struct vshadow_test_thread_pool_user_arguments
+{
+	/* The thread pool, grabbed before the user thread is created
+	 */
+	libvshadow_thread_pool_t *thread_pool;
+
+	/* The arguments of the job the user thread runs
+	 */
+	vshadow_test_thread_pool_arguments_t *test_arguments;
+
+	/* The result of running the job
+	 */
+	int result;
+};
+
+/* Callback function of the test tasks
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_thread_pool_task_callback(
+     int task_index,
+     void *arguments )
+{
+	vshadow_test_thread_pool_arguments_t *test_arguments = NULL;
+
+	test_arguments = (vshadow_test_thread_pool_arguments_t *) arguments;
+
+	if( ( task_index < 0 )
+	 || ( task_index >= VSHADOW_TEST_THREAD_POOL_NUMBER_OF_TASKS ) )
+	{
+		return( -1 );
+	}
+	test_arguments->task_counts[ task_index ] += 1;
+
+	if( task_index == test_arguments->failing_task_index )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Callback function of the test tasks that run a nested job
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_thread_pool_nested_task_callback(
+     int task_index,
+     void *arguments )
+{
+	vshadow_test_thread_pool_arguments_t nested_arguments;
+
+	vshadow_test_thread_pool_arguments_t *test_arguments = NULL;
+	int result                                           = 0;
+	int nested_task_index                                = 0;
+
+	test_arguments = (vshadow_test_thread_pool_arguments_t *) arguments;
+
+	if( ( task_index < 0 )
+	 || ( task_index >= VSHADOW_TEST_THREAD_POOL_NUMBER_OF_TASKS ) )
+	{
+		return( -1 );
+	}
+	if( memory_set(
+	     &nested_arguments,
+	     0,
+	     sizeof( vshadow_test_thread_pool_arguments_t ) ) == NULL )
+	{
+		return( -1 );
+	}
+	nested_arguments.failing_task_index = -1;
+
+	result = libvshadow_thread_pool_run(
+	          test_arguments->thread_pool,
+	          &vshadow_test_thread_pool_task_callback,
+	          (void *) &nested_arguments,
+	          test_arguments->number_of_nested_tasks,
+	          NULL );
+
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	for( nested_task_index = 0;
+	     nested_task_index < test_arguments->number_of_nested_tasks;
+	     nested_task_index++ )
+	{
+		if( nested_arguments.task_counts[ nested_task_index ] != 1 )
+		{
+			return( -1 );
+		}
+	}
+	test_arguments->task_counts[ task_index ] += 1;
+
+	return( 1 );
+}
+
+/* Callback function of the test tasks that try to free their thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_thread_pool_free_task_callback(
+     int task_index,
+     void *arguments )
+{
+	vshadow_test_thread_pool_arguments_t *test_arguments = NULL;
+	libvshadow_thread_pool_t *thread_pool                = NULL;
+	int result                                           = 0;
+
+	test_arguments = (vshadow_test_thread_pool_arguments_t *) arguments;
+
+	if( ( task_index < 0 )
+	 || ( task_index >= VSHADOW_TEST_THREAD_POOL_NUMBER_OF_TASKS ) )
+	{
+		return( -1 );
+	}
+	thread_pool = test_arguments->thread_pool;
+
+	if( libvshadow_thread_pool_is_running_task(
+	     thread_pool,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	/* The thread pool is not freed since the task would wait for itself
+	 */
+	result = libvshadow_thread_pool_free(
+	          &thread_pool,
+	          NULL );
+
+	if( ( result != -1 )
+	 || ( thread_pool != test_arguments->thread_pool ) )
+	{
+		return( -1 );
+	}
+	test_arguments->task_counts[ task_index ] += 1;
+
+	return( 1 );
+}
+
+/* Callback function of the user thread that runs a job on a grabbed thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_thread_pool_user_thread_callback(
+     vshadow_test_thread_pool_user_arguments_t *user_arguments )
+{
+	user_arguments->result = libvshadow_thread_pool_run(
+	                          user_arguments->thread_pool,
+	                          &vshadow_test_thread_pool_task_callback,
+	                          (void *) user_arguments->test_arguments,
+	                          VSHADOW_TEST_THREAD_POOL_NUMBER_OF_TASKS,
+	                          NULL );
+
+	if( libvshadow_thread_pool_release(
+	     user_arguments->thread_pool,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libvshadow_thread_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_thread_pool_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libvshadow_thread_pool_t *thread_pool = NULL;
+	int result                            = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_thread_pool_initialize(
+	          &thread_pool,
+	          4,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_pool",
+	 thread_pool );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_thread_pool_free(
+	          &thread_pool,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "thread_pool",
+	 thread_pool );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_thread_pool_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	thread_pool = (libvshadow_thread_pool_t *) 0x12345678UL;
+
+	result = libvshadow_thread_pool_initialize(
+	          &thread_pool,
+	          4,
+	          &error );
+
+	thread_pool = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_thread_pool_initialize(
+	          &thread_pool,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_thread_pool_initialize(
+	          &thread_pool,
+	          LIBVSHADOW_MAXIMUM_NUMBER_OF_THREADS + 1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_pool != NULL )
+	{
+		libvshadow_thread_pool_free(
+		 &thread_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_thread_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_thread_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_thread_pool_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_thread_pool_get_number_of_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_thread_pool_get_number_of_threads(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libvshadow_thread_pool_t *thread_pool = NULL;
+	int number_of_threads                 = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_thread_pool_initialize(
+	          &thread_pool,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_pool",
+	 thread_pool );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_thread_pool_get_number_of_threads(
+	          thread_pool,
+	          &number_of_threads,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 3 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_thread_pool_get_number_of_threads(
+	          NULL,
+	          &number_of_threads,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_thread_pool_get_number_of_threads(
+	          thread_pool,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_thread_pool_free(
+	          &thread_pool,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "thread_pool",
+	 thread_pool );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_pool != NULL )
+	{
+		libvshadow_thread_pool_free(
+		 &thread_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_thread_pool_grab and libvshadow_thread_pool_release functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_thread_pool_grab(
+     void )
+{
+	vshadow_test_thread_pool_arguments_t test_arguments;
+	vshadow_test_thread_pool_user_arguments_t user_arguments;
+
+	libcerror_error_t *error              = NULL;
+	libcthreads_thread_t *user_thread     = NULL;
+	libvshadow_thread_pool_t *thread_pool = NULL;
+	int result                            = 0;
+	int task_index                        = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_thread_pool_initialize(
+	          &thread_pool,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_pool",
+	 thread_pool );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_thread_pool_grab(
+	          thread_pool,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "thread_pool->number_of_users",
+	 thread_pool->number_of_users,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_thread_pool_release(
+	          thread_pool,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "thread_pool->number_of_users",
+	 thread_pool->number_of_users,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_thread_pool_release(
+	          thread_pool,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_thread_pool_grab(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_thread_pool_release(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test that free waits until a user that grabbed the thread pool released it
+	 */
+	memory_set(
+	 &test_arguments,
+	 0,
+	 sizeof( vshadow_test_thread_pool_arguments_t ) );
+
+	test_arguments.thread_pool        = thread_pool;
+	test_arguments.failing_task_index = -1;
+
+	user_arguments.thread_pool    = thread_pool;
+	user_arguments.test_arguments = &test_arguments;
+	user_arguments.result         = 0;
+
+	result = libvshadow_thread_pool_grab(
+	          thread_pool,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_create(
+	          &user_thread,
+	          NULL,
+	          (int (*)(void *)) &vshadow_test_thread_pool_user_thread_callback,
+	          (void *) &user_arguments,
+	          &error );
+
+	if( result != 1 )
+	{
+		libvshadow_thread_pool_release(
+		 thread_pool,
+		 NULL );
+	}
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_thread_pool_free(
+	          &thread_pool,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "thread_pool",
+	 thread_pool );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_join(
+	          &user_thread,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "user_arguments.result",
+	 user_arguments.result,
+	 1 );
+
+	for( task_index = 0;
+	     task_index < VSHADOW_TEST_THREAD_POOL_NUMBER_OF_TASKS;
+	     task_index++ )
+	{
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "task_counts[ task_index ]",
+		 test_arguments.task_counts[ task_index ],
+		 1 );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( user_thread != NULL )
+	{
+		libcthreads_thread_join(
+		 &user_thread,
+		 NULL );
+	}
+	if( thread_pool != NULL )
+	{
+		libvshadow_thread_pool_free(
+		 &thread_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_thread_pool_is_running_task function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_thread_pool_is_running_task(
+     void )
+{
+	vshadow_test_thread_pool_arguments_t test_arguments;
+
+	libcerror_error_t *error              = NULL;
+	libvshadow_thread_pool_t *thread_pool = NULL;
+	int result                            = 0;
+	int task_index                        = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_thread_pool_initialize(
+	          &thread_pool,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_pool",
+	 thread_pool );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_thread_pool_is_running_task(
+	          thread_pool,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test tasks that try to free the thread pool, on the threads of
+	 * the thread pool and on the calling thread
+	 */
+	memory_set(
+	 &test_arguments,
+	 0,
+	 sizeof( vshadow_test_thread_pool_arguments_t ) );
+
+	test_arguments.thread_pool        = thread_pool;
+	test_arguments.failing_task_index = -1;
+
+	result = libvshadow_thread_pool_run(
+	          thread_pool,
+	          &vshadow_test_thread_pool_free_task_callback,
+	          (void *) &test_arguments,
+	          64,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( task_index = 0;
+	     task_index < 64;
+	     task_index++ )
+	{
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "task_counts[ task_index ]",
+		 test_arguments.task_counts[ task_index ],
+		 1 );
+	}
+	result = libvshadow_thread_pool_is_running_task(
+	          thread_pool,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_thread_pool_is_running_task(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_thread_pool_free(
+	          &thread_pool,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "thread_pool",
+	 thread_pool );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_pool != NULL )
+	{
+		libvshadow_thread_pool_free(
+		 &thread_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_thread_pool_run function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_thread_pool_run(
+     void )
+{
+	vshadow_test_thread_pool_arguments_t test_arguments;
+
+	libcerror_error_t *error              = NULL;
+	libvshadow_thread_pool_t *thread_pool = NULL;
+	int number_of_threads                 = 0;
+	int result                            = 0;
+	int task_index                        = 0;
+
+	for( number_of_threads = 1;
+	     number_of_threads <= 4;
+	     number_of_threads++ )
+	{
+		/* Initialize test
+		 */
+		result = libvshadow_thread_pool_initialize(
+		          &thread_pool,
+		          number_of_threads,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "thread_pool",
+		 thread_pool );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test regular cases
+		 */
+		memory_set(
+		 &test_arguments,
+		 0,
+		 sizeof( vshadow_test_thread_pool_arguments_t ) );
+
+		test_arguments.thread_pool        = thread_pool;
+		test_arguments.failing_task_index = -1;
+
+		result = libvshadow_thread_pool_run(
+		          thread_pool,
+		          &vshadow_test_thread_pool_task_callback,
+		          (void *) &test_arguments,
+		          VSHADOW_TEST_THREAD_POOL_NUMBER_OF_TASKS,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( task_index = 0;
+		     task_index < VSHADOW_TEST_THREAD_POOL_NUMBER_OF_TASKS;
+		     task_index++ )
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "task_counts[ task_index ]",
+			 test_arguments.task_counts[ task_index ],
+			 1 );
+		}
+		/* Test a job with less tasks than threads
+		 */
+		memory_set(
+		 &test_arguments,
+		 0,
+		 sizeof( vshadow_test_thread_pool_arguments_t ) );
+
+		test_arguments.thread_pool        = thread_pool;
+		test_arguments.failing_task_index = -1;
+
+		result = libvshadow_thread_pool_run(
+		          thread_pool,
+		          &vshadow_test_thread_pool_task_callback,
+		          (void *) &test_arguments,
+		          1,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "task_counts[ 0 ]",
+		 test_arguments.task_counts[ 0 ],
+		 1 );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "task_counts[ 1 ]",
+		 test_arguments.task_counts[ 1 ],
+		 0 );
+
+		/* Test a job without tasks
+		 */
+		result = libvshadow_thread_pool_run(
+		          thread_pool,
+		          &vshadow_test_thread_pool_task_callback,
+		          (void *) &test_arguments,
+		          0,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test tasks that run a nested job on the same thread pool
+		 */
+		memory_set(
+		 &test_arguments,
+		 0,
+		 sizeof( vshadow_test_thread_pool_arguments_t ) );
+
+		test_arguments.thread_pool            = thread_pool;
+		test_arguments.failing_task_index     = -1;
+		test_arguments.number_of_nested_tasks = 32;
+
+		result = libvshadow_thread_pool_run(
+		          thread_pool,
+		          &vshadow_test_thread_pool_nested_task_callback,
+		          (void *) &test_arguments,
+		          16,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( task_index = 0;
+		     task_index < 16;
+		     task_index++ )
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "task_counts[ task_index ]",
+			 test_arguments.task_counts[ task_index ],
+			 1 );
+		}
+		/* Test a job with a failing task, the other tasks still run
+		 */
+		memory_set(
+		 &test_arguments,
+		 0,
+		 sizeof( vshadow_test_thread_pool_arguments_t ) );
+
+		test_arguments.thread_pool        = thread_pool;
+		test_arguments.failing_task_index = 500;
+
+		result = libvshadow_thread_pool_run(
+		          thread_pool,
+		          &vshadow_test_thread_pool_task_callback,
+		          (void *) &test_arguments,
+		          VSHADOW_TEST_THREAD_POOL_NUMBER_OF_TASKS,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		for( task_index = 0;
+		     task_index < VSHADOW_TEST_THREAD_POOL_NUMBER_OF_TASKS;
+		     task_index++ )
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "task_counts[ task_index ]",
+			 test_arguments.task_counts[ task_index ],
+			 1 );
+		}
+		/* Clean up
+		 */
+		result = libvshadow_thread_pool_free(
+		          &thread_pool,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "thread_pool",
+		 thread_pool );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Initialize test
+	 */
+	result = libvshadow_thread_pool_initialize(
+	          &thread_pool,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_pool",
+	 thread_pool );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_thread_pool_run(
+	          NULL,
+	          &vshadow_test_thread_pool_task_callback,
+	          (void *) &test_arguments,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_thread_pool_run(
+	          thread_pool,
+	          NULL,
+	          (void *) &test_arguments,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_thread_pool_run(
+	          thread_pool,
+	          &vshadow_test_thread_pool_task_callback,
+	          (void *) &test_arguments,
+	          -1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_thread_pool_free(
+	          &thread_pool,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "thread_pool",
+	 thread_pool );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_pool != NULL )
+	{
+		libvshadow_thread_pool_free(
+		 &thread_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_thread_pool_initialize",
+	 vshadow_test_thread_pool_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_thread_pool_free",
+	 vshadow_test_thread_pool_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_thread_pool_get_number_of_threads",
+	 vshadow_test_thread_pool_get_number_of_threads );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_thread_pool_grab",
+	 vshadow_test_thread_pool_grab );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_thread_pool_is_running_task",
+	 vshadow_test_thread_pool_is_running_task );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_thread_pool_run",
+	 vshadow_test_thread_pool_run );
+
+#endif /* defined( __GNUC__ ) && defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -20,7 +20,9 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -31,12 +33,18 @@
 #endif
 
 #include "vshadow_test_getopt.h"
+#include "vshadow_test_libbfio.h"
 #include "vshadow_test_libcerror.h"
 #include "vshadow_test_libclocale.h"
 #include "vshadow_test_libuna.h"
 #include "vshadow_test_libvshadow.h"
 #include "vshadow_test_macros.h"
 #include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/vshadow_catalog.h"
+#include "../libvshadow/vshadow_store.h"
+#include "../libvshadow/vshadow_volume.h"
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER ) && SIZEOF_WCHAR_T != 2 && SIZEOF_WCHAR_T != 4
 #error Unsupported size of wchar_t
@@ -578,308 +586,2562 @@ int vshadow_test_volume_close_source(
 	return( result );
 }
 
-/* Tests the libvshadow_volume_initialize function
- * Returns 1 if successful or 0 if not
+/* The size of the data samples read per store
  */
-int vshadow_test_volume_initialize(
-     void )
-{
-	libcerror_error_t *error        = NULL;
-	libvshadow_volume_t *volume     = NULL;
-	int result                      = 0;
-
-#if defined( HAVE_VSHADOW_TEST_MEMORY )
-	int number_of_malloc_fail_tests = 1;
-	int number_of_memset_fail_tests = 1;
-	int test_number                 = 0;
-#endif
-
-	/* Test regular cases
-	 */
-	result = libvshadow_volume_initialize(
-	          &volume,
-	          &error );
-
-	VSHADOW_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "volume",
-         volume );
-
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
-
-	result = libvshadow_volume_free(
-	          &volume,
-	          &error );
-
-	VSHADOW_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "volume",
-         volume );
-
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
-
-	/* Test error cases
-	 */
-	result = libvshadow_volume_initialize(
-	          NULL,
-	          &error );
-
-	VSHADOW_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
-
-        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "error",
-         error );
-
-	libcerror_error_free(
-	 &error );
-
-	volume = (libvshadow_volume_t *) 0x12345678UL;
-
-	result = libvshadow_volume_initialize(
-	          &volume,
-	          &error );
-
-	VSHADOW_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+#define VSHADOW_TEST_VOLUME_SAMPLE_SIZE		4096
 
-        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "error",
-         error );
-
-	libcerror_error_free(
-	 &error );
-
-	volume = NULL;
-
-#if defined( HAVE_VSHADOW_TEST_MEMORY )
+/* The number of data samples read per store
+ */
+#define VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES	3
 
-	for( test_number = 0;
-	     test_number < number_of_malloc_fail_tests;
-	     test_number++ )
+/* Reads data samples at the start, middle and end of a specific store
+ * The buffer should be at least VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES * VSHADOW_TEST_VOLUME_SAMPLE_SIZE
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_volume_read_store_samples(
+     libvshadow_volume_t *volume,
+     int store_index,
+     uint8_t *buffer,
+     libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	static char *function     = "vshadow_test_volume_read_store_samples";
+	size64_t volume_size      = 0;
+	ssize_t read_count        = 0;
+	off64_t sample_offset     = 0;
+	int sample_index          = 0;
+
+	if( buffer == NULL )
 	{
-		/* Test libvshadow_volume_initialize with malloc failing
-		 */
-		vshadow_test_malloc_attempts_before_fail = test_number;
-
-		result = libvshadow_volume_initialize(
-		          &volume,
-		          &error );
-
-		if( vshadow_test_malloc_attempts_before_fail != -1 )
-		{
-			vshadow_test_malloc_attempts_before_fail = -1;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-			if( volume != NULL )
-			{
-				libvshadow_volume_free(
-				 &volume,
-				 NULL );
-			}
-		}
-		else
-		{
-			VSHADOW_TEST_ASSERT_EQUAL_INT(
-			 "result",
-			 result,
-			 -1 );
+		return( -1 );
+	}
+	if( libvshadow_volume_get_size(
+	     volume,
+	     &volume_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size.",
+		 function );
 
-			VSHADOW_TEST_ASSERT_IS_NULL(
-			 "volume",
-			 volume );
+		goto on_error;
+	}
+	if( volume_size < ( VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES * VSHADOW_TEST_VOLUME_SAMPLE_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume size value out of bounds.",
+		 function );
 
-			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-			 "error",
-			 error );
+		goto on_error;
+	}
+	if( libvshadow_volume_get_store(
+	     volume,
+	     store_index,
+	     &store,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store: %d.",
+		 function,
+		 store_index );
 
-			libcerror_error_free(
-			 &error );
-		}
+		goto on_error;
 	}
-	for( test_number = 0;
-	     test_number < number_of_memset_fail_tests;
-	     test_number++ )
+	for( sample_index = 0;
+	     sample_index < VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES;
+	     sample_index++ )
 	{
-		/* Test libvshadow_volume_initialize with memset failing
+		/* The samples are evenly spread from the start to the end of the store data
 		 */
-		vshadow_test_memset_attempts_before_fail = test_number;
-
-		result = libvshadow_volume_initialize(
-		          &volume,
-		          &error );
+		sample_offset = (off64_t) ( ( ( volume_size - VSHADOW_TEST_VOLUME_SAMPLE_SIZE ) / ( VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES - 1 ) ) * sample_index );
 
-		if( vshadow_test_memset_attempts_before_fail != -1 )
+		if( sample_index == ( VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES - 1 ) )
 		{
-			vshadow_test_memset_attempts_before_fail = -1;
-
-			if( volume != NULL )
-			{
-				libvshadow_volume_free(
-				 &volume,
-				 NULL );
-			}
+			sample_offset = (off64_t) ( volume_size - VSHADOW_TEST_VOLUME_SAMPLE_SIZE );
 		}
-		else
+		read_count = libvshadow_store_read_buffer_at_offset(
+		              store,
+		              &( buffer[ sample_index * VSHADOW_TEST_VOLUME_SAMPLE_SIZE ] ),
+		              VSHADOW_TEST_VOLUME_SAMPLE_SIZE,
+		              sample_offset,
+		              error );
+
+		if( read_count != (ssize_t) VSHADOW_TEST_VOLUME_SAMPLE_SIZE )
 		{
-			VSHADOW_TEST_ASSERT_EQUAL_INT(
-			 "result",
-			 result,
-			 -1 );
-
-			VSHADOW_TEST_ASSERT_IS_NULL(
-			 "volume",
-			 volume );
-
-			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-			 "error",
-			 error );
-
-			libcerror_error_free(
-			 &error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read store: %d data at offset: %" PRIi64 ".",
+			 function,
+			 store_index,
+			 sample_offset );
+
+			goto on_error;
 		}
 	}
-#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+	if( libvshadow_store_free(
+	     &store,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free store: %d.",
+		 function,
+		 store_index );
 
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( volume != NULL )
+	if( store != NULL )
 	{
-		libvshadow_volume_free(
-		 &volume,
+		libvshadow_store_free(
+		 &store,
 		 NULL );
 	}
-	return( 0 );
+	return( -1 );
 }
 
-/* Tests the libvshadow_volume_free function
- * Returns 1 if successful or 0 if not
+#if defined( LIBVSHADOW_HAVE_BFIO )
+
+/* The maximum size of a source that is read into memory
  */
-int vshadow_test_volume_free(
-     void )
-{
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+#define VSHADOW_TEST_VOLUME_MAXIMUM_SOURCE_DATA_SIZE	( 64 * 1024 * 1024 )
 
-	/* Test error cases
-	 */
-	result = libvshadow_volume_free(
-	          NULL,
-	          &error );
+/* Reads the data of a source into memory
+ * Returns 1 if successful, 0 if the source is too large or -1 on error
+ */
+int vshadow_test_volume_read_source_data(
+     const system_character_t *source,
+     uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "vshadow_test_volume_read_source_data";
+	size64_t source_size             = 0;
+	size_t source_length             = 0;
+	ssize_t read_count               = 0;
+	int result                       = 0;
 
-	VSHADOW_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	if( source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source.",
+		 function );
 
-        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "error",
-         error );
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	source_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          source,
+	          source_length,
+	          error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          source,
+	          source_length,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file name.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &source_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve source size.",
+		 function );
+
+		goto on_error;
+	}
+	result = 0;
+
+	if( ( source_size > 0 )
+	 && ( source_size <= (size64_t) VSHADOW_TEST_VOLUME_MAXIMUM_SOURCE_DATA_SIZE ) )
+	{
+		*data = (uint8_t *) memory_allocate(
+		                     sizeof( uint8_t ) * (size_t) source_size );
+
+		if( *data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              *data,
+		              (size_t) source_size,
+		              error );
+
+		if( read_count != (ssize_t) source_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			goto on_error;
+		}
+		*data_size = (size_t) source_size;
+
+		result = 1;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( *data != NULL )
+	{
+		memory_free(
+		 *data );
+
+		*data = NULL;
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates and opens a volume of data in memory
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_volume_open_data(
+     libvshadow_volume_t **volume,
+     libbfio_handle_t **file_io_handle,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_volume_open_data";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_memory_range_initialize(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_memory_range_set(
+	     *file_io_handle,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set memory range.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_open_file_io_handle(
+	     *volume,
+	     *file_io_handle,
+	     LIBVSHADOW_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *volume != NULL )
+	{
+		libvshadow_volume_free(
+		 volume,
+		 NULL );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes and frees a volume of data in memory
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_volume_close_data(
+     libvshadow_volume_t **volume,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_volume_close_data";
+	int result            = 1;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( vshadow_test_volume_close_source(
+	     volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close volume.",
+		 function );
+
+		result = -1;
+	}
+	if( libbfio_handle_free(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Hides a specific store by clearing its catalog entries in volume data in memory
+ * Returns 1 if successful, 0 if the catalog contains no entries of the store or -1 on error
+ */
+int vshadow_test_volume_hide_store(
+     uint8_t *data,
+     size_t data_size,
+     const uint8_t *store_identifier,
+     libcerror_error_t **error )
+{
+	uint8_t *catalog_block_data  = NULL;
+	static char *function        = "vshadow_test_volume_hide_store";
+	size_t catalog_entry_offset  = 0;
+	uint64_t catalog_entry_type  = 0;
+	uint64_t catalog_offset      = 0;
+	int number_of_catalog_blocks = 0;
+	int number_of_hidden_entries = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < ( 0x1e00 + sizeof( vshadow_volume_header_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store identifier.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vshadow_volume_header_t *) &( data[ 0x1e00 ] ) )->catalog_offset,
+	 catalog_offset );
+
+	while( catalog_offset != 0 )
+	{
+		if( ( data_size < 0x4000 )
+		 || ( catalog_offset > (uint64_t) ( data_size - 0x4000 ) )
+		 || ( number_of_catalog_blocks >= 1024 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid catalog offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		catalog_block_data = &( data[ catalog_offset ] );
+
+		for( catalog_entry_offset = sizeof( vshadow_catalog_header_t );
+		     catalog_entry_offset < 0x4000;
+		     catalog_entry_offset += 128 )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( catalog_block_data[ catalog_entry_offset ] ),
+			 catalog_entry_type );
+
+			/* Both the catalog entry type 0x02 and 0x03 contain the store identifier
+			 */
+			if( ( ( catalog_entry_type == 2 )
+			  || ( catalog_entry_type == 3 ) )
+			 && ( memory_compare(
+			       &( catalog_block_data[ catalog_entry_offset + 16 ] ),
+			       store_identifier,
+			       16 ) == 0 ) )
+			{
+				memory_set(
+				 &( catalog_block_data[ catalog_entry_offset ] ),
+				 0,
+				 128 );
+
+				number_of_hidden_entries++;
+			}
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (vshadow_catalog_header_t *) catalog_block_data )->next_offset,
+		 catalog_offset );
+
+		number_of_catalog_blocks++;
+	}
+	if( number_of_hidden_entries == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Corrupts the store headers of all the stores in volume data in memory
+ * Returns 1 if successful, 0 if the catalog contains no store headers or -1 on error
+ */
+int vshadow_test_volume_corrupt_store_headers(
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *catalog_block_data     = NULL;
+	static char *function           = "vshadow_test_volume_corrupt_store_headers";
+	size_t catalog_entry_offset     = 0;
+	uint64_t catalog_entry_type     = 0;
+	uint64_t catalog_offset         = 0;
+	uint64_t store_header_offset    = 0;
+	int number_of_catalog_blocks    = 0;
+	int number_of_corrupted_headers = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < ( 0x1e00 + sizeof( vshadow_volume_header_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vshadow_volume_header_t *) &( data[ 0x1e00 ] ) )->catalog_offset,
+	 catalog_offset );
+
+	while( catalog_offset != 0 )
+	{
+		if( ( data_size < 0x4000 )
+		 || ( catalog_offset > (uint64_t) ( data_size - 0x4000 ) )
+		 || ( number_of_catalog_blocks >= 1024 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid catalog offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		catalog_block_data = &( data[ catalog_offset ] );
+
+		for( catalog_entry_offset = sizeof( vshadow_catalog_header_t );
+		     catalog_entry_offset < 0x4000;
+		     catalog_entry_offset += 128 )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( catalog_block_data[ catalog_entry_offset ] ),
+			 catalog_entry_type );
+
+			/* The catalog entry type 0x03 contains the store header offset
+			 */
+			if( catalog_entry_type != 3 )
+			{
+				continue;
+			}
+			byte_stream_copy_to_uint64_little_endian(
+			 &( catalog_block_data[ catalog_entry_offset + 32 ] ),
+			 store_header_offset );
+
+			if( store_header_offset > (uint64_t) ( data_size - sizeof( vshadow_store_block_header_t ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid store header offset value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			byte_stream_copy_from_uint32_little_endian(
+			 ( (vshadow_store_block_header_t *) &( data[ store_header_offset ] ) )->record_type,
+			 0 );
+
+			number_of_corrupted_headers++;
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (vshadow_catalog_header_t *) catalog_block_data )->next_offset,
+		 catalog_offset );
+
+		number_of_catalog_blocks++;
+	}
+	if( number_of_corrupted_headers == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( LIBVSHADOW_HAVE_BFIO ) */
+
+/* Tests the libvshadow_volume_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvshadow_volume_t *volume     = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "volume",
+         volume );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "volume",
+         volume );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	volume = (libvshadow_volume_t *) 0x12345678UL;
+
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	volume = NULL;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_volume_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_volume_initialize(
+		          &volume,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( volume != NULL )
+			{
+				libvshadow_volume_free(
+				 &volume,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "volume",
+			 volume );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_volume_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_volume_initialize(
+		          &volume,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( volume != NULL )
+			{
+				libvshadow_volume_free(
+				 &volume,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "volume",
+			 volume );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_open function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_open(
+     const system_character_t *source )
+{
+	char narrow_source[ 256 ];
+
+	libcerror_error_t *error    = NULL;
+	libvshadow_volume_t *volume = NULL;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = vshadow_test_volume_get_narrow_source(
+	          source,
+	          narrow_source,
+	          256,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "volume",
+         volume );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test open
+	 */
+	result = libvshadow_volume_open(
+	          volume,
+	          narrow_source,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_open(
+	          volume,
+	          narrow_source,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "volume",
+         volume );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Tests the libvshadow_volume_open_wide function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_open_wide(
+     const system_character_t *source )
+{
+	wchar_t wide_source[ 256 ];
+
+	libcerror_error_t *error    = NULL;
+	libvshadow_volume_t *volume = NULL;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = vshadow_test_volume_get_wide_source(
+	          source,
+	          wide_source,
+	          256,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "volume",
+         volume );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test open
+	 */
+	result = libvshadow_volume_open_wide(
+	          volume,
+	          wide_source,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_open_wide(
+	          volume,
+	          wide_source,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "volume",
+         volume );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+#if defined( LIBVSHADOW_HAVE_BFIO )
+
+/* Tests the libvshadow_volume_open_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_open_file_io_handle(
+     const system_character_t *source )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvshadow_store_t *store        = NULL;
+	libvshadow_volume_t *volume      = NULL;
+	uint8_t *data                    = NULL;
+	size_t data_size                 = 0;
+	uint32_t attribute_flags         = 0;
+	int number_of_stores             = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = vshadow_test_volume_read_source_data(
+	          source,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	/* Test regular cases
+	 */
+	result = vshadow_test_volume_open_data(
+	          &volume,
+	          &file_io_handle,
+	          data,
+	          data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_volume_close_data(
+	          &volume,
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that open does not read the store headers, which are corrupted
+	 * and only read when one of their values is retrieved
+	 */
+	result = vshadow_test_volume_corrupt_store_headers(
+	          data,
+	          data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		result = vshadow_test_volume_open_data(
+		          &volume,
+		          &file_io_handle,
+		          data,
+		          data_size,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_volume_get_number_of_stores(
+		          volume,
+		          &number_of_stores,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+		 "number_of_stores",
+		 number_of_stores,
+		 0 );
+
+		result = libvshadow_volume_get_store(
+		          volume,
+		          0,
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "store",
+		 store );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_store_get_attribute_flags(
+		          store,
+		          &attribute_flags,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvshadow_store_free(
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = vshadow_test_volume_close_data(
+		          &volume,
+		          &file_io_handle,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Clean up
+	 */
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		vshadow_test_volume_close_data(
+		 &volume,
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( LIBVSHADOW_HAVE_BFIO ) */
+
+/* Tests the libvshadow_volume_close function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_close(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_close(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_open and libvshadow_volume_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_open_close(
+     const system_character_t *source )
+{
+	libcerror_error_t *error    = NULL;
+	libvshadow_volume_t *volume = NULL;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "volume",
+         volume );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test open and close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvshadow_volume_open_wide(
+	          volume,
+	          source,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+#else
+	result = libvshadow_volume_open(
+	          volume,
+	          source,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+#endif
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libvshadow_volume_close(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test open and close a second time to validate clean up on close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvshadow_volume_open_wide(
+	          volume,
+	          source,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+#else
+	result = libvshadow_volume_open(
+	          volume,
+	          source,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+#endif
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libvshadow_volume_close(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Clean up
+	 */
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "volume",
+         volume );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_signal_abort function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_signal_abort(
+     libvshadow_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_signal_abort(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VSHADOW_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_signal_abort(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_get_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_get_size(
+     libvshadow_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	int result               = 0;
+	int size_is_set          = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_get_size(
+	          volume,
+	          &size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_get_size(
+	          NULL,
+	          &size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( size_is_set != 0 )
+	{
+		result = libvshadow_volume_get_size(
+		          volume,
+		          NULL,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_get_number_of_stores function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_get_number_of_stores(
+     libvshadow_volume_t *volume )
+{
+	libcerror_error_t *error    = NULL;
+	int number_of_stores        = 0;
+	int number_of_stores_is_set = 0;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	number_of_stores_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_get_number_of_stores(
+	          NULL,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( number_of_stores_is_set != 0 )
+	{
+		result = libvshadow_volume_get_number_of_stores(
+		          volume,
+		          NULL,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_refresh function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_refresh(
+     const system_character_t *source,
+     libvshadow_volume_t *volume )
+{
+#if defined( LIBVSHADOW_HAVE_BFIO )
+	uint8_t expected_data[ VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES * VSHADOW_TEST_VOLUME_SAMPLE_SIZE ];
+	uint8_t sample_data[ VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES * VSHADOW_TEST_VOLUME_SAMPLE_SIZE ];
+	uint8_t store_identifier[ 16 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libvshadow_volume_t *data_volume = NULL;
+	uint8_t *data                    = NULL;
+	uint8_t *source_data             = NULL;
+	size_t source_data_size          = 0;
+	int source_data_is_set           = 0;
+	int store_index                  = 0;
+#endif
+	libcerror_error_t *error         = NULL;
+	int number_of_stores             = 0;
+	int refreshed_number             = 0;
+	int result                       = 0;
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( source )
+#endif
+
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_refresh(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &refreshed_number,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "refreshed_number",
+	 refreshed_number,
+	 number_of_stores );
+
+#if defined( LIBVSHADOW_HAVE_BFIO )
+
+	/* Test a store that is appended and removed, where the last store is hidden
+	 * in a copy of the source in memory by clearing its catalog entries
+	 */
+	if( number_of_stores > 0 )
+	{
+		result = vshadow_test_volume_read_source_data(
+		          source,
+		          &source_data,
+		          &source_data_size,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		source_data_is_set = result;
+	}
+	if( source_data_is_set != 0 )
+	{
+		result = libvshadow_volume_get_store_identifier(
+		          volume,
+		          number_of_stores - 1,
+		          store_identifier,
+		          16,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		data = (uint8_t *) memory_allocate(
+		                    sizeof( uint8_t ) * source_data_size );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "data",
+		 data );
+
+		memory_copy(
+		 data,
+		 source_data,
+		 source_data_size );
+
+		result = vshadow_test_volume_hide_store(
+		          data,
+		          source_data_size,
+		          store_identifier,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = vshadow_test_volume_open_data(
+		          &data_volume,
+		          &file_io_handle,
+		          data,
+		          source_data_size,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_volume_get_number_of_stores(
+		          data_volume,
+		          &refreshed_number,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "refreshed_number",
+		 refreshed_number,
+		 number_of_stores - 1 );
+
+		/* Read the data of the last store before the append so that its block
+		 * descriptors need to be read again after the refresh
+		 */
+		if( number_of_stores > 1 )
+		{
+			result = vshadow_test_volume_read_store_samples(
+			          data_volume,
+			          number_of_stores - 2,
+			          sample_data,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		/* Test a store appended
+		 */
+		memory_copy(
+		 data,
+		 source_data,
+		 source_data_size );
+
+		result = libvshadow_volume_refresh(
+		          data_volume,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_volume_get_number_of_stores(
+		          data_volume,
+		          &refreshed_number,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "refreshed_number",
+		 refreshed_number,
+		 number_of_stores );
+
+		/* The data of the previous last store now partially resides in
+		 * the appended store and should match the data read from the source
+		 */
+		for( store_index = ( number_of_stores > 1 ) ? number_of_stores - 2 : 0;
+		     store_index < number_of_stores;
+		     store_index++ )
+		{
+			result = vshadow_test_volume_read_store_samples(
+			          volume,
+			          store_index,
+			          expected_data,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = vshadow_test_volume_read_store_samples(
+			          data_volume,
+			          store_index,
+			          sample_data,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          sample_data,
+			          expected_data,
+			          VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES * VSHADOW_TEST_VOLUME_SAMPLE_SIZE );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		/* Test a store removed
+		 */
+		result = vshadow_test_volume_hide_store(
+		          data,
+		          source_data_size,
+		          store_identifier,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_volume_refresh(
+		          data_volume,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The volume is left unchanged when stores were removed
+		 */
+		result = libvshadow_volume_get_number_of_stores(
+		          data_volume,
+		          &refreshed_number,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "refreshed_number",
+		 refreshed_number,
+		 number_of_stores );
+
+		result = vshadow_test_volume_close_data(
+		          &data_volume,
+		          &file_io_handle,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		memory_free(
+		 data );
+
+		data = NULL;
+
+		memory_free(
+		 source_data );
+
+		source_data = NULL;
+	}
+#endif /* defined( LIBVSHADOW_HAVE_BFIO ) */
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_refresh(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
 	libcerror_error_free(
 	 &error );
 
-	return( 1 );
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( LIBVSHADOW_HAVE_BFIO )
+	if( data_volume != NULL )
+	{
+		vshadow_test_volume_close_data(
+		 &data_volume,
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( source_data != NULL )
+	{
+		memory_free(
+		 source_data );
+	}
+#endif
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_set_index_memory_limit and libvshadow_volume_get_index_memory_limit functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_set_index_memory_limit(
+     libvshadow_volume_t *volume )
+{
+	uint8_t data[ VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES * VSHADOW_TEST_VOLUME_SAMPLE_SIZE ];
+	uint64_t limited_statistics_values[ LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES ];
+	uint64_t statistics_values[ LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES ];
+
+	libcerror_error_t *error    = NULL;
+	libvshadow_store_t *store   = NULL;
+	uint8_t *expected_data      = NULL;
+	size64_t index_memory_limit = 0;
+	int number_of_stores        = 0;
+	int result                  = 0;
+	int store_index             = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_set_index_memory_limit(
+	          volume,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_index_memory_limit(
+	          volume,
+	          &index_memory_limit,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "index_memory_limit",
+	 (uint64_t) index_memory_limit,
+	 (uint64_t) 1 );
+
+	result = libvshadow_volume_set_index_memory_limit(
+	          volume,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the data read with an index memory limit that evicts the block
+	 * descriptors of all but the most recently used store is identical to
+	 * the data read without an index memory limit
+	 */
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( number_of_stores > 0 )
+	{
+		expected_data = (uint8_t *) memory_allocate(
+		                             sizeof( uint8_t ) * (size_t) number_of_stores * VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES * VSHADOW_TEST_VOLUME_SAMPLE_SIZE );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "expected_data",
+		 expected_data );
+
+		for( store_index = 0;
+		     store_index < number_of_stores;
+		     store_index++ )
+		{
+			result = vshadow_test_volume_read_store_samples(
+			          volume,
+			          store_index,
+			          &( expected_data[ store_index * VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES * VSHADOW_TEST_VOLUME_SAMPLE_SIZE ] ),
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = libvshadow_volume_get_statistics(
+		          volume,
+		          statistics_values,
+		          LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_volume_set_index_memory_limit(
+		          volume,
+		          1,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( store_index = 0;
+		     store_index < number_of_stores;
+		     store_index++ )
+		{
+			result = vshadow_test_volume_read_store_samples(
+			          volume,
+			          store_index,
+			          data,
+			          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
 
-/* Tests the libvshadow_volume_open function
- * Returns 1 if successful or 0 if not
- */
-int vshadow_test_volume_open(
-     const system_character_t *source )
-{
-	char narrow_source[ 256 ];
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
 
-	libcerror_error_t *error    = NULL;
-	libvshadow_volume_t *volume = NULL;
-	int result                  = 0;
+			result = memory_compare(
+			          data,
+			          &( expected_data[ store_index * VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES * VSHADOW_TEST_VOLUME_SAMPLE_SIZE ] ),
+			          VSHADOW_TEST_VOLUME_NUMBER_OF_SAMPLES * VSHADOW_TEST_VOLUME_SAMPLE_SIZE );
 
-	/* Initialize test
-	 */
-	result = vshadow_test_volume_get_narrow_source(
-	          source,
-	          narrow_source,
-	          256,
-	          &error );
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		result = libvshadow_volume_get_statistics(
+		          volume,
+		          limited_statistics_values,
+		          LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES,
+		          &error );
 
-	VSHADOW_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	result = libvshadow_volume_initialize(
-	          &volume,
-	          &error );
+		/* The block descriptors of a single store are never evicted
+		 */
+		if( number_of_stores > 1 )
+		{
+			VSHADOW_TEST_ASSERT_LESS_THAN_UINT64(
+			 "statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_LOADS ]",
+			 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_LOADS ],
+			 limited_statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_LOADS ] );
+
+			VSHADOW_TEST_ASSERT_LESS_THAN_UINT64(
+			 "statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_EVICTIONS ]",
+			 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_EVICTIONS ],
+			 limited_statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_EVICTIONS ] );
+		}
+		/* The last store was read last, hence its block descriptors are the most
+		 * recently used and reading it again should not load or evict them
+		 */
+		result = libvshadow_volume_get_store(
+		          volume,
+		          number_of_stores - 1,
+		          &store,
+		          &error );
 
-	VSHADOW_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
-        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "volume",
-         volume );
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "store",
+		 store );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	/* Test open
+		result = libvshadow_store_get_statistics(
+		          store,
+		          statistics_values,
+		          LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = vshadow_test_volume_read_store_samples(
+		          volume,
+		          number_of_stores - 1,
+		          data,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_store_get_statistics(
+		          store,
+		          limited_statistics_values,
+		          LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+		 "limited_statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_LOADS ]",
+		 limited_statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_LOADS ],
+		 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_LOADS ] );
+
+		VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+		 "limited_statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_EVICTIONS ]",
+		 limited_statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_EVICTIONS ],
+		 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_EVICTIONS ] );
+
+		result = libvshadow_store_free(
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_volume_set_index_memory_limit(
+		          volume,
+		          0,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		memory_free(
+		 expected_data );
+
+		expected_data = NULL;
+	}
+	/* Test error cases
 	 */
-	result = libvshadow_volume_open(
-	          volume,
-	          narrow_source,
-	          LIBVSHADOW_OPEN_READ,
+	result = libvshadow_volume_set_index_memory_limit(
+	          NULL,
+	          0,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	/* Test error cases
-	 */
-	result = libvshadow_volume_open(
-	          volume,
-	          narrow_source,
-	          LIBVSHADOW_OPEN_READ,
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_index_memory_limit(
+	          NULL,
+	          &index_memory_limit,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -887,31 +3149,29 @@ int vshadow_test_volume_open(
 	 result,
 	 -1 );
 
-        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
 	libcerror_error_free(
 	 &error );
 
-	/* Clean up
-	 */
-	result = libvshadow_volume_free(
-	          &volume,
+	result = libvshadow_volume_get_index_memory_limit(
+	          volume,
+	          NULL,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "volume",
-         volume );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	libcerror_error_free(
+	 &error );
 
 	return( 1 );
 
@@ -921,35 +3181,106 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( volume != NULL )
+	if( store != NULL )
 	{
-		libvshadow_volume_free(
-		 &volume,
+		libvshadow_store_free(
+		 &store,
 		 NULL );
 	}
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	libvshadow_volume_set_index_memory_limit(
+	 volume,
+	 0,
+	 NULL );
+
 	return( 0 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
+/* Callback function of the tasks run by vshadow_test_volume_set_maximum_number_of_threads
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_volume_run_tasks_callback(
+     int task_index,
+     void *arguments )
+{
+	int *task_counts = NULL;
 
-/* Tests the libvshadow_volume_open_wide function
+	if( ( task_index < 0 )
+	 || ( task_index >= 64 ) )
+	{
+		return( -1 );
+	}
+	task_counts = (int *) arguments;
+
+	task_counts[ task_index ] += 1;
+
+	return( 1 );
+}
+
+/* Tests the libvshadow_volume_set_maximum_number_of_threads, libvshadow_volume_get_maximum_number_of_threads
+ * and libvshadow_volume_run_tasks functions
  * Returns 1 if successful or 0 if not
  */
-int vshadow_test_volume_open_wide(
-     const system_character_t *source )
+int vshadow_test_volume_set_maximum_number_of_threads(
+     libvshadow_volume_t *volume )
 {
-	wchar_t wide_source[ 256 ];
+	int task_counts[ 64 ];
 
-	libcerror_error_t *error    = NULL;
-	libvshadow_volume_t *volume = NULL;
-	int result                  = 0;
+	libcerror_error_t *error      = NULL;
+	int maximum_number_of_threads = 0;
+	int result                    = 0;
+	int task_index                = 0;
 
-	/* Initialize test
+	/* Test regular cases
 	 */
-	result = vshadow_test_volume_get_wide_source(
-	          source,
-	          wide_source,
-	          256,
+	result = libvshadow_volume_set_maximum_number_of_threads(
+	          volume,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_maximum_number_of_threads(
+	          volume,
+	          &maximum_number_of_threads,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_threads",
+	 maximum_number_of_threads,
+	 2 );
+
+	for( task_index = 0;
+	     task_index < 64;
+	     task_index++ )
+	{
+		task_counts[ task_index ] = 0;
+	}
+	result = libvshadow_volume_run_tasks(
+	          volume,
+	          &vshadow_test_volume_run_tasks_callback,
+	          (void *) task_counts,
+	          64,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -957,12 +3288,22 @@ int vshadow_test_volume_open_wide(
 	 result,
 	 1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	result = libvshadow_volume_initialize(
-	          &volume,
+	for( task_index = 0;
+	     task_index < 64;
+	     task_index++ )
+	{
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "task_counts[ task_index ]",
+		 task_counts[ task_index ],
+		 1 );
+	}
+	result = libvshadow_volume_set_maximum_number_of_threads(
+	          volume,
+	          0,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -970,20 +3311,17 @@ int vshadow_test_volume_open_wide(
 	 result,
 	 1 );
 
-        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "volume",
-         volume );
-
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Test open
+	/* Test tasks run on the calling thread
 	 */
-	result = libvshadow_volume_open_wide(
+	result = libvshadow_volume_run_tasks(
 	          volume,
-	          wide_source,
-	          LIBVSHADOW_OPEN_READ,
+	          &vshadow_test_volume_run_tasks_callback,
+	          (void *) task_counts,
+	          64,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -991,16 +3329,37 @@ int vshadow_test_volume_open_wide(
 	 result,
 	 1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "task_counts[ 63 ]",
+	 task_counts[ 63 ],
+	 2 );
 
 	/* Test error cases
 	 */
-	result = libvshadow_volume_open_wide(
+	result = libvshadow_volume_set_maximum_number_of_threads(
+	          NULL,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_set_maximum_number_of_threads(
 	          volume,
-	          wide_source,
-	          LIBVSHADOW_OPEN_READ,
+	          -1,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1008,64 +3367,52 @@ int vshadow_test_volume_open_wide(
 	 result,
 	 -1 );
 
-        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
 	libcerror_error_free(
 	 &error );
 
-	/* Clean up
-	 */
-	result = libvshadow_volume_free(
-	          &volume,
+	result = libvshadow_volume_get_maximum_number_of_threads(
+	          NULL,
+	          &maximum_number_of_threads,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "volume",
-         volume );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	libcerror_error_free(
+	 &error );
 
-	return( 1 );
+	result = libvshadow_volume_get_maximum_number_of_threads(
+	          volume,
+	          NULL,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( volume != NULL )
-	{
-		libvshadow_volume_free(
-		 &volume,
-		 NULL );
-	}
-	return( 0 );
-}
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-/* Tests the libvshadow_volume_close function
- * Returns 1 if successful or 0 if not
- */
-int vshadow_test_volume_close(
-     void )
-{
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
-	 */
-	result = libvshadow_volume_close(
+	result = libvshadow_volume_run_tasks(
 	          NULL,
+	          &vshadow_test_volume_run_tasks_callback,
+	          (void *) task_counts,
+	          64,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1073,9 +3420,49 @@ int vshadow_test_volume_close(
 	 result,
 	 -1 );
 
-        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_run_tasks(
+	          volume,
+	          NULL,
+	          (void *) task_counts,
+	          64,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a failing task
+	 */
+	result = libvshadow_volume_run_tasks(
+	          volume,
+	          &vshadow_test_volume_run_tasks_callback,
+	          (void *) task_counts,
+	          65,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
 	libcerror_error_free(
 	 &error );
@@ -1091,20 +3478,25 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvshadow_volume_open and libvshadow_volume_close functions
+/* Tests the libvshadow_volume_get_number_of_changed_blocks, libvshadow_volume_get_changed_block_by_index
+ * and libvshadow_volume_get_changed_stores_at_offset functions
  * Returns 1 if successful or 0 if not
  */
-int vshadow_test_volume_open_close(
-     const system_character_t *source )
+int vshadow_test_volume_get_changed_blocks(
+     libvshadow_volume_t *volume )
 {
-	libcerror_error_t *error    = NULL;
-	libvshadow_volume_t *volume = NULL;
-	int result                  = 0;
+	libcerror_error_t *error     = NULL;
+	off64_t offset               = 0;
+	int number_of_changed_blocks = 0;
+	int number_of_changed_stores = 0;
+	int number_of_stores         = 0;
+	int result                   = 0;
 
-	/* Initialize test
+	/* Test regular cases
 	 */
-	result = libvshadow_volume_initialize(
-	          &volume,
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1112,108 +3504,147 @@ int vshadow_test_volume_open_close(
 	 result,
 	 1 );
 
-        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "volume",
-         volume );
-
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Test open and close
-	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libvshadow_volume_open_wide(
-	          volume,
-	          source,
-	          LIBVSHADOW_OPEN_READ,
-	          &error );
-#else
-	result = libvshadow_volume_open(
+	result = libvshadow_volume_get_number_of_changed_blocks(
 	          volume,
-	          source,
-	          LIBVSHADOW_OPEN_READ,
+	          &number_of_changed_blocks,
 	          &error );
-#endif
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	result = libvshadow_volume_close(
-	          volume,
+	if( number_of_changed_blocks > 0 )
+	{
+		result = libvshadow_volume_get_changed_block_by_index(
+		          volume,
+		          0,
+		          &offset,
+		          NULL,
+		          0,
+		          &number_of_changed_stores,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+		 "number_of_changed_stores",
+		 number_of_changed_stores,
+		 0 );
+
+		VSHADOW_TEST_ASSERT_LESS_THAN_INT(
+		 "number_of_changed_stores",
+		 number_of_changed_stores,
+		 number_of_stores + 1 );
+
+		result = libvshadow_volume_get_changed_stores_at_offset(
+		          volume,
+		          offset,
+		          NULL,
+		          0,
+		          &number_of_changed_stores,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libvshadow_volume_get_number_of_changed_blocks(
+	          NULL,
+	          &number_of_changed_blocks,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 -1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	/* Test open and close a second time to validate clean up on close
-	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libvshadow_volume_open_wide(
-	          volume,
-	          source,
-	          LIBVSHADOW_OPEN_READ,
-	          &error );
-#else
-	result = libvshadow_volume_open(
-	          volume,
-	          source,
-	          LIBVSHADOW_OPEN_READ,
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_number_of_changed_blocks(
+	          volume,
+	          NULL,
 	          &error );
-#endif
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	result = libvshadow_volume_close(
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_changed_block_by_index(
 	          volume,
+	          -1,
+	          &offset,
+	          NULL,
+	          0,
+	          &number_of_changed_stores,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 -1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	/* Clean up
-	 */
-	result = libvshadow_volume_free(
-	          &volume,
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_changed_stores_at_offset(
+	          volume,
+	          -1,
+	          NULL,
+	          0,
+	          &number_of_changed_stores,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "volume",
-         volume );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	libcerror_error_free(
+	 &error );
 
 	return( 1 );
 
@@ -1223,28 +3654,31 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( volume != NULL )
-	{
-		libvshadow_volume_free(
-		 &volume,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libvshadow_volume_signal_abort function
+/* Tests the libvshadow_volume_get_number_of_physical_blocks, libvshadow_volume_get_physical_block_by_index,
+ * libvshadow_volume_get_physical_block_at_offset and libvshadow_volume_get_physical_blocks_in_range functions
  * Returns 1 if successful or 0 if not
  */
-int vshadow_test_volume_signal_abort(
+int vshadow_test_volume_get_physical_blocks(
      libvshadow_volume_t *volume )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libcerror_error_t *error       = NULL;
+	off64_t offset                 = 0;
+	off64_t original_offset        = 0;
+	int first_physical_block_index = 0;
+	int number_of_blocks_in_range  = 0;
+	int number_of_physical_blocks  = 0;
+	int number_of_stores           = 0;
+	int result                     = 0;
+	int store_index                = 0;
 
 	/* Test regular cases
 	 */
-	result = libvshadow_volume_signal_abort(
+	result = libvshadow_volume_get_number_of_stores(
 	          volume,
+	          &number_of_stores,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1252,73 +3686,113 @@ int vshadow_test_volume_signal_abort(
 	 result,
 	 1 );
 
-        VSHADOW_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Test error cases
-	 */
-	result = libvshadow_volume_signal_abort(
-	          NULL,
+	result = libvshadow_volume_get_number_of_physical_blocks(
+	          volume,
+	          &number_of_physical_blocks,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-        VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-         "error",
-         error );
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	libcerror_error_free(
-	 &error );
+	if( number_of_physical_blocks > 0 )
+	{
+		result = libvshadow_volume_get_physical_block_by_index(
+		          volume,
+		          0,
+		          &offset,
+		          &store_index,
+		          &original_offset,
+		          &error );
 
-	return( 1 );
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-/* Tests the libvshadow_volume_get_size function
- * Returns 1 if successful or 0 if not
- */
-int vshadow_test_volume_get_size(
-     libvshadow_volume_t *volume )
-{
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	int result               = 0;
-	int size_is_set          = 0;
+		VSHADOW_TEST_ASSERT_LESS_THAN_INT(
+		 "store_index",
+		 store_index,
+		 number_of_stores );
 
-	/* Test regular cases
+		result = libvshadow_volume_get_physical_block_at_offset(
+		          volume,
+		          offset,
+		          &store_index,
+		          &original_offset,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_volume_get_physical_blocks_in_range(
+		          volume,
+		          offset,
+		          1,
+		          &first_physical_block_index,
+		          &number_of_blocks_in_range,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "first_physical_block_index",
+		 first_physical_block_index,
+		 0 );
+
+		VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+		 "number_of_blocks_in_range",
+		 number_of_blocks_in_range,
+		 0 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
 	 */
-	result = libvshadow_volume_get_size(
-	          volume,
-	          &size,
+	result = libvshadow_volume_get_number_of_physical_blocks(
+	          NULL,
+	          &number_of_physical_blocks,
 	          &error );
 
-	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
-	VSHADOW_TEST_ASSERT_IS_NULL(
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	size_is_set = result;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
-	 */
-	result = libvshadow_volume_get_size(
+	result = libvshadow_volume_get_number_of_physical_blocks(
+	          volume,
 	          NULL,
-	          &size,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1333,70 +3807,51 @@ int vshadow_test_volume_get_size(
 	libcerror_error_free(
 	 &error );
 
-	if( size_is_set != 0 )
-	{
-		result = libvshadow_volume_get_size(
-		          volume,
-		          NULL,
-		          &error );
-
-		VSHADOW_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	result = libvshadow_volume_get_physical_block_by_index(
+	          volume,
+	          -1,
+	          &offset,
+	          &store_index,
+	          &original_offset,
+	          &error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-/* Tests the libvshadow_volume_get_number_of_stores function
- * Returns 1 if successful or 0 if not
- */
-int vshadow_test_volume_get_number_of_stores(
-     libvshadow_volume_t *volume )
-{
-	libcerror_error_t *error    = NULL;
-	int number_of_stores        = 0;
-	int number_of_stores_is_set = 0;
-	int result                  = 0;
+	libcerror_error_free(
+	 &error );
 
-	/* Test regular cases
-	 */
-	result = libvshadow_volume_get_number_of_stores(
+	result = libvshadow_volume_get_physical_block_at_offset(
 	          volume,
-	          &number_of_stores,
+	          -1,
+	          &store_index,
+	          &original_offset,
 	          &error );
 
-	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
-	VSHADOW_TEST_ASSERT_IS_NULL(
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	number_of_stores_is_set = result;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
-	 */
-	result = libvshadow_volume_get_number_of_stores(
+	result = libvshadow_volume_get_physical_blocks_in_range(
+	          volume,
+	          0,
+	          1,
 	          NULL,
-	          &number_of_stores,
+	          &number_of_blocks_in_range,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1411,25 +3866,6 @@ int vshadow_test_volume_get_number_of_stores(
 	libcerror_error_free(
 	 &error );
 
-	if( number_of_stores_is_set != 0 )
-	{
-		result = libvshadow_volume_get_number_of_stores(
-		          volume,
-		          NULL,
-		          &error );
-
-		VSHADOW_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -1515,7 +3951,10 @@ int main(
 
 #if defined( LIBVSHADOW_HAVE_BFIO )
 
-		/* TODO add test for libvshadow_volume_open_file_io_handle */
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_volume_open_file_io_handle",
+		 vshadow_test_volume_open_file_io_handle,
+		 source );
 
 #endif /* defined( LIBVSHADOW_HAVE_BFIO ) */
 
@@ -1569,6 +4008,32 @@ int main(
 		 vshadow_test_volume_get_number_of_stores,
 		 volume );
 
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_volume_refresh",
+		 vshadow_test_volume_refresh,
+		 source,
+		 volume );
+
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_volume_set_index_memory_limit",
+		 vshadow_test_volume_set_index_memory_limit,
+		 volume );
+
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_volume_set_maximum_number_of_threads",
+		 vshadow_test_volume_set_maximum_number_of_threads,
+		 volume );
+
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_volume_get_changed_blocks",
+		 vshadow_test_volume_get_changed_blocks,
+		 volume );
+
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_volume_get_physical_blocks",
+		 vshadow_test_volume_get_physical_blocks,
+		 volume );
+
 		/* TODO: add tests for libvshadow_volume_get_store */
 
 		/* TODO: add tests for libvshadow_volume_get_store_identifier */
@@ -0,0 +1,5655 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+
+/* The copy_file_range prototype and O_DIRECT require _GNU_SOURCE to be defined
+ * before the first system header is included
+ */
+#if ( defined( HAVE_COPY_FILE_RANGE ) || defined( HAVE_PREAD ) ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "export_handle.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+#include "vshadowtools_unused.h"
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+extern \
+int libvshadow_volume_open_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libvshadow_error_t **error );
+
+extern \
+int libvshadow_check_volume_signature_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+extern \
+ssize_t libvshadow_store_read_buffer_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         libvshadow_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
+#define EXPORT_HANDLE_NOTIFY_STREAM			stdout
+
+#if defined( HAVE_PREAD ) && defined( O_DIRECT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define EXPORT_HANDLE_HAVE_DIRECT_INPUT
+#endif
+
+#if defined( HAVE_POSIX_FADVISE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define EXPORT_HANDLE_HAVE_NO_CACHE_INPUT
+#endif
+
+/* The chunk data is aligned to the page size, which is also the smallest
+ * block size of most file systems, so that sparse chunks end up as holes
+ */
+#define EXPORT_HANDLE_BUFFER_ALIGNMENT			4096
+
+#define EXPORT_HANDLE_DEFAULT_BUFFER_SIZE		( 1024 * 1024 )
+#define EXPORT_HANDLE_MAXIMUM_BUFFER_SIZE		( 64 * 1024 * 1024 )
+
+#define EXPORT_HANDLE_DEFAULT_NUMBER_OF_READ_THREADS	4
+#define EXPORT_HANDLE_DEFAULT_NUMBER_OF_WRITE_THREADS	2
+#define EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS		64
+
+/* The number of bytes after which the checkpoint is updated
+ */
+#define EXPORT_HANDLE_CHECKPOINT_INTERVAL		( 64 * 1024 * 1024 )
+
+#define EXPORT_HANDLE_CHECKPOINT_DATA_SIZE		128
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "vshadowtools_system_string_copy_from_64_bit_in_decimal";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Creates a chunk
+ * Make sure the value chunk is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_chunk_initialize(
+     export_chunk_t **chunk,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_chunk_initialize";
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) ( SSIZE_MAX - EXPORT_HANDLE_BUFFER_ALIGNMENT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk = memory_allocate_structure(
+	          export_chunk_t );
+
+	if( *chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk,
+	     0,
+	     sizeof( export_chunk_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk.",
+		 function );
+
+		memory_free(
+		 *chunk );
+
+		*chunk = NULL;
+
+		return( -1 );
+	}
+	( *chunk )->offset = -1;
+
+	if( data_size > 0 )
+	{
+		if( export_chunk_resize_data(
+		     *chunk,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *chunk != NULL )
+	{
+		memory_free(
+		 *chunk );
+
+		*chunk = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk
+ * Returns 1 if successful or -1 on error
+ */
+int export_chunk_free(
+     export_chunk_t **chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "export_chunk_free";
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk != NULL )
+	{
+		if( ( *chunk )->segments != NULL )
+		{
+			memory_free(
+			 ( *chunk )->segments );
+		}
+		if( ( *chunk )->allocated_data != NULL )
+		{
+			memory_free(
+			 ( *chunk )->allocated_data );
+		}
+		memory_free(
+		 *chunk );
+
+		*chunk = NULL;
+	}
+	return( 1 );
+}
+
+/* Resizes the chunk data
+ * The chunk data is only reallocated when it needs to grow and its content is not preserved
+ * Returns 1 if successful or -1 on error
+ */
+int export_chunk_resize_data(
+     export_chunk_t *chunk,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_chunk_resize_data";
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) ( SSIZE_MAX - EXPORT_HANDLE_BUFFER_ALIGNMENT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > chunk->allocated_data_size )
+	{
+		if( chunk->allocated_data != NULL )
+		{
+			memory_free(
+			 chunk->allocated_data );
+
+			chunk->data                = NULL;
+			chunk->allocated_data_size = 0;
+		}
+		/* The data is over allocated so that it can be aligned
+		 */
+		chunk->allocated_data = (uint8_t *) memory_allocate(
+		                                     sizeof( uint8_t ) * ( data_size + EXPORT_HANDLE_BUFFER_ALIGNMENT ) );
+
+		if( chunk->allocated_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			return( -1 );
+		}
+		chunk->data = (uint8_t *) ( ( (intptr_t) chunk->allocated_data + EXPORT_HANDLE_BUFFER_ALIGNMENT - 1 )
+		                          & ~( (intptr_t) EXPORT_HANDLE_BUFFER_ALIGNMENT - 1 ) );
+
+		chunk->allocated_data_size = data_size;
+	}
+	chunk->data_size = data_size;
+
+	return( 1 );
+}
+
+/* Appends a segment to the chunk
+ * Returns 1 if successful or -1 on error
+ */
+int export_chunk_append_segment(
+     export_chunk_t *chunk,
+     int target_index,
+     size_t offset,
+     size_t size,
+     off64_t physical_offset,
+     uint8_t is_sparse,
+     uint8_t is_offloaded,
+     libcerror_error_t **error )
+{
+	export_segment_t *segment      = NULL;
+	void *reallocation             = NULL;
+	static char *function          = "export_chunk_append_segment";
+	int maximum_number_of_segments = 0;
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk->number_of_segments >= chunk->maximum_number_of_segments )
+	{
+		if( chunk->maximum_number_of_segments > ( ( INT_MAX / 2 ) - 16 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid chunk - maximum number of segments value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		maximum_number_of_segments = ( 2 * chunk->maximum_number_of_segments ) + 16;
+
+		reallocation = memory_reallocate(
+		                chunk->segments,
+		                sizeof( export_segment_t ) * maximum_number_of_segments );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segments.",
+			 function );
+
+			return( -1 );
+		}
+		chunk->segments                   = (export_segment_t *) reallocation;
+		chunk->maximum_number_of_segments = maximum_number_of_segments;
+	}
+	segment = &( chunk->segments[ chunk->number_of_segments ] );
+
+	segment->target_index    = target_index;
+	segment->offset          = offset;
+	segment->size            = size;
+	segment->physical_offset = physical_offset;
+	segment->data_offset     = 0;
+	segment->is_sparse       = is_sparse;
+	segment->is_offloaded    = is_offloaded;
+
+	chunk->number_of_segments += 1;
+
+	return( 1 );
+}
+
+/* Creates a target
+ * Make sure the value target is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_target_initialize(
+     export_target_t **target,
+     const system_character_t *target_path,
+     int store_index,
+     libcerror_error_t **error )
+{
+	static char *function = "export_target_initialize";
+	size_t filename_size  = 0;
+	int print_count       = 0;
+
+	if( target == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target.",
+		 function );
+
+		return( -1 );
+	}
+	if( *target != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid target value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	*target = memory_allocate_structure(
+	           export_target_t );
+
+	if( *target == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create target.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *target,
+	     0,
+	     sizeof( export_target_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear target.",
+		 function );
+
+		memory_free(
+		 *target );
+
+		*target = NULL;
+
+		return( -1 );
+	}
+	/* Reserve space for the store number and the .raw.checkpoint.tmp suffix
+	 */
+	filename_size = system_string_length(
+	                 target_path ) + 32;
+
+	( *target )->output_filename = system_string_allocate(
+	                                filename_size );
+
+	( *target )->checkpoint_filename = system_string_allocate(
+	                                    filename_size );
+
+	( *target )->temporary_checkpoint_filename = system_string_allocate(
+	                                              filename_size );
+
+	if( ( ( *target )->output_filename == NULL )
+	 || ( ( *target )->checkpoint_filename == NULL )
+	 || ( ( *target )->temporary_checkpoint_filename == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filenames.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = system_string_sprintf(
+	               ( *target )->output_filename,
+	               filename_size,
+	               _SYSTEM_STRING( "%" ) _SYSTEM_STRING( PRIs_SYSTEM ) _SYSTEM_STRING( "%d.raw" ),
+	               target_path,
+	               store_index + 1 );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= filename_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set output filename.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = system_string_sprintf(
+	               ( *target )->checkpoint_filename,
+	               filename_size,
+	               _SYSTEM_STRING( "%" ) _SYSTEM_STRING( PRIs_SYSTEM ) _SYSTEM_STRING( ".checkpoint" ),
+	               ( *target )->output_filename );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= filename_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set checkpoint filename.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = system_string_sprintf(
+	               ( *target )->temporary_checkpoint_filename,
+	               filename_size,
+	               _SYSTEM_STRING( "%" ) _SYSTEM_STRING( PRIs_SYSTEM ) _SYSTEM_STRING( ".tmp" ),
+	               ( *target )->checkpoint_filename );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= filename_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set temporary checkpoint filename.",
+		 function );
+
+		goto on_error;
+	}
+	( *target )->store_index            = store_index;
+	( *target )->output_file_descriptor = -1;
+
+	return( 1 );
+
+on_error:
+	if( *target != NULL )
+	{
+		export_target_free(
+		 target,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a target
+ * Returns 1 if successful or -1 on error
+ */
+int export_target_free(
+     export_target_t **target,
+     libcerror_error_t **error )
+{
+	static char *function = "export_target_free";
+
+	if( target == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target.",
+		 function );
+
+		return( -1 );
+	}
+	if( *target != NULL )
+	{
+		if( ( *target )->output_filename != NULL )
+		{
+			memory_free(
+			 ( *target )->output_filename );
+		}
+		if( ( *target )->checkpoint_filename != NULL )
+		{
+			memory_free(
+			 ( *target )->checkpoint_filename );
+		}
+		if( ( *target )->temporary_checkpoint_filename != NULL )
+		{
+			memory_free(
+			 ( *target )->temporary_checkpoint_filename );
+		}
+		memory_free(
+		 *target );
+
+		*target = NULL;
+	}
+	return( 1 );
+}
+
+/* Creates an export handle
+ * Make sure the value export_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_initialize";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*export_handle = memory_allocate_structure(
+	                  export_handle_t );
+
+	if( *export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *export_handle,
+	     0,
+	     sizeof( export_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export handle.",
+		 function );
+
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_range_initialize(
+	     &( ( *export_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     &( ( *export_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+	( *export_handle )->buffer_size                = EXPORT_HANDLE_DEFAULT_BUFFER_SIZE;
+	( *export_handle )->number_of_read_threads     = EXPORT_HANDLE_DEFAULT_NUMBER_OF_READ_THREADS;
+	( *export_handle )->number_of_write_threads    = EXPORT_HANDLE_DEFAULT_NUMBER_OF_WRITE_THREADS;
+	( *export_handle )->input_mode                 = EXPORT_INPUT_MODE_BUFFERED;
+	( *export_handle )->input_file_descriptor      = -1;
+	( *export_handle )->input_data_file_descriptor = -1;
+	( *export_handle )->notify_stream              = EXPORT_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *export_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an export handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free";
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		if( export_handle_free_targets(
+		     *export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free targets.",
+			 function );
+
+			result = -1;
+		}
+		if( export_handle_free_chunks(
+		     *export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks.",
+			 function );
+
+			result = -1;
+		}
+		if( libvshadow_volume_free(
+		     &( ( *export_handle )->input_volume ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input volume.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *export_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the export handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_signal_abort";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The input volume is not signalled to abort so that the chunks
+	 * that are being read can still be written and included in the checkpoint
+	 */
+	export_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_volume_offset(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the buffer size
+ * The buffer size must be a multiple of 4096
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_buffer_size(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_buffer_size";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) EXPORT_HANDLE_MAXIMUM_BUFFER_SIZE )
+	 || ( ( value_64bit % EXPORT_HANDLE_BUFFER_ALIGNMENT ) != 0 ) )
+	{
+		return( 0 );
+	}
+	export_handle->buffer_size = (size_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the number of read threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_number_of_read_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_number_of_read_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		return( 0 );
+	}
+	export_handle->number_of_read_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the number of write threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_number_of_write_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_number_of_write_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		return( 0 );
+	}
+	export_handle->number_of_write_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the store number
+ * The string contains the number of the store or all
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_store_number(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_store_number";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 3 )
+	 && ( system_string_compare_no_case(
+	       string,
+	       _SYSTEM_STRING( "all" ),
+	       3 ) == 0 ) )
+	{
+		export_handle->store_number = 0;
+
+		return( 1 );
+	}
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) INT_MAX ) )
+	{
+		return( 0 );
+	}
+	export_handle->store_number = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the input mode
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_input_mode(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_input_mode";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 6 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "direct" ),
+		     6 ) == 0 )
+		{
+#if defined( EXPORT_HANDLE_HAVE_DIRECT_INPUT )
+			export_handle->input_mode = EXPORT_INPUT_MODE_DIRECT;
+			result                    = 1;
+#endif
+		}
+	}
+	else if( string_length == 7 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "nocache" ),
+		     7 ) == 0 )
+		{
+#if defined( EXPORT_HANDLE_HAVE_NO_CACHE_INPUT )
+			export_handle->input_mode = EXPORT_INPUT_MODE_NO_CACHE;
+			result                    = 1;
+#endif
+		}
+	}
+	else if( string_length == 8 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "buffered" ),
+		     8 ) == 0 )
+		{
+			export_handle->input_mode = EXPORT_INPUT_MODE_BUFFERED;
+			result                    = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the target path
+ * The filename of the exported store is the target path followed by the store number and .raw
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_target_path(
+     export_handle_t *export_handle,
+     const system_character_t *target_path,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_target_path";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->target_path = target_path;
+
+	return( 1 );
+}
+
+/* Opens the export handle
+ * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
+ */
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "export_handle_open_input";
+	size_t filename_length = 0;
+	int result             = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	export_handle->input_filename = filename;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     export_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     export_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_range_set(
+	     export_handle->input_file_io_handle,
+	     export_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open set volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_check_volume_signature_file_io_handle(
+	          export_handle->input_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume has a VSS signature.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libvshadow_volume_open_file_io_handle(
+		     export_handle->input_volume,
+		     export_handle->input_file_io_handle,
+		     LIBVSHADOW_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open input volume.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Closes the export handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int export_handle_close(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_close";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_close(
+	     export_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Frees the chunks
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free_chunks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free_chunks";
+	int chunk_index       = 0;
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->chunks != NULL )
+	{
+		for( chunk_index = 0;
+		     chunk_index < export_handle->number_of_chunks;
+		     chunk_index++ )
+		{
+			if( export_chunk_free(
+			     &( export_handle->chunks[ chunk_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %d.",
+				 function,
+				 chunk_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 export_handle->chunks );
+
+		export_handle->chunks = NULL;
+	}
+	export_handle->number_of_chunks = 0;
+
+	if( export_handle->terminator_chunk != NULL )
+	{
+		if( export_chunk_free(
+		     &( export_handle->terminator_chunk ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free terminator chunk.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Frees the targets and the values of the export
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free_targets(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free_targets";
+	int result            = 1;
+	int target_index      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->targets != NULL )
+	{
+		for( target_index = 0;
+		     target_index < export_handle->number_of_targets;
+		     target_index++ )
+		{
+			if( export_target_free(
+			     &( export_handle->targets[ target_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free target: %d.",
+				 function,
+				 target_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 export_handle->targets );
+
+		export_handle->targets = NULL;
+	}
+	export_handle->number_of_targets = 0;
+
+	if( export_handle->completed_chunks != NULL )
+	{
+		memory_free(
+		 export_handle->completed_chunks );
+
+		export_handle->completed_chunks = NULL;
+	}
+	export_handle->number_of_export_chunks = 0;
+
+	return( result );
+}
+
+/* Opens a file
+ * Make sure the value file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_file(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     int access_flags,
+     libcfile_file_t **file,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_open_file";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_initialize(
+	     file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     *file,
+	     filename,
+	     access_flags,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     *file,
+	     filename,
+	     access_flags,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file != NULL )
+	{
+		libcfile_file_free(
+		 file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the identifier and creation time of the store of a target
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_read_store_identity(
+     export_handle_t *export_handle,
+     export_target_t *target,
+     libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	static char *function     = "export_handle_read_store_identity";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_store(
+	     export_handle->input_volume,
+	     target->store_index,
+	     &store,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store: %d.",
+		 function,
+		 target->store_index );
+
+		goto on_error;
+	}
+	if( libvshadow_store_get_identifier(
+	     store,
+	     target->store_identifier,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store: %d identifier.",
+		 function,
+		 target->store_index );
+
+		goto on_error;
+	}
+	if( libvshadow_store_get_creation_time(
+	     store,
+	     &( target->store_creation_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store: %d creation time.",
+		 function,
+		 target->store_index );
+
+		goto on_error;
+	}
+	if( libvshadow_store_free(
+	     &store,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free store: %d.",
+		 function,
+		 target->store_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the checkpoint of a target
+ * The checkpoint contains the store identifier, the store creation time, the volume size
+ * and the offset up to which the store was written
+ * Returns 1 if successful, 0 if no usable checkpoint was found or -1 on error
+ */
+int export_handle_read_checkpoint(
+     export_handle_t *export_handle,
+     export_target_t *target,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	char checkpoint_data[ EXPORT_HANDLE_CHECKPOINT_DATA_SIZE ];
+	uint8_t store_identifier[ 16 ];
+	uint64_t values[ 3 ];
+
+	libcfile_file_t *checkpoint_file = NULL;
+	static char *function            = "export_handle_read_checkpoint";
+	ssize_t read_count               = 0;
+	size_t data_index                = 0;
+	uint8_t nibble                   = 0;
+	int byte_index                   = 0;
+	int result                       = 0;
+	int value_index                  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_exists_wide(
+	          target->checkpoint_filename,
+	          error );
+#else
+	result = libcfile_file_exists(
+	          target->checkpoint_filename,
+	          error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if checkpoint file exists.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( export_handle_open_file(
+	     export_handle,
+	     target->checkpoint_filename,
+	     LIBCFILE_OPEN_READ,
+	     &checkpoint_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libcfile_file_read_buffer(
+	              checkpoint_file,
+	              (uint8_t *) checkpoint_data,
+	              EXPORT_HANDLE_CHECKPOINT_DATA_SIZE - 1,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read checkpoint data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     checkpoint_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &checkpoint_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	checkpoint_data[ read_count ] = 0;
+
+	/* The checkpoint data consists of:
+	 * "<store identifier> <store creation time> <volume size> <offset>\n"
+	 * where the store identifier is stored as 32 hexadecimal digits
+	 */
+	for( byte_index = 0;
+	     byte_index < 32;
+	     byte_index++ )
+	{
+		if( ( checkpoint_data[ data_index ] >= '0' )
+		 && ( checkpoint_data[ data_index ] <= '9' ) )
+		{
+			nibble = (uint8_t) ( checkpoint_data[ data_index ] - '0' );
+		}
+		else if( ( checkpoint_data[ data_index ] >= 'a' )
+		      && ( checkpoint_data[ data_index ] <= 'f' ) )
+		{
+			nibble = (uint8_t) ( checkpoint_data[ data_index ] - 'a' + 10 );
+		}
+		else
+		{
+			return( 0 );
+		}
+		if( ( byte_index % 2 ) == 0 )
+		{
+			store_identifier[ byte_index / 2 ] = (uint8_t) ( nibble << 4 );
+		}
+		else
+		{
+			store_identifier[ byte_index / 2 ] |= nibble;
+		}
+		data_index++;
+	}
+	if( checkpoint_data[ data_index++ ] != ' ' )
+	{
+		return( 0 );
+	}
+	for( value_index = 0;
+	     value_index < 3;
+	     value_index++ )
+	{
+		if( ( checkpoint_data[ data_index ] < '0' )
+		 || ( checkpoint_data[ data_index ] > '9' ) )
+		{
+			return( 0 );
+		}
+		values[ value_index ] = 0;
+
+		while( ( checkpoint_data[ data_index ] >= '0' )
+		    && ( checkpoint_data[ data_index ] <= '9' ) )
+		{
+			if( values[ value_index ] > ( ( (uint64_t) INT64_MAX - 9 ) / 10 ) )
+			{
+				return( 0 );
+			}
+			values[ value_index ] *= 10;
+			values[ value_index ] += (uint64_t) ( checkpoint_data[ data_index ] - '0' );
+
+			data_index++;
+		}
+		if( ( value_index < 2 )
+		 && ( checkpoint_data[ data_index++ ] != ' ' ) )
+		{
+			return( 0 );
+		}
+	}
+	/* Resuming into the image file of another store or volume would
+	 * silently combine data of different stores
+	 */
+	if( ( memory_compare(
+	       store_identifier,
+	       target->store_identifier,
+	       16 ) != 0 )
+	 || ( values[ 0 ] != target->store_creation_time )
+	 || ( values[ 1 ] != (uint64_t) export_handle->volume_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: checkpoint: %" PRIs_SYSTEM " does not match store: %d.",
+		 function,
+		 target->checkpoint_filename,
+		 target->store_index + 1 );
+
+		return( -1 );
+	}
+	if( values[ 2 ] > (uint64_t) export_handle->volume_size )
+	{
+		return( 0 );
+	}
+	*offset = (off64_t) values[ 2 ];
+
+	return( 1 );
+
+on_error:
+	if( checkpoint_file != NULL )
+	{
+		libcfile_file_free(
+		 &checkpoint_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Flushes a file to storage
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_flush_file(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	HANDLE file_handle    = INVALID_HANDLE_VALUE;
+#elif defined( HAVE_FDATASYNC ) || defined( HAVE_FSYNC )
+	int file_descriptor   = -1;
+	int result            = 0;
+#endif
+	static char *function = "export_handle_flush_file";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_handle = CreateFileW(
+	               (LPCWSTR) filename,
+	               GENERIC_WRITE,
+	               FILE_SHARE_READ | FILE_SHARE_WRITE,
+	               NULL,
+	               OPEN_EXISTING,
+	               FILE_ATTRIBUTE_NORMAL,
+	               NULL );
+#else
+	file_handle = CreateFileA(
+	               (LPCSTR) filename,
+	               GENERIC_WRITE,
+	               FILE_SHARE_READ | FILE_SHARE_WRITE,
+	               NULL,
+	               OPEN_EXISTING,
+	               FILE_ATTRIBUTE_NORMAL,
+	               NULL );
+#endif
+	if( file_handle == INVALID_HANDLE_VALUE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	if( FlushFileBuffers(
+	     file_handle ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to flush file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		CloseHandle(
+		 file_handle );
+
+		return( -1 );
+	}
+	if( CloseHandle(
+	     file_handle ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+#elif defined( HAVE_FDATASYNC ) || defined( HAVE_FSYNC )
+	file_descriptor = open(
+	                   filename,
+	                   O_WRONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+#if defined( HAVE_FDATASYNC )
+	result = fdatasync(
+	          file_descriptor );
+#else
+	result = fsync(
+	          file_descriptor );
+#endif
+	if( result != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to flush file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		close(
+		 file_descriptor );
+
+		return( -1 );
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+#endif /* defined( WINAPI ) */
+
+	return( 1 );
+}
+
+/* Flushes the output file of every target that is being exported to storage
+ * Data written by the write threads and data of which copying was offloaded
+ * end up in the same output file, flushing the file flushes both
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_flush_output_files(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	export_target_t *target = NULL;
+	static char *function   = "export_handle_flush_output_files";
+	int result              = 0;
+	int target_index        = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( target_index = 0;
+	     target_index < export_handle->number_of_targets;
+	     target_index++ )
+	{
+		target = export_handle->targets[ target_index ];
+
+#if ( defined( HAVE_FDATASYNC ) || defined( HAVE_FSYNC ) ) && !defined( WINAPI )
+		if( target->output_file_descriptor != -1 )
+		{
+#if defined( HAVE_FDATASYNC )
+			result = fdatasync(
+			          target->output_file_descriptor );
+#else
+			result = fsync(
+			          target->output_file_descriptor );
+#endif
+			if( result != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_GENERIC,
+				 "%s: unable to flush output file of target: %d.",
+				 function,
+				 target_index );
+
+				return( -1 );
+			}
+			continue;
+		}
+#endif
+		result = export_handle_flush_file(
+		          export_handle,
+		          target->output_filename,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to flush output file of target: %d.",
+			 function,
+			 target_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes the checkpoint of a target
+ * The data in the output file up to the offset must have been flushed to storage
+ * The checkpoint is written to a temporary file that then replaces the previous
+ * checkpoint, so that a checkpoint is never left partially written
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_checkpoint(
+     export_handle_t *export_handle,
+     export_target_t *target,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	char checkpoint_data[ EXPORT_HANDLE_CHECKPOINT_DATA_SIZE ];
+
+	libcfile_file_t *checkpoint_file = NULL;
+	const char *hexadecimal_digits   = "0123456789abcdef";
+	static char *function            = "export_handle_write_checkpoint";
+	ssize_t write_count              = 0;
+	int byte_index                   = 0;
+	int print_count                  = 0;
+
+#if defined( WINAPI )
+	BOOL result                      = 0;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target.",
+		 function );
+
+		return( -1 );
+	}
+	for( byte_index = 0;
+	     byte_index < 16;
+	     byte_index++ )
+	{
+		checkpoint_data[ byte_index * 2 ]         = hexadecimal_digits[ target->store_identifier[ byte_index ] >> 4 ];
+		checkpoint_data[ ( byte_index * 2 ) + 1 ] = hexadecimal_digits[ target->store_identifier[ byte_index ] & 0x0f ];
+	}
+	print_count = narrow_string_snprintf(
+	               &( checkpoint_data[ 32 ] ),
+	               EXPORT_HANDLE_CHECKPOINT_DATA_SIZE - 32,
+	               " %" PRIu64 " %" PRIu64 " %" PRIu64 "\n",
+	               target->store_creation_time,
+	               (uint64_t) export_handle->volume_size,
+	               (uint64_t) offset );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= ( EXPORT_HANDLE_CHECKPOINT_DATA_SIZE - 32 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set checkpoint data.",
+		 function );
+
+		goto on_error;
+	}
+	print_count += 32;
+
+	if( export_handle_open_file(
+	     export_handle,
+	     target->temporary_checkpoint_filename,
+	     LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     &checkpoint_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libcfile_file_write_buffer(
+	               checkpoint_file,
+	               (uint8_t *) checkpoint_data,
+	               (size_t) print_count,
+	               error );
+
+	if( write_count != (ssize_t) print_count )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write checkpoint data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     checkpoint_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &checkpoint_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle_flush_file(
+	     export_handle,
+	     target->temporary_checkpoint_filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to flush checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( WINAPI )
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = MoveFileExW(
+	          (LPCWSTR) target->temporary_checkpoint_filename,
+	          (LPCWSTR) target->checkpoint_filename,
+	          MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH );
+#else
+	result = MoveFileExA(
+	          (LPCSTR) target->temporary_checkpoint_filename,
+	          (LPCSTR) target->checkpoint_filename,
+	          MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH );
+#endif
+	if( result == 0 )
+#else
+	if( rename(
+	     target->temporary_checkpoint_filename,
+	     target->checkpoint_filename ) != 0 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to replace checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( checkpoint_file != NULL )
+	{
+		libcfile_file_free(
+		 &checkpoint_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the checkpoint of every target that is being exported
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_checkpoints(
+     export_handle_t *export_handle,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_write_checkpoints";
+	int target_index      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The output files are flushed first so that a checkpoint never
+	 * covers data that could still be lost on a system crash
+	 */
+	if( export_handle_flush_output_files(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to flush output files.",
+		 function );
+
+		return( -1 );
+	}
+	for( target_index = 0;
+	     target_index < export_handle->number_of_targets;
+	     target_index++ )
+	{
+		if( export_handle_write_checkpoint(
+		     export_handle,
+		     export_handle->targets[ target_index ],
+		     offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write checkpoint of target: %d.",
+			 function,
+			 target_index );
+
+			return( -1 );
+		}
+	}
+	export_handle->checkpoint_offset = offset;
+
+	return( 1 );
+}
+
+/* Prepares the output file of a target
+ * Resizing the output file to the volume size creates a hole in place of
+ * the data that has not been written yet, when resuming the output file is
+ * first truncated so that data after the start offset is discarded
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_prepare_output_file(
+     export_handle_t *export_handle,
+     export_target_t *target,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *output_file = NULL;
+	static char *function        = "export_handle_prepare_output_file";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle_open_file(
+	     export_handle,
+	     target->output_filename,
+	     ( export_handle->start_offset > 0 ) ? LIBCFILE_OPEN_WRITE : LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     &output_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output file.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->start_offset > 0 )
+	{
+		if( libcfile_file_resize(
+		     output_file,
+		     (size64_t) export_handle->start_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to truncate output file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcfile_file_resize(
+	     output_file,
+	     export_handle->volume_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to resize output file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     output_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close output file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &output_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free output file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( output_file != NULL )
+	{
+		libcfile_file_free(
+		 &output_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the file descriptors used to offload copying volume data to the file system
+ * Copying is offloaded with copy_file_range, which clones the data on file systems
+ * that support reflinks, such as XFS and Btrfs. This requires the input to be a regular
+ * file and the file system to support copying between the input and output files
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int export_handle_open_copy_offload(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_COPY_FILE_RANGE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	struct stat file_statistics;
+
+	export_target_t *target = NULL;
+	ssize_t copy_count      = 0;
+	off64_t input_offset    = 0;
+	off64_t output_offset   = 0;
+	int target_index        = 0;
+#endif
+	static char *function   = "export_handle_open_copy_offload";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->input_file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - input file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->copy_offload = 0;
+
+#if defined( HAVE_COPY_FILE_RANGE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( ( export_handle->input_filename == NULL )
+	 || ( export_handle->targets == NULL )
+	 || ( export_handle->number_of_targets == 0 ) )
+	{
+		return( 0 );
+	}
+	export_handle->input_file_descriptor = open(
+	                                        export_handle->input_filename,
+	                                        O_RDONLY );
+
+	if( export_handle->input_file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	/* Devices are copied by the read and write threads
+	 */
+	if( ( fstat(
+	       export_handle->input_file_descriptor,
+	       &file_statistics ) != 0 )
+	 || ( S_ISREG( file_statistics.st_mode ) == 0 ) )
+	{
+		goto on_not_supported;
+	}
+	for( target_index = 0;
+	     target_index < export_handle->number_of_targets;
+	     target_index++ )
+	{
+		target = export_handle->targets[ target_index ];
+
+		target->output_file_descriptor = open(
+		                                  target->output_filename,
+		                                  O_WRONLY );
+
+		if( target->output_file_descriptor == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open output file: %s.",
+			 function,
+			 target->output_filename );
+
+			goto on_error;
+		}
+	}
+	/* Determine if the file system supports copying between the files
+	 * by copying the start of the volume after the end of the first output file
+	 */
+	target = export_handle->targets[ 0 ];
+
+	input_offset  = export_handle->volume_offset;
+	output_offset = (off64_t) export_handle->volume_size;
+
+	copy_count = copy_file_range(
+	              export_handle->input_file_descriptor,
+	              &input_offset,
+	              target->output_file_descriptor,
+	              &output_offset,
+	              EXPORT_HANDLE_BUFFER_ALIGNMENT,
+	              0 );
+
+	if( ftruncate(
+	     target->output_file_descriptor,
+	     (off_t) export_handle->volume_size ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to truncate output file: %s.",
+		 function,
+		 target->output_filename );
+
+		goto on_error;
+	}
+	if( copy_count <= 0 )
+	{
+		goto on_not_supported;
+	}
+	export_handle->copy_offload = 1;
+
+	return( 1 );
+
+on_not_supported:
+	if( export_handle_close_copy_offload(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close copy offload.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+
+on_error:
+	export_handle_close_copy_offload(
+	 export_handle,
+	 NULL );
+
+	return( -1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_COPY_FILE_RANGE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+}
+
+/* Closes the file descriptors used to offload copying volume data to the file system
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_close_copy_offload(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_close_copy_offload";
+	int result            = 1;
+	int target_index      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->targets != NULL )
+	{
+		for( target_index = 0;
+		     target_index < export_handle->number_of_targets;
+		     target_index++ )
+		{
+			if( export_handle->targets[ target_index ]->output_file_descriptor != -1 )
+			{
+				if( close(
+				     export_handle->targets[ target_index ]->output_file_descriptor ) != 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+					 "%s: unable to close output file descriptor of target: %d.",
+					 function,
+					 target_index );
+
+					result = -1;
+				}
+				export_handle->targets[ target_index ]->output_file_descriptor = -1;
+			}
+		}
+	}
+	if( export_handle->input_file_descriptor != -1 )
+	{
+		if( close(
+		     export_handle->input_file_descriptor ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input file descriptor.",
+			 function );
+
+			result = -1;
+		}
+		export_handle->input_file_descriptor = -1;
+	}
+	export_handle->copy_offload = 0;
+
+	return( result );
+}
+
+/* Copies a segment of volume data to the output file of a target by the file system
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_copy_segment(
+     export_handle_t *export_handle,
+     export_target_t *target,
+     off64_t offset,
+     off64_t physical_offset,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_copy_segment";
+
+#if defined( HAVE_COPY_FILE_RANGE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	ssize_t copy_count    = 0;
+	off64_t input_offset  = 0;
+	off64_t output_offset = 0;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_COPY_FILE_RANGE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	/* The offsets are passed explicitly so that the file descriptors can be shared by the write threads
+	 */
+	input_offset  = export_handle->volume_offset + physical_offset;
+	output_offset = offset;
+
+	while( size > 0 )
+	{
+		copy_count = copy_file_range(
+		              export_handle->input_file_descriptor,
+		              &input_offset,
+		              target->output_file_descriptor,
+		              &output_offset,
+		              size,
+		              0 );
+
+		if( copy_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to copy physical offset: %" PRIi64 " to offset: %" PRIi64 " with error: %d.",
+			 function,
+			 input_offset,
+			 output_offset,
+			 ( copy_count < 0 ) ? errno : 0 );
+
+			return( -1 );
+		}
+		size -= (size_t) copy_count;
+	}
+	return( 1 );
+#else
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( offset )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( physical_offset )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( size )
+
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: copy offload not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_COPY_FILE_RANGE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+}
+
+/* Opens the file descriptor used to read volume data in the direct and no cache input modes
+ * In the direct input mode volume data bypasses the page cache, in the no cache input mode
+ * the kernel is advised that the volume is read sequentially and volume data is dropped
+ * from the page cache after it was read. Store metadata is read by libvshadow and
+ * is always cached
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_input_data(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_open_input_data";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->input_data_file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - input data file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->input_mode == EXPORT_INPUT_MODE_BUFFERED )
+	{
+		return( 1 );
+	}
+	if( export_handle->input_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing input filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( EXPORT_HANDLE_HAVE_DIRECT_INPUT )
+	if( export_handle->input_mode == EXPORT_INPUT_MODE_DIRECT )
+	{
+		export_handle->input_data_file_descriptor = open(
+		                                             export_handle->input_filename,
+		                                             O_RDONLY | O_DIRECT );
+	}
+#endif
+#if defined( EXPORT_HANDLE_HAVE_NO_CACHE_INPUT )
+	if( export_handle->input_mode == EXPORT_INPUT_MODE_NO_CACHE )
+	{
+		export_handle->input_data_file_descriptor = open(
+		                                             export_handle->input_filename,
+		                                             O_RDONLY );
+
+		/* The advice is only a hint hence errors are ignored
+		 */
+		if( export_handle->input_data_file_descriptor != -1 )
+		{
+			posix_fadvise(
+			 export_handle->input_data_file_descriptor,
+			 (off_t) export_handle->volume_offset,
+			 (off_t) export_handle->volume_size,
+			 POSIX_FADV_SEQUENTIAL );
+		}
+	}
+#endif
+	if( export_handle->input_data_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input file: %" PRIs_SYSTEM " for input mode: %c.",
+		 function,
+		 export_handle->input_filename,
+		 (char) export_handle->input_mode );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the file descriptor used to read volume data in the direct and no cache input modes
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_close_input_data(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_close_input_data";
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->input_data_file_descriptor != -1 )
+	{
+		if( close(
+		     export_handle->input_data_file_descriptor ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input data file descriptor.",
+			 function );
+
+			result = -1;
+		}
+		export_handle->input_data_file_descriptor = -1;
+	}
+	return( result );
+}
+
+/* Reads volume data at a specific physical offset
+ * In the direct input mode the input offset and the size must be aligned
+ * to EXPORT_HANDLE_BUFFER_ALIGNMENT and so must the buffer
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_read_volume_data(
+     export_handle_t *export_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t physical_offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_read_volume_data";
+	ssize_t read_count    = 0;
+
+#if defined( EXPORT_HANDLE_HAVE_DIRECT_INPUT )
+	off64_t input_offset  = 0;
+	off64_t end_offset    = 0;
+	size_t buffer_offset  = 0;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( EXPORT_HANDLE_HAVE_DIRECT_INPUT )
+	if( export_handle->input_mode == EXPORT_INPUT_MODE_DIRECT )
+	{
+		input_offset = export_handle->volume_offset + physical_offset;
+		end_offset   = export_handle->volume_offset + (off64_t) export_handle->volume_size;
+
+		while( buffer_offset < size )
+		{
+			read_count = pread(
+			              export_handle->input_data_file_descriptor,
+			              &( buffer[ buffer_offset ] ),
+			              size - buffer_offset,
+			              (off_t) ( input_offset + (off64_t) buffer_offset ) );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read volume data at offset: %" PRIi64 " with error: %d.",
+				 function,
+				 input_offset + (off64_t) buffer_offset,
+				 errno );
+
+				return( -1 );
+			}
+			buffer_offset += (size_t) read_count;
+
+			/* A short read signals the end of the input, after which the offset
+			 * is no longer aligned
+			 */
+			if( ( read_count == 0 )
+			 || ( ( buffer_offset % EXPORT_HANDLE_BUFFER_ALIGNMENT ) != 0 ) )
+			{
+				break;
+			}
+		}
+		if( buffer_offset < size )
+		{
+			/* The end of the volume does not need to be aligned
+			 */
+			if( ( input_offset + (off64_t) buffer_offset ) < end_offset )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read volume data at offset: %" PRIi64 ".",
+				 function,
+				 input_offset + (off64_t) buffer_offset );
+
+				return( -1 );
+			}
+			if( memory_set(
+			     &( buffer[ buffer_offset ] ),
+			     0,
+			     size - buffer_offset ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		return( 1 );
+	}
+#endif /* defined( EXPORT_HANDLE_HAVE_DIRECT_INPUT ) */
+
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     physical_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek physical offset: %" PRIi64 ".",
+		 function,
+		 physical_offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count != (ssize_t) size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume data at offset: %" PRIi64 ".",
+		 function,
+		 physical_offset );
+
+		return( -1 );
+	}
+#if defined( EXPORT_HANDLE_HAVE_NO_CACHE_INPUT )
+	/* The volume data is not read again hence it is dropped from the page cache
+	 * to prevent the export from evicting the data of other processes
+	 */
+	if( export_handle->input_mode == EXPORT_INPUT_MODE_NO_CACHE )
+	{
+		posix_fadvise(
+		 export_handle->input_data_file_descriptor,
+		 (off_t) ( export_handle->volume_offset + physical_offset ),
+		 (off_t) size,
+		 POSIX_FADV_DONTNEED );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads the NTFS allocation bitmap of every target
+ * The allocation bitmap is kept by libvshadow per store, hence it only needs
+ * to be read through one of the stores of a target
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_read_allocation_bitmaps(
+     export_handle_t *export_handle,
+     libvshadow_store_t **stores,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_read_allocation_bitmaps";
+	int result            = 0;
+	int target_index      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stores == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stores.",
+		 function );
+
+		return( -1 );
+	}
+	for( target_index = 0;
+	     target_index < export_handle->number_of_targets;
+	     target_index++ )
+	{
+		result = libvshadow_store_read_allocation_bitmap(
+		          stores[ target_index ],
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read allocation bitmap of store: %d.",
+			 function,
+			 export_handle->targets[ target_index ]->store_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 export_handle->notify_stream,
+			 "Store: %d does not contain a NTFS file system, exporting all clusters.\n",
+			 export_handle->targets[ target_index ]->store_index + 1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads a chunk of volume data for every target
+ * The chunk is first split into segments, where every segment is a physical extent
+ * of the data of a target. Unchanged data of different stores maps onto the same
+ * physical extent, hence overlapping and adjacent physical extents are merged and
+ * every distinct physical extent is read only once into the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_read_chunk(
+     export_handle_t *export_handle,
+     libvshadow_store_t **stores,
+     libbfio_handle_t *file_io_handle,
+     export_chunk_t *chunk,
+     libcerror_error_t **error )
+{
+	export_segment_t swap_segment;
+
+	export_segment_t *segment = NULL;
+	static char *function     = "export_handle_read_chunk";
+	size64_t extent_size      = 0;
+	size_t alignment          = 1;
+	size_t alignment_size     = 0;
+	size_t data_index         = 0;
+	size_t data_size          = 0;
+	size_t read_size          = 0;
+	size_t segment_offset     = 0;
+	off64_t physical_offset   = 0;
+	off64_t run_end_offset    = 0;
+	off64_t run_start_offset  = 0;
+	uint32_t extent_flags     = 0;
+	uint8_t is_offloaded      = 0;
+	uint8_t is_sparse         = 0;
+	int result                = 0;
+	int run_segment_index     = 0;
+	int segment_index         = 0;
+	int sort_index            = 0;
+	int target_index          = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stores == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stores.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	chunk->number_of_segments = 0;
+	chunk->data_size          = 0;
+
+	for( target_index = 0;
+	     target_index < export_handle->number_of_targets;
+	     target_index++ )
+	{
+		segment_offset = 0;
+
+		while( segment_offset < chunk->size )
+		{
+			result = libvshadow_store_get_physical_extent(
+			          stores[ target_index ],
+			          chunk->offset + (off64_t) segment_offset,
+			          (size64_t) ( chunk->size - segment_offset ),
+			          &physical_offset,
+			          &extent_size,
+			          &extent_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve physical extent of target: %d at offset: %" PRIi64 ".",
+				 function,
+				 target_index,
+				 chunk->offset + (off64_t) segment_offset );
+
+				return( -1 );
+			}
+			/* Data beyond the end of the store data is left sparse
+			 */
+			if( ( result == 0 )
+			 || ( extent_size == 0 ) )
+			{
+				extent_size  = (size64_t) ( chunk->size - segment_offset );
+				extent_flags = LIBVSHADOW_EXTENT_FLAG_IS_SPARSE;
+			}
+			else if( extent_size > (size64_t) ( chunk->size - segment_offset ) )
+			{
+				extent_size = (size64_t) ( chunk->size - segment_offset );
+			}
+			/* Clusters the file system does not use in the store are not read
+			 */
+			if( ( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+			 || ( ( export_handle->skip_unallocated != 0 )
+			  && ( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_UNALLOCATED ) != 0 ) ) )
+			{
+				is_sparse = 1;
+			}
+			else
+			{
+				is_sparse = 0;
+			}
+			/* Unchanged data of the current volume is copied by the file system
+			 * instead of being read into the chunk data
+			 */
+			if( ( export_handle->copy_offload != 0 )
+			 && ( extent_flags == 0 ) )
+			{
+				is_offloaded = 1;
+			}
+			else
+			{
+				is_offloaded = 0;
+			}
+			if( export_chunk_append_segment(
+			     chunk,
+			     target_index,
+			     segment_offset,
+			     (size_t) extent_size,
+			     physical_offset,
+			     is_sparse,
+			     is_offloaded,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append segment.",
+				 function );
+
+				return( -1 );
+			}
+			segment_offset += (size_t) extent_size;
+		}
+	}
+	/* Sort the segments that need to be read by physical offset, followed by the offloaded
+	 * and the sparse segments
+	 * The number of segments is small in general, hence an insertion sort is used
+	 */
+	for( segment_index = 1;
+	     segment_index < chunk->number_of_segments;
+	     segment_index++ )
+	{
+		swap_segment = chunk->segments[ segment_index ];
+
+		sort_index = segment_index;
+
+		while( sort_index > 0 )
+		{
+			segment = &( chunk->segments[ sort_index - 1 ] );
+
+			if( ( segment->is_sparse < swap_segment.is_sparse )
+			 || ( ( segment->is_sparse == swap_segment.is_sparse )
+			  && ( segment->is_offloaded < swap_segment.is_offloaded ) ) )
+			{
+				break;
+			}
+			if( ( segment->is_sparse == swap_segment.is_sparse )
+			 && ( segment->is_offloaded == swap_segment.is_offloaded )
+			 && ( segment->physical_offset <= swap_segment.physical_offset ) )
+			{
+				break;
+			}
+			chunk->segments[ sort_index ] = *segment;
+
+			sort_index--;
+		}
+		chunk->segments[ sort_index ] = swap_segment;
+	}
+	/* Determine the runs of overlapping or adjacent physical extents and
+	 * the offset of the data of every segment in the chunk data
+	 * In the direct input mode every run is extended to the alignment of the input
+	 */
+	if( export_handle->input_mode == EXPORT_INPUT_MODE_DIRECT )
+	{
+		alignment = EXPORT_HANDLE_BUFFER_ALIGNMENT;
+	}
+	segment_index = 0;
+
+	while( segment_index < chunk->number_of_segments )
+	{
+		segment = &( chunk->segments[ segment_index ] );
+
+		if( ( segment->is_sparse != 0 )
+		 || ( segment->is_offloaded != 0 ) )
+		{
+			break;
+		}
+		run_start_offset = segment->physical_offset;
+		run_end_offset   = segment->physical_offset + (off64_t) segment->size;
+		alignment_size   = (size_t) ( ( export_handle->volume_offset + run_start_offset ) % alignment );
+
+		segment->data_offset = data_size + alignment_size;
+
+		for( segment_index += 1;
+		     segment_index < chunk->number_of_segments;
+		     segment_index++ )
+		{
+			segment = &( chunk->segments[ segment_index ] );
+
+			if( ( segment->is_sparse != 0 )
+			 || ( segment->is_offloaded != 0 )
+			 || ( segment->physical_offset > run_end_offset ) )
+			{
+				break;
+			}
+			segment->data_offset = data_size + alignment_size + (size_t) ( segment->physical_offset - run_start_offset );
+
+			if( ( segment->physical_offset + (off64_t) segment->size ) > run_end_offset )
+			{
+				run_end_offset = segment->physical_offset + (off64_t) segment->size;
+			}
+		}
+		data_size += alignment_size + (size_t) ( run_end_offset - run_start_offset );
+		data_size  = ( ( data_size + alignment - 1 ) / alignment ) * alignment;
+	}
+	if( export_chunk_resize_data(
+	     chunk,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	/* Read every run with a single read
+	 */
+	segment_index = 0;
+
+	while( segment_index < chunk->number_of_segments )
+	{
+		segment = &( chunk->segments[ segment_index ] );
+
+		if( ( segment->is_sparse != 0 )
+		 || ( segment->is_offloaded != 0 ) )
+		{
+			break;
+		}
+		run_segment_index = segment_index;
+		run_start_offset  = segment->physical_offset;
+		run_end_offset    = segment->physical_offset + (off64_t) segment->size;
+
+		for( segment_index += 1;
+		     segment_index < chunk->number_of_segments;
+		     segment_index++ )
+		{
+			segment = &( chunk->segments[ segment_index ] );
+
+			if( ( segment->is_sparse != 0 )
+			 || ( segment->is_offloaded != 0 )
+			 || ( segment->physical_offset > run_end_offset ) )
+			{
+				break;
+			}
+			if( ( segment->physical_offset + (off64_t) segment->size ) > run_end_offset )
+			{
+				run_end_offset = segment->physical_offset + (off64_t) segment->size;
+			}
+		}
+		alignment_size = (size_t) ( ( export_handle->volume_offset + run_start_offset ) % alignment );
+
+		read_size = alignment_size + (size_t) ( run_end_offset - run_start_offset );
+		read_size = ( ( read_size + alignment - 1 ) / alignment ) * alignment;
+
+		if( export_handle_read_volume_data(
+		     export_handle,
+		     file_io_handle,
+		     run_start_offset - (off64_t) alignment_size,
+		     &( chunk->data[ chunk->segments[ run_segment_index ].data_offset - alignment_size ] ),
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read physical extent at offset: %" PRIi64 ".",
+			 function,
+			 run_start_offset );
+
+			return( -1 );
+		}
+	}
+	/* Data that consists of 0-byte values is left sparse as well
+	 */
+	for( segment_index = 0;
+	     segment_index < chunk->number_of_segments;
+	     segment_index++ )
+	{
+		segment = &( chunk->segments[ segment_index ] );
+
+		if( ( segment->is_sparse != 0 )
+		 || ( segment->is_offloaded != 0 ) )
+		{
+			break;
+		}
+		for( data_index = 0;
+		     data_index < segment->size;
+		     data_index++ )
+		{
+			if( chunk->data[ segment->data_offset + data_index ] != 0 )
+			{
+				break;
+			}
+		}
+		if( data_index == segment->size )
+		{
+			segment->is_sparse = 1;
+		}
+	}
+	return( 1 );
+}
+
+/* Writes the segments of a chunk to the output files of the targets
+ * Sparse segments are not written, the output files were resized to contain a hole in their place
+ * Offloaded segments are copied from the input file by the file system
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_chunk(
+     export_handle_t *export_handle,
+     libcfile_file_t **output_files,
+     export_chunk_t *chunk,
+     libcerror_error_t **error )
+{
+	export_segment_t *segment = NULL;
+	static char *function     = "export_handle_write_chunk";
+	ssize_t write_count       = 0;
+	off64_t offset            = 0;
+	int segment_index         = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output files.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	for( segment_index = 0;
+	     segment_index < chunk->number_of_segments;
+	     segment_index++ )
+	{
+		segment = &( chunk->segments[ segment_index ] );
+
+		if( segment->is_sparse != 0 )
+		{
+			continue;
+		}
+		offset = chunk->offset + (off64_t) segment->offset;
+
+		if( segment->is_offloaded != 0 )
+		{
+			if( export_handle_copy_segment(
+			     export_handle,
+			     export_handle->targets[ segment->target_index ],
+			     offset,
+			     segment->physical_offset,
+			     segment->size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to copy segment at offset: %" PRIi64 " to output file of target: %d.",
+				 function,
+				 offset,
+				 segment->target_index );
+
+				return( -1 );
+			}
+			continue;
+		}
+		if( libcfile_file_seek_offset(
+		     output_files[ segment->target_index ],
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " in output file of target: %d.",
+			 function,
+			 offset,
+			 segment->target_index );
+
+			return( -1 );
+		}
+		write_count = libcfile_file_write_buffer(
+		               output_files[ segment->target_index ],
+		               &( chunk->data[ segment->data_offset ] ),
+		               segment->size,
+		               error );
+
+		if( write_count != (ssize_t) segment->size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment at offset: %" PRIi64 " to output file of target: %d.",
+			 function,
+			 offset,
+			 segment->target_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Marks a chunk as written and updates the checkpoints when needed
+ * Chunks can be written out of order, the checkpoints only cover
+ * the chunks that were written consecutively from the start offset
+ * If multi-threading is enabled the mutex must be grabbed by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_complete_chunk(
+     export_handle_t *export_handle,
+     export_chunk_t *chunk,
+     libcerror_error_t **error )
+{
+	export_segment_t *segment = NULL;
+	export_target_t *target   = NULL;
+	static char *function     = "export_handle_complete_chunk";
+	uint64_t chunk_index      = 0;
+	off64_t completed_offset  = 0;
+	int segment_index         = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_index = (uint64_t) ( chunk->offset - export_handle->start_offset ) / export_handle->buffer_size;
+
+	if( chunk_index >= export_handle->number_of_export_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->completed_chunks[ chunk_index ] = 1;
+
+	export_handle->read_size += chunk->data_size;
+
+	for( segment_index = 0;
+	     segment_index < chunk->number_of_segments;
+	     segment_index++ )
+	{
+		segment = &( chunk->segments[ segment_index ] );
+		target  = export_handle->targets[ segment->target_index ];
+
+		if( segment->is_sparse != 0 )
+		{
+			target->sparse_size += segment->size;
+		}
+		else
+		{
+			target->write_size += segment->size;
+
+			if( segment->is_offloaded != 0 )
+			{
+				target->offload_size += segment->size;
+			}
+		}
+	}
+	while( export_handle->completed_chunk_index < export_handle->number_of_export_chunks )
+	{
+		if( export_handle->completed_chunks[ export_handle->completed_chunk_index ] == 0 )
+		{
+			break;
+		}
+		export_handle->completed_chunk_index++;
+	}
+	completed_offset = export_handle->start_offset
+	                 + (off64_t) ( export_handle->completed_chunk_index * export_handle->buffer_size );
+
+	if( (size64_t) completed_offset > export_handle->volume_size )
+	{
+		completed_offset = (off64_t) export_handle->volume_size;
+	}
+	if( ( completed_offset - export_handle->checkpoint_offset ) >= EXPORT_HANDLE_CHECKPOINT_INTERVAL )
+	{
+		if( export_handle_write_checkpoints(
+		     export_handle,
+		     completed_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write checkpoints.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Reads chunks of volume data and queues them to be written
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_read_thread_callback(
+     export_thread_arguments_t *thread_arguments )
+{
+	export_chunk_t *chunk          = NULL;
+	export_handle_t *export_handle = NULL;
+	libcerror_error_t *error       = NULL;
+	static char *function          = "export_handle_read_thread_callback";
+	off64_t offset                 = 0;
+
+	if( thread_arguments == NULL )
+	{
+		return( -1 );
+	}
+	export_handle = thread_arguments->export_handle;
+
+	thread_arguments->result = 1;
+
+	while( export_handle->abort == 0 )
+	{
+		if( libcthreads_queue_pop(
+		     export_handle->free_queue,
+		     (intptr_t **) &chunk,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pop chunk from free queue.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_grab(
+		     export_handle->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		offset = export_handle->next_offset;
+
+		if( (size64_t) offset < export_handle->volume_size )
+		{
+			export_handle->next_offset += export_handle->buffer_size;
+		}
+		if( libcthreads_mutex_release(
+		     export_handle->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( (size64_t) offset >= export_handle->volume_size )
+		{
+			break;
+		}
+		chunk->offset = offset;
+		chunk->size   = export_handle->buffer_size;
+
+		if( (size64_t) chunk->size > ( export_handle->volume_size - (size64_t) offset ) )
+		{
+			chunk->size = (size_t) ( export_handle->volume_size - (size64_t) offset );
+		}
+		if( export_handle_read_chunk(
+		     export_handle,
+		     thread_arguments->stores,
+		     thread_arguments->file_io_handle,
+		     chunk,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_push(
+		     export_handle->write_queue,
+		     (intptr_t *) chunk,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk onto write queue.",
+			 function );
+
+			goto on_error;
+		}
+		chunk = NULL;
+	}
+	if( chunk != NULL )
+	{
+		if( libcthreads_queue_push(
+		     export_handle->free_queue,
+		     (intptr_t *) chunk,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk onto free queue.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	/* Stop the other threads, the chunks that were read are still written
+	 */
+	export_handle->abort = 1;
+
+	if( chunk != NULL )
+	{
+		libcthreads_queue_push(
+		 export_handle->free_queue,
+		 (intptr_t *) chunk,
+		 NULL );
+	}
+	thread_arguments->result = -1;
+
+	return( -1 );
+}
+
+/* Writes the chunks that were queued to be written until the terminator chunk is popped
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_thread_callback(
+     export_thread_arguments_t *thread_arguments )
+{
+	export_chunk_t *chunk          = NULL;
+	export_handle_t *export_handle = NULL;
+	libcerror_error_t *error       = NULL;
+	static char *function          = "export_handle_write_thread_callback";
+	int result                     = 0;
+
+	if( thread_arguments == NULL )
+	{
+		return( -1 );
+	}
+	export_handle = thread_arguments->export_handle;
+
+	thread_arguments->result = 1;
+
+	while( 1 )
+	{
+		if( libcthreads_queue_pop(
+		     export_handle->write_queue,
+		     (intptr_t **) &chunk,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pop chunk from write queue.",
+			 function );
+
+			goto on_error;
+		}
+		if( chunk == export_handle->terminator_chunk )
+		{
+			break;
+		}
+		/* After an error the chunks are still popped so that the read threads are not blocked
+		 */
+		if( thread_arguments->result == 1 )
+		{
+			result = export_handle_write_chunk(
+			          export_handle,
+			          thread_arguments->output_files,
+			          chunk,
+			          &error );
+
+			if( result == 1 )
+			{
+				result = libcthreads_mutex_grab(
+				          export_handle->mutex,
+				          &error );
+
+				if( result == 1 )
+				{
+					result = export_handle_complete_chunk(
+					          export_handle,
+					          chunk,
+					          &error );
+
+					if( libcthreads_mutex_release(
+					     export_handle->mutex,
+					     &error ) != 1 )
+					{
+						result = -1;
+					}
+				}
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunk at offset: %" PRIi64 ".",
+				 function,
+				 chunk->offset );
+
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+
+				export_handle->abort = 1;
+
+				thread_arguments->result = -1;
+			}
+		}
+		if( libcthreads_queue_push(
+		     export_handle->free_queue,
+		     (intptr_t *) chunk,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk onto free queue.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( thread_arguments->result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	export_handle->abort = 1;
+
+	thread_arguments->result = -1;
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Exports the volume data of the targets
+ * If multi-threading is enabled the chunks are read and written by the read and write threads
+ * otherwise the first read and write thread arguments are used to read and write the chunks in order
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_data(
+     export_handle_t *export_handle,
+     export_thread_arguments_t *read_thread_arguments,
+     export_thread_arguments_t *write_thread_arguments,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_t *read_threads[ EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *write_threads[ EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS ];
+
+	int chunk_index             = 0;
+	int number_of_read_threads  = 0;
+	int number_of_write_threads = 0;
+	int thread_index            = 0;
+#else
+	export_chunk_t *chunk       = NULL;
+#endif
+	static char *function       = "export_handle_export_data";
+	int result                  = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_thread_arguments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read thread arguments.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_thread_arguments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write thread arguments.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( export_handle->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_queue_initialize(
+	     &( export_handle->free_queue ),
+	     export_handle->number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize free queue.",
+		 function );
+
+		goto on_error;
+	}
+	/* The write queue can hold all chunks and the terminator chunks so that pushing never blocks
+	 */
+	if( libcthreads_queue_initialize(
+	     &( export_handle->write_queue ),
+	     export_handle->number_of_chunks + export_handle->number_of_write_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize write queue.",
+		 function );
+
+		goto on_error;
+	}
+	for( chunk_index = 0;
+	     chunk_index < export_handle->number_of_chunks;
+	     chunk_index++ )
+	{
+		if( libcthreads_queue_push(
+		     export_handle->free_queue,
+		     (intptr_t *) export_handle->chunks[ chunk_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk: %d onto free queue.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	for( thread_index = 0;
+	     thread_index < export_handle->number_of_write_threads;
+	     thread_index++ )
+	{
+		write_threads[ thread_index ] = NULL;
+
+		if( libcthreads_thread_create(
+		     &( write_threads[ thread_index ] ),
+		     NULL,
+		     (int (*)(void *)) &export_handle_write_thread_callback,
+		     (void *) &( write_thread_arguments[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create write thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+
+			break;
+		}
+	}
+	number_of_write_threads = thread_index;
+
+	/* Without write threads the read threads would block once all chunks are read
+	 */
+	if( result == 1 )
+	{
+		for( thread_index = 0;
+		     thread_index < export_handle->number_of_read_threads;
+		     thread_index++ )
+		{
+			read_threads[ thread_index ] = NULL;
+
+			if( libcthreads_thread_create(
+			     &( read_threads[ thread_index ] ),
+			     NULL,
+			     (int (*)(void *)) &export_handle_read_thread_callback,
+			     (void *) &( read_thread_arguments[ thread_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create read thread: %d.",
+				 function,
+				 thread_index );
+
+				export_handle->abort = 1;
+
+				result = -1;
+
+				break;
+			}
+		}
+		number_of_read_threads = thread_index;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_read_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( read_threads[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+		else if( read_thread_arguments[ thread_index ].result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunks in thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+	}
+	/* The read threads have finished, signal every write thread to stop
+	 * after the chunks that were queued before have been written
+	 */
+	for( thread_index = 0;
+	     thread_index < number_of_write_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_queue_push(
+		     export_handle->write_queue,
+		     (intptr_t *) export_handle->terminator_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push terminator chunk onto write queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_write_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( write_threads[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join write thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+		else if( write_thread_arguments[ thread_index ].result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunks in thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+	}
+	/* The chunks are owned by the export handle
+	 */
+	if( libcthreads_queue_free(
+	     &( export_handle->write_queue ),
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free write queue.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_queue_free(
+	     &( export_handle->free_queue ),
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free free queue.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_free(
+	     &( export_handle->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free mutex.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+
+on_error:
+	if( export_handle->write_queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &( export_handle->write_queue ),
+		 NULL,
+		 NULL );
+	}
+	if( export_handle->free_queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &( export_handle->free_queue ),
+		 NULL,
+		 NULL );
+	}
+	if( export_handle->mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( export_handle->mutex ),
+		 NULL );
+	}
+	return( -1 );
+#else
+	chunk = export_handle->chunks[ 0 ];
+
+	while( (size64_t) export_handle->next_offset < export_handle->volume_size )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		chunk->offset = export_handle->next_offset;
+		chunk->size   = export_handle->buffer_size;
+
+		if( (size64_t) chunk->size > ( export_handle->volume_size - (size64_t) chunk->offset ) )
+		{
+			chunk->size = (size_t) ( export_handle->volume_size - (size64_t) chunk->offset );
+		}
+		export_handle->next_offset += chunk->size;
+
+		if( export_handle_read_chunk(
+		     export_handle,
+		     read_thread_arguments[ 0 ].stores,
+		     read_thread_arguments[ 0 ].file_io_handle,
+		     chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk at offset: %" PRIi64 ".",
+			 function,
+			 chunk->offset );
+
+			return( -1 );
+		}
+		if( export_handle_write_chunk(
+		     export_handle,
+		     write_thread_arguments[ 0 ].output_files,
+		     chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk at offset: %" PRIi64 ".",
+			 function,
+			 chunk->offset );
+
+			return( -1 );
+		}
+		if( export_handle_complete_chunk(
+		     export_handle,
+		     chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to complete chunk at offset: %" PRIi64 ".",
+			 function,
+			 chunk->offset );
+
+			return( -1 );
+		}
+	}
+	return( result );
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
+/* Exports the targets in a single pass over the volume
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int export_handle_export_targets(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	export_thread_arguments_t read_thread_arguments[ EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS ];
+	export_thread_arguments_t write_thread_arguments[ EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS ];
+
+	export_target_t *target     = NULL;
+	static char *function       = "export_handle_export_targets";
+	off64_t completed_offset    = 0;
+	uint8_t copy_offload        = 0;
+	int number_of_read_threads  = 1;
+	int number_of_write_threads = 1;
+	int result                  = 0;
+	int target_index            = 0;
+	int thread_index            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->targets == NULL )
+	 || ( export_handle->number_of_targets == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing targets.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->completed_chunks != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - completed chunks value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	number_of_read_threads  = export_handle->number_of_read_threads;
+	number_of_write_threads = export_handle->number_of_write_threads;
+#endif
+	for( thread_index = 0;
+	     thread_index < EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		read_thread_arguments[ thread_index ].export_handle  = export_handle;
+		read_thread_arguments[ thread_index ].stores         = NULL;
+		read_thread_arguments[ thread_index ].file_io_handle = NULL;
+		read_thread_arguments[ thread_index ].output_files   = NULL;
+		read_thread_arguments[ thread_index ].result         = 0;
+
+		write_thread_arguments[ thread_index ].export_handle  = export_handle;
+		write_thread_arguments[ thread_index ].stores         = NULL;
+		write_thread_arguments[ thread_index ].file_io_handle = NULL;
+		write_thread_arguments[ thread_index ].output_files   = NULL;
+		write_thread_arguments[ thread_index ].result         = 0;
+	}
+	export_handle->number_of_export_chunks = ( export_handle->volume_size - (size64_t) export_handle->start_offset ) / export_handle->buffer_size;
+
+	if( ( ( export_handle->volume_size - (size64_t) export_handle->start_offset ) % export_handle->buffer_size ) != 0 )
+	{
+		export_handle->number_of_export_chunks += 1;
+	}
+	if( export_handle->number_of_export_chunks > (uint64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of export chunks value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->completed_chunks = (uint8_t *) memory_allocate(
+	                                               sizeof( uint8_t ) * (size_t) export_handle->number_of_export_chunks );
+
+	if( export_handle->completed_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create completed chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     export_handle->completed_chunks,
+	     0,
+	     sizeof( uint8_t ) * (size_t) export_handle->number_of_export_chunks ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear completed chunks.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->next_offset           = export_handle->start_offset;
+	export_handle->completed_chunk_index = 0;
+	export_handle->read_size             = 0;
+
+	for( target_index = 0;
+	     target_index < export_handle->number_of_targets;
+	     target_index++ )
+	{
+		if( export_handle_prepare_output_file(
+		     export_handle,
+		     export_handle->targets[ target_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to prepare output file of target: %d.",
+			 function,
+			 target_index );
+
+			goto on_error;
+		}
+	}
+	if( export_handle_open_input_data(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input data.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle_open_copy_offload(
+	     export_handle,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open copy offload.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle_write_checkpoints(
+	     export_handle,
+	     export_handle->start_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write checkpoints.",
+		 function );
+
+		goto on_error;
+	}
+	/* Every read thread uses its own stores and file IO handle so that reads
+	 * do not contend for the current offset of a shared store or file IO handle
+	 */
+	for( thread_index = 0;
+	     thread_index < number_of_read_threads;
+	     thread_index++ )
+	{
+		read_thread_arguments[ thread_index ].stores = (libvshadow_store_t **) memory_allocate(
+		                                                                        sizeof( libvshadow_store_t * ) * export_handle->number_of_targets );
+
+		if( read_thread_arguments[ thread_index ].stores == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create stores.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     read_thread_arguments[ thread_index ].stores,
+		     0,
+		     sizeof( libvshadow_store_t * ) * export_handle->number_of_targets ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear stores.",
+			 function );
+
+			memory_free(
+			 read_thread_arguments[ thread_index ].stores );
+
+			read_thread_arguments[ thread_index ].stores = NULL;
+
+			goto on_error;
+		}
+		for( target_index = 0;
+		     target_index < export_handle->number_of_targets;
+		     target_index++ )
+		{
+			target = export_handle->targets[ target_index ];
+
+			if( libvshadow_volume_get_store(
+			     export_handle->input_volume,
+			     target->store_index,
+			     &( read_thread_arguments[ thread_index ].stores[ target_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve store: %d.",
+				 function,
+				 target->store_index );
+
+				goto on_error;
+			}
+		}
+		if( libbfio_handle_clone(
+		     &( read_thread_arguments[ thread_index ].file_io_handle ),
+		     export_handle->input_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone input file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_open(
+		     read_thread_arguments[ thread_index ].file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open input file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->skip_unallocated != 0 )
+	{
+		if( export_handle_read_allocation_bitmaps(
+		     export_handle,
+		     read_thread_arguments[ 0 ].stores,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read allocation bitmaps.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_write_threads;
+	     thread_index++ )
+	{
+		write_thread_arguments[ thread_index ].output_files = (libcfile_file_t **) memory_allocate(
+		                                                                            sizeof( libcfile_file_t * ) * export_handle->number_of_targets );
+
+		if( write_thread_arguments[ thread_index ].output_files == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create output files.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     write_thread_arguments[ thread_index ].output_files,
+		     0,
+		     sizeof( libcfile_file_t * ) * export_handle->number_of_targets ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear output files.",
+			 function );
+
+			memory_free(
+			 write_thread_arguments[ thread_index ].output_files );
+
+			write_thread_arguments[ thread_index ].output_files = NULL;
+
+			goto on_error;
+		}
+		for( target_index = 0;
+		     target_index < export_handle->number_of_targets;
+		     target_index++ )
+		{
+			if( export_handle_open_file(
+			     export_handle,
+			     export_handle->targets[ target_index ]->output_filename,
+			     LIBCFILE_OPEN_WRITE,
+			     &( write_thread_arguments[ thread_index ].output_files[ target_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open output file of target: %d.",
+				 function,
+				 target_index );
+
+				goto on_error;
+			}
+		}
+	}
+	result = export_handle_export_data(
+	          export_handle,
+	          read_thread_arguments,
+	          write_thread_arguments,
+	          error );
+
+	for( thread_index = 0;
+	     thread_index < number_of_write_threads;
+	     thread_index++ )
+	{
+		for( target_index = 0;
+		     target_index < export_handle->number_of_targets;
+		     target_index++ )
+		{
+			if( libcfile_file_close(
+			     write_thread_arguments[ thread_index ].output_files[ target_index ],
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close output file of target: %d.",
+				 function,
+				 target_index );
+
+				result = -1;
+			}
+			if( libcfile_file_free(
+			     &( write_thread_arguments[ thread_index ].output_files[ target_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free output file of target: %d.",
+				 function,
+				 target_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 write_thread_arguments[ thread_index ].output_files );
+
+		write_thread_arguments[ thread_index ].output_files = NULL;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_read_threads;
+	     thread_index++ )
+	{
+		if( libbfio_handle_close(
+		     read_thread_arguments[ thread_index ].file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( read_thread_arguments[ thread_index ].file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		for( target_index = 0;
+		     target_index < export_handle->number_of_targets;
+		     target_index++ )
+		{
+			if( libvshadow_store_free(
+			     &( read_thread_arguments[ thread_index ].stores[ target_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free store of target: %d.",
+				 function,
+				 target_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 read_thread_arguments[ thread_index ].stores );
+
+		read_thread_arguments[ thread_index ].stores = NULL;
+	}
+	if( export_handle->copy_offload != 0 )
+	{
+		copy_offload = 1;
+	}
+	if( export_handle_close_copy_offload(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close copy offload.",
+		 function );
+
+		result = -1;
+	}
+	if( export_handle_close_input_data(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input data.",
+		 function );
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* The data that was written is recorded even if the export was aborted
+	 */
+	completed_offset = export_handle->start_offset
+	                 + (off64_t) ( export_handle->completed_chunk_index * export_handle->buffer_size );
+
+	if( (size64_t) completed_offset > export_handle->volume_size )
+	{
+		completed_offset = (off64_t) export_handle->volume_size;
+	}
+	if( export_handle_write_checkpoints(
+	     export_handle,
+	     completed_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write checkpoints.",
+		 function );
+
+		goto on_error;
+	}
+	for( target_index = 0;
+	     target_index < export_handle->number_of_targets;
+	     target_index++ )
+	{
+		target = export_handle->targets[ target_index ];
+
+		fprintf(
+		 export_handle->notify_stream,
+		 "Store: %d\n",
+		 target->store_index + 1 );
+
+		fprintf(
+		 export_handle->notify_stream,
+		 "\tTarget\t\t\t\t: %" PRIs_SYSTEM "\n",
+		 target->output_filename );
+
+		fprintf(
+		 export_handle->notify_stream,
+		 "\tWritten\t\t\t\t: %" PRIu64 " bytes\n",
+		 target->write_size );
+
+		fprintf(
+		 export_handle->notify_stream,
+		 "\tSparse\t\t\t\t: %" PRIu64 " bytes\n",
+		 target->sparse_size );
+
+		if( copy_offload != 0 )
+		{
+			fprintf(
+			 export_handle->notify_stream,
+			 "\tOffloaded\t\t\t: %" PRIu64 " bytes\n",
+			 target->offload_size );
+		}
+
+		fprintf(
+		 export_handle->notify_stream,
+		 "\n" );
+	}
+	fprintf(
+	 export_handle->notify_stream,
+	 "Read from volume\t\t\t: %" PRIu64 " bytes\n",
+	 export_handle->read_size );
+
+	fprintf(
+	 export_handle->notify_stream,
+	 "\n" );
+
+	if( export_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	for( thread_index = 0;
+	     thread_index < EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( write_thread_arguments[ thread_index ].output_files != NULL )
+		{
+			for( target_index = 0;
+			     target_index < export_handle->number_of_targets;
+			     target_index++ )
+			{
+				if( write_thread_arguments[ thread_index ].output_files[ target_index ] != NULL )
+				{
+					libcfile_file_free(
+					 &( write_thread_arguments[ thread_index ].output_files[ target_index ] ),
+					 NULL );
+				}
+			}
+			memory_free(
+			 write_thread_arguments[ thread_index ].output_files );
+		}
+		if( read_thread_arguments[ thread_index ].file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( read_thread_arguments[ thread_index ].file_io_handle ),
+			 NULL );
+		}
+		if( read_thread_arguments[ thread_index ].stores != NULL )
+		{
+			for( target_index = 0;
+			     target_index < export_handle->number_of_targets;
+			     target_index++ )
+			{
+				if( read_thread_arguments[ thread_index ].stores[ target_index ] != NULL )
+				{
+					libvshadow_store_free(
+					 &( read_thread_arguments[ thread_index ].stores[ target_index ] ),
+					 NULL );
+				}
+			}
+			memory_free(
+			 read_thread_arguments[ thread_index ].stores );
+		}
+	}
+	export_handle_close_copy_offload(
+	 export_handle,
+	 NULL );
+
+	export_handle_close_input_data(
+	 export_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Exports the stores
+ * Stores that are exported together share a single pass over the volume,
+ * so that data the stores have in common is only read once
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int export_handle_export_stores(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	export_target_t *target = NULL;
+	static char *function   = "export_handle_export_stores";
+	off64_t start_offset    = 0;
+	int chunk_index         = 0;
+	int number_of_chunks    = 1;
+	int number_of_stores    = 0;
+	int result              = 1;
+	int store_index         = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->chunks != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - chunks value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->targets != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - targets value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_size(
+	     export_handle->input_volume,
+	     &( export_handle->volume_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_get_number_of_stores(
+	     export_handle->input_volume,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->store_number > number_of_stores )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store number value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Provide every thread with a second chunk so that the read threads
+	 * can continue while the write threads are busy
+	 */
+	number_of_chunks = 2 * ( export_handle->number_of_read_threads + export_handle->number_of_write_threads );
+#endif
+	fprintf(
+	 export_handle->notify_stream,
+	 "Volume Shadow Snapshot export:\n" );
+
+	fprintf(
+	 export_handle->notify_stream,
+	 "\tNumber of stores\t\t: %d\n",
+	 number_of_stores );
+
+	fprintf(
+	 export_handle->notify_stream,
+	 "\tBuffer size\t\t\t: %" PRIzd "\n",
+	 export_handle->buffer_size );
+
+	fprintf(
+	 export_handle->notify_stream,
+	 "\tInput mode\t\t\t: " );
+
+	switch( export_handle->input_mode )
+	{
+		case EXPORT_INPUT_MODE_DIRECT:
+			fprintf(
+			 export_handle->notify_stream,
+			 "direct\n" );
+			break;
+
+		case EXPORT_INPUT_MODE_NO_CACHE:
+			fprintf(
+			 export_handle->notify_stream,
+			 "nocache\n" );
+			break;
+
+		default:
+			fprintf(
+			 export_handle->notify_stream,
+			 "buffered\n" );
+			break;
+	}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	fprintf(
+	 export_handle->notify_stream,
+	 "\tNumber of read threads\t\t: %d\n",
+	 export_handle->number_of_read_threads );
+
+	fprintf(
+	 export_handle->notify_stream,
+	 "\tNumber of write threads\t\t: %d\n",
+	 export_handle->number_of_write_threads );
+#endif
+	fprintf(
+	 export_handle->notify_stream,
+	 "\n" );
+
+	if( number_of_stores == 0 )
+	{
+		return( 1 );
+	}
+	export_handle->targets = (export_target_t **) memory_allocate(
+	                                               sizeof( export_target_t * ) * number_of_stores );
+
+	if( export_handle->targets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create targets.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->number_of_targets = 0;
+	export_handle->start_offset      = (off64_t) export_handle->volume_size;
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( ( export_handle->store_number != 0 )
+		 && ( export_handle->store_number != ( store_index + 1 ) ) )
+		{
+			continue;
+		}
+		if( export_target_initialize(
+		     &target,
+		     export_handle->target_path,
+		     store_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize target: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( export_handle_read_store_identity(
+		     export_handle,
+		     target,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read identity of store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		start_offset = 0;
+
+		if( export_handle->resume != 0 )
+		{
+			result = export_handle_read_checkpoint(
+			          export_handle,
+			          target,
+			          &start_offset,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read checkpoint of store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				start_offset = 0;
+			}
+		}
+		if( (size64_t) start_offset >= export_handle->volume_size )
+		{
+			fprintf(
+			 export_handle->notify_stream,
+			 "Store: %d\n",
+			 store_index + 1 );
+
+			fprintf(
+			 export_handle->notify_stream,
+			 "\tTarget\t\t\t\t: %" PRIs_SYSTEM "\n",
+			 target->output_filename );
+
+			fprintf(
+			 export_handle->notify_stream,
+			 "\tAlready exported\n\n" );
+
+			if( export_target_free(
+			     &target,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free target: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			continue;
+		}
+		/* The stores are exported from the smallest checkpoint onwards
+		 */
+		if( start_offset < export_handle->start_offset )
+		{
+			export_handle->start_offset = start_offset;
+		}
+		export_handle->targets[ export_handle->number_of_targets ] = target;
+
+		export_handle->number_of_targets += 1;
+
+		target = NULL;
+	}
+	result = 1;
+
+	if( export_handle->number_of_targets > 0 )
+	{
+		if( export_handle->start_offset > 0 )
+		{
+			fprintf(
+			 export_handle->notify_stream,
+			 "Resumed at offset\t\t\t: %" PRIi64 "\n\n",
+			 export_handle->start_offset );
+		}
+		export_handle->chunks = (export_chunk_t **) memory_allocate(
+		                                             sizeof( export_chunk_t * ) * number_of_chunks );
+
+		if( export_handle->chunks == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunks.",
+			 function );
+
+			goto on_error;
+		}
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			export_handle->chunks[ chunk_index ] = NULL;
+		}
+		export_handle->number_of_chunks = number_of_chunks;
+
+		/* The chunk data grows when the stores do not share their data
+		 */
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			if( export_chunk_initialize(
+			     &( export_handle->chunks[ chunk_index ] ),
+			     export_handle->buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize chunk: %d.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		if( export_chunk_initialize(
+		     &( export_handle->terminator_chunk ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize terminator chunk.",
+			 function );
+
+			goto on_error;
+		}
+		result = export_handle_export_targets(
+		          export_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to export targets.",
+			 function );
+
+			goto on_error;
+		}
+		if( export_handle_free_chunks(
+		     export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle_free_targets(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free targets.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( target != NULL )
+	{
+		export_target_free(
+		 &target,
+		 NULL );
+	}
+	export_handle_free_chunks(
+	 export_handle,
+	 NULL );
+
+	export_handle_free_targets(
+	 export_handle,
+	 NULL );
+
+	return( -1 );
+}
+
@@ -0,0 +1,572 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EXPORT_HANDLE_H )
+#define _EXPORT_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+enum EXPORT_INPUT_MODES
+{
+	EXPORT_INPUT_MODE_BUFFERED	= (int) 'b',
+	EXPORT_INPUT_MODE_DIRECT	= (int) 'd',
+	EXPORT_INPUT_MODE_NO_CACHE	= (int) 'n'
+};
+
+typedef struct export_segment export_segment_t;
+
+/* A segment of a chunk that is stored consecutively for a specific target
+ */
+struct export_segment
+{
+	/* The index of the target
+	 */
+	int target_index;
+
+	/* The offset of the segment relative to the start of the chunk
+	 */
+	size_t offset;
+
+	/* The segment size
+	 */
+	size_t size;
+
+	/* The physical offset of the segment data relative to the start of the volume
+	 */
+	off64_t physical_offset;
+
+	/* The offset of the segment data relative to the start of the chunk data
+	 */
+	size_t data_offset;
+
+	/* Value to indicate the segment data consists of 0-byte values
+	 */
+	uint8_t is_sparse;
+
+	/* Value to indicate copying the segment data is offloaded to the file system
+	 */
+	uint8_t is_offloaded;
+};
+
+typedef struct export_chunk export_chunk_t;
+
+/* A chunk of volume data that is read by a read thread for every target
+ * and written by a write thread
+ */
+struct export_chunk
+{
+	/* The (logical) offset of the chunk
+	 * or -1 to signal a write thread to stop
+	 */
+	off64_t offset;
+
+	/* The chunk size
+	 */
+	size_t size;
+
+	/* The segments of the chunk of every target
+	 */
+	export_segment_t *segments;
+
+	/* The number of segments
+	 */
+	int number_of_segments;
+
+	/* The number of allocated segments
+	 */
+	int maximum_number_of_segments;
+
+	/* The chunk data, that contains every distinct physical extent of the segments once
+	 * The data is aligned to EXPORT_HANDLE_BUFFER_ALIGNMENT
+	 */
+	uint8_t *data;
+
+	/* The chunk data size
+	 */
+	size_t data_size;
+
+	/* The allocated chunk data
+	 */
+	uint8_t *allocated_data;
+
+	/* The allocated chunk data size
+	 */
+	size_t allocated_data_size;
+};
+
+typedef struct export_target export_target_t;
+
+/* A store that is being exported
+ */
+struct export_target
+{
+	/* The index of the store
+	 */
+	int store_index;
+
+	/* The output filename
+	 */
+	system_character_t *output_filename;
+
+	/* The checkpoint filename
+	 */
+	system_character_t *checkpoint_filename;
+
+	/* The temporary checkpoint filename
+	 */
+	system_character_t *temporary_checkpoint_filename;
+
+	/* The identifier of the store
+	 */
+	uint8_t store_identifier[ 16 ];
+
+	/* The creation date and time of the store
+	 */
+	uint64_t store_creation_time;
+
+	/* The output file descriptor used to offload copying
+	 */
+	int output_file_descriptor;
+
+	/* The number of bytes written
+	 */
+	uint64_t write_size;
+
+	/* The number of bytes that were left sparse
+	 */
+	uint64_t sparse_size;
+
+	/* The number of bytes of which copying was offloaded to the file system
+	 */
+	uint64_t offload_size;
+};
+
+typedef struct export_handle export_handle_t;
+
+struct export_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The buffer (chunk) size
+	 */
+	size_t buffer_size;
+
+	/* The number of read threads
+	 */
+	int number_of_read_threads;
+
+	/* The number of write threads
+	 */
+	int number_of_write_threads;
+
+	/* The number of the store to export or 0 for all stores
+	 */
+	int store_number;
+
+	/* Value to indicate an interrupted export should be resumed
+	 */
+	uint8_t resume;
+
+	/* Value to indicate clusters that the NTFS file system in a store
+	 * marks as unallocated are exported as sparse data
+	 */
+	uint8_t skip_unallocated;
+
+	/* The input mode used to read volume data
+	 */
+	int input_mode;
+
+	/* The target path
+	 */
+	const system_character_t *target_path;
+
+	/* The input filename
+	 */
+	const system_character_t *input_filename;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libvshadow input volume
+	 */
+	libvshadow_volume_t *input_volume;
+
+	/* The volume size
+	 */
+	size64_t volume_size;
+
+	/* The chunks
+	 */
+	export_chunk_t **chunks;
+
+	/* The number of chunks
+	 */
+	int number_of_chunks;
+
+	/* The chunk used to signal the write threads to stop
+	 */
+	export_chunk_t *terminator_chunk;
+
+	/* The targets
+	 */
+	export_target_t **targets;
+
+	/* The number of targets
+	 */
+	int number_of_targets;
+
+	/* The offset the export started at
+	 */
+	off64_t start_offset;
+
+	/* The offset of the next chunk to read
+	 */
+	off64_t next_offset;
+
+	/* Value per chunk to indicate the chunk was written
+	 */
+	uint8_t *completed_chunks;
+
+	/* The number of chunks to export
+	 */
+	uint64_t number_of_export_chunks;
+
+	/* The index of the first chunk that was not written
+	 */
+	uint64_t completed_chunk_index;
+
+	/* The offset of the most recently written checkpoint
+	 */
+	off64_t checkpoint_offset;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the offsets, the completed chunks and the targets
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The queue of chunks that can be read into
+	 */
+	libcthreads_queue_t *free_queue;
+
+	/* The queue of chunks that need to be written
+	 */
+	libcthreads_queue_t *write_queue;
+#endif
+
+	/* Value to indicate copying volume data is offloaded to the file system
+	 */
+	uint8_t copy_offload;
+
+	/* The input file descriptor used to offload copying
+	 */
+	int input_file_descriptor;
+
+	/* The input file descriptor used to read volume data in the direct and no cache input modes
+	 */
+	int input_data_file_descriptor;
+
+	/* The number of bytes read from the volume
+	 */
+	uint64_t read_size;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+typedef struct export_thread_arguments export_thread_arguments_t;
+
+/* The arguments of a read or write thread
+ */
+struct export_thread_arguments
+{
+	/* The export handle
+	 */
+	export_handle_t *export_handle;
+
+	/* The store of every target, used by a read thread
+	 */
+	libvshadow_store_t **stores;
+
+	/* The file IO handle, used by a read thread
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The output file of every target, used by a write thread
+	 */
+	libcfile_file_t **output_files;
+
+	/* The result of the thread
+	 */
+	int result;
+};
+
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int export_chunk_initialize(
+     export_chunk_t **chunk,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int export_chunk_free(
+     export_chunk_t **chunk,
+     libcerror_error_t **error );
+
+int export_chunk_resize_data(
+     export_chunk_t *chunk,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int export_chunk_append_segment(
+     export_chunk_t *chunk,
+     int target_index,
+     size_t offset,
+     size_t size,
+     off64_t physical_offset,
+     uint8_t is_sparse,
+     uint8_t is_offloaded,
+     libcerror_error_t **error );
+
+int export_target_initialize(
+     export_target_t **target,
+     const system_character_t *target_path,
+     int store_index,
+     libcerror_error_t **error );
+
+int export_target_free(
+     export_target_t **target,
+     libcerror_error_t **error );
+
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_set_volume_offset(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_buffer_size(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_number_of_read_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_number_of_write_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_store_number(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_input_mode(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_target_path(
+     export_handle_t *export_handle,
+     const system_character_t *target_path,
+     libcerror_error_t **error );
+
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_close(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_free_chunks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_free_targets(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_open_file(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     int access_flags,
+     libcfile_file_t **file,
+     libcerror_error_t **error );
+
+int export_handle_read_store_identity(
+     export_handle_t *export_handle,
+     export_target_t *target,
+     libcerror_error_t **error );
+
+int export_handle_read_checkpoint(
+     export_handle_t *export_handle,
+     export_target_t *target,
+     off64_t *offset,
+     libcerror_error_t **error );
+
+int export_handle_flush_file(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_flush_output_files(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_write_checkpoint(
+     export_handle_t *export_handle,
+     export_target_t *target,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int export_handle_write_checkpoints(
+     export_handle_t *export_handle,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int export_handle_prepare_output_file(
+     export_handle_t *export_handle,
+     export_target_t *target,
+     libcerror_error_t **error );
+
+int export_handle_open_copy_offload(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_close_copy_offload(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_copy_segment(
+     export_handle_t *export_handle,
+     export_target_t *target,
+     off64_t offset,
+     off64_t physical_offset,
+     size_t size,
+     libcerror_error_t **error );
+
+int export_handle_open_input_data(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_close_input_data(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_read_volume_data(
+     export_handle_t *export_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t physical_offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int export_handle_read_allocation_bitmaps(
+     export_handle_t *export_handle,
+     libvshadow_store_t **stores,
+     libcerror_error_t **error );
+
+int export_handle_read_chunk(
+     export_handle_t *export_handle,
+     libvshadow_store_t **stores,
+     libbfio_handle_t *file_io_handle,
+     export_chunk_t *chunk,
+     libcerror_error_t **error );
+
+int export_handle_write_chunk(
+     export_handle_t *export_handle,
+     libcfile_file_t **output_files,
+     export_chunk_t *chunk,
+     libcerror_error_t **error );
+
+int export_handle_complete_chunk(
+     export_handle_t *export_handle,
+     export_chunk_t *chunk,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int export_handle_read_thread_callback(
+     export_thread_arguments_t *thread_arguments );
+
+int export_handle_write_thread_callback(
+     export_thread_arguments_t *thread_arguments );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int export_handle_export_data(
+     export_handle_t *export_handle,
+     export_thread_arguments_t *read_thread_arguments,
+     export_thread_arguments_t *write_thread_arguments,
+     libcerror_error_t **error );
+
+int export_handle_export_targets(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_export_stores(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EXPORT_HANDLE_H ) */
+
@@ -0,0 +1,2674 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include "hash_handle.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libhmac.h"
+#include "vshadowtools_libvshadow.h"
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+extern \
+int libvshadow_volume_open_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libvshadow_error_t **error );
+
+extern \
+int libvshadow_check_volume_signature_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
+#define HASH_HANDLE_NOTIFY_STREAM		stdout
+
+/* The size of the data of a single store in a batch
+ */
+#define HASH_HANDLE_BATCH_SIZE			( 1024 * 1024 )
+
+#define HASH_HANDLE_DEFAULT_BLOCK_SIZE		16384
+#define HASH_HANDLE_MAXIMUM_BLOCK_SIZE		( 64 * 1024 * 1024 )
+
+#define HASH_HANDLE_DEFAULT_NUMBER_OF_THREADS	4
+#define HASH_HANDLE_MAXIMUM_NUMBER_OF_THREADS	64
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "vshadowtools_system_string_copy_from_64_bit_in_decimal";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Creates a hash handle
+ * Make sure the value hash_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_initialize";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_handle = memory_allocate_structure(
+	                hash_handle_t );
+
+	if( *hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_handle,
+	     0,
+	     sizeof( hash_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash handle.",
+		 function );
+
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_range_initialize(
+	     &( ( *hash_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     &( ( *hash_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+	( *hash_handle )->block_size        = HASH_HANDLE_DEFAULT_BLOCK_SIZE;
+	( *hash_handle )->digest_types      = HASH_HANDLE_DIGEST_TYPE_MD5;
+	( *hash_handle )->number_of_threads = HASH_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+	( *hash_handle )->notify_stream     = HASH_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *hash_handle != NULL )
+	{
+		if( ( *hash_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *hash_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a hash handle
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_free";
+	int result            = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		if( hash_handle_free_stores(
+		     *hash_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free stores.",
+			 function );
+
+			result = -1;
+		}
+		if( libvshadow_volume_free(
+		     &( ( *hash_handle )->input_volume ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input volume.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *hash_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the hash handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_signal_abort";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->abort = 1;
+
+	if( hash_handle->input_volume != NULL )
+	{
+		if( libvshadow_volume_signal_abort(
+		     hash_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_volume_offset(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the block size
+ * The block size must be a multiple of 512
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int hash_handle_set_block_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_block_size";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) HASH_HANDLE_MAXIMUM_BLOCK_SIZE )
+	 || ( ( value_64bit % 512 ) != 0 ) )
+	{
+		return( 0 );
+	}
+	hash_handle->block_size = (size_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the digest types
+ * The string contains a comma separated list of: md5, sha256 or all
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int hash_handle_set_digest_types(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "hash_handle_set_digest_types";
+	size_t segment_length  = 0;
+	size_t string_index    = 0;
+	size_t string_length   = 0;
+	uint8_t digest_types   = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	while( string_index < string_length )
+	{
+		segment_length = 0;
+
+		while( ( string_index + segment_length ) < string_length )
+		{
+			if( string[ string_index + segment_length ] == (system_character_t) ',' )
+			{
+				break;
+			}
+			segment_length++;
+		}
+		if( ( segment_length == 3 )
+		 && ( system_string_compare_no_case(
+		       &( string[ string_index ] ),
+		       _SYSTEM_STRING( "all" ),
+		       3 ) == 0 ) )
+		{
+			digest_types |= HASH_HANDLE_DIGEST_TYPE_MD5 | HASH_HANDLE_DIGEST_TYPE_SHA256;
+		}
+		else if( ( segment_length == 3 )
+		      && ( system_string_compare_no_case(
+		            &( string[ string_index ] ),
+		            _SYSTEM_STRING( "md5" ),
+		            3 ) == 0 ) )
+		{
+			digest_types |= HASH_HANDLE_DIGEST_TYPE_MD5;
+		}
+		else if( ( ( segment_length == 6 )
+		        && ( system_string_compare_no_case(
+		              &( string[ string_index ] ),
+		              _SYSTEM_STRING( "sha256" ),
+		              6 ) == 0 ) )
+		      || ( ( segment_length == 7 )
+		        && ( system_string_compare_no_case(
+		              &( string[ string_index ] ),
+		              _SYSTEM_STRING( "sha-256" ),
+		              7 ) == 0 ) ) )
+		{
+			digest_types |= HASH_HANDLE_DIGEST_TYPE_SHA256;
+		}
+		else
+		{
+			return( 0 );
+		}
+		string_index += segment_length + 1;
+	}
+	if( digest_types == 0 )
+	{
+		return( 0 );
+	}
+	hash_handle->digest_types = digest_types;
+
+	return( 1 );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int hash_handle_set_number_of_threads(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) HASH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		return( 0 );
+	}
+	hash_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Opens the hash handle
+ * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
+ */
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "hash_handle_open_input";
+	size_t filename_length = 0;
+	int result             = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     hash_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     hash_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_range_set(
+	     hash_handle->input_file_io_handle,
+	     hash_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open set volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_check_volume_signature_file_io_handle(
+	          hash_handle->input_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume has a VSS signature.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libvshadow_volume_open_file_io_handle(
+		     hash_handle->input_volume,
+		     hash_handle->input_file_io_handle,
+		     LIBVSHADOW_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open input volume.",
+			 function );
+
+			return( -1 );
+		}
+		/* The batches are hashed on the thread pool of the input volume
+		 */
+		if( libvshadow_volume_set_maximum_number_of_threads(
+		     hash_handle->input_volume,
+		     hash_handle->number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of threads of input volume.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Closes the hash handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int hash_handle_close(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_close";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle_free_stores(
+	     hash_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free stores.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_close(
+	     hash_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Creates a batch
+ * Make sure the value batch is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_batch_initialize(
+     hash_batch_t **batch,
+     int number_of_stores,
+     int number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function     = "hash_batch_initialize";
+	size_t number_of_entries  = 0;
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *batch != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid batch value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_stores <= 0 )
+	 || ( number_of_blocks <= 0 )
+	 || ( number_of_stores > ( INT_MAX / 2 / number_of_blocks ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of stores or blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_entries = (size_t) number_of_stores * (size_t) number_of_blocks;
+
+	*batch = memory_allocate_structure(
+	          hash_batch_t );
+
+	if( *batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *batch,
+	     0,
+	     sizeof( hash_batch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear batch.",
+		 function );
+
+		memory_free(
+		 *batch );
+
+		*batch = NULL;
+
+		return( -1 );
+	}
+	( *batch )->blocks = (hash_block_t *) memory_allocate(
+	                                       sizeof( hash_block_t ) * number_of_entries );
+
+	if( ( *batch )->blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocks.",
+		 function );
+
+		goto on_error;
+	}
+	( *batch )->block_indexes = (int *) memory_allocate(
+	                                     sizeof( int ) * number_of_entries );
+
+	if( ( *batch )->block_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block indexes.",
+		 function );
+
+		goto on_error;
+	}
+	/* Keep the hash table at most half full
+	 */
+	( *batch )->hash_table_size = 1;
+
+	while( (size_t) ( *batch )->hash_table_size < ( number_of_entries * 2 ) )
+	{
+		( *batch )->hash_table_size <<= 1;
+	}
+	( *batch )->hash_table = (int *) memory_allocate(
+	                                  sizeof( int ) * ( *batch )->hash_table_size );
+
+	if( ( *batch )->hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash table.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *batch != NULL )
+	{
+		if( ( *batch )->block_indexes != NULL )
+		{
+			memory_free(
+			 ( *batch )->block_indexes );
+		}
+		if( ( *batch )->blocks != NULL )
+		{
+			memory_free(
+			 ( *batch )->blocks );
+		}
+		memory_free(
+		 *batch );
+
+		*batch = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a batch
+ * Returns 1 if successful or -1 on error
+ */
+int hash_batch_free(
+     hash_batch_t **batch,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_batch_free";
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *batch != NULL )
+	{
+		if( ( *batch )->data != NULL )
+		{
+			memory_free(
+			 ( *batch )->data );
+		}
+		memory_free(
+		 ( *batch )->hash_table );
+		memory_free(
+		 ( *batch )->block_indexes );
+		memory_free(
+		 ( *batch )->blocks );
+		memory_free(
+		 *batch );
+
+		*batch = NULL;
+	}
+	return( 1 );
+}
+
+/* Frees the stores and the corresponding digest contexts and batches
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_free_stores(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_free_stores";
+	int batch_index       = 0;
+	int result            = 1;
+	int store_index       = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( batch_index = 0;
+	     batch_index < 2;
+	     batch_index++ )
+	{
+		if( hash_batch_free(
+		     &( hash_handle->batches[ batch_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free batch: %d.",
+			 function,
+			 batch_index );
+
+			result = -1;
+		}
+	}
+	for( store_index = 0;
+	     store_index < hash_handle->number_of_stores;
+	     store_index++ )
+	{
+		if( ( hash_handle->md5_contexts != NULL )
+		 && ( hash_handle->md5_contexts[ store_index ] != NULL ) )
+		{
+			if( libhmac_md5_free(
+			     &( hash_handle->md5_contexts[ store_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MD5 context: %d.",
+				 function,
+				 store_index );
+
+				result = -1;
+			}
+		}
+		if( ( hash_handle->md5_list_contexts != NULL )
+		 && ( hash_handle->md5_list_contexts[ store_index ] != NULL ) )
+		{
+			if( libhmac_md5_free(
+			     &( hash_handle->md5_list_contexts[ store_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MD5 block hash list context: %d.",
+				 function,
+				 store_index );
+
+				result = -1;
+			}
+		}
+		if( ( hash_handle->sha256_contexts != NULL )
+		 && ( hash_handle->sha256_contexts[ store_index ] != NULL ) )
+		{
+			if( libhmac_sha256_free(
+			     &( hash_handle->sha256_contexts[ store_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA-256 context: %d.",
+				 function,
+				 store_index );
+
+				result = -1;
+			}
+		}
+		if( ( hash_handle->sha256_list_contexts != NULL )
+		 && ( hash_handle->sha256_list_contexts[ store_index ] != NULL ) )
+		{
+			if( libhmac_sha256_free(
+			     &( hash_handle->sha256_list_contexts[ store_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA-256 block hash list context: %d.",
+				 function,
+				 store_index );
+
+				result = -1;
+			}
+		}
+		if( ( hash_handle->stores != NULL )
+		 && ( hash_handle->stores[ store_index ] != NULL ) )
+		{
+			if( libvshadow_store_free(
+			     &( hash_handle->stores[ store_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free store: %d.",
+				 function,
+				 store_index );
+
+				result = -1;
+			}
+		}
+	}
+	if( hash_handle->md5_contexts != NULL )
+	{
+		memory_free(
+		 hash_handle->md5_contexts );
+
+		hash_handle->md5_contexts = NULL;
+	}
+	if( hash_handle->md5_list_contexts != NULL )
+	{
+		memory_free(
+		 hash_handle->md5_list_contexts );
+
+		hash_handle->md5_list_contexts = NULL;
+	}
+	if( hash_handle->sha256_contexts != NULL )
+	{
+		memory_free(
+		 hash_handle->sha256_contexts );
+
+		hash_handle->sha256_contexts = NULL;
+	}
+	if( hash_handle->sha256_list_contexts != NULL )
+	{
+		memory_free(
+		 hash_handle->sha256_list_contexts );
+
+		hash_handle->sha256_list_contexts = NULL;
+	}
+	if( hash_handle->stores != NULL )
+	{
+		memory_free(
+		 hash_handle->stores );
+
+		hash_handle->stores = NULL;
+	}
+	if( hash_handle->extents != NULL )
+	{
+		memory_free(
+		 hash_handle->extents );
+
+		hash_handle->extents = NULL;
+	}
+	if( hash_handle->zero_block != NULL )
+	{
+		memory_free(
+		 hash_handle->zero_block );
+
+		hash_handle->zero_block = NULL;
+	}
+	hash_handle->number_of_stores = 0;
+
+	return( result );
+}
+
+/* Retrieves the index of the distinct block of a specific block of a store
+ * Blocks that are stored consecutively at the same physical offset in different stores
+ * share a single distinct block, which is read only once
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_get_block_index(
+     hash_handle_t *hash_handle,
+     hash_batch_t *batch,
+     int store_index,
+     off64_t offset,
+     size_t block_size,
+     int *block_index,
+     libcerror_error_t **error )
+{
+	hash_block_t *block           = NULL;
+	hash_extent_t *extent         = NULL;
+	uint8_t *reallocation         = NULL;
+	static char *function         = "hash_handle_get_block_index";
+	off64_t physical_offset       = -1;
+	size64_t extent_size          = 0;
+	size_t data_size              = 0;
+	ssize_t read_count            = 0;
+	uint64_t hash_value           = 0;
+	uint32_t extent_flags         = 0;
+	int hash_table_index          = 0;
+	int result                    = 0;
+	int safe_block_index          = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_index < 0 )
+	 || ( store_index >= hash_handle->number_of_stores ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	extent = &( hash_handle->extents[ store_index ] );
+
+	if( ( offset < extent->offset )
+	 || ( (size64_t) ( offset - extent->offset ) >= extent->size ) )
+	{
+		result = libvshadow_store_get_physical_extent(
+		          hash_handle->stores[ store_index ],
+		          offset,
+		          (size64_t) HASH_HANDLE_BATCH_SIZE,
+		          &( extent->physical_offset ),
+		          &extent_size,
+		          &extent_flags,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve physical extent of store: %d at offset: %" PRIi64 ".",
+			 function,
+			 store_index,
+			 offset );
+
+			return( -1 );
+		}
+		if( ( hash_handle->skip_unallocated != 0 )
+		 && ( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_UNALLOCATED ) != 0 ) )
+		{
+			extent_flags |= LIBVSHADOW_EXTENT_FLAG_IS_SPARSE;
+		}
+		extent->offset = offset;
+		extent->size   = extent_size;
+		extent->flags  = extent_flags;
+	}
+	/* Only blocks that are stored consecutively can be shared
+	 */
+	if( ( (size64_t) ( offset - extent->offset ) + block_size ) <= extent->size )
+	{
+		extent_flags = extent->flags;
+
+		if( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		{
+			physical_offset = 0;
+		}
+		else
+		{
+			physical_offset = extent->physical_offset + ( offset - extent->offset );
+		}
+		hash_value  = ( (uint64_t) physical_offset >> 9 ) ^ extent_flags;
+		hash_value *= 0x9e3779b97f4a7c15ULL;
+		hash_value ^= hash_value >> 32;
+
+		hash_table_index = (int) ( hash_value & (uint64_t) ( batch->hash_table_size - 1 ) );
+
+		while( batch->hash_table[ hash_table_index ] != 0 )
+		{
+			block = &( batch->blocks[ batch->hash_table[ hash_table_index ] - 1 ] );
+
+			if( ( block->physical_offset == physical_offset )
+			 && ( block->extent_flags == extent_flags )
+			 && ( block->data_size == block_size ) )
+			{
+				*block_index = batch->hash_table[ hash_table_index ] - 1;
+
+				return( 1 );
+			}
+			hash_table_index = ( hash_table_index + 1 ) & ( batch->hash_table_size - 1 );
+		}
+	}
+	else
+	{
+		extent_flags = 0;
+	}
+	safe_block_index = batch->number_of_distinct_blocks;
+
+	block = &( batch->blocks[ safe_block_index ] );
+
+	block->offset          = offset;
+	block->physical_offset = physical_offset;
+	block->extent_flags    = extent_flags;
+	block->store_index     = store_index;
+	block->data_offset     = batch->used_data_size;
+	block->data_size       = block_size;
+
+	if( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) == 0 )
+	{
+		if( block_size > ( batch->data_size - batch->used_data_size ) )
+		{
+			data_size = batch->data_size * 2;
+
+			if( data_size < HASH_HANDLE_BATCH_SIZE )
+			{
+				data_size = HASH_HANDLE_BATCH_SIZE;
+			}
+			while( block_size > ( data_size - batch->used_data_size ) )
+			{
+				data_size *= 2;
+			}
+			reallocation = (uint8_t *) memory_reallocate(
+			                            batch->data,
+			                            sizeof( uint8_t ) * data_size );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize batch data.",
+				 function );
+
+				return( -1 );
+			}
+			batch->data      = reallocation;
+			batch->data_size = data_size;
+		}
+		if( physical_offset != -1 )
+		{
+			/* Read data that is stored consecutively directly from the volume
+			 */
+			if( libbfio_handle_seek_offset(
+			     hash_handle->input_file_io_handle,
+			     physical_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek physical offset: %" PRIi64 ".",
+				 function,
+				 physical_offset );
+
+				return( -1 );
+			}
+			read_count = libbfio_handle_read_buffer(
+			              hash_handle->input_file_io_handle,
+			              &( batch->data[ batch->used_data_size ] ),
+			              block_size,
+			              error );
+		}
+		else
+		{
+			read_count = libvshadow_store_read_buffer_at_offset(
+			              hash_handle->stores[ store_index ],
+			              &( batch->data[ batch->used_data_size ] ),
+			              block_size,
+			              offset,
+			              error );
+		}
+		if( read_count != (ssize_t) block_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block of store: %d at offset: %" PRIi64 ".",
+			 function,
+			 store_index,
+			 offset );
+
+			return( -1 );
+		}
+		batch->used_data_size  += block_size;
+		hash_handle->read_size += (uint64_t) block_size;
+	}
+	if( physical_offset != -1 )
+	{
+		batch->hash_table[ hash_table_index ] = safe_block_index + 1;
+	}
+	batch->number_of_distinct_blocks += 1;
+
+	*block_index = safe_block_index;
+
+	return( 1 );
+}
+
+/* Reads a batch of blocks of all stores
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_read_batch(
+     hash_handle_t *hash_handle,
+     hash_batch_t *batch,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_read_batch";
+	off64_t block_offset  = 0;
+	size64_t remaining    = 0;
+	size_t block_size     = 0;
+	int block_index       = 0;
+	int entry_index       = 0;
+	int number_of_blocks  = 0;
+	int store_index       = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     batch->hash_table,
+	     0,
+	     sizeof( int ) * batch->hash_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash table.",
+		 function );
+
+		return( -1 );
+	}
+	batch->offset                    = offset;
+	batch->number_of_blocks          = 0;
+	batch->number_of_distinct_blocks = 0;
+	batch->used_data_size            = 0;
+
+	if( (size64_t) offset >= hash_handle->volume_size )
+	{
+		return( 1 );
+	}
+	remaining = hash_handle->volume_size - (size64_t) offset;
+
+	number_of_blocks = (int) ( remaining / hash_handle->block_size );
+
+	if( ( remaining % hash_handle->block_size ) != 0 )
+	{
+		number_of_blocks++;
+	}
+	if( ( remaining >= (size64_t) INT_MAX )
+	 || ( number_of_blocks > hash_handle->number_of_blocks_per_batch ) )
+	{
+		number_of_blocks = hash_handle->number_of_blocks_per_batch;
+	}
+	for( store_index = 0;
+	     store_index < hash_handle->number_of_stores;
+	     store_index++ )
+	{
+		block_offset = offset;
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			if( hash_handle->abort != 0 )
+			{
+				return( 1 );
+			}
+			block_size = hash_handle->block_size;
+
+			if( (size64_t) block_size > ( hash_handle->volume_size - (size64_t) block_offset ) )
+			{
+				block_size = (size_t) ( hash_handle->volume_size - (size64_t) block_offset );
+			}
+			entry_index = ( store_index * number_of_blocks ) + block_index;
+
+			if( hash_handle_get_block_index(
+			     hash_handle,
+			     batch,
+			     store_index,
+			     block_offset,
+			     block_size,
+			     &( batch->block_indexes[ entry_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve block: %d of store: %d.",
+				 function,
+				 block_index,
+				 store_index );
+
+				return( -1 );
+			}
+			block_offset += block_size;
+		}
+	}
+	batch->number_of_blocks = number_of_blocks;
+
+	return( 1 );
+}
+
+/* Hashes part of a batch
+ * The part consists of the hashes of every Nth distinct block and
+ * the hashes of the data of every Nth store, where N is the number of parts
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash_batch_part(
+     hash_handle_t *hash_handle,
+     hash_batch_t *batch,
+     int part_index,
+     int number_of_parts,
+     libcerror_error_t **error )
+{
+	hash_block_t *block   = NULL;
+	uint8_t *data         = NULL;
+	static char *function = "hash_handle_hash_batch_part";
+	int block_index       = 0;
+	int entry_index       = 0;
+	int store_index       = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_parts <= 0 )
+	 || ( part_index < 0 )
+	 || ( part_index >= number_of_parts ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid part index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( block_index = part_index;
+	     block_index < batch->number_of_distinct_blocks;
+	     block_index += number_of_parts )
+	{
+		block = &( batch->blocks[ block_index ] );
+
+		if( ( block->extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		{
+			data = hash_handle->zero_block;
+		}
+		else
+		{
+			data = &( batch->data[ block->data_offset ] );
+		}
+		if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_MD5 ) != 0 )
+		{
+			if( libhmac_md5_calculate(
+			     data,
+			     block->data_size,
+			     block->md5_hash,
+			     LIBHMAC_MD5_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to calculate MD5 hash of block: %d.",
+				 function,
+				 block_index );
+
+				return( -1 );
+			}
+		}
+		if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_SHA256 ) != 0 )
+		{
+			if( libhmac_sha256_calculate(
+			     data,
+			     block->data_size,
+			     block->sha256_hash,
+			     LIBHMAC_SHA256_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to calculate SHA-256 hash of block: %d.",
+				 function,
+				 block_index );
+
+				return( -1 );
+			}
+		}
+	}
+	/* The data of a store is hashed in order by a single part
+	 */
+	for( store_index = part_index;
+	     store_index < hash_handle->number_of_stores;
+	     store_index += number_of_parts )
+	{
+		for( block_index = 0;
+		     block_index < batch->number_of_blocks;
+		     block_index++ )
+		{
+			entry_index = ( store_index * batch->number_of_blocks ) + block_index;
+
+			block = &( batch->blocks[ batch->block_indexes[ entry_index ] ] );
+
+			if( ( block->extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+			{
+				data = hash_handle->zero_block;
+			}
+			else
+			{
+				data = &( batch->data[ block->data_offset ] );
+			}
+			if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_MD5 ) != 0 )
+			{
+				if( libhmac_md5_update(
+				     hash_handle->md5_contexts[ store_index ],
+				     data,
+				     block->data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update MD5 hash of store: %d.",
+					 function,
+					 store_index );
+
+					return( -1 );
+				}
+			}
+			if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_SHA256 ) != 0 )
+			{
+				if( libhmac_sha256_update(
+				     hash_handle->sha256_contexts[ store_index ],
+				     data,
+				     block->data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update SHA-256 hash of store: %d.",
+					 function,
+					 store_index );
+
+					return( -1 );
+				}
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Runs a task that hashes a batch
+ * Task 0 reads the next batch, if any, while the other tasks hash part of the batch
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash_batch_task_callback(
+     int task_index,
+     hash_batch_task_arguments_t *task_arguments )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "hash_handle_hash_batch_task_callback";
+
+	if( task_arguments == NULL )
+	{
+		return( -1 );
+	}
+	if( task_index == 0 )
+	{
+		if( task_arguments->next_batch != NULL )
+		{
+			if( hash_handle_read_batch(
+			     task_arguments->hash_handle,
+			     task_arguments->next_batch,
+			     task_arguments->next_offset,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read batch at offset: %" PRIi64 ".",
+				 function,
+				 task_arguments->next_offset );
+
+				goto on_error;
+			}
+		}
+	}
+	else if( hash_handle_hash_batch_part(
+	          task_arguments->hash_handle,
+	          task_arguments->batch,
+	          task_index - 1,
+	          task_arguments->number_of_parts,
+	          &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to hash part: %d of batch.",
+		 function,
+		 task_index - 1 );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+
+/* Hashes a batch
+ * If a next batch is provided it is read while the batch is being hashed
+ * The tasks are run on the thread pool of the input volume
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash_batch(
+     hash_handle_t *hash_handle,
+     hash_batch_t *batch,
+     hash_batch_t *next_batch,
+     off64_t next_offset,
+     libcerror_error_t **error )
+{
+	hash_batch_task_arguments_t task_arguments;
+
+	static char *function = "hash_handle_hash_batch";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	task_arguments.hash_handle     = hash_handle;
+	task_arguments.batch           = batch;
+	task_arguments.number_of_parts = hash_handle->number_of_threads;
+	task_arguments.next_batch      = next_batch;
+	task_arguments.next_offset     = next_offset;
+
+	if( libvshadow_volume_run_tasks(
+	     hash_handle->input_volume,
+	     (int (*)(int, void *)) &hash_handle_hash_batch_task_callback,
+	     (void *) &task_arguments,
+	     task_arguments.number_of_parts + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to hash batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle_finalize_batch(
+	     hash_handle,
+	     batch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize batch.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Finalizes a hashed batch
+ * Adds the block hashes to the block hash list of every store
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_finalize_batch(
+     hash_handle_t *hash_handle,
+     hash_batch_t *batch,
+     libcerror_error_t **error )
+{
+	hash_block_t *block   = NULL;
+	static char *function = "hash_handle_finalize_batch";
+	int block_index       = 0;
+	int entry_index       = 0;
+	int store_index       = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	for( store_index = 0;
+	     store_index < hash_handle->number_of_stores;
+	     store_index++ )
+	{
+		for( block_index = 0;
+		     block_index < batch->number_of_blocks;
+		     block_index++ )
+		{
+			entry_index = ( store_index * batch->number_of_blocks ) + block_index;
+
+			block = &( batch->blocks[ batch->block_indexes[ entry_index ] ] );
+
+			if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_MD5 ) != 0 )
+			{
+				if( libhmac_md5_update(
+				     hash_handle->md5_list_contexts[ store_index ],
+				     block->md5_hash,
+				     LIBHMAC_MD5_HASH_SIZE,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update MD5 block hash list of store: %d.",
+					 function,
+					 store_index );
+
+					return( -1 );
+				}
+			}
+			if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_SHA256 ) != 0 )
+			{
+				if( libhmac_sha256_update(
+				     hash_handle->sha256_list_contexts[ store_index ],
+				     block->sha256_hash,
+				     LIBHMAC_SHA256_HASH_SIZE,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update SHA-256 block hash list of store: %d.",
+					 function,
+					 store_index );
+
+					return( -1 );
+				}
+			}
+			if( hash_handle->print_block_hashes != 0 )
+			{
+				fprintf(
+				 hash_handle->notify_stream,
+				 "vss%d\t0x%08" PRIx64 "\t%" PRIzd "",
+				 store_index + 1,
+				 batch->offset + ( (off64_t) block_index * hash_handle->block_size ),
+				 block->data_size );
+
+				if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_MD5 ) != 0 )
+				{
+					fprintf(
+					 hash_handle->notify_stream,
+					 "\t" );
+
+					if( hash_handle_digest_hash_fprint(
+					     hash_handle,
+					     block->md5_hash,
+					     LIBHMAC_MD5_HASH_SIZE,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+						 "%s: unable to print MD5 hash.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_SHA256 ) != 0 )
+				{
+					fprintf(
+					 hash_handle->notify_stream,
+					 "\t" );
+
+					if( hash_handle_digest_hash_fprint(
+					     hash_handle,
+					     block->sha256_hash,
+					     LIBHMAC_SHA256_HASH_SIZE,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+						 "%s: unable to print SHA-256 hash.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				fprintf(
+				 hash_handle->notify_stream,
+				 "\n" );
+			}
+		}
+	}
+	hash_handle->number_of_blocks          += (uint64_t) hash_handle->number_of_stores * batch->number_of_blocks;
+	hash_handle->number_of_distinct_blocks += (uint64_t) batch->number_of_distinct_blocks;
+
+	return( 1 );
+}
+
+/* Prints a digest hash as a hexadecimal string
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_digest_hash_fprint(
+     hash_handle_t *hash_handle,
+     const uint8_t *digest_hash,
+     size_t digest_hash_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "hash_handle_digest_hash_fprint";
+	size_t digest_hash_index = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash.",
+		 function );
+
+		return( -1 );
+	}
+	for( digest_hash_index = 0;
+	     digest_hash_index < digest_hash_size;
+	     digest_hash_index++ )
+	{
+		fprintf(
+		 hash_handle->notify_stream,
+		 "%02" PRIx8 "",
+		 digest_hash[ digest_hash_index ] );
+	}
+	return( 1 );
+}
+
+/* Hashes the data of all the stores
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int hash_handle_hash_stores(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	uint8_t md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+	uint8_t sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	hash_batch_t *batch    = NULL;
+	hash_batch_t *next_batch = NULL;
+	static char *function  = "hash_handle_hash_stores";
+	off64_t next_offset    = 0;
+	off64_t offset         = 0;
+	int batch_index        = 0;
+	int number_of_stores   = 0;
+	int result             = 0;
+	int store_index        = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->stores != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - stores value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_size(
+	     hash_handle->input_volume,
+	     &( hash_handle->volume_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_get_number_of_stores(
+	     hash_handle->input_volume,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "Volume Shadow Snapshot hashes:\n" );
+
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\tNumber of stores\t\t: %d\n",
+	 number_of_stores );
+
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\tBlock size\t\t\t: %" PRIzd "\n",
+	 hash_handle->block_size );
+
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\n" );
+
+	if( number_of_stores == 0 )
+	{
+		return( 1 );
+	}
+	hash_handle->number_of_blocks_per_batch = (int) ( HASH_HANDLE_BATCH_SIZE / hash_handle->block_size );
+
+	if( hash_handle->number_of_blocks_per_batch == 0 )
+	{
+		hash_handle->number_of_blocks_per_batch = 1;
+	}
+	hash_handle->stores = (libvshadow_store_t **) memory_allocate(
+	                                               sizeof( libvshadow_store_t * ) * number_of_stores );
+
+	if( hash_handle->stores == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stores.",
+		 function );
+
+		goto on_error;
+	}
+	hash_handle->extents = (hash_extent_t *) memory_allocate(
+	                                          sizeof( hash_extent_t ) * number_of_stores );
+
+	if( hash_handle->extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extents.",
+		 function );
+
+		goto on_error;
+	}
+	hash_handle->md5_contexts = (libhmac_md5_context_t **) memory_allocate(
+	                                                        sizeof( libhmac_md5_context_t * ) * number_of_stores );
+
+	hash_handle->md5_list_contexts = (libhmac_md5_context_t **) memory_allocate(
+	                                                             sizeof( libhmac_md5_context_t * ) * number_of_stores );
+
+	hash_handle->sha256_contexts = (libhmac_sha256_context_t **) memory_allocate(
+	                                                              sizeof( libhmac_sha256_context_t * ) * number_of_stores );
+
+	hash_handle->sha256_list_contexts = (libhmac_sha256_context_t **) memory_allocate(
+	                                                                   sizeof( libhmac_sha256_context_t * ) * number_of_stores );
+
+	if( ( hash_handle->md5_contexts == NULL )
+	 || ( hash_handle->md5_list_contexts == NULL )
+	 || ( hash_handle->sha256_contexts == NULL )
+	 || ( hash_handle->sha256_list_contexts == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest contexts.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		hash_handle->stores[ store_index ]               = NULL;
+		hash_handle->md5_contexts[ store_index ]         = NULL;
+		hash_handle->md5_list_contexts[ store_index ]    = NULL;
+		hash_handle->sha256_contexts[ store_index ]      = NULL;
+		hash_handle->sha256_list_contexts[ store_index ] = NULL;
+
+		hash_handle->extents[ store_index ].offset = 0;
+		hash_handle->extents[ store_index ].size   = 0;
+	}
+	hash_handle->number_of_stores = number_of_stores;
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( libvshadow_volume_get_store(
+		     hash_handle->input_volume,
+		     store_index,
+		     &( hash_handle->stores[ store_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( hash_handle->skip_unallocated != 0 )
+		{
+			result = libvshadow_store_read_allocation_bitmap(
+			          hash_handle->stores[ store_index ],
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read allocation bitmap of store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				fprintf(
+				 hash_handle->notify_stream,
+				 "Store: %d does not contain a NTFS file system, hashing all clusters.\n",
+				 store_index + 1 );
+			}
+		}
+		if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_MD5 ) != 0 )
+		{
+			if( ( libhmac_md5_initialize(
+			       &( hash_handle->md5_contexts[ store_index ] ),
+			       error ) != 1 )
+			 || ( libhmac_md5_initialize(
+			       &( hash_handle->md5_list_contexts[ store_index ] ),
+			       error ) != 1 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize MD5 contexts: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+		}
+		if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_SHA256 ) != 0 )
+		{
+			if( ( libhmac_sha256_initialize(
+			       &( hash_handle->sha256_contexts[ store_index ] ),
+			       error ) != 1 )
+			 || ( libhmac_sha256_initialize(
+			       &( hash_handle->sha256_list_contexts[ store_index ] ),
+			       error ) != 1 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize SHA-256 contexts: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+		}
+	}
+	hash_handle->zero_block = (uint8_t *) memory_allocate(
+	                                       sizeof( uint8_t ) * hash_handle->block_size );
+
+	if( hash_handle->zero_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create zero block.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     hash_handle->zero_block,
+	     0,
+	     sizeof( uint8_t ) * hash_handle->block_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear zero block.",
+		 function );
+
+		goto on_error;
+	}
+	for( batch_index = 0;
+	     batch_index < 2;
+	     batch_index++ )
+	{
+		if( hash_batch_initialize(
+		     &( hash_handle->batches[ batch_index ] ),
+		     number_of_stores,
+		     hash_handle->number_of_blocks_per_batch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize batch: %d.",
+			 function,
+			 batch_index );
+
+			goto on_error;
+		}
+	}
+	batch_index = 0;
+	batch       = hash_handle->batches[ batch_index ];
+
+	if( hash_handle_read_batch(
+	     hash_handle,
+	     batch,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read batch at offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	while( batch->number_of_blocks > 0 )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			break;
+		}
+		next_offset = offset + ( (off64_t) batch->number_of_blocks * hash_handle->block_size );
+
+		if( (size64_t) next_offset < hash_handle->volume_size )
+		{
+			next_batch = hash_handle->batches[ 1 - batch_index ];
+		}
+		else
+		{
+			next_batch = NULL;
+		}
+		if( hash_handle_hash_batch(
+		     hash_handle,
+		     batch,
+		     next_batch,
+		     next_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to hash batch at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			goto on_error;
+		}
+		if( next_batch == NULL )
+		{
+			break;
+		}
+		batch_index = 1 - batch_index;
+		batch       = next_batch;
+		offset      = next_offset;
+	}
+	if( hash_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	if( hash_handle->print_block_hashes != 0 )
+	{
+		fprintf(
+		 hash_handle->notify_stream,
+		 "\n" );
+	}
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		fprintf(
+		 hash_handle->notify_stream,
+		 "Store: %d\n",
+		 store_index + 1 );
+
+		if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_MD5 ) != 0 )
+		{
+			if( libhmac_md5_finalize(
+			     hash_handle->md5_contexts[ store_index ],
+			     md5_hash,
+			     LIBHMAC_MD5_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize MD5 hash of store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			fprintf(
+			 hash_handle->notify_stream,
+			 "\tMD5\t\t\t\t: " );
+
+			if( hash_handle_digest_hash_fprint(
+			     hash_handle,
+			     md5_hash,
+			     LIBHMAC_MD5_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print MD5 hash.",
+				 function );
+
+				goto on_error;
+			}
+			if( libhmac_md5_finalize(
+			     hash_handle->md5_list_contexts[ store_index ],
+			     md5_hash,
+			     LIBHMAC_MD5_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize MD5 block hash list of store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			fprintf(
+			 hash_handle->notify_stream,
+			 "\n\tMD5 of block hashes\t\t: " );
+
+			if( hash_handle_digest_hash_fprint(
+			     hash_handle,
+			     md5_hash,
+			     LIBHMAC_MD5_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print MD5 hash.",
+				 function );
+
+				goto on_error;
+			}
+			fprintf(
+			 hash_handle->notify_stream,
+			 "\n" );
+		}
+		if( ( hash_handle->digest_types & HASH_HANDLE_DIGEST_TYPE_SHA256 ) != 0 )
+		{
+			if( libhmac_sha256_finalize(
+			     hash_handle->sha256_contexts[ store_index ],
+			     sha256_hash,
+			     LIBHMAC_SHA256_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize SHA-256 hash of store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			fprintf(
+			 hash_handle->notify_stream,
+			 "\tSHA-256\t\t\t\t: " );
+
+			if( hash_handle_digest_hash_fprint(
+			     hash_handle,
+			     sha256_hash,
+			     LIBHMAC_SHA256_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print SHA-256 hash.",
+				 function );
+
+				goto on_error;
+			}
+			if( libhmac_sha256_finalize(
+			     hash_handle->sha256_list_contexts[ store_index ],
+			     sha256_hash,
+			     LIBHMAC_SHA256_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize SHA-256 block hash list of store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			fprintf(
+			 hash_handle->notify_stream,
+			 "\n\tSHA-256 of block hashes\t\t: " );
+
+			if( hash_handle_digest_hash_fprint(
+			     hash_handle,
+			     sha256_hash,
+			     LIBHMAC_SHA256_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print SHA-256 hash.",
+				 function );
+
+				goto on_error;
+			}
+			fprintf(
+			 hash_handle->notify_stream,
+			 "\n" );
+		}
+		fprintf(
+		 hash_handle->notify_stream,
+		 "\n" );
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "Read:\n" );
+
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\tNumber of blocks\t\t: %" PRIu64 " (%" PRIu64 " distinct)\n",
+	 hash_handle->number_of_blocks,
+	 hash_handle->number_of_distinct_blocks );
+
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\tRead size\t\t\t: %" PRIu64 " of %" PRIu64 " bytes\n",
+	 hash_handle->read_size,
+	 (uint64_t) number_of_stores * hash_handle->volume_size );
+
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\n" );
+
+	if( hash_handle_free_stores(
+	     hash_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free stores.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	hash_handle_free_stores(
+	 hash_handle,
+	 NULL );
+
+	return( -1 );
+}
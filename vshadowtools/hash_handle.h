@@ -0,0 +1,395 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _HASH_HANDLE_H )
+#define _HASH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libhmac.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define HASH_HANDLE_DIGEST_TYPE_MD5		0x01
+#define HASH_HANDLE_DIGEST_TYPE_SHA256		0x02
+
+typedef struct hash_block hash_block_t;
+
+/* A block of data that is hashed once per batch
+ */
+struct hash_block
+{
+	/* The (logical) offset of the block
+	 */
+	off64_t offset;
+
+	/* The physical offset of the block
+	 * or -1 if the block is not stored consecutively
+	 */
+	off64_t physical_offset;
+
+	/* The extent flags of the block
+	 */
+	uint32_t extent_flags;
+
+	/* The index of the store the block was read from
+	 */
+	int store_index;
+
+	/* The offset of the block data in the batch data
+	 */
+	size_t data_offset;
+
+	/* The block data size
+	 */
+	size_t data_size;
+
+	/* The MD5 hash of the block data
+	 */
+	uint8_t md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+
+	/* The SHA-256 hash of the block data
+	 */
+	uint8_t sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+};
+
+typedef struct hash_batch hash_batch_t;
+
+/* A batch of consecutive blocks of all stores
+ */
+struct hash_batch
+{
+	/* The (logical) offset of the first block
+	 */
+	off64_t offset;
+
+	/* The number of blocks per store
+	 */
+	int number_of_blocks;
+
+	/* The distinct blocks
+	 */
+	hash_block_t *blocks;
+
+	/* The number of distinct blocks
+	 */
+	int number_of_distinct_blocks;
+
+	/* The index of the distinct block of every block of every store
+	 */
+	int *block_indexes;
+
+	/* The distinct blocks hash table, contains the block index + 1 or 0 if not set
+	 */
+	int *hash_table;
+
+	/* The number of entries in the hash table, which is a power of 2
+	 */
+	int hash_table_size;
+
+	/* The block data
+	 */
+	uint8_t *data;
+
+	/* The allocated size of the block data
+	 */
+	size_t data_size;
+
+	/* The used size of the block data
+	 */
+	size_t used_data_size;
+};
+
+typedef struct hash_extent hash_extent_t;
+
+/* The most recently retrieved physical extent of a store
+ */
+struct hash_extent
+{
+	/* The (logical) offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The physical offset
+	 */
+	off64_t physical_offset;
+
+	/* The extent flags
+	 */
+	uint32_t flags;
+};
+
+typedef struct hash_handle hash_handle_t;
+
+struct hash_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The digest types
+	 */
+	uint8_t digest_types;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The number of blocks of a single store in a batch
+	 */
+	int number_of_blocks_per_batch;
+
+	/* Value to indicate the block hashes should be printed
+	 */
+	uint8_t print_block_hashes;
+
+	/* Value to indicate the unallocated clusters of the file system
+	 * should be hashed as zero-filled blocks
+	 */
+	uint8_t skip_unallocated;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libvshadow input volume
+	 */
+	libvshadow_volume_t *input_volume;
+
+	/* The volume size
+	 */
+	size64_t volume_size;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The stores
+	 */
+	libvshadow_store_t **stores;
+
+	/* The most recently retrieved extent of every store
+	 */
+	hash_extent_t *extents;
+
+	/* The MD5 contexts of the data of every store
+	 */
+	libhmac_md5_context_t **md5_contexts;
+
+	/* The SHA-256 contexts of the data of every store
+	 */
+	libhmac_sha256_context_t **sha256_contexts;
+
+	/* The MD5 contexts of the block hash list of every store
+	 */
+	libhmac_md5_context_t **md5_list_contexts;
+
+	/* The SHA-256 contexts of the block hash list of every store
+	 */
+	libhmac_sha256_context_t **sha256_list_contexts;
+
+	/* The batches, one is hashed while the other is read
+	 */
+	hash_batch_t *batches[ 2 ];
+
+	/* A block of 0-byte values used for sparse blocks
+	 */
+	uint8_t *zero_block;
+
+	/* The number of bytes read
+	 */
+	uint64_t read_size;
+
+	/* The number of blocks
+	 */
+	uint64_t number_of_blocks;
+
+	/* The number of distinct blocks
+	 */
+	uint64_t number_of_distinct_blocks;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+typedef struct hash_batch_task_arguments hash_batch_task_arguments_t;
+
+/* The arguments of the tasks that hash a batch
+ */
+struct hash_batch_task_arguments
+{
+	/* The hash handle
+	 */
+	hash_handle_t *hash_handle;
+
+	/* The batch
+	 */
+	hash_batch_t *batch;
+
+	/* The number of parts the batch is hashed in
+	 */
+	int number_of_parts;
+
+	/* The next batch
+	 */
+	hash_batch_t *next_batch;
+
+	/* The offset of the next batch
+	 */
+	off64_t next_offset;
+};
+
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_set_volume_offset(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_block_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_digest_types(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_number_of_threads(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int hash_handle_close(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_free_stores(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_batch_initialize(
+     hash_batch_t **batch,
+     int number_of_stores,
+     int number_of_blocks,
+     libcerror_error_t **error );
+
+int hash_batch_free(
+     hash_batch_t **batch,
+     libcerror_error_t **error );
+
+int hash_handle_get_block_index(
+     hash_handle_t *hash_handle,
+     hash_batch_t *batch,
+     int store_index,
+     off64_t offset,
+     size_t block_size,
+     int *block_index,
+     libcerror_error_t **error );
+
+int hash_handle_read_batch(
+     hash_handle_t *hash_handle,
+     hash_batch_t *batch,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int hash_handle_hash_batch_part(
+     hash_handle_t *hash_handle,
+     hash_batch_t *batch,
+     int part_index,
+     int number_of_parts,
+     libcerror_error_t **error );
+
+int hash_handle_hash_batch_task_callback(
+     int task_index,
+     hash_batch_task_arguments_t *task_arguments );
+
+int hash_handle_hash_batch(
+     hash_handle_t *hash_handle,
+     hash_batch_t *batch,
+     hash_batch_t *next_batch,
+     off64_t next_offset,
+     libcerror_error_t **error );
+
+int hash_handle_finalize_batch(
+     hash_handle_t *hash_handle,
+     hash_batch_t *batch,
+     libcerror_error_t **error );
+
+int hash_handle_digest_hash_fprint(
+     hash_handle_t *hash_handle,
+     const uint8_t *digest_hash,
+     size_t digest_hash_size,
+     libcerror_error_t **error );
+
+int hash_handle_hash_stores(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _HASH_HANDLE_H ) */
+
@@ -499,6 +499,23 @@ int info_handle_open_input(
 	}
 	else if( result != 0 )
 	{
+		if( info_handle->show_phase_timing != 0 )
+		{
+			if( libvshadow_volume_set_phase_timing(
+			     info_handle->input_volume,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to enable phase timing.",
+				 function );
+
+				return( -1 );
+			}
+		}
 		if( libvshadow_volume_open_file_io_handle(
 		     info_handle->input_volume,
 		     info_handle->input_file_io_handle,
@@ -514,6 +531,21 @@ int info_handle_open_input(
 
 			return( -1 );
 		}
+		/* The information of all the stores is printed hence read all store headers at once
+		 */
+		if( libvshadow_volume_read_store_headers(
+		     info_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read store headers.",
+			 function );
+
+			return( -1 );
+		}
 	}
 	return( result );
 }
@@ -637,6 +669,198 @@ int info_handle_block_fprint(
 	return( 1 );
 }
 
+/* Prints the read statistics to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_statistics_fprint(
+     info_handle_t *info_handle,
+     const uint64_t *statistics_values,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_statistics_fprint";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics values.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tRead statistics:\n" );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tBlock tree lookups\t: %" PRIu64 "\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_BLOCK_TREE_LOOKUPS ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tChain reads\t\t: %" PRIu64 "\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_CHAIN_READS ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tMaximum chain depth\t: %" PRIu64 "\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_MAXIMUM_CHAIN_DEPTH ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tStore data\t\t: %" PRIu64 " bytes\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_STORE_DATA_SIZE ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tVolume data\t\t: %" PRIu64 " bytes\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_VOLUME_DATA_SIZE ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tZero-fill data\t\t: %" PRIu64 " bytes\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_ZERO_FILL_SIZE ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tOverlay data\t\t: %" PRIu64 " bytes\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_OVERLAY_DATA_SIZE ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tNumber of read calls\t: %" PRIu64 "\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_READ_CALLS ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tRead size\t\t: %" PRIu64 " bytes\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_READ_SIZE ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tLock wait time\t\t: %" PRIu64 " ns\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_LOCK_WAIT_TIME ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tIndex loads\t\t: %" PRIu64 "\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_LOADS ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t\tIndex evictions\t\t: %" PRIu64 "\n",
+	 statistics_values[ LIBVSHADOW_STATISTICS_VALUE_NUMBER_OF_INDEX_EVICTIONS ] );
+
+	return( 1 );
+}
+
+/* Prints the phase timing to a stream
+ * The phase timing of the store is printed if a store is provided
+ * otherwise the phase timing of the volume
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_phase_timing_fprint(
+     info_handle_t *info_handle,
+     libvshadow_volume_t *volume,
+     libvshadow_store_t *store,
+     libcerror_error_t **error )
+{
+	uint64_t timing_values[ LIBVSHADOW_NUMBER_OF_TIMING_VALUES ];
+
+	const char *phase_names[ LIBVSHADOW_NUMBER_OF_TIMING_PHASES ] = {
+		"Catalog read\t\t",
+		"Store header read\t",
+		"Bitmap parse\t\t",
+		"Block list parse\t",
+		"Tree insert\t\t",
+		"Index lookup\t\t",
+		"Physical IO\t\t" };
+
+	static char *function = "info_handle_phase_timing_fprint";
+	int phase             = 0;
+	int result            = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tPhase timing:\n" );
+
+	for( phase = 0;
+	     phase < LIBVSHADOW_NUMBER_OF_TIMING_PHASES;
+	     phase++ )
+	{
+		if( store != NULL )
+		{
+			result = libvshadow_store_get_phase_timing(
+			          store,
+			          phase,
+			          timing_values,
+			          LIBVSHADOW_NUMBER_OF_TIMING_VALUES,
+			          error );
+		}
+		else
+		{
+			result = libvshadow_volume_get_phase_timing(
+			          volume,
+			          phase,
+			          timing_values,
+			          LIBVSHADOW_NUMBER_OF_TIMING_VALUES,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve phase: %d timing.",
+			 function,
+			 phase );
+
+			return( -1 );
+		}
+		if( timing_values[ LIBVSHADOW_TIMING_VALUE_NUMBER_OF_SAMPLES ] == 0 )
+		{
+			continue;
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t\t%s: %" PRIu64 " samples, total: %" PRIu64 " ns, p50: %" PRIu64 " ns, p99: %" PRIu64 " ns, p999: %" PRIu64 " ns, maximum: %" PRIu64 " ns\n",
+		 phase_names[ phase ],
+		 timing_values[ LIBVSHADOW_TIMING_VALUE_NUMBER_OF_SAMPLES ],
+		 timing_values[ LIBVSHADOW_TIMING_VALUE_TOTAL_TIME ],
+		 timing_values[ LIBVSHADOW_TIMING_VALUE_P50_TIME ],
+		 timing_values[ LIBVSHADOW_TIMING_VALUE_P99_TIME ],
+		 timing_values[ LIBVSHADOW_TIMING_VALUE_P999_TIME ],
+		 timing_values[ LIBVSHADOW_TIMING_VALUE_MAXIMUM_TIME ] );
+	}
+	return( 1 );
+}
+
 /* Prints the store information to a stream
  * Returns 1 if successful or -1 on error
  */
@@ -649,6 +873,7 @@ int info_handle_store_fprint(
 	system_character_t byte_size_string[ 16 ];
 	system_character_t filetime_string[ 32 ];
 	system_character_t guid_string[ 48 ];
+	uint64_t statistics_values[ LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES ];
 	uint8_t guid_buffer[ 16 ];
 
 	libfdatetime_filetime_t *filetime = NULL;
@@ -1138,6 +1363,43 @@ int info_handle_store_fprint(
 			}
 		}
 	}
+	if( info_handle->show_statistics != 0 )
+	{
+		if( libvshadow_store_get_statistics(
+		     store,
+		     statistics_values,
+		     LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d statistics.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( info_handle_statistics_fprint(
+		     info_handle,
+		     statistics_values,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( info_handle->show_phase_timing != 0 )
+	{
+		if( info_handle_phase_timing_fprint(
+		     info_handle,
+		     NULL,
+		     store,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
 	fprintf(
 	 info_handle->notify_stream,
 	 "\n" );
@@ -1166,6 +1428,325 @@ on_error:
 	return( -1 );
 }
 
+/* Prints the changed store numbers of a block range to a stream
+ */
+void info_handle_changed_stores_fprint(
+      info_handle_t *info_handle,
+      const int *store_indexes,
+      int number_of_changed_stores )
+{
+	int store_index = 0;
+
+	if( info_handle == NULL )
+	{
+		return;
+	}
+	if( store_indexes == NULL )
+	{
+		return;
+	}
+	for( store_index = 0;
+	     store_index < number_of_changed_stores;
+	     store_index++ )
+	{
+		if( store_index > 0 )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 ", " );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "%d",
+		 store_indexes[ store_index ] + 1 );
+	}
+}
+
+/* Prints the block change timeline to a stream
+ * Consecutive changed blocks that were changed in the same stores are printed as a single range
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_block_timeline_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	uint64_t *number_of_blocks_per_number_of_stores = NULL;
+	int *range_store_indexes                        = NULL;
+	int *store_indexes                              = NULL;
+	static char *function                           = "info_handle_block_timeline_fprint";
+	off64_t block_offset                            = 0;
+	off64_t range_end_offset                        = 0;
+	off64_t range_start_offset                      = 0;
+	int changed_block_index                         = 0;
+	int number_of_changed_blocks                    = 0;
+	int number_of_changed_stores                    = 0;
+	int number_of_range_stores                      = -1;
+	int number_of_stores                            = 0;
+	int store_index                                 = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_number_of_stores(
+	     info_handle->input_volume,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_get_number_of_changed_blocks(
+	     info_handle->input_volume,
+	     &number_of_changed_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of changed blocks.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Block change timeline:\n" );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tNumber of changed blocks:\t%d\n",
+	 number_of_changed_blocks );
+
+	if( ( number_of_stores <= 0 )
+	 || ( number_of_changed_blocks <= 0 ) )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
+
+		return( 1 );
+	}
+	store_indexes = (int *) memory_allocate(
+	                         sizeof( int ) * number_of_stores );
+
+	if( store_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create store indexes.",
+		 function );
+
+		goto on_error;
+	}
+	range_store_indexes = (int *) memory_allocate(
+	                               sizeof( int ) * number_of_stores );
+
+	if( range_store_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create range store indexes.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_blocks_per_number_of_stores = (uint64_t *) memory_allocate(
+	                                                      sizeof( uint64_t ) * ( number_of_stores + 1 ) );
+
+	if( number_of_blocks_per_number_of_stores == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create number of blocks per number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     number_of_blocks_per_number_of_stores,
+	     0,
+	     sizeof( uint64_t ) * ( number_of_stores + 1 ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear number of blocks per number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tChanged ranges:\n" );
+
+	for( changed_block_index = 0;
+	     changed_block_index < number_of_changed_blocks;
+	     changed_block_index++ )
+	{
+		if( info_handle->abort != 0 )
+		{
+			break;
+		}
+		if( libvshadow_volume_get_changed_block_by_index(
+		     info_handle->input_volume,
+		     changed_block_index,
+		     &block_offset,
+		     store_indexes,
+		     number_of_stores,
+		     &number_of_changed_stores,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve changed block: %d.",
+			 function,
+			 changed_block_index );
+
+			goto on_error;
+		}
+		number_of_blocks_per_number_of_stores[ number_of_changed_stores ] += 1;
+
+		if( ( block_offset == range_end_offset )
+		 && ( number_of_changed_stores == number_of_range_stores )
+		 && ( memory_compare(
+		       store_indexes,
+		       range_store_indexes,
+		       sizeof( int ) * number_of_changed_stores ) == 0 ) )
+		{
+			range_end_offset += 0x4000;
+
+			continue;
+		}
+		if( number_of_range_stores >= 0 )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "\t\t0x%08" PRIx64 " - 0x%08" PRIx64 " (%" PRIu64 " bytes)\t: stores ",
+			 range_start_offset,
+			 range_end_offset,
+			 (uint64_t) ( range_end_offset - range_start_offset ) );
+
+			info_handle_changed_stores_fprint(
+			 info_handle,
+			 range_store_indexes,
+			 number_of_range_stores );
+
+			fprintf(
+			 info_handle->notify_stream,
+			 "\n" );
+		}
+		if( memory_copy(
+		     range_store_indexes,
+		     store_indexes,
+		     sizeof( int ) * number_of_changed_stores ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy range store indexes.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_range_stores = number_of_changed_stores;
+		range_start_offset     = block_offset;
+		range_end_offset       = block_offset + 0x4000;
+	}
+	if( number_of_range_stores >= 0 )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t\t0x%08" PRIx64 " - 0x%08" PRIx64 " (%" PRIu64 " bytes)\t: stores ",
+		 range_start_offset,
+		 range_end_offset,
+		 (uint64_t) ( range_end_offset - range_start_offset ) );
+
+		info_handle_changed_stores_fprint(
+		 info_handle,
+		 range_store_indexes,
+		 number_of_range_stores );
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tChanged blocks per number of stores:\n" );
+
+	for( store_index = 1;
+	     store_index <= number_of_stores;
+	     store_index++ )
+	{
+		if( number_of_blocks_per_number_of_stores[ store_index ] == 0 )
+		{
+			continue;
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t\t%d store(s)\t\t: %" PRIu64 "\n",
+		 store_index,
+		 number_of_blocks_per_number_of_stores[ store_index ] );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	memory_free(
+	 number_of_blocks_per_number_of_stores );
+
+	memory_free(
+	 range_store_indexes );
+
+	memory_free(
+	 store_indexes );
+
+	return( 1 );
+
+on_error:
+	if( number_of_blocks_per_number_of_stores != NULL )
+	{
+		memory_free(
+		 number_of_blocks_per_number_of_stores );
+	}
+	if( range_store_indexes != NULL )
+	{
+		memory_free(
+		 range_store_indexes );
+	}
+	if( store_indexes != NULL )
+	{
+		memory_free(
+		 store_indexes );
+	}
+	return( -1 );
+}
+
 /* Prints the volume information to a stream
  * Returns 1 if successful or -1 on error
  */
@@ -1173,6 +1754,8 @@ int info_handle_volume_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error )
 {
+	uint64_t statistics_values[ LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES ];
+
 	libvshadow_store_t *store = NULL;
 	static char *function     = "vshadowinfo_volume_info_fprint";
 	int number_of_stores      = 0;
@@ -1259,6 +1842,65 @@ int info_handle_volume_fprint(
 			goto on_error;
 		}
 	}
+	if( ( info_handle->show_statistics != 0 )
+	 || ( info_handle->show_phase_timing != 0 ) )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "Volume:\n" );
+	}
+	if( info_handle->show_statistics != 0 )
+	{
+		if( libvshadow_volume_get_statistics(
+		     info_handle->input_volume,
+		     statistics_values,
+		     LIBVSHADOW_NUMBER_OF_STATISTICS_VALUES,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve volume statistics.",
+			 function );
+
+			goto on_error;
+		}
+		if( info_handle_statistics_fprint(
+		     info_handle,
+		     statistics_values,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( info_handle->show_phase_timing != 0 )
+	{
+		if( info_handle_phase_timing_fprint(
+		     info_handle,
+		     info_handle->input_volume,
+		     NULL,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( ( info_handle->show_statistics != 0 )
+	 || ( info_handle->show_phase_timing != 0 ) )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
+	}
+	if( info_handle->show_block_timeline != 0 )
+	{
+		if( info_handle_block_timeline_fprint(
+		     info_handle,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -54,6 +54,18 @@ struct info_handle
 	 */
 	uint8_t show_allocation_information;
 
+	/* Value to indicate the read statistics should be printed
+	 */
+	uint8_t show_statistics;
+
+	/* Value to indicate the phase timing should be printed
+	 */
+	uint8_t show_phase_timing;
+
+	/* Value to indicate the block change timeline should be printed
+	 */
+	uint8_t show_block_timeline;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -101,12 +113,32 @@ int info_handle_block_fprint(
      libvshadow_block_t *block,
      libcerror_error_t **error );
 
+int info_handle_statistics_fprint(
+     info_handle_t *info_handle,
+     const uint64_t *statistics_values,
+     libcerror_error_t **error );
+
+int info_handle_phase_timing_fprint(
+     info_handle_t *info_handle,
+     libvshadow_volume_t *volume,
+     libvshadow_store_t *store,
+     libcerror_error_t **error );
+
 int info_handle_store_fprint(
      info_handle_t *info_handle,
      int store_index,
      libvshadow_store_t *store,
      libcerror_error_t **error );
 
+void info_handle_changed_stores_fprint(
+      info_handle_t *info_handle,
+      const int *store_indexes,
+      int number_of_changed_stores );
+
+int info_handle_block_timeline_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 int info_handle_volume_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
@@ -425,6 +425,64 @@ int mount_handle_set_volume_offset(
 	return( 1 );
 }
 
+/* Sets the index memory limit
+ * The string contains the limit in MiB
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_index_memory_limit(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_index_memory_limit";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > ( (uint64_t) INT64_MAX >> 20 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid index memory limit value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->index_memory_limit = (size64_t) value_64bit << 20;
+
+	return( 1 );
+}
+
 /* Opens the mount handle
  * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
  */
@@ -506,6 +564,37 @@ int mount_handle_open_input(
 	}
 	else if( result != 0 )
 	{
+		if( mount_handle->phase_timing != 0 )
+		{
+			if( libvshadow_volume_set_phase_timing(
+			     mount_handle->input_volume,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to enable phase timing.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libvshadow_volume_set_index_memory_limit(
+		     mount_handle->input_volume,
+		     mount_handle->index_memory_limit,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set index memory limit.",
+			 function );
+
+			return( -1 );
+		}
 		if( libvshadow_volume_open_file_io_handle(
 		     mount_handle->input_volume,
 		     mount_handle->input_file_io_handle,
@@ -830,6 +919,101 @@ int mount_handle_get_size(
 	return( 1 );
 }
 
+/* Prints the phase timing of the inputs to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_phase_timing_fprint(
+     mount_handle_t *mount_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	uint64_t timing_values[ LIBVSHADOW_NUMBER_OF_TIMING_VALUES ];
+
+	const char *phase_names[ LIBVSHADOW_NUMBER_OF_TIMING_PHASES ] = {
+		"catalog read",
+		"store header read",
+		"bitmap parse",
+		"block list parse",
+		"tree insert",
+		"index lookup",
+		"physical IO" };
+
+	static char *function = "mount_handle_phase_timing_fprint";
+	int phase             = 0;
+	int store_index       = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->inputs == NULL )
+	{
+		return( 1 );
+	}
+	for( store_index = 0;
+	     store_index < mount_handle->number_of_inputs;
+	     store_index++ )
+	{
+		for( phase = 0;
+		     phase < LIBVSHADOW_NUMBER_OF_TIMING_PHASES;
+		     phase++ )
+		{
+			if( libvshadow_store_get_phase_timing(
+			     mount_handle->inputs[ store_index ],
+			     phase,
+			     timing_values,
+			     LIBVSHADOW_NUMBER_OF_TIMING_VALUES,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve input: %d phase: %d timing.",
+				 function,
+				 store_index,
+				 phase );
+
+				return( -1 );
+			}
+			if( timing_values[ LIBVSHADOW_TIMING_VALUE_NUMBER_OF_SAMPLES ] == 0 )
+			{
+				continue;
+			}
+			fprintf(
+			 stream,
+			 "vss%d %s: %" PRIu64 " samples, total: %" PRIu64 " ns, p50: %" PRIu64 " ns, p99: %" PRIu64 " ns, p999: %" PRIu64 " ns, maximum: %" PRIu64 " ns\n",
+			 store_index + 1,
+			 phase_names[ phase ],
+			 timing_values[ LIBVSHADOW_TIMING_VALUE_NUMBER_OF_SAMPLES ],
+			 timing_values[ LIBVSHADOW_TIMING_VALUE_TOTAL_TIME ],
+			 timing_values[ LIBVSHADOW_TIMING_VALUE_P50_TIME ],
+			 timing_values[ LIBVSHADOW_TIMING_VALUE_P99_TIME ],
+			 timing_values[ LIBVSHADOW_TIMING_VALUE_P999_TIME ],
+			 timing_values[ LIBVSHADOW_TIMING_VALUE_MAXIMUM_TIME ] );
+		}
+	}
+	return( 1 );
+}
+
 /* Retrieves the number of inputs of the input volume
  * Returns 1 if successful or -1 on error
  */
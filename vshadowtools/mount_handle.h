@@ -58,6 +58,14 @@ struct mount_handle
 	 */
 	int number_of_inputs;
 
+	/* Value to indicate the phase timing should be enabled
+	 */
+	uint8_t phase_timing;
+
+	/* The index memory limit
+	 */
+	size64_t index_memory_limit;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -90,6 +98,11 @@ int mount_handle_set_volume_offset(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int mount_handle_set_index_memory_limit(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int mount_handle_open_input(
      mount_handle_t *mount_handle,
      const system_character_t *filename,
@@ -118,6 +131,11 @@ int mount_handle_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+int mount_handle_phase_timing_fprint(
+     mount_handle_t *mount_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 int mount_handle_get_number_of_inputs(
      mount_handle_t *mount_handle,
      int *number_of_inputs,
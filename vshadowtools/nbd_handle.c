@@ -0,0 +1,3949 @@
+/*
+ * Network Block Device (NBD) handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#if defined( HAVE_SYS_UN_H )
+#include <sys/un.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "nbd_handle.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+extern \
+int libvshadow_volume_open_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libvshadow_error_t **error );
+
+extern \
+int libvshadow_check_volume_signature_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+extern \
+ssize_t libvshadow_store_read_buffer_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         libvshadow_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
+#define NBD_HANDLE_NOTIFY_STREAM			stdout
+
+#define NBD_HANDLE_DEFAULT_NUMBER_OF_CONNECTIONS	16
+#define NBD_HANDLE_MAXIMUM_NUMBER_OF_CONNECTIONS	64
+
+/* The maximum size of the data of an option during negotiation
+ */
+#define NBD_HANDLE_MAXIMUM_OPTION_DATA_SIZE		4096
+
+/* The block sizes advertised to the client, the maximum block size
+ * is the maximum length of a read request
+ */
+#define NBD_HANDLE_MINIMUM_BLOCK_SIZE			1
+#define NBD_HANDLE_PREFERRED_BLOCK_SIZE			4096
+#define NBD_HANDLE_MAXIMUM_BLOCK_SIZE			( 32 * 1024 * 1024 )
+
+/* The maximum number of descriptors in a block status reply
+ */
+#define NBD_HANDLE_MAXIMUM_NUMBER_OF_DESCRIPTORS	4096
+
+/* The identifier of the base:allocation meta context
+ */
+#define NBD_HANDLE_ALLOCATION_CONTEXT_IDENTIFIER	1
+
+/* The values of the NBD protocol, see:
+ * https://github.com/NetworkBlockDevice/nbd/blob/master/doc/proto.md
+ */
+#define NBD_MAGIC					0x4e42444d41474943ULL
+#define NBD_OPTION_MAGIC				0x49484156454f5054ULL
+#define NBD_OPTION_REPLY_MAGIC				0x0003e889045565a9ULL
+#define NBD_REQUEST_MAGIC				0x25609513UL
+#define NBD_SIMPLE_REPLY_MAGIC				0x67446698UL
+#define NBD_STRUCTURED_REPLY_MAGIC			0x668e33efUL
+
+#define NBD_FLAG_FIXED_NEWSTYLE				0x0001
+#define NBD_FLAG_NO_ZEROES				0x0002
+
+#define NBD_FLAG_HAS_FLAGS				0x0001
+#define NBD_FLAG_READ_ONLY				0x0002
+#define NBD_FLAG_CAN_MULTI_CONN				0x0100
+
+#define NBD_OPTION_EXPORT_NAME				1
+#define NBD_OPTION_ABORT				2
+#define NBD_OPTION_LIST					3
+#define NBD_OPTION_INFO					6
+#define NBD_OPTION_GO					7
+#define NBD_OPTION_STRUCTURED_REPLY			8
+#define NBD_OPTION_LIST_META_CONTEXT			9
+#define NBD_OPTION_SET_META_CONTEXT			10
+
+#define NBD_REPLY_ACK					1
+#define NBD_REPLY_SERVER				2
+#define NBD_REPLY_INFO					3
+#define NBD_REPLY_META_CONTEXT				4
+#define NBD_REPLY_ERROR_UNSUPPORTED			0x80000001UL
+#define NBD_REPLY_ERROR_INVALID				0x80000003UL
+#define NBD_REPLY_ERROR_UNKNOWN				0x80000006UL
+
+#define NBD_INFO_EXPORT					0
+#define NBD_INFO_BLOCK_SIZE				3
+
+#define NBD_COMMAND_READ				0
+#define NBD_COMMAND_WRITE				1
+#define NBD_COMMAND_DISCONNECT				2
+#define NBD_COMMAND_FLUSH				3
+#define NBD_COMMAND_TRIM				4
+#define NBD_COMMAND_WRITE_ZEROES			6
+#define NBD_COMMAND_BLOCK_STATUS			7
+
+#define NBD_COMMAND_FLAG_REQUEST_ONE			0x0008
+
+#define NBD_REPLY_FLAG_DONE				0x0001
+
+#define NBD_REPLY_TYPE_NONE				0
+#define NBD_REPLY_TYPE_OFFSET_DATA			1
+#define NBD_REPLY_TYPE_OFFSET_HOLE			2
+#define NBD_REPLY_TYPE_BLOCK_STATUS			5
+#define NBD_REPLY_TYPE_ERROR				0x8001
+
+#define NBD_STATE_HOLE					0x00000001UL
+#define NBD_STATE_ZERO					0x00000002UL
+
+#define NBD_ERROR_PERMISSION				1
+#define NBD_ERROR_IO					5
+#define NBD_ERROR_INVALID				22
+
+#define NBD_HANDLE_EXPORT_NAME_PREFIX			"vss"
+#define NBD_HANDLE_EXPORT_NAME_PREFIX_LENGTH		3
+
+#define NBD_HANDLE_ALLOCATION_CONTEXT_NAME		"base:allocation"
+#define NBD_HANDLE_ALLOCATION_CONTEXT_NAME_LENGTH	15
+
+#if defined( NBD_HANDLE_HAVE_UNIX_SOCKETS )
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "vshadowtools_system_string_copy_from_64_bit_in_decimal";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Creates a connection
+ * Make sure the value connection is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_initialize(
+     nbd_connection_t **connection,
+     nbd_handle_t *nbd_handle,
+     int socket_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_initialize";
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *connection != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid connection value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*connection = memory_allocate_structure(
+	               nbd_connection_t );
+
+	if( *connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create connection.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *connection,
+	     0,
+	     sizeof( nbd_connection_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear connection.",
+		 function );
+
+		goto on_error;
+	}
+	( *connection )->nbd_handle        = nbd_handle;
+	( *connection )->socket_descriptor = socket_descriptor;
+	( *connection )->store_index       = -1;
+
+	return( 1 );
+
+on_error:
+	if( *connection != NULL )
+	{
+		memory_free(
+		 *connection );
+
+		*connection = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a connection
+ * The socket of the connection is closed
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_free(
+     nbd_connection_t **connection,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_free";
+	int result            = 1;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *connection != NULL )
+	{
+		if( ( *connection )->socket_descriptor != -1 )
+		{
+			if( close(
+			     ( *connection )->socket_descriptor ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close socket.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *connection )->store != NULL )
+		{
+			if( libvshadow_store_free(
+			     &( ( *connection )->store ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free store.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *connection )->file_io_handle != NULL )
+		{
+			if( libbfio_handle_close(
+			     ( *connection )->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+			if( libbfio_handle_free(
+			     &( ( *connection )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *connection )->buffer != NULL )
+		{
+			memory_free(
+			 ( *connection )->buffer );
+		}
+		memory_free(
+		 *connection );
+
+		*connection = NULL;
+	}
+	return( result );
+}
+
+/* Reads data from the socket of the connection
+ * Returns 1 if successful, 0 if the connection was closed or -1 on error
+ */
+int nbd_connection_read(
+     nbd_connection_t *connection,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_read";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		read_count = recv(
+		              connection->socket_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              size - buffer_offset,
+		              0 );
+
+		if( read_count == 0 )
+		{
+			return( 0 );
+		}
+		else if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			/* A socket that was shut down to abort is considered closed
+			 */
+			if( connection->nbd_handle->abort != 0 )
+			{
+				return( 0 );
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from socket with error: %d.",
+			 function,
+			 errno );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Writes data to the socket of the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write(
+     nbd_connection_t *connection,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_write";
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+	int flags             = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( MSG_NOSIGNAL )
+	/* A client that disconnects should not terminate the server with SIGPIPE
+	 */
+	flags = MSG_NOSIGNAL;
+#endif
+	while( buffer_offset < size )
+	{
+		write_count = send(
+		               connection->socket_descriptor,
+		               &( buffer[ buffer_offset ] ),
+		               size - buffer_offset,
+		               flags );
+
+		if( write_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to socket with error: %d.",
+			 function,
+			 errno );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Resizes the data buffer of the connection if needed
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_resize_buffer(
+     nbd_connection_t *connection,
+     size_t size,
+     libcerror_error_t **error )
+{
+	void *reallocation    = NULL;
+	static char *function = "nbd_connection_resize_buffer";
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > connection->buffer_size )
+	{
+		reallocation = memory_reallocate(
+		                connection->buffer,
+		                sizeof( uint8_t ) * size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize buffer.",
+			 function );
+
+			return( -1 );
+		}
+		connection->buffer      = (uint8_t *) reallocation;
+		connection->buffer_size = size;
+	}
+	return( 1 );
+}
+
+/* Retrieves the index of the store of an export name
+ * The name of an export is vss followed by the store number
+ * Returns 1 if successful, 0 if no such export or -1 on error
+ */
+int nbd_connection_get_store_index_by_export_name(
+     nbd_connection_t *connection,
+     const uint8_t *export_name,
+     size_t export_name_length,
+     int *store_index,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_get_store_index_by_export_name";
+	size_t name_index     = 0;
+	int store_number      = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export name.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_name_length <= NBD_HANDLE_EXPORT_NAME_PREFIX_LENGTH )
+	 || ( export_name_length > ( NBD_HANDLE_EXPORT_NAME_PREFIX_LENGTH + 4 ) ) )
+	{
+		return( 0 );
+	}
+	if( narrow_string_compare(
+	     (char *) export_name,
+	     NBD_HANDLE_EXPORT_NAME_PREFIX,
+	     NBD_HANDLE_EXPORT_NAME_PREFIX_LENGTH ) != 0 )
+	{
+		return( 0 );
+	}
+	for( name_index = NBD_HANDLE_EXPORT_NAME_PREFIX_LENGTH;
+	     name_index < export_name_length;
+	     name_index++ )
+	{
+		if( ( export_name[ name_index ] < (uint8_t) '0' )
+		 || ( export_name[ name_index ] > (uint8_t) '9' ) )
+		{
+			return( 0 );
+		}
+		store_number *= 10;
+		store_number += export_name[ name_index ] - (uint8_t) '0';
+	}
+	if( ( store_number == 0 )
+	 || ( store_number > connection->nbd_handle->number_of_stores ) )
+	{
+		return( 0 );
+	}
+	*store_index = store_number - 1;
+
+	return( 1 );
+}
+
+/* Opens the export the client selected
+ * Every connection uses its own store and file IO handle so that reads
+ * of different connections do not contend for the current offset
+ * Returns 1 if successful, 0 if no such export or -1 on error
+ */
+int nbd_connection_open_export(
+     nbd_connection_t *connection,
+     const uint8_t *export_name,
+     size_t export_name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_open_export";
+	int result            = 0;
+	int store_index       = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( connection->store != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid connection - store value already set.",
+		 function );
+
+		return( -1 );
+	}
+	result = nbd_connection_get_store_index_by_export_name(
+	          connection,
+	          export_name,
+	          export_name_length,
+	          &store_index,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	if( libvshadow_volume_get_store(
+	     connection->nbd_handle->input_volume,
+	     store_index,
+	     &( connection->store ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+	if( libbfio_handle_clone(
+	     &( connection->file_io_handle ),
+	     connection->nbd_handle->input_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     connection->file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	connection->store_index = store_index;
+
+	return( 1 );
+
+on_error:
+	if( connection->file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( connection->file_io_handle ),
+		 NULL );
+	}
+	if( connection->store != NULL )
+	{
+		libvshadow_store_free(
+		 &( connection->store ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes an option reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_option_reply(
+     nbd_connection_t *connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 20 ];
+
+	static char *function = "nbd_connection_write_option_reply";
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( data_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_OPTION_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 (uint32_t) data_size );
+
+	if( nbd_connection_write(
+	     connection,
+	     reply_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write(
+		     connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Negotiates the options of the connection with the client
+ * Only the fixed newstyle negotiation is supported
+ * Returns 1 if the transmission phase was entered, 0 if the client ended the negotiation or -1 on error
+ */
+int nbd_connection_negotiate(
+     nbd_connection_t *connection,
+     libcerror_error_t **error )
+{
+	uint8_t option_data[ NBD_HANDLE_MAXIMUM_OPTION_DATA_SIZE ];
+	uint8_t reply_data[ 256 ];
+
+	static char *function                   = "nbd_connection_negotiate";
+	const uint8_t *export_name              = NULL;
+	size_t export_name_length               = 0;
+	size_t option_data_offset               = 0;
+	size_t reply_data_size                  = 0;
+	uint64_t value_64bit                    = 0;
+	uint32_t client_flags                   = 0;
+	uint32_t number_of_queries              = 0;
+	uint32_t option                         = 0;
+	uint32_t option_data_size               = 0;
+	uint32_t query_length                   = 0;
+	uint16_t number_of_information_requests = 0;
+	uint16_t transmission_flags             = 0;
+	uint8_t context_matched                 = 0;
+	int result                              = 0;
+	int store_index                         = 0;
+	int store_number                        = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	transmission_flags = NBD_FLAG_HAS_FLAGS | NBD_FLAG_READ_ONLY | NBD_FLAG_CAN_MULTI_CONN;
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_data[ 0 ] ),
+	 NBD_MAGIC );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_data[ 8 ] ),
+	 NBD_OPTION_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply_data[ 16 ] ),
+	 NBD_FLAG_FIXED_NEWSTYLE | NBD_FLAG_NO_ZEROES );
+
+	if( nbd_connection_write(
+	     connection,
+	     reply_data,
+	     18,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write handshake.",
+		 function );
+
+		return( -1 );
+	}
+	result = nbd_connection_read(
+	          connection,
+	          option_data,
+	          4,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 option_data,
+	 client_flags );
+
+	if( ( client_flags & ~( (uint32_t) NBD_FLAG_FIXED_NEWSTYLE | NBD_FLAG_NO_ZEROES ) ) != 0 )
+	{
+		return( 0 );
+	}
+	if( ( client_flags & NBD_FLAG_NO_ZEROES ) != 0 )
+	{
+		connection->no_zeroes = 1;
+	}
+	while( connection->nbd_handle->abort == 0 )
+	{
+		result = nbd_connection_read(
+		          connection,
+		          option_data,
+		          16,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+		byte_stream_copy_to_uint64_big_endian(
+		 &( option_data[ 0 ] ),
+		 value_64bit );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_data[ 8 ] ),
+		 option );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_data[ 12 ] ),
+		 option_data_size );
+
+		if( ( value_64bit != NBD_OPTION_MAGIC )
+		 || ( option_data_size > NBD_HANDLE_MAXIMUM_OPTION_DATA_SIZE ) )
+		{
+			return( 0 );
+		}
+		if( option_data_size > 0 )
+		{
+			result = nbd_connection_read(
+			          connection,
+			          option_data,
+			          (size_t) option_data_size,
+			          error );
+
+			if( result != 1 )
+			{
+				return( result );
+			}
+		}
+		reply_data_size = 0;
+
+		switch( option )
+		{
+			case NBD_OPTION_EXPORT_NAME:
+				result = nbd_connection_open_export(
+				          connection,
+				          option_data,
+				          (size_t) option_data_size,
+				          error );
+
+				/* An unknown export can only be signalled by closing the connection
+				 */
+				if( result != 1 )
+				{
+					return( result );
+				}
+				byte_stream_copy_from_uint64_big_endian(
+				 &( reply_data[ 0 ] ),
+				 connection->nbd_handle->volume_size );
+
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 8 ] ),
+				 transmission_flags );
+
+				reply_data_size = 10;
+
+				if( connection->no_zeroes == 0 )
+				{
+					if( memory_set(
+					     &( reply_data[ 10 ] ),
+					     0,
+					     124 ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to clear reply data.",
+						 function );
+
+						return( -1 );
+					}
+					reply_data_size += 124;
+				}
+				if( nbd_connection_write(
+				     connection,
+				     reply_data,
+				     reply_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write export name reply.",
+					 function );
+
+					return( -1 );
+				}
+				return( 1 );
+
+			case NBD_OPTION_ABORT:
+				if( nbd_connection_write_option_reply(
+				     connection,
+				     option,
+				     NBD_REPLY_ACK,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write abort reply.",
+					 function );
+
+					return( -1 );
+				}
+				return( 0 );
+
+			case NBD_OPTION_LIST:
+				if( option_data_size != 0 )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				for( store_number = 1;
+				     store_number <= connection->nbd_handle->number_of_stores;
+				     store_number++ )
+				{
+					export_name_length = (size_t) narrow_string_snprintf(
+					                               (char *) &( reply_data[ 4 ] ),
+					                               16,
+					                               "%s%d",
+					                               NBD_HANDLE_EXPORT_NAME_PREFIX,
+					                               store_number );
+
+					byte_stream_copy_from_uint32_big_endian(
+					 &( reply_data[ 0 ] ),
+					 (uint32_t) export_name_length );
+
+					if( nbd_connection_write_option_reply(
+					     connection,
+					     option,
+					     NBD_REPLY_SERVER,
+					     reply_data,
+					     4 + export_name_length,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_WRITE_FAILED,
+						 "%s: unable to write list reply.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				result = nbd_connection_write_option_reply(
+				          connection,
+				          option,
+				          NBD_REPLY_ACK,
+				          NULL,
+				          0,
+				          error );
+				break;
+
+			case NBD_OPTION_INFO:
+			case NBD_OPTION_GO:
+				if( option_data_size < 6 )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				byte_stream_copy_to_uint32_big_endian(
+				 &( option_data[ 0 ] ),
+				 export_name_length );
+
+				if( export_name_length > ( (size_t) option_data_size - 6 ) )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				export_name = &( option_data[ 4 ] );
+
+				byte_stream_copy_to_uint16_big_endian(
+				 &( option_data[ 4 + export_name_length ] ),
+				 number_of_information_requests );
+
+				/* The information requests are ignored since the server always
+				 * provides the export and block size information
+				 */
+				if( ( (size_t) option_data_size - 6 - export_name_length ) != ( 2 * (size_t) number_of_information_requests ) )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				if( option == NBD_OPTION_GO )
+				{
+					result = nbd_connection_open_export(
+					          connection,
+					          export_name,
+					          export_name_length,
+					          error );
+				}
+				else
+				{
+					result = nbd_connection_get_store_index_by_export_name(
+					          connection,
+					          export_name,
+					          export_name_length,
+					          &store_index,
+					          error );
+				}
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to open export.",
+					 function );
+
+					return( -1 );
+				}
+				else if( result == 0 )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REPLY_ERROR_UNKNOWN,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 0 ] ),
+				 NBD_INFO_EXPORT );
+
+				byte_stream_copy_from_uint64_big_endian(
+				 &( reply_data[ 2 ] ),
+				 connection->nbd_handle->volume_size );
+
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 10 ] ),
+				 transmission_flags );
+
+				if( nbd_connection_write_option_reply(
+				     connection,
+				     option,
+				     NBD_REPLY_INFO,
+				     reply_data,
+				     12,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write export information reply.",
+					 function );
+
+					return( -1 );
+				}
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 0 ] ),
+				 NBD_INFO_BLOCK_SIZE );
+
+				byte_stream_copy_from_uint32_big_endian(
+				 &( reply_data[ 2 ] ),
+				 NBD_HANDLE_MINIMUM_BLOCK_SIZE );
+
+				byte_stream_copy_from_uint32_big_endian(
+				 &( reply_data[ 6 ] ),
+				 NBD_HANDLE_PREFERRED_BLOCK_SIZE );
+
+				byte_stream_copy_from_uint32_big_endian(
+				 &( reply_data[ 10 ] ),
+				 NBD_HANDLE_MAXIMUM_BLOCK_SIZE );
+
+				if( nbd_connection_write_option_reply(
+				     connection,
+				     option,
+				     NBD_REPLY_INFO,
+				     reply_data,
+				     14,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write block size information reply.",
+					 function );
+
+					return( -1 );
+				}
+				if( nbd_connection_write_option_reply(
+				     connection,
+				     option,
+				     NBD_REPLY_ACK,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write acknowledgement reply.",
+					 function );
+
+					return( -1 );
+				}
+				if( option == NBD_OPTION_GO )
+				{
+					return( 1 );
+				}
+				break;
+
+			case NBD_OPTION_STRUCTURED_REPLY:
+				if( option_data_size != 0 )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				connection->structured_replies = 1;
+
+				result = nbd_connection_write_option_reply(
+				          connection,
+				          option,
+				          NBD_REPLY_ACK,
+				          NULL,
+				          0,
+				          error );
+				break;
+
+			case NBD_OPTION_LIST_META_CONTEXT:
+			case NBD_OPTION_SET_META_CONTEXT:
+				/* Meta contexts require structured replies
+				 */
+				if( ( connection->structured_replies == 0 )
+				 || ( option_data_size < 8 ) )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				byte_stream_copy_to_uint32_big_endian(
+				 &( option_data[ 0 ] ),
+				 export_name_length );
+
+				if( export_name_length > ( (size_t) option_data_size - 8 ) )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				result = nbd_connection_get_store_index_by_export_name(
+				          connection,
+				          &( option_data[ 4 ] ),
+				          export_name_length,
+				          &store_index,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve store index of export.",
+					 function );
+
+					return( -1 );
+				}
+				else if( result == 0 )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REPLY_ERROR_UNKNOWN,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				option_data_offset = 4 + export_name_length;
+
+				byte_stream_copy_to_uint32_big_endian(
+				 &( option_data[ option_data_offset ] ),
+				 number_of_queries );
+
+				option_data_offset += 4;
+
+				/* Listing without queries returns every meta context
+				 */
+				if( ( option == NBD_OPTION_LIST_META_CONTEXT )
+				 && ( number_of_queries == 0 ) )
+				{
+					context_matched = 1;
+				}
+				else
+				{
+					context_matched = 0;
+				}
+				result = 1;
+
+				while( number_of_queries > 0 )
+				{
+					if( ( option_data_offset + 4 ) > (size_t) option_data_size )
+					{
+						result = 0;
+
+						break;
+					}
+					byte_stream_copy_to_uint32_big_endian(
+					 &( option_data[ option_data_offset ] ),
+					 query_length );
+
+					option_data_offset += 4;
+
+					if( query_length > ( (size_t) option_data_size - option_data_offset ) )
+					{
+						result = 0;
+
+						break;
+					}
+					/* When listing, the query base: selects every meta context of the base namespace
+					 */
+					if( ( ( query_length == NBD_HANDLE_ALLOCATION_CONTEXT_NAME_LENGTH )
+					  && ( memory_compare(
+					        &( option_data[ option_data_offset ] ),
+					        NBD_HANDLE_ALLOCATION_CONTEXT_NAME,
+					        NBD_HANDLE_ALLOCATION_CONTEXT_NAME_LENGTH ) == 0 ) )
+					 || ( ( option == NBD_OPTION_LIST_META_CONTEXT )
+					  && ( query_length == 5 )
+					  && ( memory_compare(
+					        &( option_data[ option_data_offset ] ),
+					        "base:",
+					        5 ) == 0 ) ) )
+					{
+						context_matched = 1;
+					}
+					option_data_offset += query_length;
+
+					number_of_queries--;
+				}
+				if( ( result == 0 )
+				 || ( option_data_offset != (size_t) option_data_size ) )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				if( context_matched != 0 )
+				{
+					byte_stream_copy_from_uint32_big_endian(
+					 &( reply_data[ 0 ] ),
+					 NBD_HANDLE_ALLOCATION_CONTEXT_IDENTIFIER );
+
+					if( memory_copy(
+					     &( reply_data[ 4 ] ),
+					     NBD_HANDLE_ALLOCATION_CONTEXT_NAME,
+					     NBD_HANDLE_ALLOCATION_CONTEXT_NAME_LENGTH ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy meta context name.",
+						 function );
+
+						return( -1 );
+					}
+					if( nbd_connection_write_option_reply(
+					     connection,
+					     option,
+					     NBD_REPLY_META_CONTEXT,
+					     reply_data,
+					     4 + NBD_HANDLE_ALLOCATION_CONTEXT_NAME_LENGTH,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_WRITE_FAILED,
+						 "%s: unable to write meta context reply.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				/* Only setting selects the meta context
+				 */
+				if( option == NBD_OPTION_SET_META_CONTEXT )
+				{
+					connection->allocation_context = context_matched;
+				}
+				result = nbd_connection_write_option_reply(
+				          connection,
+				          option,
+				          NBD_REPLY_ACK,
+				          NULL,
+				          0,
+				          error );
+				break;
+
+			default:
+				result = nbd_connection_write_option_reply(
+				          connection,
+				          option,
+				          NBD_REPLY_ERROR_UNSUPPORTED,
+				          NULL,
+				          0,
+				          error );
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 0 );
+}
+
+
+/* Writes a simple reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_simple_reply(
+     nbd_connection_t *connection,
+     uint64_t cookie,
+     uint32_t error_value,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 16 ];
+
+	static char *function = "nbd_connection_write_simple_reply";
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( data_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_SIMPLE_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 4 ] ),
+	 error_value );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 8 ] ),
+	 cookie );
+
+	if( nbd_connection_write(
+	     connection,
+	     reply_header,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write simple reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write(
+		     connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write simple reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a structured reply chunk
+ * The payload of the chunk consists of the header data followed by the data
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_structured_reply(
+     nbd_connection_t *connection,
+     uint64_t cookie,
+     uint16_t flags,
+     uint16_t reply_type,
+     const uint8_t *header_data,
+     size_t header_data_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 20 ];
+
+	static char *function = "nbd_connection_write_structured_reply";
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( header_data == NULL )
+	  &&  ( header_data_size != 0 ) )
+	 || ( ( data == NULL )
+	  &&  ( data_size != 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( header_data_size > (size_t) UINT32_MAX )
+	 || ( data_size > ( (size_t) UINT32_MAX - header_data_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_STRUCTURED_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply_header[ 4 ] ),
+	 flags );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply_header[ 6 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 8 ] ),
+	 cookie );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 (uint32_t) ( header_data_size + data_size ) );
+
+	if( nbd_connection_write(
+	     connection,
+	     reply_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write structured reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( header_data_size > 0 )
+	{
+		if( nbd_connection_write(
+		     connection,
+		     header_data,
+		     header_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write structured reply header data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write(
+		     connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write structured reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes an error reply
+ * A structured error chunk is used if structured replies were negotiated
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_error_reply(
+     nbd_connection_t *connection,
+     uint64_t cookie,
+     uint32_t error_value,
+     libcerror_error_t **error )
+{
+	uint8_t error_data[ 6 ];
+
+	static char *function = "nbd_connection_write_error_reply";
+	int result            = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( connection->structured_replies != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( error_data[ 0 ] ),
+		 error_value );
+
+		/* The error has no message
+		 */
+		byte_stream_copy_from_uint16_big_endian(
+		 &( error_data[ 4 ] ),
+		 0 );
+
+		result = nbd_connection_write_structured_reply(
+		          connection,
+		          cookie,
+		          NBD_REPLY_FLAG_DONE,
+		          NBD_REPLY_TYPE_ERROR,
+		          error_data,
+		          6,
+		          NULL,
+		          0,
+		          error );
+	}
+	else
+	{
+		result = nbd_connection_write_simple_reply(
+		          connection,
+		          cookie,
+		          error_value,
+		          NULL,
+		          0,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write error reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the extent of the export at a specific offset
+ * The extent is the range of data starting at the offset that is either sparse or not
+ * Consecutive physical extents of the store with the same state are combined
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_get_extent(
+     nbd_connection_t *connection,
+     off64_t offset,
+     size64_t maximum_size,
+     size64_t *extent_size,
+     uint8_t *is_sparse,
+     libcerror_error_t **error )
+{
+	static char *function        = "nbd_connection_get_extent";
+	size64_t physical_size       = 0;
+	off64_t physical_offset      = 0;
+	uint32_t extent_flags        = 0;
+	uint8_t physical_is_sparse   = 0;
+	int result                   = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_sparse == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is sparse.",
+		 function );
+
+		return( -1 );
+	}
+	*extent_size = 0;
+	*is_sparse   = 0;
+
+	while( *extent_size < maximum_size )
+	{
+		result = libvshadow_store_get_physical_extent(
+		          connection->store,
+		          offset + (off64_t) *extent_size,
+		          maximum_size - *extent_size,
+		          &physical_offset,
+		          &physical_size,
+		          &extent_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve physical extent at offset: %" PRIi64 ".",
+			 function,
+			 offset + (off64_t) *extent_size );
+
+			return( -1 );
+		}
+		/* Data beyond the end of the store data is read as 0-byte values
+		 */
+		if( ( result == 0 )
+		 || ( physical_size == 0 ) )
+		{
+			physical_size      = maximum_size - *extent_size;
+			physical_is_sparse = 1;
+		}
+		else if( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		{
+			physical_is_sparse = 1;
+		}
+		else
+		{
+			physical_is_sparse = 0;
+		}
+		if( *extent_size == 0 )
+		{
+			*is_sparse = physical_is_sparse;
+		}
+		else if( physical_is_sparse != *is_sparse )
+		{
+			break;
+		}
+		if( physical_size > ( maximum_size - *extent_size ) )
+		{
+			physical_size = maximum_size - *extent_size;
+		}
+		*extent_size += physical_size;
+	}
+	return( 1 );
+}
+
+/* Reads data of the export at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_read_data(
+     nbd_connection_t *connection,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_read_data";
+	ssize_t read_count    = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_seek_offset(
+	     connection->store,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	read_count = libvshadow_store_read_buffer_from_file_io_handle(
+	              connection->store,
+	              connection->file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count != (ssize_t) size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles a read request
+ * If structured replies were negotiated sparse ranges are replied as holes
+ * without reading them
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_read(
+     nbd_connection_t *connection,
+     uint64_t cookie,
+     off64_t offset,
+     uint32_t length,
+     libcerror_error_t **error )
+{
+	uint8_t header_data[ 12 ];
+
+	libcerror_error_t *read_error = NULL;
+	static char *function         = "nbd_connection_handle_read";
+	size64_t extent_size          = 0;
+	size_t read_size              = 0;
+	uint32_t remaining_length     = 0;
+	uint16_t reply_flags          = 0;
+	uint8_t is_sparse             = 0;
+	int result                    = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( length == 0 )
+	 || ( length > NBD_HANDLE_MAXIMUM_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( connection->structured_replies == 0 )
+	{
+		if( nbd_connection_resize_buffer(
+		     connection,
+		     (size_t) length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize buffer.",
+			 function );
+
+			return( -1 );
+		}
+		result = nbd_connection_read_data(
+		          connection,
+		          offset,
+		          connection->buffer,
+		          (size_t) length,
+		          &read_error );
+
+		if( result != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 read_error );
+			libcerror_error_free(
+			 &read_error );
+
+			result = nbd_connection_write_simple_reply(
+			          connection,
+			          cookie,
+			          NBD_ERROR_IO,
+			          NULL,
+			          0,
+			          error );
+		}
+		else
+		{
+			result = nbd_connection_write_simple_reply(
+			          connection,
+			          cookie,
+			          0,
+			          connection->buffer,
+			          (size_t) length,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write read reply.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	remaining_length = length;
+
+	while( remaining_length > 0 )
+	{
+		result = nbd_connection_get_extent(
+		          connection,
+		          offset,
+		          (size64_t) remaining_length,
+		          &extent_size,
+		          &is_sparse,
+		          &read_error );
+
+		if( result == 1 )
+		{
+			read_size = (size_t) extent_size;
+
+			if( is_sparse == 0 )
+			{
+				result = nbd_connection_resize_buffer(
+				          connection,
+				          read_size,
+				          &read_error );
+
+				if( result == 1 )
+				{
+					result = nbd_connection_read_data(
+					          connection,
+					          offset,
+					          connection->buffer,
+					          read_size,
+					          &read_error );
+				}
+			}
+		}
+		/* Chunks that were already sent remain valid, the error chunk ends the reply
+		 */
+		if( result != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 read_error );
+			libcerror_error_free(
+			 &read_error );
+
+			if( nbd_connection_write_error_reply(
+			     connection,
+			     cookie,
+			     NBD_ERROR_IO,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write error reply.",
+				 function );
+
+				return( -1 );
+			}
+			return( 1 );
+		}
+		remaining_length -= (uint32_t) read_size;
+
+		if( remaining_length == 0 )
+		{
+			reply_flags = NBD_REPLY_FLAG_DONE;
+		}
+		byte_stream_copy_from_uint64_big_endian(
+		 &( header_data[ 0 ] ),
+		 (uint64_t) offset );
+
+		if( is_sparse != 0 )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( header_data[ 8 ] ),
+			 (uint32_t) read_size );
+
+			result = nbd_connection_write_structured_reply(
+			          connection,
+			          cookie,
+			          reply_flags,
+			          NBD_REPLY_TYPE_OFFSET_HOLE,
+			          header_data,
+			          12,
+			          NULL,
+			          0,
+			          error );
+		}
+		else
+		{
+			result = nbd_connection_write_structured_reply(
+			          connection,
+			          cookie,
+			          reply_flags,
+			          NBD_REPLY_TYPE_OFFSET_DATA,
+			          header_data,
+			          8,
+			          connection->buffer,
+			          read_size,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write read reply chunk.",
+			 function );
+
+			return( -1 );
+		}
+		offset += (off64_t) read_size;
+	}
+	return( 1 );
+}
+
+/* Handles a block status request of the base:allocation meta context
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_block_status(
+     nbd_connection_t *connection,
+     uint64_t cookie,
+     uint16_t flags,
+     off64_t offset,
+     uint32_t length,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *status_error = NULL;
+	static char *function           = "nbd_connection_handle_block_status";
+	size64_t extent_size            = 0;
+	size64_t remaining_size         = 0;
+	size_t data_offset              = 0;
+	uint32_t extent_length          = 0;
+	uint32_t number_of_descriptors  = 0;
+	uint8_t is_sparse               = 0;
+	int result                      = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( length == 0 )
+	 || ( offset < 0 )
+	 || ( (size64_t) offset >= connection->nbd_handle->volume_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset or length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The buffer contains the context identifier followed by the descriptors
+	 */
+	if( nbd_connection_resize_buffer(
+	     connection,
+	     4 + ( 8 * NBD_HANDLE_MAXIMUM_NUMBER_OF_DESCRIPTORS ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize buffer.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( connection->buffer[ 0 ] ),
+	 NBD_HANDLE_ALLOCATION_CONTEXT_IDENTIFIER );
+
+	data_offset = 4;
+
+	remaining_size = connection->nbd_handle->volume_size - (size64_t) offset;
+
+	if( remaining_size > (size64_t) length )
+	{
+		remaining_size = (size64_t) length;
+	}
+	while( remaining_size > 0 )
+	{
+		result = nbd_connection_get_extent(
+		          connection,
+		          offset,
+		          remaining_size,
+		          &extent_size,
+		          &is_sparse,
+		          &status_error );
+
+		if( result != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 status_error );
+			libcerror_error_free(
+			 &status_error );
+
+			if( nbd_connection_write_error_reply(
+			     connection,
+			     cookie,
+			     NBD_ERROR_IO,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write error reply.",
+				 function );
+
+				return( -1 );
+			}
+			return( 1 );
+		}
+		extent_length = (uint32_t) extent_size;
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( connection->buffer[ data_offset ] ),
+		 extent_length );
+
+		data_offset += 4;
+
+		if( is_sparse != 0 )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( connection->buffer[ data_offset ] ),
+			 NBD_STATE_HOLE | NBD_STATE_ZERO );
+		}
+		else
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( connection->buffer[ data_offset ] ),
+			 0 );
+		}
+		data_offset += 4;
+
+		number_of_descriptors++;
+
+		if( ( ( flags & NBD_COMMAND_FLAG_REQUEST_ONE ) != 0 )
+		 || ( number_of_descriptors >= NBD_HANDLE_MAXIMUM_NUMBER_OF_DESCRIPTORS ) )
+		{
+			break;
+		}
+		offset         += (off64_t) extent_size;
+		remaining_size -= extent_size;
+	}
+	if( nbd_connection_write_structured_reply(
+	     connection,
+	     cookie,
+	     NBD_REPLY_FLAG_DONE,
+	     NBD_REPLY_TYPE_BLOCK_STATUS,
+	     NULL,
+	     0,
+	     connection->buffer,
+	     data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write block status reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles the requests of the client during the transmission phase
+ * Returns 1 if the client disconnected, 0 if the connection was closed or -1 on error
+ */
+int nbd_connection_transmit(
+     nbd_connection_t *connection,
+     libcerror_error_t **error )
+{
+	uint8_t request_data[ 28 ];
+
+	static char *function   = "nbd_connection_transmit";
+	uint64_t cookie         = 0;
+	uint64_t request_offset = 0;
+	uint32_t error_value    = 0;
+	uint32_t magic          = 0;
+	uint32_t request_length = 0;
+	uint16_t command        = 0;
+	uint16_t command_flags  = 0;
+	size_t discard_size     = 0;
+	int result              = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	while( connection->nbd_handle->abort == 0 )
+	{
+		result = nbd_connection_read(
+		          connection,
+		          request_data,
+		          28,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_data[ 0 ] ),
+		 magic );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request_data[ 4 ] ),
+		 command_flags );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request_data[ 6 ] ),
+		 command );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_data[ 8 ] ),
+		 cookie );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_data[ 16 ] ),
+		 request_offset );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_data[ 24 ] ),
+		 request_length );
+
+		if( magic != NBD_REQUEST_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported request magic: 0x%08" PRIx32 ".",
+			 function,
+			 magic );
+
+			return( -1 );
+		}
+		error_value = 0;
+
+		switch( command )
+		{
+			case NBD_COMMAND_READ:
+			case NBD_COMMAND_BLOCK_STATUS:
+				if( ( request_length == 0 )
+				 || ( request_offset >= connection->nbd_handle->volume_size )
+				 || ( (size64_t) request_length > ( connection->nbd_handle->volume_size - request_offset ) ) )
+				{
+					/* A block status request is allowed to exceed the end of the export
+					 */
+					if( ( command != NBD_COMMAND_BLOCK_STATUS )
+					 || ( request_length == 0 )
+					 || ( request_offset >= connection->nbd_handle->volume_size ) )
+					{
+						error_value = NBD_ERROR_INVALID;
+					}
+				}
+				if( ( command == NBD_COMMAND_READ )
+				 && ( request_length > NBD_HANDLE_MAXIMUM_BLOCK_SIZE ) )
+				{
+					error_value = NBD_ERROR_INVALID;
+				}
+				if( ( command == NBD_COMMAND_BLOCK_STATUS )
+				 && ( connection->allocation_context == 0 ) )
+				{
+					error_value = NBD_ERROR_INVALID;
+				}
+				if( error_value != 0 )
+				{
+					break;
+				}
+				if( command == NBD_COMMAND_READ )
+				{
+					result = nbd_connection_handle_read(
+					          connection,
+					          cookie,
+					          (off64_t) request_offset,
+					          request_length,
+					          error );
+				}
+				else
+				{
+					result = nbd_connection_handle_block_status(
+					          connection,
+					          cookie,
+					          command_flags,
+					          (off64_t) request_offset,
+					          request_length,
+					          error );
+				}
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to handle request: %" PRIu16 ".",
+					 function,
+					 command );
+
+					return( -1 );
+				}
+				continue;
+
+			case NBD_COMMAND_DISCONNECT:
+				return( 1 );
+
+			case NBD_COMMAND_FLUSH:
+				break;
+
+			case NBD_COMMAND_WRITE:
+				/* The data of the write request is discarded since the export is read-only
+				 */
+				while( request_length > 0 )
+				{
+					discard_size = NBD_HANDLE_PREFERRED_BLOCK_SIZE;
+
+					if( discard_size > (size_t) request_length )
+					{
+						discard_size = (size_t) request_length;
+					}
+					if( nbd_connection_resize_buffer(
+					     connection,
+					     discard_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+						 "%s: unable to resize buffer.",
+						 function );
+
+						return( -1 );
+					}
+					result = nbd_connection_read(
+					          connection,
+					          connection->buffer,
+					          discard_size,
+					          error );
+
+					if( result != 1 )
+					{
+						return( result );
+					}
+					request_length -= (uint32_t) discard_size;
+				}
+				error_value = NBD_ERROR_PERMISSION;
+
+				break;
+
+			case NBD_COMMAND_TRIM:
+			case NBD_COMMAND_WRITE_ZEROES:
+				error_value = NBD_ERROR_PERMISSION;
+
+				break;
+
+			default:
+				error_value = NBD_ERROR_INVALID;
+
+				break;
+		}
+		if( error_value != 0 )
+		{
+			result = nbd_connection_write_error_reply(
+			          connection,
+			          cookie,
+			          error_value,
+			          error );
+		}
+		else if( connection->structured_replies != 0 )
+		{
+			/* A reply without payload is a done chunk of type none
+			 */
+			result = nbd_connection_write_structured_reply(
+			          connection,
+			          cookie,
+			          NBD_REPLY_FLAG_DONE,
+			          0,
+			          NULL,
+			          0,
+			          NULL,
+			          0,
+			          error );
+		}
+		else
+		{
+			result = nbd_connection_write_simple_reply(
+			          connection,
+			          cookie,
+			          0,
+			          NULL,
+			          0,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Serves a connection until the client disconnects
+ * This function is the callback of the thread of the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_serve(
+     nbd_connection_t *connection )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "nbd_connection_serve";
+	int result               = 0;
+
+	if( connection == NULL )
+	{
+		return( -1 );
+	}
+	result = nbd_connection_negotiate(
+	          connection,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to negotiate options.",
+		 function );
+	}
+	else if( result == 1 )
+	{
+		result = nbd_connection_transmit(
+		          connection,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to handle requests of export: " NBD_HANDLE_EXPORT_NAME_PREFIX "%d.",
+			 function,
+			 connection->store_index + 1 );
+		}
+	}
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	/* Shut down the socket so the handle can reap the connection
+	 */
+	shutdown(
+	 connection->socket_descriptor,
+	 SHUT_RDWR );
+
+	connection->is_closed = 1;
+
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates a NBD handle
+ * Make sure the value nbd_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_initialize(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_initialize";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*nbd_handle = memory_allocate_structure(
+	               nbd_handle_t );
+
+	if( *nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create NBD handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_handle,
+	     0,
+	     sizeof( nbd_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD handle.",
+		 function );
+
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_range_initialize(
+	     &( ( *nbd_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     &( ( *nbd_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_handle )->maximum_number_of_connections = NBD_HANDLE_DEFAULT_NUMBER_OF_CONNECTIONS;
+	( *nbd_handle )->listen_socket_descriptor      = -1;
+	( *nbd_handle )->notify_stream                 = NBD_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *nbd_handle != NULL )
+	{
+		if( ( *nbd_handle )->input_volume != NULL )
+		{
+			libvshadow_volume_free(
+			 &( ( *nbd_handle )->input_volume ),
+			 NULL );
+		}
+		if( ( *nbd_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *nbd_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NBD handle
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_free(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_free";
+	int result            = 1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_handle != NULL )
+	{
+		if( nbd_handle_free_connections(
+		     *nbd_handle,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free connections.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *nbd_handle )->connections != NULL )
+		{
+			memory_free(
+			 ( *nbd_handle )->connections );
+		}
+		if( ( *nbd_handle )->listen_socket_descriptor != -1 )
+		{
+			if( nbd_handle_close_socket(
+			     *nbd_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close socket.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libvshadow_volume_free(
+		     &( ( *nbd_handle )->input_volume ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input volume.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *nbd_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the NBD handle to abort
+ * The sockets are shut down so that blocking accept and receive calls return
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_signal_abort(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_signal_abort";
+	int connection_index  = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->abort = 1;
+
+	if( nbd_handle->listen_socket_descriptor != -1 )
+	{
+		shutdown(
+		 nbd_handle->listen_socket_descriptor,
+		 SHUT_RDWR );
+	}
+	/* The threads of the connections return when their socket is shut down
+	 */
+	if( nbd_handle->connections != NULL )
+	{
+		for( connection_index = 0;
+		     connection_index < nbd_handle->maximum_number_of_connections;
+		     connection_index++ )
+		{
+			if( nbd_handle->connections[ connection_index ] != NULL )
+			{
+				shutdown(
+				 nbd_handle->connections[ connection_index ]->socket_descriptor,
+				 SHUT_RDWR );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_set_volume_offset(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the maximum number of connections
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int nbd_handle_set_maximum_number_of_connections(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_set_maximum_number_of_connections";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->connections != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle - connections value already set.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) NBD_HANDLE_MAXIMUM_NUMBER_OF_CONNECTIONS ) )
+	{
+		return( 0 );
+	}
+	nbd_handle->maximum_number_of_connections = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Opens the input of the NBD handle
+ * Returns 1 if successful, 0 if the volume does not contain VSS or -1 on error
+ */
+int nbd_handle_open_input(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "nbd_handle_open_input";
+	size_t filename_length = 0;
+	int result             = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( libbfio_file_range_set_name(
+	     nbd_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_range_set(
+	     nbd_handle->input_file_io_handle,
+	     nbd_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open set volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_check_volume_signature_file_io_handle(
+	          nbd_handle->input_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume has a VSS signature.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libvshadow_volume_open_file_io_handle(
+	     nbd_handle->input_volume,
+	     nbd_handle->input_file_io_handle,
+	     LIBVSHADOW_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_size(
+	     nbd_handle->input_volume,
+	     &( nbd_handle->volume_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_number_of_stores(
+	     nbd_handle->input_volume,
+	     &( nbd_handle->number_of_stores ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the NBD handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int nbd_handle_close(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_close";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_close(
+	     nbd_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Opens the Unix domain socket the clients connect to
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_open_socket(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *socket_path,
+     libcerror_error_t **error )
+{
+	struct sockaddr_un socket_address;
+
+	static char *function     = "nbd_handle_open_socket";
+	size_t socket_path_length = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->listen_socket_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle - listen socket descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket path.",
+		 function );
+
+		return( -1 );
+	}
+	socket_path_length = system_string_length(
+	                      socket_path );
+
+	if( ( socket_path_length == 0 )
+	 || ( socket_path_length >= sizeof( socket_address.sun_path ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid socket path length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &socket_address,
+	     0,
+	     sizeof( struct sockaddr_un ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear socket address.",
+		 function );
+
+		return( -1 );
+	}
+	socket_address.sun_family = AF_UNIX;
+
+	if( system_string_copy(
+	     socket_address.sun_path,
+	     socket_path,
+	     socket_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->listen_socket_descriptor = socket(
+	                                        AF_UNIX,
+	                                        SOCK_STREAM,
+	                                        0 );
+
+	if( nbd_handle->listen_socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create socket with error: %d.",
+		 function,
+		 errno );
+
+		goto on_error;
+	}
+	if( bind(
+	     nbd_handle->listen_socket_descriptor,
+	     (struct sockaddr *) &socket_address,
+	     sizeof( struct sockaddr_un ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to bind socket to: %" PRIs_SYSTEM " with error: %d.",
+		 function,
+		 socket_path,
+		 errno );
+
+		goto on_error;
+	}
+	nbd_handle->socket_path = socket_path;
+
+	if( listen(
+	     nbd_handle->listen_socket_descriptor,
+	     nbd_handle->maximum_number_of_connections ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to listen on socket with error: %d.",
+		 function,
+		 errno );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( nbd_handle->listen_socket_descriptor != -1 )
+	{
+		nbd_handle_close_socket(
+		 nbd_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the Unix domain socket the clients connect to
+ * The socket path is removed
+ * Returns the 0 if succesful or -1 on error
+ */
+int nbd_handle_close_socket(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_close_socket";
+	int result            = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->listen_socket_descriptor != -1 )
+	{
+		if( close(
+		     nbd_handle->listen_socket_descriptor ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close socket.",
+			 function );
+
+			result = -1;
+		}
+		nbd_handle->listen_socket_descriptor = -1;
+	}
+	if( nbd_handle->socket_path != NULL )
+	{
+		if( unlink(
+		     nbd_handle->socket_path ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove socket: %" PRIs_SYSTEM ".",
+			 function,
+			 nbd_handle->socket_path );
+
+			result = -1;
+		}
+		nbd_handle->socket_path = NULL;
+	}
+	return( result );
+}
+
+/* Frees the connections
+ * If only closed is set only the connections that were closed are freed
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_free_connections(
+     nbd_handle_t *nbd_handle,
+     uint8_t only_closed,
+     libcerror_error_t **error )
+{
+	nbd_connection_t *connection = NULL;
+	static char *function        = "nbd_handle_free_connections";
+	int connection_index         = 0;
+	int result                   = 1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->connections == NULL )
+	{
+		return( 1 );
+	}
+	for( connection_index = 0;
+	     connection_index < nbd_handle->maximum_number_of_connections;
+	     connection_index++ )
+	{
+		connection = nbd_handle->connections[ connection_index ];
+
+		if( connection == NULL )
+		{
+			continue;
+		}
+		if( ( only_closed != 0 )
+		 && ( connection->is_closed == 0 ) )
+		{
+			continue;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( connection->thread != NULL )
+		{
+			/* Make sure a connection that is still being served returns
+			 */
+			shutdown(
+			 connection->socket_descriptor,
+			 SHUT_RDWR );
+
+			if( libcthreads_thread_join(
+			     &( connection->thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join connection thread: %d.",
+				 function,
+				 connection_index );
+
+				result = -1;
+			}
+		}
+#endif
+		nbd_handle->connections[ connection_index ] = NULL;
+
+		if( nbd_connection_free(
+		     &connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free connection: %d.",
+			 function,
+			 connection_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Adds a connection of a client that connected
+ * If multi-threading is enabled the connection is served by its own thread
+ * otherwise the connection is served before the next client is accepted
+ * Returns 1 if successful, 0 if the maximum number of connections was reached or -1 on error
+ */
+int nbd_handle_add_connection(
+     nbd_handle_t *nbd_handle,
+     int socket_descriptor,
+     libcerror_error_t **error )
+{
+	nbd_connection_t *connection = NULL;
+	static char *function        = "nbd_handle_add_connection";
+	int connection_index         = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->connections == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD handle - missing connections.",
+		 function );
+
+		return( -1 );
+	}
+	/* Connections of clients that disconnected are reaped before looking for a free slot
+	 */
+	if( nbd_handle_free_connections(
+	     nbd_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free closed connections.",
+		 function );
+
+		return( -1 );
+	}
+	for( connection_index = 0;
+	     connection_index < nbd_handle->maximum_number_of_connections;
+	     connection_index++ )
+	{
+		if( nbd_handle->connections[ connection_index ] == NULL )
+		{
+			break;
+		}
+	}
+	if( connection_index >= nbd_handle->maximum_number_of_connections )
+	{
+		return( 0 );
+	}
+	if( nbd_connection_initialize(
+	     &connection,
+	     nbd_handle,
+	     socket_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create connection.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->connections[ connection_index ] = connection;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_thread_create(
+	     &( connection->thread ),
+	     NULL,
+	     (int (*)(void *)) &nbd_connection_serve,
+	     (void *) connection,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create connection thread.",
+		 function );
+
+		nbd_handle->connections[ connection_index ] = NULL;
+
+		/* The socket is closed by the caller
+		 */
+		connection->socket_descriptor = -1;
+
+		nbd_connection_free(
+		 &connection,
+		 NULL );
+
+		return( -1 );
+	}
+#else
+	nbd_connection_serve(
+	 connection );
+
+	nbd_handle->connections[ connection_index ] = NULL;
+
+	if( nbd_connection_free(
+	     &connection,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free connection.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Serves the stores of the volume as exports until signalled to abort
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_serve(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function   = "nbd_handle_serve";
+	int result              = 1;
+	int socket_descriptor   = -1;
+	int store_number        = 0;
+	int add_result          = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->listen_socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD handle - missing listen socket descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->connections != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle - connections value already set.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->connections = (nbd_connection_t **) memory_allocate(
+	                                                 sizeof( nbd_connection_t * ) * nbd_handle->maximum_number_of_connections );
+
+	if( nbd_handle->connections == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create connections.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     nbd_handle->connections,
+	     0,
+	     sizeof( nbd_connection_t * ) * nbd_handle->maximum_number_of_connections ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear connections.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 nbd_handle->notify_stream,
+	 "Serving exports on: %" PRIs_SYSTEM "\n",
+	 nbd_handle->socket_path );
+
+	for( store_number = 1;
+	     store_number <= nbd_handle->number_of_stores;
+	     store_number++ )
+	{
+		fprintf(
+		 nbd_handle->notify_stream,
+		 "\t%s%d\t\t\t\t: %" PRIu64 " bytes\n",
+		 NBD_HANDLE_EXPORT_NAME_PREFIX,
+		 store_number,
+		 nbd_handle->volume_size );
+	}
+	fprintf(
+	 nbd_handle->notify_stream,
+	 "\n" );
+
+	while( nbd_handle->abort == 0 )
+	{
+		socket_descriptor = accept(
+		                     nbd_handle->listen_socket_descriptor,
+		                     NULL,
+		                     NULL );
+
+		if( socket_descriptor == -1 )
+		{
+			if( nbd_handle->abort != 0 )
+			{
+				break;
+			}
+			if( ( errno == EINTR )
+			 || ( errno == ECONNABORTED ) )
+			{
+				continue;
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to accept connection with error: %d.",
+			 function,
+			 errno );
+
+			result = -1;
+
+			break;
+		}
+		add_result = nbd_handle_add_connection(
+		              nbd_handle,
+		              socket_descriptor,
+		              error );
+
+		if( add_result != 1 )
+		{
+			close(
+			 socket_descriptor );
+		}
+		if( add_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add connection.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		else if( add_result == 0 )
+		{
+			fprintf(
+			 nbd_handle->notify_stream,
+			 "Maximum number of connections reached, refusing connection.\n" );
+		}
+	}
+	if( nbd_handle_free_connections(
+	     nbd_handle,
+	     0,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free connections.",
+			 function );
+		}
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* defined( NBD_HANDLE_HAVE_UNIX_SOCKETS ) */
+
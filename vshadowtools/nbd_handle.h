@@ -0,0 +1,330 @@
+/*
+ * Network Block Device (NBD) handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_HANDLE_H )
+#define _NBD_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The exports are served over a Unix domain socket
+ */
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define NBD_HANDLE_HAVE_UNIX_SOCKETS
+#endif
+
+typedef struct nbd_handle nbd_handle_t;
+
+typedef struct nbd_connection nbd_connection_t;
+
+/* A client connection
+ */
+struct nbd_connection
+{
+	/* The NBD handle
+	 */
+	nbd_handle_t *nbd_handle;
+
+	/* The socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The libbfio input file IO handle of the connection
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The store of the export
+	 */
+	libvshadow_store_t *store;
+
+	/* The index of the store of the export
+	 */
+	int store_index;
+
+	/* Value to indicate the client does not expect the zero padding of the export name reply
+	 */
+	uint8_t no_zeroes;
+
+	/* Value to indicate structured replies were negotiated
+	 */
+	uint8_t structured_replies;
+
+	/* Value to indicate the base:allocation meta context was negotiated
+	 */
+	uint8_t allocation_context;
+
+	/* The data buffer
+	 */
+	uint8_t *buffer;
+
+	/* The data buffer size
+	 */
+	size_t buffer_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread that serves the connection
+	 */
+	libcthreads_thread_t *thread;
+#endif
+
+	/* Value to indicate the connection was closed by the client or the server
+	 * This value is set by the thread of the connection when it returns
+	 */
+	int is_closed;
+};
+
+struct nbd_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The maximum number of connections
+	 */
+	int maximum_number_of_connections;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libvshadow input volume
+	 */
+	libvshadow_volume_t *input_volume;
+
+	/* The volume size
+	 */
+	size64_t volume_size;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The socket path
+	 */
+	const system_character_t *socket_path;
+
+	/* The listen socket descriptor
+	 */
+	int listen_socket_descriptor;
+
+	/* The connections
+	 */
+	nbd_connection_t **connections;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int nbd_connection_initialize(
+     nbd_connection_t **connection,
+     nbd_handle_t *nbd_handle,
+     int socket_descriptor,
+     libcerror_error_t **error );
+
+int nbd_connection_free(
+     nbd_connection_t **connection,
+     libcerror_error_t **error );
+
+int nbd_connection_read(
+     nbd_connection_t *connection,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int nbd_connection_write(
+     nbd_connection_t *connection,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int nbd_connection_resize_buffer(
+     nbd_connection_t *connection,
+     size_t size,
+     libcerror_error_t **error );
+
+int nbd_connection_get_store_index_by_export_name(
+     nbd_connection_t *connection,
+     const uint8_t *export_name,
+     size_t export_name_length,
+     int *store_index,
+     libcerror_error_t **error );
+
+int nbd_connection_open_export(
+     nbd_connection_t *connection,
+     const uint8_t *export_name,
+     size_t export_name_length,
+     libcerror_error_t **error );
+
+int nbd_connection_write_option_reply(
+     nbd_connection_t *connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_negotiate(
+     nbd_connection_t *connection,
+     libcerror_error_t **error );
+
+int nbd_connection_write_simple_reply(
+     nbd_connection_t *connection,
+     uint64_t cookie,
+     uint32_t error_value,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_structured_reply(
+     nbd_connection_t *connection,
+     uint64_t cookie,
+     uint16_t flags,
+     uint16_t reply_type,
+     const uint8_t *header_data,
+     size_t header_data_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_error_reply(
+     nbd_connection_t *connection,
+     uint64_t cookie,
+     uint32_t error_value,
+     libcerror_error_t **error );
+
+int nbd_connection_get_extent(
+     nbd_connection_t *connection,
+     off64_t offset,
+     size64_t maximum_size,
+     size64_t *extent_size,
+     uint8_t *is_sparse,
+     libcerror_error_t **error );
+
+int nbd_connection_read_data(
+     nbd_connection_t *connection,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_read(
+     nbd_connection_t *connection,
+     uint64_t cookie,
+     off64_t offset,
+     uint32_t length,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_block_status(
+     nbd_connection_t *connection,
+     uint64_t cookie,
+     uint16_t flags,
+     off64_t offset,
+     uint32_t length,
+     libcerror_error_t **error );
+
+int nbd_connection_transmit(
+     nbd_connection_t *connection,
+     libcerror_error_t **error );
+
+int nbd_connection_serve(
+     nbd_connection_t *connection );
+
+int nbd_handle_initialize(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_free(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_signal_abort(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_set_volume_offset(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int nbd_handle_set_maximum_number_of_connections(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int nbd_handle_open_input(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int nbd_handle_close(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_open_socket(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *socket_path,
+     libcerror_error_t **error );
+
+int nbd_handle_close_socket(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_free_connections(
+     nbd_handle_t *nbd_handle,
+     uint8_t only_closed,
+     libcerror_error_t **error );
+
+int nbd_handle_add_connection(
+     nbd_handle_t *nbd_handle,
+     int socket_descriptor,
+     libcerror_error_t **error );
+
+int nbd_handle_serve(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_HANDLE_H ) */
+
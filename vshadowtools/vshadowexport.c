@@ -0,0 +1,558 @@
+/*
+ * Exports the stores in a Windows NT Volume Shadow Snapshot (VSS) volume to raw image files
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "export_handle.h"
+#include "vshadowtools_getopt.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libclocale.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libvshadow.h"
+#include "vshadowtools_output.h"
+#include "vshadowtools_signal.h"
+#include "vshadowtools_unused.h"
+
+export_handle_t *vshadowexport_export_handle = NULL;
+int vshadowexport_abort                      = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadowexport to export the stores in a Windows NT Volume Shadow\n"
+	                 "Snapshot (VSS) volume to raw image files\n\n" );
+
+	fprintf( stream, "Usage: vshadowexport [ -b buffer_size ] [ -i input_mode ] [ -j threads ]\n"
+	                 "                    [ -o offset ] [ -s store_number ] [ -w threads ]\n"
+	                 "                    [ -hruvV ] source target\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device\n" );
+	fprintf( stream, "\ttarget: the target path, the store number and .raw are appended\n"
+	                 "\t        to create the filename of every exported store\n\n" );
+
+	fprintf( stream, "\t-b:     specify the buffer size in bytes, must be a multiple of 4096\n"
+	                 "\t        (default is 1048576)\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-i:     specify the input mode used to read the volume data, options:\n"
+	                 "\t        buffered (default), direct (bypasses the page cache) or\n"
+	                 "\t        nocache (drops the volume data from the page cache after reading)\n" );
+	fprintf( stream, "\t-j:     specify the number of read threads (default is 4)\n" );
+	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-r:     resume an interrupted export from its checkpoint\n" );
+	fprintf( stream, "\t-s:     specify the number of the store to export or all (default)\n" );
+	fprintf( stream, "\t-u:     export clusters that the NTFS file system in a store marks\n"
+	                 "\t        as unallocated as sparse data instead of reading them\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+	fprintf( stream, "\t-w:     specify the number of write threads (default is 2)\n" );
+}
+
+/* Signal handler for vshadowexport
+ */
+void vshadowexport_signal_handler(
+      vshadowtools_signal_t signal VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "vshadowexport_signal_handler";
+
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vshadowexport_abort = 1;
+
+	if( vshadowexport_export_handle != NULL )
+	{
+		if( export_handle_signal_abort(
+		     vshadowexport_export_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal export handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                           = NULL;
+	system_character_t *option_buffer_size             = NULL;
+	system_character_t *option_input_mode              = NULL;
+	system_character_t *option_number_of_read_threads  = NULL;
+	system_character_t *option_number_of_write_threads = NULL;
+	system_character_t *option_store_number            = NULL;
+	system_character_t *option_volume_offset           = NULL;
+	system_character_t *source                         = NULL;
+	system_character_t *target                         = NULL;
+	char *program                                      = "vshadowexport";
+	system_integer_t option                            = 0;
+	uint8_t resume                                     = 0;
+	uint8_t skip_unallocated                           = 0;
+	int result                                         = 0;
+	int verbose                                        = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "vshadowtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+        if( vshadowtools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vshadowoutput_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vshadowtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:hi:j:o:rs:uvVw:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_buffer_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'i':
+				option_input_mode = optarg;
+
+				break;
+
+			case (system_integer_t) 'j':
+				option_number_of_read_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'o':
+				option_volume_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'r':
+				resume = 1;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_store_number = optarg;
+
+				break;
+
+			case (system_integer_t) 'u':
+				skip_unallocated = 1;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vshadowoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'w':
+				option_number_of_write_threads = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target path.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	target = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvshadow_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvshadow_notify_set_verbose(
+	 verbose );
+
+	if( export_handle_initialize(
+	     &vshadowexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize export handle.\n" );
+
+		goto on_error;
+	}
+	if( option_volume_offset != NULL )
+	{
+		if( export_handle_set_volume_offset(
+		     vshadowexport_export_handle,
+		     option_volume_offset,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported volume offset defaulting to: %" PRIi64 ".\n",
+			 vshadowexport_export_handle->volume_offset );
+		}
+	}
+	if( option_buffer_size != NULL )
+	{
+		result = export_handle_set_buffer_size(
+		          vshadowexport_export_handle,
+		          option_buffer_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set buffer size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported buffer size defaulting to: %" PRIzd ".\n",
+			 vshadowexport_export_handle->buffer_size );
+		}
+	}
+	if( option_input_mode != NULL )
+	{
+		result = export_handle_set_input_mode(
+		          vshadowexport_export_handle,
+		          option_input_mode,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set input mode.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported input mode defaulting to: buffered.\n" );
+		}
+	}
+	if( option_number_of_read_threads != NULL )
+	{
+		result = export_handle_set_number_of_read_threads(
+		          vshadowexport_export_handle,
+		          option_number_of_read_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of read threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of read threads defaulting to: %d.\n",
+			 vshadowexport_export_handle->number_of_read_threads );
+		}
+	}
+	if( option_number_of_write_threads != NULL )
+	{
+		result = export_handle_set_number_of_write_threads(
+		          vshadowexport_export_handle,
+		          option_number_of_write_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of write threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of write threads defaulting to: %d.\n",
+			 vshadowexport_export_handle->number_of_write_threads );
+		}
+	}
+	if( option_store_number != NULL )
+	{
+		result = export_handle_set_store_number(
+		          vshadowexport_export_handle,
+		          option_store_number,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set store number.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported store number defaulting to: all.\n" );
+		}
+	}
+	if( export_handle_set_target_path(
+	     vshadowexport_export_handle,
+	     target,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set target path.\n" );
+
+		goto on_error;
+	}
+	vshadowexport_export_handle->resume           = resume;
+	vshadowexport_export_handle->skip_unallocated = skip_unallocated;
+
+	if( vshadowtools_signal_attach(
+	     vshadowexport_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = export_handle_open_input(
+	          vshadowexport_export_handle,
+	          source,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "No Volume Shadow Snapshots found.\n" );
+
+		goto on_error;
+	}
+	result = export_handle_export_stores(
+	          vshadowexport_export_handle,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to export stores.\n" );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Export aborted, use -r to resume.\n" );
+	}
+	if( export_handle_close(
+	     vshadowexport_export_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close export handle.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_free(
+	     &vshadowexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free export handle.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowexport_abort != 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowexport_export_handle != NULL )
+	{
+		export_handle_free(
+		 &vshadowexport_export_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
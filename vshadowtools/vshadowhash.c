@@ -0,0 +1,470 @@
+/*
+ * Calculates digest hashes of the stores in a Windows NT Volume Shadow Snapshot (VSS) volume
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "hash_handle.h"
+#include "vshadowtools_getopt.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libclocale.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libvshadow.h"
+#include "vshadowtools_output.h"
+#include "vshadowtools_signal.h"
+#include "vshadowtools_unused.h"
+
+hash_handle_t *vshadowhash_hash_handle = NULL;
+int vshadowhash_abort                  = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadowhash to calculate digest hashes of the stores in a Windows NT\n"
+	                 "Volume Shadow Snapshot (VSS) volume\n\n" );
+
+	fprintf( stream, "Usage: vshadowhash [ -b block_size ] [ -d digest_types ] [ -j threads ]\n"
+	                 "                  [ -o offset ] [ -hpuvV ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device\n\n" );
+
+	fprintf( stream, "\t-b:     specify the block size in bytes, must be a multiple of 512\n"
+	                 "\t        (default is 16384)\n" );
+	fprintf( stream, "\t-d:     calculate the digest types, options: md5 (default),\n"
+	                 "\t        sha256 or all, multiple types can be separated by a comma\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-j:     specify the number of hashing threads (default is 4)\n" );
+	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-p:     prints the digest hashes of every block\n" );
+	fprintf( stream, "\t-u:     hash the clusters that are unallocated in the NTFS file system\n"
+	                 "\t        of a store as zero-filled, to compare the allocated data only\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for vshadowhash
+ */
+void vshadowhash_signal_handler(
+      vshadowtools_signal_t signal VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "vshadowhash_signal_handler";
+
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vshadowhash_abort = 1;
+
+	if( vshadowhash_hash_handle != NULL )
+	{
+		if( hash_handle_signal_abort(
+		     vshadowhash_hash_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal hash handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                     = NULL;
+	system_character_t *option_block_size        = NULL;
+	system_character_t *option_digest_types      = NULL;
+	system_character_t *option_number_of_threads = NULL;
+	system_character_t *option_volume_offset     = NULL;
+	system_character_t *source                   = NULL;
+	char *program                                = "vshadowhash";
+	system_integer_t option                      = 0;
+	uint8_t print_block_hashes                   = 0;
+	uint8_t skip_unallocated                     = 0;
+	int result                                   = 0;
+	int verbose                                  = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "vshadowtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+        if( vshadowtools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vshadowoutput_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vshadowtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:d:hj:o:puvV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_block_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'd':
+				option_digest_types = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'j':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'o':
+				option_volume_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'p':
+				print_block_hashes = 1;
+
+				break;
+
+			case (system_integer_t) 'u':
+				skip_unallocated = 1;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vshadowoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvshadow_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvshadow_notify_set_verbose(
+	 verbose );
+
+	if( hash_handle_initialize(
+	     &vshadowhash_hash_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize hash handle.\n" );
+
+		goto on_error;
+	}
+	if( option_volume_offset != NULL )
+	{
+		if( hash_handle_set_volume_offset(
+		     vshadowhash_hash_handle,
+		     option_volume_offset,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported volume offset defaulting to: %" PRIi64 ".\n",
+			 vshadowhash_hash_handle->volume_offset );
+		}
+	}
+	if( option_block_size != NULL )
+	{
+		result = hash_handle_set_block_size(
+		          vshadowhash_hash_handle,
+		          option_block_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set block size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported block size defaulting to: %" PRIzd ".\n",
+			 vshadowhash_hash_handle->block_size );
+		}
+	}
+	if( option_digest_types != NULL )
+	{
+		result = hash_handle_set_digest_types(
+		          vshadowhash_hash_handle,
+		          option_digest_types,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set digest types.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported digest types defaulting to: md5.\n" );
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		result = hash_handle_set_number_of_threads(
+		          vshadowhash_hash_handle,
+		          option_number_of_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: %d.\n",
+			 vshadowhash_hash_handle->number_of_threads );
+		}
+	}
+	vshadowhash_hash_handle->print_block_hashes = print_block_hashes;
+	vshadowhash_hash_handle->skip_unallocated   = skip_unallocated;
+
+	if( vshadowtools_signal_attach(
+	     vshadowhash_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = hash_handle_open_input(
+	          vshadowhash_hash_handle,
+	          source,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "No Volume Shadow Snapshots found.\n" );
+
+		goto on_error;
+	}
+	result = hash_handle_hash_stores(
+	          vshadowhash_hash_handle,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to hash stores.\n" );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Hashing aborted.\n" );
+	}
+	if( hash_handle_close(
+	     vshadowhash_hash_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close hash handle.\n" );
+
+		goto on_error;
+	}
+	if( hash_handle_free(
+	     &vshadowhash_hash_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free hash handle.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowhash_abort != 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowhash_hash_handle != NULL )
+	{
+		hash_handle_free(
+		 &vshadowhash_hash_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
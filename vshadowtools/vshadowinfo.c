@@ -59,13 +59,17 @@ void usage_fprint(
 	fprintf( stream, "Use vshadowinfo to determine information about a Windows NT Volume Shadow\n"
 	                 "Snapshot (VSS) volume\n\n" );
 
-	fprintf( stream, "Usage: vshadowinfo [ -o offset ] [ -ahvV ] source\n\n" );
+	fprintf( stream, "Usage: vshadowinfo [ -o offset ] [ -achstvV ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file or device\n\n" );
 
 	fprintf( stream, "\t-a:     shows allocation information\n" );
+	fprintf( stream, "\t-c:     shows the block change timeline, the ranges of blocks\n"
+	                 "\t        that were changed and the stores they were changed in\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
 	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-s:     shows read statistics\n" );
+	fprintf( stream, "\t-t:     shows phase timing\n" );
 	fprintf( stream, "\t-v:     verbose output to stderr\n" );
 	fprintf( stream, "\t-V:     print version\n" );
 }
@@ -128,6 +132,9 @@ int main( int argc, char * const argv[] )
 	char *program                            = "vshadowinfo";
 	system_integer_t option                  = 0;
 	uint8_t show_allocation_information      = 0;
+	uint8_t show_block_timeline              = 0;
+	uint8_t show_phase_timing                = 0;
+	uint8_t show_statistics                  = 0;
 	int result                               = 0;
 	int verbose                              = 0;
 
@@ -164,7 +171,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = vshadowtools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "aho:vV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "acho:stvV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -185,6 +192,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'c':
+				show_block_timeline = 1;
+
+				break;
+
 			case (system_integer_t) 'h':
 				usage_fprint(
 				 stdout );
@@ -196,6 +208,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 's':
+				show_statistics = 1;
+
+				break;
+
+			case (system_integer_t) 't':
+				show_phase_timing = 1;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -258,6 +280,9 @@ int main( int argc, char * const argv[] )
 		}
 	}
 	vshadowinfo_info_handle->show_allocation_information = show_allocation_information;
+	vshadowinfo_info_handle->show_statistics             = show_statistics;
+	vshadowinfo_info_handle->show_phase_timing           = show_phase_timing;
+	vshadowinfo_info_handle->show_block_timeline         = show_block_timeline;
 
 	result = info_handle_open_input(
 	          vshadowinfo_info_handle,
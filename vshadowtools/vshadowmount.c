@@ -90,14 +90,20 @@ void usage_fprint(
 	fprintf( stream, "Use vshadowmount to mount a Windows NT Volume Shadow Snapshot (VSS)\n"
 	                 "volume\n\n" );
 
-	fprintf( stream, "Usage: vshadowmount [ -o offset ] [ -X extended_options ]\n"
-	                 "                    [ -hvV ] source mount_point\n\n" );
+	fprintf( stream, "Usage: vshadowmount [ -m memory_limit ] [ -o offset ]\n"
+	                 "                    [ -X extended_options ] [ -htvV ]\n"
+	                 "                    source mount_point\n\n" );
 
 	fprintf( stream, "\tsource:      the source file or device\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
 
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-m:          specify the maximum memory in MiB used for the store\n"
+	                 "\t             block indexes, least recently used indexes are\n"
+	                 "\t             evicted when exceeded (default is no limit)\n" );
 	fprintf( stream, "\t-o:          specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-t:          prints phase timing to stderr on unmount\n"
+	                 "\t             vshadowmount will remain running in the foreground\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr\n"
 	                 "\t             vshadowmount will remain running in the foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
@@ -926,6 +932,23 @@ void vshadowmount_fuse_destroy(
 
 	if( vshadowmount_mount_handle != NULL )
 	{
+		if( vshadowmount_mount_handle->phase_timing != 0 )
+		{
+			if( mount_handle_phase_timing_fprint(
+			     vshadowmount_mount_handle,
+			     stderr,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print phase timing.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( mount_handle_free(
 		     &vshadowmount_mount_handle,
 		     &error ) != 1 )
@@ -2054,10 +2077,12 @@ int main( int argc, char * const argv[] )
 	libvshadow_error_t *error                    = NULL;
 	system_character_t *mount_point              = NULL;
 	system_character_t *option_extended_options  = NULL;
+	system_character_t *option_memory_limit      = NULL;
 	system_character_t *option_volume_offset     = NULL;
 	system_character_t *source                   = NULL;
 	char *program                                = "vshadowmount";
 	system_integer_t option                      = 0;
+	uint8_t phase_timing                         = 0;
 	int result                                   = 0;
 	int verbose                                  = 0;
 
@@ -2106,7 +2131,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = vshadowtools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "ho:vVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "hm:o:tvVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -2128,11 +2153,21 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'm':
+				option_memory_limit = optarg;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_volume_offset = optarg;
 
 				break;
 
+			case (system_integer_t) 't':
+				phase_timing = 1;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -2212,6 +2247,25 @@ int main( int argc, char * const argv[] )
 			 vshadowmount_mount_handle->volume_offset );
 		}
 	}
+	if( option_memory_limit != NULL )
+	{
+		if( mount_handle_set_index_memory_limit(
+		     vshadowmount_mount_handle,
+		     option_memory_limit,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported memory limit defaulting to: no limit.\n" );
+		}
+	}
+	vshadowmount_mount_handle->phase_timing = phase_timing;
+
 	result = mount_handle_open_input(
 	          vshadowmount_mount_handle,
 	          source,
@@ -2314,7 +2368,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	if( verbose == 0 )
+	if( ( verbose == 0 )
+	 && ( phase_timing == 0 ) )
 	{
 		if( fuse_daemonize(
 		     0 ) != 0 )
@@ -2461,6 +2516,20 @@ int main( int argc, char * const argv[] )
 			 result );
 			break;
 	}
+	if( phase_timing != 0 )
+	{
+		if( mount_handle_phase_timing_fprint(
+		     vshadowmount_mount_handle,
+		     stderr,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print phase timing.\n" );
+
+			goto on_error;
+		}
+	}
 	return( EXIT_SUCCESS );
 #else
 	fprintf(
@@ -0,0 +1,430 @@
+/*
+ * Serves the stores in a Windows NT Volume Shadow Snapshot (VSS) volume
+ * as Network Block Device (NBD) exports
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "nbd_handle.h"
+#include "vshadowtools_getopt.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libclocale.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libvshadow.h"
+#include "vshadowtools_output.h"
+#include "vshadowtools_signal.h"
+#include "vshadowtools_unused.h"
+
+#if defined( NBD_HANDLE_HAVE_UNIX_SOCKETS )
+nbd_handle_t *vshadownbd_nbd_handle = NULL;
+#endif
+
+int vshadownbd_abort = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadownbd to serve the stores in a Windows NT Volume Shadow\n"
+	                 "Snapshot (VSS) volume as read-only Network Block Device (NBD) exports\n\n" );
+
+	fprintf( stream, "Usage: vshadownbd [ -c connections ] [ -o offset ] [ -hvV ]\n"
+	                 "                  source socket_path\n\n" );
+
+	fprintf( stream, "\tsource:      the source file or device\n" );
+	fprintf( stream, "\tsocket_path: the path of the Unix domain socket to listen on,\n"
+	                 "\t             every store is exported as vss followed by the store number\n\n" );
+
+	fprintf( stream, "\t-c:          specify the maximum number of simultaneous connections\n"
+	                 "\t             (default is 16)\n" );
+	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-o:          specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-v:          verbose output to stderr\n" );
+	fprintf( stream, "\t-V:          print version\n" );
+}
+
+/* Signal handler for vshadownbd
+ */
+void vshadownbd_signal_handler(
+      vshadowtools_signal_t signal VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+{
+#if defined( NBD_HANDLE_HAVE_UNIX_SOCKETS )
+	libcerror_error_t *error = NULL;
+	static char *function   = "vshadownbd_signal_handler";
+#endif
+
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vshadownbd_abort = 1;
+
+#if defined( NBD_HANDLE_HAVE_UNIX_SOCKETS )
+	if( vshadownbd_nbd_handle != NULL )
+	{
+		if( nbd_handle_signal_abort(
+		     vshadownbd_nbd_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal NBD handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                                 = NULL;
+	system_character_t *option_maximum_number_of_connections = NULL;
+	system_character_t *option_volume_offset                 = NULL;
+	system_character_t *socket_path                          = NULL;
+	system_character_t *source                               = NULL;
+	char *program                                            = "vshadownbd";
+	system_integer_t option                                  = 0;
+	int verbose                                              = 0;
+
+#if defined( NBD_HANDLE_HAVE_UNIX_SOCKETS )
+	int result                                               = 0;
+#endif
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "vshadowtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+        if( vshadowtools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vshadowoutput_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vshadowtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "c:ho:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'c':
+				option_maximum_number_of_connections = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'o':
+				option_volume_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vshadowoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing socket path.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	socket_path = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvshadow_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvshadow_notify_set_verbose(
+	 verbose );
+
+#if defined( NBD_HANDLE_HAVE_UNIX_SOCKETS )
+	if( nbd_handle_initialize(
+	     &vshadownbd_nbd_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize NBD handle.\n" );
+
+		goto on_error;
+	}
+	if( option_volume_offset != NULL )
+	{
+		if( nbd_handle_set_volume_offset(
+		     vshadownbd_nbd_handle,
+		     option_volume_offset,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported volume offset defaulting to: %" PRIi64 ".\n",
+			 vshadownbd_nbd_handle->volume_offset );
+		}
+	}
+	if( option_maximum_number_of_connections != NULL )
+	{
+		result = nbd_handle_set_maximum_number_of_connections(
+		          vshadownbd_nbd_handle,
+		          option_maximum_number_of_connections,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum number of connections.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum number of connections defaulting to: %d.\n",
+			 vshadownbd_nbd_handle->maximum_number_of_connections );
+		}
+	}
+	result = nbd_handle_open_input(
+	          vshadownbd_nbd_handle,
+	          source,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "No Volume Shadow Snapshots found.\n" );
+
+		goto on_error;
+	}
+	if( nbd_handle_open_socket(
+	     vshadownbd_nbd_handle,
+	     socket_path,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open socket: %" PRIs_SYSTEM ".\n",
+		 socket_path );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_attach(
+	     vshadownbd_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( nbd_handle_serve(
+	     vshadownbd_nbd_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to serve exports.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( nbd_handle_close_socket(
+	     vshadownbd_nbd_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close socket.\n" );
+
+		goto on_error;
+	}
+	if( nbd_handle_close(
+	     vshadownbd_nbd_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close NBD handle.\n" );
+
+		goto on_error;
+	}
+	if( nbd_handle_free(
+	     &vshadownbd_nbd_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free NBD handle.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+#else
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( option_maximum_number_of_connections )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( option_volume_offset )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( socket_path )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( source )
+
+	fprintf(
+	 stderr,
+	 "No support for Unix domain sockets to serve VSS volume.\n" );
+
+	return( EXIT_FAILURE );
+#endif
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( NBD_HANDLE_HAVE_UNIX_SOCKETS )
+	if( vshadownbd_nbd_handle != NULL )
+	{
+		nbd_handle_free(
+		 &vshadownbd_nbd_handle,
+		 NULL );
+	}
+#endif
+	return( EXIT_FAILURE );
+}
+